@@ -22,6 +22,8 @@
 
 #include "onnx_adapter.h"
 
+#include <cmath>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <stdexcept>
@@ -30,6 +32,7 @@
 #include <fmt/format.h>
 #include <onnx/onnx_pb.h>
 
+#include "tensor/activations.h"
 #include "tensor/network_builder.h"
 #include "tensor/tensor_op.h"
 #include "tensor/tensor_op_factory.h"
@@ -68,7 +71,38 @@ void OnnxAdapter::load_model(const std::string& path) {
   visit_model(impl_->model);
 }
 
+void OnnxAdapter::visit_graph(const ::onnx::GraphProto& graph) {
+  num_remaining_uses_.clear();
+  for (const auto& node : graph.node()) {
+    for (const auto& input_name : node.input()) {
+      ++num_remaining_uses_[input_name];
+    }
+  }
+  for (const auto& output : graph.output()) {
+    ++num_remaining_uses_[output.name()];
+  }
+  OnnxVisitor::visit_graph(graph);
+}
+
+void OnnxAdapter::visit_node(const ::onnx::NodeProto& node) {
+  OnnxVisitor::visit_node(node);
+  for (const auto& input_name : node.input()) {
+    auto it = num_remaining_uses_.find(input_name);
+    if (it == std::end(num_remaining_uses_) || --it->second > 0) {
+      continue;
+    }
+    num_remaining_uses_.erase(it);
+    arithmetic_tensor_map_.erase(input_name);
+    boolean_tensor_map_.erase(input_name);
+  }
+}
+
 void OnnxAdapter::visit_initializer(const ::onnx::TensorProto& tensor) {
+  if (is_public_initializer(tensor.name())) {
+    // read directly by the operation using it
+    initializer_set_.insert(tensor.name());
+    return;
+  }
   if (tensor.dims_size() > 4) {
     throw std::invalid_argument("tensors with > 4 dimensions are not yet supported");
   }
@@ -339,7 +373,8 @@ void OnnxAdapter::visit_conv(const ::onnx::NodeProto& node) {
     const auto& group_attr = it->second.get();
     assert(group_attr.name() == "group");
     assert(group_attr.has_type() && group_attr.type() == ::onnx::AttributeProto::INT);
-    assert(group_attr.i() == 1);
+    assert(group_attr.i() > 0);
+    conv_op.group_ = group_attr.i();
   }
   {
     const auto& kernel_dims = kernel_tensor->get_dimensions();
@@ -456,6 +491,72 @@ void OnnxAdapter::visit_relu(const ::onnx::NodeProto& node) {
   boolean_tensor_map_[output_name] = output_tensor;
 }
 
+void OnnxAdapter::visit_clip(const ::onnx::NodeProto& node) {
+  assert(node.op_type() == "Clip");
+  assert(node.input_size() >= 1 && node.input_size() <= 3);
+  assert(node.output_size() == 1);
+  const auto& input_name = node.input(0);
+  const auto& output_name = node.output(0);
+
+  std::unordered_map<std::string, std::reference_wrapper<const ::onnx::AttributeProto>>
+      attribute_map;
+  for (const auto& attr : node.attribute()) {
+    attribute_map.emplace(attr.name(), std::cref(attr));
+  }
+
+  // the bounds are attributes up to opset 6 and optional inputs since opset 11
+  const auto msb = std::uint64_t(1) << (bit_size_ - 1);
+  std::uint64_t min = msb;
+  std::uint64_t max = msb - 1;
+  if (attribute_map.count("min") == 1) {
+    auto it = attribute_map.find("min");
+    assert(it != std::end(attribute_map));
+    const auto& min_attr = it->second.get();
+    assert(min_attr.has_type() && min_attr.type() == ::onnx::AttributeProto::FLOAT);
+    min = encode_public_value(min_attr.f());
+  }
+  if (attribute_map.count("max") == 1) {
+    auto it = attribute_map.find("max");
+    assert(it != std::end(attribute_map));
+    const auto& max_attr = it->second.get();
+    assert(max_attr.has_type() && max_attr.type() == ::onnx::AttributeProto::FLOAT);
+    max = encode_public_value(max_attr.f());
+  }
+  if (node.input_size() >= 2 && !node.input(1).empty()) {
+    min = encode_public_value(get_public_scalar(node.input(1)));
+  }
+  if (node.input_size() == 3 && !node.input(2).empty()) {
+    max = encode_public_value(get_public_scalar(node.input(2)));
+  }
+
+  auto& tensor_op_factory = network_builder_.get_tensor_op_factory(boolean_protocol_);
+  const auto input_tensor = get_as_boolean_tensor(input_name);
+  const auto output_tensor = tensor_op_factory.make_tensor_clip_op(input_tensor, min, max);
+  boolean_tensor_map_[output_name] = output_tensor;
+}
+
+void OnnxAdapter::visit_leaky_relu(const ::onnx::NodeProto& node) {
+  assert(node.op_type() == "LeakyRelu");
+  assert(node.input_size() == 1);
+  assert(node.output_size() == 1);
+  const auto& input_name = node.input(0);
+  const auto& output_name = node.output(0);
+
+  float alpha = 0.01f;
+  if (node.attribute_size() == 1) {
+    const auto& alpha_attr = node.attribute(0);
+    assert(alpha_attr.name() == "alpha");
+    assert(alpha_attr.has_type() && alpha_attr.type() == ::onnx::AttributeProto::FLOAT);
+    alpha = alpha_attr.f();
+  }
+
+  const auto input_tensor = get_as_arithmetic_tensor(input_name);
+  const auto output_tensor =
+      tensor::make_leaky_relu(network_builder_, arithmetic_protocol_, boolean_protocol_,
+                              input_tensor, encode_public_value(alpha), fractional_bits_);
+  arithmetic_tensor_map_[output_name] = output_tensor;
+}
+
 void OnnxAdapter::visit_maxpool(const ::onnx::NodeProto& node) {
   assert(node.op_type() == "MaxPool");
   assert(node.input_size() == 1);
@@ -643,6 +744,54 @@ void OnnxAdapter::visit_dropout(const ::onnx::NodeProto& node) {
   }
 }
 
+bool OnnxAdapter::is_public_initializer(const std::string& name) const {
+  for (const auto& node : impl_->model.graph().node()) {
+    if (node.op_type() != "Clip") {
+      continue;
+    }
+    for (int i = 1; i < node.input_size(); ++i) {
+      if (node.input(i) == name) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+float OnnxAdapter::get_public_scalar(const std::string& name) const {
+  for (const auto& tensor : impl_->model.graph().initializer()) {
+    if (tensor.name() != name) {
+      continue;
+    }
+    if (tensor.data_type() != ::onnx::TensorProto::FLOAT) {
+      throw std::invalid_argument(fmt::format("public parameter {} is not a float", name));
+    }
+    if (tensor.float_data_size() == 1) {
+      return tensor.float_data(0);
+    }
+    if (tensor.raw_data().size() == sizeof(float)) {
+      float value;
+      std::memcpy(&value, tensor.raw_data().data(), sizeof(float));
+      return value;
+    }
+    throw std::invalid_argument(fmt::format("public parameter {} is not a scalar", name));
+  }
+  throw std::runtime_error(fmt::format("cannot find initializer of name: {}", name));
+}
+
+std::uint64_t OnnxAdapter::encode_public_value(float x) const {
+  const auto msb = std::uint64_t(1) << (bit_size_ - 1);
+  const auto bound = std::exp2(bit_size_ - 1);
+  const auto y = std::round(double(x) * std::exp2(fractional_bits_));
+  if (y >= bound) {
+    return msb - 1;
+  } else if (y <= -bound) {
+    return msb;
+  }
+  const auto mask = bit_size_ == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bit_size_) - 1;
+  return static_cast<std::uint64_t>(static_cast<std::int64_t>(y)) & mask;
+}
+
 tensor::TensorCP OnnxAdapter::get_as_arithmetic_tensor(const std::string& name) {
   auto it = arithmetic_tensor_map_.find(name);
   if (it != std::end(arithmetic_tensor_map_)) {
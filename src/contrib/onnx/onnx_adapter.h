@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -45,14 +46,18 @@ class OnnxAdapter : public OnnxVisitor {
               bool is_model_provider);
   ~OnnxAdapter();
   void load_model(const std::string& path);
+  void visit_graph(const ::onnx::GraphProto&) override;
+  void visit_node(const ::onnx::NodeProto&) override;
   void visit_initializer(const ::onnx::TensorProto&) override;
   void visit_input(const ::onnx::ValueInfoProto&) override;
   void visit_output(const ::onnx::ValueInfoProto&) override;
   void visit_avgpool(const ::onnx::NodeProto&) override;
+  void visit_clip(const ::onnx::NodeProto&) override;
   void visit_conv(const ::onnx::NodeProto&) override;
   void visit_dropout(const ::onnx::NodeProto&) override;
   void visit_flatten(const ::onnx::NodeProto&) override;
   void visit_gemm(const ::onnx::NodeProto&) override;
+  void visit_leaky_relu(const ::onnx::NodeProto&) override;
   void visit_maxpool(const ::onnx::NodeProto&) override;
   void visit_mul(const ::onnx::NodeProto&) override;
   void visit_relu(const ::onnx::NodeProto&) override;
@@ -69,6 +74,14 @@ class OnnxAdapter : public OnnxVisitor {
   get_output_futures() noexcept;
 
  private:
+  // whether the initializer of the given name is a public parameter of an
+  // operation (e.g., the bounds of Clip) instead of a secret model parameter
+  bool is_public_initializer(const std::string&) const;
+  // value of a scalar initializer that is a public parameter
+  float get_public_scalar(const std::string&) const;
+  // fixed-point encoding of a public value, saturated to the signed range of bit_size_
+  std::uint64_t encode_public_value(float) const;
+
   tensor::NetworkBuilder& network_builder_;
   MPCProtocol arithmetic_protocol_;
   MPCProtocol boolean_protocol_;
@@ -79,6 +92,11 @@ class OnnxAdapter : public OnnxVisitor {
   std::unordered_set<std::string> initializer_set_;
   std::unordered_map<std::string, tensor::TensorCP> arithmetic_tensor_map_;
   std::unordered_map<std::string, tensor::TensorCP> boolean_tensor_map_;
+  // number of nodes (and graph outputs) which still need to read a value;
+  // values are dropped from the tensor maps after their last use, so that
+  // the gates can see which intermediate tensors are dead (e.g., for fusing
+  // local operations in BEAVYProvider)
+  std::unordered_map<std::string, std::size_t> num_remaining_uses_;
   std::unordered_map<std::string,
                      std::pair<tensor::TensorDimensions,
                                ENCRYPTO::ReusableFiberPromise<std::vector<std::uint32_t>>>>
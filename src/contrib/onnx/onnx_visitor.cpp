@@ -49,6 +49,8 @@ void OnnxVisitor::visit_node(const ::onnx::NodeProto& node) {
   const auto& op_type = node.op_type();
   if (op_type == "AveragePool") {
     visit_avgpool(node);
+  } else if (op_type == "Clip") {
+    visit_clip(node);
   } else if (op_type == "Conv") {
     visit_conv(node);
   } else if (op_type == "Dropout") {
@@ -57,6 +59,8 @@ void OnnxVisitor::visit_node(const ::onnx::NodeProto& node) {
     visit_flatten(node);
   } else if (op_type == "Gemm") {
     visit_gemm(node);
+  } else if (op_type == "LeakyRelu") {
+    visit_leaky_relu(node);
   } else if (op_type == "Mul") {
     visit_mul(node);
   } else if (op_type == "MaxPool") {
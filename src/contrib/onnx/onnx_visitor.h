@@ -43,10 +43,12 @@ class OnnxVisitor {
 
   virtual void visit_node(const ::onnx::NodeProto&);
   virtual void visit_avgpool(const ::onnx::NodeProto&) = 0;
+  virtual void visit_clip(const ::onnx::NodeProto&) = 0;
   virtual void visit_conv(const ::onnx::NodeProto&) = 0;
   virtual void visit_dropout(const ::onnx::NodeProto&) = 0;
   virtual void visit_flatten(const ::onnx::NodeProto&) = 0;
   virtual void visit_gemm(const ::onnx::NodeProto&) = 0;
+  virtual void visit_leaky_relu(const ::onnx::NodeProto&) = 0;
   virtual void visit_maxpool(const ::onnx::NodeProto&) = 0;
   virtual void visit_mul(const ::onnx::NodeProto&) = 0;
   virtual void visit_relu(const ::onnx::NodeProto&) = 0;
@@ -62,6 +62,7 @@ struct Options {
   std::size_t num_repetitions;
   std::size_t num_simd;
   bool sync_between_setup_and_online;
+  bool speculative_online;
   MOTION::MPCProtocol arithmetic_protocol;
   MOTION::MPCProtocol boolean_protocol;
   std::size_t my_id;
@@ -87,6 +88,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("num-simd", po::value<std::size_t>()->default_value(1), "number of SIMD values")
     ("sync-between-setup-and-online", po::bool_switch()->default_value(false),
      "run a synchronization protocol before the online phase starts")
+    ("speculative-online", po::bool_switch()->default_value(false),
+     "start the online phase concurrently to the setup phase")
     ("no-run", po::bool_switch()->default_value(false), "just build the circuit, but not execute it")
     ;
   // clang-format on
@@ -116,6 +119,11 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.num_repetitions = vm["repetitions"].as<std::size_t>();
   options.num_simd = vm["num-simd"].as<std::size_t>();
   options.sync_between_setup_and_online = vm["sync-between-setup-and-online"].as<bool>();
+  options.speculative_online = vm["speculative-online"].as<bool>();
+  if (options.speculative_online && options.sync_between_setup_and_online) {
+    std::cerr << "--speculative-online cannot be combined with --sync-between-setup-and-online\n";
+    return std::nullopt;
+  }
   options.no_run = vm["no-run"].as<bool>();
   if (options.my_id > 1) {
     std::cerr << "my-id must be one of 0 and 1\n";
@@ -265,6 +273,7 @@ int main(int argc, char* argv[]) {
     comm_layer->set_logger(logger);
     MOTION::TwoPartyTensorBackend backend(*comm_layer, options->threads,
                                       options->sync_between_setup_and_online, logger);
+    backend.set_speculative_online(options->speculative_online);
     run_composite_circuit(*options, backend);
     comm_layer->shutdown();
   } catch (std::runtime_error& e) {
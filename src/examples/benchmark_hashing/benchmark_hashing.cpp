@@ -0,0 +1,116 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compares the hash functions used in the setup phase: the fixed-key AES
+// based MMO construction used for hashing the OT extension matrix (one block
+// at a time vs. batched), and Blake2b used in the base OTs.
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "crypto/aes/aesni_primitives.h"
+#include "crypto/blake2b.h"
+#include "crypto/pseudo_random_generator.h"
+#include "crypto/random/aes128_ctr_rng.h"
+#include "utility/bit_matrix.h"
+#include "utility/bit_vector.h"
+
+static void set_random_round_keys(std::array<std::uint8_t, aes_round_keys_size_128>& round_keys) {
+  auto key = reinterpret_cast<std::byte*>(round_keys.data());
+  AES128_CTR_RNG::get_thread_instance().random_bytes(key, aes_key_size_128);
+  aesni_key_expansion_128(round_keys.data());
+}
+
+static void BM_mmo_single(benchmark::State& state) {
+  alignas(aes_block_size) std::array<std::uint8_t, aes_round_keys_size_128> round_keys;
+  set_random_round_keys(round_keys);
+  const std::size_t num_blocks = state.range(0);
+  std::vector<std::uint8_t> buffer(num_blocks * aes_block_size);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+      aesni_mmo_single(round_keys.data(), buffer.data() + i * aes_block_size);
+    }
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(state.iterations() * num_blocks * aes_block_size);
+}
+BENCHMARK(BM_mmo_single)->RangeMultiplier(1 << 4)->Range(1 << 4, 1 << 16);
+
+static void BM_mmo_batch(benchmark::State& state) {
+  alignas(aes_block_size) std::array<std::uint8_t, aes_round_keys_size_128> round_keys;
+  set_random_round_keys(round_keys);
+  const std::size_t num_blocks = state.range(0);
+  std::vector<std::uint8_t> buffer(num_blocks * aes_block_size);
+
+  for (auto _ : state) {
+    aesni_mmo_batch(round_keys.data(), buffer.data(), num_blocks);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(state.iterations() * num_blocks * aes_block_size);
+}
+BENCHMARK(BM_mmo_batch)->RangeMultiplier(1 << 4)->Range(1 << 4, 1 << 16);
+
+// hashing of a curve point and an index as in the base OTs
+static void BM_blake2b(benchmark::State& state) {
+  const std::size_t num_hashes = state.range(0);
+  std::array<std::uint8_t, 40> input{};
+  std::array<std::uint8_t, EVP_MAX_MD_SIZE> digest;
+  auto ctx = MOTION::NewBlakeCtx();
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < num_hashes; ++i) {
+      input[0] = static_cast<std::uint8_t>(i);
+      MOTION::Blake2b(input.data(), digest.data(), input.size(), ctx);
+    }
+    benchmark::DoNotOptimize(digest.data());
+  }
+  state.SetBytesProcessed(state.iterations() * num_hashes * input.size());
+}
+BENCHMARK(BM_blake2b)->RangeMultiplier(1 << 4)->Range(1 << 4, 1 << 12);
+
+// transposing and hashing the matrix on the receiver side of the OT extension
+static void BM_receiver_transpose_and_hash(benchmark::State& state) {
+  const std::size_t num_ots = state.range(0);
+  std::vector<ENCRYPTO::AlignedBitVector> rows(128);
+  std::array<const std::byte*, 128> ptrs;
+  for (std::size_t j = 0; j < 128; ++j) {
+    rows[j] = ENCRYPTO::AlignedBitVector::Random(num_ots);
+    ptrs[j] = rows[j].GetData().data();
+  }
+  std::array<std::byte, aes_key_size_128> key{};
+  ENCRYPTO::PRG prg_fixed_key;
+  prg_fixed_key.SetKey(key.data());
+  const std::vector<std::size_t> bitlengths(num_ots, 128);
+
+  for (auto _ : state) {
+    std::vector<ENCRYPTO::BitVector<>> outputs(num_ots);
+    ENCRYPTO::BitMatrix::ReceiverTransposeAndEncrypt(ptrs, outputs, prg_fixed_key, num_ots,
+                                                     bitlengths);
+    benchmark::DoNotOptimize(outputs.data());
+  }
+  state.counters["ots_per_second"] =
+      benchmark::Counter(state.iterations() * num_ots, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_receiver_transpose_and_hash)->RangeMultiplier(1 << 4)->Range(1 << 10, 1 << 20);
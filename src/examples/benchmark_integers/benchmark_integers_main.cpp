@@ -45,6 +45,9 @@ bool CheckPartyArgumentSyntax(const std::string& p);
 
 std::pair<po::variables_map, bool> ParseProgramOptions(int ac, char* av[]);
 
+std::unique_ptr<MOTION::Communication::CommunicationLayer> CreateCommunicationLayer(
+    const po::variables_map& vm);
+
 MOTION::PartyPtr CreateParty(const po::variables_map& vm);
 
 constexpr std::size_t ILLEGAL_PROTOCOL{100}, ILLEGAL_OPERATION_TYPE{100};
@@ -113,6 +116,52 @@ int main(int ac, char* av[]) {
                     comb.bit_size_, comb.num_simd_),
         accumulated_stats, accumulated_comm_stats);
   }
+
+  // compare against the division via Newton iterations on arithmetic shares
+  const auto fractional_bits{vm["fractional-bits"].as<std::size_t>()};
+  const auto num_iterations{vm["newton-iterations"].as<std::size_t>()};
+  // only in the 64 bit ring, since the products of the iterations do not fit
+  // into 32 bits with a useful number of fractional bits
+  const std::size_t bit_size{64};
+  const std::size_t num_simd{1000};
+  {
+    MOTION::Statistics::AccumulatedRunTimeStats accumulated_stats;
+    MOTION::Statistics::AccumulatedCommunicationStats accumulated_comm_stats;
+    auto comm_layer{CreateCommunicationLayer(vm)};
+    for (std::size_t i = 0; i < num_repetitions; ++i) {
+      auto stats =
+          EvaluateArithmeticDivision(*comm_layer, num_simd, fractional_bits, num_iterations);
+      accumulated_stats.add(stats);
+      accumulated_comm_stats.add(comm_layer->get_transport_statistics());
+      comm_layer->reset_transport_statistics();
+    }
+    comm_layer->shutdown();
+    std::cout << MOTION::Statistics::print_stats(
+        fmt::format("Protocol {} operation {} (Newton, {} iterations) bit size {} SIMD {}",
+                    MOTION::ToString(MOTION::MPCProtocol::ArithmeticBEAVY),
+                    ENCRYPTO::ToString(ENCRYPTO::IntegerOperationType::DIV), num_iterations,
+                    bit_size, num_simd),
+        accumulated_stats, accumulated_comm_stats);
+  }
+
+  // private set intersection via sorting in Yao
+  for (const auto num_rows : vm["intersection-rows"].as<std::vector<std::size_t>>()) {
+    const std::size_t bit_size{32};
+    MOTION::Statistics::AccumulatedRunTimeStats accumulated_stats;
+    MOTION::Statistics::AccumulatedCommunicationStats accumulated_comm_stats;
+    auto comm_layer{CreateCommunicationLayer(vm)};
+    for (std::size_t i = 0; i < num_repetitions; ++i) {
+      auto stats = EvaluateIntersection(*comm_layer, num_rows, bit_size);
+      accumulated_stats.add(stats);
+      accumulated_comm_stats.add(comm_layer->get_transport_statistics());
+      comm_layer->reset_transport_statistics();
+    }
+    comm_layer->shutdown();
+    std::cout << MOTION::Statistics::print_stats(
+        fmt::format("Protocol {} operation intersection bit size {} rows {}",
+                    MOTION::ToString(MOTION::MPCProtocol::Yao), bit_size, num_rows),
+        accumulated_stats, accumulated_comm_stats);
+  }
   return EXIT_SUCCESS;
 }
 
@@ -148,7 +197,10 @@ std::pair<po::variables_map, bool> ParseProgramOptions(int ac, char* av[]) {
       ("my-id", po::value<std::size_t>(), "my party id")
       ("other-parties", po::value<std::vector<std::string>>()->multitoken(), "(other party id, IP, port, my role), e.g., --other-parties 1,127.0.0.1,7777")
       ("online-after-setup", po::value<bool>()->default_value(true), "compute the online phase of the gate evaluations after the setup phase for all of them is completed (true/1 or false/0)")
-      ("repetitions", po::value<std::size_t>()->default_value(1), "number of repetitions");
+      ("repetitions", po::value<std::size_t>()->default_value(1), "number of repetitions")
+      ("fractional-bits", po::value<std::size_t>()->default_value(16), "number of fractional bits for the arithmetic division")
+      ("newton-iterations", po::value<std::size_t>()->default_value(8), "number of Newton iterations for the arithmetic division")
+      ("intersection-rows", po::value<std::vector<std::size_t>>()->multitoken()->default_value({10000}, "10000"), "numbers of rows per party for the set intersection, e.g., 10000 100000 1000000");
   // clang-format on
 
   po::variables_map vm;
@@ -200,7 +252,8 @@ std::pair<po::variables_map, bool> ParseProgramOptions(int ac, char* av[]) {
   return std::make_pair(vm, help);
 }
 
-MOTION::PartyPtr CreateParty(const po::variables_map& vm) {
+std::unique_ptr<MOTION::Communication::CommunicationLayer> CreateCommunicationLayer(
+    const po::variables_map& vm) {
   const auto parties_str{vm["other-parties"].as<const std::vector<std::string>>()};
   const auto num_parties{parties_str.size()};
   const auto my_id{vm["my-id"].as<std::size_t>()};
@@ -223,8 +276,12 @@ MOTION::PartyPtr CreateParty(const po::variables_map& vm) {
     parties_config.at(party_id) = std::make_pair(host, port);
   }
   MOTION::Communication::TCPSetupHelper helper(my_id, parties_config);
-  auto comm_layer = std::make_unique<MOTION::Communication::CommunicationLayer>(my_id, helper.setup_connections());
-  auto party = std::make_unique<MOTION::Party>(std::move(comm_layer));
+  return std::make_unique<MOTION::Communication::CommunicationLayer>(my_id,
+                                                                     helper.setup_connections());
+}
+
+MOTION::PartyPtr CreateParty(const po::variables_map& vm) {
+  auto party = std::make_unique<MOTION::Party>(CreateCommunicationLayer(vm));
   auto config = party->GetConfiguration();
   // disable logging if the corresponding flag was set
   const auto logging{!vm.count("disable-logging")};
@@ -24,12 +24,22 @@
 
 #include "benchmark_integers.h"
 
+#include <cmath>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include "algorithm/algorithm_description.h"
+#include "base/two_party_tensor_backend.h"
+#include "protocols/beavy/tensor.h"
 #include "share/share_wrapper.h"
 #include "secure_type/secure_unsigned_integer.h"
 #include "statistics/analysis.h"
 #include "statistics/run_time_stats.h"
+#include "tensor/tensor_op_factory.h"
 #include "utility/config.h"
+#include "utility/fixed_point.h"
+#include "utility/helpers.h"
 
 MOTION::Statistics::RunTimeStats EvaluateProtocol(MOTION::PartyPtr& party, std::size_t num_simd,
                                                   std::size_t bit_size,
@@ -89,3 +99,93 @@ MOTION::Statistics::RunTimeStats EvaluateProtocol(MOTION::PartyPtr& party, std::
   const auto& stats = party->GetBackend()->GetRunTimeStats();
   return stats.front();
 }
+
+namespace {
+
+template <typename T>
+MOTION::tensor::TensorCP MakeArithmeticBEAVYInput(MOTION::tensor::TensorDimensions dims,
+                                                  double value, std::size_t fractional_bits) {
+  // shares of a public value, which suffices for measuring the evaluation
+  auto t = std::make_shared<MOTION::proto::beavy::ArithmeticBEAVYTensor<T>>(dims);
+  t->get_secret_share() = std::vector<T>(dims.get_data_size(), 0);
+  t->get_public_share() = std::vector<T>(
+      dims.get_data_size(), MOTION::fixed_point::encode<T>(value, fractional_bits));
+  t->set_setup_ready();
+  t->set_online_ready();
+  return t;
+}
+
+}  // namespace
+
+MOTION::Statistics::RunTimeStats EvaluateArithmeticDivision(
+    MOTION::Communication::CommunicationLayer& comm_layer, std::size_t num_simd,
+    std::size_t fractional_bits, std::size_t num_iterations) {
+  const MOTION::tensor::TensorDimensions dims{
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = num_simd};
+  // make_tensor_div_op rejects fractional bits for which the Newton
+  // iterations would overflow the ring
+  const double max_value = 100.0;
+  const auto my_id = comm_layer.get_my_id();
+
+  MOTION::TwoPartyTensorBackend backend(comm_layer, 0, false, nullptr);
+  auto& tof = backend.get_tensor_op_factory(MOTION::MPCProtocol::ArithmeticBEAVY);
+
+  auto a = MakeArithmeticBEAVYInput<std::uint64_t>(dims, 42.0, fractional_bits);
+  auto b = MakeArithmeticBEAVYInput<std::uint64_t>(dims, 7.0, fractional_bits);
+  auto quotient = tof.make_tensor_div_op(a, b, fractional_bits, max_value, num_iterations);
+  ENCRYPTO::ReusableFiberFuture<std::vector<std::uint64_t>> output_future;
+  if (my_id == 0) {
+    output_future = tof.make_arithmetic_64_tensor_output_my(quotient);
+  } else {
+    tof.make_arithmetic_tensor_output_other(quotient);
+  }
+
+  backend.run();
+  if (my_id == 0) {
+    // check that we did not measure a computation which overflowed
+    const auto output = output_future.get();
+    for (const auto y : output) {
+      const auto value = MOTION::fixed_point::decode<std::uint64_t, double>(y, fractional_bits);
+      if (std::abs(value - 6.0) > 0.01) {
+        throw std::runtime_error(
+            fmt::format("arithmetic division computed {} instead of 6", value));
+      }
+    }
+  }
+  comm_layer.sync();
+  return backend.get_run_time_stats();
+}
+
+MOTION::Statistics::RunTimeStats EvaluateIntersection(
+    MOTION::Communication::CommunicationLayer& comm_layer, std::size_t num_rows,
+    std::size_t bit_size) {
+  const MOTION::tensor::TensorDimensions dims{
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = num_rows};
+
+  MOTION::TwoPartyTensorBackend backend(comm_layer, 0, false, nullptr);
+  auto& yao_tof = backend.get_tensor_op_factory(MOTION::MPCProtocol::Yao);
+
+  MOTION::tensor::TensorCP a, b;
+  switch (bit_size) {
+    case 32: {
+      a = MakeArithmeticBEAVYInput<std::uint32_t>(dims, 42.0, 0);
+      b = MakeArithmeticBEAVYInput<std::uint32_t>(dims, 7.0, 0);
+      break;
+    }
+    case 64: {
+      a = MakeArithmeticBEAVYInput<std::uint64_t>(dims, 42.0, 0);
+      b = MakeArithmeticBEAVYInput<std::uint64_t>(dims, 7.0, 0);
+      break;
+    }
+    default:
+      throw std::invalid_argument("Invalid bit size for intersection");
+  }
+  // the cost of the sorting network does not depend on the values
+  a = yao_tof.make_tensor_conversion(MOTION::MPCProtocol::Yao, a);
+  b = yao_tof.make_tensor_conversion(MOTION::MPCProtocol::Yao, b);
+  yao_tof.make_tensor_intersection_op(a, b);
+
+  backend.run();
+  comm_layer.sync();
+  return backend.get_run_time_stats();
+}
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "base/party.h"
+#include "communication/communication_layer.h"
 #include "statistics/run_time_stats.h"
 #include "utility/typedefs.h"
 
@@ -32,3 +33,16 @@ MOTION::Statistics::RunTimeStats EvaluateProtocol(MOTION::PartyPtr& party, std::
                                                   std::size_t bit_size,
                                                   MOTION::MPCProtocol protocol,
                                                   ENCRYPTO::IntegerOperationType op_type);
+
+// Evaluates the Newton-Raphson based division on arithmetic BEAVY shares using
+// fixed-point numbers in the 64 bit ring, as alternative to the Boolean
+// division circuits.  Throws if the result is not correct.
+MOTION::Statistics::RunTimeStats EvaluateArithmeticDivision(
+    MOTION::Communication::CommunicationLayer& comm_layer, std::size_t num_simd,
+    std::size_t fractional_bits, std::size_t num_iterations);
+
+// Evaluates the sorting based private set intersection of two sets with
+// num_rows elements each in Yao.
+MOTION::Statistics::RunTimeStats EvaluateIntersection(
+    MOTION::Communication::CommunicationLayer& comm_layer, std::size_t num_rows,
+    std::size_t bit_size);
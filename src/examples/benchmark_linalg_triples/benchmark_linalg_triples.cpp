@@ -0,0 +1,204 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compares the generation of GEMM and Conv2D triples with OTs and with the
+// HE-based backend for the linear layers of LeNet and CryptoNets.  Both
+// parties run in the same process, the reported time includes the OT
+// extension setup but not the base OTs.  Besides the measured time and the
+// number of bytes sent by both parties, the estimates of the cost model of
+// LinAlgTriplesFromHE are reported as counters.  The peak RSS counter is the
+// maximum of the whole process, so run one benchmark per process (with
+// --benchmark_filter) to get the peak of a single layer.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <sys/resource.h>
+#include <benchmark/benchmark.h>
+#include "communication/communication_layer.h"
+#include "communication/transport.h"
+#include "crypto/arithmetic_provider.h"
+#include "crypto/base_ots/base_ot_provider.h"
+#include "crypto/motion_base_provider.h"
+#include "crypto/multiplication_triple/linalg_triple_provider.h"
+#include "crypto/oblivious_transfer/ot_provider.h"
+#include "statistics/run_time_stats.h"
+#include "tensor/tensor_op.h"
+#include "utility/type_traits.hpp"
+
+namespace {
+
+using LayerOp = std::variant<MOTION::tensor::GemmOp, MOTION::tensor::Conv2DOp>;
+
+const std::vector<LayerOp> layers = {
+    // CryptoNets
+    MOTION::tensor::Conv2DOp{.kernel_shape_ = {5, 1, 5, 5},
+                             .input_shape_ = {1, 28, 28},
+                             .output_shape_ = {5, 13, 13},
+                             .dilations_ = {1, 1},
+                             .pads_ = {1, 1, 0, 0},
+                             .strides_ = {2, 2}},
+    MOTION::tensor::GemmOp{
+        .input_A_shape_ = {1, 845}, .input_B_shape_ = {845, 100}, .output_shape_ = {1, 100}},
+    MOTION::tensor::GemmOp{
+        .input_A_shape_ = {1, 100}, .input_B_shape_ = {100, 10}, .output_shape_ = {1, 10}},
+    // LeNet
+    MOTION::tensor::Conv2DOp{.kernel_shape_ = {20, 1, 5, 5},
+                             .input_shape_ = {1, 28, 28},
+                             .output_shape_ = {20, 24, 24},
+                             .dilations_ = {1, 1},
+                             .pads_ = {0, 0, 0, 0},
+                             .strides_ = {1, 1}},
+    MOTION::tensor::Conv2DOp{.kernel_shape_ = {50, 20, 5, 5},
+                             .input_shape_ = {20, 12, 12},
+                             .output_shape_ = {50, 8, 8},
+                             .dilations_ = {1, 1},
+                             .pads_ = {0, 0, 0, 0},
+                             .strides_ = {1, 1}},
+    MOTION::tensor::GemmOp{
+        .input_A_shape_ = {1, 800}, .input_B_shape_ = {800, 500}, .output_shape_ = {1, 500}},
+    MOTION::tensor::GemmOp{
+        .input_A_shape_ = {1, 500}, .input_B_shape_ = {500, 10}, .output_shape_ = {1, 10}},
+};
+
+// peak resident set size of this process in KiB
+std::size_t get_peak_rss() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+}  // namespace
+
+// Arguments: index of the layer in `layers`, and whether HE is used
+static void BM_linalg_triples(benchmark::State& state) {
+  using T = std::uint32_t;
+  const auto& layer = layers.at(state.range(0));
+  MOTION::LinAlgHEConfig config;
+  config.selection = state.range(1) ? MOTION::LinAlgHEConfig::Selection::always
+                                    : MOTION::LinAlgHEConfig::Selection::never;
+  std::size_t num_bytes = 0;
+
+  for (auto _ : state) {
+    auto comm_layers = MOTION::Communication::make_dummy_communication_layers(2);
+    std::vector<std::unique_ptr<MOTION::BaseOTProvider>> base_ot_providers(2);
+    std::vector<std::unique_ptr<MOTION::Crypto::MotionBaseProvider>> motion_base_providers(2);
+    std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::OTProviderManager>> ot_managers(2);
+    std::vector<std::unique_ptr<MOTION::ArithmeticProviderManager>> arithmetic_managers(2);
+    std::vector<std::unique_ptr<MOTION::LinAlgTriplesFromHE>> linalg_providers(2);
+    std::array<MOTION::Statistics::RunTimeStats, 2> stats;
+    for (std::size_t i = 0; i < 2; ++i) {
+      base_ot_providers[i] =
+          std::make_unique<MOTION::BaseOTProvider>(*comm_layers[i], nullptr, nullptr);
+      motion_base_providers[i] =
+          std::make_unique<MOTION::Crypto::MotionBaseProvider>(*comm_layers[i], nullptr);
+      ot_managers[i] = std::make_unique<ENCRYPTO::ObliviousTransfer::OTProviderManager>(
+          *comm_layers[i], *base_ot_providers[i], *motion_base_providers[i], nullptr, nullptr);
+      arithmetic_managers[i] = std::make_unique<MOTION::ArithmeticProviderManager>(
+          *comm_layers[i], *ot_managers[i], nullptr);
+      linalg_providers[i] = std::make_unique<MOTION::LinAlgTriplesFromHE>(
+          *comm_layers[i], arithmetic_managers[i]->get_provider(1 - i),
+          ot_managers[i]->get_provider(1 - i), stats[i], nullptr, config);
+    }
+
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [&, i] {
+        comm_layers[i]->start();
+        motion_base_providers[i]->setup();
+        base_ot_providers[i]->ComputeBaseOTs();
+      }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+    futs.clear();
+
+    for (std::size_t i = 0; i < 2; ++i) {
+      std::visit(
+          [&](const auto& op) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(op)>, MOTION::tensor::GemmOp>) {
+              linalg_providers[i]->register_for_gemm_triple<T>(op);
+            } else {
+              linalg_providers[i]->register_for_conv2d_triple<T>(op);
+            }
+          },
+          layer);
+      comm_layers[i]->reset_transport_statistics();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [&, i] {
+        auto& ot_provider = ot_managers[i]->get_provider(1 - i);
+        auto send_fut = std::async(std::launch::async, [&] { ot_provider.SendSetup(); });
+        ot_provider.ReceiveSetup();
+        send_fut.get();
+        linalg_providers[i]->setup();
+      }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    state.SetIterationTime(elapsed.count());
+    futs.clear();
+
+    num_bytes = 0;
+    for (std::size_t i = 0; i < 2; ++i) {
+      for (const auto& transport_statistics : comm_layers[i]->get_transport_statistics()) {
+        num_bytes += transport_statistics.num_bytes_sent;
+      }
+    }
+
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [&, i] { comm_layers[i]->shutdown(); }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  const auto dimensions = std::visit(
+      [](const auto& op) { return MOTION::LinAlgTriplesFromHE::get_matrix_dimensions(op); },
+      layer);
+  state.counters["l"] = dimensions[0];
+  state.counters["m"] = dimensions[1];
+  state.counters["n"] = dimensions[2];
+  state.counters["bytes_sent"] = num_bytes;
+  state.counters["peak_rss_kib"] = get_peak_rss();
+  const auto ot_estimate =
+      MOTION::LinAlgTriplesFromHE::estimate_ot_cost(dimensions, ENCRYPTO::bit_size_v<T>, config);
+  state.counters["ot_estimated_bytes"] = ot_estimate.bytes;
+  state.counters["ot_estimated_ms"] = 1e3 * ot_estimate.seconds;
+  const auto he_estimate =
+      MOTION::LinAlgTriplesFromHE::estimate_he_cost(dimensions, ENCRYPTO::bit_size_v<T>, config);
+  if (he_estimate.has_value()) {
+    state.counters["he_estimated_bytes"] = he_estimate->bytes;
+    state.counters["he_estimated_ms"] = 1e3 * he_estimate->seconds;
+  }
+}
+BENCHMARK(BM_linalg_triples)
+    ->ArgNames({"layer", "he"})
+    ->ArgsProduct({{0, 1, 2, 3, 4, 5, 6}, {0, 1}})
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
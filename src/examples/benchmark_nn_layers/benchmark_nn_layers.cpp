@@ -29,6 +29,7 @@
 #include <stdexcept>
 #include <string>
 
+#include <sys/resource.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/json/serialize.hpp>
@@ -56,6 +57,9 @@ struct Options {
   std::size_t num_threads;
   std::size_t num_repetitions;
   bool sync_between_setup_and_online;
+  bool speculative_online;
+  std::optional<std::uint64_t> trusted_dealer_seed;
+  std::optional<MOTION::LinAlgHEConfig> linalg_he_config;
   std::size_t bit_size;
   std::size_t fractional_bits;
   std::size_t my_id;
@@ -64,6 +68,7 @@ struct Options {
   std::string benchmark;
   std::size_t relu_variant;
   std::size_t relu_size;
+  std::size_t reshape_size;
 };
 
 std::optional<Options> parse_program_options(int argc, char* argv[]) {
@@ -81,9 +86,17 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("benchmark", po::value<std::string>()->required(), "benchmark name")
     ("relu-variant", po::value<std::size_t>(), "variant of ReLU layer")
     ("relu-size", po::value<std::size_t>(), "size of ReLU layer")
+    ("reshape-size", po::value<std::size_t>(), "size of the Flatten/Reshape/Split input")
     ("repetitions", po::value<std::size_t>()->default_value(1), "number of repetitions")
     ("sync-between-setup-and-online", po::bool_switch()->default_value(false),
      "run a synchronization protocol before the online phase starts")
+    ("speculative-online", po::bool_switch()->default_value(false),
+     "start the online phase concurrently to the setup phase")
+    ("trusted-dealer-seed", po::value<std::uint64_t>(),
+     "derive all correlated randomness from this seed without communication (insecure, "
+     "for measuring the online phase)")
+    ("linalg-he", po::value<std::string>()->default_value("off"),
+     "generate the GEMM/Conv2D triples with linear HE (off, cost-model, or always)")
     ("bit-size", po::value<std::size_t>()->default_value(64),
      "number of bits per number (32 or 64)")
     ("fractional-bits", po::value<std::size_t>()->default_value(16),
@@ -115,6 +128,29 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.json = vm["json"].as<bool>();
   options.num_repetitions = vm["repetitions"].as<std::size_t>();
   options.sync_between_setup_and_online = vm["sync-between-setup-and-online"].as<bool>();
+  options.speculative_online = vm["speculative-online"].as<bool>();
+  if (options.speculative_online && options.sync_between_setup_and_online) {
+    std::cerr << "--speculative-online cannot be combined with --sync-between-setup-and-online\n";
+    return std::nullopt;
+  }
+  if (vm.count("trusted-dealer-seed")) {
+    options.trusted_dealer_seed = vm["trusted-dealer-seed"].as<std::uint64_t>();
+  }
+  auto linalg_he = vm["linalg-he"].as<std::string>();
+  boost::algorithm::to_lower(linalg_he);
+  if (linalg_he == "cost-model") {
+    options.linalg_he_config = MOTION::LinAlgHEConfig{};
+  } else if (linalg_he == "always") {
+    options.linalg_he_config = MOTION::LinAlgHEConfig{};
+    options.linalg_he_config->selection = MOTION::LinAlgHEConfig::Selection::always;
+  } else if (linalg_he != "off") {
+    std::cerr << "invalid value for --linalg-he: " << linalg_he << "\n";
+    return std::nullopt;
+  }
+  if (options.linalg_he_config && options.trusted_dealer_seed) {
+    std::cerr << "--linalg-he cannot be combined with --trusted-dealer-seed\n";
+    return std::nullopt;
+  }
   options.bit_size = vm["bit-size"].as<std::size_t>();
   options.fractional_bits = vm["fractional-bits"].as<std::size_t>();
 
@@ -128,6 +164,17 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     options.relu_variant = vm["relu-variant"].as<std::size_t>();
     options.relu_size = vm["relu-size"].as<std::size_t>();
     options.experiment_name = fmt::format("relu-{}-{}", options.relu_variant, options.relu_size);
+  } else if (options.benchmark == "reshape") {
+    if (vm.count("reshape-size") == 0) {
+      std::cerr << "Reshape benchmark needs argument --reshape-size\n";
+      return std::nullopt;
+    }
+    options.reshape_size = vm["reshape-size"].as<std::size_t>();
+    if (options.reshape_size < 10) {
+      std::cerr << "--reshape-size needs to be at least 10 for the Split\n";
+      return std::nullopt;
+    }
+    options.experiment_name = fmt::format("reshape-{}", options.reshape_size);
   } else {
     std::cerr << "unknown benchmark: " << options.benchmark << "\n";
     return std::nullopt;
@@ -248,14 +295,45 @@ void prepare_relu(const Options& options, MOTION::TwoPartyTensorBackend& backend
   }
 }
 
+// Flatten -> Reshape -> Split as in the output layers of the ONNX CNNs, to
+// compare the time and memory of the share views with copying gates
+void prepare_reshape(const Options& options, MOTION::TwoPartyTensorBackend& backend) {
+  MOTION::tensor::TensorDimensions dims{
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = options.reshape_size};
+  const auto protocol = MOTION::MPCProtocol::ArithmeticBEAVY;
+  auto input_tensor = [&options, protocol, &dims] {
+    switch (options.bit_size) {
+      case 64:
+        return make_input_share<std::uint64_t>(protocol, dims);
+      case 32:
+        return make_input_share<std::uint32_t>(protocol, dims);
+      default:
+        throw std::invalid_argument("unexpected bit size");
+    }
+  }();
+  auto& factory = backend.get_tensor_op_factory(protocol);
+  auto flat_tensor = factory.make_tensor_flatten_op(input_tensor, 1);
+  auto reshaped_tensor = factory.make_tensor_reshape_op(flat_tensor, dims);
+  auto output_tensors = factory.make_tensor_split_op(reshaped_tensor);
+}
+
 void run_benchmark(const Options& options, MOTION::TwoPartyTensorBackend& backend) {
   if (options.benchmark == "relu") {
     prepare_relu(options, backend);
+  } else if (options.benchmark == "reshape") {
+    prepare_reshape(options, backend);
   }
 
   backend.run();
 }
 
+// peak resident set size of this process in KiB
+std::size_t get_peak_rss() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
 void print_stats(const Options& options,
                  const MOTION::Statistics::AccumulatedRunTimeStats& run_time_stats,
                  const MOTION::Statistics::AccumulatedCommunicationStats& comm_stats) {
@@ -264,16 +342,23 @@ void print_stats(const Options& options,
     obj.emplace("party_id", options.my_id);
     obj.emplace("threads", options.num_threads);
     obj.emplace("sync_between_setup_and_online", options.sync_between_setup_and_online);
+    obj.emplace("speculative_online", options.speculative_online);
+    obj.emplace("trusted_dealer", options.trusted_dealer_seed.has_value());
+    obj.emplace("linalg_he", options.linalg_he_config.has_value());
     obj.emplace("bit-size", options.bit_size);
     obj.emplace("benchmark", options.benchmark);
     if (options.benchmark == "relu") {
       obj.emplace("relu-variant", options.relu_variant);
       obj.emplace("relu-size", options.relu_size);
+    } else if (options.benchmark == "reshape") {
+      obj.emplace("reshape-size", options.reshape_size);
     }
+    obj.emplace("peak_rss_kib", get_peak_rss());
     std::cout << obj << "\n";
   } else {
     std::cout << MOTION::Statistics::print_stats(options.experiment_name, run_time_stats,
                                                  comm_stats);
+    std::cout << fmt::format("Peak RSS: {} KiB\n", get_peak_rss());
   }
 }
 
@@ -292,7 +377,10 @@ int main(int argc, char* argv[]) {
     MOTION::Statistics::AccumulatedCommunicationStats comm_stats;
     for (std::size_t i = 0; i < options->num_repetitions; ++i) {
       MOTION::TwoPartyTensorBackend backend(*comm_layer, options->num_threads,
-                                            options->sync_between_setup_and_online, logger);
+                                            options->sync_between_setup_and_online, logger,
+                                            false, options->trusted_dealer_seed,
+                                            options->linalg_he_config);
+      backend.set_speculative_online(options->speculative_online);
       run_benchmark(*options, backend);
       comm_layer->sync();
       comm_stats.add(comm_layer->get_transport_statistics());
@@ -0,0 +1,98 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measures the throughput of the OT extension setup between two parties in
+// the same process depending on the number of threads used for expanding the
+// base OT seeds and for transposing and hashing the matrix.  The time of the
+// base OTs is not included.
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "communication/communication_layer.h"
+#include "crypto/base_ots/base_ot_provider.h"
+#include "crypto/motion_base_provider.h"
+#include "crypto/oblivious_transfer/ot_flavors.h"
+#include "crypto/oblivious_transfer/ot_provider.h"
+
+static void BM_ot_extension_setup(benchmark::State& state) {
+  const std::size_t num_ots = state.range(0);
+  const std::size_t num_threads = state.range(1);
+  double total_seconds = 0.0;
+
+  for (auto _ : state) {
+    auto comm_layers = MOTION::Communication::make_dummy_communication_layers(2);
+    std::vector<std::unique_ptr<MOTION::BaseOTProvider>> base_ot_providers(2);
+    std::vector<std::unique_ptr<MOTION::Crypto::MotionBaseProvider>> motion_base_providers(2);
+    std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::OTProviderManager>> ot_managers(2);
+    for (std::size_t i = 0; i < 2; ++i) {
+      base_ot_providers[i] =
+          std::make_unique<MOTION::BaseOTProvider>(*comm_layers[i], nullptr, nullptr);
+      motion_base_providers[i] =
+          std::make_unique<MOTION::Crypto::MotionBaseProvider>(*comm_layers[i], nullptr);
+      ot_managers[i] = std::make_unique<ENCRYPTO::ObliviousTransfer::OTProviderManager>(
+          *comm_layers[i], *base_ot_providers[i], *motion_base_providers[i], nullptr, nullptr);
+      ot_managers[i]->set_num_threads(num_threads);
+    }
+
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [&, i] {
+        comm_layers[i]->start();
+        motion_base_providers[i]->setup();
+        base_ot_providers[i]->ComputeBaseOTs();
+      }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+    futs.clear();
+
+    // party 0 is the sender, party 1 the receiver
+    auto ot_sender = ot_managers[0]->get_provider(1).RegisterSendROT(num_ots);
+    auto ot_receiver = ot_managers[1]->get_provider(0).RegisterReceiveROT(num_ots);
+
+    const auto start = std::chrono::steady_clock::now();
+    futs.emplace_back(std::async(std::launch::async,
+                                 [&] { ot_managers[0]->get_provider(1).SendSetup(); }));
+    futs.emplace_back(std::async(std::launch::async,
+                                 [&] { ot_managers[1]->get_provider(0).ReceiveSetup(); }));
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    state.SetIterationTime(elapsed.count());
+    total_seconds += elapsed.count();
+    futs.clear();
+
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [&, i] { comm_layers[i]->shutdown(); }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+  state.counters["ots_per_second"] = state.iterations() * num_ots / total_seconds;
+}
+BENCHMARK(BM_ot_extension_setup)
+    ->ArgNames({"num_ots", "threads"})
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1, 2, 4, 8, 16, 32}})
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
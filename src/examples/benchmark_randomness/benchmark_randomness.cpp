@@ -0,0 +1,62 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "crypto/random/aes128_ctr_rng.h"
+#include "crypto/sharing_randomness_generator.h"
+
+template <typename T>
+static void BM_sharing_randomness(benchmark::State& state) {
+  std::array<std::byte, MOTION::Crypto::SharingRandomnessGenerator::MASTER_SEED_BYTE_LENGTH> seed;
+  AES128_CTR_RNG::get_thread_instance().random_bytes(seed.data(), seed.size());
+  MOTION::Crypto::SharingRandomnessGenerator rng(0);
+  rng.Initialize(seed.data());
+  const std::size_t num_values = state.range(0);
+  std::vector<T> output(num_values);
+  std::size_t gate_id = 0;
+
+  for (auto _ : state) {
+    rng.GetUnsigned<T>(gate_id, num_values, output.data());
+    benchmark::DoNotOptimize(output.data());
+    gate_id += num_values;
+  }
+  state.counters["values_per_second"] =
+      benchmark::Counter(state.iterations() * num_values, benchmark::Counter::kIsRate);
+  state.SetBytesProcessed(state.iterations() * sizeof(T) * num_values);
+}
+BENCHMARK_TEMPLATE(BM_sharing_randomness, std::uint8_t)
+    ->RangeMultiplier(1 << 4)
+    ->Range(1, 1 << 20);
+BENCHMARK_TEMPLATE(BM_sharing_randomness, std::uint16_t)
+    ->RangeMultiplier(1 << 4)
+    ->Range(1, 1 << 20);
+BENCHMARK_TEMPLATE(BM_sharing_randomness, std::uint32_t)
+    ->RangeMultiplier(1 << 4)
+    ->Range(1, 1 << 20);
+BENCHMARK_TEMPLATE(BM_sharing_randomness, std::uint64_t)
+    ->RangeMultiplier(1 << 4)
+    ->Range(1, 1 << 20);
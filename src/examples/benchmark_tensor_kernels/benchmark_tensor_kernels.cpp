@@ -0,0 +1,197 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Compares the specialized kernels of protocols/beavy/tensor_kernels.h with
+// the previous generic loops, which branch on the party role inside the loop,
+// access the Boolean shares bit by bit, and iterate over the bits innermost.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "protocols/beavy/tensor_kernels.h"
+#include "utility/bit_vector.h"
+
+using namespace MOTION::proto::beavy;
+
+template <typename T>
+static std::vector<T> random_vector(std::size_t size, bool bits_only = false) {
+  std::mt19937_64 gen(size);
+  std::vector<T> v(size);
+  for (auto& x : v) {
+    x = bits_only ? (gen() & 1) : gen();
+  }
+  return v;
+}
+
+template <typename T>
+static void BM_unpack_bits_generic(benchmark::State& state) {
+  const std::size_t data_size = state.range(0);
+  const auto bits = ENCRYPTO::BitVector<>::Random(data_size);
+  std::vector<T> output(data_size);
+  for (auto _ : state) {
+    for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+      output[int_i] = bits.Get(int_i);
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * data_size);
+}
+
+template <typename T>
+static void BM_unpack_bits_specialized(benchmark::State& state) {
+  const std::size_t data_size = state.range(0);
+  const auto bits = ENCRYPTO::BitVector<>::Random(data_size);
+  std::vector<T> output(data_size);
+  for (auto _ : state) {
+    kernels::unpack_bits(bits, output.data());
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * data_size);
+}
+
+template <typename T>
+static void BM_boolean_to_arithmetic_generic(benchmark::State& state) {
+  const std::size_t data_size = state.range(0);
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<T>;
+  const bool my_job = state.range(1);
+  const auto public_bits = random_vector<T>(bit_size * data_size, true);
+  const auto secret_bits = random_vector<T>(bit_size * data_size);
+  std::vector<T> output(data_size);
+  for (auto _ : state) {
+#pragma omp parallel for
+    for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+      for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+        const auto p = public_bits[bit_j * data_size + int_i];
+        const auto s = secret_bits[bit_j * data_size + int_i];
+        if (my_job) {
+          output[int_i] += (p + (1 - 2 * p) * s) << bit_j;
+        } else {
+          output[int_i] += ((1 - 2 * p) * s) << bit_j;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * data_size);
+}
+
+template <typename T>
+static void BM_boolean_to_arithmetic_specialized(benchmark::State& state) {
+  const std::size_t data_size = state.range(0);
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<T>;
+  const bool my_job = state.range(1);
+  const auto public_bits = random_vector<T>(bit_size * data_size, true);
+  const auto secret_bits = random_vector<T>(bit_size * data_size);
+  std::vector<T> output(data_size);
+  for (auto _ : state) {
+    if (my_job) {
+      kernels::boolean_to_arithmetic<T, true>(public_bits.data(), secret_bits.data(),
+                                              output.data(), data_size);
+    } else {
+      kernels::boolean_to_arithmetic<T, false>(public_bits.data(), secret_bits.data(),
+                                               output.data(), data_size);
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * data_size);
+}
+
+template <typename T>
+static void BM_relu_generic(benchmark::State& state) {
+  const std::size_t data_size = state.range(0);
+  const bool my_job = state.range(1);
+  const auto msb = ENCRYPTO::BitVector<>::Random(data_size);
+  const auto Delta_n = random_vector<T>(data_size);
+  const auto delta_n = random_vector<T>(data_size);
+  const auto delta_b = random_vector<T>(data_size);
+  const auto delta_b_x_delta_n = random_vector<T>(data_size);
+  const auto delta_y = random_vector<T>(data_size);
+  std::vector<T> output(data_size);
+  for (auto _ : state) {
+#pragma omp parallel for
+    for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+      T Delta_b = !msb.Get(int_i);
+      auto n = Delta_n[int_i];
+      output[int_i] = delta_b[int_i] * (n - 2 * Delta_b * n) - Delta_b * delta_n[int_i] -
+                      delta_b_x_delta_n[int_i] * (1 - 2 * Delta_b) + delta_y[int_i];
+      if (my_job) {
+        output[int_i] += Delta_b * n;
+      }
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * data_size);
+}
+
+template <typename T>
+static void BM_relu_specialized(benchmark::State& state) {
+  const std::size_t data_size = state.range(0);
+  const bool my_job = state.range(1);
+  const auto msb = ENCRYPTO::BitVector<>::Random(data_size);
+  const auto Delta_n = random_vector<T>(data_size);
+  const auto delta_n = random_vector<T>(data_size);
+  const auto delta_b = random_vector<T>(data_size);
+  const auto delta_b_x_delta_n = random_vector<T>(data_size);
+  const auto delta_y = random_vector<T>(data_size);
+  std::vector<T> Delta_b(data_size);
+  std::vector<T> output(data_size);
+  for (auto _ : state) {
+    kernels::unpack_bits<T, true>(msb, Delta_b.data());
+    if (my_job) {
+      kernels::relu_public_share<T, true>(Delta_b.data(), Delta_n.data(), delta_b.data(),
+                                          delta_n.data(), delta_b_x_delta_n.data(),
+                                          delta_y.data(), output.data(), data_size);
+    } else {
+      kernels::relu_public_share<T, false>(Delta_b.data(), Delta_n.data(), delta_b.data(),
+                                           delta_n.data(), delta_b_x_delta_n.data(),
+                                           delta_y.data(), output.data(), data_size);
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * data_size);
+}
+
+#define MOTION_BENCHMARK_KERNEL(name)                                                   \
+  BENCHMARK_TEMPLATE(name, std::uint32_t)->RangeMultiplier(1 << 4)->Range(1 << 8, 1 << 20); \
+  BENCHMARK_TEMPLATE(name, std::uint64_t)->RangeMultiplier(1 << 4)->Range(1 << 8, 1 << 20);
+
+#define MOTION_BENCHMARK_ROLE_KERNEL(name)                                      \
+  BENCHMARK_TEMPLATE(name, std::uint32_t)                                       \
+      ->ArgsProduct({benchmark::CreateRange(1 << 8, 1 << 20, 1 << 4), {0, 1}}); \
+  BENCHMARK_TEMPLATE(name, std::uint64_t)                                       \
+      ->ArgsProduct({benchmark::CreateRange(1 << 8, 1 << 20, 1 << 4), {0, 1}});
+
+MOTION_BENCHMARK_KERNEL(BM_unpack_bits_generic)
+MOTION_BENCHMARK_KERNEL(BM_unpack_bits_specialized)
+MOTION_BENCHMARK_ROLE_KERNEL(BM_boolean_to_arithmetic_generic)
+MOTION_BENCHMARK_ROLE_KERNEL(BM_boolean_to_arithmetic_specialized)
+MOTION_BENCHMARK_ROLE_KERNEL(BM_relu_generic)
+MOTION_BENCHMARK_ROLE_KERNEL(BM_relu_specialized)
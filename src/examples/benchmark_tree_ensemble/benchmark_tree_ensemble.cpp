@@ -0,0 +1,325 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <stdexcept>
+#include <string>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/program_options.hpp>
+
+#include "algorithm/tree_ensemble.h"
+#include "base/two_party_tensor_backend.h"
+#include "communication/communication_layer.h"
+#include "communication/tcp_transport.h"
+#include "protocols/beavy/tensor.h"
+#include "protocols/gmw/tensor.h"
+#include "statistics/analysis.h"
+#include "tensor/tensor.h"
+#include "tensor/tensor_op.h"
+#include "tensor/tensor_op_factory.h"
+#include "tensor/tree_ensemble_inference.h"
+#include "utility/helpers.h"
+#include "utility/logger.h"
+#include "utility/typedefs.h"
+
+namespace po = boost::program_options;
+
+struct Options {
+  bool json;
+  std::size_t num_threads;
+  std::size_t num_repetitions;
+  bool sync_between_setup_and_online;
+  bool speculative_online;
+  std::optional<std::uint64_t> trusted_dealer_seed;
+  std::size_t bit_size;
+  std::size_t my_id;
+  MOTION::Communication::tcp_parties_config tcp_config;
+  std::string experiment_name;
+  MOTION::MPCProtocol arithmetic_protocol;
+  std::optional<std::string> model_file;
+  std::size_t depth;
+  std::size_t num_trees;
+  std::size_t num_features;
+  std::size_t num_queries;
+};
+
+std::optional<Options> parse_program_options(int argc, char* argv[]) {
+  Options options;
+  boost::program_options::options_description desc("Allowed options");
+  // clang-format off
+  desc.add_options()
+    ("help,h", po::bool_switch()->default_value(false),"produce help message")
+    ("config-file", po::value<std::string>(), "config file containing options")
+    ("my-id", po::value<std::size_t>()->required(), "my party id")
+    ("party", po::value<std::vector<std::string>>()->multitoken(),
+     "(party id, IP, port), e.g., --party 1,127.0.0.1,7777")
+    ("threads", po::value<std::size_t>()->default_value(0), "number of threads to use for gate evaluation")
+    ("json", po::bool_switch()->default_value(false), "output data in JSON format")
+    ("arithmetic-protocol", po::value<std::string>()->default_value("gmw"),
+     "protocol for the aggregation of the leaf values (gmw or beavy)")
+    ("model", po::value<std::string>(), "file containing a tree ensemble; "
+     "overrides --depth, --num-trees, and --num-features")
+    ("depth", po::value<std::size_t>()->default_value(8), "depth of the random trees, e.g., 4 to 16")
+    ("num-trees", po::value<std::size_t>()->default_value(1), "number of random trees")
+    ("num-features", po::value<std::size_t>()->default_value(16), "number of features")
+    ("num-queries", po::value<std::size_t>()->default_value(1),
+     "number of queries evaluated in parallel")
+    ("repetitions", po::value<std::size_t>()->default_value(1), "number of repetitions")
+    ("sync-between-setup-and-online", po::bool_switch()->default_value(false),
+     "run a synchronization protocol before the online phase starts")
+    ("speculative-online", po::bool_switch()->default_value(false),
+     "start the online phase concurrently to the setup phase")
+    ("trusted-dealer-seed", po::value<std::uint64_t>(),
+     "derive all correlated randomness from this seed without communication (insecure, "
+     "for measuring the online phase)")
+    ("bit-size", po::value<std::size_t>()->default_value(64),
+     "number of bits per number (32 or 64)")
+    ;
+  // clang-format on
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  bool help = vm["help"].as<bool>();
+  if (help) {
+    std::cerr << desc << "\n";
+    return std::nullopt;
+  }
+  if (vm.count("config-file")) {
+    std::ifstream ifs(vm["config-file"].as<std::string>().c_str());
+    po::store(po::parse_config_file(ifs, desc), vm);
+  }
+  try {
+    po::notify(vm);
+  } catch (std::exception& e) {
+    std::cerr << "error:" << e.what() << "\n\n";
+    std::cerr << desc << "\n";
+    return std::nullopt;
+  }
+
+  options.my_id = vm["my-id"].as<std::size_t>();
+  options.num_threads = vm["threads"].as<std::size_t>();
+  options.json = vm["json"].as<bool>();
+  options.num_repetitions = vm["repetitions"].as<std::size_t>();
+  options.sync_between_setup_and_online = vm["sync-between-setup-and-online"].as<bool>();
+  options.speculative_online = vm["speculative-online"].as<bool>();
+  if (options.speculative_online && options.sync_between_setup_and_online) {
+    std::cerr << "--speculative-online cannot be combined with --sync-between-setup-and-online\n";
+    return std::nullopt;
+  }
+  if (vm.count("trusted-dealer-seed")) {
+    options.trusted_dealer_seed = vm["trusted-dealer-seed"].as<std::uint64_t>();
+  }
+  options.bit_size = vm["bit-size"].as<std::size_t>();
+  if (options.bit_size != 32 && options.bit_size != 64) {
+    std::cerr << "bit-size must be one of 32 and 64\n";
+    return std::nullopt;
+  }
+  options.depth = vm["depth"].as<std::size_t>();
+  options.num_trees = vm["num-trees"].as<std::size_t>();
+  options.num_features = vm["num-features"].as<std::size_t>();
+  options.num_queries = vm["num-queries"].as<std::size_t>();
+  if (vm.count("model")) {
+    options.model_file = vm["model"].as<std::string>();
+  }
+
+  auto arithmetic_protocol = vm["arithmetic-protocol"].as<std::string>();
+  boost::algorithm::to_lower(arithmetic_protocol);
+  if (arithmetic_protocol == "gmw") {
+    options.arithmetic_protocol = MOTION::MPCProtocol::ArithmeticGMW;
+  } else if (arithmetic_protocol == "beavy") {
+    options.arithmetic_protocol = MOTION::MPCProtocol::ArithmeticBEAVY;
+  } else {
+    std::cerr << "unknown arithmetic protocol: " << arithmetic_protocol << "\n";
+    return std::nullopt;
+  }
+
+  if (options.my_id > 1) {
+    std::cerr << "my-id must be one of 0 and 1\n";
+    return std::nullopt;
+  }
+
+  const auto parse_party_argument =
+      [](const auto& s) -> std::pair<std::size_t, MOTION::Communication::tcp_connection_config> {
+    const static std::regex party_argument_re("([01]),([^,]+),(\\d{1,5})");
+    std::smatch match;
+    if (!std::regex_match(s, match, party_argument_re)) {
+      throw std::invalid_argument("invalid party argument");
+    }
+    auto id = boost::lexical_cast<std::size_t>(match[1]);
+    auto host = match[2];
+    auto port = boost::lexical_cast<std::uint16_t>(match[3]);
+    return {id, {host, port}};
+  };
+
+  const std::vector<std::string> party_infos = vm["party"].as<std::vector<std::string>>();
+  if (party_infos.size() != 2) {
+    std::cerr << "expecting two --party options\n";
+    return std::nullopt;
+  }
+
+  options.tcp_config.resize(2);
+  std::size_t other_id = 2;
+
+  const auto [id0, conn_info0] = parse_party_argument(party_infos[0]);
+  const auto [id1, conn_info1] = parse_party_argument(party_infos[1]);
+  if (id0 == id1) {
+    std::cerr << "need party arguments for party 0 and 1\n";
+    return std::nullopt;
+  }
+  options.tcp_config[id0] = conn_info0;
+  options.tcp_config[id1] = conn_info1;
+
+  return options;
+}
+
+std::unique_ptr<MOTION::Communication::CommunicationLayer> setup_communication(
+    const Options& options) {
+  MOTION::Communication::TCPSetupHelper helper(options.my_id, options.tcp_config);
+  return std::make_unique<MOTION::Communication::CommunicationLayer>(options.my_id,
+                                                                     helper.setup_connections());
+}
+
+template <typename T>
+auto make_input_share(MOTION::MPCProtocol protocol, MOTION::tensor::TensorDimensions dims) {
+  if (protocol == MOTION::MPCProtocol::ArithmeticGMW) {
+    auto t = std::make_shared<MOTION::proto::gmw::ArithmeticGMWTensor<T>>(dims);
+    t->get_share() = MOTION::Helpers::RandomVector<T>(dims.get_data_size());
+    t->set_online_ready();
+    return std::dynamic_pointer_cast<const MOTION::tensor::Tensor>(t);
+  } else if (protocol == MOTION::MPCProtocol::ArithmeticBEAVY) {
+    auto t = std::make_shared<MOTION::proto::beavy::ArithmeticBEAVYTensor<T>>(dims);
+    t->get_secret_share() = MOTION::Helpers::RandomVector<T>(dims.get_data_size());
+    t->get_public_share() = std::vector<T>(dims.get_data_size(), 0x42);
+    t->set_setup_ready();
+    t->set_online_ready();
+    return std::dynamic_pointer_cast<const MOTION::tensor::Tensor>(t);
+  } else {
+    throw std::invalid_argument("unexpected protocol");
+  }
+}
+
+// Both parties need to know the structure of the model, so the random model is
+// generated from a fixed seed.  Only its structure is used, the thresholds and
+// leaf values are random shares.
+MOTION::TreeEnsemble load_model(const Options& options) {
+  if (options.model_file.has_value()) {
+    return MOTION::TreeEnsemble::from_file(*options.model_file);
+  }
+  return MOTION::TreeEnsemble::make_random(options.num_trees, options.depth,
+                                           options.num_features, options.bit_size);
+}
+
+void run_benchmark(const Options& options, const MOTION::TreeEnsemble& model,
+                   MOTION::TwoPartyTensorBackend& backend) {
+  const auto features_dims =
+      MOTION::tensor::get_tree_ensemble_features_dims(model, options.num_queries);
+  const auto thresholds_dims = MOTION::tensor::get_tree_ensemble_thresholds_dims(model);
+  const auto leaf_values_dims = MOTION::tensor::get_tree_ensemble_leaf_values_dims(model);
+  const auto make_input = [&options](const auto& dims) {
+    switch (options.bit_size) {
+      case 64:
+        return make_input_share<std::uint64_t>(options.arithmetic_protocol, dims);
+      case 32:
+        return make_input_share<std::uint32_t>(options.arithmetic_protocol, dims);
+      default:
+        throw std::invalid_argument("unexpected bit size");
+    }
+  };
+  auto features = make_input(features_dims);
+  auto thresholds = make_input(thresholds_dims);
+  auto leaf_values = make_input(leaf_values_dims);
+  auto output = MOTION::tensor::make_tree_ensemble_inference(
+      backend, options.arithmetic_protocol, model, features, thresholds, leaf_values);
+
+  backend.run();
+}
+
+void print_stats(const Options& options, const MOTION::TreeEnsemble& model,
+                 const MOTION::Statistics::AccumulatedRunTimeStats& run_time_stats,
+                 const MOTION::Statistics::AccumulatedCommunicationStats& comm_stats) {
+  if (options.json) {
+    auto obj = MOTION::Statistics::to_json(options.experiment_name, run_time_stats, comm_stats);
+    obj.emplace("party_id", options.my_id);
+    obj.emplace("threads", options.num_threads);
+    obj.emplace("sync_between_setup_and_online", options.sync_between_setup_and_online);
+    obj.emplace("speculative_online", options.speculative_online);
+    obj.emplace("trusted_dealer", options.trusted_dealer_seed.has_value());
+    obj.emplace("bit-size", options.bit_size);
+    obj.emplace("arithmetic-protocol", MOTION::ToString(options.arithmetic_protocol));
+    obj.emplace("max-depth", model.get_max_depth());
+    obj.emplace("num-trees", model.get_num_trees());
+    obj.emplace("num-features", model.num_features_);
+    obj.emplace("num-queries", options.num_queries);
+    std::cout << obj << "\n";
+  } else {
+    std::cout << MOTION::Statistics::print_stats(options.experiment_name, run_time_stats,
+                                                 comm_stats);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  auto options = parse_program_options(argc, argv);
+  if (!options.has_value()) {
+    return EXIT_FAILURE;
+  }
+
+  try {
+    const auto model = load_model(*options);
+    options->experiment_name =
+        fmt::format("tree-ensemble-{}x{}-{}", model.get_num_trees(), model.get_max_depth(),
+                    options->num_queries);
+    auto comm_layer = setup_communication(*options);
+    auto logger = std::make_shared<MOTION::Logger>(options->my_id,
+                                                   boost::log::trivial::severity_level::trace);
+    comm_layer->set_logger(logger);
+    MOTION::Statistics::AccumulatedRunTimeStats run_time_stats;
+    MOTION::Statistics::AccumulatedCommunicationStats comm_stats;
+    for (std::size_t i = 0; i < options->num_repetitions; ++i) {
+      MOTION::TwoPartyTensorBackend backend(*comm_layer, options->num_threads,
+                                            options->sync_between_setup_and_online, logger,
+                                            false, options->trusted_dealer_seed);
+      backend.set_speculative_online(options->speculative_online);
+      run_benchmark(*options, model, backend);
+      comm_layer->sync();
+      comm_stats.add(comm_layer->get_transport_statistics());
+      comm_layer->reset_transport_statistics();
+      run_time_stats.add(backend.get_run_time_stats());
+    }
+    comm_layer->shutdown();
+    print_stats(*options, model, run_time_stats, comm_stats);
+  } catch (std::runtime_error& e) {
+    std::cerr << "ERROR OCCURRED: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
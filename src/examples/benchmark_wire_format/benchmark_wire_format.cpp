@@ -0,0 +1,118 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Compares the previous FlatBuffers-in-FlatBuffers framing of gate messages
+// with the compact framing (communication/compact_message.h) in terms of
+// serialization time and bytes on the wire, and measures the cost and benefit
+// of the optional LZ4 compression (communication/message_compression.h).
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "communication/compact_message.h"
+#include "communication/message_compression.h"
+#include "communication/fbs_headers/comm_mixin_gate_message_generated.h"
+#include "communication/message.h"
+
+using namespace MOTION::Communication;
+
+static void BM_gate_message_flatbuffers(benchmark::State& state) {
+  const std::size_t payload_size = state.range(0);
+  const std::vector<std::uint8_t> payload(payload_size, 0x42);
+  std::size_t gate_id = 0;
+  std::size_t message_size = 0;
+
+  for (auto _ : state) {
+    flatbuffers::FlatBufferBuilder builder;
+    auto vector = builder.CreateVector(payload.data(), payload.size());
+    auto root = CreateCommMixinGateMessage(builder, gate_id++, 0, vector);
+    builder.Finish(root);
+    auto message =
+        BuildMessage(MessageType::BEAVYGate, builder.GetBufferPointer(), builder.GetSize());
+    auto detached = message.Release();
+    message_size = detached.size();
+    benchmark::DoNotOptimize(detached.data());
+  }
+  state.counters["wire_bytes"] = message_size;
+  state.counters["overhead_bytes"] = message_size - payload_size;
+  state.SetBytesProcessed(state.iterations() * payload_size);
+}
+
+static void BM_gate_message_compact(benchmark::State& state) {
+  const std::size_t payload_size = state.range(0);
+  const std::vector<std::uint8_t> payload(payload_size, 0x42);
+  std::size_t gate_id = 0;
+  std::size_t message_size = 0;
+
+  for (auto _ : state) {
+    auto message =
+        BuildCompactMessage(MessageType::BEAVYGate, gate_id++, 0, payload.data(), payload.size());
+    message_size = message.size();
+    benchmark::DoNotOptimize(message.data());
+  }
+  state.counters["wire_bytes"] = message_size;
+  state.counters["overhead_bytes"] = message_size - payload_size;
+  state.SetBytesProcessed(state.iterations() * payload_size);
+}
+
+// Compression of compact messages: range(0) is the payload size, range(1) the
+// percentage of nonzero bytes (e.g., public shares of sparse ReLU outputs).
+static void BM_gate_message_compressed(benchmark::State& state) {
+  if (!compression_supported()) {
+    state.SkipWithError("built without LZ4 support");
+    return;
+  }
+  const std::size_t payload_size = state.range(0);
+  const std::size_t nonzero_percentage = state.range(1);
+  std::mt19937 gen(0);
+  std::vector<std::uint8_t> payload(payload_size, 0);
+  for (auto& b : payload) {
+    if (gen() % 100 < nonzero_percentage) {
+      b = gen() & 0xFF;
+    }
+  }
+  auto config = CompressionConfig::bulk_messages();
+  config.max_failures = std::numeric_limits<std::size_t>::max();
+  MessageCompressor compressor(config);
+  std::size_t gate_id = 0;
+  std::size_t message_size = 0;
+
+  for (auto _ : state) {
+    auto message =
+        BuildCompactMessage(MessageType::BEAVYGate, gate_id++, 0, payload.data(), payload.size());
+    compressor.compress(message);
+    message_size = message.size();
+    benchmark::DoNotOptimize(message.data());
+  }
+  state.counters["wire_bytes"] = message_size;
+  state.counters["ratio"] = double(message_size) / (payload_size + compact_message_header_size);
+  state.SetBytesProcessed(state.iterations() * payload_size);
+}
+
+BENCHMARK(BM_gate_message_flatbuffers)->RangeMultiplier(1 << 4)->Range(1, 1 << 24);
+BENCHMARK(BM_gate_message_compact)->RangeMultiplier(1 << 4)->Range(1, 1 << 24);
+BENCHMARK(BM_gate_message_compressed)
+    ->ArgsProduct({{1 << 12, 1 << 16, 1 << 20}, {0, 10, 50, 100}});
@@ -50,6 +50,9 @@ struct Options {
   std::size_t threads;
   std::size_t num_repetitions;
   bool sync_between_setup_and_online;
+  bool speculative_online;
+  std::optional<std::uint64_t> trusted_dealer_seed;
+  std::optional<MOTION::LinAlgHEConfig> linalg_he_config;
   MOTION::MPCProtocol protocol;
   std::size_t fractional_bits;
   std::size_t my_id;
@@ -75,6 +78,13 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("repetitions", po::value<std::size_t>()->default_value(1), "number of repetitions")
     ("sync-between-setup-and-online", po::bool_switch()->default_value(false),
      "run a synchronization protocol before the online phase starts")
+    ("speculative-online", po::bool_switch()->default_value(false),
+     "start the online phase concurrently to the setup phase")
+    ("trusted-dealer-seed", po::value<std::uint64_t>(),
+     "derive all correlated randomness from this seed without communication (insecure, "
+     "for measuring the online phase)")
+    ("linalg-he", po::value<std::string>()->default_value("off"),
+     "generate the GEMM/Conv2D triples with linear HE (off, cost-model, or always)")
     ("relu", po::bool_switch(&options.relu)->default_value(false), "use ReLU instead of squaring as activation function");
   // clang-format on
 
@@ -102,6 +112,29 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.threads = vm["threads"].as<std::size_t>();
   options.num_repetitions = vm["repetitions"].as<std::size_t>();
   options.sync_between_setup_and_online = vm["sync-between-setup-and-online"].as<bool>();
+  options.speculative_online = vm["speculative-online"].as<bool>();
+  if (options.speculative_online && options.sync_between_setup_and_online) {
+    std::cerr << "--speculative-online cannot be combined with --sync-between-setup-and-online\n";
+    return std::nullopt;
+  }
+  if (vm.count("trusted-dealer-seed")) {
+    options.trusted_dealer_seed = vm["trusted-dealer-seed"].as<std::uint64_t>();
+  }
+  auto linalg_he = vm["linalg-he"].as<std::string>();
+  boost::algorithm::to_lower(linalg_he);
+  if (linalg_he == "cost-model") {
+    options.linalg_he_config = MOTION::LinAlgHEConfig{};
+  } else if (linalg_he == "always") {
+    options.linalg_he_config = MOTION::LinAlgHEConfig{};
+    options.linalg_he_config->selection = MOTION::LinAlgHEConfig::Selection::always;
+  } else if (linalg_he != "off") {
+    std::cerr << "invalid value for --linalg-he: " << linalg_he << "\n";
+    return std::nullopt;
+  }
+  if (options.linalg_he_config && options.trusted_dealer_seed) {
+    std::cerr << "--linalg-he cannot be combined with --trusted-dealer-seed\n";
+    return std::nullopt;
+  }
   options.fractional_bits = vm["fractional-bits"].as<std::size_t>();
   if (options.my_id > 1) {
     std::cerr << "my-id must be one of 0 and 1\n";
@@ -296,7 +329,10 @@ int main(int argc, char* argv[]) {
                                                    boost::log::trivial::severity_level::trace);
     comm_layer->set_logger(logger);
     MOTION::TwoPartyTensorBackend backend(*comm_layer, options->threads,
-                                          options->sync_between_setup_and_online, logger);
+                                          options->sync_between_setup_and_online, logger,
+                                          false, options->trusted_dealer_seed,
+                                          options->linalg_he_config);
+    backend.set_speculative_online(options->speculative_online);
     run_cryptonets(*options, backend);
     comm_layer->shutdown();
   } catch (std::runtime_error& e) {
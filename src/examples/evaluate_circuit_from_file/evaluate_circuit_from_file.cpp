@@ -35,6 +35,7 @@
 #include <boost/log/trivial.hpp>
 #include <boost/program_options.hpp>
 #include <stdexcept>
+#include <sys/resource.h>
 
 #include "algorithm/algorithm_description.h"
 #include "base/two_party_backend.h"
@@ -57,6 +58,7 @@ struct Options {
   std::string circuit_path;
   bool fashion;
   bool no_run = false;
+  std::size_t streaming;
 };
 
 std::optional<Options> parse_program_options(int argc, char* argv[]) {
@@ -77,6 +79,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("sync-between-setup-and-online", po::bool_switch()->default_value(false),
      "run a synchronization protocol before the online phase starts")
     ("no-run", po::bool_switch()->default_value(false), "just build the circuit, but not execute it")
+    ("streaming", po::value<std::size_t>()->default_value(0),
+     "levelize the circuit and evaluate it with at most this many gates in flight (0 = off)")
     ("circuit", po::value<std::string>()->required(), "path to a circuit file in the Bristol format")
     ("fashion", po::bool_switch()->default_value(false), "output data in JSON format")
     ;
@@ -108,6 +112,7 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.num_simd = vm["num-simd"].as<std::size_t>();
   options.sync_between_setup_and_online = vm["sync-between-setup-and-online"].as<bool>();
   options.no_run = vm["no-run"].as<bool>();
+  options.streaming = vm["streaming"].as<std::size_t>();
   if (options.my_id > 1) {
     std::cerr << "my-id must be one of 0 and 1\n";
     return std::nullopt;
@@ -176,6 +181,10 @@ void run_circuit(const Options& options, MOTION::TwoPartyBackend& backend) {
   } else {
     algo = ENCRYPTO::AlgorithmDescription::FromBristol(options.circuit_path);
   }
+  if (options.streaming > 0) {
+    algo.Levelize();
+    backend.set_streaming(options.streaming);
+  }
   auto& gate_factory = backend.get_gate_factory(options.protocol);
   ENCRYPTO::ReusableFiberPromise<std::vector<ENCRYPTO::BitVector<>>> input_promise;
   MOTION::WireVector w_in_a;
@@ -195,8 +204,11 @@ void run_circuit(const Options& options, MOTION::TwoPartyBackend& backend) {
     input_promise = std::move(pair.first);
     w_in_b = std::move(pair.second);
   }
-  auto w_out = backend.make_circuit(algo, w_in_a, w_in_b);
-  auto output_future = gate_factory.make_boolean_output_gate_my(MOTION::ALL_PARTIES, w_out);
+  // in streaming mode, the gates are only created during the evaluation
+  ENCRYPTO::ReusableFiberFuture<std::vector<ENCRYPTO::BitVector<>>> output_future;
+  backend.make_circuit_lazily(algo, w_in_a, w_in_b, [&](const auto& w_out) {
+    output_future = gate_factory.make_boolean_output_gate_my(MOTION::ALL_PARTIES, w_out);
+  });
 
   if (options.no_run) {
     return;
@@ -217,6 +229,13 @@ void run_circuit(const Options& options, MOTION::TwoPartyBackend& backend) {
   output_future.get();
 }
 
+// peak resident set size of this process in KiB
+std::size_t get_peak_rss() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
 void print_stats(const Options& options,
                  const MOTION::Statistics::AccumulatedRunTimeStats& run_time_stats,
                  const MOTION::Statistics::AccumulatedCommunicationStats& comm_stats) {
@@ -230,9 +249,13 @@ void print_stats(const Options& options,
     obj.emplace("sync_between_setup_and_online", options.sync_between_setup_and_online);
     obj.emplace("circuit_path", options.circuit_path);
     obj.emplace("fashion", options.fashion);
+    obj.emplace("streaming", options.streaming);
+    obj.emplace("peak_rss_kib", get_peak_rss());
     std::cout << obj << "\n";
   } else {
     std::cout << MOTION::Statistics::print_stats(filename, run_time_stats, comm_stats);
+    std::cout << fmt::format("Peak RSS: {} KiB (streaming: {})\n", get_peak_rss(),
+                             options.streaming);
   }
 }
 
@@ -37,6 +37,7 @@
 
 #include "base/two_party_tensor_backend.h"
 #include "communication/communication_layer.h"
+#include "communication/message_compression.h"
 #include "communication/tcp_transport.h"
 #include "onnx_adapter.h"
 #include "statistics/analysis.h"
@@ -54,6 +55,9 @@ struct Options {
   bool json;
   std::size_t num_repetitions;
   bool sync_between_setup_and_online;
+  bool speculative_online;
+  std::optional<std::uint64_t> trusted_dealer_seed;
+  std::optional<MOTION::LinAlgHEConfig> linalg_he_config;
   MOTION::MPCProtocol arithmetic_protocol;
   MOTION::MPCProtocol boolean_protocol;
   std::size_t bit_size;
@@ -63,6 +67,7 @@ struct Options {
   std::string model_path;
   bool no_run = false;
   bool fake_triples = false;
+  bool compress = false;
 };
 
 std::optional<Options> parse_program_options(int argc, char* argv[]) {
@@ -82,6 +87,13 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("repetitions", po::value<std::size_t>()->default_value(1), "number of repetitions")
     ("sync-between-setup-and-online", po::bool_switch()->default_value(false),
      "run a synchronization protocol before the online phase starts")
+    ("speculative-online", po::bool_switch()->default_value(false),
+     "start the online phase concurrently to the setup phase")
+    ("trusted-dealer-seed", po::value<std::uint64_t>(),
+     "derive all correlated randomness from this seed without communication (insecure, "
+     "for measuring the online phase)")
+    ("linalg-he", po::value<std::string>()->default_value("off"),
+     "generate the GEMM/Conv2D triples with linear HE (off, cost-model, or always)")
     ("bit-size", po::value<std::size_t>()->default_value(64),
      "number of bits per number (32 or 64)")
     ("fractional-bits", po::value<std::size_t>()->default_value(16),
@@ -90,6 +102,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
      "just build the network, but not execute it")
     ("fake-triples", po::bool_switch()->default_value(false),
      "use random data instead of generating valid Beaver triples")
+    ("compress", po::bool_switch()->default_value(false),
+     "compress low-entropy gate and OT messages with LZ4 (requires MOTION_USE_LZ4)")
     ("model", po::value<std::string>()->required(), "path to a model file in ONNX format");
   // clang-format on
 
@@ -117,10 +131,42 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.json = vm["json"].as<bool>();
   options.num_repetitions = vm["repetitions"].as<std::size_t>();
   options.sync_between_setup_and_online = vm["sync-between-setup-and-online"].as<bool>();
+  options.speculative_online = vm["speculative-online"].as<bool>();
+  if (options.speculative_online && options.sync_between_setup_and_online) {
+    std::cerr << "--speculative-online cannot be combined with --sync-between-setup-and-online\n";
+    return std::nullopt;
+  }
+  if (vm.count("trusted-dealer-seed")) {
+    options.trusted_dealer_seed = vm["trusted-dealer-seed"].as<std::uint64_t>();
+  }
+  auto linalg_he = vm["linalg-he"].as<std::string>();
+  boost::algorithm::to_lower(linalg_he);
+  if (linalg_he == "cost-model") {
+    options.linalg_he_config = MOTION::LinAlgHEConfig{};
+  } else if (linalg_he == "always") {
+    options.linalg_he_config = MOTION::LinAlgHEConfig{};
+    options.linalg_he_config->selection = MOTION::LinAlgHEConfig::Selection::always;
+  } else if (linalg_he != "off") {
+    std::cerr << "invalid value for --linalg-he: " << linalg_he << "\n";
+    return std::nullopt;
+  }
+  if (options.linalg_he_config && options.trusted_dealer_seed) {
+    std::cerr << "--linalg-he cannot be combined with --trusted-dealer-seed\n";
+    return std::nullopt;
+  }
   options.bit_size = vm["bit-size"].as<std::size_t>();
   options.fractional_bits = vm["fractional-bits"].as<std::size_t>();
   options.no_run = vm["no-run"].as<bool>();
   options.fake_triples = vm["fake-triples"].as<bool>();
+  if (options.linalg_he_config && options.fake_triples) {
+    std::cerr << "--linalg-he cannot be combined with --fake-triples\n";
+    return std::nullopt;
+  }
+  options.compress = vm["compress"].as<bool>();
+  if (options.compress && !MOTION::Communication::compression_supported()) {
+    std::cerr << "--compress requires MOTION to be built with MOTION_USE_LZ4\n";
+    return std::nullopt;
+  }
   if (options.my_id > 1) {
     std::cerr << "my-id must be one of 0 and 1\n";
     return std::nullopt;
@@ -243,10 +289,14 @@ void print_stats(const Options& options,
     obj.emplace("party_id", options.my_id);
     obj.emplace("threads", options.threads);
     obj.emplace("sync_between_setup_and_online", options.sync_between_setup_and_online);
+    obj.emplace("speculative_online", options.speculative_online);
+    obj.emplace("trusted_dealer", options.trusted_dealer_seed.has_value());
+    obj.emplace("linalg_he", options.linalg_he_config.has_value());
     obj.emplace("arithmetic_protocol", MOTION::ToString(options.arithmetic_protocol));
     obj.emplace("boolean_protocol", MOTION::ToString(options.boolean_protocol));
     obj.emplace("model_path", options.model_path);
     obj.emplace("fake_triples", options.fake_triples);
+    obj.emplace("compress", options.compress);
     std::cout << obj << "\n";
   } else {
     std::cout << MOTION::Statistics::print_stats(filename, run_time_stats, comm_stats);
@@ -264,16 +314,24 @@ int main(int argc, char* argv[]) {
     auto logger = std::make_shared<MOTION::Logger>(options->my_id,
                                                    boost::log::trivial::severity_level::trace);
     comm_layer->set_logger(logger);
+    if (options->compress) {
+      comm_layer->set_compression_config(
+          MOTION::Communication::CompressionConfig::bulk_messages());
+    }
     MOTION::Statistics::AccumulatedRunTimeStats run_time_stats;
     MOTION::Statistics::AccumulatedCommunicationStats comm_stats;
     for (std::size_t i = 0; i < options->num_repetitions; ++i) {
       MOTION::TwoPartyTensorBackend backend(*comm_layer, options->threads,
                                             options->sync_between_setup_and_online, logger,
-                                            options->fake_triples);
+                                            options->fake_triples, options->trusted_dealer_seed,
+                                            options->linalg_he_config);
+      backend.set_speculative_online(options->speculative_online);
       run_model(*options, backend);
       comm_layer->sync();
       comm_stats.add(comm_layer->get_transport_statistics());
       comm_layer->reset_transport_statistics();
+      comm_stats.add(comm_layer->get_compression_statistics());
+      comm_layer->reset_compression_statistics();
       run_time_stats.add(backend.get_run_time_stats());
     }
     comm_layer->shutdown();
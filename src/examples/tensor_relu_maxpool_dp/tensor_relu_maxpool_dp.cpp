@@ -29,6 +29,8 @@
 #include <regex>
 #include <stdexcept>
 
+#include <fmt/format.h>
+#include <sys/resource.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/json/serialize.hpp>
 #include <boost/lexical_cast.hpp>
@@ -63,6 +65,7 @@ struct Options {
   std::size_t num_repetitions;
   std::size_t num_simd;
   bool sync_between_setup_and_online;
+  bool speculative_online;
   MOTION::MPCProtocol arithmetic_protocol;
   MOTION::MPCProtocol boolean_protocol;
   std::size_t fractional_bits;
@@ -119,6 +122,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("num-simd", po::value<std::size_t>()->default_value(1), "number of SIMD values")
     ("sync-between-setup-and-online", po::bool_switch()->default_value(false),
      "run a synchronization protocol before the online phase starts")
+    ("speculative-online", po::bool_switch()->default_value(false),
+     "start the online phase concurrently to the setup phase")
     ("no-run", po::bool_switch()->default_value(false), "just build the circuit, but not execute it")
     ;
   // clang-format on
@@ -148,6 +153,11 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.num_repetitions = vm["repetitions"].as<std::size_t>();
   options.num_simd = vm["num-simd"].as<std::size_t>();
   options.sync_between_setup_and_online = vm["sync-between-setup-and-online"].as<bool>();
+  options.speculative_online = vm["speculative-online"].as<bool>();
+  if (options.speculative_online && options.sync_between_setup_and_online) {
+    std::cerr << "--speculative-online cannot be combined with --sync-between-setup-and-online\n";
+    return std::nullopt;
+  }
   options.no_run = vm["no-run"].as<bool>();
   if (options.my_id > 1) {
     std::cerr << "my-id must be one of 0 and 1\n";
@@ -324,9 +334,18 @@ auto create_composite_circuit(const Options& options, MOTION::TwoPartyTensorBack
   return output_future;
 }
 
+// peak resident set size of this process in KiB
+std::size_t get_peak_rss() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
 void run_composite_circuit(const Options& options, MOTION::TwoPartyTensorBackend& backend){
   auto output_future = create_composite_circuit(options, backend);
   backend.run();
+  std::cout << backend.get_run_time_stats().print_human_readable();
+  std::cout << fmt::format("Peak RSS: {} KiB\n", get_peak_rss());
   if (options.my_id == 1) {
     auto interm = output_future.get();
     std::cout << "The result is:\n[";
@@ -352,6 +371,7 @@ int main(int argc, char* argv[]) {
     comm_layer->set_logger(logger);
     MOTION::TwoPartyTensorBackend backend(*comm_layer, options->threads,
                                       options->sync_between_setup_and_online, logger);
+    backend.set_speculative_online(options->speculative_online);
     run_composite_circuit(*options, backend);
     comm_layer->shutdown();
   } catch (std::runtime_error& e) {
@@ -54,8 +54,10 @@ void matrix_multiplication_stats(std::size_t m, std::size_t k, std::size_t n) {
   std::cout << fmt::format("- {} scalar x vector multiplications with vectors of size {}\n",
                            num_mults, vector_size);
   std::cout << fmt::format("- {} additively correlated OTs\n", num_ots);
-  std::cout << fmt::format("- buffer size: {:.3f} GiB\n",
+  std::cout << fmt::format("- OT message size: {:.3f} GiB\n",
                            num_ots * vector_size * sizeof(T) / double(1 << 30));
+  std::cout << fmt::format("- output buffer size: {:.3f} GiB\n",
+                           m * n * sizeof(T) / double(1 << 30));
   // row-wise:
   std::cout << fmt::format("row-wise: {}x the following:\n", m);
   std::cout << fmt::format("- {} scalar x vector multiplications with vectors of size {}\n", k,
@@ -24,9 +24,14 @@
 
 #include "algorithm_description.h"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
+#include <limits>
+#include <numeric>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/lexical_cast.hpp>
@@ -411,4 +416,115 @@ AlgorithmDescription AlgorithmDescription::FromABY(std::ifstream& stream) {
   }
   return algo;
 }  // namespace ENCRYPTO
+
+static std::size_t get_num_input_wires(const AlgorithmDescription& algo) {
+  return algo.n_input_wires_parent_a_ + algo.n_input_wires_parent_b_.value_or(0);
+}
+
+static void check_wire_id(const AlgorithmDescription& algo, std::size_t wire_id) {
+  if (wire_id >= algo.n_wires_) {
+    throw std::invalid_argument(
+        fmt::format("AlgorithmDescription: wire id {} out of range (n_wires = {})", wire_id,
+                    algo.n_wires_));
+  }
+}
+
+std::vector<std::size_t> AlgorithmDescription::ComputeGateLevels() const {
+  std::vector<std::size_t> wire_levels(n_wires_, 0);
+  std::vector<std::size_t> gate_levels;
+  gate_levels.reserve(gates_.size());
+  for (const auto& op : gates_) {
+    check_wire_id(*this, op.parent_a_);
+    check_wire_id(*this, op.output_wire_);
+    auto level = wire_levels[op.parent_a_];
+    if (op.parent_b_.has_value()) {
+      check_wire_id(*this, *op.parent_b_);
+      level = std::max(level, wire_levels[*op.parent_b_]);
+    }
+    if (op.selection_bit_.has_value()) {
+      check_wire_id(*this, *op.selection_bit_);
+      level = std::max(level, wire_levels[*op.selection_bit_]);
+    }
+    wire_levels[op.output_wire_] = level + 1;
+    gate_levels.emplace_back(level + 1);
+  }
+  return gate_levels;
+}
+
+std::size_t AlgorithmDescription::Levelize() {
+  const auto gate_levels = ComputeGateLevels();
+  if (gate_levels.empty()) {
+    return 0;
+  }
+  const auto num_levels = *std::max_element(std::begin(gate_levels), std::end(gate_levels));
+
+  // counting sort of the gates by their level, which keeps the order within a level
+  std::vector<std::size_t> level_offsets(num_levels + 1, 0);
+  for (const auto level : gate_levels) {
+    ++level_offsets[level];
+  }
+  std::partial_sum(std::begin(level_offsets), std::end(level_offsets),
+                   std::begin(level_offsets));
+  std::vector<PrimitiveOperation> levelized_gates(gates_.size());
+  for (std::size_t gate_i = 0; gate_i < gates_.size(); ++gate_i) {
+    levelized_gates[level_offsets[gate_levels[gate_i] - 1]++] = gates_[gate_i];
+  }
+  gates_ = std::move(levelized_gates);
+  return num_levels;
+}
+
+std::size_t AlgorithmDescription::ComputeMaxLiveWires() const {
+  constexpr auto never = std::numeric_limits<std::size_t>::max();
+  const auto num_input_wires = get_num_input_wires(*this);
+  const auto first_output_wire = n_wires_ - n_output_wires_;
+
+  // index of the last gate reading each wire
+  std::vector<std::size_t> last_use(n_wires_, never);
+  for (std::size_t gate_i = 0; gate_i < gates_.size(); ++gate_i) {
+    const auto& op = gates_[gate_i];
+    check_wire_id(*this, op.parent_a_);
+    last_use[op.parent_a_] = gate_i;
+    if (op.parent_b_.has_value()) {
+      check_wire_id(*this, *op.parent_b_);
+      last_use[*op.parent_b_] = gate_i;
+    }
+    if (op.selection_bit_.has_value()) {
+      check_wire_id(*this, *op.selection_bit_);
+      last_use[*op.selection_bit_] = gate_i;
+    }
+  }
+
+  const auto is_released = [&](std::size_t wire_id, std::size_t gate_i) {
+    return wire_id >= num_input_wires && wire_id < first_output_wire &&
+           last_use[wire_id] == gate_i;
+  };
+
+  std::size_t num_live = 0;
+  std::size_t max_live = 0;
+  for (std::size_t gate_i = 0; gate_i < gates_.size(); ++gate_i) {
+    const auto& op = gates_[gate_i];
+    check_wire_id(*this, op.output_wire_);
+    const bool is_intermediate = op.output_wire_ < first_output_wire;
+    if (is_intermediate) {
+      ++num_live;
+      max_live = std::max(max_live, num_live);
+    }
+    // release the parents which are read for the last time, each wire only once
+    std::array<std::size_t, 3> parents = {op.parent_a_, op.parent_b_.value_or(never),
+                                          op.selection_bit_.value_or(never)};
+    std::sort(std::begin(parents), std::end(parents));
+    const auto parents_end = std::unique(std::begin(parents), std::end(parents));
+    for (auto it = std::begin(parents); it != parents_end && *it != never; ++it) {
+      if (is_released(*it, gate_i)) {
+        --num_live;
+      }
+    }
+    // results which are never read
+    if (is_intermediate && last_use[op.output_wire_] == never) {
+      --num_live;
+    }
+  }
+  return max_live;
+}
+
 }
@@ -59,6 +59,22 @@ struct AlgorithmDescription {
 
   static AlgorithmDescription FromABY(std::ifstream& stream);
 
+  // Compute the level of each gate, i.e., one plus the maximum level of its
+  // parents, where the input wires are on level 0.  The gates need to be in
+  // topological order.
+  std::vector<std::size_t> ComputeGateLevels() const;
+
+  // Stably sort the gates by their level s.t. the circuit can be evaluated
+  // layer by layer.  The wire ids are not changed.  Returns the number of
+  // levels.
+  std::size_t Levelize();
+
+  // Maximum number of intermediate wires which are alive at the same time if
+  // the gates are evaluated in the current order, i.e., which have been
+  // computed and are read by a later gate.  Input and output wires are not
+  // counted.
+  std::size_t ComputeMaxLiveWires() const;
+
   std::size_t n_output_wires_{0}, n_input_wires_parent_a_{0}, n_wires_{0}, n_gates_{0};
   std::optional<std::size_t> n_input_wires_parent_b_{std::nullopt};
   std::vector<PrimitiveOperation> gates_;
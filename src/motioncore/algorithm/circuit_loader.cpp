@@ -64,6 +64,21 @@ static std::string format_search_path(std::vector<fs::path> paths) {
 
 const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_circuit(std::string name,
                                                                   CircuitFormat format) {
+  if (!levelize_circuits_) {
+    return load_circuit_file(std::move(name), format);
+  }
+  const auto levelized_name = fmt::format("__circuit_loader_levelized__{}", name);
+  auto it = algo_cache_.find(levelized_name);
+  if (it != std::end(algo_cache_)) {
+    return it->second;
+  }
+  auto algo = load_circuit_file(std::move(name), format);
+  algo.Levelize();
+  return algo_cache_[levelized_name] = std::move(algo);
+}
+
+const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_circuit_file(std::string name,
+                                                                       CircuitFormat format) {
   auto it = algo_cache_.find(name);
   if (it != std::end(algo_cache_)) {
     return it->second;
@@ -144,8 +159,9 @@ const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_gt_circuit(std::size_t
     return it->second;
   }
   auto algo =
-      load_circuit(fmt::format("int_gt{}_{}.bristol", bit_size, depth_optimized ? "depth" : "size"),
-                   CircuitFormat::Bristol);
+      load_circuit_file(fmt::format("int_gt{}_{}.bristol", bit_size,
+                                    depth_optimized ? "depth" : "size"),
+                        CircuitFormat::Bristol);
 
   // remove unnecessary outputs ...
   algo.n_gates_ -= bit_size + 1;
@@ -269,6 +285,214 @@ const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_gtmod_circuit(std::siz
   return algo_cache_[name];
 }
 
+const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_eq_circuit(std::size_t bit_size) {
+  if (bit_size == 0) {
+    throw std::logic_error("unsupported bit size: 0");
+  }
+  const auto name = fmt::format("__circuit_loader_builtin__eq_{}_bit", bit_size);
+  auto it = algo_cache_.find(name);
+  if (it != std::end(algo_cache_)) {
+    return it->second;
+  }
+
+  ENCRYPTO::AlgorithmDescription algo{.n_output_wires_ = 1,
+                                      .n_input_wires_parent_a_ = bit_size,
+                                      .n_wires_ = 5 * bit_size - 1,
+                                      .n_gates_ = 3 * bit_size - 1,
+                                      .n_input_wires_parent_b_ = bit_size,
+                                      .gates_ = {}};
+  auto& gates = algo.gates_;
+  gates.reserve(algo.n_gates_);
+  // ~(X ^ Y) is one iff the bits are equal
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    gates.push_back(ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::XOR,
+                                                 .parent_a_ = bit_j,
+                                                 .parent_b_ = bit_size + bit_j,
+                                                 .output_wire_ = 2 * bit_size + bit_j});
+  }
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    gates.push_back(ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::INV,
+                                                 .parent_a_ = 2 * bit_size + bit_j,
+                                                 .output_wire_ = 3 * bit_size + bit_j});
+  }
+  // AND all of them in a tree of depth log(bit_size)
+  std::queue<std::size_t> values;
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    values.push(3 * bit_size + bit_j);
+  }
+  std::size_t wire_offset = 4 * bit_size;
+  while (values.size() > 1) {
+    auto input_a = values.front();
+    values.pop();
+    auto input_b = values.front();
+    values.pop();
+    gates.push_back(ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::AND,
+                                                 .parent_a_ = input_a,
+                                                 .parent_b_ = input_b,
+                                                 .output_wire_ = wire_offset});
+    values.push(wire_offset++);
+  }
+  assert(wire_offset == algo.n_wires_ || bit_size == 1);
+  assert(gates.size() == algo.n_gates_);
+
+  algo_cache_[name] = std::move(algo);
+  return algo_cache_[name];
+}
+
+const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_eq_select_circuit(std::size_t bit_size) {
+  const auto name = fmt::format("__circuit_loader_builtin__eq_select_{}_bit", bit_size);
+  auto it = algo_cache_.find(name);
+  if (it != std::end(algo_cache_)) {
+    return it->second;
+  }
+  auto algo = load_eq_circuit(bit_size);
+
+  auto eq_wire = algo.n_wires_ - 1;
+  auto wire_offset = algo.n_wires_;
+  algo.n_gates_ += bit_size;
+  algo.n_wires_ += bit_size;
+  algo.n_output_wires_ = bit_size;
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    // X * (X == Y)
+    algo.gates_.push_back(
+        ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::AND,
+                                     .parent_a_ = bit_j,
+                                     .parent_b_ = eq_wire,
+                                     .output_wire_ = wire_offset + bit_j});
+  }
+  assert(algo.gates_.size() == algo.n_gates_);
+
+  algo_cache_[name] = std::move(algo);
+  return algo_cache_[name];
+}
+
+const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_join_select_circuit(
+    std::size_t key_bit_size, std::size_t payload_bit_size) {
+  if (key_bit_size == 0 || payload_bit_size == 0) {
+    throw std::logic_error("unsupported bit size: 0");
+  }
+  const auto name = fmt::format("__circuit_loader_builtin__join_select_{}_{}_bit", key_bit_size,
+                                payload_bit_size);
+  auto it = algo_cache_.find(name);
+  if (it != std::end(algo_cache_)) {
+    return it->second;
+  }
+
+  // records are (payload, tag, key) starting from the least significant bit
+  const auto record_bit_size = payload_bit_size + 1 + key_bit_size;
+  const auto key_offset = payload_bit_size + 1;
+  const auto num_outputs = key_bit_size + 2 * payload_bit_size;
+  ENCRYPTO::AlgorithmDescription algo{
+      .n_output_wires_ = num_outputs,
+      .n_input_wires_parent_a_ = record_bit_size,
+      .n_wires_ = 2 * record_bit_size + 3 * key_bit_size - 1 + num_outputs,
+      .n_gates_ = 3 * key_bit_size - 1 + num_outputs,
+      .n_input_wires_parent_b_ = record_bit_size,
+      .gates_ = {}};
+  auto& gates = algo.gates_;
+  gates.reserve(algo.n_gates_);
+  std::size_t wire_offset = 2 * record_bit_size;
+  // compare only the keys: AND over ~(X ^ Y) in a tree of depth log(key_bit_size)
+  std::queue<std::size_t> values;
+  for (std::size_t bit_j = 0; bit_j < key_bit_size; ++bit_j) {
+    gates.push_back(ENCRYPTO::PrimitiveOperation{
+        .type_ = ENCRYPTO::PrimitiveOperationType::XOR,
+        .parent_a_ = key_offset + bit_j,
+        .parent_b_ = record_bit_size + key_offset + bit_j,
+        .output_wire_ = wire_offset});
+    gates.push_back(ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::INV,
+                                                 .parent_a_ = wire_offset,
+                                                 .output_wire_ = wire_offset + 1});
+    values.push(wire_offset + 1);
+    wire_offset += 2;
+  }
+  while (values.size() > 1) {
+    auto input_a = values.front();
+    values.pop();
+    auto input_b = values.front();
+    values.pop();
+    gates.push_back(ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::AND,
+                                                 .parent_a_ = input_a,
+                                                 .parent_b_ = input_b,
+                                                 .output_wire_ = wire_offset});
+    values.push(wire_offset++);
+  }
+  const auto eq_wire = values.front();
+  // outputs: key of X, payload of X, payload of Y, each multiplied with (key X == key Y)
+  const auto select = [&gates, &wire_offset, eq_wire](std::size_t input_wire) {
+    gates.push_back(ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::AND,
+                                                 .parent_a_ = input_wire,
+                                                 .parent_b_ = eq_wire,
+                                                 .output_wire_ = wire_offset++});
+  };
+  for (std::size_t bit_j = 0; bit_j < key_bit_size; ++bit_j) {
+    select(key_offset + bit_j);
+  }
+  for (std::size_t bit_j = 0; bit_j < payload_bit_size; ++bit_j) {
+    select(bit_j);
+  }
+  for (std::size_t bit_j = 0; bit_j < payload_bit_size; ++bit_j) {
+    select(record_bit_size + bit_j);
+  }
+  assert(wire_offset == algo.n_wires_);
+  assert(gates.size() == algo.n_gates_);
+
+  algo_cache_[name] = std::move(algo);
+  return algo_cache_[name];
+}
+
+const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_cmpswap_circuit(std::size_t bit_size,
+                                                                          bool depth_optimized) {
+  const auto name = fmt::format("__circuit_loader_builtin__cmpswap_{}_bit_{}", bit_size,
+                                depth_optimized ? "depth" : "size");
+  auto it = algo_cache_.find(name);
+  if (it != std::end(algo_cache_)) {
+    return it->second;
+  }
+  auto algo = load_gt_circuit(bit_size, depth_optimized);
+
+  // X > Y -> swap
+  auto choice_wire = algo.n_wires_ - 1;
+
+  auto wire_offset = algo.n_wires_;
+  auto gate_offset = algo.n_gates_;
+  auto& gates = algo.gates_;
+  gates.resize(gate_offset + 4 * bit_size);
+  algo.n_gates_ += 4 * bit_size;
+  algo.n_wires_ += 4 * bit_size;
+  algo.n_output_wires_ = 2 * bit_size;
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    // X ^ Y
+    gates.at(gate_offset + bit_j) =
+        ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::XOR,
+                                     .parent_a_ = bit_j,
+                                     .parent_b_ = bit_size + bit_j,
+                                     .output_wire_ = wire_offset + bit_j};
+    // (X ^ Y) * b
+    gates.at(gate_offset + bit_size + bit_j) =
+        ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::AND,
+                                     .parent_a_ = wire_offset + bit_j,
+                                     .parent_b_ = choice_wire,
+                                     .output_wire_ = wire_offset + bit_size + bit_j};
+    // min: X ^ (X ^ Y) * b
+    gates.at(gate_offset + 2 * bit_size + bit_j) =
+        ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::XOR,
+                                     .parent_a_ = bit_j,
+                                     .parent_b_ = wire_offset + bit_size + bit_j,
+                                     .output_wire_ = wire_offset + 2 * bit_size + bit_j};
+    // max: Y ^ (X ^ Y) * b
+    gates.at(gate_offset + 3 * bit_size + bit_j) =
+        ENCRYPTO::PrimitiveOperation{.type_ = ENCRYPTO::PrimitiveOperationType::XOR,
+                                     .parent_a_ = bit_size + bit_j,
+                                     .parent_b_ = wire_offset + bit_size + bit_j,
+                                     .output_wire_ = wire_offset + 3 * bit_size + bit_j};
+  }
+  assert(algo.gates_.size() == algo.n_gates_);
+
+  algo_cache_[name] = std::move(algo);
+  return algo_cache_[name];
+}
+
 const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_tree_circuit(const std::string& algo_name,
                                                                        std::size_t bit_size,
                                                                        std::size_t num_inputs) {
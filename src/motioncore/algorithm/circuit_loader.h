@@ -40,6 +40,10 @@ class CircuitLoader {
  public:
   CircuitLoader();
   ~CircuitLoader();
+  // Let load_circuit return levelized circuits s.t. their gates are
+  // registered layer by layer (cf. AlgorithmDescription::Levelize).  The
+  // built-in circuits below keep their gate order.
+  void set_levelize_circuits(bool levelize) noexcept { levelize_circuits_ = levelize; }
   const ENCRYPTO::AlgorithmDescription& load_circuit(std::string name, CircuitFormat);
   const ENCRYPTO::AlgorithmDescription& load_relu_circuit(std::size_t bit_size);
   const ENCRYPTO::AlgorithmDescription& load_gt_circuit(std::size_t bit_size,
@@ -48,6 +52,17 @@ class CircuitLoader {
                                                             bool depth_optimized = false);
   const ENCRYPTO::AlgorithmDescription& load_gtmux_circuit(std::size_t bit_size,
                                                            bool depth_optimized = false);
+  // a == b, single output wire
+  const ENCRYPTO::AlgorithmDescription& load_eq_circuit(std::size_t bit_size);
+  // a if a == b else 0
+  const ENCRYPTO::AlgorithmDescription& load_eq_select_circuit(std::size_t bit_size);
+  // for records (payload, tag, key) a and b: (key_a, payload_a, payload_b) if
+  // key_a == key_b else 0
+  const ENCRYPTO::AlgorithmDescription& load_join_select_circuit(std::size_t key_bit_size,
+                                                                 std::size_t payload_bit_size);
+  // (min(a, b), max(a, b)), i.e., a comparator of a sorting network
+  const ENCRYPTO::AlgorithmDescription& load_cmpswap_circuit(std::size_t bit_size,
+                                                             bool depth_optimized = false);
   const ENCRYPTO::AlgorithmDescription& load_tree_circuit(const std::string& algo_name,
                                                           std::size_t bit_size,
                                                           std::size_t num_inputs);
@@ -59,8 +74,12 @@ class CircuitLoader {
                                                              bool depth_optimized = false);
 
  private:
+  // load a circuit in its original gate order
+  const ENCRYPTO::AlgorithmDescription& load_circuit_file(std::string name, CircuitFormat);
+
   std::vector<std::filesystem::path> circuit_search_path_;
   std::unordered_map<std::string, ENCRYPTO::AlgorithmDescription> algo_cache_;
+  bool levelize_circuits_ = false;
 };
 
 }  // namespace MOTION
@@ -22,6 +22,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <utility>
+
 #include <fmt/format.h>
 
 #include "algorithm_description.h"
@@ -32,9 +38,8 @@ namespace MOTION {
 
 using WireVector = std::vector<std::shared_ptr<NewWire>>;
 
-template <typename Builder>
-WireVector make_circuit(Builder& builder, const ENCRYPTO::AlgorithmDescription& algo,
-                        const WireVector& wires_in_a, const WireVector& wires_in_b) {
+inline void check_circuit_inputs(const ENCRYPTO::AlgorithmDescription& algo,
+                                 const WireVector& wires_in_a, const WireVector& wires_in_b) {
   if (!algo.n_input_wires_parent_b_.has_value()) {
     throw std::invalid_argument("AlgorithmDescription expects 1 input but 2 are provided");
   }
@@ -48,6 +53,12 @@ WireVector make_circuit(Builder& builder, const ENCRYPTO::AlgorithmDescription&
         fmt::format("AlgorithmDescription expects {} wires for input b, but {} are provided",
                     *algo.n_input_wires_parent_b_, wires_in_b.size()));
   }
+}
+
+template <typename Builder>
+WireVector make_circuit(Builder& builder, const ENCRYPTO::AlgorithmDescription& algo,
+                        const WireVector& wires_in_a, const WireVector& wires_in_b) {
+  check_circuit_inputs(algo, wires_in_a, wires_in_b);
   WireVector circuit_wires(algo.n_wires_);
   // load the input wires into vector
   auto it = std::copy(std::begin(wires_in_a), std::end(wires_in_a), std::begin(circuit_wires));
@@ -70,6 +81,94 @@ WireVector make_circuit(Builder& builder, const ENCRYPTO::AlgorithmDescription&
   return output_wires;
 }
 
+// Returns a function which creates the gates of the next level of the
+// circuit each time it is called, and false once all gates have been created
+// (cf. NewGateExecutor::set_gate_generator).  The circuit needs to be
+// levelized (cf. AlgorithmDescription::Levelize), and the builder and the
+// algorithm description need to outlive the function.  A wire is only
+// referenced until the last gate reading it has been created, and on_outputs
+// is called with the output wires after the last level has been created.
+template <typename Builder>
+std::function<bool()> make_circuit_lazily(Builder& builder,
+                                          const ENCRYPTO::AlgorithmDescription& algo,
+                                          const WireVector& wires_in_a,
+                                          const WireVector& wires_in_b,
+                                          std::function<void(const WireVector&)> on_outputs) {
+  check_circuit_inputs(algo, wires_in_a, wires_in_b);
+  constexpr auto unused = std::numeric_limits<std::size_t>::max();
+  struct State {
+    WireVector circuit_wires;
+    std::vector<std::size_t> gate_levels;
+    // index of the last gate reading a wire
+    std::vector<std::size_t> last_reader;
+    std::size_t next_gate = 0;
+    std::function<void(const WireVector&)> on_outputs;
+  };
+  auto state = std::make_shared<State>();
+  state->circuit_wires.resize(algo.n_wires_);
+  auto it = std::copy(std::begin(wires_in_a), std::end(wires_in_a),
+                      std::begin(state->circuit_wires));
+  std::copy(std::begin(wires_in_b), std::end(wires_in_b), it);
+  state->gate_levels = algo.ComputeGateLevels();
+  if (!std::is_sorted(std::begin(state->gate_levels), std::end(state->gate_levels))) {
+    throw std::invalid_argument("make_circuit_lazily: circuit is not levelized");
+  }
+  state->last_reader.resize(algo.n_wires_, unused);
+  for (std::size_t gate_i = 0; gate_i < algo.gates_.size(); ++gate_i) {
+    const auto& prim_op = algo.gates_[gate_i];
+    state->last_reader.at(prim_op.parent_a_) = gate_i;
+    if (prim_op.parent_b_.has_value()) {
+      state->last_reader.at(*prim_op.parent_b_) = gate_i;
+    }
+  }
+  state->on_outputs = std::move(on_outputs);
+
+  return [&builder, &algo, state = std::move(state)] {
+    const auto num_gates = algo.gates_.size();
+    const auto first_output_wire = algo.n_wires_ - algo.n_output_wires_;
+    auto& wires = state->circuit_wires;
+    // only the output wires are kept after the last reader has been created
+    const auto release = [&wires, &state, first_output_wire](std::size_t wire_id,
+                                                              std::size_t gate_i) {
+      if (wire_id < first_output_wire && state->last_reader[wire_id] == gate_i) {
+        wires[wire_id] = nullptr;
+      }
+    };
+    if (state->next_gate < num_gates) {
+      const auto level = state->gate_levels[state->next_gate];
+      for (; state->next_gate < num_gates && state->gate_levels[state->next_gate] == level;
+           ++state->next_gate) {
+        const auto gate_i = state->next_gate;
+        const auto& prim_op = algo.gates_[gate_i];
+        WireVector gate_output_wires;
+        if (prim_op.parent_b_.has_value()) {
+          gate_output_wires = builder.make_binary_gate(prim_op.type_, {wires.at(prim_op.parent_a_)},
+                                                       {wires.at(*prim_op.parent_b_)});
+          release(*prim_op.parent_b_, gate_i);
+        } else {
+          gate_output_wires = builder.make_unary_gate(prim_op.type_, {wires.at(prim_op.parent_a_)});
+        }
+        release(prim_op.parent_a_, gate_i);
+        if (prim_op.output_wire_ >= first_output_wire ||
+            state->last_reader[prim_op.output_wire_] != unused) {
+          wires.at(prim_op.output_wire_) = std::move(gate_output_wires.at(0));
+        }
+      }
+    }
+    if (state->next_gate < num_gates) {
+      return true;
+    }
+    if (state->on_outputs) {
+      WireVector output_wires(std::begin(wires) + first_output_wire, std::end(wires));
+      wires.clear();
+      std::exchange(state->on_outputs, nullptr)(output_wires);
+      // on_outputs may have created further gates
+      return true;
+    }
+    return false;
+  };
+}
+
 template <typename Builder>
 std::pair<std::vector<std::unique_ptr<NewGate>>, WireVector> construct_circuit(
     Builder& builder, const ENCRYPTO::AlgorithmDescription& algo, const WireVector& wires_in_a) {
@@ -107,4 +206,47 @@ std::pair<std::vector<std::unique_ptr<NewGate>>, WireVector> construct_circuit(
   return {std::move(gates), std::move(output_wires)};
 }
 
+// Constructs a circuit of depth ceil(log2(n)) computing x > c for n-bit
+// unsigned values x and a public c from the wires t_i = x_i AND NOT c_i and
+// e_i = x_i XNOR c_i (least significant bit first), which can be computed
+// locally.  Adjacent ranges of bits are merged with the prefix operator
+//   (g_hi, p_hi) o (g_lo, p_lo) = (g_hi XOR (p_hi AND g_lo), p_hi AND p_lo),
+// where g indicates x > c and p indicates x == c on the range.
+template <typename Builder>
+std::pair<std::vector<std::unique_ptr<NewGate>>, std::shared_ptr<NewWire>>
+construct_public_gt_circuit(Builder& builder, const WireVector& t_wires,
+                            const WireVector& e_wires) {
+  assert(t_wires.size() == e_wires.size());
+  assert(!t_wires.empty());
+  std::vector<std::unique_ptr<NewGate>> gates;
+  const auto add_gate = [&builder, &gates](auto op, const auto& wire_a, const auto& wire_b) {
+    auto [gate, output_wires] = builder.construct_binary_gate(op, {wire_a}, {wire_b});
+    gates.emplace_back(std::move(gate));
+    return std::move(output_wires.at(0));
+  };
+  WireVector g_wires = t_wires;
+  WireVector p_wires = e_wires;
+  while (g_wires.size() > 1) {
+    const auto num_ranges = g_wires.size();
+    WireVector next_g_wires;
+    WireVector next_p_wires;
+    for (std::size_t i = 0; i + 1 < num_ranges; i += 2) {
+      auto tmp = add_gate(ENCRYPTO::PrimitiveOperationType::AND, p_wires[i + 1], g_wires[i]);
+      next_g_wires.emplace_back(
+          add_gate(ENCRYPTO::PrimitiveOperationType::XOR, g_wires[i + 1], tmp));
+      // p of the least significant range is never used
+      next_p_wires.emplace_back(
+          i == 0 ? nullptr
+                 : add_gate(ENCRYPTO::PrimitiveOperationType::AND, p_wires[i + 1], p_wires[i]));
+    }
+    if (num_ranges % 2 == 1) {
+      next_g_wires.emplace_back(g_wires.back());
+      next_p_wires.emplace_back(p_wires.back());
+    }
+    g_wires = std::move(next_g_wires);
+    p_wires = std::move(next_p_wires);
+  }
+  return {std::move(gates), g_wires.front()};
+}
+
 }  // namespace MOTION
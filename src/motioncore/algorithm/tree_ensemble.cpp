@@ -0,0 +1,212 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "tree_ensemble.h"
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <random>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace MOTION {
+
+bool DecisionTree::verify(std::size_t num_features) const noexcept {
+  if (depth_ == 0 || depth_ >= 8 * sizeof(std::size_t)) {
+    return false;
+  }
+  if (feature_indices_.size() != get_num_internal_nodes() ||
+      thresholds_.size() != get_num_internal_nodes() || leaf_values_.size() != get_num_leaves()) {
+    return false;
+  }
+  return std::all_of(std::begin(feature_indices_), std::end(feature_indices_),
+                     [num_features](auto f) { return f < num_features; });
+}
+
+std::uint64_t DecisionTree::evaluate(const std::uint64_t* features) const {
+  std::size_t node = 0;
+  for (std::size_t level = 0; level < depth_; ++level) {
+    bool go_right = features[feature_indices_[node]] > thresholds_[node];
+    node = 2 * node + 1 + go_right;
+  }
+  return leaf_values_[node - get_num_internal_nodes()];
+}
+
+TreeEnsemble TreeEnsemble::from_stream(std::istream& stream) {
+  auto read = [&stream](const char* what) {
+    std::uint64_t value;
+    if (!(stream >> value)) {
+      throw std::runtime_error(fmt::format("Malformed tree ensemble: cannot read {}", what));
+    }
+    return value;
+  };
+
+  TreeEnsemble model;
+  model.num_features_ = read("number of features");
+  const auto num_trees = read("number of trees");
+  model.trees_.reserve(num_trees);
+  for (std::size_t tree_i = 0; tree_i < num_trees; ++tree_i) {
+    DecisionTree tree;
+    tree.depth_ = read("tree depth");
+    if (tree.depth_ == 0 || tree.depth_ > 32) {
+      throw std::runtime_error(fmt::format("Malformed tree ensemble: tree {} has invalid depth {}",
+                                           tree_i, tree.depth_));
+    }
+    const auto num_internal_nodes = tree.get_num_internal_nodes();
+    tree.feature_indices_.resize(num_internal_nodes);
+    tree.thresholds_.resize(num_internal_nodes);
+    for (std::size_t node_i = 0; node_i < num_internal_nodes; ++node_i) {
+      tree.feature_indices_[node_i] = read("feature index");
+      tree.thresholds_[node_i] = read("threshold");
+    }
+    tree.leaf_values_.resize(tree.get_num_leaves());
+    for (auto& v : tree.leaf_values_) {
+      v = read("leaf value");
+    }
+    if (!tree.verify(model.num_features_)) {
+      throw std::runtime_error(
+          fmt::format("Malformed tree ensemble: tree {} uses an unknown feature", tree_i));
+    }
+    model.trees_.emplace_back(std::move(tree));
+  }
+  return model;
+}
+
+TreeEnsemble TreeEnsemble::from_file(const std::filesystem::path& path) {
+  std::ifstream fs(path);
+  if (!fs) {
+    throw std::runtime_error(fmt::format("Cannot open tree ensemble file {}", path.string()));
+  }
+  return from_stream(fs);
+}
+
+TreeEnsemble TreeEnsemble::make_random(std::size_t num_trees, std::size_t depth,
+                                       std::size_t num_features, std::size_t bit_size,
+                                       std::uint64_t seed) {
+  if (depth == 0 || num_features == 0 || bit_size == 0 || bit_size > 64) {
+    throw std::invalid_argument("invalid tree ensemble parameters");
+  }
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<std::size_t> feature_dist(0, num_features - 1);
+  const std::uint64_t mask =
+      bit_size == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bit_size) - 1;
+  TreeEnsemble model;
+  model.num_features_ = num_features;
+  model.trees_.resize(num_trees);
+  for (auto& tree : model.trees_) {
+    tree.depth_ = depth;
+    tree.feature_indices_.resize(tree.get_num_internal_nodes());
+    tree.thresholds_.resize(tree.get_num_internal_nodes());
+    tree.leaf_values_.resize(tree.get_num_leaves());
+    std::generate(std::begin(tree.feature_indices_), std::end(tree.feature_indices_),
+                  [&] { return feature_dist(rng); });
+    std::generate(std::begin(tree.thresholds_), std::end(tree.thresholds_),
+                  [&] { return rng() & mask; });
+    std::generate(std::begin(tree.leaf_values_), std::end(tree.leaf_values_),
+                  [&] { return rng() & mask; });
+  }
+  return model;
+}
+
+bool TreeEnsemble::verify() const noexcept {
+  return !trees_.empty() && std::all_of(std::begin(trees_), std::end(trees_), [this](auto& t) {
+    return t.verify(num_features_);
+  });
+}
+
+std::size_t TreeEnsemble::get_max_depth() const noexcept {
+  std::size_t max_depth = 0;
+  for (const auto& tree : trees_) {
+    max_depth = std::max(max_depth, tree.depth_);
+  }
+  return max_depth;
+}
+
+std::size_t TreeEnsemble::get_num_internal_nodes() const noexcept {
+  std::size_t n = 0;
+  for (const auto& tree : trees_) {
+    n += tree.get_num_internal_nodes();
+  }
+  return n;
+}
+
+std::size_t TreeEnsemble::get_num_leaves() const noexcept {
+  std::size_t n = 0;
+  for (const auto& tree : trees_) {
+    n += tree.get_num_leaves();
+  }
+  return n;
+}
+
+std::vector<std::size_t> TreeEnsemble::get_node_feature_indices() const {
+  std::vector<std::size_t> result;
+  result.reserve(get_num_internal_nodes());
+  for (const auto& tree : trees_) {
+    result.insert(std::end(result), std::begin(tree.feature_indices_),
+                  std::end(tree.feature_indices_));
+  }
+  return result;
+}
+
+std::vector<std::uint64_t> TreeEnsemble::get_thresholds() const {
+  std::vector<std::uint64_t> result;
+  result.reserve(get_num_internal_nodes());
+  for (const auto& tree : trees_) {
+    result.insert(std::end(result), std::begin(tree.thresholds_), std::end(tree.thresholds_));
+  }
+  return result;
+}
+
+std::vector<std::uint64_t> TreeEnsemble::get_leaf_values() const {
+  std::vector<std::uint64_t> result;
+  result.reserve(get_num_leaves());
+  for (const auto& tree : trees_) {
+    result.insert(std::end(result), std::begin(tree.leaf_values_), std::end(tree.leaf_values_));
+  }
+  return result;
+}
+
+std::vector<std::size_t> TreeEnsemble::get_depths() const {
+  std::vector<std::size_t> result;
+  result.reserve(trees_.size());
+  for (const auto& tree : trees_) {
+    result.push_back(tree.depth_);
+  }
+  return result;
+}
+
+std::uint64_t TreeEnsemble::evaluate(const std::vector<std::uint64_t>& features) const {
+  if (features.size() != num_features_) {
+    throw std::invalid_argument(
+        fmt::format("expected {} features, got {}", num_features_, features.size()));
+  }
+  std::uint64_t result = 0;
+  for (const auto& tree : trees_) {
+    result += tree.evaluate(features.data());
+  }
+  return result;
+}
+
+}  // namespace MOTION
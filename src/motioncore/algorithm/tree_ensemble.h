@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <vector>
+
+namespace MOTION {
+
+// A complete binary decision tree of depth d >= 1.  The 2^d - 1 internal
+// nodes are stored in breadth-first order, i.e., node i has the children
+// 2i + 1 (left) and 2i + 2 (right).  Node i continues with the right child if
+// feature feature_indices_[i] is greater than thresholds_[i], where features
+// and thresholds are compared as unsigned integers.  The 2^d leaves are
+// stored from left to right.  Shallower paths can be represented by
+// replicating the leaf value below the node where the path ends.
+struct DecisionTree {
+  std::size_t depth_;
+  std::vector<std::size_t> feature_indices_;
+  std::vector<std::uint64_t> thresholds_;
+  std::vector<std::uint64_t> leaf_values_;
+
+  std::size_t get_num_internal_nodes() const noexcept { return (std::size_t(1) << depth_) - 1; }
+  std::size_t get_num_leaves() const noexcept { return std::size_t(1) << depth_; }
+  bool verify(std::size_t num_features) const noexcept;
+  std::uint64_t evaluate(const std::uint64_t* features) const;
+};
+
+// An ensemble of decision trees whose output is the sum of the selected leaf
+// values (modulo 2^64).  Averages, e.g., for random forests, can be obtained
+// by scaling the leaf values.
+//
+// The text format consists of whitespace separated numbers:
+//
+//   <num_features> <num_trees>
+//   for each tree:
+//     <depth>
+//     for each internal node: <feature_index> <threshold>
+//     for each leaf: <leaf_value>
+struct TreeEnsemble {
+  std::size_t num_features_;
+  std::vector<DecisionTree> trees_;
+
+  static TreeEnsemble from_stream(std::istream&);
+  static TreeEnsemble from_file(const std::filesystem::path&);
+  // random model, e.g., for benchmarks; equal seeds yield equal models
+  static TreeEnsemble make_random(std::size_t num_trees, std::size_t depth,
+                                  std::size_t num_features, std::size_t bit_size,
+                                  std::uint64_t seed = 0);
+
+  bool verify() const noexcept;
+  std::size_t get_num_trees() const noexcept { return trees_.size(); }
+  std::size_t get_max_depth() const noexcept;
+  std::size_t get_num_internal_nodes() const noexcept;
+  std::size_t get_num_leaves() const noexcept;
+  // features of all internal nodes of all trees
+  std::vector<std::size_t> get_node_feature_indices() const;
+  // thresholds of all internal nodes of all trees
+  std::vector<std::uint64_t> get_thresholds() const;
+  // leaf values of all trees
+  std::vector<std::uint64_t> get_leaf_values() const;
+  std::vector<std::size_t> get_depths() const;
+  std::uint64_t evaluate(const std::vector<std::uint64_t>& features) const;
+};
+
+}  // namespace MOTION
@@ -34,6 +34,7 @@ enum class PrimitiveOperationType : std::uint8_t;
 
 namespace MOTION {
 
+class CircuitLoader;
 class GateFactory;
 enum class MPCProtocol : unsigned int;
 class NewWire;
@@ -49,6 +50,7 @@ class CircuitBuilder {
   WireVector convert(MPCProtocol, const WireVector&);
   virtual std::optional<MPCProtocol> convert_via(MPCProtocol src, MPCProtocol dst);
   virtual GateFactory& get_gate_factory(MPCProtocol) = 0;
+  virtual CircuitLoader& get_circuit_loader() = 0;
 };
 
 }  // namespace MOTION
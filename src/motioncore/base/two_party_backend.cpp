@@ -28,6 +28,7 @@
 #include <fmt/format.h>
 
 #include "algorithm/circuit_loader.h"
+#include "algorithm/make_circuit.h"
 #include "base/gate_register.h"
 #include "communication/communication_layer.h"
 #include "crypto/arithmetic_provider.h"
@@ -37,6 +38,7 @@
 #include "crypto/multiplication_triple/sb_provider.h"
 #include "crypto/multiplication_triple/sp_provider.h"
 #include "crypto/oblivious_transfer/ot_provider.h"
+#include "crypto/trusted_dealer.h"
 #include "executor/new_gate_executor.h"
 #include "protocols/beavy/beavy_provider.h"
 #include "protocols/gmw/gmw_provider.h"
@@ -44,12 +46,16 @@
 #include "statistics/run_time_stats.h"
 #include "utility/logger.h"
 #include "utility/typedefs.h"
+#include "wire/new_wire.h"
 
 namespace MOTION {
 
 TwoPartyBackend::TwoPartyBackend(Communication::CommunicationLayer& comm_layer,
                                  std::size_t num_threads, bool sync_between_setup_and_online,
-                                 std::shared_ptr<Logger> logger)
+                                 std::shared_ptr<Logger> logger,
+                                 std::optional<std::uint64_t> trusted_dealer_seed,
+                                 std::optional<ENCRYPTO::ObliviousTransfer::OTPoolConfig>
+                                     ot_pool_config)
     : comm_layer_(comm_layer),
       my_id_(comm_layer_.get_my_id()),
       logger_(logger),
@@ -59,21 +65,40 @@ TwoPartyBackend::TwoPartyBackend(Communication::CommunicationLayer& comm_layer,
           [this] { comm_layer_.sync(); }, num_threads, logger_)),
       circuit_loader_(std::make_unique<CircuitLoader>()),
       run_time_stats_(1),
+      trusted_dealer_(trusted_dealer_seed.has_value()
+                          ? std::make_unique<Crypto::TrustedDealer>(
+                                *trusted_dealer_seed, my_id_, comm_layer_.get_num_parties())
+                          : nullptr),
       motion_base_provider_(std::make_unique<Crypto::MotionBaseProvider>(comm_layer_, logger_)),
       base_ot_provider_(
           std::make_unique<BaseOTProvider>(comm_layer_, &run_time_stats_.back(), logger_)),
+      ot_pool_(ot_pool_config.has_value() && !trusted_dealer_
+                   ? std::make_unique<ENCRYPTO::ObliviousTransfer::ROTPoolManager>(
+                         comm_layer_, *base_ot_provider_, *motion_base_provider_,
+                         *ot_pool_config, logger_)
+                   : nullptr),
       ot_manager_(std::make_unique<ENCRYPTO::ObliviousTransfer::OTProviderManager>(
           comm_layer_, *base_ot_provider_, *motion_base_provider_, &run_time_stats_.back(),
-          logger_)),
+          logger_, trusted_dealer_.get(), ot_pool_.get())),
       arithmetic_manager_(
           std::make_unique<ArithmeticProviderManager>(comm_layer_, *ot_manager_, logger_)),
-      mt_provider_(std::make_unique<MTProviderFromOTs>(my_id_, comm_layer_.get_num_parties(), true,
-                                                       *arithmetic_manager_, *ot_manager_,
-                                                       run_time_stats_.back(), logger_)),
-      sp_provider_(std::make_unique<SPProviderFromOTs>(ot_manager_->get_providers(), my_id_,
-                                                       run_time_stats_.back(), logger_)),
-      sb_provider_(std::make_unique<TwoPartySBProvider>(
-          comm_layer_, ot_manager_->get_provider(1 - my_id_), run_time_stats_.back(), logger_)),
+      mt_provider_(trusted_dealer_
+                       ? std::unique_ptr<MTProvider>(std::make_unique<MTProviderFromDealer>(
+                             *trusted_dealer_, run_time_stats_.back(), logger_))
+                       : std::make_unique<MTProviderFromOTs>(
+                             my_id_, comm_layer_.get_num_parties(), true, *arithmetic_manager_,
+                             *ot_manager_, run_time_stats_.back(), logger_)),
+      sp_provider_(trusted_dealer_
+                       ? std::unique_ptr<SPProvider>(std::make_unique<SPProviderFromDealer>(
+                             *trusted_dealer_, run_time_stats_.back(), logger_))
+                       : std::make_unique<SPProviderFromOTs>(ot_manager_->get_providers(), my_id_,
+                                                             run_time_stats_.back(), logger_)),
+      sb_provider_(trusted_dealer_
+                       ? std::unique_ptr<SBProvider>(std::make_unique<SBProviderFromDealer>(
+                             *trusted_dealer_, run_time_stats_.back(), logger_))
+                       : std::make_unique<TwoPartySBProvider>(
+                             comm_layer_, ot_manager_->get_provider(1 - my_id_),
+                             run_time_stats_.back(), logger_)),
       beavy_provider_(std::make_unique<proto::beavy::BEAVYProvider>(
           comm_layer_, *gate_register_, *circuit_loader_, *motion_base_provider_, *ot_manager_,
           *arithmetic_manager_, logger_)),
@@ -83,6 +108,7 @@ TwoPartyBackend::TwoPartyBackend(Communication::CommunicationLayer& comm_layer,
       yao_provider_(std::make_unique<proto::yao::YaoProvider>(
           comm_layer_, *gate_register_, *circuit_loader_, *motion_base_provider_,
           ot_manager_->get_provider(1 - my_id_), logger_)) {
+  ot_manager_->set_num_threads(num_threads);
   gate_factories_.emplace(MPCProtocol::ArithmeticBEAVY, *beavy_provider_);
   gate_factories_.emplace(MPCProtocol::BooleanBEAVY, *beavy_provider_);
   gate_factories_.emplace(MPCProtocol::ArithmeticGMW, *gmw_provider_);
@@ -97,7 +123,14 @@ void TwoPartyBackend::run_preprocessing() {
   run_time_stats_.back().record_start<Statistics::RunTimeStats::StatID::preprocessing>();
 
   motion_base_provider_->setup();
-  base_ot_provider_->ComputeBaseOTs();
+  if (!trusted_dealer_) {
+    base_ot_provider_->ComputeBaseOTs();
+  }
+  if (ot_pool_ && !ot_pool_started_) {
+    // the pools keep running across multiple runs
+    ot_pool_->start();
+    ot_pool_started_ = true;
+  }
   mt_provider_->PreSetup();
   sp_provider_->PreSetup();
   sb_provider_->PreSetup();
@@ -112,6 +145,10 @@ void TwoPartyBackend::run_preprocessing() {
   run_time_stats_.back().record_end<Statistics::RunTimeStats::StatID::preprocessing>();
 }
 
+void TwoPartyBackend::share_base_ots(BaseOTProvider& source, std::uint64_t session_id) {
+  base_ot_provider_->ImportDerivedBaseOTs(source, session_id);
+}
+
 void TwoPartyBackend::run() {
   std::cout << "Before evaluate setup online \n";
   gate_executor_->evaluate_setup_online(run_time_stats_.back());
@@ -119,6 +156,31 @@ void TwoPartyBackend::run() {
 
 }
 
+void TwoPartyBackend::set_streaming(std::size_t max_gates_in_flight) {
+  if (gate_register_->get_num_gates() > 0) {
+    throw std::logic_error(
+        "TwoPartyBackend::set_streaming: needs to be called before any gate is created");
+  }
+  circuit_loader_->set_levelize_circuits(max_gates_in_flight > 0);
+  gate_executor_->set_streaming(max_gates_in_flight);
+}
+
+void TwoPartyBackend::make_circuit_lazily(const ENCRYPTO::AlgorithmDescription& algo,
+                                          const WireVector& wires_in_a,
+                                          const WireVector& wires_in_b,
+                                          std::function<void(const WireVector&)> on_outputs) {
+  const bool yao = !wires_in_a.empty() && wires_in_a[0]->get_protocol() == MPCProtocol::Yao;
+  if (!gate_executor_->is_streaming() || !yao) {
+    on_outputs(make_circuit(algo, wires_in_a, wires_in_b));
+    return;
+  }
+  if (gate_executor_->has_gate_generator()) {
+    throw std::logic_error("TwoPartyBackend::make_circuit_lazily: only one circuit is supported");
+  }
+  gate_executor_->set_gate_generator(::MOTION::make_circuit_lazily(
+      *this, algo, wires_in_a, wires_in_b, std::move(on_outputs)));
+}
+
 std::optional<MPCProtocol> TwoPartyBackend::convert_via(MPCProtocol src_proto,
                                                         MPCProtocol dst_proto) {
   if (src_proto == MPCProtocol::ArithmeticGMW && dst_proto == MPCProtocol::BooleanGMW) {
@@ -147,6 +209,8 @@ GateFactory& TwoPartyBackend::get_gate_factory(MPCProtocol proto) {
   }
 }
 
+CircuitLoader& TwoPartyBackend::get_circuit_loader() { return *circuit_loader_; }
+
 const Statistics::RunTimeStats& TwoPartyBackend::get_run_time_stats() const noexcept {
   return run_time_stats_.back();
 }
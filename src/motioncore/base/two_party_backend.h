@@ -22,10 +22,14 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 #include "circuit_builder.h"
+#include "crypto/oblivious_transfer/ot_pool.h"
 #include "gate_factory.h"
 
 namespace ENCRYPTO::ObliviousTransfer {
@@ -52,6 +56,7 @@ class CommunicationLayer;
 
 namespace Crypto {
 class MotionBaseProvider;
+class TrustedDealer;
 }
 
 namespace proto {
@@ -72,15 +77,49 @@ struct RunTimeStats;
 
 class TwoPartyBackend : public CircuitBuilder {
  public:
+  // If a trusted_dealer_seed is given, all correlated randomness (OTs, MTs,
+  // SPs, SBs, and linear algebra triples) is derived locally from this seed
+  // without communication (cf. Crypto::TrustedDealer).  This is insecure and
+  // only meant to measure the performance of the online phase.  If an
+  // ot_pool_config is given, all OTs are taken from OT pools which are
+  // refilled in the background (cf. ENCRYPTO::ObliviousTransfer::ROTPool)
+  // instead of running the OT extension during the preprocessing.  Both
+  // parties need to use the same configuration.  The pools are not used
+  // together with a trusted dealer.
   TwoPartyBackend(Communication::CommunicationLayer&, std::size_t num_threads,
-                  bool sync_between_setup_and_online, std::shared_ptr<Logger>);
+                  bool sync_between_setup_and_online, std::shared_ptr<Logger>,
+                  std::optional<std::uint64_t> trusted_dealer_seed = std::nullopt,
+                  std::optional<ENCRYPTO::ObliviousTransfer::OTPoolConfig> ot_pool_config =
+                      std::nullopt);
   ~TwoPartyBackend();
 
   void run_preprocessing();
   void run();
 
+  // Derive the base OTs from the given ones (cf. TwoPartyTensorBackend).
+  void share_base_ots(BaseOTProvider& source, std::uint64_t session_id);
+
+  // Evaluate large circuits in streaming mode: circuits loaded from files are
+  // levelized, at most max_gates_in_flight gates are evaluated at the same
+  // time, and gates are released as soon as they have been evaluated (cf.
+  // NewGateExecutor::set_streaming).  Needs to be called before the circuit
+  // is built.  0 disables the streaming mode.
+  void set_streaming(std::size_t max_gates_in_flight);
+
+  // Streaming mode: create the gates of a Yao circuit level by level while it
+  // is evaluated instead of all at once (cf. make_circuit_lazily), s.t. only
+  // the gates in the window exist at the same time.  on_outputs is called
+  // with the output wires once they have been created and may create gates
+  // reading them, e.g., output gates.  Otherwise, the circuit is created
+  // directly, since the gates of GMW and BEAVY request their OTs and MTs when
+  // they are created, which needs to happen before the preprocessing.
+  void make_circuit_lazily(const ENCRYPTO::AlgorithmDescription&, const WireVector& wires_in_a,
+                           const WireVector& wires_in_b,
+                           std::function<void(const WireVector&)> on_outputs);
+
   std::optional<MPCProtocol> convert_via(MPCProtocol src_proto, MPCProtocol dst_proto) override;
   GateFactory& get_gate_factory(MPCProtocol proto) override;
+  CircuitLoader& get_circuit_loader() override;
 
   const Statistics::RunTimeStats& get_run_time_stats() const noexcept;
 
@@ -94,8 +133,11 @@ class TwoPartyBackend : public CircuitBuilder {
   std::unordered_map<MPCProtocol, std::reference_wrapper<GateFactory>> gate_factories_;
   std::vector<Statistics::RunTimeStats> run_time_stats_;
 
+  std::unique_ptr<Crypto::TrustedDealer> trusted_dealer_;
   std::unique_ptr<Crypto::MotionBaseProvider> motion_base_provider_;
   std::unique_ptr<BaseOTProvider> base_ot_provider_;
+  std::unique_ptr<ENCRYPTO::ObliviousTransfer::ROTPoolManager> ot_pool_;
+  bool ot_pool_started_ = false;
   std::unique_ptr<ENCRYPTO::ObliviousTransfer::OTProviderManager> ot_manager_;
   std::unique_ptr<ArithmeticProviderManager> arithmetic_manager_;
   std::unique_ptr<MTProvider> mt_provider_;
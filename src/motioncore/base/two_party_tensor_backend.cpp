@@ -26,6 +26,7 @@
 #include <stdexcept>
 
 #include <fmt/format.h>
+#include <omp.h>
 
 #include "algorithm/circuit_loader.h"
 #include "base/gate_register.h"
@@ -38,6 +39,7 @@
 #include "crypto/multiplication_triple/sb_provider.h"
 #include "crypto/multiplication_triple/sp_provider.h"
 #include "crypto/oblivious_transfer/ot_provider.h"
+#include "crypto/trusted_dealer.h"
 #include "executor/tensor_op_executor.h"
 #include "protocols/beavy/beavy_provider.h"
 #include "protocols/gmw/gmw_provider.h"
@@ -52,7 +54,9 @@ namespace MOTION {
 TwoPartyTensorBackend::TwoPartyTensorBackend(Communication::CommunicationLayer& comm_layer,
                                              std::size_t num_threads,
                                              bool sync_between_setup_and_online,
-                                             std::shared_ptr<Logger> logger, bool fake_triples)
+                                             std::shared_ptr<Logger> logger, bool fake_triples,
+                                             std::optional<std::uint64_t> trusted_dealer_seed,
+                                             std::optional<LinAlgHEConfig> linalg_he_config)
     : comm_layer_(comm_layer),
       my_id_(comm_layer_.get_my_id()),
       logger_(logger),
@@ -62,28 +66,51 @@ TwoPartyTensorBackend::TwoPartyTensorBackend(Communication::CommunicationLayer&
           [this] { comm_layer_.sync(); }, num_threads, logger_)),
       circuit_loader_(std::make_unique<CircuitLoader>()),
       run_time_stats_(1),
+      trusted_dealer_(trusted_dealer_seed.has_value()
+                          ? std::make_unique<Crypto::TrustedDealer>(
+                                *trusted_dealer_seed, my_id_, comm_layer_.get_num_parties())
+                          : nullptr),
       motion_base_provider_(std::make_unique<Crypto::MotionBaseProvider>(comm_layer_, logger_)),
       base_ot_provider_(
           std::make_unique<BaseOTProvider>(comm_layer_, &run_time_stats_.back(), logger_)),
       ot_manager_(std::make_unique<ENCRYPTO::ObliviousTransfer::OTProviderManager>(
           comm_layer_, *base_ot_provider_, *motion_base_provider_, &run_time_stats_.back(),
-          logger_)),
+          logger_, trusted_dealer_.get())),
       arithmetic_manager_(
           std::make_unique<ArithmeticProviderManager>(comm_layer_, *ot_manager_, logger_)),
-      linalg_triple_provider_(fake_triples ? (std::dynamic_pointer_cast<LinAlgTripleProvider>(
-                                                 std::make_shared<FakeLinAlgTripleProvider>()))
-                                           : (std::dynamic_pointer_cast<LinAlgTripleProvider>(
-                                                 std::make_shared<LinAlgTriplesFromAP>(
-                                                     arithmetic_manager_->get_provider(1 - my_id_),
-                                                     ot_manager_->get_provider(1 - my_id_),
-                                                     run_time_stats_.back(), logger_)))),
-      mt_provider_(std::make_unique<MTProviderFromOTs>(my_id_, comm_layer_.get_num_parties(), true,
-                                                       *arithmetic_manager_, *ot_manager_,
-                                                       run_time_stats_.back(), logger_)),
-      sp_provider_(std::make_unique<SPProviderFromOTs>(ot_manager_->get_providers(), my_id_,
-                                                       run_time_stats_.back(), logger_)),
-      sb_provider_(std::make_unique<TwoPartySBProvider>(
-          comm_layer_, ot_manager_->get_provider(1 - my_id_), run_time_stats_.back(), logger_)),
+      linalg_triple_provider_(
+          trusted_dealer_
+              ? std::dynamic_pointer_cast<LinAlgTripleProvider>(
+                    std::make_shared<LinAlgTriplesFromDealer>(*trusted_dealer_))
+          : fake_triples ? (std::dynamic_pointer_cast<LinAlgTripleProvider>(
+                               std::make_shared<FakeLinAlgTripleProvider>()))
+          : linalg_he_config ? (std::dynamic_pointer_cast<LinAlgTripleProvider>(
+                                   std::make_shared<LinAlgTriplesFromHE>(
+                                       comm_layer_, arithmetic_manager_->get_provider(1 - my_id_),
+                                       ot_manager_->get_provider(1 - my_id_),
+                                       run_time_stats_.back(), logger_, *linalg_he_config)))
+                         : (std::dynamic_pointer_cast<LinAlgTripleProvider>(
+                               std::make_shared<LinAlgTriplesFromAP>(
+                                   arithmetic_manager_->get_provider(1 - my_id_),
+                                   ot_manager_->get_provider(1 - my_id_), run_time_stats_.back(),
+                                   logger_)))),
+      mt_provider_(trusted_dealer_
+                       ? std::unique_ptr<MTProvider>(std::make_unique<MTProviderFromDealer>(
+                             *trusted_dealer_, run_time_stats_.back(), logger_))
+                       : std::make_unique<MTProviderFromOTs>(
+                             my_id_, comm_layer_.get_num_parties(), true, *arithmetic_manager_,
+                             *ot_manager_, run_time_stats_.back(), logger_)),
+      sp_provider_(trusted_dealer_
+                       ? std::unique_ptr<SPProvider>(std::make_unique<SPProviderFromDealer>(
+                             *trusted_dealer_, run_time_stats_.back(), logger_))
+                       : std::make_unique<SPProviderFromOTs>(ot_manager_->get_providers(), my_id_,
+                                                             run_time_stats_.back(), logger_)),
+      sb_provider_(trusted_dealer_
+                       ? std::unique_ptr<SBProvider>(std::make_unique<SBProviderFromDealer>(
+                             *trusted_dealer_, run_time_stats_.back(), logger_))
+                       : std::make_unique<TwoPartySBProvider>(
+                             comm_layer_, ot_manager_->get_provider(1 - my_id_),
+                             run_time_stats_.back(), logger_)),
       beavy_provider_(std::make_unique<proto::beavy::BEAVYProvider>(
           comm_layer_, *gate_register_, *circuit_loader_, *motion_base_provider_, *ot_manager_,
           *arithmetic_manager_, logger_, fake_triples)),
@@ -93,6 +120,12 @@ TwoPartyTensorBackend::TwoPartyTensorBackend(Communication::CommunicationLayer&
       yao_provider_(std::make_unique<proto::yao::YaoProvider>(
           comm_layer_, *gate_register_, *circuit_loader_, *motion_base_provider_,
           ot_manager_->get_provider(1 - my_id_), logger_)) {
+  if (linalg_he_config && (trusted_dealer_ || fake_triples)) {
+    throw std::invalid_argument(
+        "TwoPartyTensorBackend: HE-based linear algebra triples cannot be combined with fake "
+        "triples or a trusted dealer");
+  }
+  ot_manager_->set_num_threads(num_threads);
   gmw_provider_->set_linalg_triple_provider(linalg_triple_provider_);
   tensor_op_factories_.emplace(MPCProtocol::ArithmeticBEAVY, *beavy_provider_);
   tensor_op_factories_.emplace(MPCProtocol::BooleanBEAVY, *beavy_provider_);
@@ -108,10 +141,16 @@ void TwoPartyTensorBackend::run_preprocessing() {
   run_time_stats_.back().record_start<Statistics::RunTimeStats::StatID::preprocessing>();
 
   motion_base_provider_->setup();
-  base_ot_provider_->ComputeBaseOTs();
+  if (!trusted_dealer_) {
+    base_ot_provider_->ComputeBaseOTs();
+  }
   mt_provider_->PreSetup();
   sp_provider_->PreSetup();
   sb_provider_->PreSetup();
+  if (uses_thread_budget_) {
+    // the executor has set the OpenMP threads of this thread to its lease
+    ot_manager_->set_num_threads(omp_get_max_threads());
+  }
   ot_manager_->run_setup();
   linalg_triple_provider_->setup();
   mt_provider_->Setup();
@@ -124,6 +163,19 @@ void TwoPartyTensorBackend::run_preprocessing() {
   run_time_stats_.back().record_end<Statistics::RunTimeStats::StatID::preprocessing>();
 }
 
+void TwoPartyTensorBackend::share_base_ots(BaseOTProvider& source, std::uint64_t session_id) {
+  base_ot_provider_->ImportDerivedBaseOTs(source, session_id);
+}
+
+void TwoPartyTensorBackend::set_speculative_online(bool speculative_online) {
+  gate_executor_->set_speculative_online(speculative_online);
+}
+
+void TwoPartyTensorBackend::set_thread_budget(std::shared_ptr<ThreadBudget> thread_budget) {
+  uses_thread_budget_ = thread_budget != nullptr;
+  gate_executor_->set_thread_budget(std::move(thread_budget));
+}
+
 void TwoPartyTensorBackend::run() {
   gate_executor_->evaluate_setup_online(run_time_stats_.back());
 }
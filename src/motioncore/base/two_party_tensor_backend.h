@@ -22,10 +22,13 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
+#include "crypto/multiplication_triple/linalg_triple_provider.h"
 #include "tensor/network_builder.h"
 
 namespace ENCRYPTO::ObliviousTransfer {
@@ -38,12 +41,12 @@ class ArithmeticProviderManager;
 class BaseOTProvider;
 class CircuitLoader;
 class GateRegister;
-class LinAlgTripleProvider;
 class Logger;
 class MTProvider;
 class TensorOpExecutor;
 class SBProvider;
 class SPProvider;
+class ThreadBudget;
 enum class MPCProtocol : unsigned int;
 
 namespace Communication {
@@ -52,6 +55,7 @@ class CommunicationLayer;
 
 namespace Crypto {
 class MotionBaseProvider;
+class TrustedDealer;
 }
 
 namespace proto {
@@ -76,14 +80,38 @@ class TensorOpFactory;
 
 class TwoPartyTensorBackend : public tensor::NetworkBuilder {
  public:
+  // fake_triples: use random data instead of linear algebra triples
+  // trusted_dealer_seed: derive all correlated randomness locally from this
+  // seed, which yields correct results (insecure, see TwoPartyBackend)
+  // linalg_he_config: generate the GEMM and Conv2D triples with linear
+  // homomorphic encryption where the config selects it (cf.
+  // LinAlgTriplesFromHE), cannot be combined with the two options above
   TwoPartyTensorBackend(Communication::CommunicationLayer&, std::size_t num_threads,
                         bool sync_between_setup_and_online, std::shared_ptr<Logger>,
-                        bool fake_triples = false);
+                        bool fake_triples = false,
+                        std::optional<std::uint64_t> trusted_dealer_seed = std::nullopt,
+                        std::optional<LinAlgHEConfig> linalg_he_config = std::nullopt);
   virtual ~TwoPartyTensorBackend();
 
   virtual void run_preprocessing();
   void run();
 
+  // Derive the base OTs of this backend from the given (finished) base OTs
+  // instead of computing them, e.g., if several backends run concurrently on
+  // sessions of a Communication::SessionMultiplexer.  The session id needs to
+  // be unique among the backends.  Needs to be called before the preprocessing.
+  void share_base_ots(BaseOTProvider& source, std::uint64_t session_id);
+
+  // Start the online phase of the gates concurrently to their setup phase
+  // (cf. TensorOpExecutor::set_speculative_online).  Disabled by default.
+  void set_speculative_online(bool speculative_online);
+
+  // Share the threads with other backends which run concurrently (cf.
+  // TensorOpExecutor::set_thread_budget).  The num_threads given to the
+  // constructor is then the maximum this backend leases, and the OT extension
+  // uses the threads of the lease.
+  void set_thread_budget(std::shared_ptr<ThreadBudget> thread_budget);
+
   tensor::TensorOpFactory& get_tensor_op_factory(MPCProtocol) override;
   std::optional<MPCProtocol> convert_via(MPCProtocol src_proto, MPCProtocol dst_proto) override;
 
@@ -99,7 +127,9 @@ class TwoPartyTensorBackend : public tensor::NetworkBuilder {
   std::unordered_map<MPCProtocol, std::reference_wrapper<tensor::TensorOpFactory>>
       tensor_op_factories_;
   std::vector<Statistics::RunTimeStats> run_time_stats_;
+  bool uses_thread_budget_ = false;
 
+  std::unique_ptr<Crypto::TrustedDealer> trusted_dealer_;
   std::unique_ptr<Crypto::MotionBaseProvider> motion_base_provider_;
   std::unique_ptr<BaseOTProvider> base_ot_provider_;
   std::unique_ptr<ENCRYPTO::ObliviousTransfer::OTProviderManager> ot_manager_;
@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <shared_mutex>
 #include <stdexcept>
 #include <thread>
@@ -33,8 +34,10 @@
 #include <flatbuffers/flatbuffers.h>
 #include <fmt/format.h>
 
+#include "compact_message.h"
 #include "dummy_transport.h"
 #include "message.h"
+#include "message_compression.h"
 #include "message_handler.h"
 #include "sync_handler.h"
 #include "tcp_transport.h"
@@ -75,6 +78,9 @@ struct CommunicationLayer::CommunicationLayerImpl {
   std::vector<std::thread> receive_threads_;
   std::vector<std::thread> send_threads_;
 
+  // optional compression of outgoing messages (one compressor per send thread)
+  std::vector<std::unique_ptr<MessageCompressor>> compressors_;
+
   using MessageHandlerMap = std::unordered_map<MessageType, std::shared_ptr<MessageHandler>>;
   std::shared_mutex message_handlers_mutex_;
   std::vector<MessageHandlerMap> message_handlers_;
@@ -93,6 +99,7 @@ CommunicationLayer::CommunicationLayerImpl::CommunicationLayerImpl(
       start_sfuture_(start_promise_.get_future().share()),
       transports_(std::move(transports)),
       send_queues_(num_parties_),
+      compressors_(num_parties_),
       message_handlers_(num_parties_),
       fallback_message_handlers_(num_parties_),
       sync_handler_(std::make_shared<SyncHandler>(my_id_, num_parties_, logger)),
@@ -120,6 +127,9 @@ void CommunicationLayer::CommunicationLayerImpl::send_task(std::size_t party_id)
   auto my_start_sfuture = start_sfuture_;
   my_start_sfuture.get();
 
+  // the compressors are only set before the start
+  auto* compressor = compressors_.at(party_id).get();
+
   while (!queue.closed_and_empty()) {
     auto tmp_queue = queue.batch_dequeue();
     if (!tmp_queue.has_value()) {
@@ -130,10 +140,21 @@ void CommunicationLayer::CommunicationLayerImpl::send_task(std::size_t party_id)
       auto& message = tmp_queue->front();
       if (message.index() == 0) {
         // std::vector<std::uint8_t>
+        if (compressor) {
+          compressor->compress(std::get<0>(message));
+        }
         transport.send_message(std::get<0>(message));
       } else if (message.index() == 1) {
         // std::shared_ptr<const std::vector<std::uint8_t>>
-        transport.send_message(*std::get<1>(message));
+        // (shared with other send threads, so compress a copy)
+        if (compressor) {
+          auto compressed_message = compressor->compressed_copy(*std::get<1>(message));
+          if (!compressed_message.empty()) {
+            message = std::move(compressed_message);
+          }
+        }
+        transport.send_message(message.index() == 0 ? std::get<0>(message)
+                                                    : *std::get<1>(message));
       } else if (message.index() == 2) {
         // flatbuffers::DetachedBuffer
         const auto& detached_buffer = std::get<2>(message);
@@ -155,7 +176,13 @@ void CommunicationLayer::CommunicationLayerImpl::send_task(std::size_t party_id)
             message_size = std::get<2>(message).size();
           }
           flatbuffers::Verifier verifier(raw_message, message_size);
-          if (VerifyMessageBuffer(verifier)) {
+          if (IsCompactMessage(raw_message, message_size)) {
+            auto compact_message = ParseCompactMessage(raw_message, message_size);
+            logger_->LogDebug(fmt::format(
+                "Sent message of type {} to party {}",
+                compact_message ? EnumNameMessageType(compact_message->message_type) : "unknown",
+                party_id));
+          } else if (VerifyMessageBuffer(verifier)) {
             auto fb_message = GetMessage(raw_message);
             auto message_type = fb_message->message_type();
             logger_->LogDebug(fmt::format("Sent message of type {} to party {}",
@@ -207,23 +234,53 @@ void CommunicationLayer::CommunicationLayerImpl::receive_task(std::size_t party_
     }
     auto raw_message = std::move(*raw_message_opt);
 
-    flatbuffers::Verifier verifier(reinterpret_cast<std::uint8_t*>(raw_message.data()),
-                                   raw_message.size());
-    if (!VerifyMessageBuffer(verifier)) {
-      if (logger_) {
-        logger_->LogError(fmt::format("received corrupt message from party {}", party_id));
+    MessageType message_type;
+    if (IsCompactMessage(raw_message.data(), raw_message.size())) {
+      // bulk payload in compact framing
+      const auto compact_message = ParseCompactMessage(raw_message.data(), raw_message.size());
+      if (!compact_message.has_value()) {
+        if (logger_) {
+          logger_->LogError(fmt::format("received corrupt message from party {}", party_id));
+        }
+        auto fbh = fallback_message_handlers_.at(party_id);
+        if (fbh) {
+          fbh->received_message(party_id, std::move(raw_message));
+        }
+        continue;
       }
-      auto fbh = fallback_message_handlers_.at(party_id);
-      if (fbh) {
-        fbh->received_message(party_id, std::move(raw_message));
+      message_type = compact_message->message_type;
+      if ((compact_message->flags & compact_message_flag_compressed) &&
+          !DecompressMessage(raw_message)) {
+        if (logger_) {
+          logger_->LogError(
+              fmt::format("failed to decompress message of type {} from party {}{}",
+                          EnumNameMessageType(message_type), party_id,
+                          compression_supported() ? "" : " (built without LZ4 support)"));
+        }
+        auto fbh = fallback_message_handlers_.at(party_id);
+        if (fbh) {
+          fbh->received_message(party_id, std::move(raw_message));
+        }
+        continue;
+      }
+    } else {
+      flatbuffers::Verifier verifier(reinterpret_cast<std::uint8_t*>(raw_message.data()),
+                                     raw_message.size());
+      if (!VerifyMessageBuffer(verifier)) {
+        if (logger_) {
+          logger_->LogError(fmt::format("received corrupt message from party {}", party_id));
+        }
+        auto fbh = fallback_message_handlers_.at(party_id);
+        if (fbh) {
+          fbh->received_message(party_id, std::move(raw_message));
+        }
+        continue;
       }
-      continue;
-    }
-
-    // XXX: maybe use a separate thread for this
-    auto message = GetMessage(raw_message.data());
 
-    auto message_type = message->message_type();
+      // XXX: maybe use a separate thread for this
+      auto message = GetMessage(raw_message.data());
+      message_type = message->message_type();
+    }
     if constexpr (MOTION_DEBUG) {
       if (logger_) {
         logger_->LogDebug(fmt::format("received message of type {} from party {}",
@@ -529,6 +586,61 @@ void CommunicationLayer::reset_transport_statistics() noexcept {
   }
 }
 
+void CommunicationLayer::set_compression_config(const CompressionConfig& config) {
+  if (is_started_) {
+    throw std::logic_error(
+        "changing the compression config is not allowed after the CommunicationLayer has been "
+        "started");
+  }
+  if (!config.message_types.empty() && !compression_supported()) {
+    throw std::logic_error("message compression requires MOTION to be built with MOTION_USE_LZ4");
+  }
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    auto& compressor = impl_->compressors_.at(party_id);
+    if (config.message_types.empty()) {
+      compressor.reset();
+    } else {
+      compressor = std::make_unique<MessageCompressor>(config);
+    }
+  }
+}
+
+std::vector<CompressionStatistics> CommunicationLayer::get_compression_statistics() const {
+  std::map<MessageType, CompressionStatistics> stats_map;
+  for (const auto& compressor : impl_->compressors_) {
+    if (!compressor) {
+      continue;
+    }
+    for (const auto& stats : compressor->get_statistics()) {
+      auto [it, inserted] =
+          stats_map.try_emplace(stats.message_type, CompressionStatistics{stats.message_type});
+      auto& acc = it->second;
+      acc.num_messages += stats.num_messages;
+      acc.num_attempted += stats.num_attempted;
+      acc.num_compressed += stats.num_compressed;
+      acc.num_bytes_uncompressed += stats.num_bytes_uncompressed;
+      acc.num_bytes_compressed += stats.num_bytes_compressed;
+    }
+  }
+  std::vector<CompressionStatistics> result;
+  result.reserve(stats_map.size());
+  for (const auto& [type, stats] : stats_map) {
+    result.push_back(stats);
+  }
+  return result;
+}
+
+void CommunicationLayer::reset_compression_statistics() {
+  for (auto& compressor : impl_->compressors_) {
+    if (compressor) {
+      compressor->reset_statistics();
+    }
+  }
+}
+
 void CommunicationLayer::set_logger(std::shared_ptr<Logger> logger) {
   if (is_started_) {
     throw std::logic_error(
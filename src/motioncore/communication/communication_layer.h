@@ -38,6 +38,8 @@ class Logger;
 namespace Communication {
 
 class MessageHandler;
+struct CompressionConfig;
+struct CompressionStatistics;
 struct TransportStatistics;
 
 // Central interface for all communication related functionality
@@ -90,6 +92,13 @@ class CommunicationLayer {
   std::vector<TransportStatistics> get_transport_statistics() const noexcept;
   void reset_transport_statistics() noexcept;
 
+  // Enable compression of messages (cf. message_compression.h).  Needs to be
+  // called before the CommunicationLayer is started.
+  void set_compression_config(const CompressionConfig& config);
+  // Compression statistics per message type accumulated over all parties
+  std::vector<CompressionStatistics> get_compression_statistics() const;
+  void reset_compression_statistics();
+
   void set_logger(std::shared_ptr<Logger> logger);
 
  private:
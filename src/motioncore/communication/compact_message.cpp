@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "compact_message.h"
+
+#include <cstring>
+
+namespace MOTION::Communication {
+
+// offsets of the header fields
+constexpr std::size_t marker_offset = 0;
+constexpr std::size_t message_type_offset = 4;
+constexpr std::size_t id_offset = 8;
+constexpr std::size_t msg_num_offset = 16;
+
+static_assert(msg_num_offset + sizeof(std::uint64_t) == compact_message_header_size);
+
+template <typename T>
+static void store_le(std::uint8_t* dst, T v) {
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    dst[i] = (v >> (8 * i)) & 0xFF;
+  }
+}
+
+template <typename T>
+static T load_le(const std::uint8_t* src) {
+  T v = 0;
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    v |= T(src[i]) << (8 * i);
+  }
+  return v;
+}
+
+bool IsCompactMessage(const std::uint8_t* message, std::size_t size) {
+  return size >= compact_message_header_size &&
+         load_le<std::uint32_t>(message + marker_offset) == compact_message_marker;
+}
+
+std::vector<std::uint8_t> BuildCompactMessage(MessageType message_type, std::uint64_t id,
+                                              std::uint64_t msg_num, const std::uint8_t* payload,
+                                              std::size_t payload_size) {
+  std::vector<std::uint8_t> message(compact_message_header_size + payload_size);
+  auto header = message.data();
+  store_le(header + marker_offset, compact_message_marker);
+  header[message_type_offset] = static_cast<std::uint8_t>(message_type);
+  store_le(header + id_offset, id);
+  store_le(header + msg_num_offset, msg_num);
+  if (payload_size > 0) {
+    std::memcpy(header + compact_message_header_size, payload, payload_size);
+  }
+  return message;
+}
+
+std::optional<CompactMessageView> ParseCompactMessage(const std::uint8_t* message,
+                                                      std::size_t size) {
+  if (!IsCompactMessage(message, size)) {
+    return std::nullopt;
+  }
+  const auto message_type = static_cast<MessageType>(message[message_type_offset]);
+  if (message_type < MessageType::MIN || message_type > MessageType::MAX) {
+    return std::nullopt;
+  }
+  const auto flags = message[compact_message_flags_offset];
+  if ((flags & ~compact_message_flag_compressed) != 0) {
+    return std::nullopt;
+  }
+  return CompactMessageView{message_type, load_le<std::uint64_t>(message + id_offset),
+                            load_le<std::uint64_t>(message + msg_num_offset), flags,
+                            message + compact_message_header_size,
+                            size - compact_message_header_size};
+}
+
+}  // namespace MOTION::Communication
@@ -0,0 +1,81 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "fbs_headers/message_generated.h"
+
+namespace MOTION::Communication {
+
+// Compact framing for high-volume messages (gate messages and OT extension)
+//
+// Bulk payloads are sent with a fixed header instead of being wrapped into
+// FlatBuffers twice.  The payload is copied once from the share buffer into
+// the message, and no alignment or vtable overhead is added.  FlatBuffers are
+// still used for all control messages.
+//
+//  +--------------+--------------+-------+----------+--------------+--------------+---------+
+//  | uint32       | uint8        | uint8 | 2 bytes  | uint64       | uint64       | ...     |
+//  +--------------+--------------+-------+----------+--------------+--------------+---------+
+//  | marker       | message_type | flags | reserved | id           | msg_num      | payload |
+//  +--------------+--------------+-------+----------+--------------+--------------+---------+
+//
+// The marker is an invalid root offset for a FlatBuffers message, so both
+// kinds of messages can be distinguished on the receiving side.  The id is the
+// gate id or the index of an OT extension message.  All integers are little
+// endian.  If the compressed flag is set, the payload is compressed (cf.
+// message_compression.h).
+
+constexpr std::uint32_t compact_message_marker = 0xFFFFFFFF;
+constexpr std::size_t compact_message_header_size = 24;
+constexpr std::size_t compact_message_flags_offset = 5;
+constexpr std::uint8_t compact_message_flag_compressed = 0x01;
+
+struct CompactMessageView {
+  MessageType message_type;
+  std::uint64_t id;
+  std::uint64_t msg_num;
+  std::uint8_t flags;
+  const std::uint8_t* payload;
+  std::size_t payload_size;
+};
+
+// Check if the buffer contains a compact message (without validating it).
+bool IsCompactMessage(const std::uint8_t* message, std::size_t size);
+
+// Build a compact message with the given payload.
+std::vector<std::uint8_t> BuildCompactMessage(MessageType message_type, std::uint64_t id,
+                                              std::uint64_t msg_num, const std::uint8_t* payload,
+                                              std::size_t payload_size);
+
+// Parse a compact message.  Returns std::nullopt if the buffer does not
+// contain a well-formed compact message.  The view points into the buffer.
+std::optional<CompactMessageView> ParseCompactMessage(const std::uint8_t* message,
+                                                      std::size_t size);
+
+}  // namespace MOTION::Communication
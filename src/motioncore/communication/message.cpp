@@ -66,6 +66,14 @@ std::string to_string(MessageType message_type) {
       return "MessageType::OTExtensionReceiverCorrections"s;
     case MessageType::OTExtensionSender:
       return "MessageType::OTExtensionSender"s;
+    case MessageType::OTPoolReceiverMasks:
+      return "MessageType::OTPoolReceiverMasks"s;
+    case MessageType::OTPoolSenderAck:
+      return "MessageType::OTPoolSenderAck"s;
+    case MessageType::LinAlgHE:
+      return "MessageType::LinAlgHE"s;
+    case MessageType::SessionMessage:
+      return "MessageType::SessionMessage"s;
     case MessageType::BMRInputGate0:
       return "MessageType::BMRInputGate0"s;
     case MessageType::BMRInputGate1:
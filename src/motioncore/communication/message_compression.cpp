@@ -0,0 +1,264 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "message_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#ifdef MOTION_HAVE_LZ4
+#include <lz4.h>
+#endif
+
+#include "compact_message.h"
+
+namespace MOTION::Communication {
+
+// size of the uncompressed size field at the begin of a compressed payload
+constexpr std::size_t size_field_size = sizeof(std::uint64_t);
+
+CompressionConfig CompressionConfig::bulk_messages() {
+  CompressionConfig config;
+  config.message_types = {MessageType::OTExtensionReceiverMasks,
+                          MessageType::OTExtensionReceiverCorrections,
+                          MessageType::OTExtensionSender,
+                          MessageType::YaoGate,
+                          MessageType::GMWGate,
+                          MessageType::BEAVYGate};
+  return config;
+}
+
+bool compression_supported() noexcept {
+#ifdef MOTION_HAVE_LZ4
+  return true;
+#else
+  return false;
+#endif
+}
+
+double estimate_entropy(const std::uint8_t* data, std::size_t size, std::size_t sample_size) {
+  if (size == 0 || sample_size == 0) {
+    return 0.0;
+  }
+  // sample a number of evenly spaced blocks such that local structure is retained
+  constexpr std::size_t block_size = 64;
+  sample_size = std::min(sample_size, size);
+  const std::size_t num_blocks = std::max<std::size_t>(1, sample_size / block_size);
+  const std::size_t stride = size / num_blocks;
+  std::array<std::size_t, 256> histogram{};
+  std::size_t num_samples = 0;
+  for (std::size_t block_i = 0; block_i < num_blocks; ++block_i) {
+    const auto block = data + block_i * stride;
+    const auto length = std::min(block_size, size - block_i * stride);
+    for (std::size_t j = 0; j < length; ++j) {
+      ++histogram[block[j]];
+    }
+    num_samples += length;
+  }
+  double entropy = 0.0;
+  for (auto count : histogram) {
+    if (count > 0) {
+      const double p = static_cast<double>(count) / num_samples;
+      entropy -= p * std::log2(p);
+    }
+  }
+  return entropy;
+}
+
+MessageCompressor::MessageCompressor(const CompressionConfig& config)
+    : config_(config), enabled_(compression_supported() && !config.message_types.empty()) {
+  for (std::size_t type_i = 0; type_i < num_message_types; ++type_i) {
+    statistics_[type_i].message_type = static_cast<MessageType>(type_i);
+  }
+  if (!enabled_) {
+    return;
+  }
+  for (auto type : config.message_types) {
+    states_.at(static_cast<std::size_t>(type)).enabled = true;
+  }
+}
+
+bool MessageCompressor::should_try(TypeState& state, const std::uint8_t* payload,
+                                   std::size_t payload_size) {
+  if (payload_size < config_.min_payload_size) {
+    return false;
+  }
+#ifdef MOTION_HAVE_LZ4
+  if (payload_size > LZ4_MAX_INPUT_SIZE) {
+    return false;
+  }
+#endif
+  if (state.num_failures >= config_.max_failures) {
+    // disabled: only probe every probe_interval messages
+    if (++state.num_skipped < config_.probe_interval) {
+      return false;
+    }
+    state.num_skipped = 0;
+  }
+  if (estimate_entropy(payload, payload_size, config_.entropy_sample_size) >
+      config_.max_entropy) {
+    record_attempt(state, false);
+    return false;
+  }
+  return true;
+}
+
+void MessageCompressor::record_attempt(TypeState& state, bool success) {
+  if (success) {
+    state.num_failures = 0;
+    state.num_skipped = 0;
+  } else if (state.num_failures < config_.max_failures) {
+    ++state.num_failures;
+  }
+}
+
+std::vector<std::uint8_t> MessageCompressor::compressed_copy(
+    const std::vector<std::uint8_t>& message) {
+  if (!enabled_) {
+    return {};
+  }
+  const auto view = ParseCompactMessage(message.data(), message.size());
+  if (!view.has_value() || (view->flags & compact_message_flag_compressed)) {
+    return {};
+  }
+  const auto type_i = static_cast<std::size_t>(view->message_type);
+  auto& state = states_[type_i];
+  if (!state.enabled) {
+    return {};
+  }
+
+  std::vector<std::uint8_t> compressed_message;
+  const bool attempted = should_try(state, view->payload, view->payload_size);
+  if (attempted) {
+#ifdef MOTION_HAVE_LZ4
+    const auto max_compressed_size = static_cast<std::size_t>(
+        config_.max_compression_ratio * static_cast<double>(view->payload_size));
+    const auto bound = LZ4_compressBound(static_cast<int>(view->payload_size));
+    compressed_message.resize(compact_message_header_size + size_field_size + bound);
+    const auto compressed_size = LZ4_compress_default(
+        reinterpret_cast<const char*>(view->payload),
+        reinterpret_cast<char*>(compressed_message.data() + compact_message_header_size +
+                                size_field_size),
+        static_cast<int>(view->payload_size), bound);
+    if (compressed_size > 0 &&
+        size_field_size + static_cast<std::size_t>(compressed_size) <= max_compressed_size) {
+      std::memcpy(compressed_message.data(), message.data(), compact_message_header_size);
+      compressed_message[compact_message_flags_offset] |= compact_message_flag_compressed;
+      const std::uint64_t payload_size = view->payload_size;
+      for (std::size_t i = 0; i < size_field_size; ++i) {
+        compressed_message[compact_message_header_size + i] = (payload_size >> (8 * i)) & 0xFF;
+      }
+      compressed_message.resize(compact_message_header_size + size_field_size + compressed_size);
+      compressed_message.shrink_to_fit();
+      record_attempt(state, true);
+    } else {
+      compressed_message.clear();
+      record_attempt(state, false);
+    }
+#endif
+  }
+
+  {
+    std::scoped_lock lock(statistics_mutex_);
+    auto& stats = statistics_[type_i];
+    ++stats.num_messages;
+    stats.num_attempted += attempted;
+    stats.num_bytes_uncompressed += view->payload_size;
+    if (compressed_message.empty()) {
+      stats.num_bytes_compressed += view->payload_size;
+    } else {
+      ++stats.num_compressed;
+      stats.num_bytes_compressed += compressed_message.size() - compact_message_header_size;
+    }
+  }
+  return compressed_message;
+}
+
+bool MessageCompressor::compress(std::vector<std::uint8_t>& message) {
+  auto compressed_message = compressed_copy(message);
+  if (compressed_message.empty()) {
+    return false;
+  }
+  message = std::move(compressed_message);
+  return true;
+}
+
+std::vector<CompressionStatistics> MessageCompressor::get_statistics() const {
+  std::vector<CompressionStatistics> result;
+  std::scoped_lock lock(statistics_mutex_);
+  for (const auto& stats : statistics_) {
+    if (stats.num_messages > 0) {
+      result.push_back(stats);
+    }
+  }
+  return result;
+}
+
+void MessageCompressor::reset_statistics() {
+  std::scoped_lock lock(statistics_mutex_);
+  for (auto& stats : statistics_) {
+    stats = {stats.message_type};
+  }
+}
+
+bool DecompressMessage(std::vector<std::uint8_t>& message) {
+  const auto view = ParseCompactMessage(message.data(), message.size());
+  if (!view.has_value()) {
+    return false;
+  }
+  if (!(view->flags & compact_message_flag_compressed)) {
+    return true;
+  }
+#ifdef MOTION_HAVE_LZ4
+  if (view->payload_size < size_field_size) {
+    return false;
+  }
+  std::uint64_t payload_size = 0;
+  for (std::size_t i = 0; i < size_field_size; ++i) {
+    payload_size |= std::uint64_t(view->payload[i]) << (8 * i);
+  }
+  const auto compressed_size = view->payload_size - size_field_size;
+  if (payload_size > LZ4_MAX_INPUT_SIZE ||
+      compressed_size > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+    return false;
+  }
+  std::vector<std::uint8_t> decompressed_message(compact_message_header_size + payload_size);
+  std::memcpy(decompressed_message.data(), message.data(), compact_message_header_size);
+  decompressed_message[compact_message_flags_offset] &= ~compact_message_flag_compressed;
+  const auto decompressed_size = LZ4_decompress_safe(
+      reinterpret_cast<const char*>(view->payload + size_field_size),
+      reinterpret_cast<char*>(decompressed_message.data() + compact_message_header_size),
+      static_cast<int>(compressed_size), static_cast<int>(payload_size));
+  if (decompressed_size < 0 || static_cast<std::uint64_t>(decompressed_size) != payload_size) {
+    return false;
+  }
+  message = std::move(decompressed_message);
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace MOTION::Communication
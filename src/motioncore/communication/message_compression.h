@@ -0,0 +1,144 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "fbs_headers/message_generated.h"
+
+namespace MOTION::Communication {
+
+// Optional compression of compact messages (cf. compact_message.h)
+//
+// Some payloads are highly compressible, e.g., public shares of sparse ReLU
+// outputs or sign-extended values in conversions.  For WAN deployments it can
+// pay off to spend a little CPU time on compressing these with LZ4.
+// Compression is opt-in per message type and applied by the send thread of
+// the CommunicationLayer; the receive thread decompresses the message before
+// it is passed to the message handler.
+//
+// A compressed message has the compressed flag set in its header, and its
+// payload consists of the uncompressed payload size as little endian uint64
+// followed by an LZ4 block.
+//
+// To avoid wasting CPU time on incompressible data, a payload is only
+// compressed if it is large enough and if the entropy of a small sample is
+// low enough.  If compression of a message type fails repeatedly, compression
+// of this type is disabled and only retried every `probe_interval` messages.
+
+struct CompressionConfig {
+  // message types for which compression is enabled
+  std::vector<MessageType> message_types;
+  // payloads smaller than this are sent uncompressed
+  std::size_t min_payload_size = 4096;
+  // number of bytes sampled to estimate the entropy of a payload
+  std::size_t entropy_sample_size = 1024;
+  // payloads with an estimated entropy above this (in bits per byte) are sent uncompressed
+  double max_entropy = 7.0;
+  // compression is only used if it reduces the size to at most this fraction
+  double max_compression_ratio = 0.9;
+  // number of failed attempts in a row after which a message type is disabled
+  std::size_t max_failures = 8;
+  // a disabled message type is probed again every `probe_interval` messages
+  std::size_t probe_interval = 64;
+
+  // Enable compression of gate and OT extension messages.
+  static CompressionConfig bulk_messages();
+};
+
+struct CompressionStatistics {
+  MessageType message_type;
+  // messages considered for compression
+  std::size_t num_messages = 0;
+  // messages for which compression was attempted
+  std::size_t num_attempted = 0;
+  // messages sent compressed
+  std::size_t num_compressed = 0;
+  // payload bytes before and after compression
+  std::size_t num_bytes_uncompressed = 0;
+  std::size_t num_bytes_compressed = 0;
+};
+
+// Check if MOTION was built with LZ4 support (MOTION_USE_LZ4).
+bool compression_supported() noexcept;
+
+// Estimate the Shannon entropy (in bits per byte) of a buffer from a sample
+// of at most `sample_size` bytes.
+double estimate_entropy(const std::uint8_t* data, std::size_t size, std::size_t sample_size);
+
+// Compresses compact messages according to a CompressionConfig
+//
+// The compressor keeps some state per message type.  It is meant to be used
+// by a single send thread; only the statistics may be accessed concurrently.
+class MessageCompressor {
+ public:
+  explicit MessageCompressor(const CompressionConfig& config);
+
+  // Check if compression is enabled for any message type.
+  bool enabled() const noexcept { return enabled_; }
+
+  // Compress the given compact message if compression is enabled for its
+  // type and is worth it.  Returns true if the message was replaced.
+  bool compress(std::vector<std::uint8_t>& message);
+  // Return a compressed copy of the given compact message or an empty vector
+  // if the message should be sent as is.
+  std::vector<std::uint8_t> compressed_copy(const std::vector<std::uint8_t>& message);
+
+  std::vector<CompressionStatistics> get_statistics() const;
+  void reset_statistics();
+
+ private:
+  static constexpr std::size_t num_message_types =
+      static_cast<std::size_t>(MessageType::MAX) + 1;
+
+  struct TypeState {
+    bool enabled = false;
+    // number of failed attempts in a row
+    std::size_t num_failures = 0;
+    // number of messages sent uncompressed since the type was disabled
+    std::size_t num_skipped = 0;
+  };
+
+  // Decide whether to try to compress the payload.
+  bool should_try(TypeState& state, const std::uint8_t* payload, std::size_t payload_size);
+  // Update the state after an attempt.
+  void record_attempt(TypeState& state, bool success);
+
+  CompressionConfig config_;
+  bool enabled_;
+  std::array<TypeState, num_message_types> states_;
+  mutable std::mutex statistics_mutex_;
+  std::array<CompressionStatistics, num_message_types> statistics_;
+};
+
+// Decompress a compressed compact message in place.  Messages without the
+// compressed flag are left unchanged.  Returns false if the message is
+// malformed or if LZ4 support is not available.
+bool DecompressMessage(std::vector<std::uint8_t>& message);
+
+}  // namespace MOTION::Communication
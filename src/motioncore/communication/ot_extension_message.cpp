@@ -22,45 +22,30 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include "message.h"
+#include "ot_extension_message.h"
 
-#include "fbs_headers/ot_extension_generated.h"
+#include "compact_message.h"
 
 namespace MOTION::Communication {
-flatbuffers::FlatBufferBuilder BuildOTExtensionMessageSender(const std::byte *buffer,
-                                                             const std::size_t size,
-                                                             const std::size_t i) {
-  flatbuffers::FlatBufferBuilder builder(size + 32);
-  std::vector<std::uint8_t> v_buffer(reinterpret_cast<const std::uint8_t *>(buffer),
-                                     reinterpret_cast<const std::uint8_t *>(buffer) + size);
-  auto root = CreateOTExtensionMessageDirect(builder, i, &v_buffer);
-  FinishOTExtensionMessageBuffer(builder, root);
-  return BuildMessage(MessageType::OTExtensionSender, builder.GetBufferPointer(),
-                      builder.GetSize());
+std::vector<std::uint8_t> BuildOTExtensionMessageSender(const std::byte *buffer,
+                                                        const std::size_t size,
+                                                        const std::size_t i) {
+  return BuildCompactMessage(MessageType::OTExtensionSender, i, 0,
+                             reinterpret_cast<const std::uint8_t *>(buffer), size);
 }
 
-flatbuffers::FlatBufferBuilder BuildOTExtensionMessageReceiverMasks(const std::byte *buffer,
-                                                                    const std::size_t size,
-                                                                    const std::size_t i) {
-  flatbuffers::FlatBufferBuilder builder(size + 32);
-  std::vector<std::uint8_t> v_buffer(reinterpret_cast<const std::uint8_t *>(buffer),
-                                     reinterpret_cast<const std::uint8_t *>(buffer) + size);
-  auto root = CreateOTExtensionMessageDirect(builder, i, &v_buffer);
-  FinishOTExtensionMessageBuffer(builder, root);
-  return BuildMessage(MessageType::OTExtensionReceiverMasks, builder.GetBufferPointer(),
-                      builder.GetSize());
+std::vector<std::uint8_t> BuildOTExtensionMessageReceiverMasks(const std::byte *buffer,
+                                                               const std::size_t size,
+                                                               const std::size_t i) {
+  return BuildCompactMessage(MessageType::OTExtensionReceiverMasks, i, 0,
+                             reinterpret_cast<const std::uint8_t *>(buffer), size);
 }
 
-flatbuffers::FlatBufferBuilder BuildOTExtensionMessageReceiverCorrections(const std::byte *buffer,
-                                                                          const std::size_t size,
-                                                                          const std::size_t i) {
-  flatbuffers::FlatBufferBuilder builder(size + 32);
-  std::vector<std::uint8_t> v_buffer(reinterpret_cast<const std::uint8_t *>(buffer),
-                                     reinterpret_cast<const std::uint8_t *>(buffer) + size);
-  auto root = CreateOTExtensionMessageDirect(builder, i, &v_buffer);
-  FinishOTExtensionMessageBuffer(builder, root);
-  return BuildMessage(MessageType::OTExtensionReceiverCorrections, builder.GetBufferPointer(),
-                      builder.GetSize());
+std::vector<std::uint8_t> BuildOTExtensionMessageReceiverCorrections(const std::byte *buffer,
+                                                                     const std::size_t size,
+                                                                     const std::size_t i) {
+  return BuildCompactMessage(MessageType::OTExtensionReceiverCorrections, i, 0,
+                             reinterpret_cast<const std::uint8_t *>(buffer), size);
 }
 
 }  // namespace MOTION::Communication
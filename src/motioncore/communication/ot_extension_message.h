@@ -24,19 +24,25 @@
 
 #pragma once
 
-#include <flatbuffers/flatbuffers.h>
+#include <cstdint>
+#include <vector>
+
 #include "utility/constants.h"
 
 namespace MOTION::Communication {
-flatbuffers::FlatBufferBuilder BuildOTExtensionMessageSender(const std::byte *buffer,
-                                                             const std::size_t size,
-                                                             const std::size_t i);
 
-flatbuffers::FlatBufferBuilder BuildOTExtensionMessageReceiverMasks(const std::byte *buffer,
-                                                                    const std::size_t size,
-                                                                    const std::size_t i);
+// OT extension messages use the compact framing, cf. compact_message.h, with
+// the index i as id.
+
+std::vector<std::uint8_t> BuildOTExtensionMessageSender(const std::byte *buffer,
+                                                        const std::size_t size,
+                                                        const std::size_t i);
+
+std::vector<std::uint8_t> BuildOTExtensionMessageReceiverMasks(const std::byte *buffer,
+                                                               const std::size_t size,
+                                                               const std::size_t i);
 
-flatbuffers::FlatBufferBuilder BuildOTExtensionMessageReceiverCorrections(const std::byte *buffer,
-                                                                          const std::size_t size,
-                                                                          const std::size_t i);
+std::vector<std::uint8_t> BuildOTExtensionMessageReceiverCorrections(const std::byte *buffer,
+                                                                     const std::size_t size,
+                                                                     const std::size_t i);
 }  // namespace MOTION::Communication
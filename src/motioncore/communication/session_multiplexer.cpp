@@ -0,0 +1,229 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "session_multiplexer.h"
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "communication_layer.h"
+#include "compact_message.h"
+#include "message_handler.h"
+#include "transport.h"
+#include "utility/logger.h"
+
+namespace MOTION::Communication {
+
+// Transport of a session which sends its messages over the parent
+// CommunicationLayer and receives them from the queue filled by the
+// SessionMessageHandler
+class SessionMultiplexer::SessionTransport : public Transport {
+ public:
+  SessionTransport(SessionMultiplexer& multiplexer, std::uint64_t session_id,
+                   std::size_t party_id, std::shared_ptr<message_queue_t> receive_queue)
+      : multiplexer_(multiplexer),
+        session_id_(session_id),
+        party_id_(party_id),
+        receive_queue_(std::move(receive_queue)),
+        is_shutdown_(false) {}
+
+  void send_message(std::vector<std::uint8_t>&& message) override {
+    send_message(message.data(), message.size());
+  }
+
+  void send_message(const std::vector<std::uint8_t>& message) override {
+    send_message(message.data(), message.size());
+  }
+
+  void send_message(const std::uint8_t* message, std::size_t size) override {
+    multiplexer_.parent_.send_message(
+        party_id_,
+        BuildCompactMessage(MessageType::SessionMessage, session_id_, 0, message, size));
+    statistics_.num_messages_sent += 1;
+    statistics_.num_bytes_sent += size;
+  }
+
+  bool available() const override { return !receive_queue_->empty(); }
+
+  std::optional<std::vector<std::uint8_t>> receive_message() override {
+    auto message_opt = receive_queue_->dequeue();
+    if (!message_opt.has_value()) {
+      // multiplexer has been shut down
+      return std::nullopt;
+    }
+    statistics_.num_messages_received += 1;
+    statistics_.num_bytes_received += message_opt->size();
+    return message_opt;
+  }
+
+  // the connection is owned by the parent CommunicationLayer
+  void shutdown_send() override {}
+
+  // the receive thread of the session has seen the termination message of
+  // the other party, hence no more messages arrive for this transport
+  void shutdown() override {
+    if (is_shutdown_) {
+      return;
+    }
+    is_shutdown_ = true;
+    multiplexer_.finished_transport(session_id_);
+  }
+
+ private:
+  SessionMultiplexer& multiplexer_;
+  std::uint64_t session_id_;
+  std::size_t party_id_;
+  std::shared_ptr<message_queue_t> receive_queue_;
+  bool is_shutdown_;
+};
+
+// Handler for messages of type SessionMessage
+class SessionMultiplexer::SessionMessageHandler : public MessageHandler {
+ public:
+  SessionMessageHandler(SessionMultiplexer& multiplexer) : multiplexer_(multiplexer) {}
+
+  void received_message(std::size_t party_id, std::vector<std::uint8_t>&& message) override {
+    multiplexer_.received_message(party_id, std::move(message));
+  }
+
+ private:
+  SessionMultiplexer& multiplexer_;
+};
+
+SessionMultiplexer::SessionMultiplexer(CommunicationLayer& parent, std::shared_ptr<Logger> logger)
+    : parent_(parent),
+      my_id_(parent.get_my_id()),
+      num_parties_(parent.get_num_parties()),
+      is_shutdown_(false),
+      logger_(std::move(logger)) {
+  auto handler = std::make_shared<SessionMessageHandler>(*this);
+  parent_.register_message_handler([handler](auto) { return handler; },
+                                   {MessageType::SessionMessage});
+}
+
+SessionMultiplexer::~SessionMultiplexer() {
+  parent_.deregister_message_handler({MessageType::SessionMessage});
+  std::scoped_lock lock(mutex_);
+  is_shutdown_ = true;
+  // unblock the receive threads of sessions which are still alive
+  for (auto& [session_id, session] : sessions_) {
+    for (auto& queue : session.receive_queues_) {
+      if (queue) {
+        queue->close();
+      }
+    }
+  }
+}
+
+SessionMultiplexer::Session& SessionMultiplexer::get_session(std::uint64_t session_id) {
+  auto [it, inserted] = sessions_.try_emplace(session_id);
+  auto& session = it->second;
+  if (inserted) {
+    session.receive_queues_.resize(num_parties_);
+    for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+      if (party_id == my_id_) {
+        continue;
+      }
+      session.receive_queues_.at(party_id) = std::make_shared<message_queue_t>();
+    }
+  }
+  return session;
+}
+
+std::unique_ptr<CommunicationLayer> SessionMultiplexer::make_session(std::uint64_t session_id) {
+  std::vector<std::unique_ptr<Transport>> transports(num_parties_);
+  {
+    std::scoped_lock lock(mutex_);
+    if (is_shutdown_) {
+      throw std::logic_error("SessionMultiplexer::make_session: multiplexer has been shut down");
+    }
+    if (finished_session_ids_.count(session_id) > 0) {
+      throw std::invalid_argument(fmt::format(
+          "SessionMultiplexer::make_session: session {} has already been finished", session_id));
+    }
+    auto& session = get_session(session_id);
+    if (session.created_) {
+      throw std::invalid_argument(fmt::format(
+          "SessionMultiplexer::make_session: session {} has already been created", session_id));
+    }
+    session.created_ = true;
+    for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+      if (party_id == my_id_) {
+        continue;
+      }
+      transports.at(party_id) = std::make_unique<SessionTransport>(
+          *this, session_id, party_id, session.receive_queues_.at(party_id));
+    }
+  }
+  return std::make_unique<CommunicationLayer>(my_id_, std::move(transports), logger_);
+}
+
+void SessionMultiplexer::finished_transport(std::uint64_t session_id) {
+  std::scoped_lock lock(mutex_);
+  auto it = sessions_.find(session_id);
+  if (it == std::end(sessions_)) {
+    return;
+  }
+  auto& session = it->second;
+  session.num_finished_transports_ += 1;
+  if (session.num_finished_transports_ == num_parties_ - 1) {
+    // the transports keep their queues alive
+    sessions_.erase(it);
+    finished_session_ids_.insert(session_id);
+  }
+}
+
+std::size_t SessionMultiplexer::get_num_sessions() const {
+  std::scoped_lock lock(mutex_);
+  return sessions_.size();
+}
+
+void SessionMultiplexer::received_message(std::size_t party_id,
+                                          std::vector<std::uint8_t>&& message) {
+  auto compact_message = ParseCompactMessage(message.data(), message.size());
+  if (!compact_message.has_value()) {
+    if (logger_) {
+      logger_->LogError(fmt::format("received corrupt session message from party {}", party_id));
+    }
+    return;
+  }
+  std::vector<std::uint8_t> session_message(
+      compact_message->payload, compact_message->payload + compact_message->payload_size);
+  std::scoped_lock lock(mutex_);
+  if (is_shutdown_) {
+    return;
+  }
+  if (finished_session_ids_.count(compact_message->id) > 0) {
+    // do not recreate a session which has already been removed
+    if (logger_) {
+      logger_->LogError(fmt::format("dropped message from party {} for finished session {}",
+                                    party_id, compact_message->id));
+    }
+    return;
+  }
+  get_session(compact_message->id).receive_queues_.at(party_id)->enqueue(
+      std::move(session_message));
+}
+
+}  // namespace MOTION::Communication
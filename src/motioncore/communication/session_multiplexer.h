@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "utility/synchronized_queue.h"
+
+namespace MOTION {
+
+class Logger;
+
+namespace Communication {
+
+class CommunicationLayer;
+class MessageHandler;
+
+// Multiplexes independent sessions over the connections of a CommunicationLayer
+//
+// Each session is a CommunicationLayer of its own with separate message
+// handlers and synchronization, whose transports tunnel all messages through
+// the parent CommunicationLayer.  The messages are wrapped into compact
+// messages of type SessionMessage which carry the session id, so that several
+// backends can be evaluated concurrently over the same connections although
+// they use the same message types.  Sessions with the same id are connected
+// with each other.
+//
+// The multiplexer needs to be created by all parties before the parent
+// CommunicationLayer is started, and it needs to outlive the sessions.  A
+// session is removed from the multiplexer once its CommunicationLayer has been
+// shut down, i.e., after the termination messages of all parties have been
+// received.  Its id is remembered: messages which arrive for it afterwards are
+// dropped, and it cannot be created again.
+class SessionMultiplexer {
+ public:
+  SessionMultiplexer(CommunicationLayer& parent, std::shared_ptr<Logger> logger = nullptr);
+  ~SessionMultiplexer();
+
+  // Create the CommunicationLayer of a session.  Messages which arrive for a
+  // session before it has been created are buffered.  Throws
+  // std::invalid_argument if the session has already been created.
+  std::unique_ptr<CommunicationLayer> make_session(std::uint64_t session_id);
+
+  // Number of sessions which have been created or have buffered messages and
+  // have not been shut down yet
+  std::size_t get_num_sessions() const;
+
+ private:
+  class SessionTransport;
+  class SessionMessageHandler;
+  using message_queue_t = ENCRYPTO::SynchronizedQueue<std::vector<std::uint8_t>>;
+
+  struct Session {
+    bool created_ = false;
+    // number of transports which have been shut down
+    std::size_t num_finished_transports_ = 0;
+    // receive queue for each party
+    std::vector<std::shared_ptr<message_queue_t>> receive_queues_;
+  };
+
+  // needs to be called with the mutex held
+  Session& get_session(std::uint64_t session_id);
+  // called by the transports of a session when they are shut down
+  void finished_transport(std::uint64_t session_id);
+  void received_message(std::size_t party_id, std::vector<std::uint8_t>&& message);
+
+  CommunicationLayer& parent_;
+  std::size_t my_id_;
+  std::size_t num_parties_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::uint64_t, Session> sessions_;
+  // ids of the sessions which have been shut down
+  std::unordered_set<std::uint64_t> finished_session_ids_;
+  bool is_shutdown_;
+  std::shared_ptr<Logger> logger_;
+};
+
+}  // namespace Communication
+}  // namespace MOTION
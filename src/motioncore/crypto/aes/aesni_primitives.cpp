@@ -23,7 +23,9 @@
 #include <immintrin.h>
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include "aesni_primitives.h"
+#include "utility/cpu_features.h"
 
 template <int round_constant>
 static __m128i aes_key_expand(__m128i xmm1) {
@@ -89,8 +91,104 @@ void aesni_key_expansion_128(void* round_keys_in) {
   // movdqa 0xa0[rdi], xmm1
 }
 
+// VAES implementations that process two blocks per 256 bit register.  They
+// are selected at runtime if the CPU supports them.
+
+static bool use_vaes_ctr() {
+  static const bool result = [] {
+    const auto& features = MOTION::CpuFeatures::get();
+    const bool vaes = features.vaes && features.avx2;
+    MOTION::register_kernel_variant("aes_ctr_stream", vaes ? "vaes" : "aesni");
+    return vaes;
+  }();
+  return result;
+}
+
+static bool use_vaes_mmo() {
+  static const bool result = [] {
+    const auto& features = MOTION::CpuFeatures::get();
+    const bool vaes = features.vaes && features.avx2;
+    MOTION::register_kernel_variant("aes_fixed_key_mmo", vaes ? "vaes" : "aesni");
+    return vaes;
+  }();
+  return result;
+}
+
+__attribute__((target("avx2,vaes"))) static void vaes_load_round_keys(
+    const void* round_keys_in, std::array<__m256i, aes_num_round_keys_128>& round_keys) {
+  auto round_keys_ptr =
+      reinterpret_cast<const __m128i*>(__builtin_assume_aligned(round_keys_in, aes_block_size));
+  for (std::size_t i = 0; i < aes_num_round_keys_128; ++i) {
+    round_keys[i] = _mm256_broadcastsi128_si256(_mm_load_si128(round_keys_ptr + i));
+  }
+}
+
+// Processes the largest multiple of 8 blocks and returns their number.
+__attribute__((target("avx2,vaes"))) static std::size_t vaes_ctr_stream_blocks_128(
+    const void* round_keys_in, std::uint64_t* counter_in, void* output_in,
+    std::size_t num_blocks) {
+  std::array<__m256i, aes_num_round_keys_128> round_keys;
+  std::array<__m256i, 4> wb;
+  vaes_load_round_keys(round_keys_in, round_keys);
+  auto counter = *counter_in;
+  auto output = reinterpret_cast<__m256i*>(output_in);
+
+  const auto batch_blocks = num_blocks & (~0b111);
+  for (std::size_t i = 0; i < batch_blocks; i += 8) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      wb[j] = _mm256_set_epi64x(0, counter + 2 * j + 1, 0, counter + 2 * j);
+    }
+    for (std::size_t j = 0; j < 4; ++j) wb[j] = _mm256_xor_si256(wb[j], round_keys[0]);
+    for (std::size_t r = 1; r < aes_num_round_keys_128 - 1; ++r) {
+      for (std::size_t j = 0; j < 4; ++j) wb[j] = _mm256_aesenc_epi128(wb[j], round_keys[r]);
+    }
+    for (std::size_t j = 0; j < 4; ++j) wb[j] = _mm256_aesenclast_epi128(wb[j], round_keys[10]);
+    for (std::size_t j = 0; j < 4; ++j) _mm256_storeu_si256(output + i / 2 + j, wb[j]);
+    counter += 8;
+  }
+
+  *counter_in = counter;
+  return batch_blocks;
+}
+
+__attribute__((target("avx2,vaes"))) static void vaes_fixed_key_mmo_hat_batch_4(
+    const void* round_keys_in, void* input) {
+  std::array<__m256i, aes_num_round_keys_128> round_keys;
+  std::array<__m256i, 2> wb_1;
+  std::array<__m256i, 2> wb_2;
+  vaes_load_round_keys(round_keys_in, round_keys);
+  auto input_ptr = reinterpret_cast<__m256i*>(input);
+
+  // compute wb_1 <- \sigma(x), cf. sigma below
+  const __m256i mask = _mm256_set_epi64x(0xffffffffffffffff, 0, 0xffffffffffffffff, 0);
+  for (std::size_t j = 0; j < 2; ++j) {
+    const auto x = _mm256_loadu_si256(input_ptr + j);
+    wb_1[j] =
+        _mm256_xor_si256(_mm256_shuffle_epi32(x, 0b01'00'11'10), _mm256_and_si256(x, mask));
+  }
+
+  // compute wb_2 <- \pi(\sigma(x))
+  for (std::size_t j = 0; j < 2; ++j) wb_2[j] = _mm256_xor_si256(wb_1[j], round_keys[0]);
+  for (std::size_t r = 1; r < aes_num_round_keys_128 - 1; ++r) {
+    for (std::size_t j = 0; j < 2; ++j) wb_2[j] = _mm256_aesenc_epi128(wb_2[j], round_keys[r]);
+  }
+  for (std::size_t j = 0; j < 2; ++j) wb_2[j] = _mm256_aesenclast_epi128(wb_2[j], round_keys[10]);
+
+  // store \pi(\sigma(x)) ^ \sigma(x)
+  for (std::size_t j = 0; j < 2; ++j) {
+    _mm256_storeu_si256(input_ptr + j, _mm256_xor_si256(wb_2[j], wb_1[j]));
+  }
+}
+
 void aesni_ctr_stream_blocks_128(const void* round_keys_in, std::uint64_t* counter_in,
                                  void* output_in, std::size_t num_blocks) {
+  if (use_vaes_ctr()) {
+    const auto num_done =
+        vaes_ctr_stream_blocks_128(round_keys_in, counter_in, output_in, num_blocks);
+    output_in = reinterpret_cast<std::byte*>(output_in) + num_done * aes_block_size;
+    num_blocks -= num_done;
+  }
+
   alignas(16) std::array<__m128i, aes_num_round_keys_128> round_keys;
   alignas(16) std::array<__m128i, 4> wb;
   auto counter = *counter_in;
@@ -149,6 +247,13 @@ void aesni_ctr_stream_blocks_128(const void* round_keys_in, std::uint64_t* count
 
 void aesni_ctr_stream_blocks_128_unaligned(const void* round_keys_in, std::uint64_t* counter_in,
                                            void* output_in, std::size_t num_blocks) {
+  if (use_vaes_ctr()) {
+    const auto num_done =
+        vaes_ctr_stream_blocks_128(round_keys_in, counter_in, output_in, num_blocks);
+    output_in = reinterpret_cast<std::byte*>(output_in) + num_done * aes_block_size;
+    num_blocks -= num_done;
+  }
+
   // almost the same code as in `aesni_ctr_stream_blocks_128_unaligned`
 
   alignas(16) std::array<__m128i, aes_num_round_keys_128> round_keys;
@@ -298,6 +403,44 @@ void aesni_mmo_single(const void* round_keys_in, void* input) {
   _mm_storeu_si128(input_ptr, wb_1);
 }
 
+void aesni_mmo_batch(const void* round_keys_in, void* input, std::size_t num_blocks) {
+  alignas(16) std::array<__m128i, aes_num_round_keys_128> round_keys;
+  alignas(16) std::array<__m128i, 4> input_blocks;
+  alignas(16) std::array<__m128i, 4> wb_1;
+  // copy the round keys onto the stack
+  // -> compiler will put them into registers
+  std::copy(reinterpret_cast<__m128i*>(__builtin_assume_aligned(round_keys_in, aes_block_size)),
+            reinterpret_cast<__m128i*>(__builtin_assume_aligned(round_keys_in, aes_block_size)) +
+                aes_num_round_keys_128,
+            round_keys.data());
+  auto input_ptr = reinterpret_cast<__m128i*>(input);
+
+  std::size_t i = 0;
+  for (; i + 4 <= num_blocks; i += 4) {
+    // load x
+    for (std::size_t j = 0; j < 4; ++j) input_blocks[j] = _mm_loadu_si128(input_ptr + i + j);
+    // compute wb_1 <- \pi(x)
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_xor_si128(input_blocks[j], round_keys[0]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[1]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[2]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[3]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[4]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[5]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[6]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[7]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[8]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[9]);
+    for (std::size_t j = 0; j < 4; ++j) wb_1[j] = _mm_aesenclast_si128(wb_1[j], round_keys[10]);
+    // store \pi(x) ^ x
+    for (std::size_t j = 0; j < 4; ++j) {
+      _mm_storeu_si128(input_ptr + i + j, _mm_xor_si128(wb_1[j], input_blocks[j]));
+    }
+  }
+  for (; i < num_blocks; ++i) {
+    aesni_mmo_single(round_keys_in, input_ptr + i);
+  }
+}
+
 static __m128i aesni_mix_keys(__m128i key_a, __m128i key_b) {
   const __m128i modulus = _mm_set_epi32(0, 0, 0, 0x87);
   const __m128i msb_mask = _mm_set_epi32(0x80000000, 0, 0, 0);
@@ -364,6 +507,11 @@ static __m128i sigma(__m128i x) {
 // Vectorized implementation of the \hat{MMO} construction providing circular
 // correlation robustness
 inline void aesni_fixed_key_mmo_hat_batch_4(const void* round_keys_in, void* input) {
+  if (use_vaes_mmo()) {
+    vaes_fixed_key_mmo_hat_batch_4(round_keys_in, input);
+    return;
+  }
+
   alignas(16) std::array<__m128i, aes_num_round_keys_128> round_keys;
   alignas(16) std::array<__m128i, 4> wb_1;
   alignas(16) std::array<__m128i, 4> wb_2;
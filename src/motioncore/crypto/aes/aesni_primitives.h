@@ -66,6 +66,12 @@ void aesni_tmmo_batch_4(const void* round_keys, void* input, __uint128_t tweak);
 // * round_keys are 16B aligned
 void aesni_mmo_single(const void* round_keys, void* input);
 
+// Compute MMO^\pi (cf. aesni_mmo_single) on num_blocks consecutive blocks
+// inplace.  Four blocks are processed at once to keep the AES pipeline busy.
+//
+// * round_keys are 16B aligned
+void aesni_mmo_batch(const void* round_keys, void* input, std::size_t num_blocks);
+
 // Compute the dual-key cipher A2/D1 by Bellare et al.
 // (https://eprint.iacr.org/2013/426).
 //
@@ -22,6 +22,7 @@
 
 #include "arithmetic_provider.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -307,14 +308,37 @@ void IntegerMultiplicationReceiver<T>::clear() noexcept {
   outputs_ = {};
 }
 
+namespace {
+
+// maximal number of correlated values in one block of ACOTs of the OT-based
+// matrix multiplication
+constexpr std::size_t kMaxMatrixMultiplicationBlockSize = std::size_t(1) << 22;
+
+// number of rows of A whose ACOTs form one block
+template <typename T>
+std::size_t matrix_multiplication_rows_per_block(std::size_t m, std::size_t n) {
+  const auto values_per_row = std::max<std::size_t>(1, m * n * ENCRYPTO::bit_size_v<T>);
+  return std::max<std::size_t>(1, kMaxMatrixMultiplicationBlockSize / values_per_row);
+}
+
+}  // namespace
+
 // ---------- MatrixMultiplicationRHS ----------
 
 template <typename T>
-MatrixMultiplicationRHS<T>::MatrixMultiplicationRHS(std::size_t l, std::size_t m, std::size_t n,
-                                                    ArithmeticProvider& arith_provider)
+MatrixMultiplicationRHS<T>::MatrixMultiplicationRHS(
+    std::size_t l, std::size_t m, std::size_t n,
+    ENCRYPTO::ObliviousTransfer::OTProvider& ot_provider)
     : dims_({l, m, n}),
-      mult_sender_(arith_provider.register_integer_multiplication_send<T>(l * m, n)),
-      is_output_ready_(false) {}
+      rows_per_block_(matrix_multiplication_rows_per_block<T>(m, n)),
+      next_block_(0),
+      is_output_ready_(false) {
+  for (std::size_t row_i = 0; row_i < l; row_i += rows_per_block_) {
+    const auto num_rows = std::min(rows_per_block_, l - row_i);
+    ot_senders_.emplace_back(
+        ot_provider.RegisterSendACOT<T>(num_rows * m * ENCRYPTO::bit_size_v<T>, n, true));
+  }
+}
 
 template <typename T>
 MatrixMultiplicationRHS<T>::~MatrixMultiplicationRHS() = default;
@@ -334,25 +358,50 @@ void MatrixMultiplicationRHS<T>::set_input(const std::vector<T>& inputs) {
 
 template <typename T>
 void MatrixMultiplicationRHS<T>::set_input(const T* inputs) {
-  const auto input_size = dims_[1] * dims_[2];
-  std::vector<T> mult_inputs(dims_[0] * input_size);
-  for (std::size_t i = 0; i < dims_[0]; ++i) {
-    std::copy_n(inputs, input_size, std::begin(mult_inputs) + i * input_size);
+  // the OT messages are only sent when their block is computed
+  input_.assign(inputs, inputs + dims_[1] * dims_[2]);
+  output_.assign(dims_[0] * dims_[2], 0);
+  next_block_ = 0;
+}
+
+template <typename T>
+void MatrixMultiplicationRHS<T>::compute_next_block() {
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<T>;
+  const auto dim_m = dims_[1];
+  const auto dim_n = dims_[2];
+  const auto ots_per_row = dim_m * bit_size;
+  assert(has_next_block());
+  auto& ot_sender = ot_senders_[next_block_];
+  // OT (i * m + k) * bit_size + j of a block transfers the k-th row of B
+  // shifted by j, and each block starts at a row of A
+  const auto* inputs = input_.data();
+  ot_sender->SendMessages([inputs, dim_m, dim_n](std::size_t ot_i, T* correlations) {
+    const auto row_k = (ot_i / bit_size) % dim_m;
+    const auto bit_j = ot_i % bit_size;
+    std::transform(inputs + row_k * dim_n, inputs + (row_k + 1) * dim_n, correlations,
+                   [bit_j](auto x) { return T(x << bit_j); });
+  });
+  auto* block_output = &output_[next_block_ * rows_per_block_ * dim_n];
+  // the OTs of a row of A belong to one row of the output
+  ot_sender->ComputeOutputs(
+      ots_per_row, [block_output, dim_n, ots_per_row](std::size_t ot_i, const T* ot_output) {
+        auto* output_row = block_output + (ot_i / ots_per_row) * dim_n;
+        for (std::size_t col_i = 0; col_i < dim_n; ++col_i) {
+          output_row[col_i] -= ot_output[col_i];
+        }
+      });
+  ++next_block_;
+  if (!has_next_block()) {
+    input_ = {};
+    is_output_ready_ = true;
   }
-  mult_sender_->set_inputs(std::move(mult_inputs));
 }
 
 template <typename T>
 void MatrixMultiplicationRHS<T>::compute_output() {
-  mult_sender_->compute_outputs();
-  auto mult_output = mult_sender_->get_outputs();
-  output_.resize(dims_[0] * dims_[2]);
-  using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
-  using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
-  Eigen::TensorMap<TensorType3> input_tensor(mult_output.data(), dims_[0], dims_[1], dims_[2]);
-  Eigen::TensorMap<TensorType2> output_tensor(output_.data(), dims_[0], dims_[2]);
-  Eigen::array<Eigen::Index, 1> reduction_dimensions = {1};
-  output_tensor = input_tensor.sum(reduction_dimensions);
+  while (has_next_block()) {
+    compute_next_block();
+  }
   is_output_ready_ = true;
 }
 
@@ -364,7 +413,11 @@ std::vector<T> MatrixMultiplicationRHS<T>::get_output() {
 
 template <typename T>
 void MatrixMultiplicationRHS<T>::clear() noexcept {
-  mult_sender_->clear();
+  for (auto& ot_sender : ot_senders_) {
+    ot_sender->clear();
+  }
+  next_block_ = 0;
+  input_ = {};
   output_ = {};
   is_output_ready_ = false;
 }
@@ -372,21 +425,26 @@ void MatrixMultiplicationRHS<T>::clear() noexcept {
 // ---------- MatrixMultiplicationLHS ----------
 
 template <typename T>
-MatrixMultiplicationLHS<T>::MatrixMultiplicationLHS(std::size_t l, std::size_t m, std::size_t n,
-                                                    ArithmeticProvider& arith_provider)
+MatrixMultiplicationLHS<T>::MatrixMultiplicationLHS(
+    std::size_t l, std::size_t m, std::size_t n,
+    ENCRYPTO::ObliviousTransfer::OTProvider& ot_provider)
     : dims_({l, m, n}),
-      mult_receiver_(arith_provider.register_integer_multiplication_receive<T>(l * m, n)),
-      is_output_ready_(false) {}
+      rows_per_block_(matrix_multiplication_rows_per_block<T>(m, n)),
+      next_block_(0),
+      is_output_ready_(false) {
+  for (std::size_t row_i = 0; row_i < l; row_i += rows_per_block_) {
+    const auto num_rows = std::min(rows_per_block_, l - row_i);
+    ot_receivers_.emplace_back(
+        ot_provider.RegisterReceiveACOT<T>(num_rows * m * ENCRYPTO::bit_size_v<T>, n, true));
+  }
+}
 
 template <typename T>
 MatrixMultiplicationLHS<T>::~MatrixMultiplicationLHS() = default;
 
 template <typename T>
 void MatrixMultiplicationLHS<T>::set_input(std::vector<T>&& inputs) {
-  if (inputs.size() != dims_[0] * dims_[1]) {
-    throw std::invalid_argument("input has unexpected size");
-  }
-  mult_receiver_->set_inputs(std::move(inputs));
+  set_input(inputs);
 }
 
 template <typename T>
@@ -399,22 +457,48 @@ void MatrixMultiplicationLHS<T>::set_input(const std::vector<T>& inputs) {
 
 template <typename T>
 void MatrixMultiplicationLHS<T>::set_input(const T* inputs) {
-  std::vector<T> mult_inputs(inputs, inputs + dims_[0] * dims_[1]);
-  mult_receiver_->set_inputs(std::move(mult_inputs));
+  const auto dim_l = dims_[0];
+  const auto dim_m = dims_[1];
+  // the bits of the entries of A are the choices of the OTs
+  for (std::size_t block_i = 0; block_i < ot_receivers_.size(); ++block_i) {
+    const auto row_i = block_i * rows_per_block_;
+    const auto num_inputs = std::min(rows_per_block_, dim_l - row_i) * dim_m;
+    ENCRYPTO::BitVector<> ot_choices(num_inputs * ENCRYPTO::bit_size_v<T>);
+    std::copy_n(inputs + row_i * dim_m, num_inputs,
+                reinterpret_cast<T*>(ot_choices.GetMutableData().data()));
+    ot_receivers_[block_i]->SetChoices(std::move(ot_choices));
+    // the correction bits are small, so send them for all blocks at once
+    ot_receivers_[block_i]->SendCorrections();
+  }
+  output_.assign(dim_l * dims_[2], 0);
+  next_block_ = 0;
+}
+
+template <typename T>
+void MatrixMultiplicationLHS<T>::compute_next_block() {
+  const auto dim_n = dims_[2];
+  const auto ots_per_row = dims_[1] * ENCRYPTO::bit_size_v<T>;
+  assert(has_next_block());
+  auto* block_output = &output_[next_block_ * rows_per_block_ * dim_n];
+  // the OTs of a row of A belong to one row of the output
+  ot_receivers_[next_block_]->ComputeOutputs(
+      ots_per_row, [block_output, dim_n, ots_per_row](std::size_t ot_i, const T* ot_output) {
+        auto* output_row = block_output + (ot_i / ots_per_row) * dim_n;
+        for (std::size_t col_i = 0; col_i < dim_n; ++col_i) {
+          output_row[col_i] += ot_output[col_i];
+        }
+      });
+  ++next_block_;
+  if (!has_next_block()) {
+    is_output_ready_ = true;
+  }
 }
 
 template <typename T>
 void MatrixMultiplicationLHS<T>::compute_output() {
-  mult_receiver_->compute_outputs();
-  auto mult_output = mult_receiver_->get_outputs();
-  assert(mult_output.size() == dims_[0] * dims_[1] * dims_[2]);
-  output_.resize(dims_[0] * dims_[2]);
-  using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
-  using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
-  Eigen::TensorMap<TensorType3> input_tensor(mult_output.data(), dims_[0], dims_[1], dims_[2]);
-  Eigen::TensorMap<TensorType2> output_tensor(output_.data(), dims_[0], dims_[2]);
-  Eigen::array<Eigen::Index, 1> reduction_dimensions = {1};
-  output_tensor = input_tensor.sum(reduction_dimensions);
+  while (has_next_block()) {
+    compute_next_block();
+  }
   is_output_ready_ = true;
 }
 
@@ -426,7 +510,10 @@ std::vector<T> MatrixMultiplicationLHS<T>::get_output() {
 
 template <typename T>
 void MatrixMultiplicationLHS<T>::clear() noexcept {
-  mult_receiver_->clear();
+  for (auto& ot_receiver : ot_receivers_) {
+    ot_receiver->clear();
+  }
+  next_block_ = 0;
   output_ = {};
   is_output_ready_ = false;
 }
@@ -436,11 +523,14 @@ void MatrixMultiplicationLHS<T>::clear() noexcept {
 template <typename T>
 ConvolutionInputSide<T>::ConvolutionInputSide(tensor::Conv2DOp conv_op,
                                               ArithmeticProvider& arith_provider)
-    : conv_op_(conv_op), is_output_ready_(false) {
-  const auto kernel_matrix_shape = conv_op_.compute_kernel_matrix_shape();
-  const auto input_matrix_shape = conv_op_.compute_input_matrix_shape();
-  matrix_rhs_ = arith_provider.register_matrix_multiplication_rhs<T>(
-      kernel_matrix_shape.first, kernel_matrix_shape.second, input_matrix_shape.second);
+    : conv_op_(conv_op), group_op_(conv_op.get_group_op()), is_output_ready_(false) {
+  const auto kernel_matrix_shape = group_op_.compute_kernel_matrix_shape();
+  const auto input_matrix_shape = group_op_.compute_input_matrix_shape();
+  matrix_rhs_.reserve(conv_op_.group_);
+  for (std::size_t group_i = 0; group_i < conv_op_.group_; ++group_i) {
+    matrix_rhs_.emplace_back(arith_provider.register_matrix_multiplication_rhs<T>(
+        kernel_matrix_shape.first, kernel_matrix_shape.second, input_matrix_shape.second));
+  }
 }
 
 template <typename T>
@@ -461,47 +551,60 @@ void ConvolutionInputSide<T>::set_input(const std::vector<T>& input) {
 
 template <typename T>
 void ConvolutionInputSide<T>::set_input(const T* input_buffer) {
-  const auto matrix_shape = conv_op_.compute_input_matrix_shape();
-  std::vector<T> input_matrix_buffer(matrix_shape.first * matrix_shape.second);
+  const auto matrix_shape = group_op_.compute_input_matrix_shape();
+  const auto group_input_size = group_op_.compute_input_size();
   using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
   using CTensorType3 = Eigen::Tensor<const T, 3, Eigen::RowMajor>;
-  Eigen::TensorMap<CTensorType3> input(input_buffer, conv_op_.input_shape_[0],
-                                       conv_op_.input_shape_[1], conv_op_.input_shape_[2]);
-  Eigen::TensorMap<TensorType2> input_matrix(input_matrix_buffer.data(), matrix_shape.first,
-                                             matrix_shape.second);
-  input_matrix =
-      input.shuffle(Eigen::array<Eigen::Index, 3>{2, 1, 0})
-          .extract_image_patches(conv_op_.kernel_shape_[2], conv_op_.kernel_shape_[3],
-                                 conv_op_.strides_[0], conv_op_.strides_[1], conv_op_.dilations_[0],
-                                 conv_op_.dilations_[1], 1, 1, conv_op_.pads_[0], conv_op_.pads_[2],
-                                 conv_op_.pads_[1], conv_op_.pads_[3], 0)
-          .reshape(Eigen::array<Eigen::Index, 2>{static_cast<Eigen::Index>(matrix_shape.second),
-                                                 static_cast<Eigen::Index>(matrix_shape.first)})
-          .shuffle(Eigen::array<Eigen::Index, 2>{1, 0});
-  matrix_rhs_->set_input(std::move(input_matrix_buffer));
+  for (std::size_t group_i = 0; group_i < conv_op_.group_; ++group_i) {
+    std::vector<T> input_matrix_buffer(matrix_shape.first * matrix_shape.second);
+    Eigen::TensorMap<CTensorType3> input(input_buffer + group_i * group_input_size,
+                                         group_op_.input_shape_[0], group_op_.input_shape_[1],
+                                         group_op_.input_shape_[2]);
+    Eigen::TensorMap<TensorType2> input_matrix(input_matrix_buffer.data(), matrix_shape.first,
+                                               matrix_shape.second);
+    input_matrix =
+        input.shuffle(Eigen::array<Eigen::Index, 3>{2, 1, 0})
+            .extract_image_patches(group_op_.kernel_shape_[2], group_op_.kernel_shape_[3],
+                                   group_op_.strides_[0], group_op_.strides_[1],
+                                   group_op_.dilations_[0], group_op_.dilations_[1], 1, 1,
+                                   group_op_.pads_[0], group_op_.pads_[2], group_op_.pads_[1],
+                                   group_op_.pads_[3], 0)
+            .reshape(Eigen::array<Eigen::Index, 2>{static_cast<Eigen::Index>(matrix_shape.second),
+                                                   static_cast<Eigen::Index>(matrix_shape.first)})
+            .shuffle(Eigen::array<Eigen::Index, 2>{1, 0});
+    matrix_rhs_[group_i]->set_input(std::move(input_matrix_buffer));
+  }
 }
 
 template <typename T>
-void ConvolutionInputSide<T>::compute_output() {
-  matrix_rhs_->compute_output();
-  output_ = matrix_rhs_->get_output();
-  assert(output_.size() == conv_op_.compute_output_size());
+void ConvolutionInputSide<T>::store_group_output(std::size_t group_i) {
   using CTensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
   using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
-  const auto matrix_shape = conv_op_.compute_output_matrix_shape();
-  // be careful about aliasing, use eval()
-  Eigen::TensorMap<CTensorType2> output_matrix(output_.data(), matrix_shape.first,
-                                               matrix_shape.second);
-  Eigen::TensorMap<TensorType3> output(output_.data(), conv_op_.output_shape_[0],
-                                       conv_op_.output_shape_[1], conv_op_.output_shape_[2]);
+  const auto matrix_shape = group_op_.compute_output_matrix_shape();
+  const auto group_output_size = group_op_.compute_output_size();
   const std::array<Eigen::Index, 3> rev_output_dimensions = {
-      static_cast<Eigen::Index>(conv_op_.output_shape_[2]),
-      static_cast<Eigen::Index>(conv_op_.output_shape_[1]),
-      static_cast<Eigen::Index>(conv_op_.output_shape_[0])};
+      static_cast<Eigen::Index>(group_op_.output_shape_[2]),
+      static_cast<Eigen::Index>(group_op_.output_shape_[1]),
+      static_cast<Eigen::Index>(group_op_.output_shape_[0])};
+  output_.resize(conv_op_.compute_output_size());
+  auto group_output = matrix_rhs_[group_i]->get_output();
+  assert(group_output.size() == group_output_size);
+  Eigen::TensorMap<CTensorType2> output_matrix(group_output.data(), matrix_shape.first,
+                                               matrix_shape.second);
+  Eigen::TensorMap<TensorType3> output(output_.data() + group_i * group_output_size,
+                                       group_op_.output_shape_[0], group_op_.output_shape_[1],
+                                       group_op_.output_shape_[2]);
   output = output_matrix.shuffle(std::array<Eigen::Index, 2>{1, 0})
                .reshape(rev_output_dimensions)
-               .shuffle(Eigen::array<Eigen::Index, 3>{2, 1, 0})
-               .eval();
+               .shuffle(Eigen::array<Eigen::Index, 3>{2, 1, 0});
+}
+
+template <typename T>
+void ConvolutionInputSide<T>::compute_output() {
+  for (std::size_t group_i = 0; group_i < conv_op_.group_; ++group_i) {
+    matrix_rhs_[group_i]->compute_output();
+    store_group_output(group_i);
+  }
   is_output_ready_ = true;
 }
 
@@ -513,7 +616,9 @@ std::vector<T> ConvolutionInputSide<T>::get_output() {
 
 template <typename T>
 void ConvolutionInputSide<T>::clear() noexcept {
-  matrix_rhs_->clear();
+  for (auto& matrix_rhs : matrix_rhs_) {
+    matrix_rhs->clear();
+  }
   output_ = {};
   is_output_ready_ = false;
 }
@@ -523,11 +628,14 @@ void ConvolutionInputSide<T>::clear() noexcept {
 template <typename T>
 ConvolutionKernelSide<T>::ConvolutionKernelSide(tensor::Conv2DOp conv_op,
                                                 ArithmeticProvider& arith_provider)
-    : conv_op_(conv_op), is_output_ready_(false) {
-  const auto kernel_matrix_shape = conv_op_.compute_kernel_matrix_shape();
-  const auto input_matrix_shape = conv_op_.compute_input_matrix_shape();
-  matrix_lhs_ = arith_provider.register_matrix_multiplication_lhs<T>(
-      kernel_matrix_shape.first, kernel_matrix_shape.second, input_matrix_shape.second);
+    : conv_op_(conv_op), group_op_(conv_op.get_group_op()), is_output_ready_(false) {
+  const auto kernel_matrix_shape = group_op_.compute_kernel_matrix_shape();
+  const auto input_matrix_shape = group_op_.compute_input_matrix_shape();
+  matrix_lhs_.reserve(conv_op_.group_);
+  for (std::size_t group_i = 0; group_i < conv_op_.group_; ++group_i) {
+    matrix_lhs_.emplace_back(arith_provider.register_matrix_multiplication_lhs<T>(
+        kernel_matrix_shape.first, kernel_matrix_shape.second, input_matrix_shape.second));
+  }
 }
 
 template <typename T>
@@ -550,42 +658,53 @@ template <typename T>
 void ConvolutionKernelSide<T>::set_input(const T* kernel_buffer) {
   using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
   using CTensorType4 = Eigen::Tensor<const T, 4, Eigen::RowMajor>;
-  Eigen::TensorMap<CTensorType4> kernel(kernel_buffer, conv_op_.kernel_shape_[0],
-                                        conv_op_.kernel_shape_[1], conv_op_.kernel_shape_[2],
-                                        conv_op_.kernel_shape_[3]);
-  const auto matrix_shape = conv_op_.compute_kernel_matrix_shape();
-  std::vector<T> kernel_matrix_buffer(matrix_shape.first * matrix_shape.second);
-  Eigen::TensorMap<TensorType2> kernel_matrix(kernel_matrix_buffer.data(), matrix_shape.first,
-                                              matrix_shape.second);
-  kernel_matrix =
-      kernel.shuffle(std::array<Eigen::Index, 4>{3, 2, 1, 0})
-          .reshape(std::array<Eigen::Index, 2>{static_cast<Eigen::Index>(matrix_shape.second),
-                                               static_cast<Eigen::Index>(matrix_shape.first)})
-          .shuffle(std::array<Eigen::Index, 2>{1, 0});
-  matrix_lhs_->set_input(std::move(kernel_matrix_buffer));
+  const auto matrix_shape = group_op_.compute_kernel_matrix_shape();
+  const auto group_kernel_size = group_op_.compute_kernel_size();
+  for (std::size_t group_i = 0; group_i < conv_op_.group_; ++group_i) {
+    Eigen::TensorMap<CTensorType4> kernel(kernel_buffer + group_i * group_kernel_size,
+                                          group_op_.kernel_shape_[0], group_op_.kernel_shape_[1],
+                                          group_op_.kernel_shape_[2], group_op_.kernel_shape_[3]);
+    std::vector<T> kernel_matrix_buffer(matrix_shape.first * matrix_shape.second);
+    Eigen::TensorMap<TensorType2> kernel_matrix(kernel_matrix_buffer.data(), matrix_shape.first,
+                                                matrix_shape.second);
+    kernel_matrix =
+        kernel.shuffle(std::array<Eigen::Index, 4>{3, 2, 1, 0})
+            .reshape(std::array<Eigen::Index, 2>{static_cast<Eigen::Index>(matrix_shape.second),
+                                                 static_cast<Eigen::Index>(matrix_shape.first)})
+            .shuffle(std::array<Eigen::Index, 2>{1, 0});
+    matrix_lhs_[group_i]->set_input(std::move(kernel_matrix_buffer));
+  }
 }
 
 template <typename T>
-void ConvolutionKernelSide<T>::compute_output() {
-  matrix_lhs_->compute_output();
-  output_ = matrix_lhs_->get_output();
-  assert(output_.size() == conv_op_.compute_output_size());
+void ConvolutionKernelSide<T>::store_group_output(std::size_t group_i) {
   using CTensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
   using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
-  const auto matrix_shape = conv_op_.compute_output_matrix_shape();
-  // be careful about aliasing, use eval()
-  Eigen::TensorMap<CTensorType2> output_matrix(output_.data(), matrix_shape.first,
-                                               matrix_shape.second);
-  Eigen::TensorMap<TensorType3> output(output_.data(), conv_op_.output_shape_[0],
-                                       conv_op_.output_shape_[1], conv_op_.output_shape_[2]);
+  const auto matrix_shape = group_op_.compute_output_matrix_shape();
+  const auto group_output_size = group_op_.compute_output_size();
   const std::array<Eigen::Index, 3> rev_output_dimensions = {
-      static_cast<Eigen::Index>(conv_op_.output_shape_[2]),
-      static_cast<Eigen::Index>(conv_op_.output_shape_[1]),
-      static_cast<Eigen::Index>(conv_op_.output_shape_[0])};
+      static_cast<Eigen::Index>(group_op_.output_shape_[2]),
+      static_cast<Eigen::Index>(group_op_.output_shape_[1]),
+      static_cast<Eigen::Index>(group_op_.output_shape_[0])};
+  output_.resize(conv_op_.compute_output_size());
+  auto group_output = matrix_lhs_[group_i]->get_output();
+  assert(group_output.size() == group_output_size);
+  Eigen::TensorMap<CTensorType2> output_matrix(group_output.data(), matrix_shape.first,
+                                               matrix_shape.second);
+  Eigen::TensorMap<TensorType3> output(output_.data() + group_i * group_output_size,
+                                       group_op_.output_shape_[0], group_op_.output_shape_[1],
+                                       group_op_.output_shape_[2]);
   output = output_matrix.shuffle(std::array<Eigen::Index, 2>{1, 0})
                .reshape(rev_output_dimensions)
-               .shuffle(Eigen::array<Eigen::Index, 3>{2, 1, 0})
-               .eval();
+               .shuffle(Eigen::array<Eigen::Index, 3>{2, 1, 0});
+}
+
+template <typename T>
+void ConvolutionKernelSide<T>::compute_output() {
+  for (std::size_t group_i = 0; group_i < conv_op_.group_; ++group_i) {
+    matrix_lhs_[group_i]->compute_output();
+    store_group_output(group_i);
+  }
   is_output_ready_ = true;
 }
 
@@ -597,11 +716,50 @@ std::vector<T> ConvolutionKernelSide<T>::get_output() {
 
 template <typename T>
 void ConvolutionKernelSide<T>::clear() noexcept {
-  matrix_lhs_->clear();
+  for (auto& matrix_lhs : matrix_lhs_) {
+    matrix_lhs->clear();
+  }
   output_ = {};
   is_output_ready_ = false;
 }
 
+// ---------- lockstep drivers ----------
+
+template <typename T>
+void compute_matrix_multiplication_outputs(MatrixMultiplicationLHS<T>& lhs,
+                                           MatrixMultiplicationRHS<T>& rhs) {
+  // The RHS of the other party sends the OT message of a block only after it
+  // has received our message of the previous block, so we never receive more
+  // than about one block ahead.
+  while (lhs.has_next_block() || rhs.has_next_block()) {
+    if (rhs.has_next_block()) {
+      rhs.compute_next_block();
+    }
+    if (lhs.has_next_block()) {
+      lhs.compute_next_block();
+    }
+  }
+  // mark the outputs as ready, also if there are no blocks
+  lhs.compute_output();
+  rhs.compute_output();
+}
+
+template <typename T>
+void compute_convolution_outputs(ConvolutionKernelSide<T>& kernel_side,
+                                 ConvolutionInputSide<T>& input_side) {
+  if (kernel_side.conv_op_.group_ != input_side.conv_op_.group_) {
+    throw std::invalid_argument("convolutions have different numbers of groups");
+  }
+  for (std::size_t group_i = 0; group_i < kernel_side.conv_op_.group_; ++group_i) {
+    compute_matrix_multiplication_outputs(*kernel_side.matrix_lhs_[group_i],
+                                          *input_side.matrix_rhs_[group_i]);
+    kernel_side.store_group_output(group_i);
+    input_side.store_group_output(group_i);
+  }
+  kernel_side.is_output_ready_ = true;
+  input_side.is_output_ready_ = true;
+}
+
 // ---------- ArithmeticProvider ----------
 
 ArithmeticProvider::ArithmeticProvider(ENCRYPTO::ObliviousTransfer::OTProvider& ot_provider,
@@ -641,13 +799,13 @@ ArithmeticProvider::register_integer_multiplication_receive(std::size_t batch_si
 template <typename T>
 std::unique_ptr<MatrixMultiplicationRHS<T>> ArithmeticProvider::register_matrix_multiplication_rhs(
     std::size_t dim_l, std::size_t dim_m, std::size_t dim_n) {
-  return std::make_unique<MatrixMultiplicationRHS<T>>(dim_l, dim_m, dim_n, *this);
+  return std::make_unique<MatrixMultiplicationRHS<T>>(dim_l, dim_m, dim_n, ot_provider_);
 }
 
 template <typename T>
 std::unique_ptr<MatrixMultiplicationLHS<T>> ArithmeticProvider::register_matrix_multiplication_lhs(
     std::size_t dim_l, std::size_t dim_m, std::size_t dim_n) {
-  return std::make_unique<MatrixMultiplicationLHS<T>>(dim_l, dim_m, dim_n, *this);
+  return std::make_unique<MatrixMultiplicationLHS<T>>(dim_l, dim_m, dim_n, ot_provider_);
 }
 
 template <typename T>
@@ -733,6 +891,28 @@ template class ConvolutionKernelSide<std::uint32_t>;
 template class ConvolutionKernelSide<std::uint64_t>;
 template class ConvolutionKernelSide<__uint128_t>;
 
+template void compute_matrix_multiplication_outputs(MatrixMultiplicationLHS<std::uint8_t>&,
+                                                    MatrixMultiplicationRHS<std::uint8_t>&);
+template void compute_matrix_multiplication_outputs(MatrixMultiplicationLHS<std::uint16_t>&,
+                                                    MatrixMultiplicationRHS<std::uint16_t>&);
+template void compute_matrix_multiplication_outputs(MatrixMultiplicationLHS<std::uint32_t>&,
+                                                    MatrixMultiplicationRHS<std::uint32_t>&);
+template void compute_matrix_multiplication_outputs(MatrixMultiplicationLHS<std::uint64_t>&,
+                                                    MatrixMultiplicationRHS<std::uint64_t>&);
+template void compute_matrix_multiplication_outputs(MatrixMultiplicationLHS<__uint128_t>&,
+                                                    MatrixMultiplicationRHS<__uint128_t>&);
+
+template void compute_convolution_outputs(ConvolutionKernelSide<std::uint8_t>&,
+                                          ConvolutionInputSide<std::uint8_t>&);
+template void compute_convolution_outputs(ConvolutionKernelSide<std::uint16_t>&,
+                                          ConvolutionInputSide<std::uint16_t>&);
+template void compute_convolution_outputs(ConvolutionKernelSide<std::uint32_t>&,
+                                          ConvolutionInputSide<std::uint32_t>&);
+template void compute_convolution_outputs(ConvolutionKernelSide<std::uint64_t>&,
+                                          ConvolutionInputSide<std::uint64_t>&);
+template void compute_convolution_outputs(ConvolutionKernelSide<__uint128_t>&,
+                                          ConvolutionInputSide<__uint128_t>&);
+
 template std::unique_ptr<BitIntegerMultiplicationIntSide<std::uint8_t>>
     ArithmeticProvider::register_bit_integer_multiplication_int_side<std::uint8_t>(std::size_t,
                                                                                    std::size_t);
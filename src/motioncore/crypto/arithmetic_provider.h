@@ -134,47 +134,74 @@ class IntegerMultiplicationReceiver {
   std::shared_ptr<Logger> logger_;
 };
 
+// Computes shares of the product of an l x m matrix A (LHS) and an m x n
+// matrix B (RHS) with l * m * bit_size ACOTs of vectors of size n.  The OT
+// outputs are accumulated into the l x n output as they are computed, s.t.
+// neither B is replicated nor the l x m x n products are stored.
+//
+// The ACOTs are grouped into blocks of rows of A.  The OT extension only
+// stores a 128 bit seed per ACOT, and the RHS sends the OT message of a block
+// only when the block is computed.  The LHS sends all its correction bits in
+// set_input, so the RHS never waits for the LHS.  If each party drives its
+// LHS and RHS with compute_matrix_multiplication_outputs, at most about one
+// block of OT messages is in flight in each direction.
 template <typename T>
 class MatrixMultiplicationRHS {
  public:
-  MatrixMultiplicationRHS(std::size_t l, std::size_t m, std::size_t n, ArithmeticProvider&);
+  MatrixMultiplicationRHS(std::size_t l, std::size_t m, std::size_t n,
+                          ENCRYPTO::ObliviousTransfer::OTProvider&);
   ~MatrixMultiplicationRHS();
   void set_input(std::vector<T>&& inputs);
   void set_input(const std::vector<T>& inputs);
   void set_input(const T* inputs);
   void compute_output();
+  // send the OT message of the next block and accumulate its outputs
+  void compute_next_block();
+  bool has_next_block() const { return next_block_ < ot_senders_.size(); }
   std::vector<T> get_output();
   void clear() noexcept;
 
  private:
   using is_enabled_ = ENCRYPTO::is_unsigned_int_t<T>;
   std::array<std::size_t, 3> dims_;
+  std::size_t rows_per_block_;
+  std::size_t next_block_;
+  std::vector<T> input_;
   std::vector<T> output_;
-  std::unique_ptr<IntegerMultiplicationSender<T>> mult_sender_;
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::ACOTSender<T>>> ot_senders_;
   bool is_output_ready_;
 };
 
 template <typename T>
 class MatrixMultiplicationLHS {
  public:
-  MatrixMultiplicationLHS(std::size_t l, std::size_t m, std::size_t n, ArithmeticProvider&);
+  MatrixMultiplicationLHS(std::size_t l, std::size_t m, std::size_t n,
+                          ENCRYPTO::ObliviousTransfer::OTProvider&);
   ~MatrixMultiplicationLHS();
   void set_input(std::vector<T>&& inputs);
   void set_input(const std::vector<T>& inputs);
   void set_input(const T* inputs);
   void compute_output();
+  // receive the OT message of the next block and accumulate its outputs
+  void compute_next_block();
+  bool has_next_block() const { return next_block_ < ot_receivers_.size(); }
   std::vector<T> get_output();
   void clear() noexcept;
 
  private:
   using is_enabled_ = ENCRYPTO::is_unsigned_int_t<T>;
   std::array<std::size_t, 3> dims_;
+  std::size_t rows_per_block_;
+  std::size_t next_block_;
   std::vector<T> output_;
-  std::unique_ptr<IntegerMultiplicationReceiver<T>> mult_receiver_;
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::ACOTReceiver<T>>> ot_receivers_;
   std::shared_ptr<Logger> logger_;
   bool is_output_ready_;
 };
 
+template <typename T>
+class ConvolutionKernelSide;
+
 template <typename T>
 class ConvolutionInputSide {
  public:
@@ -188,10 +215,17 @@ class ConvolutionInputSide {
   void clear() noexcept;
 
  private:
+  template <typename U>
+  friend void compute_convolution_outputs(ConvolutionKernelSide<U>&, ConvolutionInputSide<U>&);
+  // move the output of the matrix multiplication of a group into output_
+  void store_group_output(std::size_t group_i);
+
   using is_enabled_ = ENCRYPTO::is_unsigned_int_t<T>;
   const tensor::Conv2DOp conv_op_;
+  // dense convolution of each group, each one is a separate matrix multiplication
+  const tensor::Conv2DOp group_op_;
   std::vector<T> output_;
-  std::unique_ptr<MatrixMultiplicationRHS<T>> matrix_rhs_;
+  std::vector<std::unique_ptr<MatrixMultiplicationRHS<T>>> matrix_rhs_;
   bool is_output_ready_;
 };
 
@@ -208,14 +242,31 @@ class ConvolutionKernelSide {
   void clear() noexcept;
 
  private:
+  template <typename U>
+  friend void compute_convolution_outputs(ConvolutionKernelSide<U>&, ConvolutionInputSide<U>&);
+  // move the output of the matrix multiplication of a group into output_
+  void store_group_output(std::size_t group_i);
+
   using is_enabled_ = ENCRYPTO::is_unsigned_int_t<T>;
   const tensor::Conv2DOp conv_op_;
+  const tensor::Conv2DOp group_op_;
   std::vector<T> output_;
-  std::unique_ptr<MatrixMultiplicationLHS<T>> matrix_lhs_;
+  std::vector<std::unique_ptr<MatrixMultiplicationLHS<T>>> matrix_lhs_;
   std::shared_ptr<Logger> logger_;
   bool is_output_ready_;
 };
 
+// Computes the outputs of the LHS and the RHS of two matrix multiplications
+// of this party block by block in lockstep (see MatrixMultiplicationRHS).
+// Both parties need to call it for the corresponding pairs in the same order.
+template <typename T>
+void compute_matrix_multiplication_outputs(MatrixMultiplicationLHS<T>&,
+                                           MatrixMultiplicationRHS<T>&);
+
+// Same for the kernel and the input side of two convolutions, group by group.
+template <typename T>
+void compute_convolution_outputs(ConvolutionKernelSide<T>&, ConvolutionInputSide<T>&);
+
 class ArithmeticProvider {
  public:
   ArithmeticProvider(ENCRYPTO::ObliviousTransfer::OTProvider&, std::shared_ptr<Logger>);
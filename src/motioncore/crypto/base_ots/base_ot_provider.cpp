@@ -30,6 +30,7 @@
 #include "communication/fbs_headers/message_generated.h"
 #include "communication/message_handler.h"
 #include "crypto/base_ots/ot_hl17.h"
+#include "crypto/blake2b.h"
 #include "data_storage/base_ot_data.h"
 #include "statistics/run_time_stats.h"
 #include "utility/fiber_condition.h"
@@ -235,4 +236,39 @@ std::pair<ReceiverMsgs, SenderMsgs> BaseOTProvider::ExportBaseOTs(std::size_t pa
   return base_ots;
 }
 
+static void derive_base_ot_messages(base_ot_msgs_t &messages, std::uint64_t session_id,
+                                    Blake2bCtx &ctx) {
+  std::array<std::uint8_t, 16 + 2 * sizeof(std::uint64_t)> input;
+  std::uint8_t digest[EVP_MAX_MD_SIZE];
+  for (std::uint64_t i = 0; i < messages.size(); ++i) {
+    std::copy_n(reinterpret_cast<const std::uint8_t *>(messages.at(i).data()), 16, input.data());
+    std::copy_n(reinterpret_cast<const std::uint8_t *>(&session_id), sizeof(session_id),
+                input.data() + 16);
+    std::copy_n(reinterpret_cast<const std::uint8_t *>(&i), sizeof(i),
+                input.data() + 16 + sizeof(session_id));
+    Blake2b(input.data(), digest, input.size(), ctx);
+    std::copy_n(reinterpret_cast<const std::byte *>(digest), 16, messages.at(i).data());
+  }
+}
+
+void BaseOTProvider::ImportDerivedBaseOTs(BaseOTProvider &source, std::uint64_t session_id) {
+  if (source.num_parties_ != num_parties_ || source.my_id_ != my_id_) {
+    throw std::invalid_argument("Base OTs can only be derived from a provider of the same party");
+  }
+  source.wait_setup();
+
+  auto ctx = NewBlakeCtx();
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    auto [receiver_msgs, sender_msgs] = source.ExportBaseOTs(party_id);
+    derive_base_ot_messages(receiver_msgs.messages_c_, session_id, ctx);
+    derive_base_ot_messages(sender_msgs.messages_0_, session_id, ctx);
+    derive_base_ot_messages(sender_msgs.messages_1_, session_id, ctx);
+    ImportBaseOTs(party_id, receiver_msgs);
+    ImportBaseOTs(party_id, sender_msgs);
+  }
+}
+
 }  // namespace MOTION
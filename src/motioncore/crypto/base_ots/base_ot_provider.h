@@ -26,6 +26,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 
 #include "data_storage/base_ot_data.h"
 #include "utility/bit_vector.h"
@@ -67,6 +68,11 @@ class BaseOTProvider : public ENCRYPTO::enable_wait_setup {
   void ImportBaseOTs(std::size_t party_id, const ReceiverMsgs& msgs);
   void ImportBaseOTs(std::size_t party_id, const SenderMsgs& msgs);
   std::pair<ReceiverMsgs, SenderMsgs> ExportBaseOTs(std::size_t party_id);
+  // Import base OTs for another session derived from the (finished) base OTs
+  // of the given provider by hashing each message with the session id, so
+  // that sessions running over the same connections can share the base OTs
+  // (cf. Communication::SessionMultiplexer).
+  void ImportDerivedBaseOTs(BaseOTProvider& source, std::uint64_t session_id);
   BaseOTsData& get_base_ots_data(std::size_t party_id) { return data_.at(party_id); }
   const BaseOTsData& get_base_ots_data(std::size_t party_id) const { return data_.at(party_id); }
 
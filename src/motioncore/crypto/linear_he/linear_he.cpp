@@ -0,0 +1,874 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "linear_he.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include "crypto/pseudo_random_generator.h"
+#include "crypto/random/aes128_ctr_rng.h"
+#include "utility/type_traits.hpp"
+
+namespace MOTION::LinearHE {
+
+namespace {
+
+using u64 = std::uint64_t;
+using u128 = __uint128_t;
+using i128 = __int128_t;
+
+// polynomial in RNS representation: the residues modulo the first k moduli,
+// i.e., k blocks of poly_degree coefficients
+using Poly = std::vector<u64>;
+
+constexpr std::size_t num_moduli = 4;
+// the responses are switched down to the first two moduli
+constexpr std::size_t num_response_moduli = 2;
+// primes q = 1 mod 2N, in decreasing order
+constexpr std::array<u64, num_moduli> moduli = {18014398508400641ull, 18014398508138497ull,
+                                                18014398507892737ull, 18014398507794433ull};
+constexpr std::size_t modulus_bit_size = 54;
+// lower bounds on log2 of the product of all moduli and the last two moduli
+constexpr double log_modulus = 215.99;
+constexpr double log_dropped_moduli = 107.99;
+constexpr std::size_t seed_size = 16;
+// centered binomial distribution with parameter 21 (standard deviation 3.24)
+constexpr std::size_t noise_eta = 21;
+
+u64 add_mod(u64 a, u64 b, u64 q) {
+  const u64 s = a + b;
+  return s >= q ? s - q : s;
+}
+
+u64 sub_mod(u64 a, u64 b, u64 q) { return a >= b ? a - b : a + q - b; }
+
+u64 mul_mod(u64 a, u64 b, u64 q) { return static_cast<u64>(static_cast<u128>(a) * b % q); }
+
+u64 pow_mod(u64 base, u64 exponent, u64 q) {
+  u64 result = 1;
+  for (; exponent > 0; exponent >>= 1) {
+    if (exponent & 1) {
+      result = mul_mod(result, base, q);
+    }
+    base = mul_mod(base, base, q);
+  }
+  return result;
+}
+
+u64 inv_mod(u64 a, u64 q) { return pow_mod(a, q - 2, q); }
+
+// Shoup's precomputation for multiplications with the constant w
+u64 shoup(u64 w, u64 q) { return static_cast<u64>((static_cast<u128>(w) << 64) / q); }
+
+u64 mul_mod_shoup(u64 x, u64 w, u64 w_shoup, u64 q) {
+  const u64 hi = static_cast<u64>((static_cast<u128>(x) * w_shoup) >> 64);
+  const u64 r = x * w - hi * q;
+  return r >= q ? r - q : r;
+}
+
+u64 reduce_signed(std::int64_t v, u64 q) {
+  if (v >= 0) {
+    return static_cast<u64>(v) % q;
+  }
+  const u64 r = static_cast<u64>(-(v + 1)) % q;  // avoids overflow for the minimum
+  return q - 1 - r;
+}
+
+u64 reduce_signed(i128 v, u64 q) {
+  if (v >= 0) {
+    return static_cast<u64>(static_cast<u128>(v) % q);
+  }
+  const u64 r = static_cast<u64>(static_cast<u128>(-(v + 1)) % q);
+  return q - 1 - r;
+}
+
+struct NTTTables {
+  u64 q;
+  std::vector<u64> psi;  // powers of a primitive 2N-th root in bit-reversed order
+  std::vector<u64> psi_shoup;
+  std::vector<u64> psi_inv;
+  std::vector<u64> psi_inv_shoup;
+  u64 n_inv;
+  u64 n_inv_shoup;
+};
+
+struct Context {
+  Context() {
+    const std::size_t log_n = std::countr_zero(poly_degree);
+    for (std::size_t i = 0; i < num_moduli; ++i) {
+      const u64 q = moduli[i];
+      auto& tables = ntt_tables[i];
+      tables.q = q;
+      // find a primitive 2N-th root of unity
+      u64 psi = 0;
+      for (u64 g = 2;; ++g) {
+        psi = pow_mod(g, (q - 1) / (2 * poly_degree), q);
+        if (pow_mod(psi, poly_degree, q) == q - 1) {
+          break;
+        }
+      }
+      const u64 psi_inv = inv_mod(psi, q);
+      tables.psi.resize(poly_degree);
+      tables.psi_shoup.resize(poly_degree);
+      tables.psi_inv.resize(poly_degree);
+      tables.psi_inv_shoup.resize(poly_degree);
+      u64 power = 1;
+      u64 power_inv = 1;
+      for (std::size_t j = 0; j < poly_degree; ++j) {
+        std::size_t rev = 0;
+        for (std::size_t b = 0; b < log_n; ++b) {
+          rev |= ((j >> b) & 1) << (log_n - 1 - b);
+        }
+        tables.psi[rev] = power;
+        tables.psi_shoup[rev] = shoup(power, q);
+        tables.psi_inv[rev] = power_inv;
+        tables.psi_inv_shoup[rev] = shoup(power_inv, q);
+        power = mul_mod(power, psi, q);
+        power_inv = mul_mod(power_inv, psi_inv, q);
+      }
+      tables.n_inv = inv_mod(poly_degree, q);
+      tables.n_inv_shoup = shoup(tables.n_inv, q);
+    }
+    for (std::size_t d = 1; d < num_moduli; ++d) {
+      for (std::size_t i = 0; i < d; ++i) {
+        dropped_modulus_inv[d][i] = inv_mod(moduli[d] % moduli[i], moduli[i]);
+        dropped_modulus_inv_shoup[d][i] = shoup(dropped_modulus_inv[d][i], moduli[i]);
+      }
+    }
+    q1_inv_mod_q0 = inv_mod(moduli[1] % moduli[0], moduli[0]);
+    q0_inv_mod_q1 = inv_mod(moduli[0] % moduli[1], moduli[1]);
+  }
+
+  std::array<NTTTables, num_moduli> ntt_tables;
+  // q_d^{-1} mod q_i for i < d
+  std::array<std::array<u64, num_moduli>, num_moduli> dropped_modulus_inv = {};
+  std::array<std::array<u64, num_moduli>, num_moduli> dropped_modulus_inv_shoup = {};
+  // for the CRT reconstruction modulo q_0 q_1
+  u64 q1_inv_mod_q0;
+  u64 q0_inv_mod_q1;
+};
+
+const Context& get_context() {
+  static const Context context;
+  return context;
+}
+
+// negacyclic NTT (Cooley-Tukey butterflies, bit-reversed output)
+void ntt_forward(u64* a, const NTTTables& tables) {
+  const u64 q = tables.q;
+  std::size_t t = poly_degree;
+  for (std::size_t m = 1; m < poly_degree; m <<= 1) {
+    t >>= 1;
+    for (std::size_t i = 0; i < m; ++i) {
+      const std::size_t j1 = 2 * i * t;
+      const u64 w = tables.psi[m + i];
+      const u64 w_shoup = tables.psi_shoup[m + i];
+      for (std::size_t j = j1; j < j1 + t; ++j) {
+        const u64 u = a[j];
+        const u64 v = mul_mod_shoup(a[j + t], w, w_shoup, q);
+        a[j] = add_mod(u, v, q);
+        a[j + t] = sub_mod(u, v, q);
+      }
+    }
+  }
+}
+
+// inverse negacyclic NTT (Gentleman-Sande butterflies, bit-reversed input)
+void ntt_inverse(u64* a, const NTTTables& tables) {
+  const u64 q = tables.q;
+  std::size_t t = 1;
+  for (std::size_t m = poly_degree; m > 1; m >>= 1) {
+    const std::size_t h = m >> 1;
+    std::size_t j1 = 0;
+    for (std::size_t i = 0; i < h; ++i) {
+      const u64 w = tables.psi_inv[h + i];
+      const u64 w_shoup = tables.psi_inv_shoup[h + i];
+      for (std::size_t j = j1; j < j1 + t; ++j) {
+        const u64 u = a[j];
+        const u64 v = a[j + t];
+        a[j] = add_mod(u, v, q);
+        a[j + t] = mul_mod_shoup(sub_mod(u, v, q), w, w_shoup, q);
+      }
+      j1 += 2 * t;
+    }
+    t <<= 1;
+  }
+  for (std::size_t j = 0; j < poly_degree; ++j) {
+    a[j] = mul_mod_shoup(a[j], tables.n_inv, tables.n_inv_shoup, q);
+  }
+}
+
+void ntt_forward(Poly& poly, std::size_t num) {
+  const auto& context = get_context();
+  for (std::size_t i = 0; i < num; ++i) {
+    ntt_forward(poly.data() + i * poly_degree, context.ntt_tables[i]);
+  }
+}
+
+void ntt_inverse(Poly& poly, std::size_t num) {
+  const auto& context = get_context();
+  for (std::size_t i = 0; i < num; ++i) {
+    ntt_inverse(poly.data() + i * poly_degree, context.ntt_tables[i]);
+  }
+}
+
+template <typename U>
+std::vector<U> random_vector(std::size_t size) {
+  std::vector<U> output(size);
+  AES128_CTR_RNG::get_thread_instance().random_bytes(reinterpret_cast<std::byte*>(output.data()),
+                                                     size * sizeof(U));
+  return output;
+}
+
+// uniform secret in {-1, 0, 1}^N
+Poly sample_ternary(std::size_t num) {
+  const auto randomness = random_vector<u64>(poly_degree);
+  Poly poly(num * poly_degree);
+  for (std::size_t j = 0; j < poly_degree; ++j) {
+    const auto r = randomness[j] % 3;
+    for (std::size_t i = 0; i < num; ++i) {
+      poly[i * poly_degree + j] = r == 2 ? moduli[i] - 1 : r;
+    }
+  }
+  return poly;
+}
+
+Poly sample_noise(std::size_t num) {
+  constexpr u64 mask = (u64(1) << noise_eta) - 1;
+  const auto randomness = random_vector<u64>(poly_degree);
+  Poly poly(num * poly_degree);
+  for (std::size_t j = 0; j < poly_degree; ++j) {
+    const std::int64_t e = std::popcount(randomness[j] & mask) -
+                           std::popcount((randomness[j] >> noise_eta) & mask);
+    for (std::size_t i = 0; i < num; ++i) {
+      poly[i * poly_degree + j] = reduce_signed(e, moduli[i]);
+    }
+  }
+  return poly;
+}
+
+// expand a seed into a uniform polynomial (interpreted in NTT form)
+Poly expand_seed(const std::uint8_t* seed) {
+  ENCRYPTO::PRG prg;
+  prg.SetKey(seed);
+  const auto randomness = prg.Encrypt(num_moduli * poly_degree * sizeof(u128));
+  const auto* values = reinterpret_cast<const u128*>(randomness.data());
+  Poly poly(num_moduli * poly_degree);
+  for (std::size_t i = 0; i < num_moduli; ++i) {
+    for (std::size_t j = 0; j < poly_degree; ++j) {
+      poly[i * poly_degree + j] = static_cast<u64>(values[i * poly_degree + j] % moduli[i]);
+    }
+  }
+  return poly;
+}
+
+// output[j] = a[j] * b[j] for the first num moduli
+void multiply_pointwise(const Poly& a, const Poly& b, Poly& output, std::size_t num) {
+  for (std::size_t i = 0; i < num; ++i) {
+    const u64 q = moduli[i];
+    for (std::size_t j = i * poly_degree; j < (i + 1) * poly_degree; ++j) {
+      output[j] = mul_mod(a[j], b[j], q);
+    }
+  }
+}
+
+constexpr std::size_t get_packed_size(std::size_t num_values) {
+  return (num_values * modulus_bit_size + 7) / 8;
+}
+
+// write the values with modulus_bit_size bits each into a little-endian bit
+// stream, the values of different moduli are packed separately
+std::uint8_t* pack_values(const u64* values, std::size_t num_values, std::uint8_t* output) {
+  u128 buffer = 0;
+  std::size_t num_bits = 0;
+  for (std::size_t j = 0; j < num_values; ++j) {
+    buffer |= static_cast<u128>(values[j]) << num_bits;
+    num_bits += modulus_bit_size;
+    while (num_bits >= 8) {
+      *output++ = static_cast<std::uint8_t>(buffer);
+      buffer >>= 8;
+      num_bits -= 8;
+    }
+  }
+  if (num_bits > 0) {
+    *output++ = static_cast<std::uint8_t>(buffer);
+  }
+  return output;
+}
+
+// inverse of pack_values, returns nullptr if a value is not reduced modulo q
+const std::uint8_t* unpack_values(const std::uint8_t* input, std::size_t num_values, u64 q,
+                                  u64* values) {
+  constexpr u64 mask = (u64(1) << modulus_bit_size) - 1;
+  u128 buffer = 0;
+  std::size_t num_bits = 0;
+  for (std::size_t j = 0; j < num_values; ++j) {
+    while (num_bits < modulus_bit_size) {
+      buffer |= static_cast<u128>(*input++) << num_bits;
+      num_bits += 8;
+    }
+    values[j] = static_cast<u64>(buffer) & mask;
+    buffer >>= modulus_bit_size;
+    num_bits -= modulus_bit_size;
+    if (values[j] >= q) {
+      return nullptr;
+    }
+  }
+  return input;
+}
+
+// floor(Q / t) mod q_i for t = 2^bit_size
+std::array<u64, num_moduli> compute_delta(std::size_t bit_size) {
+  const u64 t = u64(1) << bit_size;
+  u64 q_mod_t = 1;
+  for (const auto q : moduli) {
+    q_mod_t *= q;
+  }
+  q_mod_t &= t - 1;
+  std::array<u64, num_moduli> delta;
+  for (std::size_t i = 0; i < num_moduli; ++i) {
+    // Q = floor(Q / t) * t + (Q mod t) and Q = 0 mod q_i
+    const u64 q = moduli[i];
+    delta[i] = mul_mod((q - q_mod_t % q) % q, inv_mod(t % q, q), q);
+  }
+  return delta;
+}
+
+// number of bits of the noise which is added to the responses such that the
+// noise of the products is hidden
+std::size_t get_flooding_bit_size(std::size_t bit_size, std::size_t num_blocks_m) {
+  const double n = poly_degree;
+  const double t = std::ldexp(1.0, static_cast<int>(bit_size));
+  const double num_blocks = static_cast<double>(num_blocks_m);
+  // per block: the carries of the products times (Q mod t) < t and the
+  // encryption noise times the plaintext; additionally the carries of the
+  // sum and the mask, and the noise of the encryption of zero
+  const double bound = num_blocks * (n * t * t / 4 + n * noise_eta * t / 2) +
+                       (num_blocks + 2) * t + 2 * noise_eta * n + noise_eta;
+  return static_cast<std::size_t>(std::ceil(std::log2(bound))) + statistical_security;
+}
+
+bool is_noise_bounded(std::size_t bit_size, std::size_t num_blocks_m) {
+  const auto flooding_bit_size = get_flooding_bit_size(bit_size, num_blocks_m);
+  // the flooding noise is sampled from 128 bit integers
+  if (flooding_bit_size + 1 >= 128) {
+    return false;
+  }
+  // noise before and after the modulus switching, which adds rounding
+  // errors bounded by N and t
+  const double noise = flooding_bit_size + 1;
+  const double switched_noise = std::log2(std::exp2(noise - log_dropped_moduli) +
+                                          poly_degree + 1 + std::ldexp(1.0, bit_size));
+  return noise + 1 < log_modulus - bit_size &&
+         switched_noise + 1 < log_modulus - log_dropped_moduli - bit_size;
+}
+
+template <typename T>
+std::int64_t to_signed(T value) {
+  return static_cast<std::int64_t>(static_cast<std::make_signed_t<T>>(value));
+}
+
+void check_packing(const MatrixPacking& packing, std::size_t bit_size) {
+  if (packing.bit_size_ != bit_size) {
+    throw std::invalid_argument(
+        fmt::format("LinearHE: packing for {} bit integers used with {} bit integers",
+                    packing.bit_size_, bit_size));
+  }
+}
+
+// Divide by the last of the num moduli with rounding, i.e., switch to the
+// first num - 1 moduli.  The residues are stored in blocks of size stride.
+void drop_last_modulus(u64* residues, std::size_t stride, std::size_t count, std::size_t num) {
+  const auto& context = get_context();
+  const std::size_t d = num - 1;
+  const u64 q_d = moduli[d];
+  for (std::size_t j = 0; j < count; ++j) {
+    const u64 v = residues[d * stride + j];
+    // centered representative of the residue modulo q_d
+    const bool negative = v > q_d / 2;
+    for (std::size_t i = 0; i < d; ++i) {
+      const u64 q = moduli[i];
+      const u64 v_i = negative ? (v + (q - q_d)) % q : v % q;
+      residues[i * stride + j] =
+          mul_mod_shoup(sub_mod(residues[i * stride + j], v_i, q), context.dropped_modulus_inv[d][i],
+                        context.dropped_modulus_inv_shoup[d][i], q);
+    }
+  }
+}
+
+}  // namespace
+
+// ---------- MatrixPacking ----------
+
+bool MatrixPacking::is_supported(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n,
+                                 std::size_t bit_size) noexcept {
+  if (dim_l == 0 || dim_m == 0 || dim_n == 0 || bit_size == 0 || bit_size > max_bit_size) {
+    return false;
+  }
+  // the noise grows with the number of blocks in the m dimension, which is
+  // minimal for the largest block size
+  const auto block_m = std::min(dim_m, (poly_degree + 1) / 2);
+  return is_noise_bounded(bit_size, (dim_m + block_m - 1) / block_m);
+}
+
+MatrixPacking MatrixPacking::compute(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n,
+                                     std::size_t bit_size) {
+  if (!is_supported(dim_l, dim_m, dim_n, bit_size)) {
+    throw std::invalid_argument(fmt::format(
+        "LinearHE: product of {}x{} and {}x{} matrices over {} bit integers is not supported",
+        dim_l, dim_m, dim_m, dim_n, bit_size));
+  }
+  MatrixPacking best;
+  std::size_t best_size = std::numeric_limits<std::size_t>::max();
+  std::size_t best_num_products = std::numeric_limits<std::size_t>::max();
+  for (std::size_t block_m = 1; block_m <= std::min(dim_m, (poly_degree + 1) / 2); ++block_m) {
+    if (!is_noise_bounded(bit_size, (dim_m + block_m - 1) / block_m)) {
+      continue;
+    }
+    // l_w m_w n_w + m_w - 1 <= N
+    const std::size_t max_block_ln = (poly_degree + 1 - block_m) / block_m;
+    for (std::size_t block_n = 1; block_n <= std::min(dim_n, max_block_ln); ++block_n) {
+      const std::size_t block_l = std::min(dim_l, max_block_ln / block_n);
+      const MatrixPacking packing = {dim_l,   dim_m,   dim_n,  bit_size,
+                                     block_l, block_m, block_n};
+      const auto size = packing.get_query_size() + packing.get_response_size();
+      const auto num_products = packing.get_num_products();
+      if (size < best_size || (size == best_size && num_products < best_num_products)) {
+        best = packing;
+        best_size = size;
+        best_num_products = num_products;
+      }
+    }
+  }
+  return best;
+}
+
+std::size_t MatrixPacking::get_query_size() const noexcept {
+  return get_num_query_ciphertexts() * (seed_size + get_packed_size(num_moduli * poly_degree));
+}
+
+std::size_t MatrixPacking::get_response_size() const noexcept {
+  return get_num_response_ciphertexts() *
+         (get_packed_size(num_response_moduli * poly_degree) +
+          num_response_moduli * get_packed_size(block_l_ * block_n_));
+}
+
+std::size_t get_public_key_size() noexcept {
+  return seed_size + get_packed_size(num_moduli * poly_degree);
+}
+
+// ---------- MatrixProductClient ----------
+
+struct MatrixProductClient::Keys {
+  Poly secret_key;  // in NTT form
+  std::array<std::uint8_t, seed_size> public_key_seed;
+  Poly public_key;  // -a s + e in NTT form, where a is expanded from the seed
+};
+
+MatrixProductClient::MatrixProductClient() : keys_(std::make_unique<Keys>()) {
+  keys_->secret_key = sample_ternary(num_moduli);
+  ntt_forward(keys_->secret_key, num_moduli);
+  const auto seed = random_vector<std::uint8_t>(seed_size);
+  std::copy(std::begin(seed), std::end(seed), std::begin(keys_->public_key_seed));
+  const auto a = expand_seed(keys_->public_key_seed.data());
+  keys_->public_key = sample_noise(num_moduli);
+  ntt_forward(keys_->public_key, num_moduli);
+  for (std::size_t i = 0; i < num_moduli; ++i) {
+    const u64 q = moduli[i];
+    for (std::size_t j = i * poly_degree; j < (i + 1) * poly_degree; ++j) {
+      keys_->public_key[j] =
+          sub_mod(keys_->public_key[j], mul_mod(a[j], keys_->secret_key[j], q), q);
+    }
+  }
+}
+
+MatrixProductClient::~MatrixProductClient() = default;
+
+std::vector<std::uint8_t> MatrixProductClient::get_public_key() const {
+  std::vector<std::uint8_t> output(get_public_key_size());
+  std::copy(std::begin(keys_->public_key_seed), std::end(keys_->public_key_seed),
+            std::begin(output));
+  pack_values(keys_->public_key.data(), num_moduli * poly_degree, output.data() + seed_size);
+  return output;
+}
+
+template <typename T>
+std::vector<std::uint8_t> MatrixProductClient::encrypt(const MatrixPacking& packing,
+                                                       const T* matrix_A) const {
+  check_packing(packing, ENCRYPTO::bit_size_v<T>);
+  const auto delta = compute_delta(packing.bit_size_);
+  const auto num_blocks_m = packing.get_num_blocks_m();
+  const auto num_ciphertexts = packing.get_num_query_ciphertexts();
+  const auto ciphertext_size = packing.get_query_size() / num_ciphertexts;
+  std::vector<std::uint8_t> output(packing.get_query_size());
+
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t ct_i = 0; ct_i < num_ciphertexts; ++ct_i) {
+    const auto block_l_i = ct_i / num_blocks_m;
+    const auto block_m_i = ct_i % num_blocks_m;
+    auto* ct_output = output.data() + ct_i * ciphertext_size;
+    const auto seed = random_vector<std::uint8_t>(seed_size);
+    std::copy(std::begin(seed), std::end(seed), ct_output);
+    const auto a = expand_seed(seed.data());
+
+    // c_0 = Delta A^ + e - a s
+    Poly c0 = sample_noise(num_moduli);
+    for (std::size_t i = 0; i < packing.block_l_; ++i) {
+      const auto row = block_l_i * packing.block_l_ + i;
+      if (row >= packing.dim_l_) {
+        break;
+      }
+      for (std::size_t j = 0; j < packing.block_m_; ++j) {
+        const auto column = block_m_i * packing.block_m_ + j;
+        if (column >= packing.dim_m_) {
+          break;
+        }
+        const auto value = to_signed(matrix_A[row * packing.dim_m_ + column]);
+        const auto position = i * packing.block_m_ * packing.block_n_ + j;
+        for (std::size_t k = 0; k < num_moduli; ++k) {
+          const u64 q = moduli[k];
+          auto& coefficient = c0[k * poly_degree + position];
+          coefficient = add_mod(coefficient, mul_mod(delta[k], reduce_signed(value, q), q), q);
+        }
+      }
+    }
+    ntt_forward(c0, num_moduli);
+    for (std::size_t k = 0; k < num_moduli; ++k) {
+      const u64 q = moduli[k];
+      for (std::size_t j = k * poly_degree; j < (k + 1) * poly_degree; ++j) {
+        c0[j] = sub_mod(c0[j], mul_mod(a[j], keys_->secret_key[j], q), q);
+      }
+    }
+    pack_values(c0.data(), num_moduli * poly_degree, ct_output + seed_size);
+  }
+  return output;
+}
+
+template std::vector<std::uint8_t> MatrixProductClient::encrypt(const MatrixPacking&,
+                                                                const std::uint8_t*) const;
+template std::vector<std::uint8_t> MatrixProductClient::encrypt(const MatrixPacking&,
+                                                                const std::uint16_t*) const;
+template std::vector<std::uint8_t> MatrixProductClient::encrypt(const MatrixPacking&,
+                                                                const std::uint32_t*) const;
+
+template <typename T>
+void MatrixProductClient::decrypt(const MatrixPacking& packing, const std::uint8_t* response,
+                                  std::size_t response_size, T* output) const {
+  check_packing(packing, ENCRYPTO::bit_size_v<T>);
+  if (response_size != packing.get_response_size()) {
+    throw std::invalid_argument(fmt::format("LinearHE: response has size {}, expected {}",
+                                            response_size, packing.get_response_size()));
+  }
+  const auto& context = get_context();
+  const u128 q0 = moduli[0];
+  const u128 q1 = moduli[1];
+  const u128 q = q0 * q1;
+  const std::size_t bit_size = packing.bit_size_;
+  const auto num_blocks_n = packing.get_num_blocks_n();
+  const auto num_ciphertexts = packing.get_num_response_ciphertexts();
+  const auto ciphertext_size = response_size / num_ciphertexts;
+  const auto num_positions = packing.block_l_ * packing.block_n_;
+  bool malformed = false;
+
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t ct_i = 0; ct_i < num_ciphertexts; ++ct_i) {
+    const auto block_l_i = ct_i / num_blocks_n;
+    const auto block_n_i = ct_i % num_blocks_n;
+    const auto* input = response + ct_i * ciphertext_size;
+    Poly c1(num_response_moduli * poly_degree);
+    std::vector<u64> c0(num_response_moduli * num_positions);
+    bool valid = true;
+    for (std::size_t k = 0; k < num_response_moduli && valid; ++k) {
+      input = unpack_values(input, poly_degree, moduli[k], c1.data() + k * poly_degree);
+      valid = input != nullptr;
+    }
+    for (std::size_t k = 0; k < num_response_moduli && valid; ++k) {
+      input = unpack_values(input, num_positions, moduli[k], c0.data() + k * num_positions);
+      valid = input != nullptr;
+    }
+    if (!valid) {
+#pragma omp atomic write
+      malformed = true;
+      continue;
+    }
+    // c_1 s
+    ntt_forward(c1, num_response_moduli);
+    multiply_pointwise(c1, keys_->secret_key, c1, num_response_moduli);
+    ntt_inverse(c1, num_response_moduli);
+
+    for (std::size_t i = 0; i < packing.block_l_; ++i) {
+      const auto row = block_l_i * packing.block_l_ + i;
+      if (row >= packing.dim_l_) {
+        break;
+      }
+      for (std::size_t k = 0; k < packing.block_n_; ++k) {
+        const auto column = block_n_i * packing.block_n_ + k;
+        if (column >= packing.dim_n_) {
+          break;
+        }
+        const auto index = i * packing.block_n_ + k;
+        const auto position =
+            i * packing.block_m_ * packing.block_n_ + k * packing.block_m_ + packing.block_m_ - 1;
+        const u64 x0 = add_mod(c0[index], c1[position], moduli[0]);
+        const u64 x1 = add_mod(c0[num_positions + index], c1[poly_degree + position], moduli[1]);
+        // CRT reconstruction of x in [0, q_0 q_1)
+        u128 x = mul_mod(x0, context.q1_inv_mod_q0, moduli[0]) * q1 +
+                 mul_mod(x1, context.q0_inv_mod_q1, moduli[1]) * q0;
+        if (x >= q) {
+          x -= q;
+        }
+        // round(t x / q) mod t via long division: floor(2 t x / q)
+        u128 quotient = 0;
+        for (std::size_t b = 0; b <= bit_size; ++b) {
+          x <<= 1;
+          quotient <<= 1;
+          if (x >= q) {
+            x -= q;
+            quotient |= 1;
+          }
+        }
+        output[row * packing.dim_n_ + column] = static_cast<T>((quotient + 1) >> 1);
+      }
+    }
+  }
+  if (malformed) {
+    throw std::invalid_argument("LinearHE: malformed response");
+  }
+}
+
+template void MatrixProductClient::decrypt(const MatrixPacking&, const std::uint8_t*, std::size_t,
+                                           std::uint8_t*) const;
+template void MatrixProductClient::decrypt(const MatrixPacking&, const std::uint8_t*, std::size_t,
+                                           std::uint16_t*) const;
+template void MatrixProductClient::decrypt(const MatrixPacking&, const std::uint8_t*, std::size_t,
+                                           std::uint32_t*) const;
+
+// ---------- MatrixProductServer ----------
+
+struct MatrixProductServer::PublicKey {
+  Poly a;  // in NTT form
+  Poly b;  // in NTT form
+};
+
+MatrixProductServer::MatrixProductServer(const std::uint8_t* public_key,
+                                         std::size_t public_key_size)
+    : public_key_(std::make_unique<PublicKey>()) {
+  if (public_key_size != get_public_key_size()) {
+    throw std::invalid_argument(fmt::format("LinearHE: public key has size {}, expected {}",
+                                            public_key_size, get_public_key_size()));
+  }
+  public_key_->a = expand_seed(public_key);
+  public_key_->b.resize(num_moduli * poly_degree);
+  const auto* input = public_key + seed_size;
+  for (std::size_t k = 0; k < num_moduli && input != nullptr; ++k) {
+    input = unpack_values(input, poly_degree, moduli[k], public_key_->b.data() + k * poly_degree);
+  }
+  if (input == nullptr) {
+    throw std::invalid_argument("LinearHE: malformed public key");
+  }
+}
+
+MatrixProductServer::~MatrixProductServer() = default;
+
+template <typename T>
+std::vector<std::uint8_t> MatrixProductServer::multiply(const MatrixPacking& packing,
+                                                        const std::uint8_t* query,
+                                                        std::size_t query_size,
+                                                        const T* matrix_B, T* mask_output) const {
+  check_packing(packing, ENCRYPTO::bit_size_v<T>);
+  if (query_size != packing.get_query_size()) {
+    throw std::invalid_argument(fmt::format("LinearHE: query has size {}, expected {}", query_size,
+                                            packing.get_query_size()));
+  }
+  const std::size_t bit_size = packing.bit_size_;
+  const u64 t = u64(1) << bit_size;
+  const auto delta = compute_delta(bit_size);
+  const auto num_blocks_l = packing.get_num_blocks_l();
+  const auto num_blocks_m = packing.get_num_blocks_m();
+  const auto num_blocks_n = packing.get_num_blocks_n();
+  const auto flooding_bit_size = get_flooding_bit_size(bit_size, num_blocks_m);
+  const auto num_positions = packing.block_l_ * packing.block_n_;
+
+  // parse the query
+  const auto num_query_ciphertexts = packing.get_num_query_ciphertexts();
+  const auto query_ciphertext_size = query_size / num_query_ciphertexts;
+  std::vector<Poly> query_c0(num_query_ciphertexts);
+  std::vector<Poly> query_c1(num_query_ciphertexts);
+  bool malformed = false;
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t ct_i = 0; ct_i < num_query_ciphertexts; ++ct_i) {
+    const auto* input = query + ct_i * query_ciphertext_size;
+    query_c1[ct_i] = expand_seed(input);
+    input += seed_size;
+    query_c0[ct_i].resize(num_moduli * poly_degree);
+    for (std::size_t k = 0; k < num_moduli && input != nullptr; ++k) {
+      input = unpack_values(input, poly_degree, moduli[k], query_c0[ct_i].data() + k * poly_degree);
+    }
+    if (input == nullptr) {
+#pragma omp atomic write
+      malformed = true;
+    }
+  }
+  if (malformed) {
+    throw std::invalid_argument("LinearHE: malformed query");
+  }
+
+  const auto response_ciphertext_size = packing.get_response_size() / (num_blocks_l * num_blocks_n);
+  std::vector<std::uint8_t> output(packing.get_response_size());
+
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t block_n_i = 0; block_n_i < num_blocks_n; ++block_n_i) {
+    // encode the blocks of this column of B, with Shoup's precomputation
+    // since each of them is multiplied with num_blocks_l ciphertexts
+    std::vector<Poly> plaintexts(num_blocks_m);
+    std::vector<Poly> plaintexts_shoup(num_blocks_m);
+    for (std::size_t block_m_i = 0; block_m_i < num_blocks_m; ++block_m_i) {
+      auto& plaintext = plaintexts[block_m_i];
+      plaintext.resize(num_moduli * poly_degree);
+      for (std::size_t j = 0; j < packing.block_m_; ++j) {
+        const auto row = block_m_i * packing.block_m_ + j;
+        if (row >= packing.dim_m_) {
+          break;
+        }
+        for (std::size_t k = 0; k < packing.block_n_; ++k) {
+          const auto column = block_n_i * packing.block_n_ + k;
+          if (column >= packing.dim_n_) {
+            break;
+          }
+          const auto value = to_signed(matrix_B[row * packing.dim_n_ + column]);
+          const auto position = k * packing.block_m_ + packing.block_m_ - 1 - j;
+          for (std::size_t r = 0; r < num_moduli; ++r) {
+            plaintext[r * poly_degree + position] = reduce_signed(value, moduli[r]);
+          }
+        }
+      }
+      ntt_forward(plaintext, num_moduli);
+      auto& plaintext_shoup = plaintexts_shoup[block_m_i];
+      plaintext_shoup.resize(num_moduli * poly_degree);
+      for (std::size_t r = 0; r < num_moduli; ++r) {
+        for (std::size_t j = r * poly_degree; j < (r + 1) * poly_degree; ++j) {
+          plaintext_shoup[j] = shoup(plaintext[j], moduli[r]);
+        }
+      }
+    }
+
+    for (std::size_t block_l_i = 0; block_l_i < num_blocks_l; ++block_l_i) {
+      // re-randomization with an encryption of zero: (b u + e_1, a u + e_2)
+      Poly u = sample_ternary(num_moduli);
+      ntt_forward(u, num_moduli);
+      Poly c0(num_moduli * poly_degree);
+      Poly c1(num_moduli * poly_degree);
+      multiply_pointwise(public_key_->b, u, c0, num_moduli);
+      multiply_pointwise(public_key_->a, u, c1, num_moduli);
+      for (std::size_t block_m_i = 0; block_m_i < num_blocks_m; ++block_m_i) {
+        const auto& ct_c0 = query_c0[block_l_i * num_blocks_m + block_m_i];
+        const auto& ct_c1 = query_c1[block_l_i * num_blocks_m + block_m_i];
+        const auto& plaintext = plaintexts[block_m_i];
+        const auto& plaintext_shoup = plaintexts_shoup[block_m_i];
+        for (std::size_t r = 0; r < num_moduli; ++r) {
+          const u64 q = moduli[r];
+          for (std::size_t j = r * poly_degree; j < (r + 1) * poly_degree; ++j) {
+            c0[j] = add_mod(c0[j], mul_mod_shoup(ct_c0[j], plaintext[j], plaintext_shoup[j], q), q);
+            c1[j] = add_mod(c1[j], mul_mod_shoup(ct_c1[j], plaintext[j], plaintext_shoup[j], q), q);
+          }
+        }
+      }
+      ntt_inverse(c0, num_moduli);
+      ntt_inverse(c1, num_moduli);
+      const auto e1 = sample_noise(num_moduli);
+      const auto e2 = sample_noise(num_moduli);
+      for (std::size_t r = 0; r < num_moduli; ++r) {
+        const u64 q = moduli[r];
+        for (std::size_t j = r * poly_degree; j < (r + 1) * poly_degree; ++j) {
+          c0[j] = add_mod(c0[j], e1[j], q);
+          c1[j] = add_mod(c1[j], e2[j], q);
+        }
+      }
+
+      // subtract the mask and flood the noise of the coefficients which are
+      // sent, collect them in a separate buffer
+      const auto masks = random_vector<u64>(num_positions);
+      const auto floods = random_vector<u128>(num_positions);
+      const u128 flooding_mask = (u128(1) << (flooding_bit_size + 1)) - 1;
+      const i128 flooding_offset = i128(1) << flooding_bit_size;
+      std::vector<u64> selected_c0(num_moduli * num_positions);
+      for (std::size_t i = 0; i < packing.block_l_; ++i) {
+        for (std::size_t k = 0; k < packing.block_n_; ++k) {
+          const auto index = i * packing.block_n_ + k;
+          const auto position =
+              i * packing.block_m_ * packing.block_n_ + k * packing.block_m_ + packing.block_m_ - 1;
+          const u64 mask = masks[index] & (t - 1);
+          const auto row = block_l_i * packing.block_l_ + i;
+          const auto column = block_n_i * packing.block_n_ + k;
+          if (row < packing.dim_l_ && column < packing.dim_n_) {
+            mask_output[row * packing.dim_n_ + column] = static_cast<T>(mask);
+          }
+          const i128 flood = static_cast<i128>(floods[index] & flooding_mask) - flooding_offset;
+          for (std::size_t r = 0; r < num_moduli; ++r) {
+            const u64 q = moduli[r];
+            const u64 masked = mul_mod(delta[r], (t - mask) & (t - 1), q);
+            selected_c0[r * num_positions + index] = add_mod(
+                add_mod(c0[r * poly_degree + position], masked, q), reduce_signed(flood, q), q);
+          }
+        }
+      }
+
+      // switch to the first two moduli
+      for (std::size_t num = num_moduli; num > num_response_moduli; --num) {
+        drop_last_modulus(c1.data(), poly_degree, poly_degree, num);
+        drop_last_modulus(selected_c0.data(), num_positions, num_positions, num);
+      }
+
+      auto* ct_output =
+          output.data() + (block_l_i * num_blocks_n + block_n_i) * response_ciphertext_size;
+      ct_output = pack_values(c1.data(), num_response_moduli * poly_degree, ct_output);
+      for (std::size_t r = 0; r < num_response_moduli; ++r) {
+        ct_output = pack_values(selected_c0.data() + r * num_positions, num_positions, ct_output);
+      }
+    }
+  }
+  return output;
+}
+
+template std::vector<std::uint8_t> MatrixProductServer::multiply(const MatrixPacking&,
+                                                                 const std::uint8_t*, std::size_t,
+                                                                 const std::uint8_t*,
+                                                                 std::uint8_t*) const;
+template std::vector<std::uint8_t> MatrixProductServer::multiply(const MatrixPacking&,
+                                                                 const std::uint8_t*, std::size_t,
+                                                                 const std::uint16_t*,
+                                                                 std::uint16_t*) const;
+template std::vector<std::uint8_t> MatrixProductServer::multiply(const MatrixPacking&,
+                                                                 const std::uint8_t*, std::size_t,
+                                                                 const std::uint32_t*,
+                                                                 std::uint32_t*) const;
+
+}  // namespace MOTION::LinearHE
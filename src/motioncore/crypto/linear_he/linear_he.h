@@ -0,0 +1,155 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace MOTION::LinearHE {
+
+// Packed linear homomorphic encryption for matrix products
+//
+// A BFV-style RLWE scheme over Z_Q[X]/(X^N + 1) with N = 8192 and Q the
+// product of four 54 bit NTT-friendly primes (log Q = 216, which provides 128
+// bit security according to the HomomorphicEncryption.org standard).  The
+// plaintext modulus is t = 2^l for l <= 32.  Only what is required for
+// ciphertext-plaintext matrix products is implemented:
+//
+// - The client encrypts its matrix A (l x m) with its secret key.  The random
+//   part of these ciphertexts is expanded from a seed, so only half of each
+//   ciphertext is sent.
+// - The server multiplies the ciphertexts with its plaintext matrix B (m x n),
+//   subtracts a random mask R, re-randomizes the result with an encryption of
+//   zero under the client's public key, floods the noise (40 bit statistical
+//   security), and switches down to two of the primes.
+// - The client decrypts A * B - R.
+//
+// The matrices are packed into the coefficients of the polynomials (cf.
+// Cheetah, https://eprint.iacr.org/2022/207): a block of A (l_w x m_w) and a
+// block of B (m_w x n_w) are encoded as
+//
+//   A^(X) = sum_{i,j} A[i,j] X^(i m_w n_w + j),
+//   B^(X) = sum_{j,k} B[j,k] X^(k m_w + m_w - 1 - j),
+//
+// such that the coefficient of X^(i m_w n_w + k m_w + m_w - 1) of A^ * B^ is
+// the entry (i, k) of the block product if l_w m_w n_w + m_w - 1 <= N.  Hence,
+// no rotations (and no Galois keys) are needed, and the server only returns
+// the coefficients of the result which contain entries of the product.
+
+constexpr std::size_t poly_degree = 8192;
+constexpr std::size_t max_bit_size = 32;
+constexpr std::size_t statistical_security = 40;
+
+// Partition of a matrix product into blocks which fit into one polynomial
+struct MatrixPacking {
+  std::size_t dim_l_;
+  std::size_t dim_m_;
+  std::size_t dim_n_;
+  std::size_t bit_size_;
+  std::size_t block_l_;
+  std::size_t block_m_;
+  std::size_t block_n_;
+
+  // Check if products of these dimensions over Z_{2^bit_size} are supported.
+  static bool is_supported(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n,
+                           std::size_t bit_size) noexcept;
+  // Choose the block sizes such that the communication is minimized.  Throws
+  // std::invalid_argument if the product is not supported.
+  static MatrixPacking compute(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n,
+                               std::size_t bit_size);
+
+  std::size_t get_num_blocks_l() const noexcept { return (dim_l_ + block_l_ - 1) / block_l_; }
+  std::size_t get_num_blocks_m() const noexcept { return (dim_m_ + block_m_ - 1) / block_m_; }
+  std::size_t get_num_blocks_n() const noexcept { return (dim_n_ + block_n_ - 1) / block_n_; }
+  std::size_t get_num_query_ciphertexts() const noexcept {
+    return get_num_blocks_l() * get_num_blocks_m();
+  }
+  std::size_t get_num_response_ciphertexts() const noexcept {
+    return get_num_blocks_l() * get_num_blocks_n();
+  }
+  // number of ciphertext-plaintext products computed by the server
+  std::size_t get_num_products() const noexcept {
+    return get_num_blocks_l() * get_num_blocks_m() * get_num_blocks_n();
+  }
+  // sizes of the messages in bytes
+  std::size_t get_query_size() const noexcept;
+  std::size_t get_response_size() const noexcept;
+};
+
+// size of a serialized public key in bytes
+std::size_t get_public_key_size() noexcept;
+
+// Holds a secret key and encrypts the left factor of matrix products.
+class MatrixProductClient {
+ public:
+  // sample a fresh key pair
+  MatrixProductClient();
+  ~MatrixProductClient();
+
+  MatrixProductClient(const MatrixProductClient&) = delete;
+  MatrixProductClient& operator=(const MatrixProductClient&) = delete;
+
+  std::vector<std::uint8_t> get_public_key() const;
+
+  // encrypt the matrix A (dim_l x dim_m, row-major)
+  template <typename T>
+  std::vector<std::uint8_t> encrypt(const MatrixPacking&, const T* matrix_A) const;
+
+  // decrypt a response into A * B - R (dim_l x dim_n, row-major)
+  template <typename T>
+  void decrypt(const MatrixPacking&, const std::uint8_t* response, std::size_t response_size,
+               T* output) const;
+
+ private:
+  struct Keys;
+  std::unique_ptr<Keys> keys_;
+};
+
+// Multiplies encrypted matrices with plaintext matrices.
+class MatrixProductServer {
+ public:
+  // throws std::invalid_argument if the public key is malformed
+  MatrixProductServer(const std::uint8_t* public_key, std::size_t public_key_size);
+  ~MatrixProductServer();
+
+  MatrixProductServer(const MatrixProductServer&) = delete;
+  MatrixProductServer& operator=(const MatrixProductServer&) = delete;
+
+  // Compute the response to a query with the matrix B (dim_m x dim_n,
+  // row-major).  The random mask R (dim_l x dim_n, row-major) is written to
+  // mask_output, i.e., the results of the server and the client are additive
+  // shares of A * B.  Throws std::invalid_argument if the query is malformed.
+  template <typename T>
+  std::vector<std::uint8_t> multiply(const MatrixPacking&, const std::uint8_t* query,
+                                     std::size_t query_size, const T* matrix_B,
+                                     T* mask_output) const;
+
+ private:
+  struct PublicKey;
+  std::unique_ptr<PublicKey> public_key_;
+};
+
+}  // namespace MOTION::LinearHE
@@ -24,14 +24,21 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <stdexcept>
 #include <type_traits>
 
 #include <fmt/format.h>
+#include <unsupported/Eigen/CXX11/Tensor>
 
+#include "communication/communication_layer.h"
+#include "communication/compact_message.h"
+#include "communication/message_handler.h"
 #include "crypto/arithmetic_provider.h"
+#include "crypto/linear_he/linear_he.h"
 #include "crypto/oblivious_transfer/ot_flavors.h"
 #include "crypto/oblivious_transfer/ot_provider.h"
+#include "crypto/trusted_dealer.h"
 #include "statistics/run_time_stats.h"
 #include "tensor/tensor_op.h"
 #include "utility/bit_vector.h"
@@ -124,6 +131,18 @@ template <typename T>
 std::size_t LinAlgTripleProvider::register_for_conv2d_triple(const tensor::Conv2DOp& conv_op) {
   assert(conv_op.verify());
 
+  if (conv_op.group_ > 1) {
+    // the triple of a grouped convolution is the concatenation of independent
+    // triples of the dense convolutions of its groups, so we register these
+    // consecutively and return the index of the first one
+    const auto group_op = conv_op.get_group_op();
+    const auto index = register_for_conv2d_triple<T>(group_op);
+    for (std::size_t group_i = 1; group_i < conv_op.group_; ++group_i) {
+      register_for_conv2d_triple<T>(group_op);
+    }
+    return index;
+  }
+
   const auto record_request = [&conv_op](auto& count_map, auto& triple_map) -> std::size_t {
     auto [it, inserted] = count_map.try_emplace(conv_op, 1);
     triple_map.try_emplace(conv_op, std::vector<LinAlgTriple<T>>{});
@@ -164,6 +183,22 @@ template <typename T>
 LinAlgTripleProvider::LinAlgTriple<T> LinAlgTripleProvider::get_conv2d_triple(
     const tensor::Conv2DOp& conv_op, std::size_t index) {
   assert(conv_op.verify());
+
+  if (conv_op.group_ > 1) {
+    const auto group_op = conv_op.get_group_op();
+    LinAlgTriple<T> triple;
+    triple.a_.reserve(conv_op.compute_input_size());
+    triple.b_.reserve(conv_op.compute_kernel_size());
+    triple.c_.reserve(conv_op.compute_output_size());
+    for (std::size_t group_i = 0; group_i < conv_op.group_; ++group_i) {
+      auto group_triple = get_conv2d_triple<T>(group_op, index + group_i);
+      triple.a_.insert(std::end(triple.a_), std::begin(group_triple.a_), std::end(group_triple.a_));
+      triple.b_.insert(std::end(triple.b_), std::begin(group_triple.b_), std::end(group_triple.b_));
+      triple.c_.insert(std::end(triple.c_), std::begin(group_triple.c_), std::end(group_triple.c_));
+    }
+    return triple;
+  }
+
   wait_setup();
 
   const auto get_triple = [&conv_op, index](auto& triple_map) -> LinAlgTriple<T> {
@@ -246,9 +281,16 @@ void LinAlgTriplesFromAP::setup() {
   }
   run_time_stats_.record_start<Statistics::RunTimeStats::StatID::linalgtriple_setup>();
 
+  setup_hook();
+
   const auto run_setup_gemm_1 = [](const auto& count_map, auto& handle_map, auto& triple_map) {
     for (const auto& [gemm_op, count] : count_map) {
-      auto& handle_vec = handle_map.at(gemm_op);
+      auto handle_it = handle_map.find(gemm_op);
+      if (handle_it == std::end(handle_map)) {
+        // generated by setup_hook()
+        continue;
+      }
+      auto& handle_vec = handle_it->second;
       auto& triple_vec = triple_map.at(gemm_op);
       assert(handle_vec.size() == count);
       triple_vec.reserve(count);
@@ -269,19 +311,23 @@ void LinAlgTriplesFromAP::setup() {
 
   const auto run_setup_gemm_2 = [](const auto& count_map, auto& handle_map, auto& triple_map) {
     for (const auto& [gemm_op, count] : count_map) {
-      auto& handle_vec = handle_map.at(gemm_op);
+      auto handle_it = handle_map.find(gemm_op);
+      if (handle_it == std::end(handle_map)) {
+        // generated by setup_hook()
+        continue;
+      }
+      auto& handle_vec = handle_it->second;
       auto& triple_vec = triple_map.at(gemm_op);
       assert(handle_vec.size() == count);
       assert(triple_vec.size() == count);
       for (std::size_t i = 0; i < count; ++i) {
         auto& triple = triple_vec.at(i);
         auto& [handle_input, handle_kernel] = handle_vec.at(i);
-        handle_input->compute_output();
+        compute_matrix_multiplication_outputs(*handle_input, *handle_kernel);
         const auto gemm1_output = handle_input->get_output();
         assert(gemm1_output.size() == gemm_op.compute_output_size());
         std::transform(std::begin(triple.c_), std::end(triple.c_), std::begin(gemm1_output),
                        std::begin(triple.c_), std::plus{});
-        handle_kernel->compute_output();
         const auto gemm2_output = handle_kernel->get_output();
         assert(gemm1_output.size() == gemm_op.compute_output_size());
         std::transform(std::begin(triple.c_), std::end(triple.c_), std::begin(gemm2_output),
@@ -292,7 +338,12 @@ void LinAlgTriplesFromAP::setup() {
 
   const auto run_setup_conv_1 = [](const auto& count_map, auto& handle_map, auto& triple_map) {
     for (const auto& [conv_op, count] : count_map) {
-      auto& handle_vec = handle_map.at(conv_op);
+      auto handle_it = handle_map.find(conv_op);
+      if (handle_it == std::end(handle_map)) {
+        // generated by setup_hook()
+        continue;
+      }
+      auto& handle_vec = handle_it->second;
       auto& triple_vec = triple_map.at(conv_op);
       assert(handle_vec.size() == count);
       assert(triple_vec.size() == 0);
@@ -312,18 +363,22 @@ void LinAlgTriplesFromAP::setup() {
 
   const auto run_setup_conv_2 = [](const auto& count_map, auto& handle_map, auto& triple_map) {
     for (const auto& [conv_op, count] : count_map) {
-      auto& handle_vec = handle_map.at(conv_op);
+      auto handle_it = handle_map.find(conv_op);
+      if (handle_it == std::end(handle_map)) {
+        // generated by setup_hook()
+        continue;
+      }
+      auto& handle_vec = handle_it->second;
       auto& triple_vec = triple_map.at(conv_op);
       assert(handle_vec.size() == count);
       assert(triple_vec.size() == count);
       for (std::size_t i = 0; i < count; ++i) {
         auto& triple = triple_vec.at(i);
         auto& [handle_input, handle_kernel] = handle_vec.at(i);
-        handle_input->compute_output();
+        compute_convolution_outputs(*handle_kernel, *handle_input);
         const auto conv1_output = handle_input->get_output();
         std::transform(std::begin(triple.c_), std::end(triple.c_), std::begin(conv1_output),
                        std::begin(triple.c_), std::plus{});
-        handle_kernel->compute_output();
         const auto conv2_output = handle_kernel->get_output();
         std::transform(std::begin(triple.c_), std::end(triple.c_), std::begin(conv2_output),
                        std::begin(triple.c_), std::plus{});
@@ -494,6 +549,352 @@ void LinAlgTriplesFromAP::registration_hook_boolean(std::size_t num_triples, std
   it->second.emplace_back(std::move(pair));
 }
 
+// ---------- LinAlgTriplesFromHE ----------
+
+namespace {
+
+// kinds of LinAlgHE messages (stored as msg_num in the compact message)
+constexpr std::uint64_t he_message_public_key = 0;
+constexpr std::uint64_t he_message_query = 1;
+constexpr std::uint64_t he_message_response = 2;
+
+std::size_t get_left_size(const tensor::GemmOp& gemm_op) { return gemm_op.compute_input_A_size(); }
+
+std::size_t get_left_size(const tensor::Conv2DOp& conv_op) {
+  return conv_op.compute_input_size();
+}
+
+std::size_t get_right_size(const tensor::GemmOp& gemm_op) {
+  return gemm_op.compute_input_B_size();
+}
+
+std::size_t get_right_size(const tensor::Conv2DOp& conv_op) {
+  return conv_op.compute_kernel_size();
+}
+
+template <typename T>
+std::vector<T> compute_product(const tensor::GemmOp& gemm_op, const std::vector<T>& a,
+                               const std::vector<T>& b) {
+  return matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                         gemm_op.output_shape_[1], a, b);
+}
+
+template <typename T>
+std::vector<T> compute_product(const tensor::Conv2DOp& conv_op, const std::vector<T>& a,
+                               const std::vector<T>& b) {
+  return convolution(conv_op, a, b);
+}
+
+// A convolution is computed as the product of the transposed input matrix
+// (one image patch per row) with the transposed kernel matrix (cf.
+// ConvolutionInputSide and ConvolutionKernelSide), such that the party
+// holding the input encrypts.
+
+template <typename T>
+std::vector<T> get_left_matrix(const tensor::GemmOp&, const std::vector<T>& a) {
+  return a;
+}
+
+template <typename T>
+std::vector<T> get_left_matrix(const tensor::Conv2DOp& conv_op, const std::vector<T>& input) {
+  const auto matrix_shape = conv_op.compute_input_matrix_shape();
+  std::vector<T> output(matrix_shape.first * matrix_shape.second);
+  using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
+  using CTensorType3 = Eigen::Tensor<const T, 3, Eigen::RowMajor>;
+  Eigen::TensorMap<CTensorType3> input_tensor(input.data(), conv_op.input_shape_[0],
+                                              conv_op.input_shape_[1], conv_op.input_shape_[2]);
+  Eigen::TensorMap<TensorType2> output_matrix(output.data(), matrix_shape.second,
+                                              matrix_shape.first);
+  output_matrix =
+      input_tensor.shuffle(Eigen::array<Eigen::Index, 3>{2, 1, 0})
+          .extract_image_patches(conv_op.kernel_shape_[2], conv_op.kernel_shape_[3],
+                                 conv_op.strides_[0], conv_op.strides_[1], conv_op.dilations_[0],
+                                 conv_op.dilations_[1], 1, 1, conv_op.pads_[0], conv_op.pads_[2],
+                                 conv_op.pads_[1], conv_op.pads_[3], 0)
+          .reshape(Eigen::array<Eigen::Index, 2>{static_cast<Eigen::Index>(matrix_shape.second),
+                                                 static_cast<Eigen::Index>(matrix_shape.first)});
+  return output;
+}
+
+template <typename T>
+std::vector<T> get_right_matrix(const tensor::GemmOp&, const std::vector<T>& b) {
+  return b;
+}
+
+template <typename T>
+std::vector<T> get_right_matrix(const tensor::Conv2DOp& conv_op, const std::vector<T>& kernel) {
+  const auto matrix_shape = conv_op.compute_kernel_matrix_shape();
+  std::vector<T> output(matrix_shape.first * matrix_shape.second);
+  using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
+  using CTensorType4 = Eigen::Tensor<const T, 4, Eigen::RowMajor>;
+  Eigen::TensorMap<CTensorType4> kernel_tensor(kernel.data(), conv_op.kernel_shape_[0],
+                                               conv_op.kernel_shape_[1], conv_op.kernel_shape_[2],
+                                               conv_op.kernel_shape_[3]);
+  Eigen::TensorMap<TensorType2> output_matrix(output.data(), matrix_shape.second,
+                                              matrix_shape.first);
+  output_matrix =
+      kernel_tensor.shuffle(std::array<Eigen::Index, 4>{3, 2, 1, 0})
+          .reshape(std::array<Eigen::Index, 2>{static_cast<Eigen::Index>(matrix_shape.second),
+                                               static_cast<Eigen::Index>(matrix_shape.first)});
+  return output;
+}
+
+// add a share of the matrix product to the share of c
+template <typename T>
+void add_product_share(const tensor::GemmOp&, std::vector<T>& c, const std::vector<T>& share) {
+  std::transform(std::begin(c), std::end(c), std::begin(share), std::begin(c), std::plus{});
+}
+
+template <typename T>
+void add_product_share(const tensor::Conv2DOp& conv_op, std::vector<T>& c,
+                       const std::vector<T>& share) {
+  // the share is the transposed output matrix
+  const auto matrix_shape = conv_op.compute_output_matrix_shape();
+  std::vector<T> output(conv_op.compute_output_size());
+  using CTensorType2 = Eigen::Tensor<const T, 2, Eigen::RowMajor>;
+  using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
+  Eigen::TensorMap<CTensorType2> output_matrix(share.data(), matrix_shape.second,
+                                               matrix_shape.first);
+  Eigen::TensorMap<TensorType3> output_tensor(output.data(), conv_op.output_shape_[0],
+                                              conv_op.output_shape_[1], conv_op.output_shape_[2]);
+  const std::array<Eigen::Index, 3> rev_output_dimensions = {
+      static_cast<Eigen::Index>(conv_op.output_shape_[2]),
+      static_cast<Eigen::Index>(conv_op.output_shape_[1]),
+      static_cast<Eigen::Index>(conv_op.output_shape_[0])};
+  output_tensor =
+      output_matrix.reshape(rev_output_dimensions).shuffle(Eigen::array<Eigen::Index, 3>{2, 1, 0});
+  std::transform(std::begin(c), std::end(c), std::begin(output), std::begin(c), std::plus{});
+}
+
+}  // namespace
+
+LinAlgTriplesFromHE::LinAlgTriplesFromHE(Communication::CommunicationLayer& comm_layer,
+                                         ArithmeticProvider& arith_provider,
+                                         ENCRYPTO::ObliviousTransfer::OTProvider& ot_provider,
+                                         Statistics::RunTimeStats& run_time_stats,
+                                         std::shared_ptr<Logger> logger,
+                                         const LinAlgHEConfig& config)
+    : LinAlgTriplesFromAP(arith_provider, ot_provider, run_time_stats, logger),
+      comm_layer_(comm_layer),
+      peer_id_(1 - comm_layer_.get_my_id()),
+      config_(config),
+      logger_(logger),
+      message_handler_(std::make_shared<Communication::QueueHandler>()) {
+  if (comm_layer_.get_num_parties() != 2) {
+    throw std::invalid_argument("LinAlgTriplesFromHE supports only two parties");
+  }
+  comm_layer_.register_message_handler([this](std::size_t) { return message_handler_; },
+                                       {Communication::MessageType::LinAlgHE});
+}
+
+LinAlgTriplesFromHE::~LinAlgTriplesFromHE() {
+  comm_layer_.deregister_message_handler({Communication::MessageType::LinAlgHE});
+}
+
+std::array<std::size_t, 3> LinAlgTriplesFromHE::get_matrix_dimensions(
+    const tensor::GemmOp& gemm_op) {
+  return {gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1], gemm_op.output_shape_[1]};
+}
+
+std::array<std::size_t, 3> LinAlgTriplesFromHE::get_matrix_dimensions(
+    const tensor::Conv2DOp& conv_op) {
+  const auto kernel_matrix_shape = conv_op.compute_kernel_matrix_shape();
+  const auto output_matrix_shape = conv_op.compute_output_matrix_shape();
+  return {output_matrix_shape.second, kernel_matrix_shape.second, kernel_matrix_shape.first};
+}
+
+std::optional<LinAlgCostEstimate> LinAlgTriplesFromHE::estimate_he_cost(
+    const std::array<std::size_t, 3>& dims, std::size_t bit_size, const LinAlgHEConfig& config) {
+  if (!LinearHE::MatrixPacking::is_supported(dims[0], dims[1], dims[2], bit_size)) {
+    return std::nullopt;
+  }
+  const auto packing = LinearHE::MatrixPacking::compute(dims[0], dims[1], dims[2], bit_size);
+  // each party sends a query and a response (the public keys are not counted)
+  const auto bytes = 2 * (packing.get_query_size() + packing.get_response_size());
+  const auto num_ciphertexts =
+      2 * (packing.get_num_query_ciphertexts() + packing.get_num_response_ciphertexts());
+  const auto seconds = bytes / config.bandwidth +
+                       2 * packing.get_num_products() * config.seconds_per_he_product +
+                       num_ciphertexts * config.seconds_per_he_ciphertext;
+  return LinAlgCostEstimate{bytes, seconds};
+}
+
+LinAlgCostEstimate LinAlgTriplesFromHE::estimate_ot_cost(const std::array<std::size_t, 3>& dims,
+                                                         std::size_t bit_size,
+                                                         const LinAlgHEConfig& config) {
+  // l * m * bit_size correlated OTs of vectors of length n in both directions,
+  // the receiver sends 128 bit per OT
+  const auto num_ots = 2 * dims[0] * dims[1] * bit_size;
+  const auto message_bytes = num_ots * dims[2] * bit_size / 8;
+  const auto bytes = num_ots * 16 + message_bytes;
+  const auto seconds = bytes / config.bandwidth + num_ots * config.seconds_per_ot +
+                       message_bytes * config.seconds_per_ot_byte;
+  return {bytes, seconds};
+}
+
+bool LinAlgTriplesFromHE::use_he(const std::array<std::size_t, 3>& dims,
+                                 std::size_t bit_size) const {
+  switch (config_.selection) {
+    case LinAlgHEConfig::Selection::never:
+      return false;
+    case LinAlgHEConfig::Selection::always:
+      return LinearHE::MatrixPacking::is_supported(dims[0], dims[1], dims[2], bit_size);
+    case LinAlgHEConfig::Selection::cost_model: {
+      const auto he_cost = estimate_he_cost(dims, bit_size, config_);
+      return he_cost.has_value() &&
+             he_cost->seconds < estimate_ot_cost(dims, bit_size, config_).seconds;
+    }
+  }
+  return false;
+}
+
+void LinAlgTriplesFromHE::registration_hook(const tensor::GemmOp& gemm_op, std::size_t bit_size) {
+  if (use_he(get_matrix_dimensions(gemm_op), bit_size)) {
+    he_requests_.push_back({gemm_op, bit_size});
+  } else {
+    LinAlgTriplesFromAP::registration_hook(gemm_op, bit_size);
+  }
+}
+
+void LinAlgTriplesFromHE::registration_hook(const tensor::Conv2DOp& conv_op,
+                                            std::size_t bit_size) {
+  if (use_he(get_matrix_dimensions(conv_op), bit_size)) {
+    he_requests_.push_back({conv_op, bit_size});
+  } else {
+    LinAlgTriplesFromAP::registration_hook(conv_op, bit_size);
+  }
+}
+
+void LinAlgTriplesFromHE::send_message(std::uint64_t kind, std::uint64_t id,
+                                       const std::vector<std::uint8_t>& payload) {
+  comm_layer_.send_message(peer_id_,
+                           Communication::BuildCompactMessage(Communication::MessageType::LinAlgHE,
+                                                              id, kind, payload.data(),
+                                                              payload.size()));
+}
+
+std::vector<std::uint8_t> LinAlgTriplesFromHE::receive_message(std::uint64_t kind,
+                                                               std::uint64_t id) {
+  auto raw_message = message_handler_->get_queue().dequeue();
+  if (!raw_message.has_value()) {
+    throw std::runtime_error("LinAlgTriplesFromHE: message queue has been closed");
+  }
+  const auto message = Communication::ParseCompactMessage(raw_message->data(), raw_message->size());
+  if (!message.has_value() || message->message_type != Communication::MessageType::LinAlgHE ||
+      message->msg_num != kind || message->id != id) {
+    throw std::runtime_error(fmt::format(
+        "LinAlgTriplesFromHE: received unexpected message, expected kind {} with id {}", kind, id));
+  }
+  return std::move(*raw_message);
+}
+
+void LinAlgTriplesFromHE::setup_hook() {
+  if (he_requests_.empty()) {
+    return;
+  }
+  if constexpr (MOTION_DEBUG) {
+    if (logger_) {
+      logger_->LogDebug(
+          fmt::format("LinAlgTriplesFromHE::setup_hook: {} triples", he_requests_.size()));
+    }
+  }
+
+  // call f(op, T{}) with the type of the request
+  const auto visit_request = [](const HERequest& request, const auto& f) {
+    std::visit(
+        [&request, &f](const auto& op) {
+          switch (request.bit_size_) {
+            case 8:
+              return f(op, std::uint8_t{});
+            case 16:
+              return f(op, std::uint16_t{});
+            case 32:
+              return f(op, std::uint32_t{});
+            default:
+              throw std::logic_error("invalid bit size");
+          }
+        },
+        request.op_);
+  };
+  const auto get_triples = [this](const auto& op, auto dummy_arg) -> auto& {
+    using T = decltype(dummy_arg);
+    if constexpr (std::is_same_v<std::decay_t<decltype(op)>, tensor::GemmOp>) {
+      if constexpr (std::is_same_v<T, std::uint8_t>) {
+        return gemm_triples_8_.at(op);
+      } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+        return gemm_triples_16_.at(op);
+      } else {
+        return gemm_triples_32_.at(op);
+      }
+    } else {
+      if constexpr (std::is_same_v<T, std::uint8_t>) {
+        return conv2d_triples_8_.at(op);
+      } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+        return conv2d_triples_16_.at(op);
+      } else {
+        return conv2d_triples_32_.at(op);
+      }
+    }
+  };
+  constexpr auto header_size = Communication::compact_message_header_size;
+  const auto num_requests = he_requests_.size();
+  std::vector<std::size_t> triple_indices(num_requests);
+  std::vector<LinearHE::MatrixPacking> packings(num_requests);
+
+  // sample the triples and send our encrypted shares of a
+  const LinearHE::MatrixProductClient client;
+  send_message(he_message_public_key, 0, client.get_public_key());
+  for (std::size_t request_i = 0; request_i < num_requests; ++request_i) {
+    visit_request(he_requests_[request_i], [&](const auto& op, auto dummy_arg) {
+      using T = decltype(dummy_arg);
+      auto& triples = get_triples(op, dummy_arg);
+      triple_indices[request_i] = triples.size();
+      auto& triple = triples.emplace_back();
+      triple.a_ = Helpers::RandomVector<T>(get_left_size(op));
+      triple.b_ = Helpers::RandomVector<T>(get_right_size(op));
+      triple.c_ = compute_product(op, triple.a_, triple.b_);
+      const auto dims = get_matrix_dimensions(op);
+      packings[request_i] =
+          LinearHE::MatrixPacking::compute(dims[0], dims[1], dims[2], ENCRYPTO::bit_size_v<T>);
+      send_message(he_message_query, request_i,
+                   client.encrypt(packings[request_i], get_left_matrix(op, triple.a_).data()));
+    });
+  }
+
+  // multiply the other party's shares of a with our shares of b
+  const auto public_key = receive_message(he_message_public_key, 0);
+  const LinearHE::MatrixProductServer server(public_key.data() + header_size,
+                                             public_key.size() - header_size);
+  for (std::size_t request_i = 0; request_i < num_requests; ++request_i) {
+    visit_request(he_requests_[request_i], [&](const auto& op, auto dummy_arg) {
+      using T = decltype(dummy_arg);
+      auto& triple = get_triples(op, dummy_arg).at(triple_indices[request_i]);
+      const auto& packing = packings[request_i];
+      const auto query = receive_message(he_message_query, request_i);
+      std::vector<T> mask(packing.dim_l_ * packing.dim_n_);
+      send_message(he_message_response, request_i,
+                   server.multiply(packing, query.data() + header_size,
+                                   query.size() - header_size,
+                                   get_right_matrix(op, triple.b_).data(), mask.data()));
+      add_product_share(op, triple.c_, mask);
+    });
+  }
+
+  // decrypt the products of our shares of a with the other party's shares of b
+  for (std::size_t request_i = 0; request_i < num_requests; ++request_i) {
+    visit_request(he_requests_[request_i], [&](const auto& op, auto dummy_arg) {
+      using T = decltype(dummy_arg);
+      auto& triple = get_triples(op, dummy_arg).at(triple_indices[request_i]);
+      const auto& packing = packings[request_i];
+      const auto response = receive_message(he_message_response, request_i);
+      std::vector<T> product(packing.dim_l_ * packing.dim_n_);
+      client.decrypt(packing, response.data() + header_size, response.size() - header_size,
+                     product.data());
+      add_product_share(op, triple.c_, product);
+    });
+  }
+}
+
 // ---------- FakeLinAlgTripleProvider ----------
 
 void FakeLinAlgTripleProvider::setup() {
@@ -565,4 +966,83 @@ void FakeLinAlgTripleProvider::registration_hook(const tensor::Conv2DOp&, std::s
 
 void FakeLinAlgTripleProvider::registration_hook_boolean(std::size_t, std::size_t) {}
 
+// ---------- LinAlgTriplesFromDealer ----------
+
+namespace {
+
+template <typename Op, typename T>
+void generate_triples_from_dealer(const Crypto::TrustedDealer& trusted_dealer,
+                                  std::string_view kind, const Op& op, std::size_t count,
+                                  std::vector<LinAlgTripleProvider::LinAlgTriple<T>>& triple_vec) {
+  triple_vec.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    // both parties need to derive the same labels for the triples of an operation
+    const auto label =
+        fmt::format("{}{}_{:x}_{}", kind, ENCRYPTO::bit_size_v<T>, std::hash<Op>{}(op), i);
+    const auto a = trusted_dealer.random_values<T>(label + "_a", get_left_size(op));
+    const auto b = trusted_dealer.random_values<T>(label + "_b", get_right_size(op));
+    const auto c = compute_product(op, a, b);
+    auto& triple = triple_vec.emplace_back();
+    triple.a_ = trusted_dealer.share(label + "_a_shares", a);
+    triple.b_ = trusted_dealer.share(label + "_b_shares", b);
+    triple.c_ = trusted_dealer.share(label + "_c_shares", c);
+  }
+}
+
+}  // namespace
+
+LinAlgTriplesFromDealer::LinAlgTriplesFromDealer(const Crypto::TrustedDealer& trusted_dealer)
+    : trusted_dealer_(trusted_dealer) {}
+
+void LinAlgTriplesFromDealer::setup() {
+  const auto run_setup = [this](std::string_view kind, const auto& count_map, auto& triple_map) {
+    for (const auto& [op, count] : count_map) {
+      generate_triples_from_dealer(trusted_dealer_, kind, op, count, triple_map.at(op));
+    }
+  };
+  const auto run_setup_boolean = [this](const auto& count_map, auto& triple_map) {
+    for (const auto& [key, count] : count_map) {
+      const auto [num_triples, bit_size] = key;
+      auto& triple_vec = triple_map.at(key);
+      triple_vec.reserve(count);
+      for (std::size_t i = 0; i < count; ++i) {
+        const auto label = fmt::format("relu_{}_{}_{}", num_triples, bit_size, i);
+        const auto a = trusted_dealer_.random_bits(label + "_a", num_triples);
+        auto& triple = triple_vec.emplace_back();
+        triple.a_ = trusted_dealer_.share(label + "_a_shares", a);
+        triple.b_.reserve(bit_size - 1);
+        triple.c_.reserve(bit_size - 1);
+        for (std::size_t bit_j = 0; bit_j < bit_size - 1; ++bit_j) {
+          const auto bit_label = fmt::format("{}_{}", label, bit_j);
+          const auto b = trusted_dealer_.random_bits(bit_label + "_b", num_triples);
+          triple.b_.emplace_back(trusted_dealer_.share(bit_label + "_b_shares", b));
+          triple.c_.emplace_back(trusted_dealer_.share(bit_label + "_c_shares", a & b));
+        }
+      }
+    }
+  };
+
+  run_setup("gemm", gemm_counts_8_, gemm_triples_8_);
+  run_setup("gemm", gemm_counts_16_, gemm_triples_16_);
+  run_setup("gemm", gemm_counts_32_, gemm_triples_32_);
+  run_setup("gemm", gemm_counts_64_, gemm_triples_64_);
+  run_setup("gemm", gemm_counts_128_, gemm_triples_128_);
+
+  run_setup("conv", conv2d_counts_8_, conv2d_triples_8_);
+  run_setup("conv", conv2d_counts_16_, conv2d_triples_16_);
+  run_setup("conv", conv2d_counts_32_, conv2d_triples_32_);
+  run_setup("conv", conv2d_counts_64_, conv2d_triples_64_);
+  run_setup("conv", conv2d_counts_128_, conv2d_triples_128_);
+
+  run_setup_boolean(relu_counts_, relu_triples_);
+
+  set_setup_ready();
+}
+
+void LinAlgTriplesFromDealer::registration_hook(const tensor::GemmOp&, std::size_t) {}
+
+void LinAlgTriplesFromDealer::registration_hook(const tensor::Conv2DOp&, std::size_t) {}
+
+void LinAlgTriplesFromDealer::registration_hook_boolean(std::size_t, std::size_t) {}
+
 }  // namespace MOTION
@@ -22,10 +22,13 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "tensor/tensor_op.h"
@@ -42,6 +45,15 @@ class ROTSender;
 
 namespace MOTION {
 
+namespace Communication {
+class CommunicationLayer;
+class QueueHandler;
+}  // namespace Communication
+
+namespace Crypto {
+class TrustedDealer;
+}
+
 namespace Statistics {
 struct RunTimeStats;
 }
@@ -140,6 +152,9 @@ class LinAlgTriplesFromAP : public LinAlgTripleProvider {
   void registration_hook(const tensor::GemmOp&, std::size_t bit_size) override;
   void registration_hook(const tensor::Conv2DOp&, std::size_t bit_size) override;
   void registration_hook_boolean(std::size_t num_triples, std::size_t bit_size) override;
+  // called at the beginning of setup() to generate the triples which are not
+  // registered with the ArithmeticProvider
+  virtual void setup_hook() {}
 
  private:
   ArithmeticProvider& arith_provider_;
@@ -172,6 +187,79 @@ class LinAlgTriplesFromAP : public LinAlgTripleProvider {
       relu_handles_;
 };
 
+struct LinAlgHEConfig {
+  enum class Selection {
+    cost_model,  // use the backend with the lower estimated time per layer
+    always,      // use HE whenever it is supported
+    never,       // always use OTs
+  };
+  Selection selection = Selection::cost_model;
+  // Parameters of the cost model.  The defaults are rough estimates for a
+  // single thread and a 1 Gbit/s network; benchmark_linalg_triples prints the
+  // estimates next to the measurements.
+  double bandwidth = 125e6;  // bytes per second
+  double seconds_per_ot = 1e-7;
+  double seconds_per_ot_byte = 1e-9;
+  double seconds_per_he_product = 2e-3;     // ciphertext-plaintext product
+  double seconds_per_he_ciphertext = 3e-3;  // encryption, re-randomization, or decryption
+};
+
+struct LinAlgCostEstimate {
+  std::size_t bytes;  // sent by both parties together
+  double seconds;
+};
+
+// Generates GEMM and Conv2D triples with packed linear homomorphic encryption
+// (cf. crypto/linear_he/linear_he.h) for the layers where this is cheaper than
+// the OT-based generation according to the cost model.  Each party encrypts
+// its share of a, and the other party multiplies it with its share of b.  All
+// remaining triples are generated by LinAlgTriplesFromAP.  The HE backend
+// supports rings of up to 32 bit.
+class LinAlgTriplesFromHE : public LinAlgTriplesFromAP {
+ public:
+  LinAlgTriplesFromHE(Communication::CommunicationLayer&, ArithmeticProvider&,
+                      ENCRYPTO::ObliviousTransfer::OTProvider&, Statistics::RunTimeStats&,
+                      std::shared_ptr<Logger>, const LinAlgHEConfig& = {});
+  ~LinAlgTriplesFromHE();
+
+  // number of registered triples which are generated with HE
+  std::size_t get_num_he_triples() const noexcept { return he_requests_.size(); }
+
+  // dimensions (l, m, n) of the matrix product computed for a triple
+  static std::array<std::size_t, 3> get_matrix_dimensions(const tensor::GemmOp&);
+  static std::array<std::size_t, 3> get_matrix_dimensions(const tensor::Conv2DOp&);
+  // costs of one triple, std::nullopt if HE is not supported
+  static std::optional<LinAlgCostEstimate> estimate_he_cost(const std::array<std::size_t, 3>&,
+                                                            std::size_t bit_size,
+                                                            const LinAlgHEConfig&);
+  static LinAlgCostEstimate estimate_ot_cost(const std::array<std::size_t, 3>&,
+                                             std::size_t bit_size, const LinAlgHEConfig&);
+
+ protected:
+  void registration_hook(const tensor::GemmOp&, std::size_t bit_size) override;
+  void registration_hook(const tensor::Conv2DOp&, std::size_t bit_size) override;
+  void setup_hook() override;
+
+ private:
+  bool use_he(const std::array<std::size_t, 3>&, std::size_t bit_size) const;
+  void send_message(std::uint64_t kind, std::uint64_t id, const std::vector<std::uint8_t>& payload);
+  // returns the raw message whose payload starts after the compact message header
+  std::vector<std::uint8_t> receive_message(std::uint64_t kind, std::uint64_t id);
+
+  struct HERequest {
+    std::variant<tensor::GemmOp, tensor::Conv2DOp> op_;
+    std::size_t bit_size_;
+  };
+
+  Communication::CommunicationLayer& comm_layer_;
+  std::size_t peer_id_;
+  LinAlgHEConfig config_;
+  std::shared_ptr<Logger> logger_;
+  // in the order of registration
+  std::vector<HERequest> he_requests_;
+  std::shared_ptr<Communication::QueueHandler> message_handler_;
+};
+
 // Generator of fake triples which just consists of random data.
 class FakeLinAlgTripleProvider : public LinAlgTripleProvider {
  public:
@@ -183,4 +271,21 @@ class FakeLinAlgTripleProvider : public LinAlgTripleProvider {
   void registration_hook_boolean(std::size_t num_triples, std::size_t bit_size) override;
 };
 
+// Generator of correct triples which are derived locally from the seed of a
+// simulated trusted dealer.  Insecure, only for benchmarking the online phase
+// (cf. Crypto::TrustedDealer).
+class LinAlgTriplesFromDealer : public LinAlgTripleProvider {
+ public:
+  LinAlgTriplesFromDealer(const Crypto::TrustedDealer&);
+  void setup() override;
+
+ protected:
+  void registration_hook(const tensor::GemmOp&, std::size_t bit_size) override;
+  void registration_hook(const tensor::Conv2DOp&, std::size_t bit_size) override;
+  void registration_hook_boolean(std::size_t num_triples, std::size_t bit_size) override;
+
+ private:
+  const Crypto::TrustedDealer& trusted_dealer_;
+};
+
 }  // namespace MOTION
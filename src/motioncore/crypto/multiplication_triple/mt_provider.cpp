@@ -27,9 +27,11 @@
 
 #include "crypto/arithmetic_provider.h"
 #include "crypto/oblivious_transfer/ot_flavors.h"
+#include "crypto/trusted_dealer.h"
 #include "statistics/run_time_stats.h"
 #include "utility/constants.h"
 #include "utility/logger.h"
+#include "utility/type_traits.hpp"
 
 namespace MOTION {
 
@@ -412,4 +414,57 @@ void MTProviderFromOTs::Setup() {
   }
 }
 
+template <typename T>
+static void generate_mts_from_dealer(const Crypto::TrustedDealer& trusted_dealer,
+                                     std::size_t num_mts, IntegerMTVector<T>& mts) {
+  if (num_mts == 0) {
+    return;
+  }
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<T>;
+  const auto a = trusted_dealer.random_values<T>(fmt::format("mt{}_a", bit_size), num_mts);
+  const auto b = trusted_dealer.random_values<T>(fmt::format("mt{}_b", bit_size), num_mts);
+  std::vector<T> c(num_mts);
+  std::transform(std::begin(a), std::end(a), std::begin(b), std::begin(c), std::multiplies{});
+  mts.a = trusted_dealer.share(fmt::format("mt{}_a_shares", bit_size), a);
+  mts.b = trusted_dealer.share(fmt::format("mt{}_b_shares", bit_size), b);
+  mts.c = trusted_dealer.share(fmt::format("mt{}_c_shares", bit_size), c);
+}
+
+MTProviderFromDealer::MTProviderFromDealer(const Crypto::TrustedDealer& trusted_dealer,
+                                           Statistics::RunTimeStats& run_time_stats,
+                                           std::shared_ptr<Logger> logger)
+    : MTProvider(trusted_dealer.get_my_id(), trusted_dealer.get_num_parties()),
+      trusted_dealer_(trusted_dealer),
+      run_time_stats_(run_time_stats),
+      logger_(logger) {}
+
+void MTProviderFromDealer::Setup() {
+  run_time_stats_.record_start<Statistics::RunTimeStats::StatID::mt_setup>();
+
+  if (num_bit_mts_ > 0) {
+    const auto a = trusted_dealer_.random_bits("mt1_a", num_bit_mts_);
+    const auto b = trusted_dealer_.random_bits("mt1_b", num_bit_mts_);
+    bit_mts_.a = trusted_dealer_.share("mt1_a_shares", a);
+    bit_mts_.b = trusted_dealer_.share("mt1_b_shares", b);
+    bit_mts_.c = trusted_dealer_.share("mt1_c_shares", a & b);
+  }
+  generate_mts_from_dealer(trusted_dealer_, num_mts_8_, mts8_);
+  generate_mts_from_dealer(trusted_dealer_, num_mts_16_, mts16_);
+  generate_mts_from_dealer(trusted_dealer_, num_mts_32_, mts32_);
+  generate_mts_from_dealer(trusted_dealer_, num_mts_64_, mts64_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_stats_.record_end<Statistics::RunTimeStats::StatID::mt_setup>();
+  if constexpr (MOTION_DEBUG) {
+    if (logger_) {
+      logger_->LogDebug("Generated MTs with the trusted dealer");
+    }
+  }
+}
+
 }  // namespace MOTION
@@ -33,6 +33,10 @@
 
 namespace MOTION {
 
+namespace Crypto {
+class TrustedDealer;
+}
+
 namespace Statistics {
 struct RunTimeStats;
 }
@@ -200,4 +204,20 @@ class MTProviderFromOTs : public MTProvider {
   std::shared_ptr<Logger> logger_;
 };
 
+// MTs which are derived locally from the seed of a simulated trusted dealer.
+// Insecure, only for benchmarking the online phase (cf. Crypto::TrustedDealer).
+class MTProviderFromDealer final : public MTProvider {
+ public:
+  MTProviderFromDealer(const Crypto::TrustedDealer&, Statistics::RunTimeStats&,
+                       std::shared_ptr<Logger>);
+
+  void PreSetup() final {}
+  void Setup() final;
+
+ private:
+  const Crypto::TrustedDealer& trusted_dealer_;
+  Statistics::RunTimeStats& run_time_stats_;
+  std::shared_ptr<Logger> logger_;
+};
+
 }  // namespace MOTION
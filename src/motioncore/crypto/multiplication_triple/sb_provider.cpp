@@ -31,6 +31,7 @@
 #include "communication/shared_bits_message.h"
 #include "crypto/oblivious_transfer/ot_flavors.h"
 #include "crypto/oblivious_transfer/ot_provider.h"
+#include "crypto/trusted_dealer.h"
 #include "data_storage/shared_bits_data.h"
 #include "sb_impl.h"
 #include "sb_provider.h"
@@ -39,6 +40,7 @@
 #include "utility/constants.h"
 #include "utility/helpers.h"
 #include "utility/logger.h"
+#include "utility/type_traits.hpp"
 
 namespace MOTION {
 
@@ -485,4 +487,49 @@ void TwoPartySBProvider::Setup() {
   }
 }
 
+template <typename T>
+static void generate_sbs_from_dealer(const Crypto::TrustedDealer& trusted_dealer,
+                                     std::size_t num_sbs, std::vector<T>& sbs) {
+  if (num_sbs == 0) {
+    return;
+  }
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<T>;
+  const auto bits = trusted_dealer.random_bits(fmt::format("sb{}", bit_size), num_sbs);
+  std::vector<T> values(num_sbs);
+  for (std::size_t sb_i = 0; sb_i < num_sbs; ++sb_i) {
+    values[sb_i] = bits.Get(sb_i);
+  }
+  sbs = trusted_dealer.share(fmt::format("sb{}_shares", bit_size), values);
+}
+
+SBProviderFromDealer::SBProviderFromDealer(const Crypto::TrustedDealer& trusted_dealer,
+                                           Statistics::RunTimeStats& run_time_stats,
+                                           std::shared_ptr<Logger> logger)
+    : SBProvider(trusted_dealer.get_my_id()),
+      trusted_dealer_(trusted_dealer),
+      run_time_stats_(run_time_stats),
+      logger_(logger) {}
+
+void SBProviderFromDealer::Setup() {
+  run_time_stats_.record_start<Statistics::RunTimeStats::StatID::sb_setup>();
+
+  generate_sbs_from_dealer(trusted_dealer_, num_sbs_8_, sbs_8_);
+  generate_sbs_from_dealer(trusted_dealer_, num_sbs_16_, sbs_16_);
+  generate_sbs_from_dealer(trusted_dealer_, num_sbs_32_, sbs_32_);
+  generate_sbs_from_dealer(trusted_dealer_, num_sbs_64_, sbs_64_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_stats_.record_end<Statistics::RunTimeStats::StatID::sb_setup>();
+  if constexpr (MOTION_DEBUG) {
+    if (logger_) {
+      logger_->LogDebug("Generated SBs with the trusted dealer");
+    }
+  }
+}
+
 }  // namespace MOTION
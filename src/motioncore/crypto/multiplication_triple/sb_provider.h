@@ -46,6 +46,10 @@ namespace Communication {
 class CommunicationLayer;
 }
 
+namespace Crypto {
+class TrustedDealer;
+}
+
 namespace Statistics {
 struct RunTimeStats;
 }
@@ -228,4 +232,20 @@ class TwoPartySBProvider : public SBProvider {
   std::shared_ptr<Logger> logger_;
 };
 
+// SBs which are derived locally from the seed of a simulated trusted dealer.
+// Insecure, only for benchmarking the online phase (cf. Crypto::TrustedDealer).
+class SBProviderFromDealer final : public SBProvider {
+ public:
+  SBProviderFromDealer(const Crypto::TrustedDealer&, Statistics::RunTimeStats&,
+                       std::shared_ptr<Logger>);
+
+  void PreSetup() final {}
+  void Setup() final;
+
+ private:
+  const Crypto::TrustedDealer& trusted_dealer_;
+  Statistics::RunTimeStats& run_time_stats_;
+  std::shared_ptr<Logger> logger_;
+};
+
 }  // namespace MOTION
@@ -23,10 +23,12 @@
 // SOFTWARE.
 
 #include "crypto/oblivious_transfer/ot_provider.h"
+#include "crypto/trusted_dealer.h"
 #include "sp_provider.h"
 #include "statistics/run_time_stats.h"
 #include "utility/constants.h"
 #include "utility/logger.h"
+#include "utility/type_traits.hpp"
 
 namespace MOTION {
 
@@ -275,4 +277,49 @@ void SPProviderFromOTs::ParseOutputs() {
   }
 }
 
+template <typename T>
+static void generate_sps_from_dealer(const Crypto::TrustedDealer& trusted_dealer,
+                                     std::size_t num_sps, SPVector<T>& sps) {
+  if (num_sps == 0) {
+    return;
+  }
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<T>;
+  const auto a = trusted_dealer.random_values<T>(fmt::format("sp{}_a", bit_size), num_sps);
+  std::vector<T> c(num_sps);
+  std::transform(std::begin(a), std::end(a), std::begin(c), [](auto x) { return x * x; });
+  sps.a = trusted_dealer.share(fmt::format("sp{}_a_shares", bit_size), a);
+  sps.c = trusted_dealer.share(fmt::format("sp{}_c_shares", bit_size), c);
+}
+
+SPProviderFromDealer::SPProviderFromDealer(const Crypto::TrustedDealer& trusted_dealer,
+                                           Statistics::RunTimeStats& run_time_stats,
+                                           std::shared_ptr<Logger> logger)
+    : SPProvider(trusted_dealer.get_my_id()),
+      trusted_dealer_(trusted_dealer),
+      run_time_stats_(run_time_stats),
+      logger_(logger) {}
+
+void SPProviderFromDealer::Setup() {
+  run_time_stats_.record_start<Statistics::RunTimeStats::StatID::sp_setup>();
+
+  generate_sps_from_dealer(trusted_dealer_, num_sps_8_, sps_8_);
+  generate_sps_from_dealer(trusted_dealer_, num_sps_16_, sps_16_);
+  generate_sps_from_dealer(trusted_dealer_, num_sps_32_, sps_32_);
+  generate_sps_from_dealer(trusted_dealer_, num_sps_64_, sps_64_);
+  generate_sps_from_dealer(trusted_dealer_, num_sps_128_, sps_128_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_stats_.record_end<Statistics::RunTimeStats::StatID::sp_setup>();
+  if constexpr (MOTION_DEBUG) {
+    if (logger_) {
+      logger_->LogDebug("Generated SPs with the trusted dealer");
+    }
+  }
+}
+
 }  // namespace MOTION
@@ -43,6 +43,10 @@ class OTVectorReceiver;
 
 namespace MOTION {
 
+namespace Crypto {
+class TrustedDealer;
+}
+
 namespace Statistics {
 struct RunTimeStats;
 }
@@ -202,4 +206,20 @@ class SPProviderFromOTs final : public SPProvider {
   Statistics::RunTimeStats& run_time_stats_;
 };
 
+// SPs which are derived locally from the seed of a simulated trusted dealer.
+// Insecure, only for benchmarking the online phase (cf. Crypto::TrustedDealer).
+class SPProviderFromDealer final : public SPProvider {
+ public:
+  SPProviderFromDealer(const Crypto::TrustedDealer&, Statistics::RunTimeStats&,
+                       std::shared_ptr<Logger>);
+
+  void PreSetup() final {}
+  void Setup() final;
+
+ private:
+  const Crypto::TrustedDealer& trusted_dealer_;
+  Statistics::RunTimeStats& run_time_stats_;
+  std::shared_ptr<Logger> logger_;
+};
+
 }  // namespace MOTION
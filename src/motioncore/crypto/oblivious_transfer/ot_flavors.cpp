@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include "communication/ot_extension_message.h"
+#include "crypto/pseudo_random_generator.h"
 #include "data_storage/ot_extension_data.h"
 #include "ot_flavors.h"
 #include "utility/fiber_condition.h"
@@ -32,7 +33,7 @@ namespace ObliviousTransfer {
 
 BasicOTSender::BasicOTSender(std::size_t ot_id, std::size_t num_ots, std::size_t bitlen,
                              OTProtocol p,
-                             const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send,
+                             const std::function<void(std::vector<std::uint8_t> &&)> &Send,
                              MOTION::OTExtensionSenderData &data)
     : OTVector(ot_id, num_ots, bitlen, p, Send), data_(data) {
   data_.received_correction_offsets_cond_.emplace(
@@ -54,7 +55,7 @@ void BasicOTSender::WaitSetup() const { data_.setup_finished_cond_->Wait(); }
 
 BasicOTReceiver::BasicOTReceiver(std::size_t ot_id, std::size_t num_ots, std::size_t bitlen,
                                  OTProtocol p,
-                                 const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send,
+                                 const std::function<void(std::vector<std::uint8_t> &&)> &Send,
                                  MOTION::OTExtensionReceiverData &data)
     : OTVector(ot_id, num_ots, bitlen, p, Send), data_(data) {
   data_.outputs_.resize(ot_id + num_ots);
@@ -78,7 +79,7 @@ void BasicOTReceiver::SendCorrections() {
 
 FixedXCOT128Sender::FixedXCOT128Sender(
     std::size_t ot_id, std::size_t num_ots, MOTION::OTExtensionSenderData &data,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : BasicOTSender(ot_id, num_ots, 128, FixedXCOT128, Send, data) {}
 
 void FixedXCOT128Sender::ComputeOutputs() {
@@ -133,7 +134,7 @@ void FixedXCOT128Sender::SendMessages() const {
 
 FixedXCOT128Receiver::FixedXCOT128Receiver(
     const std::size_t ot_id, const std::size_t num_ots, MOTION::OTExtensionReceiverData &data,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : BasicOTReceiver(ot_id, num_ots, 128, FixedXCOT128, Send, data), outputs_(num_ots) {
   data_.msg_type_.emplace(ot_id, MOTION::OTMsgType::block128);
   sender_message_future_ = data_.RegisterForBlock128SenderMessage(ot_id, num_ots);
@@ -163,7 +164,7 @@ void FixedXCOT128Receiver::ComputeOutputs() {
 
 XCOTBitSender::XCOTBitSender(const std::size_t ot_id, const std::size_t num_ots,
                              const std::size_t vector_size, MOTION::OTExtensionSenderData& data,
-                             const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send)
+                             const std::function<void(std::vector<std::uint8_t>&&)>& Send)
     : BasicOTSender(ot_id, num_ots, vector_size, XCOTBit, Send, data), vector_size_(vector_size) {}
 
 void XCOTBitSender::ComputeOutputs() {
@@ -244,7 +245,7 @@ void XCOTBitSender::SendMessages() const {
 XCOTBitReceiver::XCOTBitReceiver(const std::size_t ot_id, const std::size_t num_ots,
                                  const std::size_t vector_size,
                                  MOTION::OTExtensionReceiverData& data,
-                                 const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send)
+                                 const std::function<void(std::vector<std::uint8_t>&&)>& Send)
     : BasicOTReceiver(ot_id, num_ots, vector_size, XCOTBit, Send, data), vector_size_(vector_size) {
   data_.msg_type_.emplace(ot_id, MOTION::OTMsgType::bit);
   sender_message_future_ = data_.RegisterForBitSenderMessage(ot_id, num_ots * vector_size_);
@@ -285,12 +286,31 @@ void XCOTBitReceiver::ComputeOutputs() {
 
 // ---------- ACOTSender ----------
 
+// bit length of the OT extension outputs of an ACOT
+template <typename T>
+static std::size_t acot_bitlen(std::size_t vector_size, bool seed_compression) {
+  return seed_compression ? 128 : 8 * sizeof(T) * vector_size;
+}
+
+// Expands the seed of an ACOT with seed compression to its vector_size
+// values, in the same way as the OT extension expands long OTs.
+template <typename T>
+static void acot_expand_seed(PRG &prg, const BitVector<> &seed, T *output,
+                             std::size_t vector_size) {
+  prg.SetKey(seed.GetData().data());
+  const auto bytes = prg.Encrypt(sizeof(T) * vector_size);
+  std::copy_n(bytes.data(), sizeof(T) * vector_size, reinterpret_cast<std::byte *>(output));
+}
+
 template <typename T>
 ACOTSender<T>::ACOTSender(const std::size_t ot_id, const std::size_t num_ots,
-                          const std::size_t vector_size, MOTION::OTExtensionSenderData &data,
-                          const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
-    : BasicOTSender(ot_id, num_ots, 8 * sizeof(T) * vector_size, ACOT, Send, data),
-      vector_size_(vector_size) {}
+                          const std::size_t vector_size, bool seed_compression,
+                          MOTION::OTExtensionSenderData &data,
+                          const std::function<void(std::vector<std::uint8_t> &&)> &Send)
+    : BasicOTSender(ot_id, num_ots, acot_bitlen<T>(vector_size, seed_compression), ACOT, Send,
+                    data),
+      vector_size_(vector_size),
+      seed_compression_(seed_compression) {}
 
 template <typename T>
 void ACOTSender<T>::ComputeOutputs() {
@@ -298,6 +318,9 @@ void ACOTSender<T>::ComputeOutputs() {
     // the work was already done
     return;
   }
+  if (seed_compression_) {
+    throw std::logic_error("ACOTSender: seed compression requires the streaming ComputeOutputs");
+  }
 
   // setup phase needs to be finished
   WaitSetup();
@@ -342,6 +365,9 @@ void ACOTSender<T>::ComputeOutputs() {
 
 template <typename T>
 void ACOTSender<T>::SendMessages() const {
+  if (seed_compression_) {
+    throw std::logic_error("ACOTSender: seed compression requires the streaming SendMessages");
+  }
   auto buffer = correlations_;
   if (vector_size_ == 1) {
     for (std::size_t ot_i = 0; ot_i < num_ots_; ++ot_i) {
@@ -363,14 +389,95 @@ void ACOTSender<T>::SendMessages() const {
       reinterpret_cast<const std::byte *>(buffer.data()), sizeof(T) * buffer.size(), ot_id_));
 }
 
+template <typename T>
+void ACOTSender<T>::SendMessages(
+    const std::function<void(std::size_t, T *)> &get_correlations) const {
+  std::vector<T> buffer(num_ots_ * vector_size_);
+#pragma omp parallel
+  {
+    PRG prg;
+    std::vector<T> y0(seed_compression_ ? vector_size_ : 0);
+    std::vector<T> y1(seed_compression_ ? vector_size_ : 0);
+#pragma omp for schedule(static)
+    for (std::size_t ot_i = 0; ot_i < num_ots_; ++ot_i) {
+      const auto &seed0 = data_.y0_[ot_id_ + ot_i];
+      const auto &seed1 = data_.y1_[ot_id_ + ot_i];
+      auto y0_p = reinterpret_cast<const T *>(seed0.GetData().data());
+      auto y1_p = reinterpret_cast<const T *>(seed1.GetData().data());
+      if (seed_compression_) {
+        acot_expand_seed(prg, seed0, y0.data(), vector_size_);
+        acot_expand_seed(prg, seed1, y1.data(), vector_size_);
+        y0_p = y0.data();
+        y1_p = y1.data();
+      }
+      auto b_p = &buffer[ot_i * vector_size_];
+      get_correlations(ot_i, b_p);
+      for (std::size_t j = 0; j < vector_size_; ++j) {
+        b_p[j] += y0_p[j] + y1_p[j];
+      }
+    }
+  }
+  Send_(MOTION::Communication::BuildOTExtensionMessageSender(
+      reinterpret_cast<const std::byte *>(buffer.data()), sizeof(T) * buffer.size(), ot_id_));
+}
+
+template <typename T>
+void ACOTSender<T>::ComputeOutputs(std::size_t block_size,
+                                   const std::function<void(std::size_t, const T *)> &callback) {
+  if (num_ots_ == 0) {
+    return;
+  }
+  if (block_size == 0) {
+    throw std::invalid_argument("ACOTSender::ComputeOutputs: block size must be positive");
+  }
+
+  // setup phase needs to be finished
+  WaitSetup();
+
+  // wait until the receiver has sent its correction bits
+  data_.received_correction_offsets_cond_.at(ot_id_)->Wait();
+
+  // get the corrections bits
+  std::unique_lock lock(data_.corrections_mutex_);
+  const auto corrections = data_.corrections_.Subset(ot_id_, ot_id_ + num_ots_);
+  lock.unlock();
+
+  const auto num_blocks = (num_ots_ + block_size - 1) / block_size;
+#pragma omp parallel
+  {
+    PRG prg;
+    std::vector<T> buffer(seed_compression_ ? vector_size_ : 0);
+#pragma omp for schedule(static)
+    for (std::size_t block_i = 0; block_i < num_blocks; ++block_i) {
+      const auto ot_end = std::min(num_ots_, (block_i + 1) * block_size);
+      for (std::size_t ot_i = block_i * block_size; ot_i < ot_end; ++ot_i) {
+        // if the correction bit is 1, we need to swap
+        const auto &y = corrections[ot_i] ? data_.y1_[ot_id_ + ot_i] : data_.y0_[ot_id_ + ot_i];
+        if (seed_compression_) {
+          acot_expand_seed(prg, y, buffer.data(), vector_size_);
+          callback(ot_i, buffer.data());
+        } else {
+          callback(ot_i, reinterpret_cast<const T *>(y.GetData().data()));
+        }
+        // the outputs of this OT are not needed anymore
+        data_.y0_[ot_id_ + ot_i] = {};
+        data_.y1_[ot_id_ + ot_i] = {};
+      }
+    }
+  }
+}
+
 // ---------- ACOTReceiver ----------
 
 template <typename T>
 ACOTReceiver<T>::ACOTReceiver(const std::size_t ot_id, const std::size_t num_ots,
-                              const std::size_t vector_size, MOTION::OTExtensionReceiverData &data,
-                              const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
-    : BasicOTReceiver(ot_id, num_ots, 8 * sizeof(T) * vector_size, ACOT, Send, data),
-      vector_size_(vector_size) {
+                              const std::size_t vector_size, bool seed_compression,
+                              MOTION::OTExtensionReceiverData &data,
+                              const std::function<void(std::vector<std::uint8_t> &&)> &Send)
+    : BasicOTReceiver(ot_id, num_ots, acot_bitlen<T>(vector_size, seed_compression), ACOT, Send,
+                      data),
+      vector_size_(vector_size),
+      seed_compression_(seed_compression) {
   constexpr auto int_type_to_msg_type = boost::hana::make_map(
       boost::hana::make_pair(boost::hana::type_c<std::uint8_t>, MOTION::OTMsgType::uint8),
       boost::hana::make_pair(boost::hana::type_c<std::uint16_t>, MOTION::OTMsgType::uint16),
@@ -391,6 +498,9 @@ void ACOTReceiver<T>::ComputeOutputs() {
   if (!corrections_sent_) {
     throw std::runtime_error("Choices in COT must be se(n)t before calling ComputeOutputs()");
   }
+  if (seed_compression_) {
+    throw std::logic_error("ACOTReceiver: seed compression requires the streaming ComputeOutputs");
+  }
 
   // make space for all the OTs
   outputs_.resize(num_ots_ * vector_size_);
@@ -423,6 +533,53 @@ void ACOTReceiver<T>::ComputeOutputs() {
   outputs_computed_ = true;
 }
 
+template <typename T>
+void ACOTReceiver<T>::ComputeOutputs(std::size_t block_size,
+                                     const std::function<void(std::size_t, const T *)> &callback) {
+  if (!corrections_sent_) {
+    throw std::runtime_error("Choices in COT must be se(n)t before calling ComputeOutputs()");
+  }
+  if (num_ots_ == 0) {
+    return;
+  }
+  if (block_size == 0) {
+    throw std::invalid_argument("ACOTReceiver::ComputeOutputs: block size must be positive");
+  }
+
+  auto sender_message = sender_message_future_.get();
+  assert(sender_message.size() == num_ots_ * vector_size_);
+
+  const auto num_blocks = (num_ots_ + block_size - 1) / block_size;
+#pragma omp parallel
+  {
+    PRG prg;
+    std::vector<T> buffer(vector_size_);
+    std::vector<T> expanded(seed_compression_ ? vector_size_ : 0);
+#pragma omp for schedule(static)
+    for (std::size_t block_i = 0; block_i < num_blocks; ++block_i) {
+      const auto ot_end = std::min(num_ots_, (block_i + 1) * block_size);
+      for (std::size_t ot_i = block_i * block_size; ot_i < ot_end; ++ot_i) {
+        const auto &ot_data = data_.outputs_[ot_id_ + ot_i];
+        auto ot_data_p = reinterpret_cast<const T *>(ot_data.GetData().data());
+        if (seed_compression_) {
+          acot_expand_seed(prg, ot_data, expanded.data(), vector_size_);
+          ot_data_p = expanded.data();
+        }
+        if (choices_[ot_i]) {
+          std::transform(ot_data_p, ot_data_p + vector_size_,
+                         &sender_message[ot_i * vector_size_], std::begin(buffer),
+                         [](auto d, auto m) { return m - d; });
+          callback(ot_i, buffer.data());
+        } else {
+          callback(ot_i, ot_data_p);
+        }
+        // the outputs of this OT are not needed anymore
+        data_.outputs_[ot_id_ + ot_i] = {};
+      }
+    }
+  }
+}
+
 // ---------- ACOT template instantiations ----------
 
 template class ACOTSender<std::uint8_t>;
@@ -440,7 +597,7 @@ template class ACOTReceiver<__uint128_t>;
 
 GOT128Sender::GOT128Sender(std::size_t ot_id, std::size_t num_ots,
                            MOTION::OTExtensionSenderData &data,
-                           const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                           const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : BasicOTSender(ot_id, num_ots, 128, GOT, Send, data) {}
 
 void GOT128Sender::SendMessages() const {
@@ -470,7 +627,7 @@ void GOT128Sender::SendMessages() const {
 
 GOT128Receiver::GOT128Receiver(const std::size_t ot_id, const std::size_t num_ots,
                                MOTION::OTExtensionReceiverData &data,
-                               const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                               const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : BasicOTReceiver(ot_id, num_ots, 128, FixedXCOT128, Send, data), outputs_(num_ots) {
   data_.msg_type_.emplace(ot_id, MOTION::OTMsgType::block128);
   sender_message_future_ = data_.RegisterForBlock128SenderMessage(ot_id, 2 * num_ots);
@@ -504,7 +661,7 @@ void GOT128Receiver::ComputeOutputs() {
 
 GOTBitSender::GOTBitSender(std::size_t ot_id, std::size_t num_ots,
                            MOTION::OTExtensionSenderData &data,
-                           const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                           const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : BasicOTSender(ot_id, num_ots, 1, GOT, Send, data) {}
 
 void GOTBitSender::SendMessages() const {
@@ -535,7 +692,7 @@ void GOTBitSender::SendMessages() const {
 
 GOTBitReceiver::GOTBitReceiver(const std::size_t ot_id, const std::size_t num_ots,
                                MOTION::OTExtensionReceiverData &data,
-                               const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                               const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : BasicOTReceiver(ot_id, num_ots, 1, GOT, Send, data), outputs_(num_ots) {
   data_.msg_type_.emplace(ot_id, MOTION::OTMsgType::bit);
   sender_message_future_ = data_.RegisterForBitSenderMessage(ot_id, 2 * num_ots);
@@ -569,7 +726,7 @@ void GOTBitReceiver::ComputeOutputs() {
 
 ROTSender::ROTSender(const std::size_t ot_id, const std::size_t num_ots, std::size_t vector_size,
                      bool random_choice, MOTION::OTExtensionSenderData& data,
-                     const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send)
+                     const std::function<void(std::vector<std::uint8_t>&&)>& Send)
     : BasicOTSender(ot_id, num_ots, vector_size, ROT, Send, data),
       vector_size_(vector_size),
       random_choice_(random_choice) {
@@ -606,7 +763,7 @@ void ROTSender::ComputeOutputs() {
 ROTReceiver::ROTReceiver(const std::size_t ot_id, const std::size_t num_ots,
                          std::size_t vector_size, bool random_choice,
                          MOTION::OTExtensionReceiverData& data,
-                         const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send)
+                         const std::function<void(std::vector<std::uint8_t>&&)>& Send)
     : BasicOTReceiver(ot_id, num_ots, vector_size, ROT, Send, data),
       vector_size_(vector_size),
       random_choice_(random_choice) {
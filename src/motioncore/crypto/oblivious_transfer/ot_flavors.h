@@ -40,7 +40,7 @@ class BasicOTSender : public OTVector {
 
  protected:
   BasicOTSender(std::size_t ot_id, std::size_t num_ots, std::size_t bitlen, OTProtocol p,
-                const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send,
+                const std::function<void(std::vector<std::uint8_t> &&)> &Send,
                 MOTION::OTExtensionSenderData &data);
 
   // reference to data storage
@@ -68,7 +68,7 @@ class BasicOTReceiver : public OTVector {
 
  protected:
   BasicOTReceiver(std::size_t ot_id, std::size_t num_ots, std::size_t bitlen, OTProtocol p,
-                  const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send,
+                  const std::function<void(std::vector<std::uint8_t> &&)> &Send,
                   MOTION::OTExtensionReceiverData &data);
 
   // reference to data storage
@@ -86,7 +86,7 @@ class BasicOTReceiver : public OTVector {
 class FixedXCOT128Sender : public BasicOTSender {
  public:
   FixedXCOT128Sender(std::size_t ot_id, std::size_t num_ots, MOTION::OTExtensionSenderData &data,
-                     const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+                     const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
   // set the *single* correlation for all OTs in this batch
   void SetCorrelation(block128_t correlation) { correlation_ = correlation; }
@@ -120,7 +120,7 @@ class FixedXCOT128Receiver : public BasicOTReceiver {
  public:
   FixedXCOT128Receiver(std::size_t ot_id, std::size_t num_ots,
                        MOTION::OTExtensionReceiverData &data,
-                       const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+                       const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
   // compute the receiver's outputs
   void ComputeOutputs();
@@ -147,7 +147,7 @@ class XCOTBitSender : public BasicOTSender {
  public:
   XCOTBitSender(std::size_t ot_id, std::size_t num_ots, std::size_t vector_size,
                 MOTION::OTExtensionSenderData& data,
-                const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   // set the correlations for the OTs in this batch
   void SetCorrelations(BitVector<>&& correlations) {
@@ -193,7 +193,7 @@ class XCOTBitReceiver : public BasicOTReceiver {
  public:
   XCOTBitReceiver(std::size_t ot_id, std::size_t num_ots, std::size_t vector_size,
                   MOTION::OTExtensionReceiverData& data,
-                  const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                  const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   // compute the receiver's outputs
   void ComputeOutputs();
@@ -219,14 +219,19 @@ class XCOTBitReceiver : public BasicOTReceiver {
 };
 
 // sender implementation of batched additive-correlated ots
+//
+// With seed compression, the OT extension only stores a 128 bit seed per OT
+// which is expanded to the vector_size values when they are needed, i.e., in
+// the streaming SendMessages and ComputeOutputs.  The other methods are not
+// supported then.
 template <typename T>  //, typename U = is_unsigned_int_t<T>>
 class ACOTSender : public BasicOTSender {
   using enabled_t_ = is_unsigned_int_t<T>;
 
  public:
   ACOTSender(std::size_t ot_id, std::size_t num_ots, std::size_t vector_size,
-             MOTION::OTExtensionSenderData &data,
-             const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+             bool seed_compression, MOTION::OTExtensionSenderData &data,
+             const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
   // set the correlations for the OTs in this batch
   void SetCorrelations(std::vector<T> &&correlations) {
@@ -253,6 +258,22 @@ class ACOTSender : public BasicOTSender {
   // send the sender's messages
   void SendMessages() const;
 
+  // Alternative to SetCorrelations() and SendMessages() which does not store
+  // the correlations: get_correlations(ot_i, buffer) writes the vector_size
+  // correlations of OT ot_i to the buffer.  It may be called concurrently for
+  // different OTs.
+  void SendMessages(const std::function<void(std::size_t, T *)> &get_correlations) const;
+
+  // Alternative to ComputeOutputs() and GetOutputs() which does not store the
+  // outputs: callback(ot_i, outputs) is called with the vector_size outputs of
+  // each OT.  The OTs are split into consecutive blocks of block_size OTs
+  // which are processed in parallel, and the OTs of a block are passed in
+  // order by the same thread.  The OT extension outputs of each OT are
+  // released after the callback, so this needs to be called after
+  // SendMessages, and only once.
+  void ComputeOutputs(std::size_t block_size,
+                      const std::function<void(std::size_t, const T *)> &callback);
+
   // clear stored data s.t. this handle can be used again
   void clear() noexcept {
     correlations_ = {};
@@ -264,6 +285,9 @@ class ACOTSender : public BasicOTSender {
   // dimension of each sender-input/output
   const std::size_t vector_size_;
 
+  // if only seeds are stored by the OT extension
+  const bool seed_compression_;
+
   // the correlation vector
   std::vector<T> correlations_;
 
@@ -274,15 +298,16 @@ class ACOTSender : public BasicOTSender {
   bool outputs_computed_ = false;
 };
 
-// receiver implementation of batched additive-correlated ots
+// receiver implementation of batched additive-correlated ots, see ACOTSender
+// for seed compression
 template <typename T>  //, typename = is_unsigned_int_t<T>>
 class ACOTReceiver : public BasicOTReceiver {
   using enabled_t_ = is_unsigned_int_t<T>;
 
  public:
   ACOTReceiver(std::size_t ot_id, std::size_t num_ots, std::size_t vector_size,
-               MOTION::OTExtensionReceiverData &data,
-               const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+               bool seed_compression, MOTION::OTExtensionReceiverData &data,
+               const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
   // compute the receiver's outputs
   void ComputeOutputs();
@@ -293,6 +318,12 @@ class ACOTReceiver : public BasicOTReceiver {
     return outputs_;
   }
 
+  // Alternative to ComputeOutputs() and GetOutputs() which does not store the
+  // outputs, see ACOTSender::ComputeOutputs(std::size_t, callback).  Can be
+  // called only once, since the OT extension outputs are released.
+  void ComputeOutputs(std::size_t block_size,
+                      const std::function<void(std::size_t, const T *)> &callback);
+
   // clear stored data s.t. this handle can be used again
   void clear() noexcept {
     outputs_ = {};
@@ -304,6 +335,9 @@ class ACOTReceiver : public BasicOTReceiver {
   // dimension of each sender-input/output
   const std::size_t vector_size_;
 
+  // if only seeds are stored by the OT extension
+  const bool seed_compression_;
+
   // future for the sender's message
   ReusableFiberFuture<std::vector<T>> sender_message_future_;
 
@@ -318,7 +352,7 @@ class ACOTReceiver : public BasicOTReceiver {
 class GOT128Sender : public BasicOTSender {
  public:
   GOT128Sender(std::size_t ot_id, std::size_t num_ots, MOTION::OTExtensionSenderData &data,
-               const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+               const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
   // set the message pairs for all OTs in this batch
   void SetInputs(block128_vector &&inputs) { inputs_ = std::move(inputs); }
@@ -339,7 +373,7 @@ class GOT128Sender : public BasicOTSender {
 class GOT128Receiver : public BasicOTReceiver {
  public:
   GOT128Receiver(std::size_t ot_id, std::size_t num_ots, MOTION::OTExtensionReceiverData &data,
-                 const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+                 const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
   // compute the receiver's outputs
   void ComputeOutputs();
@@ -365,7 +399,7 @@ class GOT128Receiver : public BasicOTReceiver {
 class GOTBitSender : public BasicOTSender {
  public:
   GOTBitSender(std::size_t ot_id, std::size_t num_ots, MOTION::OTExtensionSenderData &data,
-               const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+               const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
   // set the message pairs for all OTs in this batch
   void SetInputs(BitVector<> &&inputs) { inputs_ = std::move(inputs); }
@@ -386,7 +420,7 @@ class GOTBitSender : public BasicOTSender {
 class GOTBitReceiver : public BasicOTReceiver {
  public:
   GOTBitReceiver(std::size_t ot_id, std::size_t num_ots, MOTION::OTExtensionReceiverData &data,
-                 const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+                 const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
   // compute the receiver's outputs
   void ComputeOutputs();
@@ -412,7 +446,7 @@ class ROTSender : public BasicOTSender {
  public:
   ROTSender(std::size_t ot_id, std::size_t num_ots, std::size_t vector_size, bool random_choice,
             MOTION::OTExtensionSenderData& data,
-            const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+            const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   // compute the sender's outputs
   void ComputeOutputs();
@@ -450,7 +484,7 @@ class ROTReceiver : public BasicOTReceiver {
  public:
   ROTReceiver(std::size_t ot_id, std::size_t num_ots, std::size_t vector_size, bool random_choice,
               MOTION::OTExtensionReceiverData& data,
-              const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+              const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   // compute the receiver's outputs
   void ComputeOutputs();
@@ -0,0 +1,513 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ot_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <omp.h>
+
+#include "communication/communication_layer.h"
+#include "communication/compact_message.h"
+#include "communication/message_handler.h"
+#include "crypto/base_ots/base_ot_provider.h"
+#include "crypto/motion_base_provider.h"
+#include "crypto/pseudo_random_generator.h"
+#include "data_storage/base_ot_data.h"
+#include "utility/bit_matrix.h"
+#include "utility/config.h"
+#include "utility/helpers.h"
+#include "utility/logger.h"
+#include "utility/thread.h"
+
+namespace ENCRYPTO::ObliviousTransfer {
+
+namespace {
+
+constexpr std::size_t kappa = 128;
+
+int get_omp_num_threads(std::size_t num_threads) {
+  return num_threads == 0 ? omp_get_max_threads() : static_cast<int>(num_threads);
+}
+
+// Offset into the PRG streams of the base OT keys at which the rows of the
+// given chunk start.  The OT extension of the OTProvider starts at offset 0
+// and advances linearly, so we use the upper half of the counter space to
+// avoid reusing any part of the streams.
+std::size_t get_prg_offset(std::size_t chunk_id, std::size_t chunk_size) {
+  constexpr std::size_t pool_offset = std::size_t(1) << 62;
+  // PRG::Encrypt uses an additional block
+  return pool_offset + chunk_id * (chunk_size / kappa + 1);
+}
+
+void copy_blocks(block128_vector& out, std::size_t out_offset,
+                 const std::vector<BitVector<>>& in, std::size_t in_offset, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[out_offset + i].load_from_memory(in[in_offset + i].GetData().data());
+  }
+}
+
+class OTPoolMessageHandler : public MOTION::Communication::MessageHandler {
+ public:
+  OTPoolMessageHandler(ROTPoolSender& sender, ROTPoolReceiver& receiver)
+      : sender_(sender), receiver_(receiver) {}
+  void received_message(std::size_t, std::vector<std::uint8_t>&& raw_message) override {
+    const auto message =
+        MOTION::Communication::ParseCompactMessage(raw_message.data(), raw_message.size());
+    if (!message.has_value()) {
+      throw std::runtime_error("received malformed OT pool message");
+    }
+    switch (message->message_type) {
+      case MOTION::Communication::MessageType::OTPoolReceiverMasks:
+        sender_.received_masks(message->id, message->msg_num, message->payload,
+                               message->payload_size);
+        break;
+      case MOTION::Communication::MessageType::OTPoolSenderAck:
+        receiver_.received_ack(message->id);
+        break;
+      default:
+        throw std::runtime_error("received malformed OT pool message");
+    }
+  }
+
+ private:
+  ROTPoolSender& sender_;
+  ROTPoolReceiver& receiver_;
+};
+
+}  // namespace
+
+ROTPool::ROTPool(const OTPoolConfig& config, std::size_t party_id,
+                 std::shared_ptr<MOTION::Logger> logger)
+    : config_(config), party_id_(party_id), logger_(std::move(logger)) {
+  if (config_.chunk_size == 0 || config_.chunk_size % kappa != 0) {
+    throw std::invalid_argument(fmt::format(
+        "OT pool chunk size needs to be a positive multiple of {}, got {}", kappa,
+        config_.chunk_size));
+  }
+  if (config_.max_chunks == 0) {
+    throw std::invalid_argument("OT pool needs to buffer at least one chunk");
+  }
+}
+
+ROTPool::~ROTPool() { stop(); }
+
+void ROTPool::start() {
+  if (thread_.joinable()) {
+    throw std::logic_error("OT pool has already been started");
+  }
+  thread_ = std::thread([this] { run(); });
+  thread_set_name(thread_, fmt::format("ot_pool-{}", party_id_));
+}
+
+void ROTPool::stop() {
+  {
+    std::scoped_lock lock(mutex_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+OTPoolStatistics ROTPool::get_statistics() const {
+  std::scoped_lock lock(mutex_);
+  auto statistics = statistics_;
+  statistics.num_ots_available = num_available_;
+  return statistics;
+}
+
+void ROTPool::run() {
+  try {
+    while (true) {
+      std::unique_lock lock(mutex_);
+      cv_.wait(lock, [this] { return stopped_ || needs_chunk(); });
+      if (stopped_) {
+        return;
+      }
+      const auto chunk_id = next_chunk_id_;
+      lock.unlock();
+
+      const auto start_time = std::chrono::steady_clock::now();
+      Chunk chunk;
+      generate_chunk(chunk_id, chunk);
+      const auto end_time = std::chrono::steady_clock::now();
+
+      lock.lock();
+      chunks_.emplace_back(std::move(chunk));
+      ++next_chunk_id_;
+      num_available_ += config_.chunk_size;
+      ++statistics_.num_chunks_generated;
+      statistics_.num_ots_generated += config_.chunk_size;
+      statistics_.max_ots_available = std::max(statistics_.max_ots_available, num_available_);
+      statistics_.generation_time_ms +=
+          std::chrono::duration<double, std::milli>(end_time - start_time).count();
+      lock.unlock();
+      cv_.notify_all();
+
+      if constexpr (MOTION::MOTION_DEBUG) {
+        if (logger_) {
+          logger_->LogDebug(fmt::format("OT pool for party {}: generated chunk {}", party_id_,
+                                        chunk_id));
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    if (logger_) {
+      logger_->LogError(fmt::format("OT pool for party {} failed: {}", party_id_, e.what()));
+    }
+    {
+      std::scoped_lock lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+  }
+}
+
+std::size_t ROTPool::acquire(
+    std::size_t num_ots,
+    const std::function<void(const Chunk&, std::size_t, std::size_t, std::size_t)>& callback) {
+  std::unique_lock lock(mutex_);
+  const auto offset = next_offset_;
+  next_offset_ += num_ots;
+  ++statistics_.num_acquisitions;
+
+  bool stalled = false;
+  const auto num_chunks_consumed_before = num_chunks_consumed_;
+  std::size_t position = 0;
+  while (position < num_ots) {
+    if (chunks_.empty()) {
+      if (stopped_) {
+        throw std::logic_error(
+            fmt::format("OT pool for party {} has been stopped", party_id_));
+      }
+      if (!stalled) {
+        ++statistics_.num_stalls;
+        stalled = true;
+      }
+      // tell the generator how many OTs we are waiting for
+      demand_ = num_ots - position;
+      cv_.notify_all();
+      const auto start_time = std::chrono::steady_clock::now();
+      cv_.wait(lock, [this] { return stopped_ || !chunks_.empty(); });
+      const auto end_time = std::chrono::steady_clock::now();
+      statistics_.stall_time_ms +=
+          std::chrono::duration<double, std::milli>(end_time - start_time).count();
+      continue;
+    }
+    auto& chunk = chunks_.front();
+    const auto count = std::min(num_ots - position, config_.chunk_size - chunk.num_consumed);
+    callback(chunk, chunk.num_consumed, position, count);
+    chunk.num_consumed += count;
+    position += count;
+    num_available_ -= count;
+    if (chunk.num_consumed == config_.chunk_size) {
+      chunks_.pop_front();
+      ++num_chunks_consumed_;
+    }
+  }
+  demand_ = 0;
+  statistics_.num_ots_consumed += num_ots;
+  if (statistics_.num_acquisitions == 1 || num_available_ < statistics_.min_ots_available) {
+    statistics_.min_ots_available = num_available_;
+  }
+  const auto num_chunks_consumed = num_chunks_consumed_;
+  lock.unlock();
+  // the generator might need to refill the pool
+  cv_.notify_all();
+  if (num_chunks_consumed != num_chunks_consumed_before) {
+    consumed_chunks(num_chunks_consumed);
+  }
+  return offset;
+}
+
+ROTPoolSender::ROTPoolSender(const OTPoolConfig& config,
+                             const MOTION::BaseOTsReceiverData& base_ots_data,
+                             MOTION::Crypto::MotionBaseProvider& motion_base_provider,
+                             std::function<void(std::vector<std::uint8_t>&&)> Send,
+                             std::size_t party_id, std::shared_ptr<MOTION::Logger> logger)
+    : ROTPool(config, party_id, std::move(logger)),
+      base_ots_data_(base_ots_data),
+      motion_base_provider_(motion_base_provider),
+      Send_(std::move(Send)) {}
+
+// the background thread needs to be stopped before the members are destroyed
+ROTPoolSender::~ROTPoolSender() { stop(); }
+
+ROTPoolSenderRange ROTPoolSender::acquire(std::size_t num_ots) {
+  ROTPoolSenderRange range;
+  range.messages_0_ = block128_vector(num_ots);
+  range.messages_1_ = block128_vector(num_ots);
+  range.offset_ = ROTPool::acquire(num_ots, [&range](auto& chunk, auto chunk_i, auto range_i,
+                                                     auto count) {
+    copy_blocks(range.messages_0_, range_i, chunk.messages_0, chunk_i, count);
+    copy_blocks(range.messages_1_, range_i, chunk.messages_1, chunk_i, count);
+  });
+  return range;
+}
+
+void ROTPoolSender::received_masks(std::size_t chunk_id, std::size_t row,
+                                   const std::uint8_t* data, std::size_t size) {
+  if (row >= kappa || size != config_.chunk_size / 8) {
+    throw std::runtime_error(fmt::format(
+        "received malformed OT pool masks: row {} of size {} B", row, size));
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    if (chunk_id < next_chunk_id_) {
+      throw std::runtime_error(
+          fmt::format("received OT pool masks for already generated chunk {}", chunk_id));
+    }
+    // the receiver has to wait for our acknowledgements
+    if (chunk_id >= num_chunks_consumed_ + config_.max_chunks) {
+      throw std::runtime_error(fmt::format(
+          "received OT pool masks for chunk {} while only {} chunks have been consumed",
+          chunk_id, num_chunks_consumed_));
+    }
+    auto& pending = pending_masks_[chunk_id];
+    if (pending.rows.empty()) {
+      pending.rows.resize(kappa);
+    }
+    if (pending.rows[row].GetSize() != 0) {
+      throw std::runtime_error(
+          fmt::format("received OT pool masks for row {} of chunk {} twice", row, chunk_id));
+    }
+    pending.rows[row] = AlignedBitVector(reinterpret_cast<const std::byte*>(data),
+                                         config_.chunk_size);
+    ++pending.num_received;
+  }
+  cv_.notify_all();
+}
+
+bool ROTPoolSender::needs_chunk() const {
+  // the receiver decides when a chunk is generated
+  auto it = pending_masks_.find(next_chunk_id_);
+  return it != pending_masks_.end() && it->second.num_received == kappa;
+}
+
+void ROTPoolSender::consumed_chunks(std::size_t num_chunks_consumed) {
+  // acknowledgements are cumulative, so reordered messages are harmless
+  Send_(MOTION::Communication::BuildCompactMessage(
+      MOTION::Communication::MessageType::OTPoolSenderAck, num_chunks_consumed, 0, nullptr, 0));
+}
+
+void ROTPoolSender::generate_chunk(std::size_t chunk_id, Chunk& chunk) {
+  const auto chunk_size = config_.chunk_size;
+  const auto byte_size = chunk_size / 8;
+
+  PendingMasks masks;
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = pending_masks_.find(chunk_id);
+    masks = std::move(it->second);
+    pending_masks_.erase(it);
+  }
+
+  // q_j = PRG(s_{j,c_j}) XOR (c_j * u_j)
+  std::vector<AlignedBitVector> v(kappa);
+  const auto prg_offset = get_prg_offset(chunk_id, chunk_size);
+#pragma omp parallel num_threads(get_omp_num_threads(config_.num_threads))
+  {
+    PRG prg_var_key;
+#pragma omp for
+    for (std::size_t j = 0; j < kappa; ++j) {
+      prg_var_key.SetKey(base_ots_data_.messages_c_.at(j).data());
+      prg_var_key.SetOffset(prg_offset);
+      v[j] = AlignedBitVector(prg_var_key.Encrypt(byte_size), chunk_size);
+      if (base_ots_data_.c_.Get(j)) {
+        v[j] ^= masks.rows[j];
+      }
+    }
+  }
+
+  std::array<const std::byte*, kappa> ptrs;
+  for (std::size_t j = 0; j < kappa; ++j) {
+    ptrs[j] = v[j].GetData().data();
+  }
+
+  PRG prg_fixed_key;
+  prg_fixed_key.SetKey(motion_base_provider_.get_aes_fixed_key().data());
+  const std::vector<std::size_t> bitlengths(chunk_size, kappa);
+  chunk.messages_0.resize(chunk_size);
+  chunk.messages_1.resize(chunk_size);
+  BitMatrix::SenderTransposeAndEncrypt(ptrs, chunk.messages_0, chunk.messages_1,
+                                       base_ots_data_.c_, prg_fixed_key, chunk_size, bitlengths,
+                                       get_omp_num_threads(config_.num_threads));
+}
+
+ROTPoolReceiver::ROTPoolReceiver(const OTPoolConfig& config,
+                                 const MOTION::BaseOTsSenderData& base_ots_data,
+                                 MOTION::Crypto::MotionBaseProvider& motion_base_provider,
+                                 std::function<void(std::vector<std::uint8_t>&&)> Send,
+                                 std::size_t party_id, std::shared_ptr<MOTION::Logger> logger)
+    : ROTPool(config, party_id, std::move(logger)),
+      base_ots_data_(base_ots_data),
+      motion_base_provider_(motion_base_provider),
+      Send_(std::move(Send)) {}
+
+// the background thread needs to be stopped before the members are destroyed
+ROTPoolReceiver::~ROTPoolReceiver() { stop(); }
+
+ROTPoolReceiverRange ROTPoolReceiver::acquire(std::size_t num_ots) {
+  ROTPoolReceiverRange range;
+  range.choices_.Reserve(MOTION::Helpers::Convert::BitsToBytes(num_ots));
+  range.messages_ = block128_vector(num_ots);
+  range.offset_ = ROTPool::acquire(num_ots, [&range](auto& chunk, auto chunk_i, auto range_i,
+                                                     auto count) {
+    range.choices_.Append(chunk.choices.Subset(chunk_i, chunk_i + count));
+    copy_blocks(range.messages_, range_i, chunk.messages_0, chunk_i, count);
+  });
+  return range;
+}
+
+void ROTPoolReceiver::received_ack(std::size_t num_chunks_consumed_by_sender) {
+  {
+    std::scoped_lock lock(mutex_);
+    num_chunks_consumed_by_sender_ =
+        std::max(num_chunks_consumed_by_sender_, num_chunks_consumed_by_sender);
+  }
+  cv_.notify_all();
+}
+
+bool ROTPoolReceiver::needs_chunk() const {
+  const auto num_available = get_num_available_unlocked();
+  // back-pressure: the sender must not hold more than max_chunks chunks
+  return get_num_chunks_unlocked() < config_.max_chunks &&
+         next_chunk_id_ < num_chunks_consumed_by_sender_ + config_.max_chunks &&
+         (num_available < config_.low_water_mark || num_available < demand_);
+}
+
+void ROTPoolReceiver::generate_chunk(std::size_t chunk_id, Chunk& chunk) {
+  const auto chunk_size = config_.chunk_size;
+  const auto byte_size = chunk_size / 8;
+
+  // random choices r
+  chunk.choices = BitVector<>::Random(chunk_size);
+  const AlignedBitVector choices(chunk.choices);
+
+  // t_j = PRG(s_{j,0}), u_j = t_j XOR r XOR PRG(s_{j,1})
+  std::vector<AlignedBitVector> v(kappa);
+  const auto prg_offset = get_prg_offset(chunk_id, chunk_size);
+#pragma omp parallel num_threads(get_omp_num_threads(config_.num_threads))
+  {
+    PRG prg_var_key;
+#pragma omp for
+    for (std::size_t j = 0; j < kappa; ++j) {
+      prg_var_key.SetKey(base_ots_data_.messages_0_.at(j).data());
+      prg_var_key.SetOffset(prg_offset);
+      v[j] = AlignedBitVector(prg_var_key.Encrypt(byte_size), chunk_size);
+      auto u = v[j];
+      u ^= choices;
+      prg_var_key.SetKey(base_ots_data_.messages_1_.at(j).data());
+      prg_var_key.SetOffset(prg_offset);
+      u ^= AlignedBitVector(prg_var_key.Encrypt(byte_size), chunk_size);
+      Send_(MOTION::Communication::BuildCompactMessage(
+          MOTION::Communication::MessageType::OTPoolReceiverMasks, chunk_id, j,
+          reinterpret_cast<const std::uint8_t*>(u.GetData().data()), byte_size));
+    }
+  }
+
+  std::array<const std::byte*, kappa> ptrs;
+  for (std::size_t j = 0; j < kappa; ++j) {
+    ptrs[j] = v[j].GetData().data();
+  }
+
+  PRG prg_fixed_key;
+  prg_fixed_key.SetKey(motion_base_provider_.get_aes_fixed_key().data());
+  const std::vector<std::size_t> bitlengths(chunk_size, kappa);
+  chunk.messages_0.resize(chunk_size);
+  BitMatrix::ReceiverTransposeAndEncrypt(ptrs, chunk.messages_0, prg_fixed_key, chunk_size,
+                                         bitlengths, get_omp_num_threads(config_.num_threads));
+}
+
+ROTPoolManager::ROTPoolManager(MOTION::Communication::CommunicationLayer& communication_layer,
+                               const MOTION::BaseOTProvider& base_ot_provider,
+                               MOTION::Crypto::MotionBaseProvider& motion_base_provider,
+                               const OTPoolConfig& config,
+                               std::shared_ptr<MOTION::Logger> logger)
+    : communication_layer_(communication_layer),
+      base_ot_provider_(base_ot_provider),
+      motion_base_provider_(motion_base_provider),
+      num_parties_(communication_layer_.get_num_parties()),
+      senders_(num_parties_),
+      receivers_(num_parties_) {
+  auto my_id = communication_layer_.get_my_id();
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == my_id) {
+      continue;
+    }
+    auto send_func = [this, party_id](std::vector<std::uint8_t>&& message) {
+      communication_layer_.send_message(party_id, std::move(message));
+    };
+    const auto& base_ots_data = base_ot_provider_.get_base_ots_data(party_id);
+    senders_.at(party_id) =
+        std::make_unique<ROTPoolSender>(config, base_ots_data.GetReceiverData(),
+                                        motion_base_provider_, send_func, party_id, logger);
+    receivers_.at(party_id) =
+        std::make_unique<ROTPoolReceiver>(config, base_ots_data.GetSenderData(),
+                                          motion_base_provider_, send_func, party_id, logger);
+  }
+
+  communication_layer_.register_message_handler(
+      [this](std::size_t party_id) {
+        return std::make_shared<OTPoolMessageHandler>(*senders_.at(party_id),
+                                                      *receivers_.at(party_id));
+      },
+      {MOTION::Communication::MessageType::OTPoolReceiverMasks,
+       MOTION::Communication::MessageType::OTPoolSenderAck});
+}
+
+ROTPoolManager::~ROTPoolManager() {
+  stop();
+  communication_layer_.deregister_message_handler(
+      {MOTION::Communication::MessageType::OTPoolReceiverMasks,
+       MOTION::Communication::MessageType::OTPoolSenderAck});
+}
+
+void ROTPoolManager::start() {
+  motion_base_provider_.wait_setup();
+  base_ot_provider_.wait_setup();
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == communication_layer_.get_my_id()) {
+      continue;
+    }
+    senders_.at(party_id)->start();
+    receivers_.at(party_id)->start();
+  }
+}
+
+void ROTPoolManager::stop() {
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == communication_layer_.get_my_id()) {
+      continue;
+    }
+    senders_.at(party_id)->stop();
+    receivers_.at(party_id)->stop();
+  }
+}
+
+}  // namespace ENCRYPTO::ObliviousTransfer
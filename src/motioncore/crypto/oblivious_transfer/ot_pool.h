@@ -0,0 +1,268 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "utility/bit_vector.h"
+#include "utility/block.h"
+
+namespace MOTION {
+
+class BaseOTProvider;
+struct BaseOTsReceiverData;
+struct BaseOTsSenderData;
+class Logger;
+
+namespace Communication {
+class CommunicationLayer;
+}
+
+namespace Crypto {
+class MotionBaseProvider;
+}
+
+}  // namespace MOTION
+
+namespace ENCRYPTO::ObliviousTransfer {
+
+// Pool of random OTs which is refilled in the background
+//
+// Instead of registering all OTs before the setup phase, the OTs are
+// generated by a background thread in chunks of a fixed size and handed out
+// on demand.  The receiver side of each pair of parties decides when a new
+// chunk is generated, i.e., whenever fewer than low_water_mark OTs are
+// available or an acquisition is waiting, and at most max_chunks chunks are
+// buffered.  The sender side follows as soon as the receiver masks of a
+// chunk have arrived.  The sender acknowledges each chunk it has consumed,
+// and the receiver only generates a chunk if the sender has consumed all but
+// max_chunks - 1 of the previous ones, so the sender also never holds more
+// than max_chunks chunks (generated or waiting for masks).
+//
+// Since the OTs are random, their consumers need to derandomize them.  Both
+// parties need to acquire the same numbers of OTs in the same order from
+// their sender and receiver pools, respectively.
+
+struct OTPoolConfig {
+  // number of OTs generated at once, needs to be a positive multiple of 128
+  std::size_t chunk_size = 1 << 16;
+  // generate a new chunk if fewer OTs are available
+  std::size_t low_water_mark = 1 << 16;
+  // maximum number of buffered chunks
+  std::size_t max_chunks = 4;
+  // number of threads used for the computation of a chunk, 0 selects the
+  // OpenMP default
+  std::size_t num_threads = 1;
+};
+
+struct OTPoolStatistics {
+  std::size_t num_chunks_generated = 0;
+  std::size_t num_ots_generated = 0;
+  std::size_t num_ots_consumed = 0;
+  // occupancy of the pool: currently available OTs and the minimum and
+  // maximum number of available OTs observed after each acquisition and
+  // after each generated chunk, respectively
+  std::size_t num_ots_available = 0;
+  std::size_t min_ots_available = 0;
+  std::size_t max_ots_available = 0;
+  std::size_t num_acquisitions = 0;
+  // number of acquisitions which had to wait for OTs to be generated
+  std::size_t num_stalls = 0;
+  double stall_time_ms = 0.0;
+  double generation_time_ms = 0.0;
+};
+
+// random OTs (m_0, m_1) of the sender
+struct ROTPoolSenderRange {
+  // position of the first OT in the stream of OTs generated by the pool
+  std::size_t offset_;
+  block128_vector messages_0_;
+  block128_vector messages_1_;
+};
+
+// random OTs (c, m_c) of the receiver
+struct ROTPoolReceiverRange {
+  // position of the first OT in the stream of OTs generated by the pool
+  std::size_t offset_;
+  BitVector<> choices_;
+  block128_vector messages_;
+};
+
+class ROTPool {
+ public:
+  virtual ~ROTPool();
+
+  ROTPool(const ROTPool&) = delete;
+  ROTPool& operator=(const ROTPool&) = delete;
+
+  // start/stop the background thread
+  void start();
+  void stop();
+
+  OTPoolStatistics get_statistics() const;
+  const OTPoolConfig& get_config() const noexcept { return config_; }
+
+ protected:
+  struct Chunk {
+    std::size_t num_consumed = 0;
+    BitVector<> choices;
+    std::vector<BitVector<>> messages_0;
+    std::vector<BitVector<>> messages_1;
+  };
+
+  ROTPool(const OTPoolConfig&, std::size_t party_id, std::shared_ptr<MOTION::Logger>);
+
+  // Take num_ots OTs from the pool and pass them to the callback, which is
+  // called as callback(chunk, index in the chunk, index in the range, count).
+  // Blocks until enough OTs have been generated.  Returns the offset of the
+  // first OT.
+  std::size_t acquire(std::size_t num_ots,
+                      const std::function<void(const Chunk&, std::size_t, std::size_t,
+                                               std::size_t)>& callback);
+
+  // Compute the OTs of the given chunk.  Called by the background thread
+  // without holding the mutex.
+  virtual void generate_chunk(std::size_t chunk_id, Chunk&) = 0;
+  // Called with the mutex held: whether the next chunk should be generated now.
+  virtual bool needs_chunk() const = 0;
+  // Called by acquire without holding the mutex if chunks have been used up.
+  virtual void consumed_chunks([[maybe_unused]] std::size_t num_chunks_consumed) {}
+
+  std::size_t get_num_available_unlocked() const noexcept { return num_available_; }
+  std::size_t get_num_chunks_unlocked() const noexcept { return chunks_.size(); }
+
+  const OTPoolConfig config_;
+  const std::size_t party_id_;
+  std::shared_ptr<MOTION::Logger> logger_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+  // number of OTs a blocked acquisition is still waiting for
+  std::size_t demand_ = 0;
+  // id of the chunk which is generated next
+  std::size_t next_chunk_id_ = 0;
+  // number of chunks which have been used up by acquisitions
+  std::size_t num_chunks_consumed_ = 0;
+
+ private:
+  void run();
+
+  std::deque<Chunk> chunks_;
+  std::size_t num_available_ = 0;
+  std::size_t next_offset_ = 0;
+  OTPoolStatistics statistics_;
+  std::thread thread_;
+};
+
+class ROTPoolSender final : public ROTPool {
+ public:
+  ROTPoolSender(const OTPoolConfig&, const MOTION::BaseOTsReceiverData&,
+                MOTION::Crypto::MotionBaseProvider&,
+                std::function<void(std::vector<std::uint8_t>&&)> Send, std::size_t party_id,
+                std::shared_ptr<MOTION::Logger>);
+
+  ~ROTPoolSender() override;
+
+  ROTPoolSenderRange acquire(std::size_t num_ots);
+
+  // store a row of receiver masks (called by the message handler)
+  void received_masks(std::size_t chunk_id, std::size_t row, const std::uint8_t* data,
+                      std::size_t size);
+
+ private:
+  void generate_chunk(std::size_t chunk_id, Chunk&) override;
+  bool needs_chunk() const override;
+  void consumed_chunks(std::size_t num_chunks_consumed) override;
+
+  struct PendingMasks {
+    std::vector<AlignedBitVector> rows;
+    std::size_t num_received = 0;
+  };
+
+  const MOTION::BaseOTsReceiverData& base_ots_data_;
+  MOTION::Crypto::MotionBaseProvider& motion_base_provider_;
+  std::function<void(std::vector<std::uint8_t>&&)> Send_;
+  // at most max_chunks entries (cf. received_masks)
+  std::unordered_map<std::size_t, PendingMasks> pending_masks_;
+};
+
+class ROTPoolReceiver final : public ROTPool {
+ public:
+  ROTPoolReceiver(const OTPoolConfig&, const MOTION::BaseOTsSenderData&,
+                  MOTION::Crypto::MotionBaseProvider&,
+                  std::function<void(std::vector<std::uint8_t>&&)> Send, std::size_t party_id,
+                  std::shared_ptr<MOTION::Logger>);
+
+  ~ROTPoolReceiver() override;
+
+  ROTPoolReceiverRange acquire(std::size_t num_ots);
+
+  // the sender has consumed the given number of chunks (called by the message
+  // handler)
+  void received_ack(std::size_t num_chunks_consumed_by_sender);
+
+ private:
+  void generate_chunk(std::size_t chunk_id, Chunk&) override;
+  bool needs_chunk() const override;
+
+  const MOTION::BaseOTsSenderData& base_ots_data_;
+  MOTION::Crypto::MotionBaseProvider& motion_base_provider_;
+  std::function<void(std::vector<std::uint8_t>&&)> Send_;
+  std::size_t num_chunks_consumed_by_sender_ = 0;
+};
+
+// Creates a pair of OT pools for each other party.  The base OTs need to be
+// computed before start() is called.
+class ROTPoolManager {
+ public:
+  ROTPoolManager(MOTION::Communication::CommunicationLayer&, const MOTION::BaseOTProvider&,
+                 MOTION::Crypto::MotionBaseProvider&, const OTPoolConfig&,
+                 std::shared_ptr<MOTION::Logger>);
+  ~ROTPoolManager();
+
+  // wait for the base OTs and start the background threads of all pools
+  void start();
+  void stop();
+
+  ROTPoolSender& get_sender(std::size_t party_id) { return *senders_.at(party_id); }
+  ROTPoolReceiver& get_receiver(std::size_t party_id) { return *receivers_.at(party_id); }
+
+ private:
+  MOTION::Communication::CommunicationLayer& communication_layer_;
+  const MOTION::BaseOTProvider& base_ot_provider_;
+  MOTION::Crypto::MotionBaseProvider& motion_base_provider_;
+  std::size_t num_parties_;
+  std::vector<std::unique_ptr<ROTPoolSender>> senders_;
+  std::vector<std::unique_ptr<ROTPoolReceiver>> receivers_;
+};
+
+}  // namespace ENCRYPTO::ObliviousTransfer
@@ -24,16 +24,20 @@
 
 #include "ot_provider.h"
 
+#include <omp.h>
+
 #include "communication/communication_layer.h"
-#include "communication/fbs_headers/ot_extension_generated.h"
+#include "communication/compact_message.h"
 #include "communication/message_handler.h"
 #include "communication/ot_extension_message.h"
 #include "crypto/base_ots/base_ot_provider.h"
 #include "crypto/motion_base_provider.h"
 #include "crypto/pseudo_random_generator.h"
+#include "crypto/trusted_dealer.h"
 #include "data_storage/base_ot_data.h"
 #include "data_storage/ot_extension_data.h"
 #include "ot_flavors.h"
+#include "ot_pool.h"
 #include "statistics/run_time_stats.h"
 #include "utility/bit_matrix.h"
 #include "utility/config.h"
@@ -42,7 +46,12 @@
 
 namespace ENCRYPTO::ObliviousTransfer {
 
-OTProvider::OTProvider(std::function<void(flatbuffers::FlatBufferBuilder &&)> Send,
+// number of threads for the OpenMP regions, where 0 selects the default
+static int get_omp_num_threads(std::size_t num_threads) {
+  return num_threads == 0 ? omp_get_max_threads() : static_cast<int>(num_threads);
+}
+
+OTProvider::OTProvider(std::function<void(std::vector<std::uint8_t> &&)> Send,
                        MOTION::OTExtensionData &data, std::size_t party_id,
                        std::shared_ptr<MOTION::Logger> logger)
     : Send_(Send),
@@ -67,21 +76,21 @@ void OTProvider::WaitSetup() const {
 }
 
 template <typename T>
-[[nodiscard]] std::unique_ptr<ACOTSender<T>> OTProvider::RegisterSendACOT(std::size_t num_ots,
-                                                                          std::size_t vector_size) {
-  return sender_provider_.RegisterACOT<T>(num_ots, vector_size, Send_);
+[[nodiscard]] std::unique_ptr<ACOTSender<T>> OTProvider::RegisterSendACOT(
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression) {
+  return sender_provider_.RegisterACOT<T>(num_ots, vector_size, seed_compression, Send_);
 }
 
 template std::unique_ptr<ACOTSender<std::uint8_t>> OTProvider::RegisterSendACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 template std::unique_ptr<ACOTSender<std::uint16_t>> OTProvider::RegisterSendACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 template std::unique_ptr<ACOTSender<std::uint32_t>> OTProvider::RegisterSendACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 template std::unique_ptr<ACOTSender<std::uint64_t>> OTProvider::RegisterSendACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 template std::unique_ptr<ACOTSender<__uint128_t>> OTProvider::RegisterSendACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 
 [[nodiscard]] std::unique_ptr<GOT128Sender> OTProvider::RegisterSendGOT128(std::size_t num_ots) {
   return sender_provider_.RegisterGOT128(num_ots, Send_);
@@ -109,20 +118,20 @@ template std::unique_ptr<ACOTSender<__uint128_t>> OTProvider::RegisterSendACOT(
 
 template <typename T>
 [[nodiscard]] std::unique_ptr<ACOTReceiver<T>> OTProvider::RegisterReceiveACOT(
-    std::size_t num_ots, std::size_t vector_size) {
-  return receiver_provider_.RegisterACOT<T>(num_ots, vector_size, Send_);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression) {
+  return receiver_provider_.RegisterACOT<T>(num_ots, vector_size, seed_compression, Send_);
 }
 
 template std::unique_ptr<ACOTReceiver<std::uint8_t>> OTProvider::RegisterReceiveACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 template std::unique_ptr<ACOTReceiver<std::uint16_t>> OTProvider::RegisterReceiveACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 template std::unique_ptr<ACOTReceiver<std::uint32_t>> OTProvider::RegisterReceiveACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 template std::unique_ptr<ACOTReceiver<std::uint64_t>> OTProvider::RegisterReceiveACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 template std::unique_ptr<ACOTReceiver<__uint128_t>> OTProvider::RegisterReceiveACOT(
-    std::size_t num_ots, std::size_t vector_size);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression);
 
 [[nodiscard]] std::unique_ptr<GOT128Receiver> OTProvider::RegisterReceiveGOT128(
     std::size_t num_ots) {
@@ -141,7 +150,7 @@ template std::unique_ptr<ACOTReceiver<__uint128_t>> OTProvider::RegisterReceiveA
 }
 
 OTProviderFromOTExtension::OTProviderFromOTExtension(
-    std::function<void(flatbuffers::FlatBufferBuilder &&)> Send, MOTION::OTExtensionData &data,
+    std::function<void(std::vector<std::uint8_t> &&)> Send, MOTION::OTExtensionData &data,
     const MOTION::BaseOTsData &base_ot_data,
     MOTION::Crypto::MotionBaseProvider &motion_base_provider, std::size_t party_id,
     std::shared_ptr<MOTION::Logger> logger)
@@ -193,18 +202,25 @@ void OTProviderFromOTExtension::SendSetup() {
   // XXX: note that rows/columns are swapped compared to the ALSZ paper
   std::vector<AlignedBitVector> v(kappa);
 
-  // PRG which is used to expand the keys we got from the base OTs
-  PRG prgs_var_key;
+  const int num_threads = get_omp_num_threads(num_threads_);
+
   //// fill the rows of the matrix
-  for (i = 0; i < kappa; ++i) {
-    // use the key we got from the base OTs as seed
-    prgs_var_key.SetKey(base_ots_rcv.messages_c_.at(i).data());
-    // change the offset in the output stream since we might have already used
-    // the same base OTs previously
-    prgs_var_key.SetOffset(base_ots_rcv.consumed_offset_);
-    // expand the seed such that it fills one row of the matrix
-    auto row(prgs_var_key.Encrypt(byte_size));
-    v[i] = AlignedBitVector(std::move(row), bit_size_padded);
+  // the rows are independent, so they are distributed among the threads
+#pragma omp parallel num_threads(num_threads)
+  {
+    // PRG which is used to expand the keys we got from the base OTs
+    PRG prgs_var_key;
+#pragma omp for
+    for (i = 0; i < kappa; ++i) {
+      // use the key we got from the base OTs as seed
+      prgs_var_key.SetKey(base_ots_rcv.messages_c_.at(i).data());
+      // change the offset in the output stream since we might have already used
+      // the same base OTs previously
+      prgs_var_key.SetOffset(base_ots_rcv.consumed_offset_);
+      // expand the seed such that it fills one row of the matrix
+      auto row(prgs_var_key.Encrypt(byte_size));
+      v[i] = AlignedBitVector(std::move(row), bit_size_padded);
+    }
   }
   ot_ext_snd.consumed_offset_base_ots_ += bit_size_padded / kappa;
 
@@ -244,7 +260,8 @@ void OTProviderFromOTExtension::SendSetup() {
   // transpose the bit matrix
   // XXX: figure out how the result looks like
   BitMatrix::SenderTransposeAndEncrypt(ptrs, ot_ext_snd.y0_, ot_ext_snd.y1_, base_ots_rcv.c_,
-                                       prg_fixed_key, bit_size_padded, ot_ext_snd.bitlengths_);
+                                       prg_fixed_key, bit_size_padded, ot_ext_snd.bitlengths_,
+                                       num_threads);
   /*
     for (i = 0; i < ot_ext_snd.bitlengths_.size(); ++i) {
       // here we want to store the sender's outputs
@@ -344,34 +361,42 @@ void OTProviderFromOTExtension::ReceiveSetup() {
   std::vector<AlignedBitVector> v(kappa);
 
   // PRG we use with the fixed-key AES function
+  PRG prg_fixed_key;
 
-  // PRG which is used to expand the keys we got from the base OTs
-  PRG prg_fixed_key, prg_var_key;
+  const int num_threads = get_omp_num_threads(num_threads_);
   // fill the rows of the matrix
-  for (i = 0; i < kappa; ++i) {
-    // generate rows of the matrix using the corresponding 0 key
-    // T[j] = PRG(s_{j,0})
-    prg_var_key.SetKey(base_ots_snd.messages_0_.at(i).data());
-    // change the offset in the output stream since we might have already used
-    // the same base OTs previously
-    prg_var_key.SetOffset(base_ots_snd.consumed_offset_);
-    // expand the seed such that it fills one row of the matrix
-    auto row(prg_var_key.Encrypt(byte_size));
-    v.at(i) = AlignedBitVector(std::move(row), bit_size);
-    // take a copy of the row and XOR it with our choices
-    auto u = v.at(i);
-    // u_j = T[j] XOR r
-    u ^= *ot_ext_rcv.random_choices_;
-
-    // now mask the result with random stream expanded from the 1 key
-    // u_j = u_j XOR PRG(s_{j,1})
-    prg_var_key.SetKey(base_ots_snd.messages_1_.at(i).data());
-    prg_var_key.SetOffset(base_ots_snd.consumed_offset_);
-    u ^= AlignedBitVector(prg_var_key.Encrypt(byte_size), bit_size);
-
-    // send this row
-    Send_(MOTION::Communication::BuildOTExtensionMessageReceiverMasks(u.GetData().data(),
-                                                                      u.GetData().size(), i));
+  // the rows are independent, so they are distributed among the threads, and
+  // each row is sent as soon as it is ready
+#pragma omp parallel num_threads(num_threads)
+  {
+    // PRG which is used to expand the keys we got from the base OTs
+    PRG prg_var_key;
+#pragma omp for
+    for (i = 0; i < kappa; ++i) {
+      // generate rows of the matrix using the corresponding 0 key
+      // T[j] = PRG(s_{j,0})
+      prg_var_key.SetKey(base_ots_snd.messages_0_.at(i).data());
+      // change the offset in the output stream since we might have already used
+      // the same base OTs previously
+      prg_var_key.SetOffset(base_ots_snd.consumed_offset_);
+      // expand the seed such that it fills one row of the matrix
+      auto row(prg_var_key.Encrypt(byte_size));
+      v.at(i) = AlignedBitVector(std::move(row), bit_size);
+      // take a copy of the row and XOR it with our choices
+      auto u = v.at(i);
+      // u_j = T[j] XOR r
+      u ^= *ot_ext_rcv.random_choices_;
+
+      // now mask the result with random stream expanded from the 1 key
+      // u_j = u_j XOR PRG(s_{j,1})
+      prg_var_key.SetKey(base_ots_snd.messages_1_.at(i).data());
+      prg_var_key.SetOffset(base_ots_snd.consumed_offset_);
+      u ^= AlignedBitVector(prg_var_key.Encrypt(byte_size), bit_size);
+
+      // send this row
+      Send_(MOTION::Communication::BuildOTExtensionMessageReceiverMasks(u.GetData().data(),
+                                                                        u.GetData().size(), i));
+    }
   }
   ot_ext_rcv.consumed_offset_base_ots_ += bit_size_padded / kappa;
 
@@ -394,7 +419,7 @@ void OTProviderFromOTExtension::ReceiveSetup() {
   const auto &fixed_key_aes_key = motion_base_provider_.get_aes_fixed_key();
   prg_fixed_key.SetKey(fixed_key_aes_key.data());
   BitMatrix::ReceiverTransposeAndEncrypt(ptrs, ot_ext_rcv.outputs_, prg_fixed_key, bit_size_padded,
-                                         ot_ext_rcv.bitlengths_);
+                                         ot_ext_rcv.bitlengths_, num_threads);
   /*BitMatrix::TransposeUsingBitSlicing(ptrs, bit_size_padded);
   for (i = 0; i < ot_ext_rcv.outputs_.size(); ++i) {
     const auto row_i = i % kappa;
@@ -428,9 +453,157 @@ void OTProviderFromOTExtension::ReceiveSetup() {
   }
 }
 
+OTProviderFromDealer::OTProviderFromDealer(std::function<void(std::vector<std::uint8_t> &&)> Send,
+                                           MOTION::OTExtensionData &data,
+                                           const MOTION::Crypto::TrustedDealer &trusted_dealer,
+                                           std::size_t party_id,
+                                           std::shared_ptr<MOTION::Logger> logger)
+    : OTProvider(Send, data, party_id, logger),
+      trusted_dealer_(trusted_dealer),
+      party_id_(party_id) {
+  auto &ot_ext_rcv = data_.GetReceiverData();
+  ot_ext_rcv.real_choices_ = std::make_unique<BitVector<>>();
+}
+
+// expand the random OT outputs y_0 or y_1 of the given bit lengths
+static std::vector<BitVector<>> expand_dealer_ot_outputs(
+    const MOTION::Crypto::TrustedDealer &trusted_dealer, const std::string &label,
+    const std::vector<std::size_t> &bitlengths, std::size_t num_ots) {
+  std::vector<std::size_t> offsets(num_ots + 1, 0);
+  for (std::size_t i = 0; i < num_ots; ++i) {
+    offsets[i + 1] = offsets[i] + MOTION::Helpers::Convert::BitsToBytes(bitlengths[i]);
+  }
+  const auto bytes = trusted_dealer.random_values<std::uint8_t>(label, offsets[num_ots]);
+  const auto *data = reinterpret_cast<const std::byte *>(bytes.data());
+  std::vector<BitVector<>> outputs(num_ots);
+  for (std::size_t i = 0; i < num_ots; ++i) {
+    outputs[i] = BitVector<>(std::vector<std::byte>(data + offsets[i], data + offsets[i + 1]),
+                             bitlengths[i]);
+  }
+  return outputs;
+}
+
+void OTProviderFromDealer::SendSetup() {
+  auto &ot_ext_snd = data_.GetSenderData();
+  const std::size_t bit_size = sender_provider_.GetNumOTs();
+  if (bit_size == 0) {
+    return;
+  }
+  ot_ext_snd.bit_size_ = bit_size;
+
+  const auto label = fmt::format("ot_{}_{}", trusted_dealer_.get_my_id(), party_id_);
+  ot_ext_snd.y0_ =
+      expand_dealer_ot_outputs(trusted_dealer_, label + "_y0", ot_ext_snd.bitlengths_, bit_size);
+  ot_ext_snd.y1_ =
+      expand_dealer_ot_outputs(trusted_dealer_, label + "_y1", ot_ext_snd.bitlengths_, bit_size);
+
+  {
+    std::scoped_lock lock(ot_ext_snd.setup_finished_cond_->GetMutex());
+    ot_ext_snd.setup_finished_ = true;
+  }
+  ot_ext_snd.setup_finished_cond_->NotifyAll();
+}
+
+void OTProviderFromDealer::ReceiveSetup() {
+  auto &ot_ext_rcv = data_.GetReceiverData();
+  const std::size_t bit_size = receiver_provider_.GetNumOTs();
+  if (bit_size == 0) {
+    return;
+  }
+
+  const auto label = fmt::format("ot_{}_{}", party_id_, trusted_dealer_.get_my_id());
+  auto choice_bytes = trusted_dealer_.random_values<std::uint8_t>(
+      label + "_choices", MOTION::Helpers::Convert::BitsToBytes(bit_size));
+  ot_ext_rcv.random_choices_ = std::make_unique<AlignedBitVector>(
+      std::vector<std::byte>(reinterpret_cast<const std::byte *>(choice_bytes.data()),
+                             reinterpret_cast<const std::byte *>(choice_bytes.data()) +
+                                 choice_bytes.size()),
+      bit_size);
+  const auto y0 =
+      expand_dealer_ot_outputs(trusted_dealer_, label + "_y0", ot_ext_rcv.bitlengths_, bit_size);
+  const auto y1 =
+      expand_dealer_ot_outputs(trusted_dealer_, label + "_y1", ot_ext_rcv.bitlengths_, bit_size);
+  for (std::size_t i = 0; i < bit_size; ++i) {
+    ot_ext_rcv.outputs_.at(i) = ot_ext_rcv.random_choices_->Get(i) ? y1[i] : y0[i];
+  }
+
+  {
+    std::scoped_lock lock(ot_ext_rcv.setup_finished_cond_->GetMutex());
+    ot_ext_rcv.setup_finished_ = true;
+  }
+  ot_ext_rcv.setup_finished_cond_->NotifyAll();
+}
+
+OTProviderFromPool::OTProviderFromPool(std::function<void(std::vector<std::uint8_t> &&)> Send,
+                                       MOTION::OTExtensionData &data, ROTPoolSender &sender_pool,
+                                       ROTPoolReceiver &receiver_pool, std::size_t party_id,
+                                       std::shared_ptr<MOTION::Logger> logger)
+    : OTProvider(Send, data, party_id, logger),
+      sender_pool_(sender_pool),
+      receiver_pool_(receiver_pool) {
+  auto &ot_ext_rcv = data_.GetReceiverData();
+  ot_ext_rcv.real_choices_ = std::make_unique<BitVector<>>();
+}
+
+// expand a 128 bit random OT output to the given bit length as the OT extension does
+static BitVector<> expand_pool_ot_output(const block128_t &message, std::size_t bitlen) {
+  constexpr std::size_t kappa = 128;
+  if (bitlen <= kappa) {
+    return BitVector<>(message.byte_array.data(), bitlen);
+  }
+  PRG prg_var_key;
+  prg_var_key.SetKey(message.byte_array.data());
+  return BitVector<>(prg_var_key.Encrypt(MOTION::Helpers::Convert::BitsToBytes(bitlen)), bitlen);
+}
+
+void OTProviderFromPool::SendSetup() {
+  auto &ot_ext_snd = data_.GetSenderData();
+  const std::size_t bit_size = sender_provider_.GetNumOTs();
+  if (bit_size == 0) {
+    return;
+  }
+  ot_ext_snd.bit_size_ = bit_size;
+
+  const auto range = sender_pool_.acquire(bit_size);
+#pragma omp parallel for num_threads(get_omp_num_threads(num_threads_))
+  for (std::size_t i = 0; i < bit_size; ++i) {
+    const auto bitlen = ot_ext_snd.bitlengths_.at(i);
+    ot_ext_snd.y0_[i] = expand_pool_ot_output(range.messages_0_[i], bitlen);
+    ot_ext_snd.y1_[i] = expand_pool_ot_output(range.messages_1_[i], bitlen);
+  }
+
+  {
+    std::scoped_lock lock(ot_ext_snd.setup_finished_cond_->GetMutex());
+    ot_ext_snd.setup_finished_ = true;
+  }
+  ot_ext_snd.setup_finished_cond_->NotifyAll();
+}
+
+void OTProviderFromPool::ReceiveSetup() {
+  auto &ot_ext_rcv = data_.GetReceiverData();
+  const std::size_t bit_size = receiver_provider_.GetNumOTs();
+  if (bit_size == 0) {
+    return;
+  }
+
+  auto range = receiver_pool_.acquire(bit_size);
+  ot_ext_rcv.random_choices_ = std::make_unique<AlignedBitVector>(range.choices_);
+#pragma omp parallel for num_threads(get_omp_num_threads(num_threads_))
+  for (std::size_t i = 0; i < bit_size; ++i) {
+    ot_ext_rcv.outputs_.at(i) =
+        expand_pool_ot_output(range.messages_[i], ot_ext_rcv.bitlengths_.at(i));
+  }
+
+  {
+    std::scoped_lock lock(ot_ext_rcv.setup_finished_cond_->GetMutex());
+    ot_ext_rcv.setup_finished_ = true;
+  }
+  ot_ext_rcv.setup_finished_cond_->NotifyAll();
+}
+
 OTVector::OTVector(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
                    const OTProtocol p,
-                   const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                   const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : ot_id_(ot_id), num_ots_(num_ots), bitlen_(bitlen), p_(p), Send_(Send) {}
 
 const std::vector<BitVector<>> &OTVectorSender::GetOutputs() {
@@ -453,7 +626,7 @@ void OTVectorSender::WaitSetup() { data_.setup_finished_cond_->Wait(); }
 OTVectorSender::OTVectorSender(const std::size_t ot_id, const std::size_t num_ots,
                                const std::size_t bitlen, const OTProtocol p,
                                MOTION::OTExtensionSenderData &data,
-                               const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                               const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : OTVector(ot_id, num_ots, bitlen, p, Send), data_(data) {
   Reserve(ot_id, num_ots, bitlen);
 }
@@ -472,7 +645,7 @@ void OTVectorSender::Reserve(const std::size_t id, const std::size_t num_ots,
 
 GOTVectorSender::GOTVectorSender(const std::size_t ot_id, const std::size_t num_ots,
                                  const std::size_t bitlen, MOTION::OTExtensionSenderData &data,
-                                 const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                                 const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : OTVectorSender(ot_id, num_ots, bitlen, OTProtocol::GOT, data, Send) {
   data_.received_correction_offsets_cond_.emplace(
       ot_id_, std::make_unique<FiberCondition>([ot_id, this]() {
@@ -528,7 +701,7 @@ void GOTVectorSender::SendMessages() {
 COTVectorSender::COTVectorSender(const std::size_t id, const std::size_t num_ots,
                                  const std::size_t bitlen, OTProtocol p,
                                  MOTION::OTExtensionSenderData &data,
-                                 const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                                 const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : OTVectorSender(id, num_ots, bitlen, p, data, Send) {
   if (p == OTProtocol::ACOT &&
       (bitlen != 8u && bitlen != 16u && bitlen != 32u && bitlen != 64u && bitlen != 128)) {
@@ -693,7 +866,7 @@ void COTVectorSender::SendMessages() {
 
 ROTVectorSender::ROTVectorSender(const std::size_t ot_id, const std::size_t num_ots,
                                  const std::size_t bitlen, MOTION::OTExtensionSenderData &data,
-                                 const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+                                 const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : OTVectorSender(ot_id, num_ots, bitlen, OTProtocol::ROT, data, Send) {}
 
 void ROTVectorSender::SetInputs([[maybe_unused]] std::vector<BitVector<>> &&v) {
@@ -713,7 +886,7 @@ void OTVectorReceiver::WaitSetup() { data_.setup_finished_cond_->Wait(); }
 OTVectorReceiver::OTVectorReceiver(const std::size_t ot_id, const std::size_t num_ots,
                                    const std::size_t bitlen, const OTProtocol p,
                                    MOTION::OTExtensionReceiverData &data,
-                                   std::function<void(flatbuffers::FlatBufferBuilder &&)> Send)
+                                   std::function<void(std::vector<std::uint8_t> &&)> Send)
     : OTVector(ot_id, num_ots, bitlen, p, Send), data_(data) {
   Reserve(ot_id, num_ots, bitlen);
 }
@@ -731,7 +904,7 @@ void OTVectorReceiver::Reserve(const std::size_t id, const std::size_t num_ots,
 GOTVectorReceiver::GOTVectorReceiver(
     const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
     MOTION::OTExtensionReceiverData &data,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : OTVectorReceiver(ot_id, num_ots, bitlen, OTProtocol::GOT, data, Send) {
   std::scoped_lock lock(data_.num_messages_mutex_);
   data_.num_messages_.emplace(ot_id_, 2);
@@ -794,7 +967,7 @@ const std::vector<BitVector<>> &GOTVectorReceiver::GetOutputs() {
 COTVectorReceiver::COTVectorReceiver(
     const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen, OTProtocol p,
     MOTION::OTExtensionReceiverData &data,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : OTVectorReceiver(ot_id, num_ots, bitlen, p, data, Send) {
   if (p == OTProtocol::ACOT &&
       (bitlen != 8u && bitlen != 16u && bitlen != 32u && bitlen != 64u && bitlen != 128u)) {
@@ -865,7 +1038,7 @@ const std::vector<BitVector<>> &COTVectorReceiver::GetOutputs() {
 ROTVectorReceiver::ROTVectorReceiver(
     const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
     MOTION::OTExtensionReceiverData &data,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send)
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send)
     : OTVectorReceiver(ot_id, num_ots, bitlen, OTProtocol::ROT, data, Send) {
   Reserve(ot_id, num_ots, bitlen);
 }
@@ -911,7 +1084,7 @@ std::shared_ptr<OTVectorSender> &OTProviderSender::GetOTs(std::size_t offset) {
 
 std::shared_ptr<OTVectorSender> &OTProviderSender::RegisterOTs(
     const std::size_t bitlen, const std::size_t num_ots, const OTProtocol p,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_;
   total_ots_count_ += num_ots;
   std::shared_ptr<OTVectorSender> ot;
@@ -963,7 +1136,7 @@ std::shared_ptr<OTVectorSender> &OTProviderSender::RegisterOTs(
 }
 
 std::unique_ptr<FixedXCOT128Sender> OTProviderSender::RegisterFixedXCOT128s(
-    const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_;
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<FixedXCOT128Sender>(i, num_ots, data_, Send);
@@ -978,7 +1151,7 @@ std::unique_ptr<FixedXCOT128Sender> OTProviderSender::RegisterFixedXCOT128s(
 
 std::unique_ptr<XCOTBitSender> OTProviderSender::RegisterXCOTBits(
     std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send) {
+    const std::function<void(std::vector<std::uint8_t>&&)>& Send) {
   const auto i = total_ots_count_;
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<XCOTBitSender>(i, num_ots, vector_size, data_, Send);
@@ -993,11 +1166,11 @@ std::unique_ptr<XCOTBitSender> OTProviderSender::RegisterXCOTBits(
 
 template <typename T>
 std::unique_ptr<ACOTSender<T>> OTProviderSender::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_;
   total_ots_count_ += num_ots;
-  auto ot = std::make_unique<ACOTSender<T>>(i, num_ots, vector_size, data_, Send);
+  auto ot = std::make_unique<ACOTSender<T>>(i, num_ots, vector_size, seed_compression, data_, Send);
   if constexpr (MOTION::MOTION_DEBUG) {
     if (logger_) {
       logger_->LogDebug(fmt::format("Party#{}: registered {} parallel {}-bit sender ACOTs",
@@ -1008,23 +1181,23 @@ std::unique_ptr<ACOTSender<T>> OTProviderSender::RegisterACOT(
 }
 
 template std::unique_ptr<ACOTSender<std::uint8_t>> OTProviderSender::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 template std::unique_ptr<ACOTSender<std::uint16_t>> OTProviderSender::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 template std::unique_ptr<ACOTSender<std::uint32_t>> OTProviderSender::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 template std::unique_ptr<ACOTSender<std::uint64_t>> OTProviderSender::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 template std::unique_ptr<ACOTSender<__uint128_t>> OTProviderSender::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
 std::unique_ptr<GOT128Sender> OTProviderSender::RegisterGOT128(
-    const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_;
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<GOT128Sender>(i, num_ots, data_, Send);
@@ -1038,7 +1211,7 @@ std::unique_ptr<GOT128Sender> OTProviderSender::RegisterGOT128(
 }
 
 std::unique_ptr<GOTBitSender> OTProviderSender::RegisterGOTBit(
-    const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_;
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<GOTBitSender>(i, num_ots, data_, Send);
@@ -1053,7 +1226,7 @@ std::unique_ptr<GOTBitSender> OTProviderSender::RegisterGOTBit(
 
 std::unique_ptr<ROTSender> OTProviderSender::RegisterROT(
     std::size_t num_ots, std::size_t vector_size, bool random_choice,
-    const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send) {
+    const std::function<void(std::vector<std::uint8_t>&&)>& Send) {
   const auto i = total_ots_count_;
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<ROTSender>(i, num_ots, vector_size, random_choice, data_, Send);
@@ -1098,7 +1271,7 @@ std::shared_ptr<OTVectorReceiver> &OTProviderReceiver::GetOTs(std::size_t offset
 
 std::shared_ptr<OTVectorReceiver> &OTProviderReceiver::RegisterOTs(
     const std::size_t bitlen, const std::size_t num_ots, const OTProtocol p,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const std::size_t i = total_ots_count_;
   total_ots_count_ += num_ots;
 
@@ -1175,7 +1348,7 @@ std::shared_ptr<OTVectorReceiver> &OTProviderReceiver::RegisterOTs(
 }
 
 std::unique_ptr<FixedXCOT128Receiver> OTProviderReceiver::RegisterFixedXCOT128s(
-    const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_.load();
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<FixedXCOT128Receiver>(i, num_ots, data_, Send);
@@ -1191,7 +1364,7 @@ std::unique_ptr<FixedXCOT128Receiver> OTProviderReceiver::RegisterFixedXCOT128s(
 
 std::unique_ptr<XCOTBitReceiver> OTProviderReceiver::RegisterXCOTBits(
     std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send) {
+    const std::function<void(std::vector<std::uint8_t>&&)>& Send) {
   const auto i = total_ots_count_.load();
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<XCOTBitReceiver>(i, num_ots, vector_size, data_, Send);
@@ -1206,11 +1379,12 @@ std::unique_ptr<XCOTBitReceiver> OTProviderReceiver::RegisterXCOTBits(
 
 template <typename T>
 std::unique_ptr<ACOTReceiver<T>> OTProviderReceiver::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_.load();
   total_ots_count_ += num_ots;
-  auto ot = std::make_unique<ACOTReceiver<T>>(i, num_ots, vector_size, data_, Send);
+  auto ot = std::make_unique<ACOTReceiver<T>>(i, num_ots, vector_size, seed_compression,
+                                              data_, Send);
   if constexpr (MOTION::MOTION_DEBUG) {
     if (logger_) {
       logger_->LogDebug(fmt::format("Party#{}: registered {} parallel {}-bit receiver ACOTs",
@@ -1221,23 +1395,23 @@ std::unique_ptr<ACOTReceiver<T>> OTProviderReceiver::RegisterACOT(
 }
 
 template std::unique_ptr<ACOTReceiver<std::uint8_t>> OTProviderReceiver::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 template std::unique_ptr<ACOTReceiver<std::uint16_t>> OTProviderReceiver::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 template std::unique_ptr<ACOTReceiver<std::uint32_t>> OTProviderReceiver::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 template std::unique_ptr<ACOTReceiver<std::uint64_t>> OTProviderReceiver::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 template std::unique_ptr<ACOTReceiver<__uint128_t>> OTProviderReceiver::RegisterACOT(
-    std::size_t num_ots, std::size_t vector_size,
-    const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send);
+    std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+    const std::function<void(std::vector<std::uint8_t> &&)> &Send);
 
 std::unique_ptr<GOT128Receiver> OTProviderReceiver::RegisterGOT128(
-    const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_.load();
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<GOT128Receiver>(i, num_ots, data_, Send);
@@ -1251,7 +1425,7 @@ std::unique_ptr<GOT128Receiver> OTProviderReceiver::RegisterGOT128(
 }
 
 std::unique_ptr<GOTBitReceiver> OTProviderReceiver::RegisterGOTBit(
-    const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder &&)> &Send) {
+    const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t> &&)> &Send) {
   const auto i = total_ots_count_.load();
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<GOTBitReceiver>(i, num_ots, data_, Send);
@@ -1266,7 +1440,7 @@ std::unique_ptr<GOTBitReceiver> OTProviderReceiver::RegisterGOTBit(
 
 std::unique_ptr<ROTReceiver> OTProviderReceiver::RegisterROT(
     std::size_t num_ots, std::size_t vector_size, bool random_choice,
-    const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send) {
+    const std::function<void(std::vector<std::uint8_t>&&)>& Send) {
   const auto i = total_ots_count_.load();
   total_ots_count_ += num_ots;
   auto ot = std::make_unique<ROTReceiver>(i, num_ots, vector_size, random_choice, data_, Send);
@@ -1314,13 +1488,15 @@ class OTExtensionMessageHandler : public MOTION::Communication::MessageHandler {
 void OTExtensionMessageHandler::received_message(std::size_t,
                                                  std::vector<std::uint8_t> &&raw_message) {
   assert(!raw_message.empty());
-  auto message = MOTION::Communication::GetMessage(raw_message.data());
-  auto message_type = message->message_type();
-  auto index_i = MOTION::Communication::GetOTExtensionMessage(message->payload()->data())->i();
-  auto ot_data =
-      MOTION::Communication::GetOTExtensionMessage(message->payload()->data())->buffer()->data();
-  auto ot_data_size =
-      MOTION::Communication::GetOTExtensionMessage(message->payload()->data())->buffer()->size();
+  const auto message =
+      MOTION::Communication::ParseCompactMessage(raw_message.data(), raw_message.size());
+  if (!message.has_value()) {
+    throw std::runtime_error("received malformed OT extension message");
+  }
+  auto message_type = message->message_type;
+  auto index_i = message->id;
+  auto ot_data = message->payload;
+  auto ot_data_size = message->payload_size;
   switch (message_type) {
     case MOTION::Communication::MessageType::OTExtensionReceiverMasks: {
       data_.MessageReceived(ot_data, ot_data_size, MOTION::OTExtensionDataType::rcv_masks, index_i);
@@ -1345,12 +1521,15 @@ OTProviderManager::OTProviderManager(MOTION::Communication::CommunicationLayer &
                                      const MOTION::BaseOTProvider &base_ot_provider,
                                      MOTION::Crypto::MotionBaseProvider &motion_base_provider,
                                      MOTION::Statistics::RunTimeStats *stats,
-                                     std::shared_ptr<MOTION::Logger> logger)
+                                     std::shared_ptr<MOTION::Logger> logger,
+                                     const MOTION::Crypto::TrustedDealer *trusted_dealer,
+                                     ROTPoolManager *ot_pool)
     : communication_layer_(communication_layer),
       base_ot_provider_(base_ot_provider),
       motion_base_provider_(motion_base_provider),
       stats_(stats),
       logger_(logger),
+      trusted_dealer_(trusted_dealer),
       num_parties_(communication_layer_.get_num_parties()),
       providers_(num_parties_),
       data_(num_parties_) {
@@ -1359,13 +1538,22 @@ OTProviderManager::OTProviderManager(MOTION::Communication::CommunicationLayer &
     if (party_id == my_id) {
       continue;
     }
-    auto send_func = [this, party_id](flatbuffers::FlatBufferBuilder &&message_builder) {
-      communication_layer_.send_message(party_id, std::move(message_builder));
+    auto send_func = [this, party_id](std::vector<std::uint8_t> &&message) {
+      communication_layer_.send_message(party_id, std::move(message));
     };
     data_.at(party_id) = std::make_unique<MOTION::OTExtensionData>();
-    providers_.at(party_id) = std::make_unique<OTProviderFromOTExtension>(
-        send_func, *data_.at(party_id), base_ot_provider.get_base_ots_data(party_id),
-        motion_base_provider, party_id, logger);
+    if (trusted_dealer_) {
+      providers_.at(party_id) = std::make_unique<OTProviderFromDealer>(
+          send_func, *data_.at(party_id), *trusted_dealer_, party_id, logger);
+    } else if (ot_pool) {
+      providers_.at(party_id) = std::make_unique<OTProviderFromPool>(
+          send_func, *data_.at(party_id), ot_pool->get_sender(party_id),
+          ot_pool->get_receiver(party_id), party_id, logger);
+    } else {
+      providers_.at(party_id) = std::make_unique<OTProviderFromOTExtension>(
+          send_func, *data_.at(party_id), base_ot_provider.get_base_ots_data(party_id),
+          motion_base_provider, party_id, logger);
+    }
   }
 
   communication_layer_.register_message_handler(
@@ -1386,7 +1574,9 @@ OTProviderManager::~OTProviderManager() {
 
 void OTProviderManager::run_setup() {
   motion_base_provider_.wait_setup();
-  base_ot_provider_.wait_setup();
+  if (!trusted_dealer_) {
+    base_ot_provider_.wait_setup();
+  }
 
   if constexpr (MOTION::MOTION_DEBUG) {
     logger_->LogDebug("Start computing setup for OTExtensions");
@@ -1421,6 +1611,14 @@ void OTProviderManager::run_setup() {
   }
 }
 
+void OTProviderManager::set_num_threads(std::size_t num_threads) {
+  for (auto &provider : providers_) {
+    if (provider) {
+      provider->SetNumThreads(num_threads);
+    }
+  }
+}
+
 void OTProviderManager::clear() {
   if constexpr (MOTION::MOTION_DEBUG) {
     logger_->LogDebug("OTProviderManager::clear()");
@@ -49,6 +49,7 @@ class CommunicationLayer;
 
 namespace Crypto {
 class MotionBaseProvider;
+class TrustedDealer;
 }
 
 namespace Statistics {
@@ -86,6 +87,9 @@ class GOTBitSender;
 class GOTBitReceiver;
 class ROTSender;
 class ROTReceiver;
+class ROTPoolManager;
+class ROTPoolReceiver;
+class ROTPoolSender;
 
 class OTVector {
  public:
@@ -98,12 +102,12 @@ class OTVector {
 
  protected:
   OTVector(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
-           const OTProtocol p, const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+           const OTProtocol p, const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   const std::size_t ot_id_, num_ots_, bitlen_;
   const OTProtocol p_;
 
-  std::function<void(flatbuffers::FlatBufferBuilder&&)> Send_;
+  std::function<void(std::vector<std::uint8_t>&&)> Send_;
 };
 
 class OTVectorSender : public OTVector {
@@ -121,7 +125,7 @@ class OTVectorSender : public OTVector {
  protected:
   OTVectorSender(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
                  const OTProtocol p, MOTION::OTExtensionSenderData& data,
-                 const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                 const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   void Reserve(const std::size_t id, const std::size_t num_ots, const std::size_t bitlen);
 
@@ -133,7 +137,7 @@ class GOTVectorSender final : public OTVectorSender {
  public:
   GOTVectorSender(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
                   MOTION::OTExtensionSenderData& data,
-                  const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                  const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   void SetInputs(std::vector<BitVector<>>&& v) final;
 
@@ -147,7 +151,7 @@ class COTVectorSender final : public OTVectorSender {
  public:
   COTVectorSender(const std::size_t id, const std::size_t num_ots, const std::size_t bitlen,
                   OTProtocol p, MOTION::OTExtensionSenderData& data,
-                  const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                  const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   void SetInputs(std::vector<BitVector<>>&& v) final;
 
@@ -167,7 +171,7 @@ class ROTVectorSender final : public OTVectorSender {
  public:
   ROTVectorSender(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
                   MOTION::OTExtensionSenderData& data,
-                  const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                  const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   void SetInputs(std::vector<BitVector<>>&& v) final;
 
@@ -195,7 +199,7 @@ class OTVectorReceiver : public OTVector {
  protected:
   OTVectorReceiver(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
                    const OTProtocol p, MOTION::OTExtensionReceiverData& data,
-                   std::function<void(flatbuffers::FlatBufferBuilder&&)> Send);
+                   std::function<void(std::vector<std::uint8_t>&&)> Send);
 
   void Reserve(const std::size_t id, const std::size_t num_ots, const std::size_t bitlen);
 
@@ -209,7 +213,7 @@ class GOTVectorReceiver final : public OTVectorReceiver {
  public:
   GOTVectorReceiver(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
                     MOTION::OTExtensionReceiverData& data,
-                    const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                    const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   void SetChoices(BitVector<>&& v) final;
 
@@ -229,7 +233,7 @@ class COTVectorReceiver final : public OTVectorReceiver {
  public:
   COTVectorReceiver(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
                     OTProtocol p, MOTION::OTExtensionReceiverData& data,
-                    const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                    const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   void SendCorrections() final;
 
@@ -249,7 +253,7 @@ class ROTVectorReceiver final : public OTVectorReceiver {
  public:
   ROTVectorReceiver(const std::size_t ot_id, const std::size_t num_ots, const std::size_t bitlen,
                     MOTION::OTExtensionReceiverData& data,
-                    const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+                    const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   void SetChoices(const BitVector<>& v) final;
 
@@ -276,23 +280,23 @@ class OTProviderSender {
 
   std::shared_ptr<OTVectorSender>& RegisterOTs(
       const std::size_t bitlen, const std::size_t num_ots, const OTProtocol p,
-      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<FixedXCOT128Sender> RegisterFixedXCOT128s(
-      const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<XCOTBitSender> RegisterXCOTBits(
       std::size_t num_ots, std::size_t vector_size,
-      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   template <typename T>
   std::unique_ptr<ACOTSender<T>> RegisterACOT(
-      std::size_t num_ots, std::size_t vector_size,
-      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+      const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<GOT128Sender> RegisterGOT128(
-      const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<GOTBitSender> RegisterGOTBit(
-      const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<ROTSender> RegisterROT(
       std::size_t num_ots, std::size_t vector_size, bool random_choice,
-      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   auto GetNumOTs() const { return total_ots_count_; }
 
@@ -326,23 +330,23 @@ class OTProviderReceiver {
 
   std::shared_ptr<OTVectorReceiver>& RegisterOTs(
       const std::size_t bitlen, const std::size_t num_ots, const OTProtocol p,
-      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<FixedXCOT128Receiver> RegisterFixedXCOT128s(
-      const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<XCOTBitReceiver> RegisterXCOTBits(
       std::size_t num_ots, std::size_t vector_size,
-      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   template <typename T>
   std::unique_ptr<ACOTReceiver<T>> RegisterACOT(
-      std::size_t num_ots, std::size_t vector_size,
-      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      std::size_t num_ots, std::size_t vector_size, bool seed_compression,
+      const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<GOT128Receiver> RegisterGOT128(
-      const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<GOTBitReceiver> RegisterGOTBit(
-      const std::size_t num_ots, const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::size_t num_ots, const std::function<void(std::vector<std::uint8_t>&&)>& Send);
   std::unique_ptr<ROTReceiver> RegisterROT(
       std::size_t num_ots, std::size_t vector_size, bool random_choice,
-      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& Send);
+      const std::function<void(std::vector<std::uint8_t>&&)>& Send);
 
   std::size_t GetNumOTs() const { return total_ots_count_; }
 
@@ -384,9 +388,12 @@ class OTProvider {
   [[nodiscard]] std::unique_ptr<XCOTBitSender> RegisterSendXCOTBit(std::size_t num_ots = 1,
                                                                    std::size_t vector_size = 1);
 
+  /// @param seed_compression Only store 128-bit seeds in the OT extension and expand them to
+  /// vector_size values while streaming the outputs (see ACOTSender)
   template <typename T>
   [[nodiscard]] std::unique_ptr<ACOTSender<T>> RegisterSendACOT(std::size_t num_ots = 1,
-                                                                std::size_t vector_size = 1);
+                                                                std::size_t vector_size = 1,
+                                                                bool seed_compression = false);
 
   [[nodiscard]] std::unique_ptr<GOT128Sender> RegisterSendGOT128(std::size_t num_ots = 1);
 
@@ -413,8 +420,8 @@ class OTProvider {
       std::size_t num_ots = 1, std::size_t vector_size = 1);
 
   template <typename T>
-  [[nodiscard]] std::unique_ptr<ACOTReceiver<T>> RegisterReceiveACOT(std::size_t num_ots = 1,
-                                                                     std::size_t vector_size = 1);
+  [[nodiscard]] std::unique_ptr<ACOTReceiver<T>> RegisterReceiveACOT(
+      std::size_t num_ots = 1, std::size_t vector_size = 1, bool seed_compression = false);
 
   [[nodiscard]] std::unique_ptr<GOT128Receiver> RegisterReceiveGOT128(std::size_t num_ots = 1);
 
@@ -433,6 +440,13 @@ class OTProvider {
 
   void WaitSetup() const;
 
+  // Number of threads used for the computations of the OT extension setup,
+  // i.e., the expansion of the base OT seeds and the transposition of the
+  // matrix.  0 selects the OpenMP default.
+  void SetNumThreads(std::size_t num_threads) { num_threads_ = num_threads; }
+
+  [[nodiscard]] std::size_t GetNumThreads() const { return num_threads_; }
+
   void Clear() {
     receiver_provider_.Clear();
     sender_provider_.Clear();
@@ -444,15 +458,16 @@ class OTProvider {
   }
 
  protected:
-  OTProvider(std::function<void(flatbuffers::FlatBufferBuilder&&)> Send,
+  OTProvider(std::function<void(std::vector<std::uint8_t>&&)> Send,
              MOTION::OTExtensionData& data, std::size_t party_id,
              std::shared_ptr<MOTION::Logger> logger);
 
-  std::function<void(flatbuffers::FlatBufferBuilder&&)> Send_;
+  std::function<void(std::vector<std::uint8_t>&&)> Send_;
   MOTION::OTExtensionData& data_;
   OTProviderReceiver receiver_provider_;
   OTProviderSender sender_provider_;
   std::shared_ptr<MOTION::Logger> logger_;
+  std::size_t num_threads_ = 1;
 };
 
 class OTProviderFromFile : public OTProvider {
@@ -469,7 +484,7 @@ class OTProviderFromOTExtension final : public OTProvider {
 
   void ReceiveSetup() final;
 
-  OTProviderFromOTExtension(std::function<void(flatbuffers::FlatBufferBuilder&&)> Send,
+  OTProviderFromOTExtension(std::function<void(std::vector<std::uint8_t>&&)> Send,
                             MOTION::OTExtensionData& data, const MOTION::BaseOTsData& base_ot_data,
                             MOTION::Crypto::MotionBaseProvider&, std::size_t party_id,
                             std::shared_ptr<MOTION::Logger> logger);
@@ -479,6 +494,42 @@ class OTProviderFromOTExtension final : public OTProvider {
   MOTION::Crypto::MotionBaseProvider& motion_base_provider_;
 };
 
+// Random OTs which are derived locally from the seed of a simulated trusted
+// dealer instead of running the OT extension.  Insecure, only for benchmarking
+// the online phase (cf. MOTION::Crypto::TrustedDealer).
+class OTProviderFromDealer final : public OTProvider {
+ public:
+  void SendSetup() final;
+
+  void ReceiveSetup() final;
+
+  OTProviderFromDealer(std::function<void(std::vector<std::uint8_t>&&)> Send,
+                       MOTION::OTExtensionData& data, const MOTION::Crypto::TrustedDealer&,
+                       std::size_t party_id, std::shared_ptr<MOTION::Logger> logger);
+
+ private:
+  const MOTION::Crypto::TrustedDealer& trusted_dealer_;
+  std::size_t party_id_;
+};
+
+// Random OTs which are taken from a pair of OT pools that are refilled in the
+// background (cf. ROTPoolManager) instead of running the OT extension when
+// the setup is run.  The pools need to be started before.
+class OTProviderFromPool final : public OTProvider {
+ public:
+  void SendSetup() final;
+
+  void ReceiveSetup() final;
+
+  OTProviderFromPool(std::function<void(std::vector<std::uint8_t>&&)> Send,
+                     MOTION::OTExtensionData& data, ROTPoolSender&, ROTPoolReceiver&,
+                     std::size_t party_id, std::shared_ptr<MOTION::Logger> logger);
+
+ private:
+  ROTPoolSender& sender_pool_;
+  ROTPoolReceiver& receiver_pool_;
+};
+
 class OTProviderFromThirdParty : public OTProvider {
   // TODO
 };
@@ -489,15 +540,23 @@ class OTProviderFromMultipleThirdParties : public OTProvider {
 
 class OTProviderManager : public enable_wait_setup {
  public:
+  // If a trusted dealer is given, the OTs are derived from its seed and no
+  // base OTs are needed.  If an OT pool is given, the OTs are taken from it
+  // (cf. OTProviderFromPool).
   OTProviderManager(MOTION::Communication::CommunicationLayer&, const MOTION::BaseOTProvider&,
                     MOTION::Crypto::MotionBaseProvider&, MOTION::Statistics::RunTimeStats*,
-                    std::shared_ptr<MOTION::Logger>);
+                    std::shared_ptr<MOTION::Logger>,
+                    const MOTION::Crypto::TrustedDealer* trusted_dealer = nullptr,
+                    ROTPoolManager* ot_pool = nullptr);
   ~OTProviderManager();
 
   std::vector<std::unique_ptr<OTProvider>>& get_providers() { return providers_; }
   OTProvider& get_provider(std::size_t party_id) { return *providers_.at(party_id); }
   void run_setup();
 
+  // set the number of threads used by each provider (cf. OTProvider::SetNumThreads)
+  void set_num_threads(std::size_t num_threads);
+
   // reset all data structures for a new round of OTs
   void clear();
 
@@ -507,6 +566,7 @@ class OTProviderManager : public enable_wait_setup {
   MOTION::Crypto::MotionBaseProvider& motion_base_provider_;
   MOTION::Statistics::RunTimeStats* stats_;
   std::shared_ptr<MOTION::Logger> logger_;
+  const MOTION::Crypto::TrustedDealer* trusted_dealer_;
   std::size_t num_parties_;
   std::vector<std::unique_ptr<OTProvider>> providers_;
   std::vector<std::unique_ptr<MOTION::OTExtensionData>> data_;
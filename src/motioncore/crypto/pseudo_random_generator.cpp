@@ -136,4 +136,8 @@ void PRG::FixedKeyAES(const std::byte *input, const uint128_t tweak, std::byte *
 
 void PRG::MMO(std::byte *input) { aesni_mmo_single(round_keys_.data(), input); }
 
+void PRG::MMO(std::byte *input, std::size_t num_blocks) {
+  aesni_mmo_batch(round_keys_.data(), input, num_blocks);
+}
+
 }  // namespace ENCRYPTO
@@ -64,6 +64,8 @@ class PRG {
 
   std::vector<std::byte> FixedKeyAES(const std::byte *x, const uint128_t i);
   void MMO(std::byte *input);
+  // MMO of num_blocks consecutive blocks
+  void MMO(std::byte *input, std::size_t num_blocks);
 
 
   // Implementation of TMMO^\pi
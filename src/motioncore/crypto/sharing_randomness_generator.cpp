@@ -43,10 +43,6 @@ void SharingRandomnessGenerator::Initialize(
     auto digest = HashKey(master_seed_, KeyType::ArithmeticGMWKey);
     std::copy(digest.data(), digest.data() + AES_KEY_SIZE, raw_key_arithmetic_);
   }
-  {
-    auto digest = HashKey(master_seed_, KeyType::ArithmeticGMWNonce);
-    std::copy(digest.data(), digest.data() + AES_BLOCK_SIZE / 2, aes_ctr_nonce_arithmetic_);
-  }
   {
     auto digest = HashKey(master_seed_, KeyType::BooleanGMWKey);
     std::copy(digest.data(), digest.data() + AES_KEY_SIZE, raw_key_boolean_);
@@ -56,7 +52,8 @@ void SharingRandomnessGenerator::Initialize(
     std::copy(digest.data(), digest.data() + AES_BLOCK_SIZE / 2, aes_ctr_nonce_boolean_);
   }
 
-  prg_a.SetKey(raw_key_arithmetic_);
+  std::copy_n(raw_key_arithmetic_, AES_KEY_SIZE, round_keys_arithmetic_.data());
+  aesni_key_expansion_128(round_keys_arithmetic_.data());
   prg_b.SetKey(raw_key_boolean_);
 
   {
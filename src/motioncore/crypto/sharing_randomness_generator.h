@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <thread>
 #include <vector>
@@ -42,6 +44,7 @@ static auto &EVP_MD_CTX_free = EVP_MD_CTX_destroy;
 
 #include <fmt/format.h>
 
+#include "crypto/aes/aesni_primitives.h"
 #include "pseudo_random_generator.h"
 #include "utility/bit_vector.h"
 #include "utility/fiber_condition.h"
@@ -81,57 +84,46 @@ class SharingRandomnessGenerator {
   //----------------------------------------------
   template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
   T GetUnsigned(const std::size_t gate_id) {
-    initialized_condition_->Wait();
-
-    std::byte input[AES_BLOCK_SIZE];
-
-    std::copy(std::begin(aes_ctr_nonce_arithmetic_), std::end(aes_ctr_nonce_arithmetic_), input);
-    std::copy_n(reinterpret_cast<const std::byte *>(&gate_id), sizeof(gate_id),
-                input + SharingRandomnessGenerator::COUNTER_OFFSET);
-
-    auto output = prg_a.Encrypt(input, AES_BLOCK_SIZE);
-
-    // combine resulting randomness xored with the gate_id, which is the actual
-    // input to AES-CTR
-    __uint128_t result = reinterpret_cast<std::uint64_t *>(output.data())[0],
-                mod = std::numeric_limits<T>::max();
-    result <<= 64;
-    result ^= reinterpret_cast<std::uint64_t *>(output.data())[1] ^ gate_id;
-    result %= mod;
-
-    return static_cast<T>(result);  // static-cast the result to the smaller
-                                    // ring
+    T result;
+    GetUnsigned(gate_id, 1, &result);
+    return result;
   }
 
+  // The value for gate_id g is the (g mod k)-th element of type T in the AES
+  // CTR block with counter g / k where k = 16 / sizeof(T).  Hence, the values
+  // depend only on the gate ids and not on how the requests are batched, and
+  // reducing to the ring of T is a truncation.  Complete blocks are written
+  // directly into the output buffer.
   template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
   void GetUnsigned(std::size_t gate_id, const std::size_t num_of_gates, T* output_ptr) {
+    static_assert(AES_BLOCK_SIZE % sizeof(T) == 0);
+    constexpr std::size_t values_per_block = AES_BLOCK_SIZE / sizeof(T);
     if (num_of_gates == 0) {
       return;
     }
 
     initialized_condition_->Wait();
 
-    auto size_in_bytes = AES_BLOCK_SIZE * (num_of_gates);
-    std::vector<std::byte> input(size_in_bytes + AES_BLOCK_SIZE);
-
-    auto gate_id_copy = gate_id;
-    for (auto i = 0u; i < num_of_gates; ++i, ++gate_id_copy) {
-      std::copy(std::begin(aes_ctr_nonce_arithmetic_), std::end(aes_ctr_nonce_arithmetic_),
-                &input[i * AES_BLOCK_SIZE]);
-      std::copy_n(reinterpret_cast<const std::byte *>(&gate_id_copy), sizeof(gate_id_copy),
-                  input.data() + i * AES_BLOCK_SIZE + SharingRandomnessGenerator::COUNTER_OFFSET);
+    std::uint64_t counter = gate_id / values_per_block;
+    std::size_t num_done = 0;
+    std::array<T, values_per_block> block;
+    // leading partial block
+    if (const auto offset = gate_id % values_per_block; offset != 0) {
+      aesni_ctr_stream_single_block_128_unaligned(round_keys_arithmetic_.data(), &counter,
+                                                  block.data());
+      num_done = std::min(values_per_block - offset, num_of_gates);
+      std::copy_n(block.data() + offset, num_done, output_ptr);
     }
-
-    auto output = prg_a.Encrypt(input.data(), num_of_gates * AES_BLOCK_SIZE);
-    __uint128_t mod = std::numeric_limits<T>::max(), single_result;
-    // combine resulting randomness xored with the gate_id, which is the actual
-    // input to AES-CTR
-    for (auto i = 0u; i < num_of_gates; ++i) {
-      single_result = reinterpret_cast<std::uint64_t *>(output.data())[i * 2];
-      single_result <<= 64;
-      single_result ^= reinterpret_cast<std::uint64_t *>(output.data())[i * 2 + 1] ^ gate_id++;
-      single_result %= mod;
-      output_ptr[i] = static_cast<T>(single_result);  // static-cast the result to the smaller ring
+    // complete blocks
+    const auto num_blocks = (num_of_gates - num_done) / values_per_block;
+    aesni_ctr_stream_blocks_128_unaligned(round_keys_arithmetic_.data(), &counter,
+                                          output_ptr + num_done, num_blocks);
+    num_done += num_blocks * values_per_block;
+    // trailing partial block
+    if (num_done < num_of_gates) {
+      aesni_ctr_stream_single_block_128_unaligned(round_keys_arithmetic_.data(), &counter,
+                                                  block.data());
+      std::copy_n(block.data(), num_of_gates - num_done, output_ptr + num_done);
     }
   }
 
@@ -168,12 +160,13 @@ class SharingRandomnessGenerator {
   std::byte master_seed_[SharingRandomnessGenerator::MASTER_SEED_BYTE_LENGTH] = {std::byte{0}};
   std::byte raw_key_arithmetic_[AES_KEY_SIZE] = {std::byte{0}};
   std::byte raw_key_boolean_[AES_KEY_SIZE] = {std::byte{0}};  /// AES key in raw std::byte format
-  std::byte aes_ctr_nonce_arithmetic_[AES_BLOCK_SIZE / 2] = {std::byte{0}};
+  /// expanded AES key for the AES-NI CTR stream of arithmetic randomness
+  alignas(aes_block_size) std::array<std::byte, aes_round_keys_size_128> round_keys_arithmetic_;
   std::byte aes_ctr_nonce_boolean_[AES_BLOCK_SIZE / 2] = {
       std::byte{0}};  /// Raw AES CTR nonce that is used
   /// in the left part of IV
 
-  ENCRYPTO::PRG prg_a, prg_b;
+  ENCRYPTO::PRG prg_b;
 
   enum KeyType : uint {
     ArithmeticGMWKey = 0,
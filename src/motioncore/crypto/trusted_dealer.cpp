@@ -0,0 +1,162 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "trusted_dealer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "crypto/pseudo_random_generator.h"
+
+namespace MOTION::Crypto {
+
+namespace {
+
+// index of the streams which are the same for all parties
+constexpr std::uint64_t common_index = ~std::uint64_t(0);
+
+// FNV-1a, which only needs to be deterministic across all parties
+std::uint64_t hash_label(std::string_view label, std::uint64_t index) {
+  std::uint64_t hash = 0xcbf29ce484222325;
+  const auto update = [&hash](std::uint8_t byte) {
+    hash ^= byte;
+    hash *= 0x100000001b3;
+  };
+  std::for_each(std::begin(label), std::end(label), update);
+  for (std::size_t i = 0; i < sizeof(index); ++i) {
+    update(index >> (8 * i));
+  }
+  return hash;
+}
+
+std::vector<std::byte> expand_key(const std::array<std::byte, 16>& key, std::size_t num_bytes) {
+  ENCRYPTO::PRG prg;
+  prg.SetKey(key.data());
+  auto output = prg.Encrypt(num_bytes);
+  output.resize(num_bytes);
+  return output;
+}
+
+template <typename T>
+std::vector<T> to_values(const std::vector<std::byte>& bytes, std::size_t num_values) {
+  std::vector<T> values(num_values);
+  std::memcpy(values.data(), bytes.data(), num_values * sizeof(T));
+  return values;
+}
+
+}  // namespace
+
+TrustedDealer::TrustedDealer(std::uint64_t seed, std::size_t my_id, std::size_t num_parties)
+    : seed_(seed), my_id_(my_id), num_parties_(num_parties) {
+  if (my_id_ >= num_parties_) {
+    throw std::invalid_argument(
+        fmt::format("TrustedDealer: invalid party id {} for {} parties", my_id_, num_parties_));
+  }
+}
+
+std::array<std::byte, 16> TrustedDealer::derive_key(std::string_view label,
+                                                    std::uint64_t index) const {
+  std::array<std::byte, 16> key;
+  const auto hash = hash_label(label, index);
+  std::memcpy(key.data(), &seed_, sizeof(seed_));
+  std::memcpy(key.data() + sizeof(seed_), &hash, sizeof(hash));
+  return key;
+}
+
+template <typename T>
+std::vector<T> TrustedDealer::random_values(std::string_view label, std::size_t num_values) const {
+  return to_values<T>(expand_key(derive_key(label, common_index), num_values * sizeof(T)),
+                      num_values);
+}
+
+template std::vector<std::uint8_t> TrustedDealer::random_values(std::string_view,
+                                                                std::size_t) const;
+template std::vector<std::uint16_t> TrustedDealer::random_values(std::string_view,
+                                                                 std::size_t) const;
+template std::vector<std::uint32_t> TrustedDealer::random_values(std::string_view,
+                                                                 std::size_t) const;
+template std::vector<std::uint64_t> TrustedDealer::random_values(std::string_view,
+                                                                 std::size_t) const;
+template std::vector<__uint128_t> TrustedDealer::random_values(std::string_view,
+                                                               std::size_t) const;
+
+ENCRYPTO::BitVector<> TrustedDealer::random_bits(std::string_view label,
+                                                 std::size_t num_bits) const {
+  return ENCRYPTO::BitVector<>(
+      expand_key(derive_key(label, common_index), Helpers::Convert::BitsToBytes(num_bits)),
+      num_bits);
+}
+
+template <typename T>
+std::vector<T> TrustedDealer::share(std::string_view label, const std::vector<T>& values) const {
+  const auto num_values = values.size();
+  const auto get_random_share = [this, label, num_values](std::size_t party_id) {
+    return to_values<T>(expand_key(derive_key(label, party_id), num_values * sizeof(T)),
+                        num_values);
+  };
+  if (my_id_ + 1 < num_parties_) {
+    return get_random_share(my_id_);
+  }
+  auto my_share = values;
+  for (std::size_t party_id = 0; party_id + 1 < num_parties_; ++party_id) {
+    const auto other_share = get_random_share(party_id);
+    std::transform(std::begin(my_share), std::end(my_share), std::begin(other_share),
+                   std::begin(my_share), std::minus{});
+  }
+  return my_share;
+}
+
+template std::vector<std::uint8_t> TrustedDealer::share(std::string_view,
+                                                        const std::vector<std::uint8_t>&) const;
+template std::vector<std::uint16_t> TrustedDealer::share(std::string_view,
+                                                         const std::vector<std::uint16_t>&) const;
+template std::vector<std::uint32_t> TrustedDealer::share(std::string_view,
+                                                         const std::vector<std::uint32_t>&) const;
+template std::vector<std::uint64_t> TrustedDealer::share(std::string_view,
+                                                         const std::vector<std::uint64_t>&) const;
+template std::vector<__uint128_t> TrustedDealer::share(std::string_view,
+                                                       const std::vector<__uint128_t>&) const;
+
+ENCRYPTO::BitVector<> TrustedDealer::share(std::string_view label,
+                                           const ENCRYPTO::BitVector<>& values) const {
+  const auto num_bits = values.GetSize();
+  const auto get_random_share = [this, label, num_bits](std::size_t party_id) {
+    return ENCRYPTO::BitVector<>(
+        expand_key(derive_key(label, party_id), Helpers::Convert::BitsToBytes(num_bits)),
+        num_bits);
+  };
+  if (my_id_ + 1 < num_parties_) {
+    return get_random_share(my_id_);
+  }
+  auto my_share = values;
+  for (std::size_t party_id = 0; party_id + 1 < num_parties_; ++party_id) {
+    my_share ^= get_random_share(party_id);
+  }
+  return my_share;
+}
+
+}  // namespace MOTION::Crypto
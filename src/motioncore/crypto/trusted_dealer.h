@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "utility/bit_vector.h"
+
+namespace MOTION::Crypto {
+
+// Simulation of a trusted dealer for benchmarking the online phase
+//
+// All parties derive the same correlated randomness (OTs, MTs, SPs, SBs, and
+// linear algebra triples) locally from a shared seed, i.e., without any
+// communication.  Since every party is able to compute the shares of all
+// other parties, this is completely insecure and must only be used to
+// measure the performance of the online phase.
+//
+// Each random stream is identified by a label, which needs to be unique for
+// every kind of correlation, and the same seed reproduces the same streams.
+class TrustedDealer {
+ public:
+  TrustedDealer(std::uint64_t seed, std::size_t my_id, std::size_t num_parties);
+
+  std::uint64_t get_seed() const noexcept { return seed_; }
+  std::size_t get_my_id() const noexcept { return my_id_; }
+  std::size_t get_num_parties() const noexcept { return num_parties_; }
+
+  // AES key for an ENCRYPTO::PRG whose output is the same for all parties
+  std::array<std::byte, 16> derive_key(std::string_view label, std::uint64_t index = 0) const;
+
+  // random values which are the same for all parties
+  template <typename T>
+  std::vector<T> random_values(std::string_view label, std::size_t num_values) const;
+  ENCRYPTO::BitVector<> random_bits(std::string_view label, std::size_t num_bits) const;
+
+  // Additive (resp. XOR) share of this party of the given values: the shares
+  // of the parties 0, ..., n - 2 are random and the share of the last party
+  // is the difference to the values.
+  template <typename T>
+  std::vector<T> share(std::string_view label, const std::vector<T>& values) const;
+  ENCRYPTO::BitVector<> share(std::string_view label, const ENCRYPTO::BitVector<>& values) const;
+
+ private:
+  const std::uint64_t seed_;
+  const std::size_t my_id_;
+  const std::size_t num_parties_;
+};
+
+}  // namespace MOTION::Crypto
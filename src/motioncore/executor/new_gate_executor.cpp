@@ -24,17 +24,67 @@
 
 #include <boost/fiber/future/async.hpp>
 #include <boost/fiber/policy.hpp>
+#include <fmt/format.h>
 #include <iostream>
+#include <mutex>
+#include <optional>
 
 #include "base/gate_register.h"
 #include "gate/new_gate.h"
 #include "statistics/run_time_stats.h"
+#include "utility/fiber_condition.h"
 #include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
 #include "utility/synchronized_queue.h"
 #include "utility/logger.h"
 
 namespace MOTION {
 
+namespace {
+
+// Bounds the number of gates which have been scheduled, but not yet evaluated.
+class GateWindow {
+ public:
+  explicit GateWindow(std::size_t max_gates_in_flight)
+      : max_gates_in_flight_(max_gates_in_flight),
+        condition_([this] { return num_gates_in_flight_ < max_gates_in_flight_; }) {}
+
+  // blocks until a gate can be scheduled
+  void enter() {
+    if (max_gates_in_flight_ == 0) {
+      return;
+    }
+    condition_.Wait();
+    std::scoped_lock lock(condition_.GetMutex());
+    ++num_gates_in_flight_;
+  }
+
+  void leave() {
+    if (max_gates_in_flight_ == 0) {
+      return;
+    }
+    {
+      std::scoped_lock lock(condition_.GetMutex());
+      --num_gates_in_flight_;
+    }
+    condition_.NotifyOne();
+  }
+
+  // blocks until all scheduled gates have been evaluated by occupying the
+  // whole window
+  void wait_until_empty() {
+    for (std::size_t i = 0; i < max_gates_in_flight_; ++i) {
+      enter();
+    }
+  }
+
+ private:
+  const std::size_t max_gates_in_flight_;
+  std::size_t num_gates_in_flight_ = 0;
+  ENCRYPTO::FiberCondition condition_;
+};
+
+}  // namespace
+
 NewGateExecutor::NewGateExecutor(GateRegister& reg, std::function<void(void)> preprocessing_fctn,
                                  bool sync_between_setup_and_online,
                                  std::function<void(void)> sync_fctn, std::size_t num_threads,
@@ -53,7 +103,9 @@ NewGateExecutor::NewGateExecutor(GateRegister& reg, std::function<void(void)> pr
 
 
 void NewGateExecutor::evaluate_setup_online(Statistics::RunTimeStats& stats) {
-  if (num_threads_ == 1) {
+  if (max_gates_in_flight_ > 0) {
+    evaluate_streaming(stats);
+  } else if (num_threads_ == 1) {
     evaluate_setup_online_single_threaded(stats);
   } else {
     evaluate_setup_online_multi_threaded(stats);
@@ -196,6 +248,81 @@ void NewGateExecutor::evaluate_setup_online_single_threaded(Statistics::RunTimeS
   cleanup_fut.get();
 }
 
+void NewGateExecutor::evaluate_streaming(Statistics::RunTimeStats& stats) {
+  stats.record_start<Statistics::RunTimeStats::StatID::evaluate>();
+  preprocessing_fctn_();
+
+  if (logger_) {
+    logger_->LogInfo(fmt::format(
+        "Start evaluating the circuit gates in streaming mode (setup and online phase of each "
+        "gate together, at most {} gates in flight)",
+        max_gates_in_flight_));
+  }
+
+  ENCRYPTO::SynchronizedFiberQueue<boost::fibers::fiber> cleanup_channel;
+  auto cleanup_fut = boost::fibers::async([&cleanup_channel] {
+    while (auto f = cleanup_channel.dequeue()) {
+      f->join();
+    }
+  });
+  std::optional<ENCRYPTO::FiberThreadPool> fpool;
+  if (num_threads_ != 1) {
+    fpool.emplace(num_threads_, max_gates_in_flight_);
+  }
+
+  // The setup phase of a gate is only run once the gate enters the window,
+  // directly followed by its online phase, and the gate is destroyed
+  // afterwards.  Since the wires allocate their buffers lazily, only the
+  // wires of the gates in the window and the still live wires of already
+  // evaluated gates occupy memory.  The gates are moved out of the register,
+  // s.t. the gate generator can register further gates in the meantime.
+  stats.record_start<Statistics::RunTimeStats::StatID::gates_setup>();
+  stats.record_start<Statistics::RunTimeStats::StatID::gates_online>();
+
+  {
+    GateWindow window(max_gates_in_flight_);
+    auto& gates = register_.get_gates();
+    do {
+      for (auto& gate_ptr : gates) {
+        window.enter();
+        auto fctn = [&window, gate = std::shared_ptr<NewGate>(std::move(gate_ptr))]() mutable {
+          if (gate->need_setup()) {
+            gate->evaluate_setup();
+          }
+          if (gate->need_online()) {
+            gate->evaluate_online();
+          }
+          gate.reset();
+          window.leave();
+        };
+        if (fpool) {
+          fpool->post(std::move(fctn));
+        } else {
+          cleanup_channel.enqueue(
+              boost::fibers::fiber(boost::fibers::launch::dispatch, std::move(fctn)));
+        }
+      }
+      gates.clear();
+    } while (gate_generator_ && gate_generator_());
+    window.wait_until_empty();
+  }
+
+  stats.record_end<Statistics::RunTimeStats::StatID::gates_setup>();
+  stats.record_end<Statistics::RunTimeStats::StatID::gates_online>();
+
+  if (logger_) {
+    logger_->LogInfo("Finished with the online phase of the circuit gates (streaming)");
+  }
+
+  if (fpool) {
+    fpool->join();
+  }
+  cleanup_channel.close();
+  cleanup_fut.get();
+
+  stats.record_end<Statistics::RunTimeStats::StatID::evaluate>();
+}
+
 void NewGateExecutor::evaluate(Statistics::RunTimeStats&) {
   throw std::logic_error("not implemented");
 }
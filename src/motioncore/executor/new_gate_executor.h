@@ -49,15 +49,44 @@ class NewGateExecutor {
   // Run setup and online phase of each gate as soon as possible.
   void evaluate(Statistics::RunTimeStats& stats);
 
+  // Streaming mode for large circuits: evaluate_setup_online runs the setup
+  // and online phase of each gate together, at most max_gates_in_flight gates
+  // are scheduled at the same time (in the order of registration), and each
+  // gate is destroyed after its online phase has been evaluated, which
+  // releases its references to the wires.  Hence, the memory for the
+  // intermediate values is bounded by the width of the circuit if the gates
+  // have been registered level by level.  There is no synchronization between
+  // setup and online phase in this mode.  0 disables the streaming mode.
+  void set_streaming(std::size_t max_gates_in_flight) noexcept {
+    max_gates_in_flight_ = max_gates_in_flight;
+  }
+  bool is_streaming() const noexcept { return max_gates_in_flight_ > 0; }
+
+  // Streaming mode only: instead of registering all gates before the
+  // evaluation, the gates can be created while the circuit is evaluated.  The
+  // generator is called whenever all registered gates have been scheduled,
+  // registers the next gates (e.g. one level of the circuit), and returns
+  // false when no gates are left.  Hence, only the gates in the window exist
+  // at the same time.  Gates created by the generator must not request
+  // correlated randomness (OTs, MTs, ...), since the preprocessing has already
+  // been run.
+  void set_gate_generator(std::function<bool()> generator) {
+    gate_generator_ = std::move(generator);
+  }
+  bool has_gate_generator() const noexcept { return static_cast<bool>(gate_generator_); }
+
  private:
   void evaluate_setup_online_multi_threaded(Statistics::RunTimeStats& stats);
   void evaluate_setup_online_single_threaded(Statistics::RunTimeStats& stats);
+  void evaluate_streaming(Statistics::RunTimeStats& stats);
 
   GateRegister& register_;
   std::function<void()> preprocessing_fctn_;
   std::function<void()> sync_fctn_;
   std::size_t num_threads_;
   bool sync_between_setup_and_online_ = false;
+  std::size_t max_gates_in_flight_ = 0;
+  std::function<bool()> gate_generator_;
   std::shared_ptr<Logger> logger_;
 };
 
@@ -25,7 +25,12 @@
 #include <fmt/format.h>
 #include <omp.h>
 #include <algorithm>
+#include <condition_variable>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 
 #include "base/gate_register.h"
 #include "executor/execution_context.h"
@@ -33,6 +38,7 @@
 #include "statistics/run_time_stats.h"
 #include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
 #include "utility/logger.h"
+#include "utility/thread_budget.h"
 
 namespace MOTION {
 
@@ -56,45 +62,130 @@ TensorOpExecutor::TensorOpExecutor(GateRegister& reg, std::function<void(void)>
     : TensorOpExecutor(
           reg, std::move(preprocessing_fctn), false, [] {}, num_threads, std::move(logger)) {}
 
+void TensorOpExecutor::set_speculative_online(bool speculative_online) {
+  if (speculative_online && sync_between_setup_and_online_) {
+    throw std::logic_error(
+        "TensorOpExecutor: speculative online phase cannot be combined with synchronizing "
+        "between setup and online phase");
+  }
+  speculative_online_ = speculative_online;
+}
+
+void TensorOpExecutor::set_thread_budget(std::shared_ptr<ThreadBudget> thread_budget) {
+  thread_budget_ = std::move(thread_budget);
+}
+
+namespace {
+
+// Number of gates at the beginning of the register whose setup phase has been
+// evaluated
+class SetupProgress {
+ public:
+  void advance(std::size_t num_gates) {
+    {
+      std::scoped_lock lock(mutex_);
+      num_gates_ = num_gates;
+    }
+    cv_.notify_all();
+  }
+  void abort() {
+    {
+      std::scoped_lock lock(mutex_);
+      aborted_ = true;
+    }
+    cv_.notify_all();
+  }
+  // wait until the setup phase of the first num_gates gates has been evaluated
+  void wait(std::size_t num_gates) {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this, num_gates] { return aborted_ || num_gates_ >= num_gates; });
+    if (aborted_) {
+      throw std::runtime_error("TensorOpExecutor: setup phase failed");
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::size_t num_gates_ = 0;
+  bool aborted_ = false;
+};
+
+}  // namespace
+
 void TensorOpExecutor::evaluate_setup_online(Statistics::RunTimeStats& stats) {
-  if (num_threads_ > 0) {
+  // the leased threads are returned after the fiber pool has been joined
+  std::optional<ThreadBudget::Lease> lease;
+  auto num_threads = num_threads_;
+  if (thread_budget_) {
+    lease.emplace(thread_budget_->acquire(num_threads_));
+    num_threads = lease->get_num_threads();
+  }
+  if (num_threads > 0) {
     if (logger_) {
-      logger_->LogInfo(fmt::format("Set OpenMP threads to {}", num_threads_));
+      logger_->LogInfo(fmt::format("Set OpenMP threads to {}", num_threads));
     }
-    omp_set_num_threads(num_threads_);
+    omp_set_num_threads(num_threads);
   }
 
-  ExecutionContext exec_ctx{.num_threads_ = num_threads_,
+  ExecutionContext exec_ctx{.num_threads_ = num_threads,
                             .fpool_ = std::make_unique<ENCRYPTO::FiberThreadPool>(
-                                std::max(std::size_t{2}, num_threads_))};
+                                std::max(std::size_t{2}, num_threads))};
 
   stats.record_start<Statistics::RunTimeStats::StatID::evaluate>();
 
   preprocessing_fctn_();
 
+  // In speculative mode, the online phase starts concurrently with the setup
+  // phase: gates whose online phase does not depend on any setup data are
+  // evaluated immediately, all others wait until the setup phase of all gates
+  // up to them has been evaluated.
+  const bool speculative_online = speculative_online_;
+  SetupProgress setup_progress;
+
   if (logger_) {
-    logger_->LogInfo(
-        "Start evaluating the circuit gates sequentially (online after all finished setup)");
+    logger_->LogInfo(speculative_online
+                         ? "Start evaluating the circuit gates (online concurrently to setup)"
+                         : "Start evaluating the circuit gates sequentially (online after all "
+                           "finished setup)");
   }
 
   // ------------------------------ setup phase ------------------------------
-  stats.record_start<Statistics::RunTimeStats::StatID::gates_setup>();
-
-  if (register_.get_num_gates_with_setup()) {
-    // evaluate the setup phase of all the gates
-    for (auto& gate : register_.get_gates()) {
-      if (gate->need_setup()) {
-        gate->evaluate_setup_with_context(exec_ctx);
-        register_.increment_gate_setup_counter();
+  auto evaluate_setup = [this, num_threads, &stats, &exec_ctx, &setup_progress] {
+    if (num_threads > 0) {
+      omp_set_num_threads(num_threads);
+    }
+    stats.record_start<Statistics::RunTimeStats::StatID::gates_setup>();
+    try {
+      if (register_.get_num_gates_with_setup()) {
+        // evaluate the setup phase of all the gates
+        auto& gates = register_.get_gates();
+        for (std::size_t gate_i = 0; gate_i < gates.size(); ++gate_i) {
+          auto& gate = gates.at(gate_i);
+          if (gate->need_setup()) {
+            gate->evaluate_setup_with_context(exec_ctx);
+            register_.increment_gate_setup_counter();
+          }
+          setup_progress.advance(gate_i + 1);
+        }
+        register_.wait_setup();
       }
+    } catch (...) {
+      setup_progress.abort();
+      throw;
+    }
+    setup_progress.advance(register_.get_gates().size());
+    stats.record_end<Statistics::RunTimeStats::StatID::gates_setup>();
+  };
+
+  std::future<void> setup_future;
+  if (speculative_online) {
+    setup_future = std::async(std::launch::async, evaluate_setup);
+  } else {
+    evaluate_setup();
+    if (sync_between_setup_and_online_) {
+      sync_fctn_();
     }
-    register_.wait_setup();
-  }
-
-  stats.record_end<Statistics::RunTimeStats::StatID::gates_setup>();
-
-  if (sync_between_setup_and_online_) {
-    sync_fctn_();
   }
 
   if (logger_) {
@@ -104,19 +195,36 @@ void TensorOpExecutor::evaluate_setup_online(Statistics::RunTimeStats& stats) {
   // ------------------------------ online phase ------------------------------
   stats.record_start<Statistics::RunTimeStats::StatID::gates_online>();
 
-  if (register_.get_num_gates_with_online()) {
-    // evaluate the online phase of all the gates
-    for (auto& gate : register_.get_gates()) {
-      if (gate->need_online()) {
-        gate->evaluate_online_with_context(exec_ctx);
-        register_.increment_gate_online_counter();
+  try {
+    if (register_.get_num_gates_with_online()) {
+      // evaluate the online phase of all the gates
+      auto& gates = register_.get_gates();
+      for (std::size_t gate_i = 0; gate_i < gates.size(); ++gate_i) {
+        auto& gate = gates.at(gate_i);
+        if (gate->need_online()) {
+          if (gate->online_needs_setup()) {
+            setup_progress.wait(gate_i + 1);
+          }
+          gate->evaluate_online_with_context(exec_ctx);
+          register_.increment_gate_online_counter();
+        }
       }
+      register_.wait_online();
     }
-    register_.wait_online();
+  } catch (...) {
+    if (setup_future.valid()) {
+      setup_future.wait();
+    }
+    throw;
   }
 
   stats.record_end<Statistics::RunTimeStats::StatID::gates_online>();
 
+  if (setup_future.valid()) {
+    // propagate exceptions of the setup phase
+    setup_future.get();
+  }
+
   // --------------------------------------------------------------------------
 
   if (logger_) {
@@ -29,6 +29,7 @@ namespace MOTION {
 
 class Logger;
 class GateRegister;
+class ThreadBudget;
 
 namespace Statistics {
 struct RunTimeStats;
@@ -43,8 +44,21 @@ class TensorOpExecutor {
   TensorOpExecutor(GateRegister&, std::function<void()> preprocessing_fctn, std::size_t num_threads,
                    std::shared_ptr<Logger>);
 
-  // Run the setup phases first for all gates before starting with the online
-  // phases.
+  // Start the online phase concurrently to the setup phase: each gate only
+  // waits for the setup phases up to itself if it declares that its online
+  // phase needs them (cf. NewGate::online_needs_setup).  The time measured
+  // for the online phase then includes waiting for the setup phase.  Cannot
+  // be combined with synchronizing between setup and online phase.
+  void set_speculative_online(bool speculative_online);
+
+  // Lease the threads of each evaluation from a budget shared with other
+  // executors, at most num_threads of them.  If fewer are available, the
+  // evaluation uses fewer threads (cf. ThreadBudget::acquire).  The fiber
+  // pool still gets at least two workers.
+  void set_thread_budget(std::shared_ptr<ThreadBudget> thread_budget);
+
+  // Run the setup phases of all gates in order, and the online phases
+  // afterwards (or concurrently, cf. set_speculative_online).
   void evaluate_setup_online(Statistics::RunTimeStats& stats);
   // Run setup and online phase of each gate as soon as possible.
   void evaluate(Statistics::RunTimeStats& stats);
@@ -55,6 +69,8 @@ class TensorOpExecutor {
   std::function<void()> sync_fctn_;
   std::size_t num_threads_;
   bool sync_between_setup_and_online_ = false;
+  bool speculative_online_ = false;
+  std::shared_ptr<ThreadBudget> thread_budget_;
   std::shared_ptr<Logger> logger_;
 };
 
@@ -38,6 +38,11 @@ class NewGate : public ENCRYPTO::enable_wait_setup, public ENCRYPTO::enable_wait
   virtual ~NewGate() = default;
   virtual bool need_setup() const noexcept = 0;
   virtual bool need_online() const noexcept = 0;
+  // Whether the online phase depends on data computed in the setup phase of
+  // this or of a preceding gate.  Gates which only compute locally on public
+  // values can return false, so that their online phase can be evaluated
+  // before the setup phase has finished (cf. TensorOpExecutor).
+  virtual bool online_needs_setup() const noexcept { return true; }
   virtual void evaluate_setup() = 0;
   virtual void evaluate_online() = 0;
   virtual void evaluate_setup_with_context(ExecutionContext&) { evaluate_setup(); }
@@ -22,7 +22,9 @@
 
 #include "beavy_provider.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <stdexcept>
 #include <unordered_map>
 
 #include "base/gate_register.h"
@@ -70,6 +72,15 @@ BEAVYProvider::BEAVYProvider(Communication::CommunicationLayer& communication_la
 BEAVYProvider::~BEAVYProvider() = default;
 
 void BEAVYProvider::setup() {
+  // The circuit is complete now: a fused gate whose output was only absorbed
+  // into longer chains does not need to compute it.  Afterwards, the terms
+  // of the chains are not needed anymore.
+  for (const auto& [output, fused_op] : fused_linear_ops_) {
+    if (fused_op.is_absorbed && fused_op.num_other_uses == 0) {
+      unused_fused_outputs_.insert(output);
+    }
+  }
+  fused_linear_ops_.clear();
   motion_base_provider_.wait_setup();
   // TODO wait for ot setup
   set_setup_ready();
@@ -916,46 +927,53 @@ BEAVYProvider::make_arithmetic_64_tensor_input_shares(const tensor::TensorDimens
 
 template <typename T>
 ENCRYPTO::ReusableFiberFuture<IntegerValues<T>>
-BEAVYProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP& in) {
+BEAVYProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP& in,
+                                                      std::size_t output_bit_size) {
+  count_tensor_use(in);
   auto input = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(in);
   if (input == nullptr) {
     throw std::logic_error("wrong tensor type");
   }
   auto gate_id = gate_register_.get_next_gate_id();
   auto tensor_op =
-      std::make_unique<ArithmeticBEAVYTensorOutput<T>>(gate_id, *this, std::move(input), my_id_);
+      std::make_unique<ArithmeticBEAVYTensorOutput<T>>(gate_id, *this, std::move(input), my_id_,
+                                                       output_bit_size);
   auto future = tensor_op->get_output_future();
   gate_register_.register_gate(std::move(tensor_op));
   return future;
 }
 
 template ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-BEAVYProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP&);
+BEAVYProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP&, std::size_t);
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>>
-BEAVYProvider::make_arithmetic_32_tensor_output_my(const tensor::TensorCP& in) {
-  return basic_make_arithmetic_tensor_output_my<std::uint32_t>(in);
+BEAVYProvider::make_arithmetic_32_tensor_output_my(const tensor::TensorCP& in,
+                                                   std::size_t output_bit_size) {
+  return basic_make_arithmetic_tensor_output_my<std::uint32_t>(in, output_bit_size);
 }
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-BEAVYProvider::make_arithmetic_64_tensor_output_my(const tensor::TensorCP& in) {
-  return basic_make_arithmetic_tensor_output_my<std::uint64_t>(in);
+BEAVYProvider::make_arithmetic_64_tensor_output_my(const tensor::TensorCP& in,
+                                                   std::size_t output_bit_size) {
+  return basic_make_arithmetic_tensor_output_my<std::uint64_t>(in, output_bit_size);
 }
 
-void BEAVYProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP& in) {
+void BEAVYProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP& in,
+                                                        std::size_t output_bit_size) {
+  count_tensor_use(in);
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
   switch (in->get_bit_size()) {
     case 32: {
       gate = std::make_unique<ArithmeticBEAVYTensorOutput<std::uint32_t>>(
           gate_id, *this, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<std::uint32_t>>(in),
-          1 - my_id_);
+          1 - my_id_, output_bit_size);
       break;
     }
     case 64: {
       gate = std::make_unique<ArithmeticBEAVYTensorOutput<std::uint64_t>>(
           gate_id, *this, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<std::uint64_t>>(in),
-          1 - my_id_);
+          1 - my_id_, output_bit_size);
       break;
     }
     default: {
@@ -967,6 +985,7 @@ void BEAVYProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP&
 
 tensor::TensorCP BEAVYProvider::make_tensor_flatten_op(const tensor::TensorCP input,
                                                        std::size_t axis) {
+  count_tensor_use(input);
   if (axis > 4) {
     throw std::invalid_argument("invalid axis argument > 4");
   }
@@ -995,8 +1014,41 @@ tensor::TensorCP BEAVYProvider::make_tensor_flatten_op(const tensor::TensorCP in
   return output;
 }
 
+tensor::TensorCP BEAVYProvider::make_tensor_reshape_op(const tensor::TensorCP input,
+                                                       const tensor::TensorDimensions& dims) {
+  count_tensor_use(input);
+  if (input->get_protocol() != MPCProtocol::ArithmeticBEAVY) {
+    throw std::invalid_argument(fmt::format("BEAVYProvider: cannot reshape {} tensor",
+                                            ToString(input->get_protocol())));
+  }
+  auto bit_size = input->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, input, &dims, gate_id, &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticBEAVYTensorReshape<T>>(
+        gate_id, *this, dims, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input));
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
 tensor::TensorCP BEAVYProvider::make_tensor_conversion(MPCProtocol dst_proto,
                                                        const tensor::TensorCP input) {
+  count_tensor_use(input);
   auto src_proto = input->get_protocol();
   if (src_proto == MPCProtocol::BooleanBEAVY && dst_proto == MPCProtocol::ArithmeticBEAVY) {
     return make_convert_boolean_to_arithmetic_beavy_tensor(input);
@@ -1005,11 +1057,31 @@ tensor::TensorCP BEAVYProvider::make_tensor_conversion(MPCProtocol dst_proto,
                                           ToString(src_proto), ToString(dst_proto)));
 }
 
+tensor::TensorCP BEAVYProvider::make_tensor_bit_to_arithmetic_op(const tensor::TensorCP input,
+                                                                 std::size_t bit_size) {
+  count_tensor_use(input);
+  if (input->get_protocol() != MPCProtocol::BooleanBEAVY || input->get_bit_size() != 1) {
+    throw std::invalid_argument(
+        "BEAVYProvider: bit to arithmetic conversion expects a BooleanBEAVY tensor of bit size 1");
+  }
+  switch (bit_size) {
+    case 32:
+      return basic_make_convert_boolean_to_arithmetic_beavy_tensor<std::uint32_t>(input);
+    case 64:
+      return basic_make_convert_boolean_to_arithmetic_beavy_tensor<std::uint64_t>(input);
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+}
+
 tensor::TensorCP BEAVYProvider::make_tensor_conv2d_op(const tensor::Conv2DOp& conv_op,
                                                       const tensor::TensorCP input,
                                                       const tensor::TensorCP kernel,
                                                       const tensor::TensorCP bias,
                                                       std::size_t fractional_bits) {
+  count_tensor_use(input);
+  count_tensor_use(kernel);
+  count_tensor_use(bias);
   if (!conv_op.verify()) {
     throw std::invalid_argument("invalid Conv2dOp");
   }
@@ -1067,6 +1139,8 @@ tensor::TensorCP BEAVYProvider::make_tensor_gemm_op(const tensor::GemmOp& gemm_o
                                                     const tensor::TensorCP input_A,
                                                     const tensor::TensorCP input_B,
                                                     std::size_t fractional_bits) {
+  count_tensor_use(input_A);
+  count_tensor_use(input_B);
   if (!gemm_op.verify()) {
     throw std::invalid_argument("invalid GemmOp");
   }
@@ -1106,8 +1180,44 @@ tensor::TensorCP BEAVYProvider::make_tensor_gemm_op(const tensor::GemmOp& gemm_o
   return output;
 }
 
+tensor::TensorCP BEAVYProvider::make_tensor_mul_op(const tensor::TensorCP input_A,
+                                                   const tensor::TensorCP input_B,
+                                                   std::size_t fractional_bits) {
+  count_tensor_use(input_A);
+  count_tensor_use(input_B);
+  if (input_A->get_bit_size() != input_B->get_bit_size()) {
+    throw std::logic_error("mismatch of bit sizes");
+  }
+  auto bit_size = input_A->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, input_A, input_B, fractional_bits, gate_id,
+                        &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticBEAVYTensorMul<T>>(
+        gate_id, *this, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input_A),
+        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input_B), fractional_bits);
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
 tensor::TensorCP BEAVYProvider::make_tensor_sqr_op(const tensor::TensorCP input,
                                                    std::size_t fractional_bits) {
+  count_tensor_use(input);
   auto bit_size = input->get_bit_size();
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
@@ -1137,6 +1247,7 @@ tensor::TensorCP BEAVYProvider::make_tensor_sqr_op(const tensor::TensorCP input,
 tensor::TensorCP BEAVYProvider::make_tensor_avgpool_op(const tensor::AveragePoolOp& avgpool_op,
                                                        const tensor::TensorCP input,
                                                        std::size_t fractional_bits) {
+  count_tensor_use(input);
   auto bit_size = input->get_bit_size();
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
@@ -1164,6 +1275,64 @@ tensor::TensorCP BEAVYProvider::make_tensor_avgpool_op(const tensor::AveragePool
   return output;
 }
 
+tensor::TensorCP BEAVYProvider::make_tensor_sum_op(const tensor::TensorCP input,
+                                                   std::size_t axis) {
+  count_tensor_use(input);
+  auto bit_size = input->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, input, axis, gate_id, &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticBEAVYTensorSum<T>>(
+        gate_id, *this, axis, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input));
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
+tensor::TensorCP BEAVYProvider::make_tensor_mean_op(const tensor::TensorCP input,
+                                                    std::size_t axis,
+                                                    std::size_t fractional_bits) {
+  count_tensor_use(input);
+  auto bit_size = input->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, input, axis, fractional_bits, gate_id, &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticBEAVYTensorMean<T>>(
+        gate_id, *this, axis, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input),
+        fractional_bits);
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
 tensor::TensorCP BEAVYProvider::make_tensor_relu_op(const tensor::TensorCP in) {
   const auto input_tensor = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(in);
   assert(input_tensor != nullptr);
@@ -1192,6 +1361,7 @@ tensor::TensorCP BEAVYProvider::basic_make_tensor_relu_op(const tensor::TensorCP
 
 tensor::TensorCP BEAVYProvider::make_tensor_relu_op(const tensor::TensorCP in_bool,
                                                     const tensor::TensorCP in_arith) {
+  count_tensor_use(in_arith);
   if (in_bool->get_protocol() != MPCProtocol::BooleanBEAVY ||
       in_arith->get_protocol() != MPCProtocol::ArithmeticBEAVY) {
     throw std::invalid_argument("expected Boolean and arithmetic BEAVY, respectively");
@@ -1212,6 +1382,12 @@ tensor::TensorCP BEAVYProvider::make_tensor_relu_op(const tensor::TensorCP in_bo
   }
 }
 
+bool BEAVYProvider::supports_tensor_relu_op(MPCProtocol bool_protocol,
+                                            MPCProtocol arith_protocol) const noexcept {
+  return bool_protocol == MPCProtocol::BooleanBEAVY &&
+         arith_protocol == MPCProtocol::ArithmeticBEAVY;
+}
+
 tensor::TensorCP BEAVYProvider::make_tensor_maxpool_op(const tensor::MaxPoolOp& maxpool_op,
                                                        const tensor::TensorCP in) {
   const auto input_tensor = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(in);
@@ -1224,8 +1400,40 @@ tensor::TensorCP BEAVYProvider::make_tensor_maxpool_op(const tensor::MaxPoolOp&
   return output;
 }
 
+tensor::TensorCP BEAVYProvider::make_tensor_gt_public_op(
+    const tensor::TensorCP in, const std::vector<std::uint64_t>& constants) {
+  const auto input_tensor = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(in);
+  if (input_tensor == nullptr) {
+    throw std::invalid_argument(
+        "BEAVYProvider: GT with public constants expects a Boolean BEAVY tensor");
+  }
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto tensor_op = std::make_unique<BooleanBEAVYTensorGTPublic>(
+      gate_id, *this, input_tensor, tensor::broadcast_per_channel(in->get_dimensions(), constants));
+  auto output = tensor_op->get_output_tensor();
+  gate_register_.register_gate(std::move(tensor_op));
+  return output;
+}
+
+tensor::TensorCP BEAVYProvider::make_tensor_clip_op(const tensor::TensorCP in, std::uint64_t min,
+                                                    std::uint64_t max) {
+  const auto input_tensor = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(in);
+  if (input_tensor == nullptr) {
+    throw std::invalid_argument("BEAVYProvider: Clip expects a Boolean BEAVY tensor");
+  }
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto tensor_op = std::make_unique<BooleanBEAVYTensorClip>(gate_id, *this, input_tensor, min, max);
+  auto output = tensor_op->get_output_tensor();
+  gate_register_.register_gate(std::move(tensor_op));
+  return output;
+}
+
 // Functions defined to perform constant operations (addnl)
 tensor::TensorCP BEAVYProvider::make_tensor_negate(const tensor::TensorCP in) {
+  if (fuse_local_tensor_ops_) {
+    return make_fused_linear_tensor_op({{-std::uint64_t(1), in}}, 0, in->get_dimensions());
+  }
+  count_tensor_use(in);
   auto bit_size = in->get_bit_size();
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
@@ -1254,16 +1462,22 @@ tensor::TensorCP BEAVYProvider::make_tensor_negate(const tensor::TensorCP in) {
 }
 
 //(addnl)
-tensor::TensorCP BEAVYProvider::make_tensor_constMul_op(const tensor::TensorCP in,const uint64_t k) {
+tensor::TensorCP BEAVYProvider::make_tensor_constMul_op(const tensor::TensorCP in,const uint64_t k,
+                                                       std::size_t fractional_bits) {
+  if (fuse_local_tensor_ops_ && fractional_bits == 0) {
+    return make_fused_linear_tensor_op({{k, in}}, 0, in->get_dimensions());
+  }
+  count_tensor_use(in);
   auto bit_size = in->get_bit_size();
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
   tensor::TensorCP output;
-  const auto make_op = [this, in, gate_id, k,
+  const auto make_op = [this, in, gate_id, k, fractional_bits,
                         &output](auto dummy_arg) {
     using T = decltype(dummy_arg);
     auto tensor_op = std::make_unique<ArithmeticBEAVYTensorConstMul<T>>(
-        gate_id, *this, k, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(in));
+        gate_id, *this, k, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(in),
+        fractional_bits);
     output = tensor_op->get_output_tensor();
     return tensor_op;
   };
@@ -1282,8 +1496,44 @@ tensor::TensorCP BEAVYProvider::make_tensor_constMul_op(const tensor::TensorCP i
 
 }
 
+tensor::TensorCP BEAVYProvider::make_tensor_constAdd_op(const tensor::TensorCP in,
+                                                       const uint64_t k) {
+  if (fuse_local_tensor_ops_) {
+    return make_fused_linear_tensor_op({{1, in}}, k, in->get_dimensions());
+  }
+  count_tensor_use(in);
+  auto bit_size = in->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, in, gate_id, k, &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticBEAVYTensorConstAdd<T>>(
+        gate_id, *this, k, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(in));
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
 //(addnl)
 tensor::TensorCP BEAVYProvider::make_tensor_add_op(const tensor::TensorCP inputA,const tensor::TensorCP inputB) {
+  if (fuse_local_tensor_ops_) {
+    return make_fused_linear_tensor_op({{1, inputA}, {1, inputB}}, 0, inputA->get_dimensions());
+  }
+  count_tensor_use(inputA);
+  count_tensor_use(inputB);
   auto bit_size = inputA->get_bit_size();
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
@@ -1312,8 +1562,108 @@ tensor::TensorCP BEAVYProvider::make_tensor_add_op(const tensor::TensorCP inputA
 
 }
 
+namespace {
+
+// maximal number of inputs of a fused gate, longer chains are cut
+constexpr std::size_t max_fused_terms = 8;
+
+}  // namespace
+
+tensor::TensorCP BEAVYProvider::make_fused_linear_tensor_op(
+    const LinearTerms& terms, std::uint64_t constant,
+    const tensor::TensorDimensions& output_dims) {
+  const auto bit_size = terms.front().second->get_bit_size();
+  LinearTerms fused_terms;
+  const auto add_term = [&fused_terms](std::uint64_t c, const tensor::TensorCP& x) {
+    auto it = std::find_if(std::begin(fused_terms), std::end(fused_terms),
+                           [&x](const auto& term) { return term.second == x; });
+    if (it != std::end(fused_terms)) {
+      it->first += c;
+    } else {
+      fused_terms.emplace_back(c, x);
+    }
+  };
+
+  for (const auto& [c, input] : terms) {
+    if (input->get_protocol() != MPCProtocol::ArithmeticBEAVY) {
+      throw std::invalid_argument(
+          fmt::format("BEAVYProvider: expected ArithmeticBEAVY tensor, got {}",
+                      ToString(input->get_protocol())));
+    }
+    if (input->get_bit_size() != bit_size) {
+      throw std::invalid_argument(fmt::format(
+          "BEAVYProvider: mismatching bit sizes {} and {}", bit_size, input->get_bit_size()));
+    }
+    auto it = fused_linear_ops_.find(input.get());
+    if (it != std::end(fused_linear_ops_) &&
+        fused_terms.size() + it->second.terms.size() <= max_fused_terms) {
+      // c * (sum_j c_j * x_j + k) = sum_j (c * c_j) * x_j + c * k
+      for (const auto& [c_j, x_j] : it->second.terms) {
+        add_term(c * c_j, x_j);
+      }
+      constant += c * it->second.constant;
+      it->second.is_absorbed = true;
+    } else {
+      count_tensor_use(input);
+      add_term(c, input);
+    }
+  }
+  // drop terms which cancelled out
+  fused_terms.erase(std::remove_if(std::begin(fused_terms), std::end(fused_terms),
+                                   [](const auto& term) { return term.first == 0; }),
+                    std::end(fused_terms));
+
+  tensor::TensorCP output;
+  switch (bit_size) {
+    case 32:
+      output = basic_make_fused_linear_tensor_op<std::uint32_t>(fused_terms, constant, output_dims);
+      break;
+    case 64:
+      output = basic_make_fused_linear_tensor_op<std::uint64_t>(fused_terms, constant, output_dims);
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  fused_linear_ops_.emplace(output.get(), FusedLinearOp{std::move(fused_terms), constant});
+  return output;
+}
+
+void BEAVYProvider::count_tensor_use(const tensor::TensorCP& tensor) {
+  if (tensor == nullptr) {
+    return;
+  }
+  auto it = fused_linear_ops_.find(tensor.get());
+  if (it != std::end(fused_linear_ops_)) {
+    ++it->second.num_other_uses;
+  }
+}
+
+bool BEAVYProvider::is_fused_output_used(const tensor::Tensor* output) const {
+  return unused_fused_outputs_.count(output) == 0;
+}
+
+template <typename T>
+tensor::TensorCP BEAVYProvider::basic_make_fused_linear_tensor_op(
+    const LinearTerms& terms, std::uint64_t constant,
+    const tensor::TensorDimensions& output_dims) {
+  using Gate = ArithmeticBEAVYTensorLinearCombination<T>;
+  std::vector<typename Gate::Term> typed_terms;
+  typed_terms.reserve(terms.size());
+  for (const auto& [c, input] : terms) {
+    typed_terms.emplace_back(static_cast<T>(c),
+                             std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input));
+  }
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto gate = std::make_unique<Gate>(gate_id, *this, output_dims, std::move(typed_terms),
+                                     static_cast<T>(constant));
+  tensor::TensorCP output = gate->get_output_tensor();
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
 //(addnl)
 std::vector<tensor::TensorCP> BEAVYProvider::make_tensor_split_op(const tensor::TensorCP in) {
+  count_tensor_use(in);
   auto bit_size = in->get_bit_size();
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
@@ -1354,6 +1704,8 @@ tensor::TensorCP BEAVYProvider::make_tensor_join_op(const tensor::JoinOp& join_o
                                                     const tensor::TensorCP input_A,
                                                     const tensor::TensorCP input_B,
                                                     std::size_t fractional_bits) {
+  count_tensor_use(input_A);
+  count_tensor_use(input_B);
   if (!join_op.verify()) {
     throw std::invalid_argument("invalid JoinOp");
   }
@@ -22,7 +22,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "base/gate_factory.h"
@@ -103,6 +107,18 @@ class BEAVYProvider : public GateFactory,
 
   bool get_fake_setup() const noexcept { return fake_setup_; }
 
+  // Fuse chains of the local linear tensor operations Add, Negate, ConstAdd,
+  // and ConstMul without truncation into single
+  // ArithmeticBEAVYTensorLinearCombination gates (enabled by default).
+  void set_fuse_local_tensor_ops(bool fuse) noexcept { fuse_local_tensor_ops_ = fuse; }
+  bool get_fuse_local_tensor_ops() const noexcept { return fuse_local_tensor_ops_; }
+  // Whether another gate reads the output of a fused gate.  The uses are
+  // counted in the make_* calls of this provider; gates of other providers
+  // read ArithmeticBEAVY tensors only after a conversion, which is first
+  // tried with make_tensor_conversion of this provider (see
+  // NetworkBuilder::convert).  Only valid after setup().
+  bool is_fused_output_used(const tensor::Tensor*) const;
+
   // Implementation of GateFactors interface
 
   // Boolean inputs
@@ -194,16 +210,21 @@ class BEAVYProvider : public GateFactory,
 
   // arithmetic outputs
   ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>> make_arithmetic_32_tensor_output_my(
-      const tensor::TensorCP&) override;
+      const tensor::TensorCP&, std::size_t output_bit_size = 0) override;
   ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>> make_arithmetic_64_tensor_output_my(
-      const tensor::TensorCP&) override;
+      const tensor::TensorCP&, std::size_t output_bit_size = 0) override;
 
   // conversions
   tensor::TensorCP make_tensor_conversion(MPCProtocol, const tensor::TensorCP input) override;
+  tensor::TensorCP make_tensor_bit_to_arithmetic_op(const tensor::TensorCP input,
+                                                    std::size_t bit_size) override;
 
-  void make_arithmetic_tensor_output_other(const tensor::TensorCP&) override;
+  void make_arithmetic_tensor_output_other(const tensor::TensorCP&,
+                                           std::size_t output_bit_size = 0) override;
 
   tensor::TensorCP make_tensor_flatten_op(const tensor::TensorCP input, std::size_t axis) override;
+  tensor::TensorCP make_tensor_reshape_op(const tensor::TensorCP input,
+                                          const tensor::TensorDimensions& dims) override;
   tensor::TensorCP make_tensor_conv2d_op(const tensor::Conv2DOp& conv_op,
                                          const tensor::TensorCP input,
                                          const tensor::TensorCP kernel, const tensor::TensorCP bias,
@@ -219,13 +240,27 @@ class BEAVYProvider : public GateFactory,
   template <typename T>
   tensor::TensorCP basic_make_tensor_relu_op(const tensor::TensorCP, const tensor::TensorCP);
   tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP, const tensor::TensorCP) override;
+  bool supports_tensor_relu_op(MPCProtocol bool_protocol,
+                               MPCProtocol arith_protocol) const noexcept override;
   tensor::TensorCP make_tensor_maxpool_op(const tensor::MaxPoolOp&,
                                           const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_gt_public_op(const tensor::TensorCP,
+                                            const std::vector<std::uint64_t>&) override;
+  tensor::TensorCP make_tensor_clip_op(const tensor::TensorCP, std::uint64_t min,
+                                       std::uint64_t max) override;
   tensor::TensorCP make_tensor_avgpool_op(const tensor::AveragePoolOp&, const tensor::TensorCP,
                                           std::size_t fractional_bits = 0) override;
+  tensor::TensorCP make_tensor_sum_op(const tensor::TensorCP input, std::size_t axis) override;
+  tensor::TensorCP make_tensor_mean_op(const tensor::TensorCP input, std::size_t axis,
+                                       std::size_t fractional_bits) override;
   //Functions defined to perform constant operations (addnl)
   tensor::TensorCP make_tensor_negate(const tensor::TensorCP) override;
-  tensor::TensorCP make_tensor_constMul_op(const tensor::TensorCP,const uint64_t k) override;
+  tensor::TensorCP make_tensor_constMul_op(const tensor::TensorCP,const uint64_t k,
+                                           std::size_t fractional_bits = 0) override;
+  tensor::TensorCP make_tensor_constAdd_op(const tensor::TensorCP, const uint64_t k) override;
+  tensor::TensorCP make_tensor_mul_op(const tensor::TensorCP input_A,
+                                      const tensor::TensorCP input_B,
+                                      std::size_t fractional_bits = 0) override;
   tensor::TensorCP make_tensor_add_op(const tensor::TensorCP,const tensor::TensorCP) override;
   std::vector<tensor::TensorCP> make_tensor_split_op(const tensor::TensorCP) override;
   tensor::TensorCP make_tensor_join_op(const tensor::JoinOp& join_op,
@@ -317,9 +352,20 @@ class BEAVYProvider : public GateFactory,
   
   template <typename T>
   ENCRYPTO::ReusableFiberFuture<IntegerValues<T>> basic_make_arithmetic_tensor_output_my(
-      const tensor::TensorCP&);
+      const tensor::TensorCP&, std::size_t output_bit_size = 0);
 
  private:
+  // y = sum_j c_j * x_j + k, where inputs that are outputs of fused gates are
+  // replaced by the terms of these gates
+  using LinearTerms = std::vector<std::pair<std::uint64_t, tensor::TensorCP>>;
+  tensor::TensorCP make_fused_linear_tensor_op(const LinearTerms&, std::uint64_t constant,
+                                               const tensor::TensorDimensions& output_dims);
+  template <typename T>
+  tensor::TensorCP basic_make_fused_linear_tensor_op(const LinearTerms&, std::uint64_t constant,
+                                                     const tensor::TensorDimensions& output_dims);
+  // count a gate reading the tensor, if it is the output of a fused gate
+  void count_tensor_use(const tensor::TensorCP&);
+
   Communication::CommunicationLayer& communication_layer_;
   GateRegister& gate_register_;
   CircuitLoader& circuit_loader_;
@@ -331,6 +377,20 @@ class BEAVYProvider : public GateFactory,
   std::size_t next_input_id_;
   std::shared_ptr<Logger> logger_;
   bool fake_setup_;
+  bool fuse_local_tensor_ops_ = true;
+  // terms of the fused gates by their output tensors, used to extend chains;
+  // the output tensors are kept alive by their gates
+  struct FusedLinearOp {
+    LinearTerms terms;
+    std::uint64_t constant;
+    // if the terms have been copied into a longer chain
+    bool is_absorbed = false;
+    // number of other gates reading the output
+    std::size_t num_other_uses = 0;
+  };
+  std::unordered_map<const tensor::Tensor*, FusedLinearOp> fused_linear_ops_;
+  // outputs of fused gates which nobody reads, determined in setup()
+  std::unordered_set<const tensor::Tensor*> unused_fused_outputs_;
 };
 
 }  // namespace proto::beavy
@@ -22,6 +22,12 @@
 
 #pragma once
 
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include "tensor/tensor.h"
 #include "utility/bit_vector.h"
 #include "utility/enable_wait.h"
@@ -34,17 +40,35 @@ template <typename T>
 class ArithmeticBEAVYTensor : public tensor::Tensor, public ENCRYPTO::enable_wait_setup {
  public:
   using Tensor::Tensor;
+  // View with other dimensions on the shares of base, which need to contain
+  // the same number of elements.  No data is copied, but the view still needs
+  // to be marked as ready by the gate creating it.  Views always cover all
+  // elements of base: offset or strided views (and hence slices) are not
+  // supported, since the share accessors and all kernels work on contiguous
+  // std::vectors starting at the first element.
+  ArithmeticBEAVYTensor(const tensor::TensorDimensions& dims, const ArithmeticBEAVYTensor& base)
+      : Tensor(dims), public_share_(base.public_share_), secret_share_(base.secret_share_) {
+    if (dims.get_data_size() != base.get_dimensions().get_data_size()) {
+      throw std::invalid_argument(
+          fmt::format("ArithmeticBEAVYTensor: cannot view {} elements as {} elements",
+                      base.get_dimensions().get_data_size(), dims.get_data_size()));
+    }
+  }
   MPCProtocol get_protocol() const noexcept override { return MPCProtocol::ArithmeticBEAVY; }
   std::size_t get_bit_size() const noexcept override { return ENCRYPTO::bit_size_v<T>; }
-  std::vector<T>& get_public_share() { return public_share_; };
-  const std::vector<T>& get_public_share() const { return public_share_; };
-  std::vector<T>& get_secret_share() { return secret_share_; };
-  const std::vector<T>& get_secret_share() const { return secret_share_; };
+  std::vector<T>& get_public_share() { return *public_share_; };
+  const std::vector<T>& get_public_share() const { return *public_share_; };
+  std::vector<T>& get_secret_share() { return *secret_share_; };
+  const std::vector<T>& get_secret_share() const { return *secret_share_; };
+  bool is_view_of(const ArithmeticBEAVYTensor& base) const noexcept {
+    return public_share_ == base.public_share_;
+  }
 
  private:
   using is_enabled_ = ENCRYPTO::is_unsigned_int_t<T>;
-  std::vector<T> public_share_;
-  std::vector<T> secret_share_;
+  // shared with views of this tensor
+  std::shared_ptr<std::vector<T>> public_share_ = std::make_shared<std::vector<T>>();
+  std::shared_ptr<std::vector<T>> secret_share_ = std::make_shared<std::vector<T>>();
 };
 
 template <typename T>
@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "utility/bit_vector.h"
+#include "utility/type_traits.hpp"
+
+// Kernels for the local computations of the BEAVY tensor gates.
+//
+// The bit width is a template parameter via the integer type and the party
+// role via `my_job`, so that the inner loops are free of branches and can be
+// vectorized by the compiler.
+
+namespace MOTION::proto::beavy::kernels {
+
+// number of integers processed by a thread at once
+constexpr std::size_t chunk_size = 4096;
+
+// out[i] <- bits[i] (or its negation if `invert`) as integer in {0, 1}
+template <typename T, bool invert = false>
+void unpack_bits(const std::byte* bits, T* out, std::size_t n) {
+  const auto num_full_bytes = n / 8;
+  for (std::size_t byte_i = 0; byte_i < num_full_bytes; ++byte_i) {
+    auto byte = std::to_integer<unsigned>(bits[byte_i]);
+    if constexpr (invert) {
+      byte = ~byte;
+    }
+    for (std::size_t bit_k = 0; bit_k < 8; ++bit_k) {
+      out[8 * byte_i + bit_k] = (byte >> bit_k) & 1;
+    }
+  }
+  for (std::size_t i = 8 * num_full_bytes; i < n; ++i) {
+    out[i] = ((std::to_integer<unsigned>(bits[i / 8]) >> (i % 8)) & 1) ^ invert;
+  }
+}
+
+template <typename T, bool invert = false>
+void unpack_bits(const ENCRYPTO::BitVector<>& bits, T* out) {
+  unpack_bits<T, invert>(bits.GetData().data(), out, bits.GetSize());
+}
+
+// Combines the arithmetized bits of a Boolean sharing to an arithmetic share:
+//
+//   out[i] += \sum_j ([my_job] * p_j[i] + (1 - 2 * p_j[i]) * s_j[i]) << j
+//
+// where p_j[i] = public_bits[j * data_size + i] and similarly for s, and j
+// ranges over the bit_size bits of the Boolean sharing.
+template <typename T, bool my_job>
+void boolean_to_arithmetic(const T* public_bits, const T* secret_bits, T* out,
+                           std::size_t data_size,
+                           std::size_t bit_size = ENCRYPTO::bit_size_v<T>) {
+#pragma omp parallel for
+  for (std::size_t chunk_begin = 0; chunk_begin < data_size; chunk_begin += chunk_size) {
+    const auto chunk_end = std::min(chunk_begin + chunk_size, data_size);
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      const auto p = public_bits + bit_j * data_size;
+      const auto s = secret_bits + bit_j * data_size;
+      for (std::size_t int_i = chunk_begin; int_i < chunk_end; ++int_i) {
+        T v = (1 - 2 * p[int_i]) * s[int_i];
+        if constexpr (my_job) {
+          v += p[int_i];
+        }
+        out[int_i] += v << bit_j;
+      }
+    }
+  }
+}
+
+// Public share of the ReLU as product of the (inverted) MSB b and the input n,
+// cf. BooleanXArithmeticBEAVYTensorRelu.
+template <typename T, bool my_job>
+void relu_public_share(const T* Delta_b, const T* Delta_n, const T* delta_b_share,
+                       const T* delta_n_share, const T* delta_b_x_delta_n_share,
+                       const T* delta_y_share, T* out, std::size_t data_size) {
+#pragma omp parallel for
+  for (std::size_t chunk_begin = 0; chunk_begin < data_size; chunk_begin += chunk_size) {
+    const auto chunk_end = std::min(chunk_begin + chunk_size, data_size);
+    for (std::size_t int_i = chunk_begin; int_i < chunk_end; ++int_i) {
+      const auto b = Delta_b[int_i];
+      const auto n = Delta_n[int_i];
+      T v = delta_b_share[int_i] * (n - 2 * b * n) - b * delta_n_share[int_i] -
+            delta_b_x_delta_n_share[int_i] * (1 - 2 * b) + delta_y_share[int_i];
+      if constexpr (my_job) {
+        v += b * n;
+      }
+      out[int_i] = v;
+    }
+  }
+}
+
+// out[i] <- constant + sum_j coefficients[j] * inputs[j][i], used for both
+// shares of a fused chain of local linear operations in one pass over the data
+template <typename T>
+void linear_combination(const T* coefficients, const T* const* inputs, std::size_t num_inputs,
+                        T constant, T* out, std::size_t data_size) {
+#pragma omp parallel for
+  for (std::size_t chunk_begin = 0; chunk_begin < data_size; chunk_begin += chunk_size) {
+    const auto chunk_end = std::min(chunk_begin + chunk_size, data_size);
+    std::fill(out + chunk_begin, out + chunk_end, constant);
+    for (std::size_t input_j = 0; input_j < num_inputs; ++input_j) {
+      const auto c = coefficients[input_j];
+      const auto* in = inputs[input_j];
+      for (std::size_t int_i = chunk_begin; int_i < chunk_end; ++int_i) {
+        out[int_i] += c * in[int_i];
+      }
+    }
+  }
+}
+
+}  // namespace MOTION::proto::beavy::kernels
@@ -28,6 +28,7 @@
 #include "algorithm/circuit_loader.h"
 #include "algorithm/make_circuit.h"
 #include "beavy_provider.h"
+#include "tensor_kernels.h"
 #include "crypto/arithmetic_provider.h"
 #include "crypto/motion_base_provider.h"
 #include "crypto/multiplication_triple/linalg_triple_provider.h"
@@ -38,6 +39,7 @@
 #include "executor/execution_context.h"
 #include "utility/constants.h"
 #include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
+#include "utility/bit_packing.h"
 #include "utility/fixed_point.h"
 #include "utility/helpers.h"
 #include "utility/linear_algebra.h"
@@ -322,15 +324,21 @@ template <typename T>
 ArithmeticBEAVYTensorOutput<T>::ArithmeticBEAVYTensorOutput(std::size_t gate_id,
                                                             BEAVYProvider& beavy_provider,
                                                             ArithmeticBEAVYTensorCP<T> input,
-                                                            std::size_t output_owner)
+                                                            std::size_t output_owner,
+                                                            std::size_t output_bit_size)
     : NewGate(gate_id),
       beavy_provider_(beavy_provider),
       output_owner_(output_owner),
+      output_bit_size_(output_bit_size == 0 ? ENCRYPTO::bit_size_v<T> : output_bit_size),
       input_(input) {
+  if (output_bit_size_ > ENCRYPTO::bit_size_v<T>) {
+    throw std::invalid_argument(fmt::format("invalid output bit size {} for {} bit tensor",
+                                            output_bit_size_, ENCRYPTO::bit_size_v<T>));
+  }
   auto my_id = beavy_provider_.get_my_id();
   if (output_owner_ == my_id) {
     secret_share_future_ = beavy_provider_.register_for_ints_message<T>(
-        1 - my_id, gate_id_, input_->get_dimensions().get_data_size());
+        1 - my_id, gate_id_, input_->get_dimensions().get_data_size(), 0, output_bit_size_);
   }
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
@@ -361,7 +369,8 @@ void ArithmeticBEAVYTensorOutput<T>::evaluate_setup() {
     __gnu_parallel::transform(std::begin(secret_shares_), std::end(secret_shares_),
                               std::begin(my_secret_share), std::begin(secret_shares_), std::plus{});
   } else {
-    beavy_provider_.send_ints_message<T>(1 - my_id, gate_id_, my_secret_share);
+    beavy_provider_.send_ints_message<T>(1 - my_id, gate_id_, my_secret_share, 0,
+                                         output_bit_size_);
   }
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
@@ -391,6 +400,9 @@ void ArithmeticBEAVYTensorOutput<T>::evaluate_online() {
     assert(secret_shares_.size() == input_->get_dimensions().get_data_size());
     __gnu_parallel::transform(std::begin(public_share), std::end(public_share),
                               std::begin(secret_shares_), std::begin(secret_shares_), std::minus{});
+    if (output_bit_size_ < ENCRYPTO::bit_size_v<T>) {
+      sign_extend_ints(secret_shares_.data(), secret_shares_.size(), output_bit_size_);
+    }
     output_promise_.set_value(std::move(secret_shares_));
   }
 
@@ -417,67 +429,77 @@ template class ArithmeticBEAVYTensorOutput<std::uint32_t>;
 template class ArithmeticBEAVYTensorOutput<std::uint64_t>;
 
 template <typename T>
-ArithmeticBEAVYTensorFlatten<T>::ArithmeticBEAVYTensorFlatten(
-    std::size_t gate_id, BEAVYProvider& beavy_provider, std::size_t axis,
-    const ArithmeticBEAVYTensorCP<T> input)
-    : NewGate(gate_id), beavy_provider_(beavy_provider), input_(input) {
-  const auto& input_dims = input_->get_dimensions();
-  output_ = std::make_shared<ArithmeticBEAVYTensor<T>>(flatten(input_dims, axis));
-
+ArithmeticBEAVYTensorReshape<T>::ArithmeticBEAVYTensorReshape(
+    std::size_t gate_id, BEAVYProvider& beavy_provider,
+    const tensor::TensorDimensions& output_dims, const ArithmeticBEAVYTensorCP<T> input)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      input_(input),
+      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(output_dims, *input_)) {
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
-      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorFlatten<T> created", gate_id_));
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorReshape<T> created", gate_id_));
     }
   }
 }
 
 template <typename T>
-void ArithmeticBEAVYTensorFlatten<T>::evaluate_setup() {
+void ArithmeticBEAVYTensorReshape<T>::evaluate_setup() {
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorFlatten<T>::evaluate_setup start", gate_id_));
+          fmt::format("Gate {}: ArithmeticBEAVYTensorReshape<T>::evaluate_setup start", gate_id_));
     }
   }
 
+  // the output shares the secret share of the input
   input_->wait_setup();
-  output_->get_secret_share() = input_->get_secret_share();
   output_->set_setup_ready();
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorFlatten<T>::evaluate_setup end", gate_id_));
+          fmt::format("Gate {}: ArithmeticBEAVYTensorReshape<T>::evaluate_setup end", gate_id_));
     }
   }
 }
 
 template <typename T>
-void ArithmeticBEAVYTensorFlatten<T>::evaluate_online() {
+void ArithmeticBEAVYTensorReshape<T>::evaluate_online() {
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorFlatten<T>::evaluate_online start", gate_id_));
+          fmt::format("Gate {}: ArithmeticBEAVYTensorReshape<T>::evaluate_online start", gate_id_));
     }
   }
 
+  // the output shares the public share of the input
   input_->wait_online();
-  output_->get_public_share() = input_->get_public_share();
   output_->set_online_ready();
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorFlatten<T>::evaluate_online end", gate_id_));
+          fmt::format("Gate {}: ArithmeticBEAVYTensorReshape<T>::evaluate_online end", gate_id_));
     }
   }
 }
 
+template class ArithmeticBEAVYTensorReshape<std::uint32_t>;
+template class ArithmeticBEAVYTensorReshape<std::uint64_t>;
+
+template <typename T>
+ArithmeticBEAVYTensorFlatten<T>::ArithmeticBEAVYTensorFlatten(
+    std::size_t gate_id, BEAVYProvider& beavy_provider, std::size_t axis,
+    const ArithmeticBEAVYTensorCP<T> input)
+    : ArithmeticBEAVYTensorReshape<T>(gate_id, beavy_provider,
+                                      flatten(input->get_dimensions(), axis), input) {}
+
 template class ArithmeticBEAVYTensorFlatten<std::uint32_t>;
 template class ArithmeticBEAVYTensorFlatten<std::uint64_t>;
 
@@ -553,8 +575,7 @@ void ArithmeticBEAVYTensorConv2D<T>::evaluate_setup() {
   }
 
   if (!beavy_provider_.get_fake_setup()) {
-    conv_input_side_->compute_output();
-    conv_kernel_side_->compute_output();
+    compute_convolution_outputs(*conv_kernel_side_, *conv_input_side_);
   }
   std::vector<T> delta_ab_share1;
   std::vector<T> delta_ab_share2;
@@ -728,8 +749,7 @@ void ArithmeticBEAVYTensorGemm<T>::evaluate_setup() {
   }
 
   if (!beavy_provider_.get_fake_setup()) {
-    mm_lhs_side_->compute_output();
-    mm_rhs_side_->compute_output();
+    compute_matrix_multiplication_outputs(*mm_lhs_side_, *mm_rhs_side_);
   }
   std::vector<T> delta_ab_share1;
   std::vector<T> delta_ab_share2;
@@ -1282,6 +1302,211 @@ void ArithmeticBEAVYTensorAveragePool<T>::evaluate_online() {
 template class ArithmeticBEAVYTensorAveragePool<std::uint32_t>;
 template class ArithmeticBEAVYTensorAveragePool<std::uint64_t>;
 
+template <typename T>
+ArithmeticBEAVYTensorSum<T>::ArithmeticBEAVYTensorSum(std::size_t gate_id,
+                                                      BEAVYProvider& beavy_provider,
+                                                      std::size_t axis,
+                                                      const ArithmeticBEAVYTensorCP<T> input)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      axis_(axis),
+      input_(input),
+      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(
+          tensor::reduce(input_->get_dimensions(), axis_))) {
+  if (axis_ > 3) {
+    throw std::invalid_argument("invalid axis argument > 3");
+  }
+  const auto output_size = output_->get_dimensions().get_data_size();
+  output_->get_secret_share().resize(output_size);
+  output_->get_public_share().resize(output_size);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorSum<T> created", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSum<T>::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorSum<T>::evaluate_setup start", gate_id_));
+    }
+  }
+
+  // delta_y = sum(delta_x)
+  input_->wait_setup();
+  sum_reduce(input_->get_dimensions(), axis_, input_->get_secret_share().data(),
+             output_->get_secret_share().data());
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorSum<T>::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSum<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorSum<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  // Delta_y = sum(Delta_x)
+  input_->wait_online();
+  sum_reduce(input_->get_dimensions(), axis_, input_->get_public_share().data(),
+             output_->get_public_share().data());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorSum<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticBEAVYTensorSum<std::uint32_t>;
+template class ArithmeticBEAVYTensorSum<std::uint64_t>;
+
+template <typename T>
+ArithmeticBEAVYTensorMean<T>::ArithmeticBEAVYTensorMean(std::size_t gate_id,
+                                                        BEAVYProvider& beavy_provider,
+                                                        std::size_t axis,
+                                                        const ArithmeticBEAVYTensorCP<T> input,
+                                                        std::size_t fractional_bits)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      axis_(axis),
+      data_size_(input->get_dimensions().get_data_size()),
+      fractional_bits_(fractional_bits),
+      input_(input),
+      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(
+          tensor::reduce(input_->get_dimensions(), axis_))) {
+  if (axis_ > 3) {
+    throw std::invalid_argument("invalid axis argument > 3");
+  }
+  if (fractional_bits_ >= ENCRYPTO::bit_size_v<T>) {
+    throw std::invalid_argument(
+        fmt::format("ArithmeticBEAVYTensorMean: {} fractional bits for {} bit tensor",
+                    fractional_bits_, ENCRYPTO::bit_size_v<T>));
+  }
+  output_size_ = output_->get_dimensions().get_data_size();
+  const auto num_summands = data_size_ / output_size_;
+  if (num_summands > (T(1) << fractional_bits_)) {
+    throw std::invalid_argument(
+        "ArithmeticBEAVYTensorMean: not enough fractional bits to represent factor");
+  }
+  factor_ = fixed_point::encode<T>(1.0 / num_summands, fractional_bits_);
+  tmp_in_.resize(data_size_);
+  tmp_out_.resize(output_size_);
+  const auto my_id = beavy_provider_.get_my_id();
+  share_future_ = beavy_provider_.register_for_ints_message<T>(1 - my_id, gate_id_, output_size_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorMean<T> created", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorMean<T>::compute_and_broadcast_share(std::vector<T>& A_share) {
+  // compute the scaled sum on the A share
+  sum_reduce(input_->get_dimensions(), axis_, A_share.data(), tmp_out_.data());
+  const auto factor = factor_;
+  __gnu_parallel::transform(std::begin(tmp_out_), std::end(tmp_out_), std::begin(tmp_out_),
+                            [factor](auto x) { return x * factor; });
+  fixed_point::truncate_shared(tmp_out_.data(), fractional_bits_, tmp_out_.size(),
+                               beavy_provider_.is_my_job(gate_id_));
+  // convert: A -> alpha, mask with secret_share + send
+  __gnu_parallel::transform(std::begin(tmp_out_), std::end(tmp_out_),
+                            std::begin(output_->get_secret_share()), std::begin(tmp_out_),
+                            std::plus{});
+  beavy_provider_.broadcast_ints_message(gate_id_, tmp_out_);
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorMean<T>::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorMean<T>::evaluate_setup start", gate_id_));
+    }
+  }
+
+  output_->get_secret_share() = Helpers::RandomVector<T>(output_size_);
+  output_->set_setup_ready();
+
+  if (!beavy_provider_.is_my_job(gate_id_)) {
+    input_->wait_setup();
+    // convert: alpha -> A
+    __gnu_parallel::transform(std::begin(input_->get_secret_share()),
+                              std::end(input_->get_secret_share()), std::begin(tmp_in_),
+                              std::negate{});
+    compute_and_broadcast_share(tmp_in_);
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorMean<T>::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorMean<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorMean<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  if (beavy_provider_.is_my_job(gate_id_)) {
+    input_->wait_online();
+    // convert: alpha -> A
+    __gnu_parallel::transform(
+        std::begin(input_->get_public_share()), std::end(input_->get_public_share()),
+        std::begin(input_->get_secret_share()), std::begin(tmp_in_), std::minus{});
+    compute_and_broadcast_share(tmp_in_);
+  }
+
+  auto other_share = share_future_.get();
+  __gnu_parallel::transform(std::begin(tmp_out_), std::end(tmp_out_), std::begin(other_share),
+                            std::begin(tmp_out_), std::plus{});
+  output_->get_public_share() = std::move(tmp_out_);
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorMean<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticBEAVYTensorMean<std::uint32_t>;
+template class ArithmeticBEAVYTensorMean<std::uint64_t>;
+
 //Implementation of Tensor Negation (addnl)
 template <typename T>
 ArithmeticBEAVYTensorNegate<T>::ArithmeticBEAVYTensorNegate(std::size_t gate_id,
@@ -1392,20 +1617,26 @@ template <typename T>
 ArithmeticBEAVYTensorConstMul<T>::ArithmeticBEAVYTensorConstMul(std::size_t gate_id,
                                                         BEAVYProvider& beavy_provider,
                                                         const T k,
-                                                        const ArithmeticBEAVYTensorCP<T> input)
+                                                        const ArithmeticBEAVYTensorCP<T> input,
+                                                        std::size_t fractional_bits)
     : NewGate(gate_id),
       beavy_provider_(beavy_provider),
-      constant_(k),
       input_(input),
+      constant_(k),
+      fractional_bits_(fractional_bits),
       output_(std::make_shared<ArithmeticBEAVYTensor<T>>(input_->get_dimensions())) {
   const auto my_id = beavy_provider_.get_my_id();
   const auto output_size = input_->get_dimensions().get_data_size();
   Delta_y_.resize(output_size);
+  if (fractional_bits_ > 0) {
+    // truncation requires a fresh sharing of the output
+    share_future_ = beavy_provider_.register_for_ints_message<T>(1 - my_id, gate_id_, output_size);
+  }
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
-      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorGemm<T> created", gate_id_));
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorConstMul<T> created", gate_id_));
     }
   }
 }
@@ -1419,31 +1650,36 @@ void ArithmeticBEAVYTensorConstMul<T>::evaluate_setup() {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorGemm<T>::evaluate_setup start", gate_id_));
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstMul<T>::evaluate_setup start", gate_id_));
     }
   }
 
   const auto output_size = input_->get_dimensions().get_data_size();
 
-  input_->wait_setup();
+  if (fractional_bits_ > 0) {
+    output_->get_secret_share() = Helpers::RandomVector<T>(output_size);
+    output_->set_setup_ready();
+  } else {
+    input_->wait_setup();
 
-  const auto& delta_a_share_ = input_->get_secret_share();
+    const auto& delta_a_share_ = input_->get_secret_share();
 
-  std::vector<T> constant_vector(output_size,constant_);
-  auto& delta_y_share_ = constant_vector;
-  
-  // [Delta_y]_i += [[delta_a]_i * [delta_b]_(1-i)]_i
-  __gnu_parallel::transform(std::begin(constant_vector), std::end(constant_vector),
-                            std::begin(delta_a_share_), std::begin(delta_y_share_), std::multiplies{});
+    std::vector<T> constant_vector(output_size,constant_);
+    auto& delta_y_share_ = constant_vector;
 
-  output_->get_secret_share() = std::move(delta_y_share_);
-  output_->set_setup_ready();
+    // [delta_y]_i = k * [delta_a]_i
+    __gnu_parallel::transform(std::begin(constant_vector), std::end(constant_vector),
+                              std::begin(delta_a_share_), std::begin(delta_y_share_), std::multiplies{});
+
+    output_->get_secret_share() = std::move(delta_y_share_);
+    output_->set_setup_ready();
+  }
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorGemm<T>::evaluate_setup end", gate_id_));
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstMul<T>::evaluate_setup end", gate_id_));
     }
   }
 }
@@ -1454,18 +1690,47 @@ void ArithmeticBEAVYTensorConstMul<T>::evaluate_online() {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorGemm<T>::evaluate_online start", gate_id_));
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstMul<T>::evaluate_online start", gate_id_));
     }
   }
 
   const auto output_size = input_->get_dimensions().get_data_size();
   input_->wait_online();
   const auto& Delta_ = input_->get_public_share();
-  std::vector<T> constant_vector(output_size,constant_);
-  
-  // [Delta_y]_i += [[delta_a]_i * [delta_b]_(1-i)]_i
-  __gnu_parallel::transform(std::begin(constant_vector), std::end(constant_vector),
-                            std::begin(Delta_), std::begin(Delta_y_), std::multiplies{});
+
+  if (fractional_bits_ > 0) {
+    const auto& delta_a_share = input_->get_secret_share();
+    const auto constant = constant_;
+    const bool is_my_job = beavy_provider_.is_my_job(gate_id_);
+
+    // [k * x]_i = k * Delta_a - k * [delta_a]_i (Delta_a only counted once)
+    if (is_my_job) {
+      __gnu_parallel::transform(std::begin(Delta_), std::end(Delta_), std::begin(delta_a_share),
+                                std::begin(Delta_y_),
+                                [constant](auto Delta, auto delta) { return constant * (Delta - delta); });
+    } else {
+      __gnu_parallel::transform(std::begin(delta_a_share), std::end(delta_a_share),
+                                std::begin(Delta_y_),
+                                [constant](auto delta) { return -(constant * delta); });
+    }
+    fixed_point::truncate_shared<T>(Delta_y_.data(), fractional_bits_, output_size, is_my_job);
+    // [Delta_y]_i += [delta_y]_i
+    __gnu_parallel::transform(std::begin(Delta_y_), std::end(Delta_y_),
+                              std::begin(output_->get_secret_share()), std::begin(Delta_y_),
+                              std::plus{});
+
+    // broadcast [Delta_y]_i
+    beavy_provider_.broadcast_ints_message(gate_id_, Delta_y_);
+    // Delta_y = [Delta_y]_i + [Delta_y]_(1-i)
+    __gnu_parallel::transform(std::begin(Delta_y_), std::end(Delta_y_),
+                              std::begin(share_future_.get()), std::begin(Delta_y_), std::plus{});
+  } else {
+    std::vector<T> constant_vector(output_size,constant_);
+
+    // Delta_y = k * Delta_a
+    __gnu_parallel::transform(std::begin(constant_vector), std::end(constant_vector),
+                              std::begin(Delta_), std::begin(Delta_y_), std::multiplies{});
+  }
 
   output_->get_public_share() = std::move(Delta_y_);
   output_->set_online_ready();
@@ -1474,7 +1739,7 @@ void ArithmeticBEAVYTensorConstMul<T>::evaluate_online() {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorGemm<T>::evaluate_online end", gate_id_));
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstMul<T>::evaluate_online end", gate_id_));
     }
   }
 }
@@ -1482,6 +1747,79 @@ void ArithmeticBEAVYTensorConstMul<T>::evaluate_online() {
 template class ArithmeticBEAVYTensorConstMul<std::uint32_t>;
 template class ArithmeticBEAVYTensorConstMul<std::uint64_t>;
 
+template <typename T>
+ArithmeticBEAVYTensorConstAdd<T>::ArithmeticBEAVYTensorConstAdd(
+    std::size_t gate_id, BEAVYProvider& beavy_provider, const T k,
+    const ArithmeticBEAVYTensorCP<T> input)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      input_(input),
+      constant_(k),
+      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(input_->get_dimensions())) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorConstAdd<T> created", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorConstAdd<T>::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstAdd<T>::evaluate_setup start", gate_id_));
+    }
+  }
+
+  // delta_y = delta_a
+  input_->wait_setup();
+  output_->get_secret_share() = input_->get_secret_share();
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstAdd<T>::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorConstAdd<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstAdd<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  // Delta_y = Delta_a + k
+  input_->wait_online();
+  const auto& Delta_a = input_->get_public_share();
+  auto& Delta_y = output_->get_public_share();
+  Delta_y.resize(Delta_a.size());
+  const auto constant = constant_;
+  __gnu_parallel::transform(std::begin(Delta_a), std::end(Delta_a), std::begin(Delta_y),
+                            [constant](auto Delta) { return Delta + constant; });
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstAdd<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticBEAVYTensorConstAdd<std::uint32_t>;
+template class ArithmeticBEAVYTensorConstAdd<std::uint64_t>;
+
 //Implementation of Addition with Tensor (addnl)
 template <typename T>
 ArithmeticBEAVYTensorAdd<T>::ArithmeticBEAVYTensorAdd(std::size_t gate_id,
@@ -1580,6 +1918,113 @@ void ArithmeticBEAVYTensorAdd<T>::evaluate_online() {
 template class ArithmeticBEAVYTensorAdd<std::uint32_t>;
 template class ArithmeticBEAVYTensorAdd<std::uint64_t>;
 
+template <typename T>
+ArithmeticBEAVYTensorLinearCombination<T>::ArithmeticBEAVYTensorLinearCombination(
+    std::size_t gate_id, BEAVYProvider& beavy_provider,
+    const tensor::TensorDimensions& output_dims, std::vector<Term>&& terms, T constant)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      terms_(std::move(terms)),
+      constant_(constant),
+      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(output_dims)) {
+  const auto data_size = output_dims.get_data_size();
+  coefficients_.reserve(terms_.size());
+  for (const auto& [c, input] : terms_) {
+    if (input->get_dimensions().get_data_size() != data_size) {
+      throw std::invalid_argument(fmt::format(
+          "ArithmeticBEAVYTensorLinearCombination: input with {} elements, expected {}",
+          input->get_dimensions().get_data_size(), data_size));
+    }
+    coefficients_.push_back(c);
+  }
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorLinearCombination<T> created with {} terms", gate_id_,
+          terms_.size()));
+    }
+  }
+}
+
+template <typename T>
+bool ArithmeticBEAVYTensorLinearCombination<T>::is_output_used() const {
+  // the uses are known once the provider has been set up
+  beavy_provider_.wait_setup();
+  return beavy_provider_.is_fused_output_used(output_.get());
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorLinearCombination<T>::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorLinearCombination<T>::evaluate_setup start", gate_id_));
+    }
+  }
+
+  if (is_output_used()) {
+    // delta_y = sum_j c_j * delta_j
+    std::vector<const T*> deltas;
+    deltas.reserve(terms_.size());
+    for (const auto& [c, input] : terms_) {
+      input->wait_setup();
+      deltas.push_back(input->get_secret_share().data());
+    }
+    auto& delta_y = output_->get_secret_share();
+    delta_y.resize(output_->get_dimensions().get_data_size());
+    kernels::linear_combination(coefficients_.data(), deltas.data(), deltas.size(), T(0),
+                                delta_y.data(), delta_y.size());
+  }
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorLinearCombination<T>::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorLinearCombination<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorLinearCombination<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  if (is_output_used()) {
+    // Delta_y = sum_j c_j * Delta_j + k
+    std::vector<const T*> Deltas;
+    Deltas.reserve(terms_.size());
+    for (const auto& [c, input] : terms_) {
+      input->wait_online();
+      Deltas.push_back(input->get_public_share().data());
+    }
+    auto& Delta_y = output_->get_public_share();
+    Delta_y.resize(output_->get_dimensions().get_data_size());
+    kernels::linear_combination(coefficients_.data(), Deltas.data(), Deltas.size(), constant_,
+                                Delta_y.data(), Delta_y.size());
+  }
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorLinearCombination<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticBEAVYTensorLinearCombination<std::uint32_t>;
+template class ArithmeticBEAVYTensorLinearCombination<std::uint64_t>;
+
 //Implementation of Splitting a Tensor (addnl)
 template <typename T>
 ArithmeticBEAVYTensorSplit<T>::ArithmeticBEAVYTensorSplit(std::size_t gate_id,
@@ -1598,9 +2043,12 @@ ArithmeticBEAVYTensorSplit<T>::ArithmeticBEAVYTensorSplit(std::size_t gate_id,
       output_7_(std::make_shared<ArithmeticBEAVYTensor<T>>(dimensions_)),
       output_8_(std::make_shared<ArithmeticBEAVYTensor<T>>(dimensions_)),
       output_9_(std::make_shared<ArithmeticBEAVYTensor<T>>(dimensions_)){
-  const auto my_id = beavy_provider_.get_my_id();
-  const auto output_size = input_->get_dimensions().get_data_size();
-  Delta_y_.resize(output_size);
+  // the outputs are the first 10 elements, which are copied individually
+  if (input_->get_dimensions().get_data_size() < 10) {
+    throw std::invalid_argument(
+        fmt::format("ArithmeticBEAVYTensorSplit: input has only {} elements, need at least 10",
+                    input_->get_dimensions().get_data_size()));
+  }
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
@@ -1623,13 +2071,10 @@ void ArithmeticBEAVYTensorSplit<T>::evaluate_setup() {
     }
   }
 
-  const auto output_size = input_->get_dimensions().get_data_size();
-
   input_->wait_setup();
 
-  const auto& delta_share_ = input_->get_secret_share();
-
-  std::vector<T> delta_y_share_(delta_share_);
+  // only the selected elements are copied
+  const auto& delta_y_share_ = input_->get_secret_share();
 
   std::vector<T> temp = {delta_y_share_[0]};
   output_0_->get_secret_share() = temp;
@@ -1690,10 +2135,8 @@ void ArithmeticBEAVYTensorSplit<T>::evaluate_online() {
     }
   }
 
-  const auto output_size = input_->get_dimensions().get_data_size();
   input_->wait_online();
-  const auto& Delta_ = input_->get_public_share();
-  Delta_y_ = Delta_;
+  const auto& Delta_y_ = input_->get_public_share();
 
   std::vector<T> temp = {Delta_y_[0]};
   output_0_->get_public_share() = temp;
@@ -1752,9 +2195,11 @@ BooleanToArithmeticBEAVYTensorConversion<T>::BooleanToArithmeticBEAVYTensorConve
     std::size_t gate_id, BEAVYProvider& beavy_provider, const BooleanBEAVYTensorCP input)
     : NewGate(gate_id),
       beavy_provider_(beavy_provider),
+      bit_size_(input->get_bit_size()),
       data_size_(input->get_dimensions().get_data_size()),
       input_(std::move(input)),
       output_(std::make_shared<ArithmeticBEAVYTensor<T>>(input_->get_dimensions())) {
+  assert(bit_size_ <= ENCRYPTO::bit_size_v<T>);
   const auto my_id = beavy_provider_.get_my_id();
 
   auto& ot_provider = beavy_provider_.get_ot_manager().get_provider(1 - my_id);
@@ -1795,28 +2240,21 @@ void BooleanToArithmeticBEAVYTensorConversion<T>::evaluate_setup() {
   const auto& sshares = input_->get_secret_share();
   assert(sshares.size() == bit_size_);
 
+  std::vector<T> secret_bits(bit_size_ * data_size_);
+#pragma omp parallel for
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    kernels::unpack_bits(sshares[bit_j], secret_bits.data() + bit_j * data_size_);
+  }
+
   std::vector<T> ot_output;
   if (ot_sender_ != nullptr) {
-    std::vector<T> correlations(bit_size_ * data_size_);
-#pragma omp parallel for
-    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
-      for (std::size_t int_i = 0; int_i < data_size_; ++int_i) {
-        if (sshares[bit_j].Get(int_i)) {
-          correlations[bit_j * data_size_ + int_i] = 1;
-        }
-      }
-    }
-    ot_sender_->SetCorrelations(std::move(correlations));
+    ot_sender_->SetCorrelations(secret_bits);
     ot_sender_->SendMessages();
     ot_sender_->ComputeOutputs();
     ot_output = ot_sender_->GetOutputs();
-#pragma omp parallel for
-    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
-      for (std::size_t int_i = 0; int_i < data_size_; ++int_i) {
-        T bit = sshares[bit_j].Get(int_i);
-        ot_output[bit_j * data_size_ + int_i] = bit + 2 * ot_output[bit_j * data_size_ + int_i];
-      }
-    }
+    __gnu_parallel::transform(std::begin(secret_bits), std::end(secret_bits),
+                              std::begin(ot_output), std::begin(ot_output),
+                              [](auto bit, auto x) { return bit + 2 * x; });
   } else {
     assert(ot_receiver_ != nullptr);
     ENCRYPTO::BitVector<> choices;
@@ -1828,13 +2266,9 @@ void BooleanToArithmeticBEAVYTensorConversion<T>::evaluate_setup() {
     ot_receiver_->SendCorrections();
     ot_receiver_->ComputeOutputs();
     ot_output = ot_receiver_->GetOutputs();
-#pragma omp parallel for
-    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
-      for (std::size_t int_i = 0; int_i < data_size_; ++int_i) {
-        T bit = sshares[bit_j].Get(int_i);
-        ot_output[bit_j * data_size_ + int_i] = bit - 2 * ot_output[bit_j * data_size_ + int_i];
-      }
-    }
+    __gnu_parallel::transform(std::begin(secret_bits), std::end(secret_bits),
+                              std::begin(ot_output), std::begin(ot_output),
+                              [](auto bit, auto x) { return bit - 2 * x; });
   }
   arithmetized_secret_share_ = std::move(ot_output);
 
@@ -1865,32 +2299,18 @@ void BooleanToArithmeticBEAVYTensorConversion<T>::evaluate_online() {
 
 #pragma omp parallel for
   for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
-    for (std::size_t int_i = 0; int_i < data_size_; ++int_i) {
-      if (pshares[bit_j].Get(int_i)) {
-        arithmetized_public_share[bit_j * data_size_ + int_i] = 1;
-      }
-    }
+    kernels::unpack_bits(pshares[bit_j], arithmetized_public_share.data() + bit_j * data_size_);
   }
 
   auto tmp = output_->get_secret_share();
   if (beavy_provider_.is_my_job(gate_id_)) {
-#pragma omp parallel for
-    for (std::size_t int_i = 0; int_i < data_size_; ++int_i) {
-      for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
-        const auto p = arithmetized_public_share[bit_j * data_size_ + int_i];
-        const auto s = arithmetized_secret_share_[bit_j * data_size_ + int_i];
-        tmp[int_i] += (p + (1 - 2 * p) * s) << bit_j;
-      }
-    }
+    kernels::boolean_to_arithmetic<T, true>(arithmetized_public_share.data(),
+                                            arithmetized_secret_share_.data(), tmp.data(),
+                                            data_size_, bit_size_);
   } else {
-#pragma omp parallel for
-    for (std::size_t int_i = 0; int_i < data_size_; ++int_i) {
-      for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
-        const auto p = arithmetized_public_share[bit_j * data_size_ + int_i];
-        const auto s = arithmetized_secret_share_[bit_j * data_size_ + int_i];
-        tmp[int_i] += ((1 - 2 * p) * s) << bit_j;
-      }
-    }
+    kernels::boolean_to_arithmetic<T, false>(arithmetized_public_share.data(),
+                                             arithmetized_secret_share_.data(), tmp.data(),
+                                             data_size_, bit_size_);
   }
   beavy_provider_.send_ints_message(1 - my_id, gate_id_, tmp);
   const auto other_share = share_future_.get();
@@ -2190,16 +2610,18 @@ void BooleanXArithmeticBEAVYTensorRelu<T>::evaluate_online() {
   const auto& sshare = output_->get_secret_share();
   std::vector<T> pshare(data_size_);
 
-#pragma omp parallel for
-  for (std::size_t int_i = 0; int_i < data_size_; ++int_i) {
-    T Delta_b = !msb_pshare.Get(int_i);
-    auto Delta_n = int_pshare[int_i];
-    pshare[int_i] = delta_b_share_[int_i] * (Delta_n - 2 * Delta_b * Delta_n) -
-                    Delta_b * int_sshare[int_i] -
-                    delta_b_x_delta_n_share_[int_i] * (1 - 2 * Delta_b) + sshare[int_i];
-    if (beavy_provider_.is_my_job(gate_id_)) {
-      pshare[int_i] += Delta_b * Delta_n;
-    }
+  // Delta_b = NOT msb
+  std::vector<T> Delta_b(data_size_);
+  kernels::unpack_bits<T, true>(msb_pshare, Delta_b.data());
+  if (beavy_provider_.is_my_job(gate_id_)) {
+    kernels::relu_public_share<T, true>(Delta_b.data(), int_pshare.data(), delta_b_share_.data(),
+                                        int_sshare.data(), delta_b_x_delta_n_share_.data(),
+                                        sshare.data(), pshare.data(), data_size_);
+  } else {
+    kernels::relu_public_share<T, false>(Delta_b.data(), int_pshare.data(),
+                                         delta_b_share_.data(), int_sshare.data(),
+                                         delta_b_x_delta_n_share_.data(), sshare.data(),
+                                         pshare.data(), data_size_);
   }
 
   beavy_provider_.broadcast_ints_message(gate_id_, pshare);
@@ -2476,4 +2898,315 @@ void BooleanBEAVYTensorMaxPool::evaluate_online_with_context(ExecutionContext& e
   }
 }
 
+// bits of NOT c for each public constant c, where the MSB is flipped such that
+// signed values compare like unsigned ones
+static std::vector<ENCRYPTO::BitVector<>> decompose_gt_public_constants(
+    const std::vector<std::uint64_t>& constants, std::size_t bit_size) {
+  std::vector<ENCRYPTO::BitVector<>> bits(bit_size, ENCRYPTO::BitVector<>(constants.size()));
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    const bool msb = bit_j == bit_size - 1;
+    for (std::size_t int_i = 0; int_i < constants.size(); ++int_i) {
+      bits[bit_j].Set(((constants[int_i] >> bit_j) & 1) == msb, int_i);
+    }
+  }
+  return bits;
+}
+
+BooleanBEAVYTensorGTPublic::BooleanBEAVYTensorGTPublic(std::size_t gate_id,
+                                                       BEAVYProvider& beavy_provider,
+                                                       const BooleanBEAVYTensorCP input,
+                                                       const std::vector<std::uint64_t>& constants)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      input_(input),
+      output_(std::make_shared<BooleanBEAVYTensor>(input_->get_dimensions(), 1)),
+      constant_bits_(decompose_gt_public_constants(constants, bit_size_)) {
+  if (constants.size() != data_size_) {
+    throw std::invalid_argument(fmt::format("expected {} constants, but {} are provided",
+                                            data_size_, constants.size()));
+  }
+  const auto make_wire = [this] {
+    auto w = std::make_shared<BooleanBEAVYWire>(data_size_);
+    w->get_secret_share().Resize(data_size_);
+    w->get_public_share().Resize(data_size_);
+    return w;
+  };
+  t_wires_.resize(bit_size_);
+  e_wires_.resize(bit_size_);
+  std::generate(std::begin(t_wires_), std::end(t_wires_), make_wire);
+  std::generate(std::begin(e_wires_), std::end(e_wires_), make_wire);
+  {
+    WireVector t_in(std::begin(t_wires_), std::end(t_wires_));
+    WireVector e_in(std::begin(e_wires_), std::end(e_wires_));
+    auto [gates, out] = construct_public_gt_circuit(beavy_provider_, t_in, e_in);
+    gates_ = std::move(gates);
+    output_wire_ = std::dynamic_pointer_cast<BooleanBEAVYWire>(out);
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: BooleanBEAVYTensorGTPublic created", gate_id_));
+    }
+  }
+}
+
+void BooleanBEAVYTensorGTPublic::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorGTPublic::evaluate_setup start", gate_id_));
+    }
+  }
+
+  input_->wait_setup();
+
+  // XOR with a public value does not change the secret shares, AND with a
+  // public value is applied to all of them
+  const auto& input_shares = input_->get_secret_share();
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    t_wires_[bit_j]->get_secret_share() = input_shares[bit_j] & constant_bits_[bit_j];
+    e_wires_[bit_j]->get_secret_share() = input_shares[bit_j];
+    t_wires_[bit_j]->set_setup_ready();
+    e_wires_[bit_j]->set_setup_ready();
+  }
+
+  for (auto& gate : gates_) {
+    gate->evaluate_setup();
+  }
+
+  output_wire_->wait_setup();
+  output_->get_secret_share()[0] = std::move(output_wire_->get_secret_share());
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorGTPublic::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+void BooleanBEAVYTensorGTPublic::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorGTPublic::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  const auto& input_shares = input_->get_public_share();
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    auto share = bit_j == bit_size_ - 1 ? ~input_shares[bit_j] : input_shares[bit_j];
+    t_wires_[bit_j]->get_public_share() = share & constant_bits_[bit_j];
+    e_wires_[bit_j]->get_public_share() = share ^ constant_bits_[bit_j];
+    t_wires_[bit_j]->set_online_ready();
+    e_wires_[bit_j]->set_online_ready();
+  }
+
+  for (auto& gate : gates_) {
+    gate->evaluate_online();
+  }
+
+  output_wire_->wait_online();
+  output_->get_public_share()[0] = std::move(output_wire_->get_public_share());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorGTPublic::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+BooleanBEAVYTensorClip::BooleanBEAVYTensorClip(std::size_t gate_id, BEAVYProvider& beavy_provider,
+                                               const BooleanBEAVYTensorCP input,
+                                               std::uint64_t min, std::uint64_t max)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      input_(input),
+      output_(std::make_shared<BooleanBEAVYTensor>(input_->get_dimensions(), bit_size_)),
+      min_(min),
+      max_(max) {
+  tensor::check_clip_range(min_, max_, bit_size_);
+  {
+    std::vector<std::uint64_t> constants(2 * data_size_, min_);
+    std::fill_n(std::begin(constants) + data_size_, data_size_, max_);
+    constant_bits_ = decompose_gt_public_constants(constants, bit_size_);
+  }
+  const auto make_wire = [](std::size_t num_simd) {
+    auto w = std::make_shared<BooleanBEAVYWire>(num_simd);
+    w->get_secret_share().Resize(num_simd);
+    w->get_public_share().Resize(num_simd);
+    return w;
+  };
+  t_wires_.resize(bit_size_);
+  e_wires_.resize(bit_size_);
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    t_wires_[bit_j] = make_wire(2 * data_size_);
+    e_wires_[bit_j] = make_wire(2 * data_size_);
+  }
+  {
+    WireVector t_in(std::begin(t_wires_), std::end(t_wires_));
+    WireVector e_in(std::begin(e_wires_), std::end(e_wires_));
+    auto [gates, out] = construct_public_gt_circuit(beavy_provider_, t_in, e_in);
+    cmp_gates_ = std::move(gates);
+    cmp_wire_ = std::dynamic_pointer_cast<BooleanBEAVYWire>(out);
+  }
+  select_wire_ = make_wire(bit_size_ * data_size_);
+  value_wire_ = make_wire(bit_size_ * data_size_);
+  {
+    auto [gate, out] = beavy_provider_.construct_binary_gate(
+        ENCRYPTO::PrimitiveOperationType::AND, {select_wire_}, {value_wire_});
+    and_gate_ = std::move(gate);
+    and_wire_ = std::dynamic_pointer_cast<BooleanBEAVYWire>(out.at(0));
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: BooleanBEAVYTensorClip created", gate_id_));
+    }
+  }
+}
+
+// y = (s AND x) XOR (NOT (x > min) AND min) XOR ((x > max) AND max) with
+// s = (x > min) XOR (x > max), where the operations with public values are
+// local: XOR and NOT only change the public shares, AND with a public value is
+// applied to all shares
+template <bool setup>
+void BooleanBEAVYTensorClip::evaluate() {
+  const auto share = [](BooleanBEAVYWire& wire) -> ENCRYPTO::BitVector<>& {
+    return setup ? wire.get_secret_share() : wire.get_public_share();
+  };
+  const auto set_ready = [](BooleanBEAVYWire& wire) {
+    if constexpr (setup) {
+      wire.set_setup_ready();
+    } else {
+      wire.set_online_ready();
+    }
+  };
+  const auto& input_shares = setup ? input_->get_secret_share() : input_->get_public_share();
+
+  // compare with min and max in one batch
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    auto x = input_shares[bit_j];
+    x.Append(input_shares[bit_j]);
+    if (!setup && bit_j == bit_size_ - 1) {
+      x = ~x;
+    }
+    share(*t_wires_[bit_j]) = x & constant_bits_[bit_j];
+    share(*e_wires_[bit_j]) = setup ? std::move(x) : x ^ constant_bits_[bit_j];
+    set_ready(*t_wires_[bit_j]);
+    set_ready(*e_wires_[bit_j]);
+  }
+  for (auto& gate : cmp_gates_) {
+    if constexpr (setup) {
+      gate->evaluate_setup();
+    } else {
+      gate->evaluate_online();
+    }
+  }
+  if constexpr (setup) {
+    cmp_wire_->wait_setup();
+  } else {
+    cmp_wire_->wait_online();
+  }
+  auto gt_min = share(*cmp_wire_).Subset(0, data_size_);
+  auto gt_max = share(*cmp_wire_).Subset(data_size_, 2 * data_size_);
+
+  // select x iff min < x <= max with a single layer of AND gates
+  {
+    const auto select = gt_min ^ gt_max;
+    auto& select_share = share(*select_wire_);
+    auto& value_share = share(*value_wire_);
+    select_share = ENCRYPTO::BitVector<>();
+    value_share = ENCRYPTO::BitVector<>();
+    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+      select_share.Append(select);
+      value_share.Append(input_shares[bit_j]);
+    }
+    set_ready(*select_wire_);
+    set_ready(*value_wire_);
+  }
+  if constexpr (setup) {
+    and_gate_->evaluate_setup();
+    and_wire_->wait_setup();
+  } else {
+    and_gate_->evaluate_online();
+    and_wire_->wait_online();
+  }
+
+  if constexpr (!setup) {
+    gt_min = ~gt_min;
+  }
+  auto& output_shares = setup ? output_->get_secret_share() : output_->get_public_share();
+  const auto& and_share = share(*and_wire_);
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    auto y = and_share.Subset(bit_j * data_size_, (bit_j + 1) * data_size_);
+    if ((min_ >> bit_j) & 1) {
+      y ^= gt_min;
+    }
+    if ((max_ >> bit_j) & 1) {
+      y ^= gt_max;
+    }
+    output_shares[bit_j] = std::move(y);
+  }
+}
+
+void BooleanBEAVYTensorClip::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorClip::evaluate_setup start", gate_id_));
+    }
+  }
+
+  input_->wait_setup();
+  evaluate<true>();
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorClip::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+void BooleanBEAVYTensorClip::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorClip::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+  evaluate<false>();
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorClip::evaluate_online end", gate_id_));
+    }
+  }
+}
+
 }  // namespace MOTION::proto::beavy
@@ -143,8 +143,10 @@ class ArithmeticBEAVYTensorInputShares : public NewGate {
 template <typename T>
 class ArithmeticBEAVYTensorOutput : public NewGate {
  public:
+  // output_bit_size == 0 reconstructs the full width of T, otherwise only
+  // the lowest output_bit_size bits are sent and the output is sign-extended
   ArithmeticBEAVYTensorOutput(std::size_t gate_id, BEAVYProvider&, ArithmeticBEAVYTensorCP<T>,
-                            std::size_t output_owner);
+                              std::size_t output_owner, std::size_t output_bit_size = 0);
   bool need_setup() const noexcept override { return true; }
   bool need_online() const noexcept override { return true; }
   void evaluate_setup() override;
@@ -157,16 +159,21 @@ class ArithmeticBEAVYTensorOutput : public NewGate {
   ENCRYPTO::ReusableFiberFuture<std::vector<T>> secret_share_future_;
   std::vector<T> secret_shares_;
   std::size_t output_owner_;
+  std::size_t output_bit_size_;
   const ArithmeticBEAVYTensorCP<T> input_;
 };
 
+// The output is a view on the shares of the input, so only the ready flags
+// are forwarded.
 template <typename T>
-class ArithmeticBEAVYTensorFlatten : public NewGate {
+class ArithmeticBEAVYTensorReshape : public NewGate {
  public:
-  ArithmeticBEAVYTensorFlatten(std::size_t gate_id, BEAVYProvider&, std::size_t axis,
+  ArithmeticBEAVYTensorReshape(std::size_t gate_id, BEAVYProvider&,
+                               const tensor::TensorDimensions& output_dims,
                                const ArithmeticBEAVYTensorCP<T> input);
   bool need_setup() const noexcept override { return true; }
   bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
   void evaluate_setup() override;
   void evaluate_online() override;
   const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
@@ -177,6 +184,13 @@ class ArithmeticBEAVYTensorFlatten : public NewGate {
   std::shared_ptr<ArithmeticBEAVYTensor<T>> output_;
 };
 
+template <typename T>
+class ArithmeticBEAVYTensorFlatten : public ArithmeticBEAVYTensorReshape<T> {
+ public:
+  ArithmeticBEAVYTensorFlatten(std::size_t gate_id, BEAVYProvider&, std::size_t axis,
+                               const ArithmeticBEAVYTensorCP<T> input);
+};
+
 template <typename T>
 class ArithmeticBEAVYTensorConv2D : public NewGate {
  public:
@@ -308,6 +322,55 @@ class ArithmeticBEAVYTensorAveragePool : public NewGate {
   std::vector<T> tmp_out_;
 };
 
+// Sum over one axis, computed locally on both shares.
+template <typename T>
+class ArithmeticBEAVYTensorSum : public NewGate {
+ public:
+  ArithmeticBEAVYTensorSum(std::size_t gate_id, BEAVYProvider&, std::size_t axis,
+                           const ArithmeticBEAVYTensorCP<T> input);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  BEAVYProvider& beavy_provider_;
+  std::size_t axis_;
+  const ArithmeticBEAVYTensorCP<T> input_;
+  std::shared_ptr<ArithmeticBEAVYTensor<T>> output_;
+};
+
+// Mean over one axis: the scaled sum is truncated on additive shares and
+// reshared with a single message per output element, like AveragePool.
+template <typename T>
+class ArithmeticBEAVYTensorMean : public NewGate {
+ public:
+  ArithmeticBEAVYTensorMean(std::size_t gate_id, BEAVYProvider&, std::size_t axis,
+                            const ArithmeticBEAVYTensorCP<T> input, std::size_t fractional_bits);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  void compute_and_broadcast_share(std::vector<T>& A_share);
+
+  BEAVYProvider& beavy_provider_;
+  std::size_t axis_;
+  std::size_t data_size_;
+  std::size_t output_size_;
+  std::size_t fractional_bits_;
+  const ArithmeticBEAVYTensorCP<T> input_;
+  std::shared_ptr<ArithmeticBEAVYTensor<T>> output_;
+  ENCRYPTO::ReusableFiberFuture<std::vector<T>> share_future_;
+  T factor_;
+  std::vector<T> tmp_in_;
+  std::vector<T> tmp_out_;
+};
+
 //Implementation of Tensor Negation (addnl)
 template <typename T>
 class ArithmeticBEAVYTensorNegate : public NewGate {
@@ -317,6 +380,7 @@ class ArithmeticBEAVYTensorNegate : public NewGate {
   ~ArithmeticBEAVYTensorNegate();
   bool need_setup() const noexcept override { return true; }
   bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
   void evaluate_setup() override;
   void evaluate_online() override;
   const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
@@ -337,10 +401,12 @@ class ArithmeticBEAVYTensorConstMul : public NewGate {
  public:
   ArithmeticBEAVYTensorConstMul(std::size_t gate_id, BEAVYProvider&,
                             const T k,
-                            const ArithmeticBEAVYTensorCP<T> input);
+                            const ArithmeticBEAVYTensorCP<T> input,
+                            std::size_t fractional_bits = 0);
   ~ArithmeticBEAVYTensorConstMul();
   bool need_setup() const noexcept override { return true; }
   bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return fractional_bits_ > 0; }
   void evaluate_setup() override;
   void evaluate_online() override;
   const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
@@ -349,6 +415,7 @@ class ArithmeticBEAVYTensorConstMul : public NewGate {
   BEAVYProvider& beavy_provider_;
   const ArithmeticBEAVYTensorCP<T> input_;
   const T constant_;
+  std::size_t fractional_bits_;
   std::shared_ptr<ArithmeticBEAVYTensor<T>> output_;
   ENCRYPTO::ReusableFiberFuture<std::vector<T>> share_future_;
   std::vector<T> Delta_y_;
@@ -356,6 +423,26 @@ class ArithmeticBEAVYTensorConstMul : public NewGate {
   std::unique_ptr<MOTION::MatrixMultiplicationLHS<T>> mm_lhs_side_;
 };
 
+// Addition of a public constant, purely local
+template <typename T>
+class ArithmeticBEAVYTensorConstAdd : public NewGate {
+ public:
+  ArithmeticBEAVYTensorConstAdd(std::size_t gate_id, BEAVYProvider&, const T k,
+                                const ArithmeticBEAVYTensorCP<T> input);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  BEAVYProvider& beavy_provider_;
+  const ArithmeticBEAVYTensorCP<T> input_;
+  const T constant_;
+  std::shared_ptr<ArithmeticBEAVYTensor<T>> output_;
+};
+
 //Implementation of Tensor Addition (addnl)
 template <typename T>
 class ArithmeticBEAVYTensorAdd : public NewGate {
@@ -366,6 +453,7 @@ class ArithmeticBEAVYTensorAdd : public NewGate {
   ~ArithmeticBEAVYTensorAdd();
   bool need_setup() const noexcept override { return true; }
   bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
   void evaluate_setup() override;
   void evaluate_online() override;
   const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
@@ -381,7 +469,43 @@ class ArithmeticBEAVYTensorAdd : public NewGate {
   std::unique_ptr<MOTION::MatrixMultiplicationLHS<T>> mm_lhs_side_;
 };
 
+// Fused chain of local linear operations: y = sum_j c_j * x_j + k
+//
+// Created by the BEAVYProvider for Add, Negate, ConstAdd, and ConstMul
+// (without truncation), and extended whenever such an operation is
+// applied to the output of another fused gate.  Since BEAVY shares are
+// linear, Delta_y = sum_j c_j * Delta_j + k and delta_y = sum_j c_j * delta_j.
+// Intermediate gates of a chain whose outputs are only read by longer chains
+// skip the computation.
+template <typename T>
+class ArithmeticBEAVYTensorLinearCombination : public NewGate {
+ public:
+  using Term = std::pair<T, ArithmeticBEAVYTensorCP<T>>;
+  ArithmeticBEAVYTensorLinearCombination(std::size_t gate_id, BEAVYProvider&,
+                                         const tensor::TensorDimensions& output_dims,
+                                         std::vector<Term>&& terms, T constant);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  // the output is only computed if another gate reads it
+  bool is_output_used() const;
+
+  BEAVYProvider& beavy_provider_;
+  const std::vector<Term> terms_;
+  const T constant_;
+  std::vector<T> coefficients_;
+  std::shared_ptr<ArithmeticBEAVYTensor<T>> output_;
+};
+
 //Implementation of Splitting a Tensor (addnl)
+// The outputs are the first 10 elements of the input as separate tensors.
+// They are copies, not views: each output copies a single element, so the
+// cost does not depend on the input size.
 template <typename T>
 class ArithmeticBEAVYTensorSplit : public NewGate {
  public:
@@ -390,6 +514,7 @@ class ArithmeticBEAVYTensorSplit : public NewGate {
   ~ArithmeticBEAVYTensorSplit();
   bool need_setup() const noexcept override { return true; }
   bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
   void evaluate_setup() override;
   void evaluate_online() override;
   const ArithmeticBEAVYTensorP<T>& get_output_tensor_0() const { return output_0_; }
@@ -423,11 +548,13 @@ class ArithmeticBEAVYTensorSplit : public NewGate {
   std::shared_ptr<ArithmeticBEAVYTensor<T>> output_8_;
   std::shared_ptr<ArithmeticBEAVYTensor<T>> output_9_;
   ENCRYPTO::ReusableFiberFuture<std::vector<T>> share_future_;
-  std::vector<T> Delta_y_;
   std::unique_ptr<MOTION::MatrixMultiplicationRHS<T>> mm_rhs_side_;
   std::unique_ptr<MOTION::MatrixMultiplicationLHS<T>> mm_lhs_side_;
 };
 
+// Converts a Boolean sharing of at most ENCRYPTO::bit_size_v<T> bits into an
+// arithmetic one with one ACOT per bit, e.g., a tensor of single bits into
+// 0/1 integers with one ACOT per element.
 template <typename T>
 class BooleanToArithmeticBEAVYTensorConversion : public NewGate {
  public:
@@ -442,7 +569,7 @@ class BooleanToArithmeticBEAVYTensorConversion : public NewGate {
 
  private:
   BEAVYProvider& beavy_provider_;
-  static constexpr auto bit_size_ = ENCRYPTO::bit_size_v<T>;
+  const std::size_t bit_size_;
   const std::size_t data_size_;
   const BooleanBEAVYTensorCP input_;
   ArithmeticBEAVYTensorP<T> output_;
@@ -526,4 +653,67 @@ class BooleanBEAVYTensorMaxPool : public NewGate {
   std::vector<std::unique_ptr<NewGate>> gates_;
 };
 
+// elementwise signed comparison input > c with one public constant per
+// element, the output tensor has bit size 1
+class BooleanBEAVYTensorGTPublic : public NewGate {
+ public:
+  BooleanBEAVYTensorGTPublic(std::size_t gate_id, BEAVYProvider&, const BooleanBEAVYTensorCP input,
+                             const std::vector<std::uint64_t>& constants);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  const BooleanBEAVYTensorP& get_output_tensor() const { return output_; }
+
+ private:
+  BEAVYProvider& beavy_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const BooleanBEAVYTensorCP input_;
+  const BooleanBEAVYTensorP output_;
+  // bits of NOT c, with the MSB flipped to compare as unsigned values
+  std::vector<ENCRYPTO::BitVector<>> constant_bits_;
+  BooleanBEAVYWireVector t_wires_;
+  BooleanBEAVYWireVector e_wires_;
+  std::shared_ptr<BooleanBEAVYWire> output_wire_;
+  std::vector<std::unique_ptr<NewGate>> gates_;
+};
+
+// elementwise clipping of signed values to the public range [min, max]: both
+// comparisons x > min and x > max are evaluated in one batch, the selection
+// then needs a single layer of AND gates
+class BooleanBEAVYTensorClip : public NewGate {
+ public:
+  BooleanBEAVYTensorClip(std::size_t gate_id, BEAVYProvider&, const BooleanBEAVYTensorCP input,
+                         std::uint64_t min, std::uint64_t max);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  const BooleanBEAVYTensorP& get_output_tensor() const { return output_; }
+
+ private:
+  template <bool setup>
+  void evaluate();
+
+  BEAVYProvider& beavy_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const BooleanBEAVYTensorCP input_;
+  const BooleanBEAVYTensorP output_;
+  const std::uint64_t min_;
+  const std::uint64_t max_;
+  // comparison with min for the first, with max for the second half
+  std::vector<ENCRYPTO::BitVector<>> constant_bits_;
+  BooleanBEAVYWireVector t_wires_;
+  BooleanBEAVYWireVector e_wires_;
+  std::shared_ptr<BooleanBEAVYWire> cmp_wire_;
+  // (x > min) XOR (x > max) repeated for each bit, and the concatenated input bits
+  std::shared_ptr<BooleanBEAVYWire> select_wire_;
+  std::shared_ptr<BooleanBEAVYWire> value_wire_;
+  std::shared_ptr<BooleanBEAVYWire> and_wire_;
+  std::vector<std::unique_ptr<NewGate>> cmp_gates_;
+  std::unique_ptr<NewGate> and_gate_;
+};
+
 }  // namespace MOTION::proto::beavy
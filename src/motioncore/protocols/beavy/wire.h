@@ -66,24 +66,32 @@ inline std::ostream& operator<<(std::ostream& os, const BooleanBEAVYWire& w) {
 template <typename T>
 class ArithmeticBEAVYWire : public NewWire, public ENCRYPTO::enable_wait_setup {
  public:
-  ArithmeticBEAVYWire(std::size_t num_simd)
-      : NewWire(num_simd), public_share_(num_simd), secret_share_(num_simd) {}
+  // the shares are allocated on first (mutable) access, so that wires of gates which have not
+  // been evaluated yet do not occupy memory
+  ArithmeticBEAVYWire(std::size_t num_simd) : NewWire(num_simd) {}
   MPCProtocol get_protocol() const noexcept override { return MPCProtocol::ArithmeticBEAVY; }
   std::size_t get_bit_size() const noexcept override { return ENCRYPTO::bit_size_v<T>; }
   std::pair<std::vector<T>&, std::vector<T>&> get_share() {
-    return {public_share_, secret_share_};
+    return {get_public_share(), get_secret_share()};
   };
   std::pair<const std::vector<T>&, const std::vector<T>&> get_share() const {
     return {public_share_, secret_share_};
   };
-  std::vector<T>& get_public_share() { return public_share_; };
+  std::vector<T>& get_public_share() { return allocate(public_share_); };
   const std::vector<T>& get_public_share() const { return public_share_; };
-  std::vector<T>& get_secret_share() { return secret_share_; };
+  std::vector<T>& get_secret_share() { return allocate(secret_share_); };
   const std::vector<T>& get_secret_share() const { return secret_share_; };
 
  private:
   using is_enabled_ = ENCRYPTO::is_unsigned_int_t<T>;
 
+  std::vector<T>& allocate(std::vector<T>& share) {
+    if (share.size() != get_num_simd()) {
+      share.resize(get_num_simd());
+    }
+    return share;
+  }
+
   // holds this party shares
   std::vector<T> public_share_;
   std::vector<T> secret_share_;
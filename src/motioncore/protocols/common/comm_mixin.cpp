@@ -23,14 +23,16 @@
 #include "comm_mixin.h"
 
 #include <cstdint>
+#include <mutex>
 #include <unordered_map>
 
 #include <boost/functional/hash.hpp>
 
 #include "communication/communication_layer.h"
-#include "communication/fbs_headers/comm_mixin_gate_message_generated.h"
+#include "communication/compact_message.h"
 #include "communication/message.h"
 #include "communication/message_handler.h"
+#include "utility/bit_packing.h"
 #include "utility/constants.h"
 #include "utility/logger.h"
 
@@ -53,6 +55,8 @@ struct CommMixin::GateMessageHandler : public Communication::MessageHandler {
   GateMessageHandler(std::size_t num_parties, Communication::MessageType gate_message_type,
                      std::shared_ptr<Logger> logger);
   void received_message(std::size_t, std::vector<std::uint8_t>&& raw_message) override;
+  // passes messages which arrived before the registration to received_message
+  void deliver_early_messages(std::size_t gate_id, std::size_t msg_num);
 
   enum class MsgValueType { bit, block, uint8, uint16, uint32, uint64 };
 
@@ -62,9 +66,15 @@ struct CommMixin::GateMessageHandler : public Communication::MessageHandler {
   // KeyType = (gate_id, msg_num)
   using KeyType = std::pair<std::size_t, std::size_t>;
 
-  // KeyType -> (size, type)
-  std::unordered_map<KeyType, std::pair<std::size_t, MsgValueType>, SizeTPairHash>
-      expected_messages_;
+  struct ExpectedMessage {
+    std::size_t size;
+    MsgValueType type;
+    // number of bits per element for bit-packed ints messages
+    std::size_t bit_width;
+  };
+
+  // KeyType -> (size, type, bit_width)
+  std::unordered_map<KeyType, ExpectedMessage, SizeTPairHash> expected_messages_;
 
   // [KeyType -> promise]
   std::vector<std::unordered_map<KeyType, ENCRYPTO::ReusableFiberPromise<ENCRYPTO::BitVector<>>,
@@ -91,6 +101,18 @@ struct CommMixin::GateMessageHandler : public Communication::MessageHandler {
       std::unordered_map<KeyType, ENCRYPTO::ReusableFiberPromise<std::vector<T>>, SizeTPairHash>>&
   get_promise_map();
 
+  // Gates may be created while the circuit is evaluated (cf.
+  // NewGateExecutor::set_gate_generator), so messages can arrive before the
+  // corresponding gate has registered for them.  These are kept until then.
+  // KeyType -> [(party_id, raw_message)]
+  std::unordered_map<KeyType, std::vector<std::pair<std::size_t, std::vector<std::uint8_t>>>,
+                     SizeTPairHash>
+      early_messages_;
+
+  // protects the maps above, since the gates register from other threads than
+  // the one receiving the messages
+  std::mutex mutex_;
+
   Communication::MessageType gate_message_type_;
   std::shared_ptr<Logger> logger_;
 };
@@ -153,58 +175,57 @@ CommMixin::GateMessageHandler::GateMessageHandler(std::size_t num_parties,
 void CommMixin::GateMessageHandler::received_message(std::size_t party_id,
                                                      std::vector<std::uint8_t>&& raw_message) {
   assert(!raw_message.empty());
-  auto message = Communication::GetMessage(raw_message.data());
-  {
-    flatbuffers::Verifier verifier(raw_message.data(), raw_message.size());
-    if (!message->Verify(verifier)) {
-      throw std::runtime_error("received malformed Message");
-      // TODO: log and drop instead
-    }
+  const auto message = Communication::ParseCompactMessage(raw_message.data(), raw_message.size());
+  if (!message.has_value()) {
+    throw std::runtime_error(
+        fmt::format("received malformed {}", EnumNameMessageType(gate_message_type_)));
+    // TODO: log and drop instead
   }
-
-  auto message_type = message->message_type();
-  if (message_type != gate_message_type_) {
+  if (message->message_type != gate_message_type_) {
     throw std::logic_error(
         fmt::format("CommMixin::GateMessageHandler: received unexpected message of type {}",
-                    EnumNameMessageType(message_type)));
+                    EnumNameMessageType(message->message_type)));
   }
 
-  auto gate_message =
-      flatbuffers::GetRoot<MOTION::Communication::CommMixinGateMessage>(message->payload()->data());
-  {
-    flatbuffers::Verifier verifier(message->payload()->data(), message->payload()->size());
-    if (!gate_message->Verify(verifier)) {
-      throw std::runtime_error(
-          fmt::format("received malformed {}", EnumNameMessageType(gate_message_type_)));
-      // TODO: log and drop instead
-    }
-  }
-  auto gate_id = gate_message->gate_id();
-  auto msg_num = gate_message->msg_num();
-  auto payload = gate_message->payload();
+  const auto gate_id = message->id;
+  const auto msg_num = message->msg_num;
+  const auto payload = message->payload;
+  const auto payload_size = message->payload_size;
+  std::scoped_lock lock(mutex_);
   auto it = expected_messages_.find({gate_id, msg_num});
   if (it == expected_messages_.end()) {
-    logger_->LogError(fmt::format("received unexpected {} for gate {}, dropping",
-                                  EnumNameMessageType(gate_message_type_), gate_id));
+    if constexpr (MOTION_VERBOSE_DEBUG) {
+      logger_->LogDebug(fmt::format("received {} for gate {} (msg_num {}) before registration",
+                                    EnumNameMessageType(gate_message_type_), gate_id, msg_num));
+    }
+    early_messages_[{gate_id, msg_num}].emplace_back(party_id, std::move(raw_message));
     return;
   }
-  auto expected_size = it->second.first;
-  auto type = it->second.second;
-
-  auto set_value_helper = [this, party_id, gate_id, msg_num, expected_size, payload](
-                              auto& map_vec, auto type_tag) {
-    auto byte_size = expected_size * sizeof(type_tag);
-    if (byte_size != payload->size()) {
+  auto expected_size = it->second.size;
+  auto type = it->second.type;
+  auto bit_width = it->second.bit_width;
+
+  auto set_value_helper = [this, party_id, gate_id, msg_num, expected_size, bit_width, payload,
+                           payload_size](auto& map_vec, auto type_tag) {
+    using T = decltype(type_tag);
+    const bool packed = bit_width != 8 * sizeof(T);
+    auto byte_size =
+        packed ? packed_ints_size(expected_size, bit_width) : expected_size * sizeof(T);
+    if (byte_size != payload_size) {
       logger_->LogError(fmt::format(
           "received {} for gate {} (msg_num {}) of size {} while expecting size {}, dropping",
-          EnumNameMessageType(gate_message_type_), gate_id, msg_num, payload->size(), byte_size));
+          EnumNameMessageType(gate_message_type_), gate_id, msg_num, payload_size, byte_size));
       return;
     }
     auto& promise_map = map_vec[party_id];
     auto& promise = promise_map.at({gate_id, msg_num});
-    auto ptr = reinterpret_cast<const decltype(type_tag)*>(payload->data());
+    auto ptr = reinterpret_cast<const T*>(payload);
     try {
-      promise.set_value(std::vector(ptr, ptr + expected_size));
+      if (packed) {
+        promise.set_value(unpack_ints<T>(payload, expected_size, bit_width));
+      } else {
+        promise.set_value(std::vector(ptr, ptr + expected_size));
+      }
     } catch (std::future_error& e) {
       logger_->LogError(fmt::format(
           "unable to fulfill promise ({}) for {} (ints) for gate {} (msg_num {}), dropping",
@@ -215,15 +236,15 @@ void CommMixin::GateMessageHandler::received_message(std::size_t party_id,
   switch (type) {
     case MsgValueType::bit: {
       auto byte_size = Helpers::Convert::BitsToBytes(expected_size);
-      if (byte_size != payload->size()) {
+      if (byte_size != payload_size) {
         logger_->LogError(fmt::format(
             "received {} for gate {} (msg_num {}) of size {} while expecting size {}, dropping",
-            EnumNameMessageType(gate_message_type_), gate_id, msg_num, payload->size(), byte_size));
+            EnumNameMessageType(gate_message_type_), gate_id, msg_num, payload_size, byte_size));
         return;
       }
       auto& promise = bits_promises_[party_id].at({gate_id, msg_num});
       try {
-        promise.set_value(ENCRYPTO::BitVector(payload->data(), expected_size));
+        promise.set_value(ENCRYPTO::BitVector(payload, expected_size));
       } catch (std::future_error& e) {
         logger_->LogError(fmt::format(
             "unable to fulfill promise ({}) for {} (bits) for gate {} (msg_num {}), dropping",
@@ -233,15 +254,15 @@ void CommMixin::GateMessageHandler::received_message(std::size_t party_id,
     }
     case MsgValueType::block: {
       auto byte_size = 16 * expected_size;
-      if (byte_size != payload->size()) {
+      if (byte_size != payload_size) {
         logger_->LogError(fmt::format(
             "received {} for gate {} (msg_num {}) of size {} while expecting size {}, dropping",
-            EnumNameMessageType(gate_message_type_), gate_id, msg_num, payload->size(), byte_size));
+            EnumNameMessageType(gate_message_type_), gate_id, msg_num, payload_size, byte_size));
         return;
       }
       auto& promise = blocks_promises_[party_id].at({gate_id, msg_num});
       try {
-        promise.set_value(ENCRYPTO::block128_vector(expected_size, payload->data()));
+        promise.set_value(ENCRYPTO::block128_vector(expected_size, payload));
       } catch (std::future_error& e) {
         logger_->LogError(fmt::format(
             "unable to fulfill promise ({}) for {} (blocks) for gate {} (msg_num {}), dropping",
@@ -268,6 +289,23 @@ void CommMixin::GateMessageHandler::received_message(std::size_t party_id,
   }
 }
 
+void CommMixin::GateMessageHandler::deliver_early_messages(std::size_t gate_id,
+                                                           std::size_t msg_num) {
+  std::vector<std::pair<std::size_t, std::vector<std::uint8_t>>> messages;
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = early_messages_.find({gate_id, msg_num});
+    if (it == early_messages_.end()) {
+      return;
+    }
+    messages = std::move(it->second);
+    early_messages_.erase(it);
+  }
+  for (auto& [party_id, raw_message] : messages) {
+    received_message(party_id, std::move(raw_message));
+  }
+}
+
 CommMixin::CommMixin(Communication::CommunicationLayer& communication_layer,
                      Communication::MessageType gate_message_type, std::shared_ptr<Logger> logger)
     : communication_layer_(communication_layer),
@@ -284,34 +322,40 @@ CommMixin::CommMixin(Communication::CommunicationLayer& communication_layer,
 
 CommMixin::~CommMixin() { communication_layer_.deregister_message_handler({gate_message_type_}); }
 
-flatbuffers::FlatBufferBuilder CommMixin::build_gate_message(std::size_t gate_id,
+std::vector<std::uint8_t> CommMixin::build_gate_message(std::size_t gate_id,
                                                              std::size_t msg_num,
                                                              const std::uint8_t* message,
                                                              std::size_t size) const {
-  flatbuffers::FlatBufferBuilder builder;
-  auto vector = builder.CreateVector(message, size);
-  auto root = Communication::CreateCommMixinGateMessage(builder, gate_id, msg_num, vector);
-  builder.Finish(root);
-  return Communication::BuildMessage(gate_message_type_, builder.GetBufferPointer(),
-                                     builder.GetSize());
+  return Communication::BuildCompactMessage(gate_message_type_, gate_id, msg_num, message, size);
 }
 
 template <typename T>
-flatbuffers::FlatBufferBuilder CommMixin::build_gate_message(std::size_t gate_id,
+std::vector<std::uint8_t> CommMixin::build_gate_message(std::size_t gate_id,
                                                              std::size_t msg_num,
-                                                             const std::vector<T>& vector) const {
-  return build_gate_message(gate_id, msg_num, reinterpret_cast<const std::uint8_t*>(vector.data()),
-                            sizeof(T) * vector.size());
+                                                             const std::vector<T>& vector,
+                                                             std::size_t bit_width) const {
+  if (bit_width == 8 * sizeof(T)) {
+    return build_gate_message(gate_id, msg_num,
+                              reinterpret_cast<const std::uint8_t*>(vector.data()),
+                              sizeof(T) * vector.size());
+  }
+  // pack directly into the message buffer
+  auto message = build_gate_message(gate_id, msg_num, nullptr, 0);
+  message.resize(Communication::compact_message_header_size +
+                 packed_ints_size(vector.size(), bit_width));
+  pack_ints(message.data() + Communication::compact_message_header_size, vector.data(),
+            vector.size(), bit_width);
+  return message;
 }
 
-flatbuffers::FlatBufferBuilder CommMixin::build_gate_message(
+std::vector<std::uint8_t> CommMixin::build_gate_message(
     std::size_t gate_id, std::size_t msg_num, const ENCRYPTO::BitVector<>& message) const {
   auto vector = message.GetData();
   return build_gate_message(gate_id, msg_num, reinterpret_cast<const std::uint8_t*>(vector.data()),
                             vector.size());
 }
 
-flatbuffers::FlatBufferBuilder CommMixin::build_gate_message(
+std::vector<std::uint8_t> CommMixin::build_gate_message(
     std::size_t gate_id, std::size_t msg_num, const ENCRYPTO::block128_vector& message) const {
   auto data = message.data();
   return build_gate_message(gate_id, msg_num, reinterpret_cast<const std::uint8_t*>(data),
@@ -336,9 +380,10 @@ CommMixin::register_for_bits_messages(std::size_t gate_id, std::size_t num_bits,
   std::vector<ENCRYPTO::ReusableFiberFuture<ENCRYPTO::BitVector<>>> futures;
   std::transform(std::begin(promises), std::end(promises), std::back_inserter(futures),
                  [](auto& p) { return p.get_future(); });
+  std::unique_lock lock(mh.mutex_);
   auto [_, success] = mh.expected_messages_.insert(
       {std::make_pair(gate_id, msg_num),
-       std::make_pair(num_bits, GateMessageHandler::MsgValueType::bit)});
+       GateMessageHandler::ExpectedMessage{num_bits, GateMessageHandler::MsgValueType::bit, 1}});
   if (!success) {
     throw std::logic_error(fmt::format("tried to register twice for message for gate {}", gate_id));
   }
@@ -351,6 +396,8 @@ CommMixin::register_for_bits_messages(std::size_t gate_id, std::size_t num_bits,
         promise_map.insert({std::make_pair(gate_id, msg_num), std::move(promises.at(party_id))});
     assert(success);
   }
+  lock.unlock();
+  mh.deliver_early_messages(gate_id, msg_num);
   if constexpr (MOTION_VERBOSE_DEBUG) {
     if (logger_) {
       logger_->LogTrace(
@@ -367,9 +414,10 @@ CommMixin::register_for_bits_message(std::size_t party_id, std::size_t gate_id,
   auto& mh = *message_handler_;
   ENCRYPTO::ReusableFiberPromise<ENCRYPTO::BitVector<>> promise;
   ENCRYPTO::ReusableFiberFuture<ENCRYPTO::BitVector<>> future = promise.get_future();
+  std::unique_lock lock(mh.mutex_);
   auto [_, success] = mh.expected_messages_.insert(
       {std::make_pair(gate_id, msg_num),
-       std::make_pair(num_bits, GateMessageHandler::MsgValueType::bit)});
+       GateMessageHandler::ExpectedMessage{num_bits, GateMessageHandler::MsgValueType::bit, 1}});
   if (!success) {
     throw std::logic_error(fmt::format("tried to register twice for message for gate {}", gate_id));
   }
@@ -378,6 +426,8 @@ CommMixin::register_for_bits_message(std::size_t party_id, std::size_t gate_id,
     auto [_, success] = promise_map.insert({std::make_pair(gate_id, msg_num), std::move(promise)});
     assert(success);
   }
+  lock.unlock();
+  mh.deliver_early_messages(gate_id, msg_num);
   if constexpr (MOTION_VERBOSE_DEBUG) {
     if (logger_) {
       logger_->LogTrace(
@@ -407,9 +457,11 @@ CommMixin::register_for_blocks_messages(std::size_t gate_id, std::size_t num_blo
   std::vector<ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector>> futures;
   std::transform(std::begin(promises), std::end(promises), std::back_inserter(futures),
                  [](auto& p) { return p.get_future(); });
+  std::unique_lock lock(mh.mutex_);
   auto [_, success] = mh.expected_messages_.insert(
       {std::make_pair(gate_id, msg_num),
-       std::make_pair(num_blocks, GateMessageHandler::MsgValueType::block)});
+       GateMessageHandler::ExpectedMessage{num_blocks, GateMessageHandler::MsgValueType::block,
+                                           128}});
   if (!success) {
     throw std::logic_error(fmt::format("tried to register twice for message for gate {}", gate_id));
   }
@@ -422,6 +474,8 @@ CommMixin::register_for_blocks_messages(std::size_t gate_id, std::size_t num_blo
         promise_map.insert({std::make_pair(gate_id, msg_num), std::move(promises.at(party_id))});
     assert(success);
   }
+  lock.unlock();
+  mh.deliver_early_messages(gate_id, msg_num);
   if constexpr (MOTION_VERBOSE_DEBUG) {
     if (logger_) {
       logger_->LogTrace(
@@ -438,9 +492,11 @@ CommMixin::register_for_blocks_message(std::size_t party_id, std::size_t gate_id
   auto& mh = *message_handler_;
   ENCRYPTO::ReusableFiberPromise<ENCRYPTO::block128_vector> promise;
   ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector> future = promise.get_future();
+  std::unique_lock lock(mh.mutex_);
   auto [_, success] = mh.expected_messages_.insert(
       {std::make_pair(gate_id, msg_num),
-       std::make_pair(num_blocks, GateMessageHandler::MsgValueType::block)});
+       GateMessageHandler::ExpectedMessage{num_blocks, GateMessageHandler::MsgValueType::block,
+                                           128}});
   if (!success) {
     throw std::logic_error(fmt::format("tried to register twice for message for gate {}", gate_id));
   }
@@ -449,6 +505,8 @@ CommMixin::register_for_blocks_message(std::size_t party_id, std::size_t gate_id
     auto [_, success] = promise_map.insert({std::make_pair(gate_id, msg_num), std::move(promise)});
     assert(success);
   }
+  lock.unlock();
+  mh.deliver_early_messages(gate_id, msg_num);
   if constexpr (MOTION_VERBOSE_DEBUG) {
     if (logger_) {
       logger_->LogTrace(
@@ -460,46 +518,57 @@ CommMixin::register_for_blocks_message(std::size_t party_id, std::size_t gate_id
 
 template <typename T>
 void CommMixin::broadcast_ints_message(std::size_t gate_id, const std::vector<T>& message,
-                                       std::size_t msg_num) const {
-  communication_layer_.broadcast_message(build_gate_message(gate_id, msg_num, message));
+                                       std::size_t msg_num, std::size_t bit_width) const {
+  communication_layer_.broadcast_message(build_gate_message(gate_id, msg_num, message, bit_width));
 }
 
 template void CommMixin::broadcast_ints_message(std::size_t, const std::vector<std::uint8_t>&,
-                                                std::size_t) const;
+                                                std::size_t, std::size_t) const;
 template void CommMixin::broadcast_ints_message(std::size_t, const std::vector<std::uint16_t>&,
-                                                std::size_t) const;
+                                                std::size_t, std::size_t) const;
 template void CommMixin::broadcast_ints_message(std::size_t, const std::vector<std::uint32_t>&,
-                                                std::size_t) const;
+                                                std::size_t, std::size_t) const;
 template void CommMixin::broadcast_ints_message(std::size_t, const std::vector<std::uint64_t>&,
-                                                std::size_t) const;
+                                                std::size_t, std::size_t) const;
 
 template <typename T>
 void CommMixin::send_ints_message(std::size_t party_id, std::size_t gate_id,
-                                  const std::vector<T>& message, std::size_t msg_num) const {
-  communication_layer_.send_message(party_id, build_gate_message(gate_id, msg_num, message));
+                                  const std::vector<T>& message, std::size_t msg_num,
+                                  std::size_t bit_width) const {
+  communication_layer_.send_message(party_id,
+                                    build_gate_message(gate_id, msg_num, message, bit_width));
 }
 
 template void CommMixin::send_ints_message(std::size_t, std::size_t,
-                                           const std::vector<std::uint8_t>&, std::size_t) const;
+                                           const std::vector<std::uint8_t>&, std::size_t,
+                                           std::size_t) const;
 template void CommMixin::send_ints_message(std::size_t, std::size_t,
-                                           const std::vector<std::uint16_t>&, std::size_t) const;
+                                           const std::vector<std::uint16_t>&, std::size_t,
+                                           std::size_t) const;
 template void CommMixin::send_ints_message(std::size_t, std::size_t,
-                                           const std::vector<std::uint32_t>&, std::size_t) const;
+                                           const std::vector<std::uint32_t>&, std::size_t,
+                                           std::size_t) const;
 template void CommMixin::send_ints_message(std::size_t, std::size_t,
-                                           const std::vector<std::uint64_t>&, std::size_t) const;
+                                           const std::vector<std::uint64_t>&, std::size_t,
+                                           std::size_t) const;
 
 template <typename T>
 [[nodiscard]] std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<T>>>
 CommMixin::register_for_ints_messages(std::size_t gate_id, std::size_t num_elements,
-                                      std::size_t msg_num) {
+                                      std::size_t msg_num, std::size_t bit_width) {
   auto& mh = *message_handler_;
   std::vector<ENCRYPTO::ReusableFiberPromise<std::vector<T>>> promises(num_parties_);
   std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<T>>> futures;
   std::transform(std::begin(promises), std::end(promises), std::back_inserter(futures),
                  [](auto& p) { return p.get_future(); });
+  if (bit_width == 0 || bit_width > 8 * sizeof(T)) {
+    throw std::invalid_argument(fmt::format("invalid bit width {}", bit_width));
+  }
   auto type = GateMessageHandler::get_msg_value_type<T>();
+  std::unique_lock lock(mh.mutex_);
   auto [_, success] = mh.expected_messages_.insert(
-      {std::make_pair(gate_id, msg_num), std::make_pair(num_elements, type)});
+      {std::make_pair(gate_id, msg_num),
+       GateMessageHandler::ExpectedMessage{num_elements, type, bit_width}});
   if (!success) {
     throw std::logic_error(
         fmt::format("tried to register twice for message {} for gate {}", msg_num, gate_id));
@@ -513,6 +582,8 @@ CommMixin::register_for_ints_messages(std::size_t gate_id, std::size_t num_eleme
         promise_map.insert({std::make_pair(gate_id, msg_num), std::move(promises.at(party_id))});
     assert(success);
   }
+  lock.unlock();
+  mh.deliver_early_messages(gate_id, msg_num);
   if constexpr (MOTION_VERBOSE_DEBUG) {
     if (logger_) {
       logger_->LogTrace(fmt::format("Gate {}: registered for int messages {} of size {}", gate_id,
@@ -523,24 +594,30 @@ CommMixin::register_for_ints_messages(std::size_t gate_id, std::size_t num_eleme
 }
 
 template std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<std::uint8_t>>>
-    CommMixin::register_for_ints_messages(std::size_t, std::size_t, std::size_t);
+    CommMixin::register_for_ints_messages(std::size_t, std::size_t, std::size_t, std::size_t);
 template std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<std::uint16_t>>>
-    CommMixin::register_for_ints_messages(std::size_t, std::size_t, std::size_t);
+    CommMixin::register_for_ints_messages(std::size_t, std::size_t, std::size_t, std::size_t);
 template std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<std::uint32_t>>>
-    CommMixin::register_for_ints_messages(std::size_t, std::size_t, std::size_t);
+    CommMixin::register_for_ints_messages(std::size_t, std::size_t, std::size_t, std::size_t);
 template std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<std::uint64_t>>>
-    CommMixin::register_for_ints_messages(std::size_t, std::size_t, std::size_t);
+    CommMixin::register_for_ints_messages(std::size_t, std::size_t, std::size_t, std::size_t);
 
 template <typename T>
 [[nodiscard]] ENCRYPTO::ReusableFiberFuture<std::vector<T>> CommMixin::register_for_ints_message(
-    std::size_t party_id, std::size_t gate_id, std::size_t num_elements, std::size_t msg_num) {
+    std::size_t party_id, std::size_t gate_id, std::size_t num_elements, std::size_t msg_num,
+    std::size_t bit_width) {
   assert(party_id != my_id_);
   auto& mh = *message_handler_;
   ENCRYPTO::ReusableFiberPromise<std::vector<T>> promise;
   ENCRYPTO::ReusableFiberFuture<std::vector<T>> future = promise.get_future();
+  if (bit_width == 0 || bit_width > 8 * sizeof(T)) {
+    throw std::invalid_argument(fmt::format("invalid bit width {}", bit_width));
+  }
   auto type = GateMessageHandler::get_msg_value_type<T>();
+  std::unique_lock lock(mh.mutex_);
   auto [_, success] = mh.expected_messages_.insert(
-      {std::make_pair(gate_id, msg_num), std::make_pair(num_elements, type)});
+      {std::make_pair(gate_id, msg_num),
+       GateMessageHandler::ExpectedMessage{num_elements, type, bit_width}});
   if (!success) {
     throw std::logic_error(
         fmt::format("tried to register twice for message {} for gate {}", msg_num, gate_id));
@@ -550,6 +627,8 @@ template <typename T>
     auto [_, success] = promise_map.insert({std::make_pair(gate_id, msg_num), std::move(promise)});
     assert(success);
   }
+  lock.unlock();
+  mh.deliver_early_messages(gate_id, msg_num);
   if constexpr (MOTION_VERBOSE_DEBUG) {
     if (logger_) {
       logger_->LogTrace(fmt::format("Gate {}: registered for int message {} of size {}", gate_id,
@@ -560,12 +639,16 @@ template <typename T>
 }
 
 template ENCRYPTO::ReusableFiberFuture<std::vector<std::uint8_t>>
-    CommMixin::register_for_ints_message(std::size_t, std::size_t, std::size_t, std::size_t);
+    CommMixin::register_for_ints_message(std::size_t, std::size_t, std::size_t, std::size_t,
+                                         std::size_t);
 template ENCRYPTO::ReusableFiberFuture<std::vector<std::uint16_t>>
-    CommMixin::register_for_ints_message(std::size_t, std::size_t, std::size_t, std::size_t);
+    CommMixin::register_for_ints_message(std::size_t, std::size_t, std::size_t, std::size_t,
+                                         std::size_t);
 template ENCRYPTO::ReusableFiberFuture<std::vector<std::uint32_t>>
-    CommMixin::register_for_ints_message(std::size_t, std::size_t, std::size_t, std::size_t);
+    CommMixin::register_for_ints_message(std::size_t, std::size_t, std::size_t, std::size_t,
+                                         std::size_t);
 template ENCRYPTO::ReusableFiberFuture<std::vector<std::uint64_t>>
-    CommMixin::register_for_ints_message(std::size_t, std::size_t, std::size_t, std::size_t);
+    CommMixin::register_for_ints_message(std::size_t, std::size_t, std::size_t, std::size_t,
+                                         std::size_t);
 
 }  // namespace MOTION::proto
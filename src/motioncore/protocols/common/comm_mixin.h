@@ -64,30 +64,36 @@ class CommMixin {
   register_for_blocks_message(std::size_t party_id, std::size_t gate_id, std::size_t num_bits,
                               std::size_t msg_num = 0);
 
+  // The ints messages may be sent bit-packed if only the lowest `bit_width`
+  // bits of each element are needed (cf. utility/bit_packing.h).  Sender and
+  // receiver need to use the same bit width, and the received elements are
+  // reduced modulo 2^bit_width.
   template <typename T>
   void broadcast_ints_message(std::size_t gate_id, const std::vector<T>& message,
-                              std::size_t msg_num = 0) const;
+                              std::size_t msg_num = 0, std::size_t bit_width = 8 * sizeof(T)) const;
   template <typename T>
   void send_ints_message(std::size_t party_id, std::size_t gate_id, const std::vector<T>& message,
-                         std::size_t msg_num = 0) const;
+                         std::size_t msg_num = 0, std::size_t bit_width = 8 * sizeof(T)) const;
   template <typename T>
   [[nodiscard]] std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<T>>>
   register_for_ints_messages(std::size_t gate_id, std::size_t num_elements,
-                             std::size_t msg_num = 0);
+                             std::size_t msg_num = 0, std::size_t bit_width = 8 * sizeof(T));
   template <typename T>
   [[nodiscard]] ENCRYPTO::ReusableFiberFuture<std::vector<T>> register_for_ints_message(
-      std::size_t party_id, std::size_t gate_id, std::size_t num_elements, std::size_t msg_num = 0);
+      std::size_t party_id, std::size_t gate_id, std::size_t num_elements, std::size_t msg_num = 0,
+      std::size_t bit_width = 8 * sizeof(T));
 
  private:
-  flatbuffers::FlatBufferBuilder build_gate_message(std::size_t gate_id, std::size_t msg_num,
+  std::vector<std::uint8_t> build_gate_message(std::size_t gate_id, std::size_t msg_num,
                                                     const std::uint8_t* message,
                                                     std::size_t size) const;
   template <typename T>
-  flatbuffers::FlatBufferBuilder build_gate_message(std::size_t gate_id, std::size_t msg_num,
-                                                    const std::vector<T>& vector) const;
-  flatbuffers::FlatBufferBuilder build_gate_message(std::size_t gate_id, std::size_t msg_num,
+  std::vector<std::uint8_t> build_gate_message(std::size_t gate_id, std::size_t msg_num,
+                                                    const std::vector<T>& vector,
+                                                    std::size_t bit_width) const;
+  std::vector<std::uint8_t> build_gate_message(std::size_t gate_id, std::size_t msg_num,
                                                     const ENCRYPTO::BitVector<>& message) const;
-  flatbuffers::FlatBufferBuilder build_gate_message(std::size_t gate_id, std::size_t msg_num,
+  std::vector<std::uint8_t> build_gate_message(std::size_t gate_id, std::size_t msg_num,
                                                     const ENCRYPTO::block128_vector& message) const;
 
   struct GateMessageHandler;
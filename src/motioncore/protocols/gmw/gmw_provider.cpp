@@ -734,46 +734,50 @@ tensor::TensorCP GMWProvider::make_arithmetic_64_tensor_input_other(
 
 template <typename T>
 ENCRYPTO::ReusableFiberFuture<IntegerValues<T>> GMWProvider::basic_make_arithmetic_tensor_output_my(
-    const tensor::TensorCP& in) {
+    const tensor::TensorCP& in, std::size_t output_bit_size) {
   auto input = std::dynamic_pointer_cast<const ArithmeticGMWTensor<T>>(in);
   if (input == nullptr) {
     throw std::logic_error("wrong tensor type");
   }
   auto gate_id = gate_register_.get_next_gate_id();
   auto tensor_op =
-      std::make_unique<ArithmeticGMWTensorOutput<T>>(gate_id, *this, std::move(input), my_id_);
+      std::make_unique<ArithmeticGMWTensorOutput<T>>(gate_id, *this, std::move(input), my_id_,
+                                                     output_bit_size);
   auto future = tensor_op->get_output_future();
   gate_register_.register_gate(std::move(tensor_op));
   return future;
 }
 
 template ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-GMWProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP&);
+GMWProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP&, std::size_t);
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>>
-GMWProvider::make_arithmetic_32_tensor_output_my(const tensor::TensorCP& in) {
-  return basic_make_arithmetic_tensor_output_my<std::uint32_t>(in);
+GMWProvider::make_arithmetic_32_tensor_output_my(const tensor::TensorCP& in,
+                                                 std::size_t output_bit_size) {
+  return basic_make_arithmetic_tensor_output_my<std::uint32_t>(in, output_bit_size);
 }
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-GMWProvider::make_arithmetic_64_tensor_output_my(const tensor::TensorCP& in) {
-  return basic_make_arithmetic_tensor_output_my<std::uint64_t>(in);
+GMWProvider::make_arithmetic_64_tensor_output_my(const tensor::TensorCP& in,
+                                                 std::size_t output_bit_size) {
+  return basic_make_arithmetic_tensor_output_my<std::uint64_t>(in, output_bit_size);
 }
 
-void GMWProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP& in) {
+void GMWProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP& in,
+                                                      std::size_t output_bit_size) {
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
   switch (in->get_bit_size()) {
     case 32: {
       gate = std::make_unique<ArithmeticGMWTensorOutput<std::uint32_t>>(
           gate_id, *this, std::dynamic_pointer_cast<const ArithmeticGMWTensor<std::uint32_t>>(in),
-          1 - my_id_);
+          1 - my_id_, output_bit_size);
       break;
     }
     case 64: {
       gate = std::make_unique<ArithmeticGMWTensorOutput<std::uint64_t>>(
           gate_id, *this, std::dynamic_pointer_cast<const ArithmeticGMWTensor<std::uint64_t>>(in),
-          1 - my_id_);
+          1 - my_id_, output_bit_size);
       break;
     }
     default: {
@@ -793,6 +797,22 @@ tensor::TensorCP GMWProvider::make_tensor_conversion(MPCProtocol dst_proto,
                                           ToString(src_proto), ToString(dst_proto)));
 }
 
+tensor::TensorCP GMWProvider::make_tensor_bit_to_arithmetic_op(const tensor::TensorCP input,
+                                                               std::size_t bit_size) {
+  if (input->get_protocol() != MPCProtocol::BooleanGMW || input->get_bit_size() != 1) {
+    throw std::invalid_argument(
+        "GMWProvider: bit to arithmetic conversion expects a BooleanGMW tensor of bit size 1");
+  }
+  switch (bit_size) {
+    case 32:
+      return basic_make_convert_boolean_to_arithmetic_gmw_tensor<std::uint32_t>(input);
+    case 64:
+      return basic_make_convert_boolean_to_arithmetic_gmw_tensor<std::uint64_t>(input);
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+}
+
 tensor::TensorCP GMWProvider::make_tensor_flatten_op(const tensor::TensorCP input,
                                                      std::size_t axis) {
   if (axis > 4) {
@@ -982,6 +1002,115 @@ tensor::TensorCP GMWProvider::make_tensor_avgpool_op(const tensor::AveragePoolOp
   return output;
 }
 
+tensor::TensorCP GMWProvider::make_tensor_sum_op(const tensor::TensorCP input,
+                                                 std::size_t axis) {
+  auto bit_size = input->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, input, axis, gate_id, &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticGMWTensorSum<T>>(
+        gate_id, *this, axis, std::dynamic_pointer_cast<const ArithmeticGMWTensor<T>>(input));
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
+tensor::TensorCP GMWProvider::make_tensor_mean_op(const tensor::TensorCP input,
+                                                  std::size_t axis, std::size_t fractional_bits) {
+  auto bit_size = input->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, input, axis, fractional_bits, gate_id, &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticGMWTensorMean<T>>(
+        gate_id, *this, axis, std::dynamic_pointer_cast<const ArithmeticGMWTensor<T>>(input),
+        fractional_bits);
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
+tensor::TensorCP GMWProvider::make_tensor_negate(const tensor::TensorCP input) {
+  auto bit_size = input->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, input, gate_id, &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticGMWTensorNegate<T>>(
+        gate_id, *this, std::dynamic_pointer_cast<const ArithmeticGMWTensor<T>>(input));
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
+tensor::TensorCP GMWProvider::make_tensor_add_op(const tensor::TensorCP input_A,
+                                                 const tensor::TensorCP input_B) {
+  auto bit_size = input_A->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, input_A, input_B, gate_id, &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    auto tensor_op = std::make_unique<ArithmeticGMWTensorAdd<T>>(
+        gate_id, *this, std::dynamic_pointer_cast<const ArithmeticGMWTensor<T>>(input_A),
+        std::dynamic_pointer_cast<const ArithmeticGMWTensor<T>>(input_B));
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
 tensor::TensorCP GMWProvider::make_tensor_relu_op(const tensor::TensorCP in) {
   const auto input_tensor = std::dynamic_pointer_cast<const BooleanGMWTensor>(in);
   assert(input_tensor != nullptr);
@@ -1029,6 +1158,11 @@ tensor::TensorCP GMWProvider::make_tensor_relu_op(const tensor::TensorCP in_bool
   }
 }
 
+bool GMWProvider::supports_tensor_relu_op(MPCProtocol bool_protocol,
+                                          MPCProtocol arith_protocol) const noexcept {
+  return bool_protocol == MPCProtocol::BooleanGMW && arith_protocol == MPCProtocol::ArithmeticGMW;
+}
+
 tensor::TensorCP GMWProvider::make_tensor_maxpool_op(const tensor::MaxPoolOp& maxpool_op,
                                                      const tensor::TensorCP in) {
   const auto input_tensor = std::dynamic_pointer_cast<const BooleanGMWTensor>(in);
@@ -1041,6 +1175,34 @@ tensor::TensorCP GMWProvider::make_tensor_maxpool_op(const tensor::MaxPoolOp& ma
   return output;
 }
 
+tensor::TensorCP GMWProvider::make_tensor_gt_public_op(
+    const tensor::TensorCP in, const std::vector<std::uint64_t>& constants) {
+  const auto input_tensor = std::dynamic_pointer_cast<const BooleanGMWTensor>(in);
+  if (input_tensor == nullptr) {
+    throw std::invalid_argument(
+        "GMWProvider: GT with public constants expects a Boolean GMW tensor");
+  }
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto tensor_op = std::make_unique<BooleanGMWTensorGTPublic>(
+      gate_id, *this, input_tensor, tensor::broadcast_per_channel(in->get_dimensions(), constants));
+  auto output = tensor_op->get_output_tensor();
+  gate_register_.register_gate(std::move(tensor_op));
+  return output;
+}
+
+tensor::TensorCP GMWProvider::make_tensor_clip_op(const tensor::TensorCP in, std::uint64_t min,
+                                                  std::uint64_t max) {
+  const auto input_tensor = std::dynamic_pointer_cast<const BooleanGMWTensor>(in);
+  if (input_tensor == nullptr) {
+    throw std::invalid_argument("GMWProvider: Clip expects a Boolean GMW tensor");
+  }
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto tensor_op = std::make_unique<BooleanGMWTensorClip>(gate_id, *this, input_tensor, min, max);
+  auto output = tensor_op->get_output_tensor();
+  gate_register_.register_gate(std::move(tensor_op));
+  return output;
+}
+
 template <typename T>
 tensor::TensorCP GMWProvider::basic_make_convert_boolean_to_arithmetic_gmw_tensor(
     const tensor::TensorCP in) {
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -194,14 +195,17 @@ class GMWProvider : public GateFactory,
 
   // arithmetic outputs
   ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>> make_arithmetic_32_tensor_output_my(
-      const tensor::TensorCP&) override;
+      const tensor::TensorCP&, std::size_t output_bit_size = 0) override;
   ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>> make_arithmetic_64_tensor_output_my(
-      const tensor::TensorCP&) override;
+      const tensor::TensorCP&, std::size_t output_bit_size = 0) override;
 
-  void make_arithmetic_tensor_output_other(const tensor::TensorCP&) override;
+  void make_arithmetic_tensor_output_other(const tensor::TensorCP&,
+                                           std::size_t output_bit_size = 0) override;
 
   // conversions
   tensor::TensorCP make_tensor_conversion(MPCProtocol, const tensor::TensorCP input) override;
+  tensor::TensorCP make_tensor_bit_to_arithmetic_op(const tensor::TensorCP input,
+                                                    std::size_t bit_size) override;
 
   // tensor operations
   tensor::TensorCP make_tensor_flatten_op(const tensor::TensorCP input, std::size_t axis) override;
@@ -220,10 +224,21 @@ class GMWProvider : public GateFactory,
   template <typename T>
   tensor::TensorCP basic_make_tensor_relu_op(const tensor::TensorCP, const tensor::TensorCP);
   tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP, const tensor::TensorCP) override;
+  bool supports_tensor_relu_op(MPCProtocol bool_protocol,
+                               MPCProtocol arith_protocol) const noexcept override;
   tensor::TensorCP make_tensor_maxpool_op(const tensor::MaxPoolOp&,
                                           const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_gt_public_op(const tensor::TensorCP,
+                                            const std::vector<std::uint64_t>&) override;
+  tensor::TensorCP make_tensor_clip_op(const tensor::TensorCP, std::uint64_t min,
+                                       std::uint64_t max) override;
   tensor::TensorCP make_tensor_avgpool_op(const tensor::AveragePoolOp&, const tensor::TensorCP,
                                           std::size_t fractional_bits = 0) override;
+  tensor::TensorCP make_tensor_sum_op(const tensor::TensorCP input, std::size_t axis) override;
+  tensor::TensorCP make_tensor_mean_op(const tensor::TensorCP input, std::size_t axis,
+                                       std::size_t fractional_bits) override;
+  tensor::TensorCP make_tensor_negate(const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_add_op(const tensor::TensorCP, const tensor::TensorCP) override;
   template <typename T>
   tensor::TensorCP basic_make_convert_boolean_to_arithmetic_gmw_tensor(const tensor::TensorCP);
   tensor::TensorCP make_convert_boolean_to_arithmetic_gmw_tensor(const tensor::TensorCP);
@@ -273,7 +288,7 @@ class GMWProvider : public GateFactory,
   tensor::TensorCP basic_make_arithmetic_tensor_input_other(const tensor::TensorDimensions&);
   template <typename T>
   ENCRYPTO::ReusableFiberFuture<IntegerValues<T>> basic_make_arithmetic_tensor_output_my(
-      const tensor::TensorCP&);
+      const tensor::TensorCP&, std::size_t output_bit_size = 0);
 
  private:
   Communication::CommunicationLayer& communication_layer_;
@@ -39,6 +39,7 @@
 #include "crypto/sharing_randomness_generator.h"
 #include "executor/execution_context.h"
 #include "gmw_provider.h"
+#include "utility/bit_packing.h"
 #include "utility/bit_vector.h"
 #include "utility/constants.h"
 #include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
@@ -181,12 +182,21 @@ template <typename T>
 ArithmeticGMWTensorOutput<T>::ArithmeticGMWTensorOutput(std::size_t gate_id,
                                                         GMWProvider& gmw_provider,
                                                         ArithmeticGMWTensorCP<T> input,
-                                                        std::size_t output_owner)
-    : NewGate(gate_id), gmw_provider_(gmw_provider), output_owner_(output_owner), input_(input) {
+                                                        std::size_t output_owner,
+                                                        std::size_t output_bit_size)
+    : NewGate(gate_id),
+      gmw_provider_(gmw_provider),
+      output_owner_(output_owner),
+      output_bit_size_(output_bit_size == 0 ? ENCRYPTO::bit_size_v<T> : output_bit_size),
+      input_(input) {
+  if (output_bit_size_ > ENCRYPTO::bit_size_v<T>) {
+    throw std::invalid_argument(fmt::format("invalid output bit size {} for {} bit tensor",
+                                            output_bit_size_, ENCRYPTO::bit_size_v<T>));
+  }
   auto my_id = gmw_provider_.get_my_id();
   if (output_owner_ == my_id) {
     share_future_ = gmw_provider_.register_for_ints_message<T>(
-        1 - my_id, gate_id_, input_->get_dimensions().get_data_size());
+        1 - my_id, gate_id_, input_->get_dimensions().get_data_size(), 0, output_bit_size_);
   }
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
@@ -215,9 +225,12 @@ void ArithmeticGMWTensorOutput<T>::evaluate_online() {
     __gnu_parallel::transform(std::begin(other_share), std::end(other_share),
                               std::begin(input_->get_share()), std::begin(other_share),
                               std::plus{});
+    if (output_bit_size_ < ENCRYPTO::bit_size_v<T>) {
+      sign_extend_ints(other_share.data(), other_share.size(), output_bit_size_);
+    }
     output_promise_.set_value(std::move(other_share));
   } else {
-    gmw_provider_.send_ints_message(1 - my_id, gate_id_, input_->get_share());
+    gmw_provider_.send_ints_message(1 - my_id, gate_id_, input_->get_share(), 0, output_bit_size_);
   }
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
@@ -630,14 +643,233 @@ void ArithmeticGMWTensorAveragePool<T>::evaluate_online() {
 template class ArithmeticGMWTensorAveragePool<std::uint32_t>;
 template class ArithmeticGMWTensorAveragePool<std::uint64_t>;
 
+template <typename T>
+ArithmeticGMWTensorSum<T>::ArithmeticGMWTensorSum(std::size_t gate_id, GMWProvider& gmw_provider,
+                                                  std::size_t axis,
+                                                  const ArithmeticGMWTensorCP<T> input)
+    : NewGate(gate_id),
+      gmw_provider_(gmw_provider),
+      axis_(axis),
+      input_(input),
+      output_(std::make_shared<ArithmeticGMWTensor<T>>(
+          tensor::reduce(input_->get_dimensions(), axis_))) {
+  if (axis_ > 3) {
+    throw std::invalid_argument("invalid axis argument > 3");
+  }
+  output_->get_share().resize(output_->get_dimensions().get_data_size());
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticGMWTensorSum<T> created", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticGMWTensorSum<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticGMWTensorSum<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+  sum_reduce(input_->get_dimensions(), axis_, input_->get_share().data(),
+             output_->get_share().data());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticGMWTensorSum<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticGMWTensorSum<std::uint32_t>;
+template class ArithmeticGMWTensorSum<std::uint64_t>;
+
+template <typename T>
+ArithmeticGMWTensorMean<T>::ArithmeticGMWTensorMean(std::size_t gate_id,
+                                                    GMWProvider& gmw_provider, std::size_t axis,
+                                                    const ArithmeticGMWTensorCP<T> input,
+                                                    std::size_t fractional_bits)
+    : NewGate(gate_id),
+      gmw_provider_(gmw_provider),
+      axis_(axis),
+      fractional_bits_(fractional_bits),
+      input_(input),
+      output_(std::make_shared<ArithmeticGMWTensor<T>>(
+          tensor::reduce(input_->get_dimensions(), axis_))) {
+  if (axis_ > 3) {
+    throw std::invalid_argument("invalid axis argument > 3");
+  }
+  if (fractional_bits_ >= ENCRYPTO::bit_size_v<T>) {
+    throw std::invalid_argument(
+        fmt::format("ArithmeticGMWTensorMean: {} fractional bits for {} bit tensor",
+                    fractional_bits_, ENCRYPTO::bit_size_v<T>));
+  }
+  const auto output_size = output_->get_dimensions().get_data_size();
+  const auto num_summands = input_->get_dimensions().get_data_size() / output_size;
+  if (num_summands > (T(1) << fractional_bits_)) {
+    throw std::invalid_argument(
+        "ArithmeticGMWTensorMean: not enough fractional bits to represent factor");
+  }
+  factor_ = fixed_point::encode<T>(1.0 / num_summands, fractional_bits_);
+  output_->get_share().resize(output_size);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticGMWTensorMean<T> created", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticGMWTensorMean<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticGMWTensorMean<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+  auto& share = output_->get_share();
+  sum_reduce(input_->get_dimensions(), axis_, input_->get_share().data(), share.data());
+  const auto factor = factor_;
+  __gnu_parallel::transform(std::begin(share), std::end(share), std::begin(share),
+                            [factor](auto x) { return x * factor; });
+  fixed_point::truncate_shared(share.data(), fractional_bits_, share.size(),
+                               gmw_provider_.is_my_job(gate_id_));
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticGMWTensorMean<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticGMWTensorMean<std::uint32_t>;
+template class ArithmeticGMWTensorMean<std::uint64_t>;
+
+template <typename T>
+ArithmeticGMWTensorAdd<T>::ArithmeticGMWTensorAdd(std::size_t gate_id, GMWProvider& gmw_provider,
+                                                  const ArithmeticGMWTensorCP<T> input_A,
+                                                  const ArithmeticGMWTensorCP<T> input_B)
+    : NewGate(gate_id),
+      gmw_provider_(gmw_provider),
+      input_A_(input_A),
+      input_B_(input_B),
+      output_(std::make_shared<ArithmeticGMWTensor<T>>(input_A_->get_dimensions())) {
+  if (input_A_->get_dimensions() != input_B_->get_dimensions()) {
+    throw std::invalid_argument("ArithmeticGMWTensorAdd: mismatch of dimensions");
+  }
+  output_->get_share().resize(input_A_->get_dimensions().get_data_size());
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticGMWTensorAdd<T> created", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticGMWTensorAdd<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticGMWTensorAdd<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_A_->wait_online();
+  input_B_->wait_online();
+  const auto& share_A = input_A_->get_share();
+  const auto& share_B = input_B_->get_share();
+  __gnu_parallel::transform(std::begin(share_A), std::end(share_A), std::begin(share_B),
+                            std::begin(output_->get_share()), std::plus{});
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticGMWTensorAdd<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticGMWTensorAdd<std::uint32_t>;
+template class ArithmeticGMWTensorAdd<std::uint64_t>;
+
+template <typename T>
+ArithmeticGMWTensorNegate<T>::ArithmeticGMWTensorNegate(std::size_t gate_id,
+                                                        GMWProvider& gmw_provider,
+                                                        const ArithmeticGMWTensorCP<T> input)
+    : NewGate(gate_id),
+      gmw_provider_(gmw_provider),
+      input_(input),
+      output_(std::make_shared<ArithmeticGMWTensor<T>>(input_->get_dimensions())) {
+  output_->get_share().resize(input_->get_dimensions().get_data_size());
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticGMWTensorNegate<T> created", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticGMWTensorNegate<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticGMWTensorNegate<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+  const auto& share = input_->get_share();
+  __gnu_parallel::transform(std::begin(share), std::end(share), std::begin(output_->get_share()),
+                            std::negate{});
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticGMWTensorNegate<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticGMWTensorNegate<std::uint32_t>;
+template class ArithmeticGMWTensorNegate<std::uint64_t>;
+
 template <typename T>
 BooleanToArithmeticGMWTensorConversion<T>::BooleanToArithmeticGMWTensorConversion(
     std::size_t gate_id, GMWProvider& gmw_provider, const BooleanGMWTensorCP input)
     : NewGate(gate_id),
       gmw_provider_(gmw_provider),
+      bit_size_(input->get_bit_size()),
       data_size_(input->get_dimensions().get_data_size()),
       input_(std::move(input)),
       output_(std::make_shared<ArithmeticGMWTensor<T>>(input_->get_dimensions())) {
+  assert(bit_size_ <= ENCRYPTO::bit_size_v<T>);
   const auto my_id = gmw_provider_.get_my_id();
   auto& sb_provider = gmw_provider_.get_sb_provider();
   sb_offset_ = sb_provider.RequestSBs<T>(bit_size_ * data_size_);
@@ -1097,4 +1329,227 @@ void BooleanGMWTensorMaxPool::evaluate_online_with_context(ExecutionContext& exe
   }
 }
 
+// bits of NOT c for each public constant c, where the MSB is flipped such that
+// signed values compare like unsigned ones
+static std::vector<ENCRYPTO::BitVector<>> decompose_gt_public_constants(
+    const std::vector<std::uint64_t>& constants, std::size_t bit_size) {
+  std::vector<ENCRYPTO::BitVector<>> bits(bit_size, ENCRYPTO::BitVector<>(constants.size()));
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    const bool msb = bit_j == bit_size - 1;
+    for (std::size_t int_i = 0; int_i < constants.size(); ++int_i) {
+      bits[bit_j].Set(((constants[int_i] >> bit_j) & 1) == msb, int_i);
+    }
+  }
+  return bits;
+}
+
+BooleanGMWTensorGTPublic::BooleanGMWTensorGTPublic(std::size_t gate_id, GMWProvider& gmw_provider,
+                                                   const BooleanGMWTensorCP input,
+                                                   const std::vector<std::uint64_t>& constants)
+    : NewGate(gate_id),
+      gmw_provider_(gmw_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      is_my_job_(gmw_provider_.is_my_job(gate_id)),
+      input_(input),
+      output_(std::make_shared<BooleanGMWTensor>(input_->get_dimensions(), 1)),
+      constant_bits_(decompose_gt_public_constants(constants, bit_size_)) {
+  if (constants.size() != data_size_) {
+    throw std::invalid_argument(fmt::format("expected {} constants, but {} are provided",
+                                            data_size_, constants.size()));
+  }
+  const auto make_wire = [this] {
+    auto w = std::make_shared<BooleanGMWWire>(data_size_);
+    w->get_share().Resize(data_size_);
+    return w;
+  };
+  t_wires_.resize(bit_size_);
+  e_wires_.resize(bit_size_);
+  std::generate(std::begin(t_wires_), std::end(t_wires_), make_wire);
+  std::generate(std::begin(e_wires_), std::end(e_wires_), make_wire);
+  {
+    WireVector t_in(std::begin(t_wires_), std::end(t_wires_));
+    WireVector e_in(std::begin(e_wires_), std::end(e_wires_));
+    auto [gates, out] = construct_public_gt_circuit(gmw_provider_, t_in, e_in);
+    gates_ = std::move(gates);
+    output_wire_ = std::dynamic_pointer_cast<BooleanGMWWire>(out);
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: BooleanGMWTensorGTPublic created", gate_id_));
+    }
+  }
+}
+
+void BooleanGMWTensorGTPublic::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanGMWTensorGTPublic::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  // only one party XORs public values into its shares, AND with a public
+  // value is applied to both shares
+  const auto& input_shares = input_->get_share();
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    auto share = (is_my_job_ && bit_j == bit_size_ - 1) ? ~input_shares[bit_j]
+                                                         : input_shares[bit_j];
+    t_wires_[bit_j]->get_share() = share & constant_bits_[bit_j];
+    e_wires_[bit_j]->get_share() = is_my_job_ ? share ^ constant_bits_[bit_j] : std::move(share);
+    t_wires_[bit_j]->set_online_ready();
+    e_wires_[bit_j]->set_online_ready();
+  }
+
+  for (auto& gate : gates_) {
+    gate->evaluate_online();
+  }
+
+  output_wire_->wait_online();
+  output_->get_share()[0] = std::move(output_wire_->get_share());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanGMWTensorGTPublic::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+BooleanGMWTensorClip::BooleanGMWTensorClip(std::size_t gate_id, GMWProvider& gmw_provider,
+                                           const BooleanGMWTensorCP input, std::uint64_t min,
+                                           std::uint64_t max)
+    : NewGate(gate_id),
+      gmw_provider_(gmw_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      is_my_job_(gmw_provider_.is_my_job(gate_id)),
+      input_(input),
+      output_(std::make_shared<BooleanGMWTensor>(input_->get_dimensions(), bit_size_)),
+      min_(min),
+      max_(max) {
+  tensor::check_clip_range(min_, max_, bit_size_);
+  {
+    std::vector<std::uint64_t> constants(2 * data_size_, min_);
+    std::fill_n(std::begin(constants) + data_size_, data_size_, max_);
+    constant_bits_ = decompose_gt_public_constants(constants, bit_size_);
+  }
+  const auto make_wire = [](std::size_t num_simd) {
+    auto w = std::make_shared<BooleanGMWWire>(num_simd);
+    w->get_share().Resize(num_simd);
+    return w;
+  };
+  t_wires_.resize(bit_size_);
+  e_wires_.resize(bit_size_);
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    t_wires_[bit_j] = make_wire(2 * data_size_);
+    e_wires_[bit_j] = make_wire(2 * data_size_);
+  }
+  {
+    WireVector t_in(std::begin(t_wires_), std::end(t_wires_));
+    WireVector e_in(std::begin(e_wires_), std::end(e_wires_));
+    auto [gates, out] = construct_public_gt_circuit(gmw_provider_, t_in, e_in);
+    cmp_gates_ = std::move(gates);
+    cmp_wire_ = std::dynamic_pointer_cast<BooleanGMWWire>(out);
+  }
+  select_wire_ = make_wire(bit_size_ * data_size_);
+  value_wire_ = make_wire(bit_size_ * data_size_);
+  {
+    auto [gate, out] = gmw_provider_.construct_binary_gate(ENCRYPTO::PrimitiveOperationType::AND,
+                                                           {select_wire_}, {value_wire_});
+    and_gate_ = std::move(gate);
+    and_wire_ = std::dynamic_pointer_cast<BooleanGMWWire>(out.at(0));
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: BooleanGMWTensorClip created", gate_id_));
+    }
+  }
+}
+
+void BooleanGMWTensorClip::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanGMWTensorClip::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  // compare with min and max in one batch
+  const auto& input_shares = input_->get_share();
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    auto share = input_shares[bit_j];
+    share.Append(input_shares[bit_j]);
+    if (is_my_job_ && bit_j == bit_size_ - 1) {
+      share = ~share;
+    }
+    t_wires_[bit_j]->get_share() = share & constant_bits_[bit_j];
+    e_wires_[bit_j]->get_share() = is_my_job_ ? share ^ constant_bits_[bit_j] : std::move(share);
+    t_wires_[bit_j]->set_online_ready();
+    e_wires_[bit_j]->set_online_ready();
+  }
+  for (auto& gate : cmp_gates_) {
+    gate->evaluate_online();
+  }
+  cmp_wire_->wait_online();
+  auto gt_min = cmp_wire_->get_share().Subset(0, data_size_);
+  auto gt_max = cmp_wire_->get_share().Subset(data_size_, 2 * data_size_);
+
+  // select x iff min < x <= max with a single layer of AND gates
+  {
+    const auto select = gt_min ^ gt_max;
+    auto& select_share = select_wire_->get_share();
+    auto& value_share = value_wire_->get_share();
+    select_share = ENCRYPTO::BitVector<>();
+    value_share = ENCRYPTO::BitVector<>();
+    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+      select_share.Append(select);
+      value_share.Append(input_shares[bit_j]);
+    }
+    select_wire_->set_online_ready();
+    value_wire_->set_online_ready();
+  }
+  and_gate_->evaluate_online();
+  and_wire_->wait_online();
+
+  // y = (s AND x) XOR (NOT (x > min) AND min) XOR ((x > max) AND max), where
+  // only one party applies the NOT
+  if (is_my_job_) {
+    gt_min = ~gt_min;
+  }
+  auto& output_shares = output_->get_share();
+  const auto& and_share = and_wire_->get_share();
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    auto y = and_share.Subset(bit_j * data_size_, (bit_j + 1) * data_size_);
+    if ((min_ >> bit_j) & 1) {
+      y ^= gt_min;
+    }
+    if ((max_ >> bit_j) & 1) {
+      y ^= gt_max;
+    }
+    output_shares[bit_j] = std::move(y);
+  }
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = gmw_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanGMWTensorClip::evaluate_online end", gate_id_));
+    }
+  }
+}
+
 }  // namespace MOTION::proto::gmw
@@ -92,8 +92,10 @@ class ArithmeticGMWTensorInputReceiver : public NewGate {
 template <typename T>
 class ArithmeticGMWTensorOutput : public NewGate {
  public:
+  // output_bit_size == 0 reconstructs the full width of T, otherwise only
+  // the lowest output_bit_size bits are sent and the output is sign-extended
   ArithmeticGMWTensorOutput(std::size_t gate_id, GMWProvider&, ArithmeticGMWTensorCP<T>,
-                            std::size_t output_owner);
+                            std::size_t output_owner, std::size_t output_bit_size = 0);
   bool need_setup() const noexcept override { return false; }
   bool need_online() const noexcept override { return true; }
   void evaluate_setup() override {}
@@ -105,6 +107,7 @@ class ArithmeticGMWTensorOutput : public NewGate {
   ENCRYPTO::ReusableFiberPromise<std::vector<T>> output_promise_;
   ENCRYPTO::ReusableFiberFuture<std::vector<T>> share_future_;
   std::size_t output_owner_;
+  std::size_t output_bit_size_;
   const ArithmeticGMWTensorCP<T> input_;
 };
 
@@ -115,6 +118,7 @@ class ArithmeticGMWTensorFlatten : public NewGate {
                              const ArithmeticGMWTensorCP<T> input);
   bool need_setup() const noexcept override { return false; }
   bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
   void evaluate_setup() override {}
   void evaluate_online() override;
   const ArithmeticGMWTensorP<T>& get_output_tensor() const { return output_; }
@@ -215,6 +219,86 @@ class ArithmeticGMWTensorAveragePool : public NewGate {
   T factor_;
 };
 
+// Sum over one axis; the mean additionally scales the sum and truncates the
+// shares locally, hence neither requires any communication.
+template <typename T>
+class ArithmeticGMWTensorSum : public NewGate {
+ public:
+  ArithmeticGMWTensorSum(std::size_t gate_id, GMWProvider&, std::size_t axis,
+                         const ArithmeticGMWTensorCP<T> input);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  const ArithmeticGMWTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  GMWProvider& gmw_provider_;
+  std::size_t axis_;
+  const ArithmeticGMWTensorCP<T> input_;
+  std::shared_ptr<ArithmeticGMWTensor<T>> output_;
+};
+
+template <typename T>
+class ArithmeticGMWTensorMean : public NewGate {
+ public:
+  ArithmeticGMWTensorMean(std::size_t gate_id, GMWProvider&, std::size_t axis,
+                          const ArithmeticGMWTensorCP<T> input, std::size_t fractional_bits);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  const ArithmeticGMWTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  GMWProvider& gmw_provider_;
+  std::size_t axis_;
+  std::size_t fractional_bits_;
+  const ArithmeticGMWTensorCP<T> input_;
+  std::shared_ptr<ArithmeticGMWTensor<T>> output_;
+  T factor_;
+};
+
+template <typename T>
+class ArithmeticGMWTensorAdd : public NewGate {
+ public:
+  ArithmeticGMWTensorAdd(std::size_t gate_id, GMWProvider&, const ArithmeticGMWTensorCP<T> input_A,
+                         const ArithmeticGMWTensorCP<T> input_B);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  const ArithmeticGMWTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  GMWProvider& gmw_provider_;
+  const ArithmeticGMWTensorCP<T> input_A_;
+  const ArithmeticGMWTensorCP<T> input_B_;
+  std::shared_ptr<ArithmeticGMWTensor<T>> output_;
+};
+
+template <typename T>
+class ArithmeticGMWTensorNegate : public NewGate {
+ public:
+  ArithmeticGMWTensorNegate(std::size_t gate_id, GMWProvider&,
+                            const ArithmeticGMWTensorCP<T> input);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  const ArithmeticGMWTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  GMWProvider& gmw_provider_;
+  const ArithmeticGMWTensorCP<T> input_;
+  std::shared_ptr<ArithmeticGMWTensor<T>> output_;
+};
+
+// Converts a Boolean sharing of at most ENCRYPTO::bit_size_v<T> bits into an
+// arithmetic one with one shared bit per bit.
 template <typename T>
 class BooleanToArithmeticGMWTensorConversion : public NewGate {
  public:
@@ -228,7 +312,7 @@ class BooleanToArithmeticGMWTensorConversion : public NewGate {
 
  private:
   GMWProvider& gmw_provider_;
-  static constexpr auto bit_size_ = ENCRYPTO::bit_size_v<T>;
+  const std::size_t bit_size_;
   const std::size_t data_size_;
   const BooleanGMWTensorCP input_;
   ArithmeticGMWTensorP<T> output_;
@@ -302,4 +386,66 @@ class BooleanGMWTensorMaxPool : public NewGate {
   std::vector<std::unique_ptr<NewGate>> gates_;
 };
 
+// elementwise signed comparison input > c with one public constant per
+// element, the output tensor has bit size 1
+class BooleanGMWTensorGTPublic : public NewGate {
+ public:
+  BooleanGMWTensorGTPublic(std::size_t gate_id, GMWProvider&, const BooleanGMWTensorCP input,
+                           const std::vector<std::uint64_t>& constants);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  const BooleanGMWTensorP& get_output_tensor() const { return output_; }
+
+ private:
+  GMWProvider& gmw_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const bool is_my_job_;
+  const BooleanGMWTensorCP input_;
+  const BooleanGMWTensorP output_;
+  // bits of NOT c, with the MSB flipped to compare as unsigned values
+  std::vector<ENCRYPTO::BitVector<>> constant_bits_;
+  BooleanGMWWireVector t_wires_;
+  BooleanGMWWireVector e_wires_;
+  std::shared_ptr<BooleanGMWWire> output_wire_;
+  std::vector<std::unique_ptr<NewGate>> gates_;
+};
+
+// elementwise clipping of signed values to the public range [min, max]: both
+// comparisons x > min and x > max are evaluated in one batch, the selection
+// then needs a single layer of AND gates
+class BooleanGMWTensorClip : public NewGate {
+ public:
+  BooleanGMWTensorClip(std::size_t gate_id, GMWProvider&, const BooleanGMWTensorCP input,
+                       std::uint64_t min, std::uint64_t max);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  const BooleanGMWTensorP& get_output_tensor() const { return output_; }
+
+ private:
+  GMWProvider& gmw_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const bool is_my_job_;
+  const BooleanGMWTensorCP input_;
+  const BooleanGMWTensorP output_;
+  const std::uint64_t min_;
+  const std::uint64_t max_;
+  // comparison with min for the first, with max for the second half
+  std::vector<ENCRYPTO::BitVector<>> constant_bits_;
+  BooleanGMWWireVector t_wires_;
+  BooleanGMWWireVector e_wires_;
+  std::shared_ptr<BooleanGMWWire> cmp_wire_;
+  // (x > min) XOR (x > max) repeated for each bit, and the concatenated input bits
+  std::shared_ptr<BooleanGMWWire> select_wire_;
+  std::shared_ptr<BooleanGMWWire> value_wire_;
+  std::shared_ptr<BooleanGMWWire> and_wire_;
+  std::vector<std::unique_ptr<NewGate>> cmp_gates_;
+  std::unique_ptr<NewGate> and_gate_;
+};
+
 }  // namespace MOTION::proto::gmw
@@ -20,9 +20,12 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+#include <numeric>
 #include <parallel/algorithm>
 
 #include "algorithm/circuit_loader.h"
+#include "algorithm/tree_ensemble.h"
 #include "crypto/motion_base_provider.h"
 #include "crypto/oblivious_transfer/ot_flavors.h"
 #include "crypto/oblivious_transfer/ot_provider.h"
@@ -1561,4 +1564,1502 @@ void YaoTensorGTEvaluator::evaluate_online() {
   }
 }
 
+// Eq
+
+static std::size_t count_and_gates(const ENCRYPTO::AlgorithmDescription& algo) {
+  return std::count_if(std::begin(algo.gates_), std::end(algo.gates_), [](const auto& op) {
+    return op.type_ == ENCRYPTO::PrimitiveOperationType::AND;
+  });
+}
+
+YaoTensorEqGarbler::YaoTensorEqGarbler(std::size_t gate_id, YaoProvider& yao_provider,
+                                       const YaoTensorCP input_A, const YaoTensorCP input_B)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input_A->get_bit_size()),
+      data_size_(input_A->get_dimensions().get_data_size()),
+      input_A_(input_A),
+      input_B_(input_B),
+      output_(std::make_shared<YaoTensor>(input_A->get_dimensions(), 1)),
+      eq_algo_(yao_provider_.get_circuit_loader().load_eq_circuit(bit_size_)) {
+  assert(input_A_->get_dimensions() == input_B_->get_dimensions());
+  assert(input_B_->get_bit_size() == bit_size_);
+  output_->get_keys().resize(data_size_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorEqGarbler created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorEqGarbler::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorEqGarbler::evaluate_setup start", gate_id_));
+    }
+  }
+
+  input_A_->wait_setup();
+  input_B_->wait_setup();
+
+  // garble equality circuit
+  yao_provider_.create_garbled_circuit(gate_id_, data_size_, eq_algo_, input_A_->get_keys(),
+                                       input_B_->get_keys(), garbled_tables_, output_->get_keys(),
+                                       true);
+  yao_provider_.send_blocks_message(gate_id_, std::move(garbled_tables_));
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorEqGarbler::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+YaoTensorEqEvaluator::YaoTensorEqEvaluator(std::size_t gate_id, YaoProvider& yao_provider,
+                                           const YaoTensorCP input_A, const YaoTensorCP input_B)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input_A->get_bit_size()),
+      data_size_(input_A->get_dimensions().get_data_size()),
+      input_A_(input_A),
+      input_B_(input_B),
+      output_(std::make_shared<YaoTensor>(input_A->get_dimensions(), 1)),
+      eq_algo_(yao_provider_.get_circuit_loader().load_eq_circuit(bit_size_)) {
+  assert(input_A_->get_dimensions() == input_B_->get_dimensions());
+  assert(input_B_->get_bit_size() == bit_size_);
+  garbled_tables_future_ =
+      yao_provider_.register_for_blocks_message(gate_id, 2 * (bit_size_ - 1) * data_size_);
+  output_->get_keys().resize(data_size_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorEqEvaluator created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorEqEvaluator::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorEqEvaluator::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_A_->wait_online();
+  input_B_->wait_online();
+
+  // evaluate equality circuit
+  const auto garbled_tables = garbled_tables_future_.get();
+  yao_provider_.evaluate_garbled_circuit(gate_id_, data_size_, eq_algo_, input_A_->get_keys(),
+                                         input_B_->get_keys(), garbled_tables, output_->get_keys(),
+                                         true);
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorEqEvaluator::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+// GTPublic
+
+// the constants with flipped MSB such that signed values compare like unsigned ones
+static std::vector<std::uint64_t> gt_public_flip_msbs(std::vector<std::uint64_t>&& constants,
+                                                      std::size_t bit_size) {
+  const auto msb = std::uint64_t(1) << (bit_size - 1);
+  std::transform(std::begin(constants), std::end(constants), std::begin(constants),
+                 [msb](auto c) { return c ^ msb; });
+  return std::move(constants);
+}
+
+// index of the least significant zero bit of c, or bit_size if there is none
+static std::size_t gt_public_start_bit(std::uint64_t c, std::size_t bit_size) {
+  std::size_t bit_j = 0;
+  while (bit_j < bit_size && ((c >> bit_j) & 1)) {
+    ++bit_j;
+  }
+  return bit_j;
+}
+
+// number of blocks sent by the garbler of the comparison gate
+static std::size_t compute_gt_public_tables_size(const std::vector<std::uint64_t>& constants,
+                                                 std::size_t bit_size) {
+  std::size_t num_and_gates = 0;
+  for (const auto c : constants) {
+    const auto start_bit = gt_public_start_bit(c, bit_size);
+    if (start_bit < bit_size) {
+      num_and_gates += bit_size - 1 - start_bit;
+    }
+  }
+  return 2 * num_and_gates;
+}
+
+// Computes the keys of [x > c] for unsigned values x and public constants c
+// (both with flipped MSB) bit by bit, starting at the least significant zero
+// bit z of c where [x > c] = x_z:
+//   g_j = x_j AND g_{j-1}                 if c_j = 1,
+//   g_j = NOT (NOT x_j AND NOT g_{j-1})   if c_j = 0.
+// The ANDs of one bit position are passed to and_op as a single batch.  NOT
+// is computed by XORing not_offset, i.e., the global offset for the garbler
+// and 0 for the evaluator.
+template <typename F>
+static void gt_public_compute_keys(ENCRYPTO::block128_vector& output_keys,
+                                   const ENCRYPTO::block128_vector& input_keys,
+                                   const std::vector<std::uint64_t>& constants,
+                                   std::size_t bit_size, ENCRYPTO::block128_t zero_key,
+                                   ENCRYPTO::block128_t not_offset, F and_op) {
+  const auto data_size = constants.size();
+  // the MSB of x is flipped by a free NOT
+  const auto x_key = [&input_keys, &not_offset, bit_size, data_size](auto bit_j, auto int_i) {
+    const auto& key = input_keys[bit_j * data_size + int_i];
+    return bit_j == bit_size - 1 ? key ^ not_offset : key;
+  };
+
+  std::vector<std::size_t> start_bits(data_size);
+  output_keys.resize(data_size);
+  for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+    start_bits[int_i] = gt_public_start_bit(constants[int_i], bit_size);
+    output_keys[int_i] = start_bits[int_i] < bit_size ? x_key(start_bits[int_i], int_i) : zero_key;
+  }
+
+  std::vector<std::size_t> indices;
+  ENCRYPTO::block128_vector keys_a;
+  ENCRYPTO::block128_vector keys_b;
+  ENCRYPTO::block128_vector keys_out;
+  for (std::size_t bit_j = 1; bit_j < bit_size; ++bit_j) {
+    indices.clear();
+    for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+      if (start_bits[int_i] < bit_j) {
+        indices.push_back(int_i);
+      }
+    }
+    if (indices.empty()) {
+      continue;
+    }
+    keys_a.resize(indices.size());
+    keys_b.resize(indices.size());
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+      const auto int_i = indices[k];
+      keys_a[k] = x_key(bit_j, int_i);
+      keys_b[k] = output_keys[int_i];
+      if (((constants[int_i] >> bit_j) & 1) == 0) {
+        keys_a[k] ^= not_offset;
+        keys_b[k] ^= not_offset;
+      }
+    }
+    and_op(keys_a, keys_b, keys_out);
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+      const auto int_i = indices[k];
+      output_keys[int_i] = keys_out[k];
+      if (((constants[int_i] >> bit_j) & 1) == 0) {
+        output_keys[int_i] ^= not_offset;
+      }
+    }
+  }
+}
+
+YaoTensorGTPublicGarbler::YaoTensorGTPublicGarbler(std::size_t gate_id, YaoProvider& yao_provider,
+                                                   const YaoTensorCP input,
+                                                   std::vector<std::uint64_t>&& constants)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      constants_(gt_public_flip_msbs(std::move(constants), bit_size_)),
+      input_(input),
+      output_(std::make_shared<YaoTensor>(input->get_dimensions(), 1)) {
+  if (constants_.size() != data_size_) {
+    throw std::invalid_argument(fmt::format("expected {} constants, but {} are provided",
+                                            data_size_, constants_.size()));
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorGTPublicGarbler created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorGTPublicGarbler::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorGTPublicGarbler::evaluate_setup start", gate_id_));
+    }
+  }
+
+  input_->wait_setup();
+
+  ENCRYPTO::block128_vector garbled_tables(compute_gt_public_tables_size(constants_, bit_size_));
+  std::size_t tables_offset = 0;
+  std::size_t index = gate_id_;
+  gt_public_compute_keys(
+      output_->get_keys(), input_->get_keys(), constants_, bit_size_,
+      yao_provider_.get_shared_zero(), yao_provider_.get_global_offset(),
+      [this, &garbled_tables, &tables_offset, &index](const auto& keys_a, const auto& keys_b,
+                                                      auto& keys_out) {
+        yao_provider_.create_garbled_tables(index, keys_a, keys_b,
+                                            garbled_tables.data() + tables_offset, keys_out);
+        tables_offset += 2 * keys_a.size();
+        index += keys_a.size();
+      });
+  assert(tables_offset == garbled_tables.size());
+  yao_provider_.send_blocks_message(gate_id_, std::move(garbled_tables));
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorGTPublicGarbler::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+YaoTensorGTPublicEvaluator::YaoTensorGTPublicEvaluator(std::size_t gate_id,
+                                                       YaoProvider& yao_provider,
+                                                       const YaoTensorCP input,
+                                                       std::vector<std::uint64_t>&& constants)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      constants_(gt_public_flip_msbs(std::move(constants), bit_size_)),
+      input_(input),
+      output_(std::make_shared<YaoTensor>(input->get_dimensions(), 1)) {
+  if (constants_.size() != data_size_) {
+    throw std::invalid_argument(fmt::format("expected {} constants, but {} are provided",
+                                            data_size_, constants_.size()));
+  }
+  garbled_tables_future_ = yao_provider_.register_for_blocks_message(
+      gate_id, compute_gt_public_tables_size(constants_, bit_size_));
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorGTPublicEvaluator created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorGTPublicEvaluator::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorGTPublicEvaluator::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  const auto garbled_tables = garbled_tables_future_.get();
+  std::size_t tables_offset = 0;
+  std::size_t index = gate_id_;
+  gt_public_compute_keys(
+      output_->get_keys(), input_->get_keys(), constants_, bit_size_,
+      yao_provider_.get_shared_zero(), ENCRYPTO::block128_t::make_zero(),
+      [this, &garbled_tables, &tables_offset, &index](const auto& keys_a, const auto& keys_b,
+                                                      auto& keys_out) {
+        yao_provider_.evaluate_garbled_tables(index, keys_a, keys_b,
+                                              garbled_tables.data() + tables_offset, keys_out);
+        tables_offset += 2 * keys_a.size();
+        index += keys_a.size();
+      });
+  assert(tables_offset == garbled_tables.size());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorGTPublicEvaluator::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+// Clip
+
+static std::vector<std::uint64_t> clip_make_constants(std::uint64_t min, std::uint64_t max,
+                                                      std::size_t bit_size,
+                                                      std::size_t data_size) {
+  tensor::check_clip_range(min, max, bit_size);
+  std::vector<std::uint64_t> constants(2 * data_size, min);
+  std::fill_n(std::begin(constants) + data_size, data_size, max);
+  return gt_public_flip_msbs(std::move(constants), bit_size);
+}
+
+// number of blocks sent by the garbler of the clip gate
+static std::size_t compute_clip_tables_size(const std::vector<std::uint64_t>& constants,
+                                            std::size_t bit_size) {
+  return compute_gt_public_tables_size(constants, bit_size) + constants.size() * bit_size;
+}
+
+// Computes the keys of
+//   y = (s AND x) XOR (NOT (x > min) AND min) XOR ((x > max) AND max)
+// with s = (x > min) XOR (x > max), where the ANDs with the public min and max
+// are free.
+template <typename F>
+static void clip_compute_keys(ENCRYPTO::block128_vector& output_keys,
+                              const ENCRYPTO::block128_vector& input_keys, std::uint64_t min,
+                              std::uint64_t max, const std::vector<std::uint64_t>& constants,
+                              std::size_t bit_size, ENCRYPTO::block128_t zero_key,
+                              ENCRYPTO::block128_t not_offset, F and_op) {
+  const auto data_size = constants.size() / 2;
+  const auto num_keys = bit_size * data_size;
+
+  ENCRYPTO::block128_vector cmp_keys;
+  {
+    ENCRYPTO::block128_vector cmp_input_keys(2 * num_keys);
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      const auto src = std::begin(input_keys) + bit_j * data_size;
+      const auto dst = std::begin(cmp_input_keys) + 2 * bit_j * data_size;
+      std::copy_n(src, data_size, dst);
+      std::copy_n(src, data_size, dst + data_size);
+    }
+    gt_public_compute_keys(cmp_keys, cmp_input_keys, constants, bit_size, zero_key, not_offset,
+                           and_op);
+  }
+
+  ENCRYPTO::block128_vector select_keys(num_keys);
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+      select_keys[bit_j * data_size + int_i] = cmp_keys[int_i] ^ cmp_keys[data_size + int_i];
+    }
+  }
+  and_op(select_keys, input_keys, output_keys);
+
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    const bool min_bit = (min >> bit_j) & 1;
+    const bool max_bit = (max >> bit_j) & 1;
+    for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+      auto& key = output_keys[bit_j * data_size + int_i];
+      if (min_bit) {
+        key ^= cmp_keys[int_i] ^ not_offset;
+      }
+      if (max_bit) {
+        key ^= cmp_keys[data_size + int_i];
+      }
+    }
+  }
+}
+
+YaoTensorClipGarbler::YaoTensorClipGarbler(std::size_t gate_id, YaoProvider& yao_provider,
+                                           const YaoTensorCP input, std::uint64_t min,
+                                           std::uint64_t max)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      min_(min),
+      max_(max),
+      constants_(clip_make_constants(min_, max_, bit_size_, data_size_)),
+      input_(input),
+      output_(std::make_shared<YaoTensor>(input->get_dimensions(), bit_size_)) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorClipGarbler created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorClipGarbler::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorClipGarbler::evaluate_setup start", gate_id_));
+    }
+  }
+
+  input_->wait_setup();
+
+  ENCRYPTO::block128_vector garbled_tables(compute_clip_tables_size(constants_, bit_size_));
+  std::size_t tables_offset = 0;
+  std::size_t index = gate_id_;
+  clip_compute_keys(
+      output_->get_keys(), input_->get_keys(), min_, max_, constants_, bit_size_,
+      yao_provider_.get_shared_zero(), yao_provider_.get_global_offset(),
+      [this, &garbled_tables, &tables_offset, &index](const auto& keys_a, const auto& keys_b,
+                                                      auto& keys_out) {
+        yao_provider_.create_garbled_tables(index, keys_a, keys_b,
+                                            garbled_tables.data() + tables_offset, keys_out);
+        tables_offset += 2 * keys_a.size();
+        index += keys_a.size();
+      });
+  assert(tables_offset == garbled_tables.size());
+  yao_provider_.send_blocks_message(gate_id_, std::move(garbled_tables));
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorClipGarbler::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+YaoTensorClipEvaluator::YaoTensorClipEvaluator(std::size_t gate_id, YaoProvider& yao_provider,
+                                               const YaoTensorCP input, std::uint64_t min,
+                                               std::uint64_t max)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      min_(min),
+      max_(max),
+      constants_(clip_make_constants(min_, max_, bit_size_, data_size_)),
+      input_(input),
+      output_(std::make_shared<YaoTensor>(input->get_dimensions(), bit_size_)) {
+  garbled_tables_future_ = yao_provider_.register_for_blocks_message(
+      gate_id, compute_clip_tables_size(constants_, bit_size_));
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorClipEvaluator created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorClipEvaluator::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorClipEvaluator::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  const auto garbled_tables = garbled_tables_future_.get();
+  std::size_t tables_offset = 0;
+  std::size_t index = gate_id_;
+  clip_compute_keys(
+      output_->get_keys(), input_->get_keys(), min_, max_, constants_, bit_size_,
+      yao_provider_.get_shared_zero(), ENCRYPTO::block128_t::make_zero(),
+      [this, &garbled_tables, &tables_offset, &index](const auto& keys_a, const auto& keys_b,
+                                                      auto& keys_out) {
+        yao_provider_.evaluate_garbled_tables(index, keys_a, keys_b,
+                                              garbled_tables.data() + tables_offset, keys_out);
+        tables_offset += 2 * keys_a.size();
+        index += keys_a.size();
+      });
+  assert(tables_offset == garbled_tables.size());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorClipEvaluator::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+// Sort
+
+static std::size_t compute_total_data_size(const std::vector<YaoTensorCP>& inputs) {
+  return std::transform_reduce(
+      std::begin(inputs), std::end(inputs), std::size_t(0), std::plus{},
+      [](const auto& input) { return input->get_dimensions().get_data_size(); });
+}
+
+static tensor::TensorDimensions compute_sort_output_dims(const std::vector<YaoTensorCP>& inputs) {
+  if (inputs.size() == 1) {
+    return inputs[0]->get_dimensions();
+  }
+  return {.batch_size_ = 1,
+          .num_channels_ = 1,
+          .height_ = 1,
+          .width_ = compute_total_data_size(inputs)};
+}
+
+// The garbler of the sorting and join gates sends the tables of each layer of
+// the sorting network, and of the final selection circuit, as a separate
+// message.  Hence, it never holds more than one layer of tables, and the
+// evaluator registers one future per message.
+static std::vector<ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector>>
+register_for_network_tables(YaoProvider& yao_provider, std::size_t gate_id,
+                            const BitonicSortingNetwork& sorting_network,
+                            const ENCRYPTO::AlgorithmDescription& cmpswap_algo,
+                            const ENCRYPTO::AlgorithmDescription* select_algo) {
+  const auto num_and_gates_cmpswap = count_and_gates(cmpswap_algo);
+  const auto num_layers = sorting_network.get_num_layers();
+  std::vector<ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector>> futures;
+  futures.reserve(num_layers + 1);
+  for (std::size_t layer_i = 0; layer_i < num_layers; ++layer_i) {
+    futures.emplace_back(yao_provider.register_for_blocks_message(
+        gate_id, 2 * num_and_gates_cmpswap * sorting_network.get_layer_size(layer_i),
+        futures.size()));
+  }
+  const auto data_size = sorting_network.get_num_elements();
+  if (select_algo != nullptr && data_size > 1) {
+    futures.emplace_back(yao_provider.register_for_blocks_message(
+        gate_id, 2 * count_and_gates(*select_algo) * (data_size - 1), futures.size()));
+  }
+  return futures;
+}
+
+namespace {
+
+// Garbles one SIMD circuit per call and sends its tables right away.
+struct NetworkLayerGarbler {
+  YaoProvider& yao_provider;
+  const std::size_t gate_id;
+  // each AND gate consumes one index, so advance it for every circuit
+  std::size_t index;
+  std::size_t msg_num = 0;
+
+  void operator()(const ENCRYPTO::AlgorithmDescription& algo, std::size_t num_simd,
+                  const ENCRYPTO::block128_vector& in_keys_a,
+                  const ENCRYPTO::block128_vector& in_keys_b,
+                  ENCRYPTO::block128_vector& out_keys) {
+    ENCRYPTO::block128_vector tables;
+    yao_provider.create_garbled_circuit(index, num_simd, algo, in_keys_a, in_keys_b, tables,
+                                        out_keys, true);
+    index += tables.size() / 2;
+    yao_provider.send_blocks_message(gate_id, std::move(tables), msg_num++);
+  }
+};
+
+// Evaluates one SIMD circuit per call with the tables of the next message.
+struct NetworkLayerEvaluator {
+  YaoProvider& yao_provider;
+  std::vector<ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector>>& futures;
+  std::size_t index;
+  std::size_t msg_num = 0;
+
+  void operator()(const ENCRYPTO::AlgorithmDescription& algo, std::size_t num_simd,
+                  const ENCRYPTO::block128_vector& in_keys_a,
+                  const ENCRYPTO::block128_vector& in_keys_b,
+                  ENCRYPTO::block128_vector& out_keys) {
+    const auto tables = futures.at(msg_num++).get();
+    yao_provider.evaluate_garbled_circuit(index, num_simd, algo, in_keys_a, in_keys_b, tables,
+                                          out_keys, true);
+    index += tables.size() / 2;
+  }
+};
+
+}  // namespace
+
+// concatenates the keys of the inputs which are all stored bit by bit
+static void concatenate_keys(ENCRYPTO::block128_vector& dst,
+                             const std::vector<YaoTensorCP>& inputs, std::size_t bit_size,
+                             std::size_t data_size) {
+  dst.resize(bit_size * data_size);
+  std::size_t offset = 0;
+  for (const auto& input : inputs) {
+    const auto input_size = input->get_dimensions().get_data_size();
+    const auto& keys = input->get_keys();
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      std::copy_n(keys.data() + bit_j * input_size, input_size,
+                  dst.data() + bit_j * data_size + offset);
+    }
+    offset += input_size;
+  }
+}
+
+// Gathers the inputs of each layer of comparators, hands them to circuit
+// (which garbles or evaluates cmpswap_algo), and scatters the outputs back.
+template <typename F>
+static void apply_sorting_network(const BitonicSortingNetwork& sorting_network,
+                                  std::size_t bit_size, ENCRYPTO::block128_vector& keys,
+                                  F& circuit, const ENCRYPTO::AlgorithmDescription& cmpswap_algo) {
+  const auto data_size = sorting_network.get_num_elements();
+  std::vector<BitonicSortingNetwork::Comparator> layer;
+  ENCRYPTO::block128_vector in_keys_a;
+  ENCRYPTO::block128_vector in_keys_b;
+  ENCRYPTO::block128_vector out_keys;
+  for (std::size_t layer_i = 0; layer_i < sorting_network.get_num_layers(); ++layer_i) {
+    sorting_network.get_layer(layer, layer_i);
+    const auto layer_size = layer.size();
+    in_keys_a.resize(bit_size * layer_size);
+    in_keys_b.resize(bit_size * layer_size);
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      for (std::size_t k = 0; k < layer_size; ++k) {
+        in_keys_a[bit_j * layer_size + k] = keys[bit_j * data_size + layer[k].first];
+        in_keys_b[bit_j * layer_size + k] = keys[bit_j * data_size + layer[k].second];
+      }
+    }
+    circuit(cmpswap_algo, layer_size, in_keys_a, in_keys_b, out_keys);
+    // the first bit_size output wires contain the minimum, the others the maximum
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      for (std::size_t k = 0; k < layer_size; ++k) {
+        keys[bit_j * data_size + layer[k].first] = out_keys[bit_j * layer_size + k];
+        keys[bit_j * data_size + layer[k].second] =
+            out_keys[(bit_size + bit_j) * layer_size + k];
+      }
+    }
+  }
+}
+
+// Pairs each element with its successor, hands them to circuit (which garbles
+// or evaluates select_algo), and writes the outputs (output_bit_size wires per
+// pair) to dst.  The last element has no successor and becomes the constant 0
+// with the shared zero key.
+template <typename F>
+static void apply_duplicate_selection(ENCRYPTO::block128_vector& dst,
+                                      const ENCRYPTO::block128_vector& keys, std::size_t bit_size,
+                                      std::size_t output_bit_size, std::size_t data_size,
+                                      F& circuit, const ENCRYPTO::AlgorithmDescription& select_algo,
+                                      const ENCRYPTO::block128_t& zero_key) {
+  dst.resize(output_bit_size * data_size);
+  std::fill(std::begin(dst), std::end(dst), zero_key);
+  if (data_size < 2) {
+    return;
+  }
+  const auto num_pairs = data_size - 1;
+  ENCRYPTO::block128_vector in_keys_a(bit_size * num_pairs);
+  ENCRYPTO::block128_vector in_keys_b(bit_size * num_pairs);
+  ENCRYPTO::block128_vector out_keys;
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    std::copy_n(keys.data() + bit_j * data_size, num_pairs, in_keys_a.data() + bit_j * num_pairs);
+    std::copy_n(keys.data() + bit_j * data_size + 1, num_pairs,
+                in_keys_b.data() + bit_j * num_pairs);
+  }
+  circuit(select_algo, num_pairs, in_keys_a, in_keys_b, out_keys);
+  for (std::size_t bit_j = 0; bit_j < output_bit_size; ++bit_j) {
+    std::copy_n(out_keys.data() + bit_j * num_pairs, num_pairs, dst.data() + bit_j * data_size);
+  }
+}
+
+// Sorts the keys and optionally selects the duplicates.  Shared by garbler and
+// evaluator which differ only in circuit.
+template <typename F>
+static void sort_compute_keys(ENCRYPTO::block128_vector& output_keys,
+                              ENCRYPTO::block128_vector& keys,
+                              const BitonicSortingNetwork& sorting_network, std::size_t bit_size,
+                              bool select_duplicates, F& circuit,
+                              const ENCRYPTO::AlgorithmDescription& cmpswap_algo,
+                              const ENCRYPTO::AlgorithmDescription& eq_select_algo,
+                              const ENCRYPTO::block128_t& zero_key) {
+  apply_sorting_network(sorting_network, bit_size, keys, circuit, cmpswap_algo);
+  if (select_duplicates) {
+    apply_duplicate_selection(output_keys, keys, bit_size, bit_size,
+                              sorting_network.get_num_elements(), circuit, eq_select_algo,
+                              zero_key);
+  } else {
+    output_keys = std::move(keys);
+  }
+}
+
+YaoTensorSortGarbler::YaoTensorSortGarbler(std::size_t gate_id, YaoProvider& yao_provider,
+                                           std::vector<YaoTensorCP> inputs,
+                                           bool select_duplicates)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(inputs.at(0)->get_bit_size()),
+      data_size_(compute_total_data_size(inputs)),
+      select_duplicates_(select_duplicates),
+      inputs_(std::move(inputs)),
+      output_(std::make_shared<YaoTensor>(compute_sort_output_dims(inputs_), bit_size_)),
+      sorting_network_(data_size_),
+      cmpswap_algo_(yao_provider_.get_circuit_loader().load_cmpswap_circuit(bit_size_)),
+      eq_select_algo_(yao_provider_.get_circuit_loader().load_eq_select_circuit(bit_size_)) {
+  output_->get_keys().resize(data_size_ * bit_size_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorSortGarbler created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorSortGarbler::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorSortGarbler::evaluate_setup start", gate_id_));
+    }
+  }
+
+  for (const auto& input : inputs_) {
+    input->wait_setup();
+  }
+
+  ENCRYPTO::block128_vector keys;
+  concatenate_keys(keys, inputs_, bit_size_, data_size_);
+  NetworkLayerGarbler garble{yao_provider_, gate_id_, gate_id_};
+  sort_compute_keys(output_->get_keys(), keys, sorting_network_, bit_size_, select_duplicates_,
+                    garble, cmpswap_algo_, eq_select_algo_, yao_provider_.get_shared_zero());
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorSortGarbler::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+YaoTensorSortEvaluator::YaoTensorSortEvaluator(std::size_t gate_id, YaoProvider& yao_provider,
+                                               std::vector<YaoTensorCP> inputs,
+                                               bool select_duplicates)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(inputs.at(0)->get_bit_size()),
+      data_size_(compute_total_data_size(inputs)),
+      select_duplicates_(select_duplicates),
+      inputs_(std::move(inputs)),
+      output_(std::make_shared<YaoTensor>(compute_sort_output_dims(inputs_), bit_size_)),
+      sorting_network_(data_size_),
+      cmpswap_algo_(yao_provider_.get_circuit_loader().load_cmpswap_circuit(bit_size_)),
+      eq_select_algo_(yao_provider_.get_circuit_loader().load_eq_select_circuit(bit_size_)) {
+  garbled_tables_futures_ = register_for_network_tables(
+      yao_provider_, gate_id, sorting_network_, cmpswap_algo_,
+      select_duplicates_ ? &eq_select_algo_ : nullptr);
+  output_->get_keys().resize(data_size_ * bit_size_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorSortEvaluator created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorSortEvaluator::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorSortEvaluator::evaluate_online start", gate_id_));
+    }
+  }
+
+  for (const auto& input : inputs_) {
+    input->wait_online();
+  }
+
+  ENCRYPTO::block128_vector keys;
+  concatenate_keys(keys, inputs_, bit_size_, data_size_);
+  NetworkLayerEvaluator evaluate{yao_provider_, garbled_tables_futures_, gate_id_};
+  sort_compute_keys(output_->get_keys(), keys, sorting_network_, bit_size_, select_duplicates_,
+                    evaluate, cmpswap_algo_, eq_select_algo_, yao_provider_.get_shared_zero());
+  assert(evaluate.msg_num == garbled_tables_futures_.size());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorSortEvaluator::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+// Join
+
+static std::size_t check_join_inputs(const YaoTensorCP& keys_A, const YaoTensorCP& payload_A,
+                                     const YaoTensorCP& keys_B, const YaoTensorCP& payload_B) {
+  if (keys_A->get_bit_size() != keys_B->get_bit_size() ||
+      payload_A->get_bit_size() != payload_B->get_bit_size()) {
+    throw std::invalid_argument("join: bit size mismatch");
+  }
+  const auto data_size_A = keys_A->get_dimensions().get_data_size();
+  const auto data_size_B = keys_B->get_dimensions().get_data_size();
+  if (payload_A->get_dimensions().get_data_size() != data_size_A ||
+      payload_B->get_dimensions().get_data_size() != data_size_B) {
+    throw std::invalid_argument("join: need one payload per key");
+  }
+  return data_size_A + data_size_B;
+}
+
+static std::vector<YaoTensorP> make_join_outputs(std::size_t key_bit_size,
+                                                 std::size_t payload_bit_size,
+                                                 std::size_t data_size) {
+  const tensor::TensorDimensions dims{
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = data_size};
+  return {std::make_shared<YaoTensor>(dims, key_bit_size),
+          std::make_shared<YaoTensor>(dims, payload_bit_size),
+          std::make_shared<YaoTensor>(dims, payload_bit_size)};
+}
+
+// Builds the records (payload, tag, key) of A || B bit by bit, where the tag
+// is the constant 0 (with key zero_key) for A and the constant 1 (with key
+// one_key) for B.
+static void join_make_records(ENCRYPTO::block128_vector& records,
+                              const std::vector<YaoTensorCP>& keys,
+                              const std::vector<YaoTensorCP>& payloads,
+                              std::size_t key_bit_size, std::size_t payload_bit_size,
+                              std::size_t data_size, const ENCRYPTO::block128_t& zero_key,
+                              const ENCRYPTO::block128_t& one_key) {
+  ENCRYPTO::block128_vector key_keys;
+  ENCRYPTO::block128_vector payload_keys;
+  concatenate_keys(key_keys, keys, key_bit_size, data_size);
+  concatenate_keys(payload_keys, payloads, payload_bit_size, data_size);
+  records.resize((payload_bit_size + 1 + key_bit_size) * data_size);
+  std::copy(std::begin(payload_keys), std::end(payload_keys), records.data());
+  const auto tag_offset = payload_bit_size * data_size;
+  const auto data_size_A = keys[0]->get_dimensions().get_data_size();
+  std::fill_n(records.data() + tag_offset, data_size_A, zero_key);
+  std::fill_n(records.data() + tag_offset + data_size_A, data_size - data_size_A, one_key);
+  std::copy(std::begin(key_keys), std::end(key_keys), records.data() + tag_offset + data_size);
+}
+
+// Sorts the records, selects the matches, and splits them into the outputs.
+// Shared by garbler and evaluator which differ only in circuit.
+template <typename F>
+static void join_compute_keys(const std::vector<YaoTensorP>& outputs,
+                              ENCRYPTO::block128_vector& records,
+                              const BitonicSortingNetwork& sorting_network,
+                              std::size_t key_bit_size, std::size_t payload_bit_size, F& circuit,
+                              const ENCRYPTO::AlgorithmDescription& cmpswap_algo,
+                              const ENCRYPTO::AlgorithmDescription& join_select_algo,
+                              const ENCRYPTO::block128_t& zero_key) {
+  const auto data_size = sorting_network.get_num_elements();
+  const auto record_bit_size = payload_bit_size + 1 + key_bit_size;
+  const auto output_bit_size = key_bit_size + 2 * payload_bit_size;
+  apply_sorting_network(sorting_network, record_bit_size, records, circuit, cmpswap_algo);
+  ENCRYPTO::block128_vector selected_keys;
+  apply_duplicate_selection(selected_keys, records, record_bit_size, output_bit_size, data_size,
+                            circuit, join_select_algo, zero_key);
+  auto it = std::begin(selected_keys);
+  for (std::size_t output_i = 0; output_i < 3; ++output_i) {
+    const auto num_keys = (output_i == 0 ? key_bit_size : payload_bit_size) * data_size;
+    auto& output_keys = outputs[output_i]->get_keys();
+    output_keys.resize(num_keys);
+    std::copy_n(it, num_keys, output_keys.data());
+    it += num_keys;
+  }
+}
+
+YaoTensorJoinGarbler::YaoTensorJoinGarbler(std::size_t gate_id, YaoProvider& yao_provider,
+                                           const YaoTensorCP keys_A, const YaoTensorCP payload_A,
+                                           const YaoTensorCP keys_B, const YaoTensorCP payload_B)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      key_bit_size_(keys_A->get_bit_size()),
+      payload_bit_size_(payload_A->get_bit_size()),
+      data_size_(check_join_inputs(keys_A, payload_A, keys_B, payload_B)),
+      keys_({keys_A, keys_B}),
+      payloads_({payload_A, payload_B}),
+      outputs_(make_join_outputs(key_bit_size_, payload_bit_size_, data_size_)),
+      sorting_network_(data_size_),
+      cmpswap_algo_(yao_provider_.get_circuit_loader().load_cmpswap_circuit(
+          payload_bit_size_ + 1 + key_bit_size_)),
+      join_select_algo_(yao_provider_.get_circuit_loader().load_join_select_circuit(
+          key_bit_size_, payload_bit_size_)) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorJoinGarbler created", gate_id_));
+    }
+  }
+}
+
+std::vector<YaoTensorCP> YaoTensorJoinGarbler::get_output_tensors() const {
+  return {std::begin(outputs_), std::end(outputs_)};
+}
+
+void YaoTensorJoinGarbler::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorJoinGarbler::evaluate_setup start", gate_id_));
+    }
+  }
+
+  for (const auto& input : keys_) {
+    input->wait_setup();
+  }
+  for (const auto& input : payloads_) {
+    input->wait_setup();
+  }
+
+  const auto zero_key = yao_provider_.get_shared_zero();
+  ENCRYPTO::block128_vector records;
+  join_make_records(records, keys_, payloads_, key_bit_size_, payload_bit_size_, data_size_,
+                    zero_key, zero_key ^ yao_provider_.get_global_offset());
+  NetworkLayerGarbler garble{yao_provider_, gate_id_, gate_id_};
+  join_compute_keys(outputs_, records, sorting_network_, key_bit_size_, payload_bit_size_, garble,
+                    cmpswap_algo_, join_select_algo_, zero_key);
+  for (auto& output : outputs_) {
+    output->set_setup_ready();
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorJoinGarbler::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+YaoTensorJoinEvaluator::YaoTensorJoinEvaluator(std::size_t gate_id, YaoProvider& yao_provider,
+                                               const YaoTensorCP keys_A,
+                                               const YaoTensorCP payload_A,
+                                               const YaoTensorCP keys_B,
+                                               const YaoTensorCP payload_B)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      key_bit_size_(keys_A->get_bit_size()),
+      payload_bit_size_(payload_A->get_bit_size()),
+      data_size_(check_join_inputs(keys_A, payload_A, keys_B, payload_B)),
+      keys_({keys_A, keys_B}),
+      payloads_({payload_A, payload_B}),
+      outputs_(make_join_outputs(key_bit_size_, payload_bit_size_, data_size_)),
+      sorting_network_(data_size_),
+      cmpswap_algo_(yao_provider_.get_circuit_loader().load_cmpswap_circuit(
+          payload_bit_size_ + 1 + key_bit_size_)),
+      join_select_algo_(yao_provider_.get_circuit_loader().load_join_select_circuit(
+          key_bit_size_, payload_bit_size_)) {
+  garbled_tables_futures_ = register_for_network_tables(yao_provider_, gate_id, sorting_network_,
+                                                        cmpswap_algo_, &join_select_algo_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorJoinEvaluator created", gate_id_));
+    }
+  }
+}
+
+std::vector<YaoTensorCP> YaoTensorJoinEvaluator::get_output_tensors() const {
+  return {std::begin(outputs_), std::end(outputs_)};
+}
+
+void YaoTensorJoinEvaluator::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorJoinEvaluator::evaluate_online start", gate_id_));
+    }
+  }
+
+  for (const auto& input : keys_) {
+    input->wait_online();
+  }
+  for (const auto& input : payloads_) {
+    input->wait_online();
+  }
+
+  // the evaluator holds the shared zero key for every constant
+  const auto zero_key = yao_provider_.get_shared_zero();
+  ENCRYPTO::block128_vector records;
+  join_make_records(records, keys_, payloads_, key_bit_size_, payload_bit_size_, data_size_,
+                    zero_key, zero_key);
+  NetworkLayerEvaluator evaluate{yao_provider_, garbled_tables_futures_, gate_id_};
+  join_compute_keys(outputs_, records, sorting_network_, key_bit_size_, payload_bit_size_,
+                    evaluate, cmpswap_algo_, join_select_algo_, zero_key);
+  assert(evaluate.msg_num == garbled_tables_futures_.size());
+  for (auto& output : outputs_) {
+    output->set_online_ready();
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorJoinEvaluator::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+// Bucketize
+
+static tensor::TensorDimensions compute_bucketize_output_dims(
+    std::size_t bit_size, std::size_t data_size, const std::vector<std::uint64_t>& bucket_bounds) {
+  if (bucket_bounds.size() < 2) {
+    throw std::invalid_argument("at least two bucket bounds are required");
+  }
+  if (std::adjacent_find(std::begin(bucket_bounds), std::end(bucket_bounds),
+                         std::greater_equal{}) != std::end(bucket_bounds)) {
+    throw std::invalid_argument("bucket bounds need to be strictly increasing");
+  }
+  if (bit_size < 64 && bucket_bounds.back() >> bit_size) {
+    throw std::invalid_argument(
+        fmt::format("bucket bound {} exceeds the bit size {}", bucket_bounds.back(), bit_size));
+  }
+  return {.batch_size_ = 1,
+          .num_channels_ = bucket_bounds.size() - 1,
+          .height_ = 1,
+          .width_ = data_size};
+}
+
+// Arranges the keys for comparing each bound with each element: the first
+// input holds the bounds as constant keys, i.e., zero or the key of 1, and the
+// second input holds copies of the input keys.
+static void bucketize_rearrange_keys_in(ENCRYPTO::block128_vector& keys_a,
+                                        ENCRYPTO::block128_vector& keys_b,
+                                        const ENCRYPTO::block128_vector& input_keys,
+                                        std::size_t bit_size, std::size_t data_size,
+                                        const std::vector<std::uint64_t>& bucket_bounds,
+                                        const ENCRYPTO::block128_t& one_key) {
+  const auto num_bounds = bucket_bounds.size();
+  const auto num_simd = num_bounds * data_size;
+  keys_a = ENCRYPTO::block128_vector::make_zero(bit_size * num_simd);
+  keys_b.resize(bit_size * num_simd);
+  for (std::size_t bit_i = 0; bit_i < bit_size; ++bit_i) {
+    for (std::size_t bound_j = 0; bound_j < num_bounds; ++bound_j) {
+      const auto offset = bit_i * num_simd + bound_j * data_size;
+      if ((bucket_bounds[bound_j] >> bit_i) & 1) {
+        std::fill_n(&keys_a[offset], data_size, one_key);
+      }
+      std::copy_n(&input_keys[bit_i * data_size], data_size, &keys_b[offset]);
+    }
+  }
+}
+
+// Computes bucket indicators from the comparison results b_j > x.  Only the
+// least significant bit is non-constant.
+static void bucketize_rearrange_keys_out(ENCRYPTO::block128_vector& output_keys,
+                                         const ENCRYPTO::block128_vector& gt_keys,
+                                         std::size_t bit_size, std::size_t data_size,
+                                         std::size_t num_buckets) {
+  output_keys = ENCRYPTO::block128_vector::make_zero(bit_size * num_buckets * data_size);
+  for (std::size_t i = 0; i < num_buckets * data_size; ++i) {
+    // [b_j <= x < b_(j+1)] = [b_(j+1) > x] ^ [b_j > x]
+    output_keys[i] = gt_keys[i + data_size] ^ gt_keys[i];
+  }
+}
+
+YaoTensorBucketizeGarbler::YaoTensorBucketizeGarbler(std::size_t gate_id,
+                                                     YaoProvider& yao_provider,
+                                                     const YaoTensorCP input,
+                                                     std::vector<std::uint64_t> bucket_bounds)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      bucket_bounds_(std::move(bucket_bounds)),
+      input_(input),
+      output_(std::make_shared<YaoTensor>(
+          compute_bucketize_output_dims(bit_size_, data_size_, bucket_bounds_), bit_size_)),
+      gt_algo_(yao_provider_.get_circuit_loader().load_gt_circuit(bit_size_)) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorBucketizeGarbler created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorBucketizeGarbler::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorBucketizeGarbler::evaluate_setup start", gate_id_));
+    }
+  }
+
+  input_->wait_setup();
+
+  // garble all comparisons at once
+  ENCRYPTO::block128_vector keys_a;
+  ENCRYPTO::block128_vector keys_b;
+  ENCRYPTO::block128_vector gt_keys;
+  bucketize_rearrange_keys_in(keys_a, keys_b, input_->get_keys(), bit_size_, data_size_,
+                              bucket_bounds_, yao_provider_.get_global_offset());
+  yao_provider_.create_garbled_circuit(gate_id_, bucket_bounds_.size() * data_size_, gt_algo_,
+                                       keys_a, keys_b, garbled_tables_, gt_keys, true);
+  yao_provider_.send_blocks_message(gate_id_, std::move(garbled_tables_));
+  bucketize_rearrange_keys_out(output_->get_keys(), gt_keys, bit_size_, data_size_,
+                               bucket_bounds_.size() - 1);
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorBucketizeGarbler::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+YaoTensorBucketizeEvaluator::YaoTensorBucketizeEvaluator(std::size_t gate_id,
+                                                         YaoProvider& yao_provider,
+                                                         const YaoTensorCP input,
+                                                         std::vector<std::uint64_t> bucket_bounds)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input->get_bit_size()),
+      data_size_(input->get_dimensions().get_data_size()),
+      bucket_bounds_(std::move(bucket_bounds)),
+      input_(input),
+      output_(std::make_shared<YaoTensor>(
+          compute_bucketize_output_dims(bit_size_, data_size_, bucket_bounds_), bit_size_)),
+      gt_algo_(yao_provider_.get_circuit_loader().load_gt_circuit(bit_size_)) {
+  garbled_tables_future_ = yao_provider_.register_for_blocks_message(
+      gate_id, 2 * count_and_gates(gt_algo_) * bucket_bounds_.size() * data_size_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorBucketizeEvaluator created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorBucketizeEvaluator::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorBucketizeEvaluator::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  // the evaluator holds the zero key for every constant
+  ENCRYPTO::block128_vector keys_a;
+  ENCRYPTO::block128_vector keys_b;
+  ENCRYPTO::block128_vector gt_keys;
+  bucketize_rearrange_keys_in(keys_a, keys_b, input_->get_keys(), bit_size_, data_size_,
+                              bucket_bounds_, ENCRYPTO::block128_t::make_zero());
+  const auto garbled_tables = garbled_tables_future_.get();
+  yao_provider_.evaluate_garbled_circuit(gate_id_, bucket_bounds_.size() * data_size_, gt_algo_,
+                                         keys_a, keys_b, garbled_tables, gt_keys, true);
+  bucketize_rearrange_keys_out(output_->get_keys(), gt_keys, bit_size_, data_size_,
+                               bucket_bounds_.size() - 1);
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorBucketizeEvaluator::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+// Tree ensemble
+
+static std::size_t compute_tree_ensemble_num_queries(const TreeEnsemble& model,
+                                                     const YaoTensorCP& features,
+                                                     const YaoTensorCP& thresholds) {
+  if (!model.verify()) {
+    throw std::invalid_argument("invalid tree ensemble");
+  }
+  if (features->get_bit_size() != thresholds->get_bit_size()) {
+    throw std::invalid_argument("features and thresholds need to have the same bit size");
+  }
+  const auto features_size = features->get_dimensions().get_data_size();
+  if (features_size == 0 || features_size % model.num_features_ != 0) {
+    throw std::invalid_argument(
+        fmt::format("feature tensor of size {} does not contain queries of {} features",
+                    features_size, model.num_features_));
+  }
+  if (thresholds->get_dimensions().get_data_size() != model.get_num_internal_nodes()) {
+    throw std::invalid_argument(
+        fmt::format("expected {} thresholds, got {}", model.get_num_internal_nodes(),
+                    thresholds->get_dimensions().get_data_size()));
+  }
+  return features_size / model.num_features_;
+}
+
+static tensor::TensorDimensions compute_tree_ensemble_output_dims(const TreeEnsemble& model,
+                                                                  std::size_t num_queries) {
+  return {.batch_size_ = 1,
+          .num_channels_ = 1,
+          .height_ = model.get_num_leaves(),
+          .width_ = num_queries};
+}
+
+static std::size_t compute_tree_ensemble_tables_size(const ENCRYPTO::AlgorithmDescription& gt_algo,
+                                                     const std::vector<std::size_t>& depths,
+                                                     std::size_t num_queries) {
+  std::size_t num_internal_nodes = 0;
+  std::size_t num_path_and_gates = 0;
+  for (auto depth : depths) {
+    num_internal_nodes += (std::size_t(1) << depth) - 1;
+    // the indicators of the root's children are free
+    num_path_and_gates += (std::size_t(1) << depth) - 2;
+  }
+  return 2 * num_queries * (count_and_gates(gt_algo) * num_internal_nodes + num_path_and_gates);
+}
+
+// Arranges the keys for comparing the feature of each internal node with its
+// threshold for each query, i.e., SIMD index m * num_queries + q corresponds
+// to node m and query q.
+static void tree_ensemble_rearrange_keys_in(ENCRYPTO::block128_vector& keys_a,
+                                            ENCRYPTO::block128_vector& keys_b,
+                                            const ENCRYPTO::block128_vector& feature_keys,
+                                            const ENCRYPTO::block128_vector& threshold_keys,
+                                            const std::vector<std::size_t>& node_feature_indices,
+                                            std::size_t bit_size, std::size_t num_features,
+                                            std::size_t num_queries) {
+  const auto num_nodes = node_feature_indices.size();
+  const auto num_simd = num_nodes * num_queries;
+  keys_a.resize(bit_size * num_simd);
+  keys_b.resize(bit_size * num_simd);
+  for (std::size_t bit_i = 0; bit_i < bit_size; ++bit_i) {
+    const auto* features_bit = &feature_keys[bit_i * num_queries * num_features];
+    for (std::size_t node_j = 0; node_j < num_nodes; ++node_j) {
+      const auto offset = bit_i * num_simd + node_j * num_queries;
+      const auto feature_index = node_feature_indices[node_j];
+      for (std::size_t query_k = 0; query_k < num_queries; ++query_k) {
+        keys_a[offset + query_k] = features_bit[query_k * num_features + feature_index];
+      }
+      std::fill_n(&keys_b[offset], num_queries, threshold_keys[bit_i * num_nodes + node_j]);
+    }
+  }
+}
+
+// Propagates the path indicators from the roots to the leaves given the
+// comparison results [x_f > t] of all nodes.  The indicator of the right child
+// is the AND of the node's indicator and its comparison result, and the one of
+// the left child is the XOR of both.  All ANDs of one level are passed to
+// and_op as a single batch.  The output holds one key per leaf and query.
+template <typename F>
+static void tree_ensemble_compute_leaf_indicators(ENCRYPTO::block128_vector& output_keys,
+                                                  const ENCRYPTO::block128_vector& gt_keys,
+                                                  const std::vector<std::size_t>& depths,
+                                                  std::size_t num_queries,
+                                                  const ENCRYPTO::block128_t& one_key,
+                                                  F&& and_op) {
+  const auto num_trees = depths.size();
+  std::vector<std::size_t> root_offsets(num_trees);
+  std::size_t max_depth = 0;
+  std::size_t num_leaves = 0;
+  for (std::size_t tree_i = 0, offset = 0; tree_i < num_trees; ++tree_i) {
+    root_offsets[tree_i] = offset;
+    offset += (std::size_t(1) << depths[tree_i]) - 1;
+    max_depth = std::max(max_depth, depths[tree_i]);
+    num_leaves += std::size_t(1) << depths[tree_i];
+  }
+
+  // the root's indicator is the constant 1, so its children are free
+  std::vector<ENCRYPTO::block128_vector> indicators(num_trees);
+  for (std::size_t tree_i = 0; tree_i < num_trees; ++tree_i) {
+    auto& ind = indicators[tree_i];
+    ind.resize(2 * num_queries);
+    const auto* gt_root = &gt_keys[root_offsets[tree_i] * num_queries];
+    for (std::size_t query_k = 0; query_k < num_queries; ++query_k) {
+      ind[query_k] = gt_root[query_k] ^ one_key;
+      ind[num_queries + query_k] = gt_root[query_k];
+    }
+  }
+
+  ENCRYPTO::block128_vector keys_a;
+  ENCRYPTO::block128_vector keys_b;
+  ENCRYPTO::block128_vector keys_out;
+  for (std::size_t level = 1; level < max_depth; ++level) {
+    const auto level_size = (std::size_t(1) << level) * num_queries;
+    std::size_t num_gates = 0;
+    for (auto depth : depths) {
+      num_gates += (depth > level) ? level_size : 0;
+    }
+    keys_a.resize(num_gates);
+    keys_b.resize(num_gates);
+    for (std::size_t tree_i = 0, offset = 0; tree_i < num_trees; ++tree_i) {
+      if (depths[tree_i] <= level) {
+        continue;
+      }
+      // the nodes of this level are stored contiguously
+      const auto level_offset =
+          (root_offsets[tree_i] + (std::size_t(1) << level) - 1) * num_queries;
+      std::copy_n(indicators[tree_i].data(), level_size, &keys_a[offset]);
+      std::copy_n(&gt_keys[level_offset], level_size, &keys_b[offset]);
+      offset += level_size;
+    }
+    and_op(keys_a, keys_b, keys_out);
+    for (std::size_t tree_i = 0, offset = 0; tree_i < num_trees; ++tree_i) {
+      if (depths[tree_i] <= level) {
+        continue;
+      }
+      const auto& ind = indicators[tree_i];
+      ENCRYPTO::block128_vector next_ind(2 * level_size);
+      for (std::size_t i = 0; i < level_size; ++i) {
+        const auto node_j = i / num_queries;
+        const auto query_k = i % num_queries;
+        const auto& right = keys_out[offset + i];
+        next_ind[(2 * node_j) * num_queries + query_k] = ind[i] ^ right;
+        next_ind[(2 * node_j + 1) * num_queries + query_k] = right;
+      }
+      indicators[tree_i] = std::move(next_ind);
+      offset += level_size;
+    }
+  }
+
+  output_keys.resize(num_leaves * num_queries);
+  for (std::size_t tree_i = 0, offset = 0; tree_i < num_trees; ++tree_i) {
+    std::copy_n(indicators[tree_i].data(), indicators[tree_i].size(), &output_keys[offset]);
+    offset += indicators[tree_i].size();
+  }
+}
+
+YaoTensorTreeEnsembleGarbler::YaoTensorTreeEnsembleGarbler(std::size_t gate_id,
+                                                           YaoProvider& yao_provider,
+                                                           const TreeEnsemble& model,
+                                                           const YaoTensorCP features,
+                                                           const YaoTensorCP thresholds)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(features->get_bit_size()),
+      num_features_(model.num_features_),
+      num_queries_(compute_tree_ensemble_num_queries(model, features, thresholds)),
+      depths_(model.get_depths()),
+      node_feature_indices_(model.get_node_feature_indices()),
+      features_(features),
+      thresholds_(thresholds),
+      output_(std::make_shared<YaoTensor>(compute_tree_ensemble_output_dims(model, num_queries_),
+                                          1)),
+      gt_algo_(yao_provider_.get_circuit_loader().load_gt_circuit(bit_size_)) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorTreeEnsembleGarbler created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorTreeEnsembleGarbler::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorTreeEnsembleGarbler::evaluate_setup start", gate_id_));
+    }
+  }
+
+  features_->wait_setup();
+  thresholds_->wait_setup();
+
+  ENCRYPTO::block128_vector garbled_tables(
+      compute_tree_ensemble_tables_size(gt_algo_, depths_, num_queries_));
+  std::size_t tables_offset = 0;
+
+  // garble the comparisons of all nodes at once
+  ENCRYPTO::block128_vector gt_keys;
+  {
+    ENCRYPTO::block128_vector keys_a;
+    ENCRYPTO::block128_vector keys_b;
+    ENCRYPTO::block128_vector tables;
+    tree_ensemble_rearrange_keys_in(keys_a, keys_b, features_->get_keys(),
+                                    thresholds_->get_keys(), node_feature_indices_, bit_size_,
+                                    num_features_, num_queries_);
+    yao_provider_.create_garbled_circuit(gate_id_, node_feature_indices_.size() * num_queries_,
+                                         gt_algo_, keys_a, keys_b, tables, gt_keys, true);
+    std::copy_n(tables.data(), tables.size(), garbled_tables.data());
+    tables_offset += tables.size();
+  }
+
+  // garble the path indicators level by level; the constant 1 is encoded
+  // relative to the shared zero key
+  std::size_t index = gate_id_ + tables_offset / 2;
+  tree_ensemble_compute_leaf_indicators(
+      output_->get_keys(), gt_keys, depths_, num_queries_,
+      yao_provider_.get_shared_zero() ^ yao_provider_.get_global_offset(),
+      [this, &garbled_tables, &tables_offset, &index](const auto& keys_a, const auto& keys_b,
+                                                      auto& keys_out) {
+        yao_provider_.create_garbled_tables(index, keys_a, keys_b,
+                                            garbled_tables.data() + tables_offset, keys_out);
+        tables_offset += 2 * keys_a.size();
+        index += keys_a.size();
+      });
+  assert(tables_offset == garbled_tables.size());
+  yao_provider_.send_blocks_message(gate_id_, std::move(garbled_tables));
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorTreeEnsembleGarbler::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+YaoTensorTreeEnsembleEvaluator::YaoTensorTreeEnsembleEvaluator(std::size_t gate_id,
+                                                               YaoProvider& yao_provider,
+                                                               const TreeEnsemble& model,
+                                                               const YaoTensorCP features,
+                                                               const YaoTensorCP thresholds)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(features->get_bit_size()),
+      num_features_(model.num_features_),
+      num_queries_(compute_tree_ensemble_num_queries(model, features, thresholds)),
+      depths_(model.get_depths()),
+      node_feature_indices_(model.get_node_feature_indices()),
+      features_(features),
+      thresholds_(thresholds),
+      output_(std::make_shared<YaoTensor>(compute_tree_ensemble_output_dims(model, num_queries_),
+                                          1)),
+      gt_algo_(yao_provider_.get_circuit_loader().load_gt_circuit(bit_size_)) {
+  garbled_tables_future_ = yao_provider_.register_for_blocks_message(
+      gate_id, compute_tree_ensemble_tables_size(gt_algo_, depths_, num_queries_));
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorTreeEnsembleEvaluator created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorTreeEnsembleEvaluator::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorTreeEnsembleEvaluator::evaluate_online start", gate_id_));
+    }
+  }
+
+  features_->wait_online();
+  thresholds_->wait_online();
+
+  const auto garbled_tables = garbled_tables_future_.get();
+  std::size_t tables_offset = 0;
+
+  // evaluate the comparisons of all nodes at once
+  ENCRYPTO::block128_vector gt_keys;
+  {
+    const auto num_simd = node_feature_indices_.size() * num_queries_;
+    const auto num_blocks = 2 * count_and_gates(gt_algo_) * num_simd;
+    ENCRYPTO::block128_vector keys_a;
+    ENCRYPTO::block128_vector keys_b;
+    ENCRYPTO::block128_vector tables(num_blocks, garbled_tables.data());
+    tree_ensemble_rearrange_keys_in(keys_a, keys_b, features_->get_keys(),
+                                    thresholds_->get_keys(), node_feature_indices_, bit_size_,
+                                    num_features_, num_queries_);
+    yao_provider_.evaluate_garbled_circuit(gate_id_, num_simd, gt_algo_, keys_a, keys_b, tables,
+                                           gt_keys, true);
+    tables_offset += num_blocks;
+  }
+
+  // evaluate the path indicators level by level; the evaluator holds the
+  // shared zero key as active key of the constant 1
+  std::size_t index = gate_id_ + tables_offset / 2;
+  tree_ensemble_compute_leaf_indicators(
+      output_->get_keys(), gt_keys, depths_, num_queries_, yao_provider_.get_shared_zero(),
+      [this, &garbled_tables, &tables_offset, &index](const auto& keys_a, const auto& keys_b,
+                                                      auto& keys_out) {
+        yao_provider_.evaluate_garbled_tables(index, keys_a, keys_b,
+                                              garbled_tables.data() + tables_offset, keys_out);
+        tables_offset += 2 * keys_a.size();
+        index += keys_a.size();
+      });
+  assert(tables_offset == garbled_tables.size());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorTreeEnsembleEvaluator::evaluate_online end", gate_id_));
+    }
+  }
+}
+
 }  // namespace MOTION::proto::yao
@@ -27,6 +27,7 @@
 #include "protocols/gmw/tensor.h"
 #include "tensor.h"
 #include "tensor/tensor_op.h"
+#include "tools.h"
 #include "utility/bit_vector.h"
 #include "utility/reusable_future.h"
 
@@ -40,6 +41,10 @@ class GOT128Sender;
 }  // namespace ObliviousTransfer
 }  // namespace ENCRYPTO
 
+namespace MOTION {
+struct TreeEnsemble;
+}  // namespace MOTION
+
 namespace MOTION::proto::yao {
 
 class YaoProvider;
@@ -438,4 +443,346 @@ class YaoTensorGTEvaluator : public NewGate {
   const ENCRYPTO::AlgorithmDescription& maxpool_algo_;
 };
 
+// elementwise A == B, the output tensor has bit size 1
+class YaoTensorEqGarbler : public NewGate {
+ public:
+  YaoTensorEqGarbler(std::size_t gate_id, YaoProvider&, const YaoTensorCP input_A,
+                     const YaoTensorCP input_B);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override {}
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const YaoTensorCP input_A_;
+  const YaoTensorCP input_B_;
+  const YaoTensorP output_;
+  ENCRYPTO::block128_vector garbled_tables_;
+  const ENCRYPTO::AlgorithmDescription& eq_algo_;
+};
+
+class YaoTensorEqEvaluator : public NewGate {
+ public:
+  YaoTensorEqEvaluator(std::size_t gate_id, YaoProvider&, const YaoTensorCP input_A,
+                       const YaoTensorCP input_B);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const YaoTensorCP input_A_;
+  const YaoTensorCP input_B_;
+  const YaoTensorP output_;
+  ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector> garbled_tables_future_;
+  const ENCRYPTO::AlgorithmDescription& eq_algo_;
+};
+
+// Elementwise signed comparison input > c with one public constant per
+// element, the output tensor has bit size 1.  Since c is known to both
+// parties, no keys need to be transferred for it, and only one AND is garbled
+// for each bit above the least significant zero bit of c.
+class YaoTensorGTPublicGarbler : public NewGate {
+ public:
+  YaoTensorGTPublicGarbler(std::size_t gate_id, YaoProvider&, const YaoTensorCP input,
+                           std::vector<std::uint64_t>&& constants);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override {}
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const std::vector<std::uint64_t> constants_;
+  const YaoTensorCP input_;
+  const YaoTensorP output_;
+};
+
+class YaoTensorGTPublicEvaluator : public NewGate {
+ public:
+  YaoTensorGTPublicEvaluator(std::size_t gate_id, YaoProvider&, const YaoTensorCP input,
+                             std::vector<std::uint64_t>&& constants);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const std::vector<std::uint64_t> constants_;
+  const YaoTensorCP input_;
+  const YaoTensorP output_;
+  ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector> garbled_tables_future_;
+};
+
+// Elementwise clipping of signed values to the public range [min, max].  The
+// comparisons x > min and x > max are garbled as one batch of GTPublic
+// circuits; selecting between x, min, and max then takes one AND per bit.
+class YaoTensorClipGarbler : public NewGate {
+ public:
+  YaoTensorClipGarbler(std::size_t gate_id, YaoProvider&, const YaoTensorCP input,
+                       std::uint64_t min, std::uint64_t max);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override {}
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const std::uint64_t min_;
+  const std::uint64_t max_;
+  // min for the first, max for the second half, with flipped MSBs
+  std::vector<std::uint64_t> constants_;
+  const YaoTensorCP input_;
+  const YaoTensorP output_;
+};
+
+class YaoTensorClipEvaluator : public NewGate {
+ public:
+  YaoTensorClipEvaluator(std::size_t gate_id, YaoProvider&, const YaoTensorCP input,
+                         std::uint64_t min, std::uint64_t max);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const std::uint64_t min_;
+  const std::uint64_t max_;
+  std::vector<std::uint64_t> constants_;
+  const YaoTensorCP input_;
+  const YaoTensorP output_;
+  ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector> garbled_tables_future_;
+};
+
+// Sorts the elements of the concatenation of all inputs in ascending order
+// with a bitonic sorting network.  Each layer of the network is garbled as a
+// single SIMD circuit and sent as a separate message; the rearrangement of the
+// keys between the layers is free.  If select_duplicates is set, each output
+// element is kept only if it equals its successor and is replaced by 0
+// otherwise.  For two inputs with pairwise distinct, non-zero elements this
+// yields their intersection.
+class YaoTensorSortGarbler : public NewGate {
+ public:
+  YaoTensorSortGarbler(std::size_t gate_id, YaoProvider&, std::vector<YaoTensorCP> inputs,
+                       bool select_duplicates);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override {}
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const bool select_duplicates_;
+  const std::vector<YaoTensorCP> inputs_;
+  const YaoTensorP output_;
+  const BitonicSortingNetwork sorting_network_;
+  const ENCRYPTO::AlgorithmDescription& cmpswap_algo_;
+  const ENCRYPTO::AlgorithmDescription& eq_select_algo_;
+};
+
+class YaoTensorSortEvaluator : public NewGate {
+ public:
+  YaoTensorSortEvaluator(std::size_t gate_id, YaoProvider&, std::vector<YaoTensorCP> inputs,
+                         bool select_duplicates);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const bool select_duplicates_;
+  const std::vector<YaoTensorCP> inputs_;
+  const YaoTensorP output_;
+  const BitonicSortingNetwork sorting_network_;
+  const ENCRYPTO::AlgorithmDescription& cmpswap_algo_;
+  const ENCRYPTO::AlgorithmDescription& eq_select_algo_;
+  // one message per layer of the network and one for the selection
+  std::vector<ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector>> garbled_tables_futures_;
+};
+
+// Join of two tables with pairwise distinct, non-zero keys and one payload
+// column each.  The records (payload, tag, key) of A || B are sorted with the
+// same network as YaoTensorSort* where the tag orders a record of A before a
+// record of B with the same key.  Each record whose key equals the key of its
+// successor yields (key, payload of A, payload of B), all other positions are
+// set to 0.
+class YaoTensorJoinGarbler : public NewGate {
+ public:
+  YaoTensorJoinGarbler(std::size_t gate_id, YaoProvider&, const YaoTensorCP keys_A,
+                       const YaoTensorCP payload_A, const YaoTensorCP keys_B,
+                       const YaoTensorCP payload_B);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override {}
+  // keys, payloads of A, payloads of B
+  std::vector<YaoTensorCP> get_output_tensors() const;
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t key_bit_size_;
+  const std::size_t payload_bit_size_;
+  const std::size_t data_size_;
+  const std::vector<YaoTensorCP> keys_;
+  const std::vector<YaoTensorCP> payloads_;
+  const std::vector<YaoTensorP> outputs_;
+  const BitonicSortingNetwork sorting_network_;
+  const ENCRYPTO::AlgorithmDescription& cmpswap_algo_;
+  const ENCRYPTO::AlgorithmDescription& join_select_algo_;
+};
+
+class YaoTensorJoinEvaluator : public NewGate {
+ public:
+  YaoTensorJoinEvaluator(std::size_t gate_id, YaoProvider&, const YaoTensorCP keys_A,
+                         const YaoTensorCP payload_A, const YaoTensorCP keys_B,
+                         const YaoTensorCP payload_B);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  std::vector<YaoTensorCP> get_output_tensors() const;
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t key_bit_size_;
+  const std::size_t payload_bit_size_;
+  const std::size_t data_size_;
+  const std::vector<YaoTensorCP> keys_;
+  const std::vector<YaoTensorCP> payloads_;
+  const std::vector<YaoTensorP> outputs_;
+  const BitonicSortingNetwork sorting_network_;
+  const ENCRYPTO::AlgorithmDescription& cmpswap_algo_;
+  const ENCRYPTO::AlgorithmDescription& join_select_algo_;
+  // one message per layer of the network and one for the selection
+  std::vector<ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector>> garbled_tables_futures_;
+};
+
+// One-hot bucket indicators w.r.t. public bucket bounds, cf.
+// TensorOpFactory::make_tensor_bucketize_op.  The comparisons of all elements
+// with all bounds are garbled as a single SIMD circuit where the bounds are
+// encoded as constant keys.  The indicator of bucket j is the XOR of the
+// comparison results for the bounds j and j + 1, which is free.
+class YaoTensorBucketizeGarbler : public NewGate {
+ public:
+  YaoTensorBucketizeGarbler(std::size_t gate_id, YaoProvider&, const YaoTensorCP input,
+                            std::vector<std::uint64_t> bucket_bounds);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override {}
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const std::vector<std::uint64_t> bucket_bounds_;
+  const YaoTensorCP input_;
+  const YaoTensorP output_;
+  ENCRYPTO::block128_vector garbled_tables_;
+  const ENCRYPTO::AlgorithmDescription& gt_algo_;
+};
+
+class YaoTensorBucketizeEvaluator : public NewGate {
+ public:
+  YaoTensorBucketizeEvaluator(std::size_t gate_id, YaoProvider&, const YaoTensorCP input,
+                              std::vector<std::uint64_t> bucket_bounds);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t data_size_;
+  const std::vector<std::uint64_t> bucket_bounds_;
+  const YaoTensorCP input_;
+  const YaoTensorP output_;
+  ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector> garbled_tables_future_;
+  const ENCRYPTO::AlgorithmDescription& gt_algo_;
+};
+
+// Leaf indicators of a tree ensemble with public structure, cf.
+// TensorOpFactory::make_tensor_tree_ensemble_op.  The comparisons of all
+// internal nodes with all queries are garbled as a single SIMD circuit.  Then
+// the path indicators are propagated level by level where each level of all
+// trees is garbled as one batch of AND gates.
+class YaoTensorTreeEnsembleGarbler : public NewGate {
+ public:
+  YaoTensorTreeEnsembleGarbler(std::size_t gate_id, YaoProvider&, const TreeEnsemble& model,
+                               const YaoTensorCP features, const YaoTensorCP thresholds);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override {}
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t num_features_;
+  const std::size_t num_queries_;
+  const std::vector<std::size_t> depths_;
+  const std::vector<std::size_t> node_feature_indices_;
+  const YaoTensorCP features_;
+  const YaoTensorCP thresholds_;
+  const YaoTensorP output_;
+  const ENCRYPTO::AlgorithmDescription& gt_algo_;
+};
+
+class YaoTensorTreeEnsembleEvaluator : public NewGate {
+ public:
+  YaoTensorTreeEnsembleEvaluator(std::size_t gate_id, YaoProvider&, const TreeEnsemble& model,
+                                 const YaoTensorCP features, const YaoTensorCP thresholds);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t num_features_;
+  const std::size_t num_queries_;
+  const std::vector<std::size_t> depths_;
+  const std::vector<std::size_t> node_feature_indices_;
+  const YaoTensorCP features_;
+  const YaoTensorCP thresholds_;
+  const YaoTensorP output_;
+  const ENCRYPTO::AlgorithmDescription& gt_algo_;
+  ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector> garbled_tables_future_;
+};
+
 }  // namespace MOTION::proto::yao
@@ -22,9 +22,12 @@
 
 #include "tools.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <unsupported/Eigen/CXX11/Tensor>
 
+#include <fmt/format.h>
+
 #include "tensor/tensor_op.h"
 
 namespace MOTION::proto::yao {
@@ -104,4 +107,59 @@ void maxpool_rearrange_keys_out(ENCRYPTO::block128_vector& dst,
           .shuffle(Eigen::array<Eigen::Index, 4>{0, 3, 2, 1});
 }
 
+BitonicSortingNetwork::BitonicSortingNetwork(std::size_t num_elements)
+    : num_elements_(num_elements), log_size_(0) {
+  while ((std::size_t(1) << log_size_) < num_elements_) {
+    ++log_size_;
+  }
+  // merge k (of blocks of size 2^k) has k layers
+  num_layers_ = log_size_ * (log_size_ + 1) / 2;
+}
+
+template <typename F>
+void BitonicSortingNetwork::for_each_comparator(std::size_t layer_i, F&& f) const {
+  if (layer_i >= num_layers_) {
+    throw std::out_of_range(
+        fmt::format("BitonicSortingNetwork: layer {} of {}", layer_i, num_layers_));
+  }
+  std::size_t k = 1;
+  while (layer_i >= k) {
+    layer_i -= k;
+    ++k;
+  }
+  const std::size_t block_size = std::size_t(1) << k;
+  if (layer_i == 0) {
+    // compare the mirrored positions of each block
+    for (std::size_t block = 0; block < num_elements_; block += block_size) {
+      for (std::size_t t = 0; t < block_size / 2; ++t) {
+        const auto max_pos = block + block_size - 1 - t;
+        if (max_pos < num_elements_) {
+          f(block + t, max_pos);
+        }
+      }
+    }
+  } else {
+    // half-cleaner with distance 2^(k - 1 - layer_i)
+    const std::size_t distance = block_size >> (layer_i + 1);
+    for (std::size_t min_pos = 0; min_pos + distance < num_elements_; ++min_pos) {
+      if ((min_pos & distance) == 0) {
+        f(min_pos, min_pos + distance);
+      }
+    }
+  }
+}
+
+std::size_t BitonicSortingNetwork::get_layer_size(std::size_t layer_i) const {
+  std::size_t size = 0;
+  for_each_comparator(layer_i, [&size](std::size_t, std::size_t) { ++size; });
+  return size;
+}
+
+void BitonicSortingNetwork::get_layer(std::vector<Comparator>& layer, std::size_t layer_i) const {
+  layer.clear();
+  for_each_comparator(layer_i, [&layer](std::size_t min_pos, std::size_t max_pos) {
+    layer.emplace_back(min_pos, max_pos);
+  });
+}
+
 }  // namespace MOTION::proto::yao
@@ -23,6 +23,8 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
+#include <vector>
 
 #include "utility/bit_vector.h"
 #include "utility/block.h"
@@ -47,4 +49,31 @@ void maxpool_rearrange_keys_out(ENCRYPTO::block128_vector& dst,
                                 const ENCRYPTO::block128_vector& keys, std::size_t bit_size,
                                 const tensor::MaxPoolOp&);
 
+// Bitonic sorting network for an arbitrary number of elements whose layers of
+// independent comparators are generated on demand, so that the network never
+// needs to be stored as a whole.  Every comparator moves the minimum to the
+// lower position (the first layer of each merge compares mirrored positions),
+// hence the network for n elements is the one for the next power of two
+// without the comparators touching positions >= n, which would only compare
+// padding elements of value +infinity.
+class BitonicSortingNetwork {
+ public:
+  // (position receiving the minimum, position receiving the maximum)
+  using Comparator = std::pair<std::size_t, std::size_t>;
+
+  explicit BitonicSortingNetwork(std::size_t num_elements);
+  std::size_t get_num_elements() const noexcept { return num_elements_; }
+  std::size_t get_num_layers() const noexcept { return num_layers_; }
+  std::size_t get_layer_size(std::size_t layer_i) const;
+  void get_layer(std::vector<Comparator>& layer, std::size_t layer_i) const;
+
+ private:
+  template <typename F>
+  void for_each_comparator(std::size_t layer_i, F&& f) const;
+
+  std::size_t num_elements_;
+  std::size_t log_size_;
+  std::size_t num_layers_;
+};
+
 }  // namespace MOTION::proto::yao
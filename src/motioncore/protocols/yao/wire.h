@@ -36,10 +36,17 @@ class YaoProvider;
 
 class YaoWire : public NewWire, public ENCRYPTO::enable_wait_setup {
  public:
-  YaoWire(std::size_t num_simd) : NewWire(num_simd), keys_(num_simd) {}
+  // the keys are allocated on first (mutable) access, so that wires of gates which have not been
+  // evaluated yet do not occupy memory
+  YaoWire(std::size_t num_simd) : NewWire(num_simd) {}
   MPCProtocol get_protocol() const noexcept override { return MPCProtocol::Yao; }
   std::size_t get_bit_size() const noexcept override { return 1; }
-  ENCRYPTO::block128_vector& get_keys() { return keys_; };
+  ENCRYPTO::block128_vector& get_keys() {
+    if (keys_.size() != get_num_simd()) {
+      keys_.resize(get_num_simd());
+    }
+    return keys_;
+  };
   const ENCRYPTO::block128_vector& get_keys() const { return keys_; };
 
  private:
@@ -390,9 +390,9 @@ void YaoProvider::setup() {
   setup_ran_ = true;
 }
 
-void YaoProvider::send_blocks_message(std::size_t gate_id,
-                                      ENCRYPTO::block128_vector&& message) const {
-  CommMixin::send_blocks_message(1 - my_id_, gate_id, std::move(message));
+void YaoProvider::send_blocks_message(std::size_t gate_id, ENCRYPTO::block128_vector&& message,
+                                      std::size_t msg_num) const {
+  CommMixin::send_blocks_message(1 - my_id_, gate_id, std::move(message), msg_num);
 }
 
 void YaoProvider::send_bits_message(std::size_t gate_id, ENCRYPTO::BitVector<>&& message) const {
@@ -405,8 +405,8 @@ void YaoProvider::send_bits_message(std::size_t gate_id,
 }
 
 ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector> YaoProvider::register_for_blocks_message(
-    std::size_t gate_id, std::size_t num_blocks) {
-  return CommMixin::register_for_blocks_message(1 - my_id_, gate_id, num_blocks);
+    std::size_t gate_id, std::size_t num_blocks, std::size_t msg_num) {
+  return CommMixin::register_for_blocks_message(1 - my_id_, gate_id, num_blocks, msg_num);
 }
 
 ENCRYPTO::ReusableFiberFuture<ENCRYPTO::BitVector<>> YaoProvider::register_for_bits_message(
@@ -1111,4 +1111,169 @@ tensor::TensorCP YaoProvider::make_tensor_gt_op(const tensor::MaxPoolOp& maxpool
   return output;
 }
 
+tensor::TensorCP YaoProvider::make_tensor_eq_op(const tensor::TensorCP in_a,
+                                                const tensor::TensorCP in_b) {
+  const auto input_a = std::dynamic_pointer_cast<const YaoTensor>(in_a);
+  const auto input_b = std::dynamic_pointer_cast<const YaoTensor>(in_b);
+  assert(input_a != nullptr && input_b != nullptr);
+  if (input_a->get_dimensions() != input_b->get_dimensions() ||
+      input_a->get_bit_size() != input_b->get_bit_size()) {
+    throw std::invalid_argument("YaoProvider::make_tensor_eq_op: tensor mismatch");
+  }
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  if (role_ == Role::garbler) {
+    auto tensor_op = std::make_unique<YaoTensorEqGarbler>(gate_id, *this, input_a, input_b);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  } else {
+    auto tensor_op = std::make_unique<YaoTensorEqEvaluator>(gate_id, *this, input_a, input_b);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  }
+  return output;
+}
+
+tensor::TensorCP YaoProvider::make_tensor_gt_public_op(
+    const tensor::TensorCP in, const std::vector<std::uint64_t>& constants) {
+  const auto input = std::dynamic_pointer_cast<const YaoTensor>(in);
+  assert(input != nullptr);
+  auto element_constants = tensor::broadcast_per_channel(in->get_dimensions(), constants);
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  if (role_ == Role::garbler) {
+    auto tensor_op = std::make_unique<YaoTensorGTPublicGarbler>(gate_id, *this, input,
+                                                                std::move(element_constants));
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  } else {
+    auto tensor_op = std::make_unique<YaoTensorGTPublicEvaluator>(gate_id, *this, input,
+                                                                  std::move(element_constants));
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  }
+  return output;
+}
+
+tensor::TensorCP YaoProvider::make_tensor_clip_op(const tensor::TensorCP in, std::uint64_t min,
+                                                  std::uint64_t max) {
+  const auto input = std::dynamic_pointer_cast<const YaoTensor>(in);
+  assert(input != nullptr);
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  if (role_ == Role::garbler) {
+    auto tensor_op = std::make_unique<YaoTensorClipGarbler>(gate_id, *this, input, min, max);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  } else {
+    auto tensor_op = std::make_unique<YaoTensorClipEvaluator>(gate_id, *this, input, min, max);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  }
+  return output;
+}
+
+tensor::TensorCP YaoProvider::make_sort_tensor(std::vector<YaoTensorCP> inputs,
+                                               bool select_duplicates) {
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  if (role_ == Role::garbler) {
+    auto tensor_op = std::make_unique<YaoTensorSortGarbler>(gate_id, *this, std::move(inputs),
+                                                            select_duplicates);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  } else {
+    auto tensor_op = std::make_unique<YaoTensorSortEvaluator>(gate_id, *this, std::move(inputs),
+                                                              select_duplicates);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  }
+  return output;
+}
+
+tensor::TensorCP YaoProvider::make_tensor_sort_op(const tensor::TensorCP in) {
+  const auto input_tensor = std::dynamic_pointer_cast<const YaoTensor>(in);
+  assert(input_tensor != nullptr);
+  return make_sort_tensor({input_tensor}, false);
+}
+
+tensor::TensorCP YaoProvider::make_tensor_intersection_op(const tensor::TensorCP in_a,
+                                                          const tensor::TensorCP in_b) {
+  const auto input_a = std::dynamic_pointer_cast<const YaoTensor>(in_a);
+  const auto input_b = std::dynamic_pointer_cast<const YaoTensor>(in_b);
+  assert(input_a != nullptr && input_b != nullptr);
+  if (input_a->get_bit_size() != input_b->get_bit_size()) {
+    throw std::invalid_argument("YaoProvider::make_tensor_intersection_op: bit size mismatch");
+  }
+  // after sorting A || B, common elements are next to each other
+  return make_sort_tensor({input_a, input_b}, true);
+}
+
+std::vector<tensor::TensorCP> YaoProvider::make_tensor_join_on_keys_op(
+    const tensor::TensorCP in_keys_a, const tensor::TensorCP in_payload_a,
+    const tensor::TensorCP in_keys_b, const tensor::TensorCP in_payload_b) {
+  const auto keys_a = std::dynamic_pointer_cast<const YaoTensor>(in_keys_a);
+  const auto payload_a = std::dynamic_pointer_cast<const YaoTensor>(in_payload_a);
+  const auto keys_b = std::dynamic_pointer_cast<const YaoTensor>(in_keys_b);
+  const auto payload_b = std::dynamic_pointer_cast<const YaoTensor>(in_payload_b);
+  assert(keys_a != nullptr && payload_a != nullptr && keys_b != nullptr && payload_b != nullptr);
+  auto gate_id = gate_register_.get_next_gate_id();
+  std::vector<YaoTensorCP> outputs;
+  if (role_ == Role::garbler) {
+    auto tensor_op = std::make_unique<YaoTensorJoinGarbler>(gate_id, *this, keys_a, payload_a,
+                                                            keys_b, payload_b);
+    outputs = tensor_op->get_output_tensors();
+    gate_register_.register_gate(std::move(tensor_op));
+  } else {
+    auto tensor_op = std::make_unique<YaoTensorJoinEvaluator>(gate_id, *this, keys_a, payload_a,
+                                                              keys_b, payload_b);
+    outputs = tensor_op->get_output_tensors();
+    gate_register_.register_gate(std::move(tensor_op));
+  }
+  return {std::begin(outputs), std::end(outputs)};
+}
+
+tensor::TensorCP YaoProvider::make_tensor_bucketize_op(
+    const tensor::TensorCP in, const std::vector<std::uint64_t>& bucket_bounds) {
+  const auto input_tensor = std::dynamic_pointer_cast<const YaoTensor>(in);
+  assert(input_tensor != nullptr);
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  if (role_ == Role::garbler) {
+    auto tensor_op =
+        std::make_unique<YaoTensorBucketizeGarbler>(gate_id, *this, input_tensor, bucket_bounds);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  } else {
+    auto tensor_op =
+        std::make_unique<YaoTensorBucketizeEvaluator>(gate_id, *this, input_tensor, bucket_bounds);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  }
+  return output;
+}
+
+tensor::TensorCP YaoProvider::make_tensor_tree_ensemble_op(const TreeEnsemble& model,
+                                                           const tensor::TensorCP features,
+                                                           const tensor::TensorCP thresholds) {
+  const auto features_tensor = std::dynamic_pointer_cast<const YaoTensor>(features);
+  assert(features_tensor != nullptr);
+  const auto thresholds_tensor = std::dynamic_pointer_cast<const YaoTensor>(thresholds);
+  assert(thresholds_tensor != nullptr);
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  if (role_ == Role::garbler) {
+    auto tensor_op = std::make_unique<YaoTensorTreeEnsembleGarbler>(
+        gate_id, *this, model, features_tensor, thresholds_tensor);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  } else {
+    auto tensor_op = std::make_unique<YaoTensorTreeEnsembleEvaluator>(
+        gate_id, *this, model, features_tensor, thresholds_tensor);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  }
+  return output;
+}
+
 }  // namespace MOTION::proto::yao
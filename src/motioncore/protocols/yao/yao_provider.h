@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <initializer_list>
 #include <memory>
 #include <utility>
@@ -71,6 +72,8 @@ enum class OutputRecipient : std::uint8_t { garbler, evaluator, both };
 
 class YaoWire;
 using YaoWireVector = std::vector<std::shared_ptr<YaoWire>>;
+class YaoTensor;
+using YaoTensorCP = std::shared_ptr<const YaoTensor>;
 
 struct YaoMessageHandler;
 
@@ -133,11 +136,13 @@ class YaoProvider : public GateFactory,
   ENCRYPTO::block128_t get_global_offset() const;
   ENCRYPTO::block128_t get_shared_zero() const noexcept;
 
-  void send_blocks_message(std::size_t gate_id, ENCRYPTO::block128_vector&& message) const;
+  void send_blocks_message(std::size_t gate_id, ENCRYPTO::block128_vector&& message,
+                           std::size_t msg_num = 0) const;
   void send_bits_message(std::size_t gate_id, ENCRYPTO::BitVector<>&& message) const;
   void send_bits_message(std::size_t gate_id, const ENCRYPTO::BitVector<>& message) const;
   [[nodiscard]] ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector>
-  register_for_blocks_message(std::size_t gate_id, std::size_t num_blocks);
+  register_for_blocks_message(std::size_t gate_id, std::size_t num_blocks,
+                              std::size_t msg_num = 0);
   [[nodiscard]] ENCRYPTO::ReusableFiberFuture<ENCRYPTO::BitVector<>> register_for_bits_message(
       std::size_t gate_id, std::size_t num_bits);
   void create_garbled_tables(std::size_t gate_id, const ENCRYPTO::block128_vector& keys_a,
@@ -212,8 +217,26 @@ class YaoProvider : public GateFactory,
                                           const tensor::TensorCP) override;
   tensor::TensorCP make_tensor_gt_op(const tensor::MaxPoolOp&,
                                           const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_eq_op(const tensor::TensorCP, const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_gt_public_op(const tensor::TensorCP,
+                                            const std::vector<std::uint64_t>&) override;
+  tensor::TensorCP make_tensor_clip_op(const tensor::TensorCP, std::uint64_t min,
+                                       std::uint64_t max) override;
+  tensor::TensorCP make_tensor_sort_op(const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_intersection_op(const tensor::TensorCP,
+                                               const tensor::TensorCP) override;
+  std::vector<tensor::TensorCP> make_tensor_join_on_keys_op(const tensor::TensorCP,
+                                                            const tensor::TensorCP,
+                                                            const tensor::TensorCP,
+                                                            const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_bucketize_op(
+      const tensor::TensorCP, const std::vector<std::uint64_t>& bucket_bounds) override;
+  tensor::TensorCP make_tensor_tree_ensemble_op(const TreeEnsemble&, const tensor::TensorCP,
+                                                const tensor::TensorCP) override;
 
  private:
+  tensor::TensorCP make_sort_tensor(std::vector<YaoTensorCP> inputs, bool select_duplicates);
+
   Communication::CommunicationLayer& communication_layer_;
   GateRegister& gate_register_;
   CircuitLoader& circuit_loader_;
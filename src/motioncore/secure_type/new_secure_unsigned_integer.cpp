@@ -0,0 +1,183 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "new_secure_unsigned_integer.h"
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "algorithm/algorithm_description.h"
+#include "algorithm/circuit_loader.h"
+#include "base/circuit_builder.h"
+#include "utility/typedefs.h"
+#include "wire/new_wire.h"
+
+namespace MOTION {
+
+static bool is_plain(MPCProtocol proto) {
+  return proto == MPCProtocol::ArithmeticPlain || proto == MPCProtocol::BooleanPlain;
+}
+
+NewSecureUnsignedInteger::NewSecureUnsignedInteger(CircuitBuilder& circuit_builder,
+                                                   WireVector wires)
+    : circuit_builder_(&circuit_builder), wires_(std::move(wires)) {
+  if (wires_.empty()) {
+    throw std::invalid_argument("NewSecureUnsignedInteger: empty WireVector");
+  }
+  protocol_ = wires_[0]->get_protocol();
+  num_simd_ = wires_[0]->get_num_simd();
+  if (is_arithmetic()) {
+    if (wires_.size() != 1) {
+      throw std::invalid_argument(
+          "NewSecureUnsignedInteger: arithmetic integers consist of a single wire");
+    }
+    bit_size_ = wires_[0]->get_bit_size();
+  } else {
+    bit_size_ = wires_.size();
+  }
+}
+
+bool NewSecureUnsignedInteger::is_arithmetic() const noexcept {
+  switch (protocol_) {
+    case MPCProtocol::ArithmeticGMW:
+    case MPCProtocol::ArithmeticBEAVY:
+    case MPCProtocol::ArithmeticPlain:
+    case MPCProtocol::ArithmeticConstant:
+      return true;
+    default:
+      return false;
+  }
+}
+
+NewSecureUnsignedInteger NewSecureUnsignedInteger::convert(MPCProtocol dst_proto) const {
+  if (dst_proto == protocol_) {
+    return *this;
+  }
+  return NewSecureUnsignedInteger(*circuit_builder_, circuit_builder_->convert(dst_proto, wires_));
+}
+
+WireVector NewSecureUnsignedInteger::align(const NewSecureUnsignedInteger& other) const {
+  if (bit_size_ != other.bit_size_ || num_simd_ != other.num_simd_) {
+    throw std::invalid_argument(fmt::format(
+        "NewSecureUnsignedInteger: operand mismatch ({} bit x {} vs. {} bit x {})", bit_size_,
+        num_simd_, other.bit_size_, other.num_simd_));
+  }
+  if (other.protocol_ == protocol_ || is_plain(other.protocol_)) {
+    return other.wires_;
+  }
+  return circuit_builder_->convert(protocol_, other.wires_);
+}
+
+std::pair<WireVector, WireVector> NewSecureUnsignedInteger::to_boolean(
+    const NewSecureUnsignedInteger& other) const {
+  auto wires_b = align(other);
+  if (!is_arithmetic()) {
+    return {wires_, std::move(wires_b)};
+  }
+  // A2Y is available for both arithmetic protocols
+  return {circuit_builder_->convert(MPCProtocol::Yao, wires_),
+          circuit_builder_->convert(MPCProtocol::Yao, wires_b)};
+}
+
+WireVector NewSecureUnsignedInteger::evaluate_bristol(const char* op_name,
+                                                      const WireVector& wires_a,
+                                                      const WireVector& wires_b) const {
+  // Yao only pays for AND gates, the secret sharing based protocols pay for AND depth
+  const bool depth_optimized = wires_a[0]->get_protocol() != MPCProtocol::Yao;
+  const auto& algo = circuit_builder_->get_circuit_loader().load_circuit(
+      fmt::format("int_{}{}_{}.bristol", op_name, bit_size_, depth_optimized ? "depth" : "size"),
+      CircuitFormat::Bristol);
+  return circuit_builder_->make_circuit(algo, wires_a, wires_b);
+}
+
+NewSecureUnsignedInteger NewSecureUnsignedInteger::operator+(
+    const NewSecureUnsignedInteger& other) const {
+  auto wires_b = align(other);
+  if (is_arithmetic()) {
+    return NewSecureUnsignedInteger(
+        *circuit_builder_,
+        circuit_builder_->make_binary_gate(ENCRYPTO::PrimitiveOperationType::ADD, wires_, wires_b));
+  }
+  return NewSecureUnsignedInteger(*circuit_builder_, evaluate_bristol("add", wires_, wires_b));
+}
+
+NewSecureUnsignedInteger NewSecureUnsignedInteger::operator-(
+    const NewSecureUnsignedInteger& other) const {
+  auto wires_b = align(other);
+  if (is_arithmetic()) {
+    auto neg_b = circuit_builder_->make_unary_gate(ENCRYPTO::PrimitiveOperationType::NEG, wires_b);
+    return NewSecureUnsignedInteger(
+        *circuit_builder_,
+        circuit_builder_->make_binary_gate(ENCRYPTO::PrimitiveOperationType::ADD, wires_, neg_b));
+  }
+  return NewSecureUnsignedInteger(*circuit_builder_, evaluate_bristol("sub", wires_, wires_b));
+}
+
+NewSecureUnsignedInteger NewSecureUnsignedInteger::operator*(
+    const NewSecureUnsignedInteger& other) const {
+  auto wires_b = align(other);
+  if (is_arithmetic()) {
+    return NewSecureUnsignedInteger(
+        *circuit_builder_,
+        circuit_builder_->make_binary_gate(ENCRYPTO::PrimitiveOperationType::MUL, wires_, wires_b));
+  }
+  return NewSecureUnsignedInteger(*circuit_builder_, evaluate_bristol("mul", wires_, wires_b));
+}
+
+NewSecureUnsignedInteger NewSecureUnsignedInteger::operator/(
+    const NewSecureUnsignedInteger& other) const {
+  auto [wires_a, wires_b] = to_boolean(other);
+  NewSecureUnsignedInteger result(*circuit_builder_, evaluate_bristol("div", wires_a, wires_b));
+  // hand the quotient back in the protocol of the dividend
+  return result.convert(protocol_);
+}
+
+WireVector NewSecureUnsignedInteger::operator>(const NewSecureUnsignedInteger& other) const {
+  auto [wires_a, wires_b] = to_boolean(other);
+  const bool depth_optimized = wires_a[0]->get_protocol() != MPCProtocol::Yao;
+  const auto& algo =
+      circuit_builder_->get_circuit_loader().load_gt_circuit(bit_size_, depth_optimized);
+  return circuit_builder_->make_circuit(algo, wires_a, wires_b);
+}
+
+WireVector NewSecureUnsignedInteger::operator==(const NewSecureUnsignedInteger& other) const {
+  auto [wires_a, wires_b] = to_boolean(other);
+  // a == b iff all bits of ~(a ^ b) are set, which is reduced by a tree of AND
+  // gates where each level is a single gate over all remaining wires
+  auto wires = circuit_builder_->make_binary_gate(ENCRYPTO::PrimitiveOperationType::XOR, wires_a,
+                                                  wires_b);
+  wires = circuit_builder_->make_unary_gate(ENCRYPTO::PrimitiveOperationType::INV, wires);
+  while (wires.size() > 1) {
+    const auto half = wires.size() / 2;
+    WireVector lhs(std::begin(wires), std::begin(wires) + half);
+    WireVector rhs(std::begin(wires) + half, std::begin(wires) + 2 * half);
+    auto next = circuit_builder_->make_binary_gate(ENCRYPTO::PrimitiveOperationType::AND, lhs, rhs);
+    if (wires.size() % 2 == 1) {
+      next.push_back(wires.back());
+    }
+    wires = std::move(next);
+  }
+  return wires;
+}
+
+}  // namespace MOTION
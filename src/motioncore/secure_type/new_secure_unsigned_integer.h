@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace MOTION {
+
+class CircuitBuilder;
+enum class MPCProtocol : unsigned int;
+class NewWire;
+using WireVector = std::vector<std::shared_ptr<NewWire>>;
+
+// Unsigned integer on top of the NewGate backend.
+//
+// Arithmetic protocols hold a single wire, Boolean protocols (GMW, BEAVY, Yao)
+// hold one wire per bit.  In both cases every wire carries get_num_simd()
+// values, so each operator processes all SIMD lanes at once.  Boolean
+// operations are built from the Bristol circuits in circuits/int which are
+// parsed only once by the CircuitLoader.  Operations which have no arithmetic
+// counterpart (division, comparisons) convert the operands to Yao first.
+class NewSecureUnsignedInteger {
+ public:
+  NewSecureUnsignedInteger(CircuitBuilder&, WireVector);
+
+  const WireVector& get_wires() const noexcept { return wires_; }
+  MPCProtocol get_protocol() const noexcept { return protocol_; }
+  std::size_t get_bit_size() const noexcept { return bit_size_; }
+  std::size_t get_num_simd() const noexcept { return num_simd_; }
+  bool is_arithmetic() const noexcept;
+
+  NewSecureUnsignedInteger convert(MPCProtocol) const;
+
+  NewSecureUnsignedInteger operator+(const NewSecureUnsignedInteger& other) const;
+
+  NewSecureUnsignedInteger& operator+=(const NewSecureUnsignedInteger& other) {
+    *this = *this + other;
+    return *this;
+  }
+
+  NewSecureUnsignedInteger operator-(const NewSecureUnsignedInteger& other) const;
+
+  NewSecureUnsignedInteger& operator-=(const NewSecureUnsignedInteger& other) {
+    *this = *this - other;
+    return *this;
+  }
+
+  NewSecureUnsignedInteger operator*(const NewSecureUnsignedInteger& other) const;
+
+  NewSecureUnsignedInteger& operator*=(const NewSecureUnsignedInteger& other) {
+    *this = *this * other;
+    return *this;
+  }
+
+  NewSecureUnsignedInteger operator/(const NewSecureUnsignedInteger& other) const;
+
+  NewSecureUnsignedInteger& operator/=(const NewSecureUnsignedInteger& other) {
+    *this = *this / other;
+    return *this;
+  }
+
+  // comparisons return a single Boolean wire in the protocol of the evaluated circuit
+  WireVector operator>(const NewSecureUnsignedInteger& other) const;
+
+  WireVector operator==(const NewSecureUnsignedInteger& other) const;
+
+ private:
+  // bring other into the protocol of *this
+  WireVector align(const NewSecureUnsignedInteger& other) const;
+  // returns a Boolean version of *this and other (converted to Yao if arithmetic)
+  std::pair<WireVector, WireVector> to_boolean(const NewSecureUnsignedInteger& other) const;
+  WireVector evaluate_bristol(const char* op_name, const WireVector& wires_a,
+                              const WireVector& wires_b) const;
+
+  CircuitBuilder* circuit_builder_;
+  WireVector wires_;
+  MPCProtocol protocol_;
+  std::size_t bit_size_;
+  std::size_t num_simd_;
+};
+
+}  // namespace MOTION
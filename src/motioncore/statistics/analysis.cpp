@@ -30,7 +30,9 @@
 #include <boost/core/alloc_construct.hpp>
 #include <boost/json.hpp>
 
+#include "communication/message_compression.h"
 #include "communication/transport.h"
+#include "utility/cpu_features.h"
 #include "utility/runtime_info.h"
 #include "utility/version.h"
 
@@ -138,6 +140,17 @@ void AccumulatedCommunicationStats::add(
   }
 }
 
+void AccumulatedCommunicationStats::add(
+    const std::vector<Communication::CompressionStatistics>& stats) {
+  for (const auto& s : stats) {
+    auto& acc = compression_[Communication::EnumNameMessageType(s.message_type)];
+    acc[0] += s.num_messages;
+    acc[1] += s.num_compressed;
+    acc[2] += s.num_bytes_uncompressed;
+    acc[3] += s.num_bytes_compressed;
+  }
+}
+
 std::string AccumulatedCommunicationStats::print_human_readable() const {
   std::stringstream ss;
   ss << "Communication with each other party:\n"
@@ -149,11 +162,19 @@ std::string AccumulatedCommunicationStats::print_human_readable() const {
                     boost::accumulators::mean(accumulators_[idx_num_bytes_received]) / 1048576,
                     static_cast<std::size_t>(
                         boost::accumulators::mean(accumulators_[idx_num_messages_received])));
+  if (!compression_.empty()) {
+    ss << "Compression (all runs):\n";
+    for (const auto& [type, acc] : compression_) {
+      ss << fmt::format("{:30}: {:0.3f} MiB -> {:0.3f} MiB (ratio {:0.3f}), {:d}/{:d} messages\n",
+                        type, double(acc[2]) / 1048576, double(acc[3]) / 1048576,
+                        acc[2] ? double(acc[3]) / acc[2] : 1.0, acc[1], acc[0]);
+    }
+  }
   return ss.str();
 }
 
 json::object AccumulatedCommunicationStats::to_json() const {
-  return {
+  json::object obj{
       {"bytes_sent",
        static_cast<std::size_t>(boost::accumulators::mean(accumulators_[idx_num_bytes_sent]))},
       {"num_messages_sent",
@@ -162,6 +183,19 @@ json::object AccumulatedCommunicationStats::to_json() const {
        static_cast<std::size_t>(boost::accumulators::mean(accumulators_[idx_num_bytes_received]))},
       {"num_messages_received", static_cast<std::size_t>(boost::accumulators::mean(
                                     accumulators_[idx_num_messages_received]))}};
+  if (!compression_.empty()) {
+    json::object compression;
+    for (const auto& [type, acc] : compression_) {
+      json::object type_obj;
+      type_obj.emplace("num_messages", acc[0]);
+      type_obj.emplace("num_compressed", acc[1]);
+      type_obj.emplace("bytes_uncompressed", acc[2]);
+      type_obj.emplace("bytes_compressed", acc[3]);
+      compression.emplace(type, std::move(type_obj));
+    }
+    obj.emplace("compression", std::move(compression));
+  }
+  return obj;
 }
 
 std::string print_motion_info() {
@@ -172,6 +206,25 @@ std::string print_motion_info() {
   return ss.str();
 }
 
+static std::string print_kernel_info() {
+  std::stringstream ss;
+  ss << "Kernels:\n"
+     << fmt::format("  {:<20} {}\n", "vectorized_kernels", get_target_clones_variant());
+  for (const auto& [kernel, variant] : get_kernel_variants()) {
+    ss << fmt::format("  {:<20} {}\n", kernel, variant);
+  }
+  return ss.str();
+}
+
+static json::object kernels_to_json() {
+  json::object obj;
+  obj.emplace("vectorized_kernels", get_target_clones_variant());
+  for (const auto& [kernel, variant] : get_kernel_variants()) {
+    obj.emplace(kernel, variant);
+  }
+  return obj;
+}
+
 std::string print_stats(const std::string& experiment_name,
                         const AccumulatedRunTimeStats& exec_stats,
                         const AccumulatedCommunicationStats& comm_stats) {
@@ -181,6 +234,8 @@ std::string print_stats(const std::string& experiment_name,
      << "===========================================================================\n"
      << print_motion_info()
      << "===========================================================================\n"
+     << print_kernel_info()
+     << "===========================================================================\n"
      << exec_stats.print_human_readable()
      << "===========================================================================\n"
      << comm_stats.print_human_readable()
@@ -201,6 +256,7 @@ json::object to_json(const std::string& experiment_name, const AccumulatedRunTim
                       {"git-branch", get_git_branch()},
                       {"git-commit", get_git_commit()},
                       {"git-version", get_git_version()}}}});
+  obj.emplace("kernels", kernels_to_json());
   obj.emplace("runtime", exec_stats.to_json());
   obj.emplace("communication", comm_stats.to_json());
   return obj;
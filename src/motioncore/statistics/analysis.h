@@ -30,11 +30,14 @@
 #include <boost/accumulators/statistics/variance.hpp>
 #include <boost/json/object.hpp>
 #include <list>
+#include <map>
+#include <string>
 #include "run_time_stats.h"
 
 namespace MOTION {
 
 namespace Communication {
+struct CompressionStatistics;
 struct TransportStatistics;
 }
 
@@ -71,8 +74,13 @@ struct AccumulatedCommunicationStats {
   std::size_t count_ = 0;
   std::array<accumulator_type, 4> accumulators_;
 
+  // compression statistics per message type: messages, compressed messages,
+  // uncompressed bytes, compressed bytes
+  std::map<std::string, std::array<std::size_t, 4>> compression_;
+
   void add(const Communication::TransportStatistics& stats);
   void add(const std::vector<Communication::TransportStatistics>& stats);
+  void add(const std::vector<Communication::CompressionStatistics>& stats);
   std::string print_human_readable() const;
   boost::json::object to_json() const;
 };
@@ -0,0 +1,55 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "activations.h"
+
+#include "network_builder.h"
+#include "tensor_op_factory.h"
+#include "utility/typedefs.h"
+
+namespace MOTION::tensor {
+
+TensorCP make_leaky_relu(NetworkBuilder& builder, MPCProtocol arithmetic_protocol,
+                         MPCProtocol boolean_protocol, const TensorCP input, std::uint64_t slope,
+                         std::size_t fractional_bits) {
+  const auto convert = [&builder, input](MPCProtocol proto) {
+    return input->get_protocol() == proto ? input : builder.convert(proto, input);
+  };
+  const auto arith_input = convert(arithmetic_protocol);
+  const auto bool_input = convert(boolean_protocol);
+  auto& bool_factory = builder.get_tensor_op_factory(boolean_protocol);
+  auto& arith_factory = builder.get_tensor_op_factory(arithmetic_protocol);
+
+  const auto relu =
+      bool_factory.supports_tensor_relu_op(boolean_protocol, arithmetic_protocol)
+          ? bool_factory.make_tensor_relu_op(bool_input, arith_input)
+          : builder.convert(arithmetic_protocol, bool_factory.make_tensor_relu_op(bool_input));
+
+  // min(x, 0) = x - max(x, 0)
+  const auto negative_part =
+      arith_factory.make_tensor_add_op(arith_input, arith_factory.make_tensor_negate(relu));
+  return arith_factory.make_tensor_add_op(
+      relu, arith_factory.make_tensor_constMul_op(negative_part, slope, fractional_bits));
+}
+
+}  // namespace MOTION::tensor
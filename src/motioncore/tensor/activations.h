@@ -0,0 +1,50 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensor.h"
+
+namespace MOTION {
+
+enum class MPCProtocol : unsigned int;
+
+namespace tensor {
+
+class NetworkBuilder;
+
+// Leaky ReLU y = max(x, 0) + slope * min(x, 0) of an arithmetically shared
+// fixed-point tensor with a public slope (encoded with fractional_bits).  The
+// only comparison is the one of the ReLU, which is computed in the Boolean
+// protocol (if possible directly with an arithmetic output); the negative
+// part x - ReLU(x) is then scaled with a single multiplication by the public
+// slope.
+TensorCP make_leaky_relu(NetworkBuilder&, MPCProtocol arithmetic_protocol,
+                         MPCProtocol boolean_protocol, const TensorCP input, std::uint64_t slope,
+                         std::size_t fractional_bits);
+
+}  // namespace tensor
+}  // namespace MOTION
@@ -22,8 +22,12 @@
 
 #include "tensor_op.h"
 
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <cassert>
+#include <stdexcept>
+
+#include <fmt/format.h>
 
 namespace MOTION::tensor {
 
@@ -31,6 +35,8 @@ bool Conv2DOp::verify() const noexcept {
   bool result = true;
   result = result && (output_shape_ == compute_output_shape());
   result = result && strides_[0] > 0 && strides_[1] > 0;
+  result = result && group_ > 0 && kernel_shape_[0] % group_ == 0;
+  result = result && input_shape_[0] == kernel_shape_[1] * group_;
   // maybe add more checks here
   return result;
 }
@@ -72,8 +78,19 @@ std::size_t Conv2DOp::compute_bias_size() const noexcept {
   return kernel_shape_[0];
 }
 
+Conv2DOp Conv2DOp::get_group_op() const noexcept {
+  assert(verify());
+  Conv2DOp group_op = *this;
+  group_op.kernel_shape_[0] /= group_;
+  group_op.input_shape_[0] /= group_;
+  group_op.output_shape_[0] /= group_;
+  group_op.group_ = 1;
+  return group_op;
+}
+
 std::pair<std::size_t, std::size_t> Conv2DOp::compute_input_matrix_shape() const noexcept {
   assert(verify());
+  assert(group_ == 1);
   std::size_t num_rows = kernel_shape_[1] * kernel_shape_[2] * kernel_shape_[3];
   std::size_t num_columns = output_shape_[1] * output_shape_[2];
   return {num_rows, num_columns};
@@ -81,6 +98,7 @@ std::pair<std::size_t, std::size_t> Conv2DOp::compute_input_matrix_shape() const
 
 std::pair<std::size_t, std::size_t> Conv2DOp::compute_kernel_matrix_shape() const noexcept {
   assert(verify());
+  assert(group_ == 1);
   std::size_t num_rows = kernel_shape_[0];
   std::size_t num_columns = kernel_shape_[1] * kernel_shape_[2] * kernel_shape_[3];
   return {num_rows, num_columns};
@@ -88,6 +106,7 @@ std::pair<std::size_t, std::size_t> Conv2DOp::compute_kernel_matrix_shape() cons
 
 std::pair<std::size_t, std::size_t> Conv2DOp::compute_output_matrix_shape() const noexcept {
   assert(verify());
+  assert(group_ == 1);
   std::size_t num_rows = kernel_shape_[0];
   std::size_t num_columns = output_shape_[1] * output_shape_[2];
   return {num_rows, num_columns};
@@ -127,6 +146,7 @@ bool Conv2DOp::operator==(const Conv2DOp& other) const noexcept {
   result = result && dilations_ == other.dilations_;
   result = result && pads_ == other.pads_;
   result = result && strides_ == other.strides_;
+  result = result && group_ == other.group_;
   return result;
 }
 
@@ -291,6 +311,59 @@ TensorDimensions flatten(const TensorDimensions& dims, std::size_t axis) {
   return {.batch_size_ = 1, .num_channels_ = 1, .height_ = height, .width_ = width};
 }
 
+TensorDimensions reduce(const TensorDimensions& dims, std::size_t axis) {
+  auto output_dims = dims;
+  switch (axis) {
+    case 0:
+      output_dims.batch_size_ = 1;
+      break;
+    case 1:
+      output_dims.num_channels_ = 1;
+      break;
+    case 2:
+      output_dims.height_ = 1;
+      break;
+    case 3:
+      output_dims.width_ = 1;
+      break;
+  }
+  return output_dims;
+}
+
+std::vector<std::uint64_t> broadcast_per_channel(const TensorDimensions& dims,
+                                                 const std::vector<std::uint64_t>& constants) {
+  if (constants.size() == 1) {
+    return std::vector<std::uint64_t>(dims.get_data_size(), constants[0]);
+  }
+  if (constants.size() != dims.num_channels_) {
+    throw std::invalid_argument(
+        fmt::format("expected 1 or {} constants, but {} are provided", dims.num_channels_,
+                    constants.size()));
+  }
+  const auto channel_size = dims.height_ * dims.width_;
+  std::vector<std::uint64_t> output(dims.get_data_size());
+  auto it = std::begin(output);
+  for (std::size_t batch_i = 0; batch_i < dims.batch_size_; ++batch_i) {
+    for (const auto c : constants) {
+      it = std::fill_n(it, channel_size, c);
+    }
+  }
+  return output;
+}
+
+void check_clip_range(std::uint64_t min, std::uint64_t max, std::size_t bit_size) {
+  if (bit_size == 0 || bit_size > 64) {
+    throw std::invalid_argument(fmt::format("invalid bit size {}", bit_size));
+  }
+  const auto mask = bit_size == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bit_size) - 1;
+  const auto msb = std::uint64_t(1) << (bit_size - 1);
+  // flipping the MSB maps signed to unsigned values while preserving the order
+  if (((min ^ msb) & mask) > ((max ^ msb) & mask)) {
+    throw std::invalid_argument(
+        fmt::format("empty clipping range: min {:#x} > max {:#x}", min & mask, max & mask));
+  }
+}
+
 bool MaxPoolOp::verify() const noexcept {
   bool result = true;
   result = result && (output_shape_ == compute_output_shape());
@@ -415,6 +488,7 @@ std::size_t std::hash<MOTION::tensor::Conv2DOp>::operator()(
   boost::hash_combine(seed, boost::hash_range(std::begin(op.dilations_), std::end(op.dilations_)));
   boost::hash_combine(seed, boost::hash_range(std::begin(op.pads_), std::end(op.pads_)));
   boost::hash_combine(seed, boost::hash_range(std::begin(op.strides_), std::end(op.strides_)));
+  boost::hash_combine(seed, op.group_);
   return seed;
 }
 
@@ -24,8 +24,10 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <utility>
+#include <vector>
 
 #include "tensor.h"
 
@@ -44,12 +46,21 @@ struct Conv2DOp {
   std::array<std::size_t, 4> pads_;
   std::array<std::size_t, 2> strides_;
 
+  // the input and output channels are split into group_ groups which are
+  // convolved independently, i.e., kernel_shape_[1] == input_shape_[0] / group_
+  // (depthwise convolution for group_ == input_shape_[0])
+  std::size_t group_ = 1;
+
   bool verify() const noexcept;
   std::array<std::size_t, 3> compute_output_shape() const noexcept;
   std::size_t compute_output_size() const noexcept;
   std::size_t compute_input_size() const noexcept;
   std::size_t compute_kernel_size() const noexcept;
   std::size_t compute_bias_size() const noexcept;
+  // the dense convolution computed by each group, which operates on
+  // consecutive slices of the input, kernel, and output buffers
+  Conv2DOp get_group_op() const noexcept;
+  // shapes of the im2col matrices (only for dense convolutions)
   std::pair<std::size_t, std::size_t> compute_input_matrix_shape() const noexcept;
   std::pair<std::size_t, std::size_t> compute_kernel_matrix_shape() const noexcept;
   std::pair<std::size_t, std::size_t> compute_output_matrix_shape() const noexcept;
@@ -106,6 +117,17 @@ struct JoinOp {
 
 TensorDimensions flatten(const TensorDimensions& dims, std::size_t axis);
 
+// dimensions after summing over the given axis, which is kept with size 1
+TensorDimensions reduce(const TensorDimensions& dims, std::size_t axis);
+
+// one public constant per element of a tensor with the given dimensions, given
+// either a single constant for all elements or one constant per channel
+std::vector<std::uint64_t> broadcast_per_channel(const TensorDimensions& dims,
+                                                 const std::vector<std::uint64_t>& constants);
+
+// throws if min > max when interpreted as signed bit_size-bit integers
+void check_clip_range(std::uint64_t min, std::uint64_t max, std::size_t bit_size);
+
 struct MaxPoolOp {
   std::array<std::size_t, 3> input_shape_;
   std::array<std::size_t, 3> output_shape_;
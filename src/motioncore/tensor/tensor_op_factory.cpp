@@ -22,8 +22,12 @@
 
 #include "tensor_op_factory.h"
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include "tensor/tensor.h"
 #include "tensor/tensor_op.h"
+#include "utility/fixed_point.h"
 
 #include <fmt/format.h>
 
@@ -66,18 +70,18 @@ TensorOpFactory::make_arithmetic_64_tensor_input_shares(const TensorDimensions&)
 }
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>>
-TensorOpFactory::make_arithmetic_32_tensor_output_my(const TensorCP&) {
+TensorOpFactory::make_arithmetic_32_tensor_output_my(const TensorCP&, std::size_t) {
   throw std::logic_error(
       fmt::format("{} does not support arithmetic 32 bit outputs", get_provider_name()));
 }
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-TensorOpFactory::make_arithmetic_64_tensor_output_my(const TensorCP&) {
+TensorOpFactory::make_arithmetic_64_tensor_output_my(const TensorCP&, std::size_t) {
   throw std::logic_error(
       fmt::format("{} does not support arithmetic 64 bit outputs", get_provider_name()));
 }
 
-void TensorOpFactory::make_arithmetic_tensor_output_other(const TensorCP&) {
+void TensorOpFactory::make_arithmetic_tensor_output_other(const TensorCP&, std::size_t) {
   throw std::logic_error(
       fmt::format("{} does not support arithmetic outputs", get_provider_name()));
 }
@@ -87,11 +91,23 @@ tensor::TensorCP TensorOpFactory::make_tensor_conversion(MPCProtocol, const tens
       fmt::format("{} does not support conversions to other protocols", get_provider_name()));
 }
 
+tensor::TensorCP TensorOpFactory::make_tensor_bit_to_arithmetic_op(const tensor::TensorCP,
+                                                                   std::size_t) {
+  throw std::logic_error(fmt::format("{} does not support bit to arithmetic conversions",
+                                     get_provider_name()));
+}
+
 tensor::TensorCP TensorOpFactory::make_tensor_flatten_op(const tensor::TensorCP, std::size_t) {
   throw std::logic_error(
       fmt::format("{} does not support the Flatten operation", get_provider_name()));
 }
 
+tensor::TensorCP TensorOpFactory::make_tensor_reshape_op(const tensor::TensorCP,
+                                                         const tensor::TensorDimensions&) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Reshape operation", get_provider_name()));
+}
+
 tensor::TensorCP TensorOpFactory::make_tensor_conv2d_op(const tensor::Conv2DOp&,
                                                         const tensor::TensorCP,
                                                         const tensor::TensorCP,
@@ -128,6 +144,16 @@ tensor::TensorCP TensorOpFactory::make_tensor_relu_op(const tensor::TensorCP,
       fmt::format("{} does not support the ReLU (arith x Bool) operation", get_provider_name()));
 }
 
+bool TensorOpFactory::supports_tensor_relu_op(MPCProtocol, MPCProtocol) const noexcept {
+  return false;
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_clip_op(const tensor::TensorCP, std::uint64_t,
+                                                      std::uint64_t) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Clip operation", get_provider_name()));
+}
+
 tensor::TensorCP TensorOpFactory::make_tensor_maxpool_op(const tensor::MaxPoolOp&,
                                                          const tensor::TensorCP) {
   throw std::logic_error(
@@ -145,11 +171,23 @@ tensor::TensorCP TensorOpFactory::make_tensor_negate(const tensor::TensorCP) {
       fmt::format("{} does not support the Negate operation", get_provider_name()));
 }
 
-tensor::TensorCP TensorOpFactory::make_tensor_constMul_op(const tensor::TensorCP,const uint64_t k) {
+tensor::TensorCP TensorOpFactory::make_tensor_constMul_op(const tensor::TensorCP,const uint64_t k,
+                                                         std::size_t) {
   throw std::logic_error(
       fmt::format("{} does not support the Const Multiplication operation", get_provider_name()));
 }
 
+tensor::TensorCP TensorOpFactory::make_tensor_constAdd_op(const tensor::TensorCP, const uint64_t) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Const Addition operation", get_provider_name()));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_mul_op(const tensor::TensorCP, const tensor::TensorCP,
+                                                     std::size_t) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Mul operation", get_provider_name()));
+}
+
 tensor::TensorCP TensorOpFactory::make_tensor_add_op(const tensor::TensorCP,const tensor::TensorCP) {
   throw std::logic_error(
       fmt::format("{} does not support the Tensor addition operation", get_provider_name()));
@@ -173,4 +211,164 @@ tensor::TensorCP TensorOpFactory::make_tensor_join_op(const tensor::JoinOp&, con
       fmt::format("{} does not support the Join operation", get_provider_name()));
 }
 
+tensor::TensorCP TensorOpFactory::make_tensor_eq_op(const tensor::TensorCP, const tensor::TensorCP) {
+  throw std::logic_error(fmt::format("{} does not support the Eq operation", get_provider_name()));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_gt_public_op(const tensor::TensorCP,
+                                                           const std::vector<std::uint64_t>&) {
+  throw std::logic_error(
+      fmt::format("{} does not support the GT operation with public constants",
+                  get_provider_name()));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_sort_op(const tensor::TensorCP) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Sort operation", get_provider_name()));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_intersection_op(const tensor::TensorCP,
+                                                              const tensor::TensorCP) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Intersection operation", get_provider_name()));
+}
+
+std::vector<tensor::TensorCP> TensorOpFactory::make_tensor_join_on_keys_op(
+    const tensor::TensorCP, const tensor::TensorCP, const tensor::TensorCP,
+    const tensor::TensorCP) {
+  throw std::logic_error(
+      fmt::format("{} does not support the JoinOnKeys operation", get_provider_name()));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_sum_op(const tensor::TensorCP, std::size_t) {
+  throw std::logic_error(fmt::format("{} does not support the Sum operation", get_provider_name()));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_mean_op(const tensor::TensorCP, std::size_t,
+                                                      std::size_t) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Mean operation", get_provider_name()));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_variance_op(const tensor::TensorCP input,
+                                                          std::size_t axis,
+                                                          std::size_t fractional_bits) {
+  // Var[x] = E[x^2] - E[x]^2
+  auto mean_of_sqr =
+      make_tensor_mean_op(make_tensor_sqr_op(input, fractional_bits), axis, fractional_bits);
+  auto sqr_of_mean = make_tensor_sqr_op(make_tensor_mean_op(input, axis, fractional_bits),
+                                        fractional_bits);
+  return make_tensor_add_op(mean_of_sqr, make_tensor_negate(sqr_of_mean));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_bucketize_op(const tensor::TensorCP,
+                                                           const std::vector<std::uint64_t>&) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Bucketize operation", get_provider_name()));
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_tree_ensemble_op(const TreeEnsemble&,
+                                                               const tensor::TensorCP,
+                                                               const tensor::TensorCP) {
+  throw std::logic_error(
+      fmt::format("{} does not support the TreeEnsemble operation", get_provider_name()));
+}
+
+namespace {
+
+// Shared starting value for the Newton iterations: multiplying with zero and
+// adding the public constant is local in all arithmetic protocols.
+tensor::TensorCP make_start_value(TensorOpFactory& factory, const tensor::TensorCP input,
+                                  double value, std::size_t fractional_bits) {
+  const auto encoded_value = fixed_point::encode<std::uint64_t>(value, fractional_bits);
+  if (encoded_value == 0) {
+    throw std::invalid_argument(
+        fmt::format("starting value {} is not representable with {} fractional bits", value,
+                    fractional_bits));
+  }
+  return factory.make_tensor_constAdd_op(factory.make_tensor_constMul_op(input, 0), encoded_value);
+}
+
+void check_newton_parameters(const tensor::TensorCP& input, std::size_t fractional_bits,
+                             double max_value, std::size_t num_iterations) {
+  if (!(max_value > 0.0)) {
+    throw std::invalid_argument("max_value needs to be positive");
+  }
+  if (num_iterations == 0) {
+    throw std::invalid_argument("at least one Newton iteration is required");
+  }
+  // the products of the iterations need 2 * fractional_bits plus the integer
+  // bits of max_value^2 and a sign bit, otherwise they silently overflow
+  const auto bit_size = input->get_bit_size();
+  const auto max_value_bits =
+      static_cast<std::size_t>(std::max(0.0, std::ceil(std::log2(max_value))));
+  if (2 * (fractional_bits + max_value_bits) + 1 >= bit_size) {
+    throw std::invalid_argument(
+        fmt::format("Newton iterations with {} fractional bits and max_value {} overflow {} bit "
+                    "tensors",
+                    fractional_bits, max_value, bit_size));
+  }
+}
+
+}  // namespace
+
+tensor::TensorCP TensorOpFactory::make_tensor_reciprocal_op(const tensor::TensorCP input,
+                                                            std::size_t fractional_bits,
+                                                            double max_value,
+                                                            std::size_t num_iterations) {
+  check_newton_parameters(input, fractional_bits, max_value, num_iterations);
+  const auto two = fixed_point::encode<std::uint64_t>(2.0, fractional_bits);
+
+  // y_0 = 1 / max_value lies in (0, 2 / x) for every x in (0, max_value]
+  auto y = make_start_value(*this, input, 1.0 / max_value, fractional_bits);
+  for (std::size_t i = 0; i < num_iterations; ++i) {
+    // y_(i+1) = y_i * (2 - x * y_i)
+    auto xy = make_tensor_mul_op(input, y, fractional_bits);
+    auto e = make_tensor_constAdd_op(make_tensor_negate(xy), two);
+    y = make_tensor_mul_op(y, e, fractional_bits);
+  }
+  return y;
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_div_op(const tensor::TensorCP numerator,
+                                                     const tensor::TensorCP denominator,
+                                                     std::size_t fractional_bits,
+                                                     double max_value,
+                                                     std::size_t num_iterations) {
+  if (numerator->get_dimensions() != denominator->get_dimensions()) {
+    throw std::logic_error("mismatch of dimensions");
+  }
+  auto reciprocal =
+      make_tensor_reciprocal_op(denominator, fractional_bits, max_value, num_iterations);
+  return make_tensor_mul_op(numerator, reciprocal, fractional_bits);
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_rsqrt_op(const tensor::TensorCP input,
+                                                       std::size_t fractional_bits,
+                                                       double max_value,
+                                                       std::size_t num_iterations) {
+  check_newton_parameters(input, fractional_bits, max_value, num_iterations);
+  const auto three = fixed_point::encode<std::uint64_t>(3.0, fractional_bits);
+
+  // y_0 = 1 / sqrt(max_value) lies in (0, sqrt(3 / x)) for every x in (0, max_value]
+  auto y = make_start_value(*this, input, 1.0 / std::sqrt(max_value), fractional_bits);
+  for (std::size_t i = 0; i < num_iterations; ++i) {
+    // y_(i+1) = y_i * (3 - x * y_i^2) / 2, the halving is folded into the truncation
+    auto y_sqr = make_tensor_mul_op(y, y, fractional_bits);
+    auto xy_sqr = make_tensor_mul_op(input, y_sqr, fractional_bits);
+    auto e = make_tensor_constAdd_op(make_tensor_negate(xy_sqr), three);
+    y = make_tensor_mul_op(y, e, fractional_bits + 1);
+  }
+  return y;
+}
+
+tensor::TensorCP TensorOpFactory::make_tensor_sqrt_op(const tensor::TensorCP input,
+                                                      std::size_t fractional_bits,
+                                                      double max_value,
+                                                      std::size_t num_iterations) {
+  // sqrt(x) = x * (1 / sqrt(x))
+  auto rsqrt = make_tensor_rsqrt_op(input, fractional_bits, max_value, num_iterations);
+  return make_tensor_mul_op(input, rsqrt, fractional_bits);
+}
+
 }  // namespace MOTION::tensor
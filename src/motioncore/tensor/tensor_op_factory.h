@@ -29,6 +29,10 @@
 #include "tensor_op.h"
 #include "utility/reusable_future.h"
 
+namespace MOTION {
+struct TreeEnsemble;
+}  // namespace MOTION
+
 namespace MOTION::tensor {
 
 struct TensorDimensions;
@@ -62,17 +66,30 @@ class TensorOpFactory {
   make_arithmetic_64_tensor_input_shares(const TensorDimensions&);
 
   // arithmetic outputs
+  // If output_bit_size is nonzero, only the lowest output_bit_size bits of the
+  // outputs are sent bit-packed and the reconstructed values are
+  // sign-extended, i.e., the outputs need to fit into output_bit_size bits as
+  // two's complement numbers.  Both parties need to use the same value.
   virtual ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>>
-  make_arithmetic_32_tensor_output_my(const TensorCP&);
+  make_arithmetic_32_tensor_output_my(const TensorCP&, std::size_t output_bit_size = 0);
   virtual ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-  make_arithmetic_64_tensor_output_my(const TensorCP&);
-  virtual void make_arithmetic_tensor_output_other(const TensorCP&);
+  make_arithmetic_64_tensor_output_my(const TensorCP&, std::size_t output_bit_size = 0);
+  virtual void make_arithmetic_tensor_output_other(const TensorCP&,
+                                                   std::size_t output_bit_size = 0);
 
   // conversions
   virtual tensor::TensorCP make_tensor_conversion(MPCProtocol, const tensor::TensorCP input);
+  // converts a Boolean tensor of bit size 1 into an arithmetic tensor of the
+  // given bit size holding each bit as 0 or 1, i.e., with one OT or shared bit
+  // per element instead of bit_size many
+  virtual tensor::TensorCP make_tensor_bit_to_arithmetic_op(const tensor::TensorCP input,
+                                                            std::size_t bit_size);
 
   // operations
   virtual tensor::TensorCP make_tensor_flatten_op(const tensor::TensorCP input, std::size_t axis);
+  // same data in other dimensions with the same number of elements
+  virtual tensor::TensorCP make_tensor_reshape_op(const tensor::TensorCP input,
+                                                  const tensor::TensorDimensions& dims);
   virtual tensor::TensorCP make_tensor_conv2d_op(const tensor::Conv2DOp& conv_op,
                                                  const tensor::TensorCP input,
                                                  const tensor::TensorCP kernel,
@@ -91,14 +108,29 @@ class TensorOpFactory {
   virtual tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP input);
   virtual tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP input_bool,
                                                const tensor::TensorCP input_arith);
+  // whether the ReLU (arith x Bool) operation is supported for inputs of the
+  // given protocols
+  virtual bool supports_tensor_relu_op(MPCProtocol bool_protocol,
+                                       MPCProtocol arith_protocol) const noexcept;
+  // elementwise clipping of the signed values of a Boolean tensor to the
+  // public range [min, max], e.g., ReLU6 for min = 0 and max = 6 (in
+  // fixed-point encoding); both comparisons are evaluated in one batch
+  virtual tensor::TensorCP make_tensor_clip_op(const tensor::TensorCP input, std::uint64_t min,
+                                               std::uint64_t max);
   virtual tensor::TensorCP make_tensor_maxpool_op(const tensor::MaxPoolOp& maxpool_op,
                                                   const tensor::TensorCP input);
   virtual tensor::TensorCP make_tensor_avgpool_op(const tensor::AveragePoolOp& avgpool_op,
                                                   const tensor::TensorCP input,
                                                   std::size_t truncate_bits);
   virtual tensor::TensorCP make_tensor_negate(const tensor::TensorCP);   
-  virtual tensor::TensorCP make_tensor_constMul_op(const tensor::TensorCP,const uint64_t k);
+  virtual tensor::TensorCP make_tensor_constMul_op(const tensor::TensorCP,const uint64_t k,
+                                                   std::size_t truncate_bits = 0);
+  virtual tensor::TensorCP make_tensor_constAdd_op(const tensor::TensorCP, const uint64_t k);
+  virtual tensor::TensorCP make_tensor_mul_op(const tensor::TensorCP input_A,
+                                              const tensor::TensorCP input_B,
+                                              std::size_t truncate_bits = 0);
   virtual tensor::TensorCP make_tensor_add_op(const tensor::TensorCP,const tensor::TensorCP);
+  // the first 10 elements as separate tensors of one element each
   virtual std::vector<tensor::TensorCP> make_tensor_split_op(const tensor::TensorCP);
   virtual tensor::TensorCP make_tensor_gt_op(const tensor::MaxPoolOp& maxpool_op,
                                                   const tensor::TensorCP input);
@@ -106,7 +138,77 @@ class TensorOpFactory {
                                                const tensor::TensorCP input_A,
                                                const tensor::TensorCP input_B,
                                                std::size_t truncate_bits = 0);
-                                               
+
+  // elementwise equality, the output has bit size 1
+  virtual tensor::TensorCP make_tensor_eq_op(const tensor::TensorCP input_A,
+                                             const tensor::TensorCP input_B);
+  // elementwise signed comparison input > c with public constants c, given
+  // either as a single constant or as one constant per channel (cf.
+  // tensor::broadcast_per_channel); the output has bit size 1
+  virtual tensor::TensorCP make_tensor_gt_public_op(const tensor::TensorCP input,
+                                                    const std::vector<std::uint64_t>& constants);
+  // sorts all elements of the tensor in ascending order
+  virtual tensor::TensorCP make_tensor_sort_op(const tensor::TensorCP input);
+  // Intersection of the elements of two tensors, each of which must contain
+  // pairwise distinct and non-zero values.  The output is a flat tensor with
+  // one entry per input element holding the common values in ascending order,
+  // interleaved with zeros at positions where no match was found.
+  virtual tensor::TensorCP make_tensor_intersection_op(const tensor::TensorCP input_A,
+                                                       const tensor::TensorCP input_B);
+  // Join of two tables on their keys, which satisfy the same conditions as
+  // above, with one payload column per table.  Returns three flat tensors
+  // (keys, payloads of A, payloads of B) laid out as the intersection output,
+  // i.e., at the position of each common key they hold the key and the
+  // payloads of its rows in A and B, and zeros elsewhere.
+  virtual std::vector<tensor::TensorCP> make_tensor_join_on_keys_op(
+      const tensor::TensorCP keys_A, const tensor::TensorCP payload_A,
+      const tensor::TensorCP keys_B, const tensor::TensorCP payload_B);
+
+  // reductions over one axis of the tensor, the axis is kept with size 1;
+  // the sum is computed locally on the shares, the mean additionally scales
+  // the sum by the public factor 1 / n and truncates
+  virtual tensor::TensorCP make_tensor_sum_op(const tensor::TensorCP input, std::size_t axis);
+  virtual tensor::TensorCP make_tensor_mean_op(const tensor::TensorCP input, std::size_t axis,
+                                               std::size_t fractional_bits);
+  // population variance E[x^2] - E[x]^2, composed from the operations above
+  virtual tensor::TensorCP make_tensor_variance_op(const tensor::TensorCP input,
+                                                   std::size_t axis,
+                                                   std::size_t fractional_bits);
+  // Given k + 1 strictly increasing bucket bounds b_0 < ... < b_k, computes a
+  // tensor of dimensions (1, k, 1, n) for an input of n elements whose entry
+  // (j, i) is 1 if b_j <= x_i < b_(j+1) and 0 otherwise.  Values are compared
+  // as unsigned integers.  Converting the output to an arithmetic protocol and
+  // summing over axis 3 yields the histogram.
+  virtual tensor::TensorCP make_tensor_bucketize_op(const tensor::TensorCP input,
+                                                    const std::vector<std::uint64_t>& bucket_bounds);
+  // Leaf indicators of a tree ensemble whose structure, i.e., the depths and
+  // the features of the internal nodes, is public.  The features tensor holds
+  // n queries of model.num_features_ values each, the thresholds tensor the
+  // thresholds of all internal nodes in the order of
+  // TreeEnsemble::get_thresholds.  The output has dimensions (1, 1, L, n)
+  // and bit size 1 where L is the total number of leaves, and entry (l, i) is
+  // 1 if query i reaches leaf l and 0 otherwise.
+  virtual tensor::TensorCP make_tensor_tree_ensemble_op(const TreeEnsemble& model,
+                                                        const tensor::TensorCP features,
+                                                        const tensor::TensorCP thresholds);
+
+  // fixed-point approximations via Newton iterations, composed from the
+  // operations above; inputs are expected to lie in (0, max_value], and
+  // 2 * (fractional_bits + log2(max_value)) + 1 needs to be smaller than the
+  // bit size of the input (std::invalid_argument otherwise)
+  virtual tensor::TensorCP make_tensor_reciprocal_op(const tensor::TensorCP input,
+                                                     std::size_t fractional_bits, double max_value,
+                                                     std::size_t num_iterations);
+  virtual tensor::TensorCP make_tensor_div_op(const tensor::TensorCP numerator,
+                                              const tensor::TensorCP denominator,
+                                              std::size_t fractional_bits, double max_value,
+                                              std::size_t num_iterations);
+  virtual tensor::TensorCP make_tensor_rsqrt_op(const tensor::TensorCP input,
+                                                std::size_t fractional_bits, double max_value,
+                                                std::size_t num_iterations);
+  virtual tensor::TensorCP make_tensor_sqrt_op(const tensor::TensorCP input,
+                                               std::size_t fractional_bits, double max_value,
+                                               std::size_t num_iterations);
 };
 
 }  // namespace MOTION::tensor
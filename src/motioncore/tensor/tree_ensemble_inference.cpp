@@ -0,0 +1,96 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "tree_ensemble_inference.h"
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "algorithm/tree_ensemble.h"
+#include "network_builder.h"
+#include "tensor_op.h"
+#include "tensor_op_factory.h"
+#include "utility/typedefs.h"
+
+namespace MOTION::tensor {
+
+TensorDimensions get_tree_ensemble_features_dims(const TreeEnsemble& model,
+                                                 std::size_t num_queries) {
+  return {.batch_size_ = 1,
+          .num_channels_ = 1,
+          .height_ = num_queries,
+          .width_ = model.num_features_};
+}
+
+TensorDimensions get_tree_ensemble_thresholds_dims(const TreeEnsemble& model) {
+  return {.batch_size_ = 1,
+          .num_channels_ = 1,
+          .height_ = 1,
+          .width_ = model.get_num_internal_nodes()};
+}
+
+TensorDimensions get_tree_ensemble_leaf_values_dims(const TreeEnsemble& model) {
+  return {.batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = model.get_num_leaves()};
+}
+
+TensorCP make_tree_ensemble_inference(NetworkBuilder& builder, MPCProtocol arithmetic_protocol,
+                                      const TreeEnsemble& model, const TensorCP features,
+                                      const TensorCP thresholds, const TensorCP leaf_values) {
+  if (leaf_values->get_dimensions() != get_tree_ensemble_leaf_values_dims(model)) {
+    throw std::invalid_argument(fmt::format("expected {} leaf values, got {}",
+                                            model.get_num_leaves(),
+                                            leaf_values->get_dimensions().get_data_size()));
+  }
+  MPCProtocol boolean_protocol;
+  if (arithmetic_protocol == MPCProtocol::ArithmeticBEAVY) {
+    boolean_protocol = MPCProtocol::BooleanBEAVY;
+  } else if (arithmetic_protocol == MPCProtocol::ArithmeticGMW) {
+    boolean_protocol = MPCProtocol::BooleanGMW;
+  } else {
+    throw std::invalid_argument(
+        fmt::format("unsupported arithmetic protocol {}", ToString(arithmetic_protocol)));
+  }
+  const auto yao_features = builder.convert(MPCProtocol::Yao, features);
+  const auto yao_thresholds = builder.convert(MPCProtocol::Yao, thresholds);
+  const auto indicators =
+      builder.get_tensor_op_factory(MPCProtocol::Yao)
+          .make_tensor_tree_ensemble_op(model, yao_features, yao_thresholds);
+  // the indicators are single bits, so they are converted with one OT each
+  // instead of a conversion of full bit size integers
+  const auto bool_indicators = builder.convert(boolean_protocol, indicators);
+  const auto arith_indicators =
+      builder.get_tensor_op_factory(arithmetic_protocol)
+          .make_tensor_bit_to_arithmetic_op(bool_indicators, leaf_values->get_bit_size());
+
+  // (1 x L) leaf values times (L x n) indicators
+  const auto num_leaves = model.get_num_leaves();
+  const auto num_queries = indicators->get_dimensions().width_;
+  const GemmOp gemm_op = {.input_A_shape_ = {1, num_leaves},
+                          .input_B_shape_ = {num_leaves, num_queries},
+                          .output_shape_ = {1, num_queries}};
+  return builder.get_tensor_op_factory(arithmetic_protocol)
+      .make_tensor_gemm_op(gemm_op, leaf_values, arith_indicators);
+}
+
+}  // namespace MOTION::tensor
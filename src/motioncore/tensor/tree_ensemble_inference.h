@@ -0,0 +1,58 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+
+#include "tensor.h"
+
+namespace MOTION {
+
+enum class MPCProtocol : unsigned int;
+struct TreeEnsemble;
+
+namespace tensor {
+
+class NetworkBuilder;
+
+// dimensions of the secret inputs of make_tree_ensemble_inference
+TensorDimensions get_tree_ensemble_features_dims(const TreeEnsemble&, std::size_t num_queries);
+TensorDimensions get_tree_ensemble_thresholds_dims(const TreeEnsemble&);
+TensorDimensions get_tree_ensemble_leaf_values_dims(const TreeEnsemble&);
+
+// Secure inference of a tree ensemble with public structure and secret
+// thresholds and leaf values for a batch of queries.  The features and
+// thresholds are converted to Yao, where all internal nodes are compared at
+// once and the leaf indicators are computed.  The indicators are single bits,
+// which are converted via the Boolean counterpart of the given arithmetic
+// protocol (ArithmeticBEAVY or ArithmeticGMW) with one OT or shared bit each
+// and multiplied with the leaf values, which yields a tensor of dimensions
+// (1, 1, 1, n) with the sum of the selected leaf values of all trees for each
+// of the n queries.
+TensorCP make_tree_ensemble_inference(NetworkBuilder&, MPCProtocol arithmetic_protocol,
+                                      const TreeEnsemble&, const TensorCP features,
+                                      const TensorCP thresholds, const TensorCP leaf_values);
+
+}  // namespace tensor
+}  // namespace MOTION
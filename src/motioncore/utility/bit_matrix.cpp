@@ -26,11 +26,14 @@
 
 #include <immintrin.h>
 #include <omp.h>
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 
 #include "crypto/pseudo_random_generator.h"
 #include "helpers.h"
+#include "utility/cpu_features.h"
 
 namespace ENCRYPTO {
 void BitMatrix::Transpose() {
@@ -261,6 +264,7 @@ void BitMatrix::Transpose128RowsInplace(std::array<std::byte*, 128>& matrix,
   }
 }
 
+MOTION_TARGET_CLONES
 void BitMatrix::Transpose128x128InPlace(std::array<std::uint64_t*, 128>& rows_64,
                                         std::array<std::uint32_t*, 128>& rows_32) {
   constexpr std::size_t blk_size = 128;
@@ -499,7 +503,8 @@ void BitMatrix::SenderTransposeAndEncrypt(const std::array<const std::byte*, 128
                                           std::vector<BitVector<>>& y0,
                                           std::vector<BitVector<>>& y1, const BitVector<> choices,
                                           PRG& prg_fixed_key, const std::size_t ncols,
-                                          const std::vector<std::size_t>& bitlengths) {
+                                          const std::vector<std::size_t>& bitlengths,
+                                          std::size_t num_threads) {
   constexpr std::size_t kappa{128}, nrows{128};
 #define INP(r, c)                                     \
   reinterpret_cast<const std::uint8_t* __restrict__>( \
@@ -514,9 +519,6 @@ void BitMatrix::SenderTransposeAndEncrypt(const std::array<const std::byte*, 128
 
   for (auto& bv : y0) bv = BitVector(std::vector<std::byte>(kappa / 8), kappa);
 
-  std::uint64_t r{0}, c{0};
-  int i{0};
-
   assert(nrows % 8 == 0 && ncols % 8 == 0);
 
 //#define MOTION_AVX2
@@ -564,58 +566,71 @@ void BitMatrix::SenderTransposeAndEncrypt(const std::array<const std::byte*, 128
     }
   }
 #else
-  __m128i vec;
-  PRG prg_var_key;
-  // process 128x128 blocks
-  while (c < ncols) {
-    auto c_old{c};
-    for (r = 0; r <= nrows - 16; r += 16) {
-      for (c = c_old; c == c_old || (c % 128 != 0); c += 8) {
-        // vec = _mm_set_epi8(INP(r + 8, c), INP(r + 9, c), INP(r + 10, c), INP(r + 11, c),
-        //                    INP(r + 12, c), INP(r + 13, c), INP(r + 14, c), INP(r + 15, c),
-        //                    INP(r + 0, c), INP(r + 1, c), INP(r + 2, c), INP(r + 3, c),
-        //                    INP(r + 4, c), INP(r + 5, c), INP(r + 6, c), INP(r + 7, c));
-        vec = _mm_set_epi8(INP(r + 15, c), INP(r + 14, c), INP(r + 13, c), INP(r + 12, c),
-                           INP(r + 11, c), INP(r + 10, c), INP(r + 9, c), INP(r + 8, c),
-                           INP(r + 7, c), INP(r + 6, c), INP(r + 5, c), INP(r + 4, c),
-                           INP(r + 3, c), INP(r + 2, c), INP(r + 1, c), INP(r + 0, c));
-        // for (i = 0; i < 8; vec = _mm_slli_epi64(vec, 1), ++i) {
-        for (i = 8; i > 0; vec = _mm_slli_epi64(vec, 1), --i) {
-          // *reinterpret_cast<std::uint16_t* __restrict__>(y0[c + i].GetMutableData().data() +
-          *reinterpret_cast<std::uint16_t* __restrict__>(y0[c + i - 1].GetMutableData().data() +
-                                                         r / 8) = _mm_movemask_epi8(vec);
+  // process 128x128 blocks, which are independent of each other
+  const std::size_t num_blocks{ncols / 128};
+#pragma omp parallel num_threads(num_threads)
+  {
+    __m128i vec;
+    PRG prg_var_key;
+    // inputs of the hash function for the 128 columns of a block, first all
+    // x_0 = q, then all x_1 = q ^ s
+    alignas(16) std::array<std::byte, 2 * 128 * 16> hash_buffer;
+    assert(choices.GetSize() == kappa);
+    const __m128i choices_block{
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(choices.GetData().data()))};
+#pragma omp for
+    for (std::size_t blk = 0; blk < num_blocks; ++blk) {
+      const std::size_t c_begin{blk * 128}, c_end{c_begin + 128};
+      for (std::size_t r = 0; r <= nrows - 16; r += 16) {
+        for (std::size_t c = c_begin; c < c_end; c += 8) {
+          vec = _mm_set_epi8(INP(r + 15, c), INP(r + 14, c), INP(r + 13, c), INP(r + 12, c),
+                             INP(r + 11, c), INP(r + 10, c), INP(r + 9, c), INP(r + 8, c),
+                             INP(r + 7, c), INP(r + 6, c), INP(r + 5, c), INP(r + 4, c),
+                             INP(r + 3, c), INP(r + 2, c), INP(r + 1, c), INP(r + 0, c));
+          for (int i = 8; i > 0; vec = _mm_slli_epi64(vec, 1), --i) {
+            *reinterpret_cast<std::uint16_t* __restrict__>(y0[c + i - 1].GetMutableData().data() +
+                                                           r / 8) = _mm_movemask_epi8(vec);
+          }
         }
       }
-    }
-    // XXX
-    for (; c_old < c && c_old < original_size; ++c_old) {
-      auto& out0 = y0[c_old];
-      auto& out1 = y1[c_old];
-
-      // bit length of the OT
-      const auto bitlen = bitlengths[c_old];
-
-      out1 = choices ^ out0;
-      assert(out0.GetSize() == 128);
-      assert(out1.GetSize() == 128);
-      // compute the sender outputs
-      if (bitlen <= kappa) {
-        // the bit length is smaller than 128 bit
-        prg_fixed_key.MMO(out0.GetMutableData().data());
-        prg_fixed_key.MMO(out1.GetMutableData().data());
-        out0.Resize(bitlen);
-        out1.Resize(bitlen);
-      } else {
-        // string OT with bit length > 128 bit
-        // -> do seed compression and send later only 128 bit seeds
-        prg_fixed_key.MMO(out0.GetMutableData().data());
-        prg_fixed_key.MMO(out1.GetMutableData().data());
-        prg_var_key.SetKey(out0.GetData().data());
-        out0 =
-            BitVector<>(prg_var_key.Encrypt(MOTION::Helpers::Convert::BitsToBytes(bitlen)), bitlen);
-        prg_var_key.SetKey(out1.GetData().data());
-        out1 =
-            BitVector<>(prg_var_key.Encrypt(MOTION::Helpers::Convert::BitsToBytes(bitlen)), bitlen);
+      // collect the inputs x_0 = q and x_1 = q ^ s of the hash function for
+      // all columns of this block, and hash them in one batch
+      const std::size_t num_hashed{std::min(c_end, std::max(c_begin, original_size)) - c_begin};
+      for (std::size_t k = 0; k < num_hashed; ++k) {
+        assert(y0[c_begin + k].GetSize() == 128);
+        const auto q = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(y0[c_begin + k].GetData().data()));
+        _mm_store_si128(reinterpret_cast<__m128i*>(hash_buffer.data()) + k, q);
+        _mm_store_si128(reinterpret_cast<__m128i*>(hash_buffer.data()) + 128 + k,
+                        _mm_xor_si128(q, choices_block));
+      }
+      prg_fixed_key.MMO(hash_buffer.data(), num_hashed);
+      prg_fixed_key.MMO(hash_buffer.data() + 128 * 16, num_hashed);
+
+      for (auto c = c_begin; c < c_begin + num_hashed; ++c) {
+        auto& out0 = y0[c];
+        auto& out1 = y1[c];
+
+        // bit length of the OT
+        const auto bitlen = bitlengths[c];
+
+        std::copy_n(hash_buffer.data() + (c - c_begin) * 16, 16, out0.GetMutableData().data());
+        out1 = BitVector<>(hash_buffer.data() + (128 + c - c_begin) * 16, kappa);
+        // compute the sender outputs
+        if (bitlen <= kappa) {
+          // the bit length is smaller than 128 bit
+          out0.Resize(bitlen);
+          out1.Resize(bitlen);
+        } else {
+          // string OT with bit length > 128 bit
+          // -> do seed compression and send later only 128 bit seeds
+          prg_var_key.SetKey(out0.GetData().data());
+          out0 = BitVector<>(prg_var_key.Encrypt(MOTION::Helpers::Convert::BitsToBytes(bitlen)),
+                             bitlen);
+          prg_var_key.SetKey(out1.GetData().data());
+          out1 = BitVector<>(prg_var_key.Encrypt(MOTION::Helpers::Convert::BitsToBytes(bitlen)),
+                             bitlen);
+        }
       }
     }
   }
@@ -625,7 +640,8 @@ void BitMatrix::SenderTransposeAndEncrypt(const std::array<const std::byte*, 128
 void BitMatrix::ReceiverTransposeAndEncrypt(const std::array<const std::byte*, 128>& matrix,
                                             std::vector<BitVector<>>& out, PRG& prg_fixed_key,
                                             const std::size_t ncols,
-                                            const std::vector<std::size_t>& bitlengths) {
+                                            const std::vector<std::size_t>& bitlengths,
+                                            std::size_t num_threads) {
   constexpr std::size_t kappa{128}, nrows{128};
 #define INP(r, c)                                     \
   reinterpret_cast<const std::uint8_t* __restrict__>( \
@@ -638,9 +654,6 @@ void BitMatrix::ReceiverTransposeAndEncrypt(const std::array<const std::byte*, 1
 
   for (auto& bv : out) bv = BitVector(std::vector<std::byte>(kappa / 8), kappa);
 
-  std::uint64_t r{0}, c{0};
-  int i{0};
-
   assert(nrows % 8 == 0 && ncols % 8 == 0);
 
 //#define MOTION_AVX2
@@ -688,43 +701,49 @@ void BitMatrix::ReceiverTransposeAndEncrypt(const std::array<const std::byte*, 1
     }
   }
 #else
-  __m128i vec;
-  PRG prg_var_key;
-  // process 128x128 blocks
-  while (c < ncols) {
-    auto c_old{c};
-    for (r = 0; r <= nrows - 16; r += 16) {
-      for (c = c_old; c == c_old || (c % 128 != 0); c += 8) {
-        // vec = _mm_set_epi8(INP(r + 8, c), INP(r + 9, c), INP(r + 10, c), INP(r + 11, c),
-        //                    INP(r + 12, c), INP(r + 13, c), INP(r + 14, c), INP(r + 15, c),
-        //                    INP(r + 0, c), INP(r + 1, c), INP(r + 2, c), INP(r + 3, c),
-        //                    INP(r + 4, c), INP(r + 5, c), INP(r + 6, c), INP(r + 7, c));
-        vec = _mm_set_epi8(INP(r + 15, c), INP(r + 14, c), INP(r + 13, c), INP(r + 12, c),
-                           INP(r + 11, c), INP(r + 10, c), INP(r + 9, c), INP(r + 8, c),
-                           INP(r + 7, c), INP(r + 6, c), INP(r + 5, c), INP(r + 4, c),
-                           INP(r + 3, c), INP(r + 2, c), INP(r + 1, c), INP(r + 0, c));
-        // for (i = 0; i < 8; vec = _mm_slli_epi64(vec, 1), ++i) {
-        for (i = 8; i > 0; vec = _mm_slli_epi64(vec, 1), --i) {
-          // *reinterpret_cast<std::uint16_t* __restrict__>(out[c + i].GetMutableData().data() +
-          *reinterpret_cast<std::uint16_t* __restrict__>(out[c + i - 1].GetMutableData().data() +
-                                                         r / 8) = _mm_movemask_epi8(vec);
+  // process 128x128 blocks, which are independent of each other
+  const std::size_t num_blocks{ncols / 128};
+#pragma omp parallel num_threads(num_threads)
+  {
+    __m128i vec;
+    PRG prg_var_key;
+    alignas(16) std::array<std::byte, 128 * 16> hash_buffer;
+#pragma omp for
+    for (std::size_t blk = 0; blk < num_blocks; ++blk) {
+      const std::size_t c_begin{blk * 128}, c_end{c_begin + 128};
+      for (std::size_t r = 0; r <= nrows - 16; r += 16) {
+        for (std::size_t c = c_begin; c < c_end; c += 8) {
+          vec = _mm_set_epi8(INP(r + 15, c), INP(r + 14, c), INP(r + 13, c), INP(r + 12, c),
+                             INP(r + 11, c), INP(r + 10, c), INP(r + 9, c), INP(r + 8, c),
+                             INP(r + 7, c), INP(r + 6, c), INP(r + 5, c), INP(r + 4, c),
+                             INP(r + 3, c), INP(r + 2, c), INP(r + 1, c), INP(r + 0, c));
+          for (int i = 8; i > 0; vec = _mm_slli_epi64(vec, 1), --i) {
+            *reinterpret_cast<std::uint16_t* __restrict__>(out[c + i - 1].GetMutableData().data() +
+                                                           r / 8) = _mm_movemask_epi8(vec);
+          }
         }
       }
-    }
-    // XXX
-    for (; c_old < c && c_old < original_size; ++c_old) {
-        auto &o = out[c_old];
-        assert(o.GetSize() == 128);
-        const std::size_t bitlen = bitlengths[c_old];
+      // hash the outputs of all columns of this block in one batch
+      const std::size_t num_hashed{std::min(c_end, std::max(c_begin, original_size)) - c_begin};
+      for (std::size_t k = 0; k < num_hashed; ++k) {
+        assert(out[c_begin + k].GetSize() == 128);
+        std::copy_n(out[c_begin + k].GetData().data(), 16, hash_buffer.data() + k * 16);
+      }
+      prg_fixed_key.MMO(hash_buffer.data(), num_hashed);
+
+      for (auto c = c_begin; c < c_begin + num_hashed; ++c) {
+        auto& o = out[c];
+        const std::size_t bitlen = bitlengths[c];
+        std::copy_n(hash_buffer.data() + (c - c_begin) * 16, 16, o.GetMutableData().data());
 
         if (bitlen <= kappa) {
-          prg_fixed_key.MMO(o.GetMutableData().data());
           o.Resize(bitlen);
         } else {
-          prg_fixed_key.MMO(o.GetMutableData().data());
           prg_var_key.SetKey(o.GetData().data());
-          o = BitVector<>(prg_var_key.Encrypt(MOTION::Helpers::Convert::BitsToBytes(bitlen)), bitlen);
+          o = BitVector<>(prg_var_key.Encrypt(MOTION::Helpers::Convert::BitsToBytes(bitlen)),
+                          bitlen);
         }
+      }
     }
   }
 #endif
@@ -119,16 +119,20 @@ class BitMatrix {
   static void TransposeUsingBitSlicing(std::array<std::byte*, 128>& matrix,
                                        std::size_t num_columns);
 
+  // The following functions process the 128-column blocks of the matrix with
+  // num_threads threads in parallel.  prg_fixed_key is shared between the threads.
   static void SenderTransposeAndEncrypt(const std::array<const std::byte*, 128>& matrix,
                                         std::vector<BitVector<>>& y0, std::vector<BitVector<>>& y1,
                                         const BitVector<> choices, PRG& prg_fixed_key,
                                         const std::size_t ncols,
-                                        const std::vector<std::size_t>& bitlengths);
+                                        const std::vector<std::size_t>& bitlengths,
+                                        std::size_t num_threads = 1);
 
   static void ReceiverTransposeAndEncrypt(const std::array<const std::byte*, 128>& matrix,
                                           std::vector<BitVector<>>& out, PRG& prg_fixed_key,
                                           const std::size_t ncols,
-                                          const std::vector<std::size_t>& bitlengths);
+                                          const std::vector<std::size_t>& bitlengths,
+                                          std::size_t num_threads = 1);
 
   bool operator==(const BitMatrix& other);
 
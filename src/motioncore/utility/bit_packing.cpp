@@ -0,0 +1,167 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "bit_packing.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include "utility/type_traits.hpp"
+
+namespace MOTION {
+
+template <typename T>
+static void check_bit_width(std::size_t bit_width) {
+  if (bit_width == 0 || bit_width > ENCRYPTO::bit_size_v<T>) {
+    throw std::invalid_argument(fmt::format("invalid bit width {} for {}-bit integers", bit_width,
+                                            ENCRYPTO::bit_size_v<T>));
+  }
+}
+
+static void store_word(std::uint8_t* dst, std::uint64_t word, std::size_t num_bytes) {
+  for (std::size_t i = 0; i < num_bytes; ++i) {
+    dst[i] = static_cast<std::uint8_t>(word >> (8 * i));
+  }
+}
+
+static std::uint64_t load_word(const std::uint8_t* src, std::size_t num_bytes) {
+  std::uint64_t word = 0;
+  for (std::size_t i = 0; i < num_bytes; ++i) {
+    word |= std::uint64_t(src[i]) << (8 * i);
+  }
+  return word;
+}
+
+template <typename T>
+void pack_ints(std::uint8_t* dst, const T* src, std::size_t n, std::size_t bit_width) {
+  check_bit_width<T>(bit_width);
+  if (bit_width == ENCRYPTO::bit_size_v<T> && bit_width % 8 == 0) {
+    std::memcpy(dst, src, n * sizeof(T));
+    return;
+  }
+  const std::uint64_t mask =
+      bit_width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bit_width) - 1;
+  // bits are collected in acc until a full word can be written
+  std::uint64_t acc = 0;
+  std::size_t acc_bits = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::uint64_t v = src[i] & mask;
+    acc |= v << acc_bits;
+    if (acc_bits + bit_width >= 64) {
+      store_word(dst, acc, 8);
+      dst += 8;
+      acc = acc_bits == 0 ? 0 : v >> (64 - acc_bits);
+      acc_bits = acc_bits + bit_width - 64;
+    } else {
+      acc_bits += bit_width;
+    }
+  }
+  store_word(dst, acc, (acc_bits + 7) / 8);
+}
+
+template <typename T>
+std::vector<std::uint8_t> pack_ints(const std::vector<T>& src, std::size_t bit_width) {
+  std::vector<std::uint8_t> dst(packed_ints_size(src.size(), bit_width));
+  pack_ints(dst.data(), src.data(), src.size(), bit_width);
+  return dst;
+}
+
+template <typename T>
+void unpack_ints(T* dst, const std::uint8_t* src, std::size_t n, std::size_t bit_width) {
+  check_bit_width<T>(bit_width);
+  if (bit_width == ENCRYPTO::bit_size_v<T> && bit_width % 8 == 0) {
+    std::memcpy(dst, src, n * sizeof(T));
+    return;
+  }
+  const std::uint64_t mask =
+      bit_width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bit_width) - 1;
+  auto remaining_bytes = packed_ints_size(n, bit_width);
+  // bits which have been loaded, but not yet consumed
+  std::uint64_t acc = 0;
+  std::size_t acc_bits = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t v;
+    if (acc_bits >= bit_width) {
+      v = acc;
+      acc = bit_width == 64 ? 0 : acc >> bit_width;
+      acc_bits -= bit_width;
+    } else {
+      const auto num_bytes = std::min<std::size_t>(8, remaining_bytes);
+      const auto next = load_word(src, num_bytes);
+      src += num_bytes;
+      remaining_bytes -= num_bytes;
+      v = acc | (next << acc_bits);
+      const auto consumed_bits = bit_width - acc_bits;
+      acc = consumed_bits == 64 ? 0 : next >> consumed_bits;
+      acc_bits = 8 * num_bytes - consumed_bits;
+    }
+    dst[i] = static_cast<T>(v & mask);
+  }
+}
+
+template <typename T>
+std::vector<T> unpack_ints(const std::uint8_t* src, std::size_t n, std::size_t bit_width) {
+  std::vector<T> dst(n);
+  unpack_ints(dst.data(), src, n, bit_width);
+  return dst;
+}
+
+template <typename T>
+void sign_extend_ints(T* buffer, std::size_t n, std::size_t bit_width) {
+  check_bit_width<T>(bit_width);
+  const auto shift = ENCRYPTO::bit_size_v<T> - bit_width;
+  if (shift == 0) {
+    return;
+  }
+  using S = std::make_signed_t<T>;
+  for (std::size_t i = 0; i < n; ++i) {
+    buffer[i] = static_cast<T>(static_cast<S>(static_cast<T>(buffer[i] << shift)) >> shift);
+  }
+}
+
+template void pack_ints(std::uint8_t*, const std::uint8_t*, std::size_t, std::size_t);
+template void pack_ints(std::uint8_t*, const std::uint16_t*, std::size_t, std::size_t);
+template void pack_ints(std::uint8_t*, const std::uint32_t*, std::size_t, std::size_t);
+template void pack_ints(std::uint8_t*, const std::uint64_t*, std::size_t, std::size_t);
+template std::vector<std::uint8_t> pack_ints(const std::vector<std::uint8_t>&, std::size_t);
+template std::vector<std::uint8_t> pack_ints(const std::vector<std::uint16_t>&, std::size_t);
+template std::vector<std::uint8_t> pack_ints(const std::vector<std::uint32_t>&, std::size_t);
+template std::vector<std::uint8_t> pack_ints(const std::vector<std::uint64_t>&, std::size_t);
+template void unpack_ints(std::uint8_t*, const std::uint8_t*, std::size_t, std::size_t);
+template void unpack_ints(std::uint16_t*, const std::uint8_t*, std::size_t, std::size_t);
+template void unpack_ints(std::uint32_t*, const std::uint8_t*, std::size_t, std::size_t);
+template void unpack_ints(std::uint64_t*, const std::uint8_t*, std::size_t, std::size_t);
+template std::vector<std::uint8_t> unpack_ints(const std::uint8_t*, std::size_t, std::size_t);
+template std::vector<std::uint16_t> unpack_ints(const std::uint8_t*, std::size_t, std::size_t);
+template std::vector<std::uint32_t> unpack_ints(const std::uint8_t*, std::size_t, std::size_t);
+template std::vector<std::uint64_t> unpack_ints(const std::uint8_t*, std::size_t, std::size_t);
+template void sign_extend_ints(std::uint8_t*, std::size_t, std::size_t);
+template void sign_extend_ints(std::uint16_t*, std::size_t, std::size_t);
+template void sign_extend_ints(std::uint32_t*, std::size_t, std::size_t);
+template void sign_extend_ints(std::uint64_t*, std::size_t, std::size_t);
+
+}  // namespace MOTION
@@ -0,0 +1,62 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MOTION {
+
+// Bit-packed serialization of ring elements
+//
+// Only the lowest `bit_width` bits of each element are stored, and the
+// elements are concatenated without padding (little endian, LSB first).
+// Unpacking yields the elements reduced modulo 2^bit_width.  This is useful to
+// send values whose effective width is known to be smaller than the width of
+// the type T, e.g., outputs that fit into a small number of bits.
+
+// Number of bytes required to pack n elements of width bit_width.
+constexpr std::size_t packed_ints_size(std::size_t n, std::size_t bit_width) {
+  return (n * bit_width + 7) / 8;
+}
+
+template <typename T>
+void pack_ints(std::uint8_t* dst, const T* src, std::size_t n, std::size_t bit_width);
+
+template <typename T>
+std::vector<std::uint8_t> pack_ints(const std::vector<T>& src, std::size_t bit_width);
+
+template <typename T>
+void unpack_ints(T* dst, const std::uint8_t* src, std::size_t n, std::size_t bit_width);
+
+template <typename T>
+std::vector<T> unpack_ints(const std::uint8_t* src, std::size_t n, std::size_t bit_width);
+
+// Interpret the lowest bit_width bits of each element as two's complement
+// number and sign-extend it to the full width of T.
+template <typename T>
+void sign_extend_ints(T* buffer, std::size_t n, std::size_t bit_width);
+
+}  // namespace MOTION
@@ -24,6 +24,7 @@
 
 #include "bit_vector.h"
 #include "crypto/random/aes128_ctr_rng.h"
+#include "utility/cpu_features.h"
 
 namespace ENCRYPTO {
 
@@ -88,12 +89,28 @@ inline bool AlignedEQImpl(const T* ptr1, const U* ptr2, const std::size_t byte_s
   return std::equal(ptr1_cast, ptr1_cast + byte_size, ptr2_cast);
 }
 
+// Byte-wise kernels shared by the functions below.  They are compiled for
+// several instruction sets, cf. MOTION_TARGET_CLONES.
+MOTION_TARGET_CLONES static void XORBytes(const std::byte* in, std::byte* res,
+                                          const std::size_t byte_size) {
+  for (std::size_t i = 0; i < byte_size; ++i) res[i] ^= in[i];
+}
+
+MOTION_TARGET_CLONES static void ANDBytes(const std::byte* in, std::byte* res,
+                                          const std::size_t byte_size) {
+  for (std::size_t i = 0; i < byte_size; ++i) res[i] &= in[i];
+}
+
+MOTION_TARGET_CLONES static void ORBytes(const std::byte* in, std::byte* res,
+                                         const std::size_t byte_size) {
+  for (std::size_t i = 0; i < byte_size; ++i) res[i] |= in[i];
+}
+
 template <typename T, typename U>
 inline void XORImpl(const T* in, U* res, const std::size_t byte_size) {
   const auto in_cast{reinterpret_cast<const std::byte*>(in)};
   auto res_cast{reinterpret_cast<std::byte*>(res)};
-  std::transform(in_cast, in_cast + byte_size, res_cast, res_cast,
-                 [](const std::byte& a, const std::byte& b) { return a ^ b; });
+  XORBytes(in_cast, res_cast, byte_size);
 }
 
 // TODO: check how good this is vectorized
@@ -103,16 +120,14 @@ inline void AlignedXORImpl(const T* in, U* res, const std::size_t byte_size) {
       reinterpret_cast<const std::byte*>(__builtin_assume_aligned(in, MOTION::MOTION_ALIGNMENT))};
   auto res_cast{
       reinterpret_cast<std::byte*>(__builtin_assume_aligned(res, MOTION::MOTION_ALIGNMENT))};
-  std::transform(in_cast, in_cast + byte_size, res_cast, res_cast,
-                 [](const std::byte& a, const std::byte& b) { return a ^ b; });
+  XORBytes(in_cast, res_cast, byte_size);
 }
 
 template <typename T, typename U>
 inline void ANDImpl(const T* in, U* res, const std::size_t byte_size) {
   const auto in_cast{reinterpret_cast<const std::byte*>(in)};
   auto res_cast{reinterpret_cast<std::byte*>(res)};
-  std::transform(in_cast, in_cast + byte_size, res_cast, res_cast,
-                 [](const std::byte& a, const std::byte& b) { return a & b; });
+  ANDBytes(in_cast, res_cast, byte_size);
 }
 
 template <typename T, typename U>
@@ -121,16 +136,14 @@ inline void AlignedANDImpl(const T* in, U* res, const std::size_t byte_size) {
       reinterpret_cast<const std::byte*>(__builtin_assume_aligned(in, MOTION::MOTION_ALIGNMENT))};
   auto res_cast{
       reinterpret_cast<std::byte*>(__builtin_assume_aligned(res, MOTION::MOTION_ALIGNMENT))};
-  std::transform(in_cast, in_cast + byte_size, res_cast, res_cast,
-                 [](const std::byte& a, const std::byte& b) { return a & b; });
+  ANDBytes(in_cast, res_cast, byte_size);
 }
 
 template <typename T, typename U>
 inline void ORImpl(const T* in, U* res, const std::size_t byte_size) {
   const auto in_cast{reinterpret_cast<const std::byte*>(in)};
   auto res_cast{reinterpret_cast<std::byte*>(res)};
-  std::transform(in_cast, in_cast + byte_size, res_cast, res_cast,
-                 [](const std::byte& a, const std::byte& b) { return a | b; });
+  ORBytes(in_cast, res_cast, byte_size);
 }
 
 template <typename T, typename U>
@@ -139,8 +152,7 @@ inline void AlignedORImpl(const T* in, U* res, const std::size_t byte_size) {
       reinterpret_cast<const std::byte*>(__builtin_assume_aligned(in, MOTION::MOTION_ALIGNMENT))};
   auto res_cast{
       reinterpret_cast<std::byte*>(__builtin_assume_aligned(res, MOTION::MOTION_ALIGNMENT))};
-  std::transform(in_cast, in_cast + byte_size, res_cast, res_cast,
-                 [](const std::byte& a, const std::byte& b) { return a | b; });
+  ORBytes(in_cast, res_cast, byte_size);
 }
 
 inline void CopyImpl(const std::size_t from, const std::size_t to, std::byte* src, std::byte* dst) {
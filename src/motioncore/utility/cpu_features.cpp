@@ -0,0 +1,97 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "cpu_features.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace MOTION {
+
+static CpuFeatures detect_cpu_features() {
+  CpuFeatures features{};
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  features.sse4_2 = __builtin_cpu_supports("sse4.2");
+  features.aes = __builtin_cpu_supports("aes");
+  features.pclmul = __builtin_cpu_supports("pclmul");
+  features.avx2 = __builtin_cpu_supports("avx2");
+  features.avx512f = __builtin_cpu_supports("avx512f");
+  features.avx512bw = __builtin_cpu_supports("avx512bw");
+  features.vaes = __builtin_cpu_supports("vaes");
+#endif
+  return features;
+}
+
+const CpuFeatures& CpuFeatures::get() {
+  static const CpuFeatures features = detect_cpu_features();
+  return features;
+}
+
+const char* get_target_clones_variant() {
+#if defined(__x86_64__)
+  const auto& features = CpuFeatures::get();
+  // same priority as the resolver of MOTION_TARGET_CLONES
+  if (features.avx512f) {
+    return "avx512f";
+  } else if (features.avx2) {
+    return "avx2";
+  }
+#endif
+  return "default";
+}
+
+namespace {
+
+struct KernelVariants {
+  std::mutex mutex;
+  std::vector<std::pair<std::string, std::string>> variants;
+};
+
+// kernels may be registered during static initialization of other units
+KernelVariants& get_kernel_variants_instance() {
+  static KernelVariants instance;
+  return instance;
+}
+
+}  // namespace
+
+void register_kernel_variant(const std::string& kernel, const std::string& variant) {
+  auto& [mutex, variants] = get_kernel_variants_instance();
+  std::scoped_lock lock(mutex);
+  auto it = std::find_if(std::begin(variants), std::end(variants),
+                         [&kernel](const auto& p) { return p.first == kernel; });
+  if (it == std::end(variants)) {
+    variants.emplace_back(kernel, variant);
+  } else {
+    it->second = variant;
+  }
+}
+
+std::vector<std::pair<std::string, std::string>> get_kernel_variants() {
+  auto& [mutex, variants] = get_kernel_variants_instance();
+  std::scoped_lock lock(mutex);
+  return variants;
+}
+
+}  // namespace MOTION
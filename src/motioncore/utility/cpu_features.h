@@ -0,0 +1,62 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Compiles a function for several instruction sets; the dynamic loader picks
+// the best one supported by the CPU.  This is meant for loops that the
+// compiler vectorizes automatically.
+#if defined(__x86_64__) && (defined(__clang__) ? (__clang_major__ >= 14) : defined(__GNUC__))
+#define MOTION_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define MOTION_TARGET_CLONES
+#endif
+
+namespace MOTION {
+
+// instruction set extensions available on the CPU, detected at runtime
+struct CpuFeatures {
+  bool sse4_2;
+  bool aes;
+  bool pclmul;
+  bool avx2;
+  bool avx512f;
+  bool avx512bw;
+  bool vaes;
+
+  static const CpuFeatures& get();
+};
+
+// name of the variant of MOTION_TARGET_CLONES functions used on this CPU
+const char* get_target_clones_variant();
+
+// Records which implementation of a kernel has been selected at runtime.
+// The selections are reported together with the run time statistics.
+void register_kernel_variant(const std::string& kernel, const std::string& variant);
+std::vector<std::pair<std::string, std::string>> get_kernel_variants();
+
+}  // namespace MOTION
@@ -22,6 +22,7 @@
 
 #include "linear_algebra.h"
 
+#include <array>
 #include <cassert>
 
 #include <Eigen/Core>
@@ -189,6 +190,18 @@ void convolution(const tensor::Conv2DOp& conv_op, const T* input_buffer, const T
   using CTensorType3 = Eigen::Tensor<const T, 3, Eigen::RowMajor>;
   using CTensorType4 = Eigen::Tensor<const T, 4, Eigen::RowMajor>;
   assert(conv_op.verify());
+  if (conv_op.group_ > 1) {
+    // the groups are independent dense convolutions on consecutive channels
+    const auto group_op = conv_op.get_group_op();
+    const auto input_size = group_op.compute_input_size();
+    const auto kernel_size = group_op.compute_kernel_size();
+    const auto output_size = group_op.compute_output_size();
+    for (std::size_t group_i = 0; group_i < conv_op.group_; ++group_i) {
+      convolution(group_op, input_buffer + group_i * input_size,
+                  kernel_buffer + group_i * kernel_size, output_buffer + group_i * output_size);
+    }
+    return;
+  }
   const auto& output_shape = conv_op.output_shape_;
   const auto& input_shape = conv_op.input_shape_;
   const auto& kernel_shape = conv_op.kernel_shape_;
@@ -297,4 +310,38 @@ template void sum_pool(const tensor::AveragePoolOp&, const std::uint32_t*, std::
 template void sum_pool(const tensor::AveragePoolOp&, const std::uint64_t*, std::uint64_t*);
 template void sum_pool(const tensor::AveragePoolOp&, const __uint128_t*, __uint128_t*);
 
+template <typename T>
+void sum_reduce(const tensor::TensorDimensions& dims, std::size_t axis, const T* input,
+                T* output) {
+  assert(axis < 4);
+  using TensorType4C = Eigen::Tensor<const T, 4, Eigen::RowMajor>;
+  using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
+  const std::array<Eigen::Index, 4> in_dims = {
+      static_cast<Eigen::Index>(dims.batch_size_), static_cast<Eigen::Index>(dims.num_channels_),
+      static_cast<Eigen::Index>(dims.height_), static_cast<Eigen::Index>(dims.width_)};
+  // the remaining dimensions keep their row-major order
+  Eigen::array<Eigen::Index, 3> out_dims;
+  for (std::size_t i = 0, j = 0; i < 4; ++i) {
+    if (i != axis) {
+      out_dims[j++] = in_dims[i];
+    }
+  }
+
+  Eigen::TensorMap<TensorType4C> tensor_src(input, in_dims[0], in_dims[1], in_dims[2], in_dims[3]);
+  Eigen::TensorMap<TensorType3> tensor_dst(output, out_dims);
+
+  tensor_dst = tensor_src.sum(Eigen::array<Eigen::Index, 1>{static_cast<Eigen::Index>(axis)});
+}
+
+template void sum_reduce(const tensor::TensorDimensions&, std::size_t, const std::uint8_t*,
+                         std::uint8_t*);
+template void sum_reduce(const tensor::TensorDimensions&, std::size_t, const std::uint16_t*,
+                         std::uint16_t*);
+template void sum_reduce(const tensor::TensorDimensions&, std::size_t, const std::uint32_t*,
+                         std::uint32_t*);
+template void sum_reduce(const tensor::TensorDimensions&, std::size_t, const std::uint64_t*,
+                         std::uint64_t*);
+template void sum_reduce(const tensor::TensorDimensions&, std::size_t, const __uint128_t*,
+                         __uint128_t*);
+
 }  // namespace MOTION
@@ -28,6 +28,7 @@
 namespace MOTION {
 
 namespace tensor {
+struct TensorDimensions;
 struct MaxPoolOp;
 using AveragePoolOp = MaxPoolOp;
 struct Conv2DOp;
@@ -67,4 +68,8 @@ void convolution(const tensor::Conv2DOp&, const T* input, const T* kernel, T* ou
 template <typename T>
 void sum_pool(const tensor::AveragePoolOp&, const T* input, T* output);
 
+// sum over one axis of a tensor in NCHW layout, cf. tensor::reduce
+template <typename T>
+void sum_reduce(const tensor::TensorDimensions&, std::size_t axis, const T* input, T* output);
+
 }  // namespace MOTION
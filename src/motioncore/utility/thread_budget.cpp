@@ -0,0 +1,69 @@
+// Copyright 2019 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#pragma once
+
+#include "thread_budget.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace MOTION {
+
+ThreadBudget::Lease::Lease(Lease&& other) noexcept
+    : budget_(other.budget_), num_threads_(other.num_threads_) {
+  other.budget_ = nullptr;
+  other.num_threads_ = 0;
+}
+
+ThreadBudget::Lease::~Lease() {
+  if (budget_ != nullptr) {
+    budget_->release(num_threads_);
+  }
+}
+
+ThreadBudget::ThreadBudget(std::size_t num_threads)
+    : num_threads_(num_threads == 0 ? std::max(1u, std::thread::hardware_concurrency())
+                                    : num_threads),
+      num_available_threads_(num_threads_) {}
+
+ThreadBudget::Lease ThreadBudget::acquire(std::size_t max_threads) {
+  std::unique_lock lock(mutex_);
+  cv_.wait(lock, [this] { return num_available_threads_ > 0; });
+  const auto num_threads =
+      max_threads == 0 ? num_available_threads_ : std::min(max_threads, num_available_threads_);
+  num_available_threads_ -= num_threads;
+  return Lease(*this, num_threads);
+}
+
+std::size_t ThreadBudget::get_num_available_threads() const {
+  std::scoped_lock lock(mutex_);
+  return num_available_threads_;
+}
+
+void ThreadBudget::release(std::size_t num_threads) {
+  {
+    std::scoped_lock lock(mutex_);
+    num_available_threads_ += num_threads;
+  }
+  cv_.notify_all();
+}
+
+}  // namespace MOTION
@@ -0,0 +1,75 @@
+// Copyright 2019 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#pragma once
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace MOTION {
+
+// Number of threads shared by several backends which are evaluated
+// concurrently, e.g., on the sessions of a Communication::SessionMultiplexer.
+// Each evaluation leases a part of the budget for its OpenMP regions and its
+// fiber pool and returns it when it is finished, so that the backends
+// together do not use more than the given number of threads.
+class ThreadBudget {
+ public:
+  // Threads leased from the budget, which are returned on destruction
+  class Lease {
+   public:
+    Lease(Lease&& other) noexcept;
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    Lease& operator=(Lease&&) = delete;
+    ~Lease();
+    std::size_t get_num_threads() const noexcept { return num_threads_; }
+
+   private:
+    friend class ThreadBudget;
+    Lease(ThreadBudget& budget, std::size_t num_threads)
+        : budget_(&budget), num_threads_(num_threads) {}
+    ThreadBudget* budget_;
+    std::size_t num_threads_;
+  };
+
+  // num_threads == 0 selects std::thread::hardware_concurrency()
+  explicit ThreadBudget(std::size_t num_threads);
+
+  // Lease up to max_threads threads (all threads if max_threads == 0), blocks
+  // until at least one thread is available
+  Lease acquire(std::size_t max_threads);
+
+  std::size_t get_num_threads() const noexcept { return num_threads_; }
+  std::size_t get_num_available_threads() const;
+
+ private:
+  void release(std::size_t num_threads);
+
+  const std::size_t num_threads_;
+  std::size_t num_available_threads_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace MOTION
@@ -130,6 +130,41 @@ TEST(aesni128, ctr_stream_blockwise) {
   EXPECT_EQ(output, expected_output);
 }
 
+// The batched functions may use a different implementation depending on the
+// CPU (cf. utility/cpu_features.h), so compare them with the blockwise one.
+TEST(aesni128, ctr_stream_batched_equals_blockwise) {
+  std::array<std::uint8_t, aes_key_size_128> key = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                                    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+  alignas(aes_block_size) std::array<std::uint8_t, aes_round_keys_size_128> round_keys;
+  std::copy(std::begin(key), std::end(key), std::begin(round_keys));
+  aesni_key_expansion_128(round_keys.data());
+
+  constexpr std::size_t max_num_blocks = 43;
+  std::array<std::uint8_t, max_num_blocks * aes_block_size> expected_output;
+  std::uint64_t expected_counter = 42;
+  for (std::size_t n = 0; n < max_num_blocks; ++n) {
+    aesni_ctr_stream_single_block_128_unaligned(round_keys.data(), &expected_counter,
+                                                expected_output.data() + n * aes_block_size);
+  }
+
+  alignas(aes_block_size) std::array<std::uint8_t, max_num_blocks * aes_block_size> output;
+  std::array<std::uint8_t, max_num_blocks * aes_block_size + 1> output_unaligned;
+  for (std::size_t n : {1, 7, 8, 9, 16, 31, 43}) {
+    std::uint64_t counter = 42;
+    aesni_ctr_stream_blocks_128(round_keys.data(), &counter, output.data(), n);
+    EXPECT_EQ(counter, 42 + n);
+    EXPECT_TRUE(std::equal(std::begin(output), std::begin(output) + n * aes_block_size,
+                           std::begin(expected_output)));
+    counter = 42;
+    aesni_ctr_stream_blocks_128_unaligned(round_keys.data(), &counter,
+                                          output_unaligned.data() + 1, n);
+    EXPECT_EQ(counter, 42 + n);
+    EXPECT_TRUE(std::equal(std::begin(output_unaligned) + 1,
+                           std::begin(output_unaligned) + 1 + n * aes_block_size,
+                           std::begin(expected_output)));
+  }
+}
+
 TEST(aesni128, tmmo_batch_4) {
   std::array<std::uint8_t, aes_key_size_128> key = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
                                                     0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
@@ -172,3 +207,25 @@ TEST(aesni128, mmo_single) {
   aesni_mmo_single(round_keys.data(), output.data());
   EXPECT_EQ(output, expected_output);
 }
+
+TEST(aesni128, mmo_batch_equals_single) {
+  std::array<std::uint8_t, aes_key_size_128> key = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                                    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+  alignas(aes_block_size) std::array<std::uint8_t, aes_round_keys_size_128> round_keys;
+  std::copy(std::begin(key), std::end(key), std::begin(round_keys));
+  aesni_key_expansion_128(round_keys.data());
+
+  // not a multiple of the batch size
+  const std::size_t num_blocks = 11;
+  std::vector<std::uint8_t> input(num_blocks * aes_block_size);
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<std::uint8_t>(i);
+  }
+  auto expected_output = input;
+  for (std::size_t i = 0; i < num_blocks; ++i) {
+    aesni_mmo_single(round_keys.data(), expected_output.data() + i * aes_block_size);
+  }
+  auto output = input;
+  aesni_mmo_batch(round_keys.data(), output.data(), num_blocks);
+  EXPECT_EQ(output, expected_output);
+}
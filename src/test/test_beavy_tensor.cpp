@@ -20,9 +20,13 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <iterator>
 #include <memory>
+#include <random>
+#include <type_traits>
 
 #include <gtest/gtest.h>
 
@@ -36,7 +40,9 @@
 #include "gate/new_gate.h"
 #include "protocols/beavy/beavy_provider.h"
 #include "protocols/beavy/tensor.h"
+#include "protocols/beavy/tensor_kernels.h"
 #include "statistics/run_time_stats.h"
+#include "utility/fixed_point.h"
 #include "utility/helpers.h"
 #include "utility/linear_algebra.h"
 #include "utility/logger.h"
@@ -170,13 +176,13 @@ class ArithmeticBEAVYTensorTest : public BEAVYTensorTest {
     }
   }
   ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<T>> make_arithmetic_T_tensor_output_my(
-      std::size_t party_id, const MOTION::tensor::TensorCP& in) {
+      std::size_t party_id, const MOTION::tensor::TensorCP& in, std::size_t output_bit_size = 0) {
     auto& bp = *beavy_providers_.at(party_id);
     if constexpr (ENCRYPTO::bit_size_v<T> == 64) {
-      return bp.make_arithmetic_64_tensor_output_my(in);
+      return bp.make_arithmetic_64_tensor_output_my(in, output_bit_size);
     } else {
       static_assert(ENCRYPTO::bit_size_v<T> == 32);
-      return bp.make_arithmetic_32_tensor_output_my(in);
+      return bp.make_arithmetic_32_tensor_output_my(in, output_bit_size);
     }
   }
 };
@@ -294,6 +300,33 @@ TYPED_TEST(ArithmeticBEAVYTensorTest, OutputSingle) {
   ASSERT_EQ(input_a, output);
 }
 
+TYPED_TEST(ArithmeticBEAVYTensorTest, OutputReducedBitSize) {
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 28, .width_ = 28};
+  constexpr std::size_t output_bit_size = 12;
+  // signed values that fit into output_bit_size bits
+  auto input_a = this->generate_inputs(dims);
+  for (auto& x : input_a) {
+    x = TypeParam(std::make_signed_t<TypeParam>(x) >>
+                  (ENCRYPTO::bit_size_v<TypeParam> - output_bit_size));
+  }
+
+  auto [input_a_promise, tensor_a_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_a_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  this->beavy_providers_[0]->make_arithmetic_tensor_output_other(tensor_a_in_0, output_bit_size);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, tensor_a_in_1, output_bit_size);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_a_promise.set_value(input_a);
+  this->run_gates_online();
+
+  auto output = output_future.get();
+
+  ASSERT_EQ(output.size(), dims.get_data_size());
+  ASSERT_EQ(input_a, output);
+}
+
 TYPED_TEST(ArithmeticBEAVYTensorTest, Convolution) {
   // Convolution from CryptoNets
   const MOTION::tensor::Conv2DOp conv_op = {.kernel_shape_ = {5, 1, 5, 5},
@@ -357,6 +390,69 @@ TYPED_TEST(ArithmeticBEAVYTensorTest, Convolution) {
   ASSERT_EQ(plain_output, expected_output);
 }
 
+TYPED_TEST(ArithmeticBEAVYTensorTest, GroupedConvolution) {
+  const MOTION::tensor::Conv2DOp conv_op = {.kernel_shape_ = {4, 2, 3, 3},
+                                            .input_shape_ = {4, 8, 8},
+                                            .output_shape_ = {4, 8, 8},
+                                            .dilations_ = {1, 1},
+                                            .pads_ = {1, 1, 1, 1},
+                                            .strides_ = {1, 1},
+                                            .group_ = 2};
+  ASSERT_TRUE(conv_op.verify());
+  const auto input_dims = conv_op.get_input_tensor_dims();
+  const auto kernel_dims = conv_op.get_kernel_tensor_dims();
+  const auto output_dims = conv_op.get_output_tensor_dims();
+  const auto input = this->generate_inputs(input_dims);
+  const auto kernel = this->generate_inputs(kernel_dims);
+
+  auto [input_promise, tensor_input_0] = this->make_arithmetic_T_tensor_input_my(0, input_dims);
+  auto tensor_input_1 = this->make_arithmetic_T_tensor_input_other(1, input_dims);
+  auto tensor_kernel_0 = this->make_arithmetic_T_tensor_input_other(0, kernel_dims);
+  auto [kernel_promise, tensor_kernel_1] = this->make_arithmetic_T_tensor_input_my(1, kernel_dims);
+
+  ASSERT_EQ(tensor_input_0->get_dimensions(), input_dims);
+  ASSERT_EQ(tensor_input_1->get_dimensions(), input_dims);
+  ASSERT_EQ(tensor_kernel_0->get_dimensions(), kernel_dims);
+  ASSERT_EQ(tensor_kernel_1->get_dimensions(), kernel_dims);
+
+  auto tensor_output_0 =
+      this->beavy_providers_[0]->make_tensor_conv2d_op(conv_op, tensor_input_0, tensor_kernel_0);
+  auto tensor_output_1 =
+      this->beavy_providers_[1]->make_tensor_conv2d_op(conv_op, tensor_input_1, tensor_kernel_1);
+
+  ASSERT_EQ(tensor_output_0->get_dimensions(), output_dims);
+  ASSERT_EQ(tensor_output_1->get_dimensions(), output_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  kernel_promise.set_value(kernel);
+  this->run_gates_online();
+
+  const auto output_beavy_tensor_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_0);
+  const auto output_beavy_tensor_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_1);
+
+  const auto& public_output_share_0 = output_beavy_tensor_0->get_public_share();
+  const auto& public_output_share_1 = output_beavy_tensor_1->get_public_share();
+  const auto& secret_output_share_0 = output_beavy_tensor_0->get_secret_share();
+  const auto& secret_output_share_1 = output_beavy_tensor_1->get_secret_share();
+
+  ASSERT_EQ(public_output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_1.size(), output_dims.get_data_size());
+  ASSERT_EQ(secret_output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(secret_output_share_1.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_0, public_output_share_1);
+
+  const auto expected_output = MOTION::convolution(conv_op, input, kernel);
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      public_output_share_0,
+      MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
+
+  ASSERT_EQ(plain_output, expected_output);
+}
+
 TYPED_TEST(ArithmeticBEAVYTensorTest, Gemm) {
   const MOTION::tensor::GemmOp gemm_op = {
       .input_A_shape_ = {1, 100}, .input_B_shape_ = {100, 10}, .output_shape_ = {1, 10}};
@@ -466,3 +562,356 @@ TYPED_TEST(ArithmeticBEAVYTensorTest, Sqr) {
       MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
   ASSERT_EQ(plain_output, expected_output);
 }
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, LocalOpFusion) {
+  using T = TypeParam;
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 2, .height_ = 10, .width_ = 10};
+  const auto input_a = this->generate_inputs(dims);
+  const auto input_b = this->generate_inputs(dims);
+
+  auto [input_a_promise, tensor_a_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_a_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto tensor_b_in_0 = this->make_arithmetic_T_tensor_input_other(0, dims);
+  auto [input_b_promise, tensor_b_in_1] = this->make_arithmetic_T_tensor_input_my(1, dims);
+
+  // y = flatten(-(3 * a + b) + 5) and z = a - a + 7, intermediates are dropped
+  const auto make_ops = [this](std::size_t party_id, const auto& tensor_a, const auto& tensor_b) {
+    auto& bp = *this->beavy_providers_[party_id];
+    EXPECT_TRUE(bp.get_fuse_local_tensor_ops());
+    auto y = bp.make_tensor_flatten_op(
+        bp.make_tensor_constAdd_op(
+            bp.make_tensor_negate(
+                bp.make_tensor_add_op(bp.make_tensor_constMul_op(tensor_a, 3), tensor_b)),
+            5),
+        1);
+    auto z = bp.make_tensor_constAdd_op(
+        bp.make_tensor_add_op(tensor_a, bp.make_tensor_negate(tensor_a)), 7);
+    return std::make_pair(y, z);
+  };
+  const auto [tensor_y_0, tensor_z_0] = make_ops(0, tensor_a_in_0, tensor_b_in_0);
+  const auto [tensor_y_1, tensor_z_1] = make_ops(1, tensor_a_in_1, tensor_b_in_1);
+  const MOTION::tensor::TensorDimensions flat_dims = {
+      .batch_size_ = 1, .num_channels_ = 200, .height_ = 1, .width_ = 1};
+  ASSERT_EQ(tensor_y_0->get_dimensions(), flat_dims);
+  ASSERT_EQ(tensor_z_0->get_dimensions(), dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_a_promise.set_value(input_a);
+  input_b_promise.set_value(input_b);
+  this->run_gates_online();
+
+  const auto reconstruct = [](const auto& tensor_0, const auto& tensor_1) {
+    const auto t0 = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensor_0);
+    const auto t1 = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensor_1);
+    t0->wait_online();
+    t1->wait_online();
+    EXPECT_EQ(t0->get_public_share(), t1->get_public_share());
+    return MOTION::Helpers::SubVectors(
+        t0->get_public_share(),
+        MOTION::Helpers::AddVectors(t0->get_secret_share(), t1->get_secret_share()));
+  };
+  const auto output_y = reconstruct(tensor_y_0, tensor_y_1);
+  const auto output_z = reconstruct(tensor_z_0, tensor_z_1);
+  ASSERT_EQ(output_y.size(), dims.get_data_size());
+  ASSERT_EQ(output_z.size(), dims.get_data_size());
+  for (std::size_t i = 0; i < dims.get_data_size(); ++i) {
+    EXPECT_EQ(output_y[i], T(5 - 3 * input_a[i] - input_b[i]));
+    EXPECT_EQ(output_z[i], T(7));
+  }
+}
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, ReshapeView) {
+  using T = TypeParam;
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 4, .width_ = 5};
+  const MOTION::tensor::TensorDimensions new_dims = {
+      .batch_size_ = 1, .num_channels_ = 12, .height_ = 5, .width_ = 1};
+  const auto input = this->generate_inputs(dims);
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  std::array<MOTION::tensor::TensorCP, 2> tensors_in = {tensor_in_0, tensor_in_1};
+  std::array<MOTION::tensor::TensorCP, 2> tensors_out;
+  for (std::size_t party_id = 0; party_id < 2; ++party_id) {
+    auto& bp = *this->beavy_providers_[party_id];
+    EXPECT_THROW(bp.make_tensor_reshape_op(tensors_in[party_id], {1, 1, 1, 59}),
+                 std::invalid_argument);
+    tensors_out[party_id] = bp.make_tensor_reshape_op(tensors_in[party_id], new_dims);
+    ASSERT_EQ(tensors_out[party_id]->get_dimensions(), new_dims);
+  }
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  for (std::size_t party_id = 0; party_id < 2; ++party_id) {
+    const auto t_in =
+        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensors_in[party_id]);
+    const auto t_out =
+        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensors_out[party_id]);
+    t_out->wait_online();
+    // no copy has been made
+    EXPECT_TRUE(t_out->is_view_of(*t_in));
+    EXPECT_EQ(t_out->get_public_share().data(), t_in->get_public_share().data());
+    EXPECT_EQ(t_out->get_secret_share().data(), t_in->get_secret_share().data());
+  }
+  const auto t0 = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensors_out[0]);
+  const auto t1 = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensors_out[1]);
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      t0->get_public_share(),
+      MOTION::Helpers::AddVectors(t0->get_secret_share(), t1->get_secret_share()));
+  EXPECT_EQ(plain_output, input);
+}
+
+using ArithmeticBEAVYTensor64Test = ArithmeticBEAVYTensorTest<std::uint64_t>;
+
+TEST_F(ArithmeticBEAVYTensor64Test, Reciprocal) {
+  using T = std::uint64_t;
+  const std::size_t fractional_bits = 16;
+  const double max_value = 16.0;
+  const std::size_t num_iterations = 10;
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 100};
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dist(1.0, max_value);
+  std::vector<double> plain_input(dims.get_data_size());
+  std::generate(std::begin(plain_input), std::end(plain_input), [&] { return dist(rng); });
+  std::vector<T> input(dims.get_data_size());
+  std::transform(std::begin(plain_input), std::end(plain_input), std::begin(input),
+                 [fractional_bits](auto x) {
+                   return MOTION::fixed_point::encode<T>(x, fractional_bits);
+                 });
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_out_0 = this->beavy_providers_[0]->make_tensor_reciprocal_op(
+      tensor_in_0, fractional_bits, max_value, num_iterations);
+  auto tensor_out_1 = this->beavy_providers_[1]->make_tensor_reciprocal_op(
+      tensor_in_1, fractional_bits, max_value, num_iterations);
+  auto tensor_sqrt_0 = this->beavy_providers_[0]->make_tensor_sqrt_op(
+      tensor_in_0, fractional_bits, max_value, 2 * num_iterations);
+  auto tensor_sqrt_1 = this->beavy_providers_[1]->make_tensor_sqrt_op(
+      tensor_in_1, fractional_bits, max_value, 2 * num_iterations);
+
+  ASSERT_EQ(tensor_out_0->get_dimensions(), dims);
+  ASSERT_EQ(tensor_out_1->get_dimensions(), dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto reconstruct = [](const auto& tensor_0, const auto& tensor_1) {
+    const auto t0 = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensor_0);
+    const auto t1 = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensor_1);
+    t0->wait_online();
+    t1->wait_online();
+    EXPECT_EQ(t0->get_public_share(), t1->get_public_share());
+    return MOTION::Helpers::SubVectors(
+        t0->get_public_share(),
+        MOTION::Helpers::AddVectors(t0->get_secret_share(), t1->get_secret_share()));
+  };
+  const auto reciprocal_output = reconstruct(tensor_out_0, tensor_out_1);
+  const auto sqrt_output = reconstruct(tensor_sqrt_0, tensor_sqrt_1);
+
+  ASSERT_EQ(reciprocal_output.size(), input.size());
+  ASSERT_EQ(sqrt_output.size(), input.size());
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    const auto reciprocal =
+        MOTION::fixed_point::decode<T, double>(reciprocal_output[i], fractional_bits);
+    const auto sqrt = MOTION::fixed_point::decode<T, double>(sqrt_output[i], fractional_bits);
+    EXPECT_NEAR(reciprocal, 1.0 / plain_input[i], 1e-3);
+    EXPECT_NEAR(sqrt, std::sqrt(plain_input[i]), 1e-2);
+  }
+}
+
+using ArithmeticBEAVYTensor32Test = ArithmeticBEAVYTensorTest<std::uint32_t>;
+
+TEST_F(ArithmeticBEAVYTensor32Test, ReciprocalOverflow) {
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 100};
+  const auto tensor_in = std::make_shared<ArithmeticBEAVYTensor<std::uint32_t>>(dims);
+  auto& bp = *this->beavy_providers_[0];
+  // 2 * (16 + 4) + 1 bits do not fit into 32 bit
+  EXPECT_THROW(bp.make_tensor_reciprocal_op(tensor_in, 16, 16.0, 10), std::invalid_argument);
+  EXPECT_THROW(bp.make_tensor_div_op(tensor_in, tensor_in, 16, 16.0, 10), std::invalid_argument);
+  EXPECT_THROW(bp.make_tensor_rsqrt_op(tensor_in, 16, 16.0, 10), std::invalid_argument);
+  EXPECT_THROW(bp.make_tensor_sqrt_op(tensor_in, 16, 16.0, 10), std::invalid_argument);
+}
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, Sum) {
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 4, .width_ = 5};
+  const auto input = this->generate_inputs(dims);
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_out_0 = this->beavy_providers_[0]->make_tensor_sum_op(tensor_in_0, 2);
+  auto tensor_out_1 = this->beavy_providers_[1]->make_tensor_sum_op(tensor_in_1, 2);
+
+  const MOTION::tensor::TensorDimensions expected_dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 1, .width_ = 5};
+  ASSERT_EQ(tensor_out_0->get_dimensions(), expected_dims);
+  ASSERT_EQ(tensor_out_1->get_dimensions(), expected_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto tensor_output_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_out_0);
+  const auto tensor_output_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_out_1);
+
+  ASSERT_NE(tensor_output_0, nullptr);
+  ASSERT_NE(tensor_output_1, nullptr);
+
+  tensor_output_0->wait_online();
+  tensor_output_1->wait_online();
+
+  ASSERT_EQ(tensor_output_0->get_public_share(), tensor_output_1->get_public_share());
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      tensor_output_0->get_public_share(),
+      MOTION::Helpers::AddVectors(tensor_output_0->get_secret_share(),
+                                  tensor_output_1->get_secret_share()));
+  ASSERT_EQ(plain_output.size(), expected_dims.get_data_size());
+
+  for (std::size_t c = 0; c < 3; ++c) {
+    for (std::size_t w = 0; w < 5; ++w) {
+      TypeParam expected = 0;
+      for (std::size_t h = 0; h < 4; ++h) {
+        expected += input[(c * 4 + h) * 5 + w];
+      }
+      EXPECT_EQ(plain_output[c * 5 + w], expected);
+    }
+  }
+}
+
+TEST_F(ArithmeticBEAVYTensor64Test, MeanVariance) {
+  using T = std::uint64_t;
+  const std::size_t fractional_bits = 16;
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 4, .height_ = 1, .width_ = 50};
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dist(-8.0, 8.0);
+  std::vector<double> plain_input(dims.get_data_size());
+  std::generate(std::begin(plain_input), std::end(plain_input), [&] { return dist(rng); });
+  std::vector<T> input(dims.get_data_size());
+  std::transform(std::begin(plain_input), std::end(plain_input), std::begin(input),
+                 [fractional_bits](auto x) {
+                   return MOTION::fixed_point::encode<T>(x, fractional_bits);
+                 });
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  // at least one integer bit is required
+  EXPECT_THROW(this->beavy_providers_[0]->make_tensor_mean_op(tensor_in_0, 3, 64),
+               std::invalid_argument);
+
+  auto tensor_mean_0 =
+      this->beavy_providers_[0]->make_tensor_mean_op(tensor_in_0, 3, fractional_bits);
+  auto tensor_mean_1 =
+      this->beavy_providers_[1]->make_tensor_mean_op(tensor_in_1, 3, fractional_bits);
+  auto tensor_var_0 =
+      this->beavy_providers_[0]->make_tensor_variance_op(tensor_in_0, 3, fractional_bits);
+  auto tensor_var_1 =
+      this->beavy_providers_[1]->make_tensor_variance_op(tensor_in_1, 3, fractional_bits);
+
+  const MOTION::tensor::TensorDimensions expected_dims = {
+      .batch_size_ = 1, .num_channels_ = 4, .height_ = 1, .width_ = 1};
+  ASSERT_EQ(tensor_mean_0->get_dimensions(), expected_dims);
+  ASSERT_EQ(tensor_var_0->get_dimensions(), expected_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto reconstruct = [](const auto& tensor_0, const auto& tensor_1) {
+    const auto t0 = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensor_0);
+    const auto t1 = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(tensor_1);
+    t0->wait_online();
+    t1->wait_online();
+    EXPECT_EQ(t0->get_public_share(), t1->get_public_share());
+    return MOTION::Helpers::SubVectors(
+        t0->get_public_share(),
+        MOTION::Helpers::AddVectors(t0->get_secret_share(), t1->get_secret_share()));
+  };
+  const auto mean_output = reconstruct(tensor_mean_0, tensor_mean_1);
+  const auto var_output = reconstruct(tensor_var_0, tensor_var_1);
+
+  for (std::size_t c = 0; c < 4; ++c) {
+    double sum = 0.0;
+    double sum_sqr = 0.0;
+    for (std::size_t w = 0; w < 50; ++w) {
+      sum += plain_input[c * 50 + w];
+      sum_sqr += plain_input[c * 50 + w] * plain_input[c * 50 + w];
+    }
+    const auto expected_mean = sum / 50;
+    const auto expected_var = sum_sqr / 50 - expected_mean * expected_mean;
+    const auto mean = MOTION::fixed_point::decode<T, double>(mean_output[c], fractional_bits);
+    const auto var = MOTION::fixed_point::decode<T, double>(var_output[c], fractional_bits);
+    EXPECT_NEAR(mean, expected_mean, 1e-3);
+    EXPECT_NEAR(var, expected_var, 1e-2);
+  }
+}
+
+template <typename T>
+class BEAVYTensorKernelsTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(BEAVYTensorKernelsTest, integer_types);
+
+TYPED_TEST(BEAVYTensorKernelsTest, UnpackBits) {
+  using T = TypeParam;
+  for (std::size_t n : {1, 7, 8, 13, 64, 1001}) {
+    const auto bits = ENCRYPTO::BitVector<>::Random(n);
+    std::vector<T> unpacked(n);
+    std::vector<T> unpacked_inverted(n);
+    kernels::unpack_bits(bits, unpacked.data());
+    kernels::unpack_bits<T, true>(bits, unpacked_inverted.data());
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(unpacked[i], T(bits.Get(i)));
+      EXPECT_EQ(unpacked_inverted[i], T(!bits.Get(i)));
+    }
+  }
+}
+
+TYPED_TEST(BEAVYTensorKernelsTest, BooleanToArithmetic) {
+  using T = TypeParam;
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<T>;
+  const std::size_t data_size = 5000;
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<T> dist;
+  std::vector<T> public_bits(bit_size * data_size);
+  std::vector<T> secret_bits(bit_size * data_size);
+  std::generate(std::begin(public_bits), std::end(public_bits), [&] { return gen() & 1; });
+  std::generate(std::begin(secret_bits), std::end(secret_bits), [&] { return dist(gen); });
+  std::vector<T> output_0(data_size);
+  std::vector<T> output_1(data_size);
+  std::generate(std::begin(output_0), std::end(output_0), [&] { return dist(gen); });
+  std::copy(std::begin(output_0), std::end(output_0), std::begin(output_1));
+  const auto initial = output_0;
+
+  kernels::boolean_to_arithmetic<T, true>(public_bits.data(), secret_bits.data(),
+                                          output_0.data(), data_size);
+  kernels::boolean_to_arithmetic<T, false>(public_bits.data(), secret_bits.data(),
+                                           output_1.data(), data_size);
+  for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+    T expected_0 = initial[int_i];
+    T expected_1 = initial[int_i];
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      const T p = public_bits[bit_j * data_size + int_i];
+      const T s = secret_bits[bit_j * data_size + int_i];
+      expected_0 += T(p + (1 - 2 * p) * s) << bit_j;
+      expected_1 += T((1 - 2 * p) * s) << bit_j;
+    }
+    EXPECT_EQ(output_0[int_i], expected_0);
+    EXPECT_EQ(output_1[int_i], expected_1);
+  }
+}
@@ -20,11 +20,18 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <array>
+#include <numeric>
+#include <random>
+
 #include <gtest/gtest.h>
 #include <boost/log/trivial.hpp>
 
 #include "communication/communication_layer.h"
+#include "communication/compact_message.h"
+#include "communication/message_compression.h"
 #include "communication/message_handler.h"
+#include "communication/session_multiplexer.h"
 #include "utility/logger.h"
 
 TEST(CommunicationLayer, Dummy) {
@@ -85,6 +92,257 @@ TEST(CommunicationLayer, Dummy) {
   std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
 }
 
+TEST(CompactMessage, RoundTrip) {
+  using namespace MOTION::Communication;
+  const std::vector<std::uint8_t> payload = {0xde, 0xad, 0xbe, 0xef, 0x42};
+  const std::uint64_t gate_id = 0x0123456789abcdef;
+  const auto message =
+      BuildCompactMessage(MessageType::BEAVYGate, gate_id, 3, payload.data(), payload.size());
+  EXPECT_EQ(message.size(), compact_message_header_size + payload.size());
+  EXPECT_TRUE(IsCompactMessage(message.data(), message.size()));
+
+  const auto view = ParseCompactMessage(message.data(), message.size());
+  ASSERT_TRUE(view.has_value());
+  EXPECT_EQ(view->message_type, MessageType::BEAVYGate);
+  EXPECT_EQ(view->id, gate_id);
+  EXPECT_EQ(view->msg_num, 3);
+  EXPECT_EQ(std::vector(view->payload, view->payload + view->payload_size), payload);
+
+  // truncated header
+  EXPECT_FALSE(ParseCompactMessage(message.data(), compact_message_header_size - 1).has_value());
+  // empty payload
+  const auto empty_message = BuildCompactMessage(MessageType::GMWGate, 7, 0, nullptr, 0);
+  const auto empty_view = ParseCompactMessage(empty_message.data(), empty_message.size());
+  ASSERT_TRUE(empty_view.has_value());
+  EXPECT_EQ(empty_view->payload_size, 0);
+}
+
+TEST(CommunicationLayer, DispatchCompactMessage) {
+  using namespace MOTION::Communication;
+  auto comm_layers = make_dummy_communication_layers(2);
+  auto qh = std::make_shared<QueueHandler>();
+  comm_layers.at(1)->register_message_handler([qh](auto) { return qh; },
+                                              {MessageType::GMWGate});
+  std::for_each(std::begin(comm_layers), std::end(comm_layers), [](auto& cl) { cl->start(); });
+
+  const std::vector<std::uint8_t> payload = {0xde, 0xad, 0xbe, 0xef};
+  const auto message =
+      BuildCompactMessage(MessageType::GMWGate, 42, 0, payload.data(), payload.size());
+  comm_layers.at(0)->send_message(1, message);
+  EXPECT_EQ(qh->get_queue().dequeue(), message);
+
+  std::vector<std::future<void>> futs;
+  for (auto& cl : comm_layers) {
+    futs.emplace_back(std::async(std::launch::async, [&cl] { cl->shutdown(); }));
+  }
+  std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+}
+
+TEST(SessionMultiplexer, Sessions) {
+  using namespace MOTION::Communication;
+  constexpr std::size_t num_sessions = 3;
+  auto comm_layers = make_dummy_communication_layers(2);
+  std::vector<std::unique_ptr<SessionMultiplexer>> multiplexers;
+  for (auto& cl : comm_layers) {
+    multiplexers.emplace_back(std::make_unique<SessionMultiplexer>(*cl));
+  }
+  std::for_each(std::begin(comm_layers), std::end(comm_layers), [](auto& cl) { cl->start(); });
+
+  // all sessions use the same message type
+  std::array<std::vector<std::unique_ptr<CommunicationLayer>>, 2> sessions;
+  std::vector<std::shared_ptr<QueueHandler>> qhs;
+  for (std::size_t session_id = 0; session_id < num_sessions; ++session_id) {
+    sessions.at(0).emplace_back(multiplexers.at(0)->make_session(session_id));
+    // create the sessions of the receiver in reverse order
+    sessions.at(1).emplace_back(multiplexers.at(1)->make_session(num_sessions - 1 - session_id));
+  }
+  EXPECT_THROW(multiplexers.at(0)->make_session(0), std::invalid_argument);
+  std::reverse(std::begin(sessions.at(1)), std::end(sessions.at(1)));
+  for (std::size_t session_id = 0; session_id < num_sessions; ++session_id) {
+    auto qh = std::make_shared<QueueHandler>();
+    sessions.at(1).at(session_id)->register_message_handler([qh](auto) { return qh; },
+                                                            {MessageType::GMWGate});
+    qhs.push_back(qh);
+    sessions.at(0).at(session_id)->start();
+    sessions.at(1).at(session_id)->start();
+  }
+
+  for (std::size_t session_id = 0; session_id < num_sessions; ++session_id) {
+    const std::vector<std::uint8_t> payload(session_id + 1, std::uint8_t(session_id));
+    sessions.at(0).at(session_id)->send_message(
+        1, BuildCompactMessage(MessageType::GMWGate, 0, 0, payload.data(), payload.size()));
+  }
+  for (std::size_t session_id = 0; session_id < num_sessions; ++session_id) {
+    const auto message = qhs.at(session_id)->get_queue().dequeue();
+    ASSERT_TRUE(message.has_value());
+    const auto view = ParseCompactMessage(message->data(), message->size());
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(std::vector(view->payload, view->payload + view->payload_size),
+              std::vector<std::uint8_t>(session_id + 1, std::uint8_t(session_id)));
+  }
+
+  // the sessions are synchronized independently
+  {
+    std::vector<std::future<void>> futs;
+    for (auto& party_sessions : sessions) {
+      for (auto& session : party_sessions) {
+        futs.emplace_back(std::async(std::launch::async, [&session] { session->sync(); }));
+      }
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  EXPECT_EQ(multiplexers.at(0)->get_num_sessions(), num_sessions);
+  EXPECT_EQ(multiplexers.at(1)->get_num_sessions(), num_sessions);
+  {
+    std::vector<std::future<void>> futs;
+    for (auto& party_sessions : sessions) {
+      for (auto& session : party_sessions) {
+        futs.emplace_back(std::async(std::launch::async, [&session] { session->shutdown(); }));
+      }
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+  // finished sessions are removed
+  EXPECT_EQ(multiplexers.at(0)->get_num_sessions(), 0);
+  EXPECT_EQ(multiplexers.at(1)->get_num_sessions(), 0);
+  EXPECT_THROW(multiplexers.at(0)->make_session(0), std::invalid_argument);
+
+  // late messages for finished sessions are dropped instead of recreating them
+  {
+    const std::vector<std::uint8_t> payload(1, 0x42);
+    comm_layers.at(0)->send_message(
+        1, BuildCompactMessage(MessageType::SessionMessage, 0, 0, payload.data(), payload.size()));
+    std::vector<std::future<void>> futs;
+    for (auto& cl : comm_layers) {
+      futs.emplace_back(std::async(std::launch::async, [&cl] { cl->sync(); }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+  EXPECT_EQ(multiplexers.at(1)->get_num_sessions(), 0);
+  multiplexers.clear();
+  std::vector<std::future<void>> futs;
+  for (auto& cl : comm_layers) {
+    futs.emplace_back(std::async(std::launch::async, [&cl] { cl->shutdown(); }));
+  }
+  std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+}
+
+TEST(MessageCompression, EstimateEntropy) {
+  using namespace MOTION::Communication;
+  const std::vector<std::uint8_t> zeros(1 << 16, 0);
+  EXPECT_EQ(estimate_entropy(zeros.data(), zeros.size(), 1024), 0.0);
+  std::vector<std::uint8_t> counter(1 << 16);
+  std::iota(std::begin(counter), std::end(counter), 0);
+  EXPECT_NEAR(estimate_entropy(counter.data(), counter.size(), 1 << 16), 8.0, 1e-9);
+}
+
+TEST(MessageCompression, RoundTrip) {
+  using namespace MOTION::Communication;
+  if (!compression_supported()) {
+    GTEST_SKIP() << "built without LZ4 support";
+  }
+  MessageCompressor compressor(CompressionConfig::bulk_messages());
+  ASSERT_TRUE(compressor.enabled());
+
+  // sparse payload
+  std::vector<std::uint8_t> payload(1 << 16, 0);
+  for (std::size_t i = 0; i < payload.size(); i += 97) {
+    payload[i] = i & 0xFF;
+  }
+  const auto original_message =
+      BuildCompactMessage(MessageType::BEAVYGate, 42, 1, payload.data(), payload.size());
+  auto message = original_message;
+  EXPECT_TRUE(compressor.compress(message));
+  EXPECT_LT(message.size(), original_message.size() / 4);
+  const auto view = ParseCompactMessage(message.data(), message.size());
+  ASSERT_TRUE(view.has_value());
+  EXPECT_TRUE(view->flags & compact_message_flag_compressed);
+  EXPECT_EQ(view->message_type, MessageType::BEAVYGate);
+  EXPECT_EQ(view->id, 42);
+
+  EXPECT_TRUE(DecompressMessage(message));
+  EXPECT_EQ(message, original_message);
+
+  // truncated compressed message
+  auto truncated_message = original_message;
+  EXPECT_TRUE(compressor.compress(truncated_message));
+  truncated_message.resize(truncated_message.size() - 8);
+  EXPECT_FALSE(DecompressMessage(truncated_message));
+
+  // message types without compression are left unchanged
+  message =
+      BuildCompactMessage(MessageType::SharedBitsMask, 42, 1, payload.data(), payload.size());
+  EXPECT_FALSE(compressor.compress(message));
+
+  const auto stats = compressor.get_statistics();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats.at(0).message_type, MessageType::BEAVYGate);
+  EXPECT_EQ(stats.at(0).num_messages, 2);
+  EXPECT_EQ(stats.at(0).num_attempted, 2);
+  EXPECT_EQ(stats.at(0).num_compressed, 2);
+  EXPECT_EQ(stats.at(0).num_bytes_uncompressed, 2 * payload.size());
+}
+
+TEST(MessageCompression, DisableIncompressibleTypes) {
+  using namespace MOTION::Communication;
+  if (!compression_supported()) {
+    GTEST_SKIP() << "built without LZ4 support";
+  }
+  auto config = CompressionConfig::bulk_messages();
+  config.max_entropy = 8.0;  // always attempt the compression
+  config.max_failures = 2;
+  config.probe_interval = 4;
+  MessageCompressor compressor(config);
+
+  // random bytes are incompressible
+  std::mt19937 gen(42);
+  std::vector<std::uint8_t> payload(8192);
+  std::generate(std::begin(payload), std::end(payload), [&gen] { return gen() & 0xFF; });
+  for (std::size_t i = 0; i < 10; ++i) {
+    auto message =
+        BuildCompactMessage(MessageType::GMWGate, i, 0, payload.data(), payload.size());
+    compressor.compress(message);
+  }
+  // after two failures, only every fourth message is tried again
+  const auto stats = compressor.get_statistics();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats.at(0).num_messages, 10);
+  EXPECT_EQ(stats.at(0).num_attempted, 4);
+  EXPECT_EQ(stats.at(0).num_compressed, 0);
+  EXPECT_EQ(stats.at(0).num_bytes_compressed, stats.at(0).num_bytes_uncompressed);
+}
+
+TEST(CommunicationLayer, CompressedMessage) {
+  using namespace MOTION::Communication;
+  if (!compression_supported()) {
+    GTEST_SKIP() << "built without LZ4 support";
+  }
+  auto comm_layers = make_dummy_communication_layers(2);
+  comm_layers.at(0)->set_compression_config(CompressionConfig::bulk_messages());
+  auto qh = std::make_shared<QueueHandler>();
+  comm_layers.at(1)->register_message_handler([qh](auto) { return qh; },
+                                              {MessageType::GMWGate});
+  std::for_each(std::begin(comm_layers), std::end(comm_layers), [](auto& cl) { cl->start(); });
+
+  const std::vector<std::uint8_t> payload(1 << 16, 0x42);
+  const auto message =
+      BuildCompactMessage(MessageType::GMWGate, 42, 0, payload.data(), payload.size());
+  comm_layers.at(0)->send_message(1, message);
+  EXPECT_EQ(qh->get_queue().dequeue(), message);
+
+  std::vector<std::future<void>> futs;
+  for (auto& cl : comm_layers) {
+    futs.emplace_back(std::async(std::launch::async, [&cl] { cl->shutdown(); }));
+  }
+  std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+
+  const auto stats = comm_layers.at(0)->get_compression_statistics();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats.at(0).num_compressed, 1);
+  EXPECT_LT(stats.at(0).num_bytes_compressed, payload.size() / 10);
+}
+
 class CommunicationLayerTCP : public testing::TestWithParam<bool> {};
 
 TEST_P(CommunicationLayerTCP, TCP) {
@@ -20,9 +20,12 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <array>
 #include <iterator>
 #include <memory>
+#include <random>
+#include <type_traits>
 
 #include <gtest/gtest.h>
 
@@ -43,6 +46,7 @@
 #include "protocols/gmw/wire.h"
 #include "statistics/run_time_stats.h"
 #include "tensor/tensor.h"
+#include "utility/fixed_point.h"
 #include "utility/helpers.h"
 #include "utility/linear_algebra.h"
 #include "utility/logger.h"
@@ -197,13 +201,13 @@ class ArithmeticGMWTensorTest : public GMWTensorTest {
     }
   }
   ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<T>> make_arithmetic_T_tensor_output_my(
-      std::size_t party_id, const MOTION::tensor::TensorCP& in) {
+      std::size_t party_id, const MOTION::tensor::TensorCP& in, std::size_t output_bit_size = 0) {
     auto& gp = *gmw_providers_.at(party_id);
     if constexpr (ENCRYPTO::bit_size_v<T> == 64) {
-      return gp.make_arithmetic_64_tensor_output_my(in);
+      return gp.make_arithmetic_64_tensor_output_my(in, output_bit_size);
     } else {
       static_assert(ENCRYPTO::bit_size_v<T> == 32);
-      return gp.make_arithmetic_32_tensor_output_my(in);
+      return gp.make_arithmetic_32_tensor_output_my(in, output_bit_size);
     }
   }
 };
@@ -289,6 +293,33 @@ TYPED_TEST(ArithmeticGMWTensorTest, OutputSingle) {
   ASSERT_EQ(input_a, output);
 }
 
+TYPED_TEST(ArithmeticGMWTensorTest, OutputReducedBitSize) {
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 28, .width_ = 28};
+  constexpr std::size_t output_bit_size = 12;
+  // signed values that fit into output_bit_size bits
+  auto input_a = this->generate_inputs(dims);
+  for (auto& x : input_a) {
+    x = TypeParam(std::make_signed_t<TypeParam>(x) >>
+                  (ENCRYPTO::bit_size_v<TypeParam> - output_bit_size));
+  }
+
+  auto [input_a_promise, tensor_a_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_a_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  this->gmw_providers_[0]->make_arithmetic_tensor_output_other(tensor_a_in_0, output_bit_size);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, tensor_a_in_1, output_bit_size);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_a_promise.set_value(input_a);
+  this->run_gates_online();
+
+  auto output = output_future.get();
+
+  ASSERT_EQ(output.size(), dims.get_data_size());
+  ASSERT_EQ(input_a, output);
+}
+
 TYPED_TEST(ArithmeticGMWTensorTest, Convolution) {
   // Convolution from CryptoNets
   const MOTION::tensor::Conv2DOp conv_op = {.kernel_shape_ = {5, 1, 5, 5},
@@ -345,6 +376,62 @@ TYPED_TEST(ArithmeticGMWTensorTest, Convolution) {
   ASSERT_EQ(plain_output, expected_output);
 }
 
+TYPED_TEST(ArithmeticGMWTensorTest, GroupedConvolution) {
+  const MOTION::tensor::Conv2DOp conv_op = {.kernel_shape_ = {4, 2, 3, 3},
+                                            .input_shape_ = {4, 8, 8},
+                                            .output_shape_ = {4, 8, 8},
+                                            .dilations_ = {1, 1},
+                                            .pads_ = {1, 1, 1, 1},
+                                            .strides_ = {1, 1},
+                                            .group_ = 2};
+  ASSERT_TRUE(conv_op.verify());
+  const auto input_dims = conv_op.get_input_tensor_dims();
+  const auto kernel_dims = conv_op.get_kernel_tensor_dims();
+  const auto output_dims = conv_op.get_output_tensor_dims();
+  const auto input = this->generate_inputs(input_dims);
+  const auto kernel = this->generate_inputs(kernel_dims);
+
+  auto [input_promise, tensor_input_0] = this->make_arithmetic_T_tensor_input_my(0, input_dims);
+  auto tensor_input_1 = this->make_arithmetic_T_tensor_input_other(1, input_dims);
+  auto tensor_kernel_0 = this->make_arithmetic_T_tensor_input_other(0, kernel_dims);
+  auto [kernel_promise, tensor_kernel_1] = this->make_arithmetic_T_tensor_input_my(1, kernel_dims);
+
+  ASSERT_EQ(tensor_input_0->get_dimensions(), input_dims);
+  ASSERT_EQ(tensor_input_1->get_dimensions(), input_dims);
+  ASSERT_EQ(tensor_kernel_0->get_dimensions(), kernel_dims);
+  ASSERT_EQ(tensor_kernel_1->get_dimensions(), kernel_dims);
+
+  auto tensor_output_0 =
+      this->gmw_providers_[0]->make_tensor_conv2d_op(conv_op, tensor_input_0, tensor_kernel_0);
+  auto tensor_output_1 =
+      this->gmw_providers_[1]->make_tensor_conv2d_op(conv_op, tensor_input_1, tensor_kernel_1);
+
+  ASSERT_EQ(tensor_output_0->get_dimensions(), output_dims);
+  ASSERT_EQ(tensor_output_1->get_dimensions(), output_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  kernel_promise.set_value(kernel);
+  this->run_gates_online();
+
+  const auto output_gmw_tensor_0 =
+      std::dynamic_pointer_cast<const ArithmeticGMWTensor<TypeParam>>(tensor_output_0);
+  const auto output_gmw_tensor_1 =
+      std::dynamic_pointer_cast<const ArithmeticGMWTensor<TypeParam>>(tensor_output_1);
+
+  const auto& output_share_0 = output_gmw_tensor_0->get_share();
+  const auto& output_share_1 = output_gmw_tensor_1->get_share();
+
+  ASSERT_EQ(output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(output_share_1.size(), output_dims.get_data_size());
+
+  const auto expected_output = MOTION::convolution(conv_op, input, kernel);
+  const auto plain_output = MOTION::Helpers::AddVectors(output_share_0, output_share_1);
+
+  ASSERT_EQ(plain_output, expected_output);
+}
+
 TYPED_TEST(ArithmeticGMWTensorTest, Gemm) {
   const MOTION::tensor::GemmOp gemm_op = {
       .input_A_shape_ = {1, 100}, .input_B_shape_ = {100, 10}, .output_shape_ = {1, 10}};
@@ -440,3 +527,118 @@ TYPED_TEST(ArithmeticGMWTensorTest, Sqr) {
     ASSERT_EQ(TypeParam(input[i] * input[i]), TypeParam(share_0[i] + share_1[i]));
   }
 }
+
+TYPED_TEST(ArithmeticGMWTensorTest, Sum) {
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 4, .width_ = 5};
+  const auto input = this->generate_inputs(dims);
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_out_0 = this->gmw_providers_[0]->make_tensor_sum_op(tensor_in_0, 1);
+  auto tensor_out_1 = this->gmw_providers_[1]->make_tensor_sum_op(tensor_in_1, 1);
+
+  const MOTION::tensor::TensorDimensions expected_dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 4, .width_ = 5};
+  ASSERT_EQ(tensor_out_0->get_dimensions(), expected_dims);
+  ASSERT_EQ(tensor_out_1->get_dimensions(), expected_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto tensor_output_0 =
+      std::dynamic_pointer_cast<const ArithmeticGMWTensor<TypeParam>>(tensor_out_0);
+  const auto tensor_output_1 =
+      std::dynamic_pointer_cast<const ArithmeticGMWTensor<TypeParam>>(tensor_out_1);
+
+  ASSERT_NE(tensor_output_0, nullptr);
+  ASSERT_NE(tensor_output_1, nullptr);
+
+  tensor_output_0->wait_online();
+  tensor_output_1->wait_online();
+
+  const auto& share_0 = tensor_output_0->get_share();
+  const auto& share_1 = tensor_output_1->get_share();
+
+  ASSERT_EQ(share_0.size(), expected_dims.get_data_size());
+  ASSERT_EQ(share_1.size(), expected_dims.get_data_size());
+
+  for (std::size_t i = 0; i < expected_dims.get_data_size(); ++i) {
+    TypeParam expected = 0;
+    for (std::size_t c = 0; c < 3; ++c) {
+      expected += input[c * 20 + i];
+    }
+    EXPECT_EQ(TypeParam(share_0[i] + share_1[i]), expected);
+  }
+}
+
+using ArithmeticGMWTensor64Test = ArithmeticGMWTensorTest<std::uint64_t>;
+
+TEST_F(ArithmeticGMWTensor64Test, MeanVariance) {
+  using T = std::uint64_t;
+  const std::size_t fractional_bits = 16;
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 4, .height_ = 1, .width_ = 50};
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dist(-8.0, 8.0);
+  std::vector<double> plain_input(dims.get_data_size());
+  std::generate(std::begin(plain_input), std::end(plain_input), [&] { return dist(rng); });
+  std::vector<T> input(dims.get_data_size());
+  std::transform(std::begin(plain_input), std::end(plain_input), std::begin(input),
+                 [fractional_bits](auto x) {
+                   return MOTION::fixed_point::encode<T>(x, fractional_bits);
+                 });
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  // at least one integer bit is required
+  EXPECT_THROW(this->gmw_providers_[0]->make_tensor_mean_op(tensor_in_0, 3, 64),
+               std::invalid_argument);
+
+  auto tensor_mean_0 =
+      this->gmw_providers_[0]->make_tensor_mean_op(tensor_in_0, 3, fractional_bits);
+  auto tensor_mean_1 =
+      this->gmw_providers_[1]->make_tensor_mean_op(tensor_in_1, 3, fractional_bits);
+  auto tensor_var_0 =
+      this->gmw_providers_[0]->make_tensor_variance_op(tensor_in_0, 3, fractional_bits);
+  auto tensor_var_1 =
+      this->gmw_providers_[1]->make_tensor_variance_op(tensor_in_1, 3, fractional_bits);
+
+  const MOTION::tensor::TensorDimensions expected_dims = {
+      .batch_size_ = 1, .num_channels_ = 4, .height_ = 1, .width_ = 1};
+  ASSERT_EQ(tensor_mean_0->get_dimensions(), expected_dims);
+  ASSERT_EQ(tensor_var_0->get_dimensions(), expected_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto reconstruct = [](const auto& tensor_0, const auto& tensor_1) {
+    const auto t0 = std::dynamic_pointer_cast<const ArithmeticGMWTensor<T>>(tensor_0);
+    const auto t1 = std::dynamic_pointer_cast<const ArithmeticGMWTensor<T>>(tensor_1);
+    t0->wait_online();
+    t1->wait_online();
+    return MOTION::Helpers::AddVectors(t0->get_share(), t1->get_share());
+  };
+  const auto mean_output = reconstruct(tensor_mean_0, tensor_mean_1);
+  const auto var_output = reconstruct(tensor_var_0, tensor_var_1);
+
+  for (std::size_t c = 0; c < 4; ++c) {
+    double sum = 0.0;
+    double sum_sqr = 0.0;
+    for (std::size_t w = 0; w < 50; ++w) {
+      sum += plain_input[c * 50 + w];
+      sum_sqr += plain_input[c * 50 + w] * plain_input[c * 50 + w];
+    }
+    const auto expected_mean = sum / 50;
+    const auto expected_var = sum_sqr / 50 - expected_mean * expected_mean;
+    const auto mean = MOTION::fixed_point::decode<T, double>(mean_output[c], fractional_bits);
+    const auto var = MOTION::fixed_point::decode<T, double>(var_output[c], fractional_bits);
+    EXPECT_NEAR(mean, expected_mean, 1e-3);
+    EXPECT_NEAR(var, expected_var, 1e-2);
+  }
+}
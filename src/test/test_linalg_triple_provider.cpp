@@ -27,9 +27,11 @@
 #include "communication/communication_layer.h"
 #include "crypto/arithmetic_provider.h"
 #include "crypto/base_ots/base_ot_provider.h"
+#include "crypto/linear_he/linear_he.h"
 #include "crypto/motion_base_provider.h"
 #include "crypto/multiplication_triple/linalg_triple_provider.h"
 #include "crypto/oblivious_transfer/ot_provider.h"
+#include "crypto/trusted_dealer.h"
 #include "statistics/run_time_stats.h"
 #include "utility/linear_algebra.h"
 
@@ -230,3 +232,272 @@ TYPED_TEST(LinAlgTripleProviderTest, ReLU) {
   }
   ASSERT_EQ(plain_triple.c_, expected_c);
 }
+
+template <typename T>
+class LinAlgTriplesFromHETest : public LinAlgTripleProviderTest<T> {
+ protected:
+  void SetUp() override {
+    LinAlgTripleProviderTest<T>::SetUp();
+    MOTION::LinAlgHEConfig config;
+    config.selection = MOTION::LinAlgHEConfig::Selection::always;
+    for (std::size_t i = 0; i < 2; ++i) {
+      this->linalg_triple_providers_[i] = std::make_unique<MOTION::LinAlgTriplesFromHE>(
+          *this->comm_layers_[i], this->arithmetic_provider_managers_[i]->get_provider(1 - i),
+          this->ot_provider_managers_[i]->get_provider(1 - i), this->stats_[i], nullptr, config);
+    }
+  }
+
+  std::size_t get_num_he_triples(std::size_t party_id) {
+    return dynamic_cast<MOTION::LinAlgTriplesFromHE&>(*this->linalg_triple_providers_[party_id])
+        .get_num_he_triples();
+  }
+};
+
+// HE is only supported for rings of up to 32 bits
+using small_integer_types = ::testing::Types<std::uint8_t, std::uint16_t, std::uint32_t>;
+TYPED_TEST_SUITE(LinAlgTriplesFromHETest, small_integer_types);
+
+TYPED_TEST(LinAlgTriplesFromHETest, MatrixProduct) {
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<TypeParam>;
+  const std::array<std::array<std::size_t, 3>, 3> dimensions = {
+      {{7, 11, 13}, {3, 9000, 2}, {64, 500, 50}}};
+  for (const auto [l, m, n] : dimensions) {
+    const auto packing = MOTION::LinearHE::MatrixPacking::compute(l, m, n, bit_size);
+    const auto A = MOTION::Helpers::RandomVector<TypeParam>(l * m);
+    const auto B = MOTION::Helpers::RandomVector<TypeParam>(m * n);
+
+    MOTION::LinearHE::MatrixProductClient client;
+    const auto public_key = client.get_public_key();
+    MOTION::LinearHE::MatrixProductServer server(public_key.data(), public_key.size());
+
+    const auto query = client.encrypt(packing, A.data());
+    ASSERT_EQ(query.size(), packing.get_query_size());
+    std::vector<TypeParam> mask(l * n);
+    const auto response =
+        server.multiply(packing, query.data(), query.size(), B.data(), mask.data());
+    ASSERT_EQ(response.size(), packing.get_response_size());
+    std::vector<TypeParam> output(l * n);
+    client.decrypt(packing, response.data(), response.size(), output.data());
+
+    auto expected = MOTION::matrix_multiply(l, m, n, A, B);
+    ASSERT_EQ(MOTION::Helpers::AddVectors(output, mask), expected);
+  }
+}
+
+TYPED_TEST(LinAlgTriplesFromHETest, Gemm) {
+  const MOTION::tensor::GemmOp gemm_op = {
+      .input_A_shape_ = {7, 11}, .input_B_shape_ = {11, 13}, .output_shape_ = {7, 13}};
+  ASSERT_TRUE(gemm_op.verify());
+
+  auto index_0 =
+      this->linalg_triple_providers_[0]->template register_for_gemm_triple<TypeParam>(gemm_op);
+  auto index_1 =
+      this->linalg_triple_providers_[1]->template register_for_gemm_triple<TypeParam>(gemm_op);
+  ASSERT_EQ(this->get_num_he_triples(0), 1);
+  ASSERT_EQ(this->get_num_he_triples(1), 1);
+
+  this->run_setup();
+
+  auto triple_0 =
+      this->linalg_triple_providers_[0]->template get_gemm_triple<TypeParam>(gemm_op, index_0);
+  auto triple_1 =
+      this->linalg_triple_providers_[1]->template get_gemm_triple<TypeParam>(gemm_op, index_1);
+
+  ASSERT_EQ(triple_0.a_.size(), gemm_op.compute_input_A_size());
+  ASSERT_EQ(triple_0.b_.size(), gemm_op.compute_input_B_size());
+  ASSERT_EQ(triple_0.c_.size(), gemm_op.compute_output_size());
+
+  ASSERT_EQ(triple_0.a_.size(), triple_1.a_.size());
+  ASSERT_EQ(triple_0.b_.size(), triple_1.b_.size());
+  ASSERT_EQ(triple_0.c_.size(), triple_1.c_.size());
+
+  MOTION::LinAlgTripleProvider::LinAlgTriple<TypeParam> plain_triple;
+
+  plain_triple.a_ = MOTION::Helpers::AddVectors(triple_0.a_, triple_1.a_);
+  plain_triple.b_ = MOTION::Helpers::AddVectors(triple_0.b_, triple_1.b_);
+  plain_triple.c_ = MOTION::Helpers::AddVectors(triple_0.c_, triple_1.c_);
+
+  auto expected_c =
+      MOTION::matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                              gemm_op.output_shape_[1], plain_triple.a_, plain_triple.b_);
+  ASSERT_EQ(plain_triple.c_, expected_c);
+}
+
+TYPED_TEST(LinAlgTriplesFromHETest, Convolution) {
+  // Convolution from CryptoNets
+  const MOTION::tensor::Conv2DOp conv_op = {.kernel_shape_ = {5, 1, 5, 5},
+                                            .input_shape_ = {1, 28, 28},
+                                            .output_shape_ = {5, 13, 13},
+                                            .dilations_ = {1, 1},
+                                            .pads_ = {1, 1, 0, 0},
+                                            .strides_ = {2, 2}};
+  ASSERT_TRUE(conv_op.verify());
+
+  auto index_0 =
+      this->linalg_triple_providers_[0]->template register_for_conv2d_triple<TypeParam>(conv_op);
+  auto index_1 =
+      this->linalg_triple_providers_[1]->template register_for_conv2d_triple<TypeParam>(conv_op);
+  ASSERT_EQ(this->get_num_he_triples(0), 1);
+  ASSERT_EQ(this->get_num_he_triples(1), 1);
+
+  this->run_setup();
+
+  auto triple_0 =
+      this->linalg_triple_providers_[0]->template get_conv2d_triple<TypeParam>(conv_op, index_0);
+  auto triple_1 =
+      this->linalg_triple_providers_[1]->template get_conv2d_triple<TypeParam>(conv_op, index_1);
+
+  ASSERT_EQ(triple_0.a_.size(), conv_op.compute_input_size());
+  ASSERT_EQ(triple_0.b_.size(), conv_op.compute_kernel_size());
+  ASSERT_EQ(triple_0.c_.size(), conv_op.compute_output_size());
+
+  MOTION::LinAlgTripleProvider::LinAlgTriple<TypeParam> plain_triple;
+
+  plain_triple.a_ = MOTION::Helpers::AddVectors(triple_0.a_, triple_1.a_);
+  plain_triple.b_ = MOTION::Helpers::AddVectors(triple_0.b_, triple_1.b_);
+  plain_triple.c_ = MOTION::Helpers::AddVectors(triple_0.c_, triple_1.c_);
+
+  auto expected_c = MOTION::convolution(conv_op, plain_triple.a_, plain_triple.b_);
+  ASSERT_EQ(plain_triple.c_, expected_c);
+}
+
+template <typename T>
+class LinAlgTriplesFromDealerTest : public LinAlgTripleProviderTest<T> {
+ protected:
+  void SetUp() override {
+    LinAlgTripleProviderTest<T>::SetUp();
+    for (std::size_t i = 0; i < 2; ++i) {
+      dealers_[i] = std::make_unique<MOTION::Crypto::TrustedDealer>(42, i, 2);
+      this->linalg_triple_providers_[i] =
+          std::make_unique<MOTION::LinAlgTriplesFromDealer>(*dealers_[i]);
+    }
+  }
+
+  void TearDown() override {
+    LinAlgTripleProviderTest<T>::TearDown();
+    // the providers hold references to the dealers
+    for (auto& provider : this->linalg_triple_providers_) {
+      provider.reset();
+    }
+  }
+
+  std::array<std::unique_ptr<MOTION::Crypto::TrustedDealer>, 2> dealers_;
+};
+
+TYPED_TEST_SUITE(LinAlgTriplesFromDealerTest, integer_types);
+
+TYPED_TEST(LinAlgTriplesFromDealerTest, Gemm) {
+  const MOTION::tensor::GemmOp gemm_op = {
+      .input_A_shape_ = {7, 11}, .input_B_shape_ = {11, 13}, .output_shape_ = {7, 13}};
+  ASSERT_TRUE(gemm_op.verify());
+
+  // two triples for the same operation need to differ
+  std::array<std::array<std::size_t, 2>, 2> indices;
+  for (std::size_t i = 0; i < 2; ++i) {
+    for (std::size_t triple_j = 0; triple_j < 2; ++triple_j) {
+      indices[i][triple_j] =
+          this->linalg_triple_providers_[i]->template register_for_gemm_triple<TypeParam>(gemm_op);
+    }
+  }
+
+  this->run_setup();
+
+  std::vector<TypeParam> first_a;
+  for (std::size_t triple_j = 0; triple_j < 2; ++triple_j) {
+    auto triple_0 = this->linalg_triple_providers_[0]->template get_gemm_triple<TypeParam>(
+        gemm_op, indices[0][triple_j]);
+    auto triple_1 = this->linalg_triple_providers_[1]->template get_gemm_triple<TypeParam>(
+        gemm_op, indices[1][triple_j]);
+
+    ASSERT_EQ(triple_0.a_.size(), gemm_op.compute_input_A_size());
+    ASSERT_EQ(triple_0.b_.size(), gemm_op.compute_input_B_size());
+    ASSERT_EQ(triple_0.c_.size(), gemm_op.compute_output_size());
+    ASSERT_EQ(triple_0.a_.size(), triple_1.a_.size());
+    ASSERT_EQ(triple_0.b_.size(), triple_1.b_.size());
+    ASSERT_EQ(triple_0.c_.size(), triple_1.c_.size());
+    // the parties hold different shares
+    EXPECT_NE(triple_0.a_, triple_1.a_);
+
+    MOTION::LinAlgTripleProvider::LinAlgTriple<TypeParam> plain_triple;
+    plain_triple.a_ = MOTION::Helpers::AddVectors(triple_0.a_, triple_1.a_);
+    plain_triple.b_ = MOTION::Helpers::AddVectors(triple_0.b_, triple_1.b_);
+    plain_triple.c_ = MOTION::Helpers::AddVectors(triple_0.c_, triple_1.c_);
+
+    auto expected_c =
+        MOTION::matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                                gemm_op.output_shape_[1], plain_triple.a_, plain_triple.b_);
+    ASSERT_EQ(plain_triple.c_, expected_c);
+    if (triple_j == 0) {
+      first_a = plain_triple.a_;
+    } else {
+      EXPECT_NE(plain_triple.a_, first_a);
+    }
+  }
+}
+
+TYPED_TEST(LinAlgTriplesFromDealerTest, Convolution) {
+  // Convolution from CryptoNets
+  const MOTION::tensor::Conv2DOp conv_op = {.kernel_shape_ = {5, 1, 5, 5},
+                                            .input_shape_ = {1, 28, 28},
+                                            .output_shape_ = {5, 13, 13},
+                                            .dilations_ = {1, 1},
+                                            .pads_ = {1, 1, 0, 0},
+                                            .strides_ = {2, 2}};
+  ASSERT_TRUE(conv_op.verify());
+
+  auto index_0 =
+      this->linalg_triple_providers_[0]->template register_for_conv2d_triple<TypeParam>(conv_op);
+  auto index_1 =
+      this->linalg_triple_providers_[1]->template register_for_conv2d_triple<TypeParam>(conv_op);
+
+  this->run_setup();
+
+  auto triple_0 =
+      this->linalg_triple_providers_[0]->template get_conv2d_triple<TypeParam>(conv_op, index_0);
+  auto triple_1 =
+      this->linalg_triple_providers_[1]->template get_conv2d_triple<TypeParam>(conv_op, index_1);
+
+  ASSERT_EQ(triple_0.a_.size(), conv_op.compute_input_size());
+  ASSERT_EQ(triple_0.b_.size(), conv_op.compute_kernel_size());
+  ASSERT_EQ(triple_0.c_.size(), conv_op.compute_output_size());
+  ASSERT_EQ(triple_0.a_.size(), triple_1.a_.size());
+  ASSERT_EQ(triple_0.b_.size(), triple_1.b_.size());
+  ASSERT_EQ(triple_0.c_.size(), triple_1.c_.size());
+
+  MOTION::LinAlgTripleProvider::LinAlgTriple<TypeParam> plain_triple;
+
+  plain_triple.a_ = MOTION::Helpers::AddVectors(triple_0.a_, triple_1.a_);
+  plain_triple.b_ = MOTION::Helpers::AddVectors(triple_0.b_, triple_1.b_);
+  plain_triple.c_ = MOTION::Helpers::AddVectors(triple_0.c_, triple_1.c_);
+
+  auto expected_c = MOTION::convolution(conv_op, plain_triple.a_, plain_triple.b_);
+  ASSERT_EQ(plain_triple.c_, expected_c);
+}
+
+TYPED_TEST(LinAlgTriplesFromDealerTest, ReLU) {
+  std::size_t num_triples = 100;
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<TypeParam>;
+
+  auto index_0 = this->linalg_triple_providers_[0]->register_for_relu_triple(num_triples, bit_size);
+  auto index_1 = this->linalg_triple_providers_[1]->register_for_relu_triple(num_triples, bit_size);
+
+  this->run_setup();
+
+  auto triple_0 =
+      this->linalg_triple_providers_[0]->get_relu_triple(num_triples, bit_size, index_0);
+  auto triple_1 =
+      this->linalg_triple_providers_[1]->get_relu_triple(num_triples, bit_size, index_1);
+
+  ASSERT_EQ(triple_0.a_.GetSize(), num_triples);
+  ASSERT_EQ(triple_0.b_.size(), bit_size - 1);
+  ASSERT_EQ(triple_0.c_.size(), bit_size - 1);
+  ASSERT_EQ(triple_1.b_.size(), bit_size - 1);
+  ASSERT_EQ(triple_1.c_.size(), bit_size - 1);
+
+  const auto plain_a = triple_0.a_ ^ triple_1.a_;
+  for (std::size_t bit_j = 0; bit_j < bit_size - 1; ++bit_j) {
+    const auto plain_b = triple_0.b_.at(bit_j) ^ triple_1.b_.at(bit_j);
+    const auto plain_c = triple_0.c_.at(bit_j) ^ triple_1.c_.at(bit_j);
+    ASSERT_EQ(plain_c, plain_a & plain_b);
+  }
+}
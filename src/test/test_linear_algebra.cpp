@@ -189,6 +189,44 @@ TEST_F(Conv2DTest, Conv2D) {
   ASSERT_EQ(output_buffer, expected_output_buffer_);
 }
 
+TEST(LinearAlgebra, DepthwiseConv2D) {
+  MOTION::tensor::Conv2DOp conv_op{.kernel_shape_ = {2, 1, 2, 2},
+                                   .input_shape_ = {2, 3, 3},
+                                   .output_shape_ = {2, 2, 2},
+                                   .dilations_ = {1, 1},
+                                   .pads_ = {0, 0, 0, 0},
+                                   .strides_ = {1, 1},
+                                   .group_ = 2};
+
+  ASSERT_TRUE(conv_op.verify());
+  // clang-format off
+  const std::vector<std::uint16_t> input = {
+    1, 2, 3,
+    4, 5, 6,
+    7, 8, 9,
+    9, 8, 7,
+    6, 5, 4,
+    3, 2, 1,
+  };
+  const std::vector<std::uint16_t> kernel = {
+    1, 0,
+    0, 1,
+    2, 1,
+    1, 0,
+  };
+  const std::vector<std::uint16_t> expected_output = {
+     6,  8,
+    12, 14,
+    32, 28,
+    20, 16,
+  };
+  // clang-format on
+  ASSERT_EQ(input.size(), conv_op.compute_input_size());
+  ASSERT_EQ(kernel.size(), conv_op.compute_kernel_size());
+  auto output = MOTION::convolution(conv_op, input, kernel);
+  ASSERT_EQ(output, expected_output);
+}
+
 TEST(LinearAlgebra, SumPool) {
   MOTION::tensor::AveragePoolOp avgpool_op{
       .input_shape_ = {1, 4, 4},
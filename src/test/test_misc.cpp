@@ -22,13 +22,19 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <future>
+#include <random>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "algorithm/algorithm_description.h"
+#include "algorithm/circuit_loader.h"
 #include "test_constants.h"
+#include "utility/bit_packing.h"
 #include "utility/bit_vector.h"
 #include "utility/condition.h"
 
@@ -251,4 +257,142 @@ TEST(InputOutput_Un_Vectorization, VectorsOfUnsignedIntegers) {
   EXPECT_EQ(v32, v32_check);
   EXPECT_EQ(v64, v64_check);
 }
-}
\ No newline at end of file
+
+template <typename T>
+class BitPackingTest : public ::testing::Test {};
+
+using bit_packing_types = ::testing::Types<std::uint8_t, std::uint16_t, std::uint32_t,
+                                           std::uint64_t>;
+TYPED_TEST_SUITE(BitPackingTest, bit_packing_types);
+
+TYPED_TEST(BitPackingTest, RoundTrip) {
+  using T = TypeParam;
+  constexpr std::size_t bits = 8 * sizeof(T);
+  std::mt19937_64 rng(0);
+  for (std::size_t n : {0, 1, 7, 8, 9, 63, 64, 65, 1000}) {
+    std::vector<T> values(n);
+    for (auto& v : values) {
+      v = static_cast<T>(rng());
+    }
+    for (std::size_t w = 1; w <= bits; ++w) {
+      const auto packed = MOTION::pack_ints(values, w);
+      ASSERT_EQ(packed.size(), MOTION::packed_ints_size(n, w));
+      const auto unpacked = MOTION::unpack_ints<T>(packed.data(), n, w);
+      ASSERT_EQ(unpacked.size(), n);
+      const T mask = (w == bits) ? T(~T(0)) : T((T(1) << w) - 1);
+      for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(unpacked[i], T(values[i] & mask));
+      }
+    }
+  }
+}
+
+TYPED_TEST(BitPackingTest, SignExtend) {
+  using T = TypeParam;
+  std::vector<T> values = {0b0000, 0b0111, 0b1000, 0b1111};
+  MOTION::sign_extend_ints(values.data(), values.size(), 4);
+  EXPECT_EQ(values[0], T(0));
+  EXPECT_EQ(values[1], T(7));
+  EXPECT_EQ(values[2], T(-8));
+  EXPECT_EQ(values[3], T(-1));
+}
+
+TEST(BitPacking, InvalidBitWidth) {
+  std::vector<std::uint32_t> values(8);
+  EXPECT_THROW(MOTION::pack_ints(values, 0), std::invalid_argument);
+  EXPECT_THROW(MOTION::pack_ints(values, 33), std::invalid_argument);
+}
+
+TEST(AlgorithmDescription, Levelize) {
+  using ENCRYPTO::PrimitiveOperation;
+  using ENCRYPTO::PrimitiveOperationType;
+  // inputs 0, 1 and 2, 3; output 7
+  ENCRYPTO::AlgorithmDescription algo{
+      .n_output_wires_ = 1,
+      .n_input_wires_parent_a_ = 2,
+      .n_wires_ = 8,
+      .n_gates_ = 4,
+      .n_input_wires_parent_b_ = 2,
+      .gates_ = {PrimitiveOperation{.type_ = PrimitiveOperationType::AND,
+                                    .parent_a_ = 0,
+                                    .parent_b_ = 2,
+                                    .output_wire_ = 4},
+                 PrimitiveOperation{.type_ = PrimitiveOperationType::XOR,
+                                    .parent_a_ = 4,
+                                    .parent_b_ = 1,
+                                    .output_wire_ = 5},
+                 PrimitiveOperation{.type_ = PrimitiveOperationType::AND,
+                                    .parent_a_ = 1,
+                                    .parent_b_ = 3,
+                                    .output_wire_ = 6},
+                 PrimitiveOperation{.type_ = PrimitiveOperationType::XOR,
+                                    .parent_a_ = 5,
+                                    .parent_b_ = 6,
+                                    .output_wire_ = 7}}};
+  EXPECT_EQ(algo.ComputeGateLevels(), (std::vector<std::size_t>{1, 2, 1, 3}));
+  EXPECT_EQ(algo.ComputeMaxLiveWires(), 2);
+
+  EXPECT_EQ(algo.Levelize(), 3);
+  EXPECT_EQ(algo.ComputeGateLevels(), (std::vector<std::size_t>{1, 1, 2, 3}));
+  const std::vector<std::size_t> expected_output_wires = {4, 6, 5, 7};
+  for (std::size_t gate_i = 0; gate_i < algo.gates_.size(); ++gate_i) {
+    EXPECT_EQ(algo.gates_[gate_i].output_wire_, expected_output_wires[gate_i]);
+  }
+  EXPECT_EQ(algo.ComputeMaxLiveWires(), 3);
+
+  algo.gates_[0].parent_b_ = 8;
+  EXPECT_THROW(algo.ComputeGateLevels(), std::invalid_argument);
+}
+
+TEST(AlgorithmDescription, LevelizePreservesSemantics) {
+  MOTION::CircuitLoader circuit_loader;
+  const auto& algo =
+      circuit_loader.load_circuit("int_add32_size.bristol", MOTION::CircuitFormat::Bristol);
+  auto levelized_algo = algo;
+  const auto num_levels = levelized_algo.Levelize();
+
+  const auto levels = levelized_algo.ComputeGateLevels();
+  ASSERT_FALSE(levels.empty());
+  EXPECT_TRUE(std::is_sorted(std::begin(levels), std::end(levels)));
+  EXPECT_EQ(levels.back(), num_levels);
+
+  auto evaluate = [](const auto& algo, const std::vector<bool>& inputs) {
+    using ENCRYPTO::PrimitiveOperationType;
+    std::vector<bool> wires(algo.n_wires_);
+    std::copy(std::begin(inputs), std::end(inputs), std::begin(wires));
+    for (const auto& op : algo.gates_) {
+      const bool a = wires.at(op.parent_a_);
+      switch (op.type_) {
+        case PrimitiveOperationType::XOR:
+          wires.at(op.output_wire_) = a != wires.at(*op.parent_b_);
+          break;
+        case PrimitiveOperationType::AND:
+          wires.at(op.output_wire_) = a && wires.at(*op.parent_b_);
+          break;
+        case PrimitiveOperationType::OR:
+          wires.at(op.output_wire_) = a || wires.at(*op.parent_b_);
+          break;
+        case PrimitiveOperationType::INV:
+          wires.at(op.output_wire_) = !a;
+          break;
+        case PrimitiveOperationType::MUX:
+          wires.at(op.output_wire_) =
+              wires.at(*op.selection_bit_) ? wires.at(*op.parent_b_) : a;
+          break;
+        default:
+          throw std::logic_error("unexpected gate type");
+      }
+    }
+    return std::vector<bool>(std::end(wires) - algo.n_output_wires_, std::end(wires));
+  };
+
+  std::mt19937 gen(std::random_device{}());
+  std::bernoulli_distribution dist;
+  const auto num_inputs = algo.n_input_wires_parent_a_ + *algo.n_input_wires_parent_b_;
+  for (std::size_t run_i = 0; run_i < 10; ++run_i) {
+    std::vector<bool> inputs(num_inputs);
+    std::generate(std::begin(inputs), std::end(inputs), [&] { return dist(gen); });
+    EXPECT_EQ(evaluate(algo, inputs), evaluate(levelized_algo, inputs));
+  }
+}
+}
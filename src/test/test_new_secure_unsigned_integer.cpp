@@ -0,0 +1,249 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <array>
+#include <future>
+#include <memory>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "algorithm/algorithm_description.h"
+#include "base/gate_factory.h"
+#include "base/two_party_backend.h"
+#include "communication/communication_layer.h"
+#include "secure_type/new_secure_unsigned_integer.h"
+#include "utility/logger.h"
+#include "utility/typedefs.h"
+#include "wire/new_wire.h"
+
+namespace {
+
+constexpr std::size_t num_simd = 10;
+constexpr std::size_t bit_size = 64;
+
+// interprets output wire i as bit i of each SIMD value
+std::vector<std::uint64_t> bits_to_integers(const MOTION::BitValues& bvs) {
+  std::vector<std::uint64_t> values(bvs.at(0).GetSize(), 0);
+  for (std::size_t bit_i = 0; bit_i < bvs.size(); ++bit_i) {
+    for (std::size_t simd_i = 0; simd_i < values.size(); ++simd_i) {
+      values[simd_i] |= std::uint64_t(bvs[bit_i].Get(simd_i)) << bit_i;
+    }
+  }
+  return values;
+}
+
+class NewSecureUnsignedIntegerTest : public ::testing::TestWithParam<MOTION::MPCProtocol> {
+ protected:
+  void SetUp() override {
+    comm_layers_ = MOTION::Communication::make_dummy_communication_layers(2);
+    for (std::size_t i = 0; i < 2; ++i) {
+      loggers_[i] = std::make_shared<MOTION::Logger>(i, boost::log::trivial::severity_level::trace);
+      comm_layers_[i]->set_logger(loggers_[i]);
+      backends_[i] = std::make_unique<MOTION::TwoPartyBackend>(*comm_layers_[i], 1, false,
+                                                               loggers_[i]);
+    }
+    std::mt19937_64 gen(std::random_device{}());
+    std::uniform_int_distribution<std::uint64_t> dist(1, 1 << 20);
+    std::generate(std::begin(inputs_a_), std::end(inputs_a_), [&] { return dist(gen); });
+    std::generate(std::begin(inputs_b_), std::end(inputs_b_), [&] { return dist(gen); });
+    // make sure that the equality test has something to find
+    inputs_b_[0] = inputs_a_[0];
+  }
+
+  void TearDown() override {
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [this, i] { comm_layers_[i]->shutdown(); }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  // party 0 provides a, party 1 provides b, both as arithmetic shares of the
+  // same protocol family as the tested protocol
+  std::pair<MOTION::NewSecureUnsignedInteger, MOTION::NewSecureUnsignedInteger> make_inputs(
+      std::size_t party_id) {
+    auto& backend = *backends_[party_id];
+    const bool is_beavy = GetParam() == MOTION::MPCProtocol::ArithmeticBEAVY ||
+                          GetParam() == MOTION::MPCProtocol::BooleanBEAVY;
+    auto& gate_factory = backend.get_gate_factory(is_beavy ? MOTION::MPCProtocol::ArithmeticBEAVY
+                                                           : MOTION::MPCProtocol::ArithmeticGMW);
+    MOTION::WireVector wires_a, wires_b;
+    if (party_id == 0) {
+      auto [promise, wires] = gate_factory.make_arithmetic_64_input_gate_my(0, num_simd);
+      promise.set_value(inputs_a_);
+      wires_a = std::move(wires);
+      wires_b = gate_factory.make_arithmetic_64_input_gate_other(1, num_simd);
+    } else {
+      wires_a = gate_factory.make_arithmetic_64_input_gate_other(0, num_simd);
+      auto [promise, wires] = gate_factory.make_arithmetic_64_input_gate_my(1, num_simd);
+      promise.set_value(inputs_b_);
+      wires_b = std::move(wires);
+    }
+    MOTION::NewSecureUnsignedInteger a(backend, std::move(wires_a));
+    MOTION::NewSecureUnsignedInteger b(backend, std::move(wires_b));
+    return {a.convert(GetParam()), b.convert(GetParam())};
+  }
+
+  MOTION::IntegerValues<std::uint64_t> inputs_a_ = MOTION::IntegerValues<std::uint64_t>(num_simd);
+  MOTION::IntegerValues<std::uint64_t> inputs_b_ = MOTION::IntegerValues<std::uint64_t>(num_simd);
+  std::vector<std::unique_ptr<MOTION::Communication::CommunicationLayer>> comm_layers_;
+  std::array<std::shared_ptr<MOTION::Logger>, 2> loggers_;
+  std::array<std::unique_ptr<MOTION::TwoPartyBackend>, 2> backends_;
+
+  // evaluates the operations for both parties, in streaming mode with at most
+  // max_gates_in_flight gates in flight if it is non-zero
+  void check_operations(std::size_t max_gates_in_flight);
+};
+
+void NewSecureUnsignedIntegerTest::check_operations(std::size_t max_gates_in_flight) {
+  auto run_party = [this, max_gates_in_flight](std::size_t party_id) {
+    if (max_gates_in_flight > 0) {
+      backends_[party_id]->set_streaming(max_gates_in_flight);
+    }
+    auto [a, b] = make_inputs(party_id);
+    EXPECT_EQ(a.get_bit_size(), bit_size);
+    EXPECT_EQ(a.get_num_simd(), num_simd);
+    std::array<MOTION::NewSecureUnsignedInteger, 4> results{a + b, a - b, a * b, a / b};
+    std::array<ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<std::uint64_t>>, 4> futures;
+    std::array<ENCRYPTO::ReusableFiberFuture<MOTION::BitValues>, 4> bit_futures;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      auto& gate_factory = backends_[party_id]->get_gate_factory(results[i].get_protocol());
+      if (results[i].is_arithmetic()) {
+        futures[i] = gate_factory.make_arithmetic_64_output_gate_my(MOTION::ALL_PARTIES,
+                                                                    results[i].get_wires());
+      } else {
+        bit_futures[i] =
+            gate_factory.make_boolean_output_gate_my(MOTION::ALL_PARTIES, results[i].get_wires());
+      }
+    }
+    auto gt_wires = a > b;
+    auto eq_wires = a == b;
+    auto& bool_factory = backends_[party_id]->get_gate_factory(gt_wires.at(0)->get_protocol());
+    auto gt_future = bool_factory.make_boolean_output_gate_my(MOTION::ALL_PARTIES, gt_wires);
+    auto eq_future = bool_factory.make_boolean_output_gate_my(MOTION::ALL_PARTIES, eq_wires);
+
+    backends_[party_id]->run();
+
+    std::array<std::vector<std::uint64_t>, 4> values;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      values[i] = results[i].is_arithmetic() ? futures[i].get()
+                                             : bits_to_integers(bit_futures[i].get());
+    }
+    const auto gt_bits = gt_future.get().at(0);
+    const auto eq_bits = eq_future.get().at(0);
+    for (std::size_t simd_i = 0; simd_i < num_simd; ++simd_i) {
+      const auto x = inputs_a_[simd_i];
+      const auto y = inputs_b_[simd_i];
+      EXPECT_EQ(values[0].at(simd_i), x + y);
+      EXPECT_EQ(values[1].at(simd_i), x - y);
+      EXPECT_EQ(values[2].at(simd_i), x * y);
+      EXPECT_EQ(values[3].at(simd_i), x / y);
+      EXPECT_EQ(gt_bits.Get(simd_i), x > y);
+      EXPECT_EQ(eq_bits.Get(simd_i), x == y);
+    }
+  };
+  auto f0 = std::async(std::launch::async, run_party, 0);
+  auto f1 = std::async(std::launch::async, run_party, 1);
+  f0.get();
+  f1.get();
+}
+
+TEST_P(NewSecureUnsignedIntegerTest, Operations) { check_operations(0); }
+
+TEST_P(NewSecureUnsignedIntegerTest, OperationsStreaming) { check_operations(16); }
+
+INSTANTIATE_TEST_SUITE_P(NewSecureUnsignedIntegerTestSuite, NewSecureUnsignedIntegerTest,
+                         ::testing::Values(MOTION::MPCProtocol::ArithmeticGMW,
+                                           MOTION::MPCProtocol::BooleanGMW,
+                                           MOTION::MPCProtocol::ArithmeticBEAVY,
+                                           MOTION::MPCProtocol::BooleanBEAVY,
+                                           MOTION::MPCProtocol::Yao),
+                         [](auto& info) { return MOTION::ToString(info.param); });
+
+TEST(TwoPartyBackend, LazyCircuitStreaming) {
+  using ENCRYPTO::PrimitiveOperation;
+  using ENCRYPTO::PrimitiveOperationType;
+  // inputs a = (0, 1) and b = (2, 3); output 7 = ((a_0 & b_0) ^ a_1) ^ (a_1 & b_1)
+  ENCRYPTO::AlgorithmDescription algo{
+      .n_output_wires_ = 1,
+      .n_input_wires_parent_a_ = 2,
+      .n_wires_ = 8,
+      .n_gates_ = 4,
+      .n_input_wires_parent_b_ = 2,
+      .gates_ = {PrimitiveOperation{.type_ = PrimitiveOperationType::AND,
+                                    .parent_a_ = 0,
+                                    .parent_b_ = 2,
+                                    .output_wire_ = 4},
+                 PrimitiveOperation{.type_ = PrimitiveOperationType::XOR,
+                                    .parent_a_ = 4,
+                                    .parent_b_ = 1,
+                                    .output_wire_ = 5},
+                 PrimitiveOperation{.type_ = PrimitiveOperationType::AND,
+                                    .parent_a_ = 1,
+                                    .parent_b_ = 3,
+                                    .output_wire_ = 6},
+                 PrimitiveOperation{.type_ = PrimitiveOperationType::XOR,
+                                    .parent_a_ = 5,
+                                    .parent_b_ = 6,
+                                    .output_wire_ = 7}}};
+  algo.Levelize();
+  std::array<MOTION::BitValues, 2> inputs;
+  for (auto& bvs : inputs) {
+    bvs = {ENCRYPTO::BitVector<>::Random(num_simd), ENCRYPTO::BitVector<>::Random(num_simd)};
+  }
+  auto comm_layers = MOTION::Communication::make_dummy_communication_layers(2);
+  auto run_party = [&](std::size_t party_id) {
+    auto logger =
+        std::make_shared<MOTION::Logger>(party_id, boost::log::trivial::severity_level::trace);
+    comm_layers[party_id]->set_logger(logger);
+    MOTION::TwoPartyBackend backend(*comm_layers[party_id], 1, false, logger);
+    backend.set_streaming(2);
+    auto& gate_factory = backend.get_gate_factory(MOTION::MPCProtocol::Yao);
+    auto [promise, my_wires] = gate_factory.make_boolean_input_gate_my(party_id, 2, num_simd);
+    auto other_wires = gate_factory.make_boolean_input_gate_other(1 - party_id, 2, num_simd);
+    promise.set_value(inputs[party_id]);
+    const auto& wires_a = party_id == 0 ? my_wires : other_wires;
+    const auto& wires_b = party_id == 0 ? other_wires : my_wires;
+    ENCRYPTO::ReusableFiberFuture<MOTION::BitValues> output_future;
+    bool outputs_created = false;
+    backend.make_circuit_lazily(algo, wires_a, wires_b, [&](const auto& w_out) {
+      outputs_created = true;
+      output_future = gate_factory.make_boolean_output_gate_my(MOTION::ALL_PARTIES, w_out);
+    });
+    // the gates are only created during the evaluation
+    EXPECT_FALSE(outputs_created);
+    backend.run();
+    EXPECT_TRUE(outputs_created);
+    const auto& a = inputs[0];
+    const auto& b = inputs[1];
+    EXPECT_EQ(output_future.get().at(0), ((a[0] & b[0]) ^ a[1]) ^ (a[1] & b[1]));
+    comm_layers[party_id]->shutdown();
+  };
+  auto f0 = std::async(std::launch::async, run_party, 0);
+  auto f1 = std::async(std::launch::async, run_party, 1);
+  f0.get();
+  f1.get();
+}
+
+}  // namespace
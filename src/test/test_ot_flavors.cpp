@@ -267,6 +267,54 @@ TYPED_TEST(ACOTTest, VectorACOT) {
   }
 }
 
+TYPED_TEST(ACOTTest, StreamingVectorACOT) {
+  const std::size_t num_ots = 100;
+  const std::size_t vector_size = 10;
+  const std::size_t block_size = 7;
+  const auto correlations = MOTION::Helpers::RandomVector<TypeParam>(num_ots * vector_size);
+  const auto choice_bits = ENCRYPTO::BitVector<>::Random(num_ots);
+  auto ot_sender =
+      this->get_sender_provider().template RegisterSendACOT<TypeParam>(num_ots, vector_size);
+  auto ot_receiver =
+      this->get_receiver_provider().template RegisterReceiveACOT<TypeParam>(num_ots, vector_size);
+
+  this->run_ot_extension_setup();
+
+  ot_sender->SendMessages([&correlations, vector_size](std::size_t ot_i, TypeParam* buffer) {
+    std::copy_n(&correlations[ot_i * vector_size], vector_size, buffer);
+  });
+
+  ot_receiver->SetChoices(choice_bits);
+  ot_receiver->SendCorrections();
+
+  std::vector<TypeParam> sender_output(num_ots * vector_size);
+  std::vector<TypeParam> receiver_output(num_ots * vector_size);
+  std::vector<std::size_t> sender_num_calls(num_ots, 0);
+  std::vector<std::size_t> receiver_num_calls(num_ots, 0);
+  ot_sender->ComputeOutputs(block_size, [&](std::size_t ot_i, const TypeParam* outputs) {
+    ++sender_num_calls[ot_i];
+    std::copy_n(outputs, vector_size, &sender_output[ot_i * vector_size]);
+  });
+  ot_receiver->ComputeOutputs(block_size, [&](std::size_t ot_i, const TypeParam* outputs) {
+    ++receiver_num_calls[ot_i];
+    std::copy_n(outputs, vector_size, &receiver_output[ot_i * vector_size]);
+  });
+
+  for (std::size_t ot_i = 0; ot_i < num_ots; ++ot_i) {
+    EXPECT_EQ(sender_num_calls[ot_i], 1);
+    EXPECT_EQ(receiver_num_calls[ot_i], 1);
+    for (std::size_t j = 0; j < vector_size; ++j) {
+      if (choice_bits.Get(ot_i)) {
+        EXPECT_EQ(receiver_output[ot_i * vector_size + j],
+                  TypeParam(sender_output[ot_i * vector_size + j] +
+                            correlations[ot_i * vector_size + j]));
+      } else {
+        EXPECT_EQ(receiver_output[ot_i * vector_size + j], sender_output[ot_i * vector_size + j]);
+      }
+    }
+  }
+}
+
 TEST_F(OTFlavorTest, GOT128) {
   const std::size_t num_ots = 1000;
   const auto sender_input = ENCRYPTO::block128_vector::make_random(2 * num_ots);
@@ -351,6 +399,39 @@ TEST_F(OTFlavorTest, ROT) {
   }
 }
 
+TEST_F(OTFlavorTest, ROTMultiThreaded) {
+  const std::size_t num_ots = 10000;
+  const std::size_t vector_size = 1;
+  const bool random_choice = true;
+  for (auto& ot_provider_wrapper : ot_provider_wrappers_) {
+    ot_provider_wrapper->set_num_threads(4);
+  }
+  auto ot_sender = get_sender_provider().RegisterSendROT(num_ots, vector_size, random_choice);
+  auto ot_receiver =
+      get_receiver_provider().RegisterReceiveROT(num_ots, vector_size, random_choice);
+
+  run_ot_extension_setup();
+
+  ot_receiver->ComputeOutputs();
+  const auto receiver_output = ot_receiver->GetOutputs();
+  const auto choice_bits = ot_receiver->GetChoices();
+  ot_sender->ComputeOutputs();
+  const auto [sender_output_m0, sender_output_m1] = ot_sender->GetOutputs();
+
+  ASSERT_EQ(receiver_output.GetSize(), num_ots * vector_size);
+  ASSERT_EQ(choice_bits.GetSize(), num_ots);
+  ASSERT_EQ(sender_output_m0.GetSize(), num_ots * vector_size);
+  ASSERT_EQ(sender_output_m1.GetSize(), num_ots * vector_size);
+
+  for (std::size_t ot_i = 0; ot_i < num_ots; ++ot_i) {
+    if (choice_bits.Get(ot_i)) {
+      ASSERT_EQ(receiver_output.Get(ot_i), sender_output_m1.Get(ot_i));
+    } else {
+      ASSERT_EQ(receiver_output.Get(ot_i), sender_output_m0.Get(ot_i));
+    }
+  }
+}
+
 TEST_F(OTFlavorTest, VectorROT) {
   const std::size_t num_ots = 100;
   const std::size_t vector_size = 16;
@@ -383,3 +464,129 @@ TEST_F(OTFlavorTest, VectorROT) {
     }
   }
 }
+
+// OT extension in several sessions whose base OTs are derived from the same
+// base OTs (cf. BaseOTProvider::ImportDerivedBaseOTs)
+class DerivedBaseOTTest : public OTFlavorTest {
+ protected:
+  struct Session {
+    std::vector<std::unique_ptr<MOTION::Communication::CommunicationLayer>> comm_layers_;
+    std::vector<std::unique_ptr<MOTION::BaseOTProvider>> base_ot_providers_;
+    std::vector<std::unique_ptr<MOTION::Crypto::MotionBaseProvider>> motion_base_providers_;
+    std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::OTProviderManager>>
+        ot_provider_wrappers_;
+  };
+
+  void make_session(std::uint64_t session_id) {
+    auto& session = sessions_.emplace_back();
+    session.comm_layers_ = MOTION::Communication::make_dummy_communication_layers(2);
+    session.base_ot_providers_.resize(2);
+    session.motion_base_providers_.resize(2);
+    session.ot_provider_wrappers_.resize(2);
+    for (std::size_t i = 0; i < 2; ++i) {
+      session.base_ot_providers_[i] =
+          std::make_unique<MOTION::BaseOTProvider>(*session.comm_layers_[i], nullptr, nullptr);
+      session.motion_base_providers_[i] =
+          std::make_unique<MOTION::Crypto::MotionBaseProvider>(*session.comm_layers_[i], nullptr);
+      session.ot_provider_wrappers_[i] =
+          std::make_unique<ENCRYPTO::ObliviousTransfer::OTProviderManager>(
+              *session.comm_layers_[i], *session.base_ot_providers_[i],
+              *session.motion_base_providers_[i], nullptr, nullptr);
+    }
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [this, &session, session_id, i] {
+        session.comm_layers_[i]->start();
+        session.motion_base_providers_[i]->setup();
+        session.base_ot_providers_[i]->ImportDerivedBaseOTs(*base_ot_providers_[i], session_id);
+      }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  void run_ot_extension_setup(Session& session) {
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [&session, i] {
+        session.ot_provider_wrappers_[i]->get_provider(1 - i).SendSetup();
+      }));
+      futs.emplace_back(std::async(std::launch::async, [&session, i] {
+        session.ot_provider_wrappers_[i]->get_provider(1 - i).ReceiveSetup();
+      }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  void TearDown() override {
+    for (auto& session : sessions_) {
+      std::vector<std::future<void>> futs;
+      for (std::size_t i = 0; i < 2; ++i) {
+        futs.emplace_back(std::async(std::launch::async,
+                                     [&session, i] { session.comm_layers_[i]->shutdown(); }));
+      }
+      std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+    }
+    OTFlavorTest::TearDown();
+  }
+
+  std::vector<Session> sessions_;
+};
+
+TEST_F(DerivedBaseOTTest, ROTInTwoSessions) {
+  const std::size_t num_sessions = 2;
+  const std::size_t num_ots = 1000;
+  const std::size_t vector_size = 128;
+  const bool random_choice = true;
+  sessions_.reserve(num_sessions);
+  for (std::uint64_t session_id = 1; session_id <= num_sessions; ++session_id) {
+    make_session(session_id);
+  }
+
+  // the derived base OTs are correct and differ from the original ones
+  const auto source_rcv_msgs = base_ot_providers_[receiver_i_]->ExportBaseOTs(sender_i_).first;
+  std::vector<MOTION::base_ot_msgs_t> session_rcv_messages;
+  for (auto& session : sessions_) {
+    const auto rcv_msgs = session.base_ot_providers_[receiver_i_]->ExportBaseOTs(sender_i_).first;
+    const auto snd_msgs = session.base_ot_providers_[sender_i_]->ExportBaseOTs(receiver_i_).second;
+    ASSERT_EQ(rcv_msgs.c_, source_rcv_msgs.c_);
+    ASSERT_NE(rcv_msgs.messages_c_, source_rcv_msgs.messages_c_);
+    for (std::size_t ot_i = 0; ot_i < rcv_msgs.messages_c_.size(); ++ot_i) {
+      if (rcv_msgs.c_.Get(ot_i)) {
+        ASSERT_EQ(rcv_msgs.messages_c_.at(ot_i), snd_msgs.messages_1_.at(ot_i));
+      } else {
+        ASSERT_EQ(rcv_msgs.messages_c_.at(ot_i), snd_msgs.messages_0_.at(ot_i));
+      }
+    }
+    session_rcv_messages.push_back(rcv_msgs.messages_c_);
+  }
+  ASSERT_NE(session_rcv_messages.at(0), session_rcv_messages.at(1));
+
+  // OT extension works in each session and yields independent outputs
+  std::vector<ENCRYPTO::BitVector<>> session_sender_outputs;
+  for (auto& session : sessions_) {
+    auto ot_sender = session.ot_provider_wrappers_[sender_i_]
+                         ->get_provider(receiver_i_)
+                         .RegisterSendROT(num_ots, vector_size, random_choice);
+    auto ot_receiver = session.ot_provider_wrappers_[receiver_i_]
+                           ->get_provider(sender_i_)
+                           .RegisterReceiveROT(num_ots, vector_size, random_choice);
+
+    run_ot_extension_setup(session);
+
+    ot_receiver->ComputeOutputs();
+    const auto receiver_output = ot_receiver->GetOutputs();
+    const auto choice_bits = ot_receiver->GetChoices();
+    ot_sender->ComputeOutputs();
+    const auto [sender_output_m0, sender_output_m1] = ot_sender->GetOutputs();
+
+    ASSERT_EQ(receiver_output.GetSize(), num_ots * vector_size);
+    ASSERT_EQ(sender_output_m0.GetSize(), num_ots * vector_size);
+    for (std::size_t ot_i = 0; ot_i < num_ots; ++ot_i) {
+      const auto r_bits = receiver_output.Subset(ot_i * vector_size, (ot_i + 1) * vector_size);
+      const auto& sender_output = choice_bits.Get(ot_i) ? sender_output_m1 : sender_output_m0;
+      ASSERT_EQ(r_bits, sender_output.Subset(ot_i * vector_size, (ot_i + 1) * vector_size));
+    }
+    session_sender_outputs.push_back(sender_output_m0);
+  }
+  ASSERT_NE(session_sender_outputs.at(0), session_sender_outputs.at(1));
+}
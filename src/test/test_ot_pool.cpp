@@ -0,0 +1,243 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "communication/communication_layer.h"
+#include "crypto/base_ots/base_ot_provider.h"
+#include "crypto/motion_base_provider.h"
+#include "crypto/oblivious_transfer/ot_flavors.h"
+#include "crypto/oblivious_transfer/ot_pool.h"
+#include "crypto/oblivious_transfer/ot_provider.h"
+#include "utility/block.h"
+
+class OTPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    comm_layers_ = MOTION::Communication::make_dummy_communication_layers(2);
+    base_ot_providers_.resize(2);
+    motion_base_providers_.resize(2);
+    for (std::size_t i = 0; i < 2; ++i) {
+      base_ot_providers_[i] =
+          std::make_unique<MOTION::BaseOTProvider>(*comm_layers_[i], nullptr, nullptr);
+      motion_base_providers_[i] =
+          std::make_unique<MOTION::Crypto::MotionBaseProvider>(*comm_layers_[i], nullptr);
+    }
+
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [this, i] {
+        comm_layers_[i]->start();
+        motion_base_providers_[i]->setup();
+        base_ot_providers_[i]->ComputeBaseOTs();
+      }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  void TearDown() override {
+    ot_pool_managers_.clear();
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [this, i] { comm_layers_[i]->shutdown(); }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  void start_pools(const ENCRYPTO::ObliviousTransfer::OTPoolConfig& config) {
+    ot_pool_managers_.resize(2);
+    for (std::size_t i = 0; i < 2; ++i) {
+      ot_pool_managers_[i] = std::make_unique<ENCRYPTO::ObliviousTransfer::ROTPoolManager>(
+          *comm_layers_[i], *base_ot_providers_[i], *motion_base_providers_[i], config, nullptr);
+    }
+    for (std::size_t i = 0; i < 2; ++i) {
+      ot_pool_managers_[i]->start();
+    }
+  }
+
+  const std::size_t sender_i_ = 0;
+  const std::size_t receiver_i_ = 1;
+  ENCRYPTO::ObliviousTransfer::ROTPoolSender& get_sender() {
+    return ot_pool_managers_[sender_i_]->get_sender(receiver_i_);
+  }
+  ENCRYPTO::ObliviousTransfer::ROTPoolReceiver& get_receiver() {
+    return ot_pool_managers_[receiver_i_]->get_receiver(sender_i_);
+  }
+
+  std::vector<std::unique_ptr<MOTION::Communication::CommunicationLayer>> comm_layers_;
+  std::vector<std::unique_ptr<MOTION::BaseOTProvider>> base_ot_providers_;
+  std::vector<std::unique_ptr<MOTION::Crypto::MotionBaseProvider>> motion_base_providers_;
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::ROTPoolManager>> ot_pool_managers_;
+};
+
+TEST_F(OTPoolTest, InvalidConfig) {
+  ENCRYPTO::ObliviousTransfer::OTPoolConfig config;
+  config.chunk_size = 1000;
+  EXPECT_THROW(start_pools(config), std::invalid_argument);
+}
+
+TEST_F(OTPoolTest, ROT) {
+  ENCRYPTO::ObliviousTransfer::OTPoolConfig config;
+  config.chunk_size = 1024;
+  config.low_water_mark = 512;
+  config.max_chunks = 2;
+  config.num_threads = 2;
+  start_pools(config);
+
+  // ranges which are smaller than a chunk, span several chunks, and exceed
+  // the capacity of the pool
+  const std::vector<std::size_t> num_ots_list = {100, 1500, 3000, 7, 0, 1024};
+  std::size_t expected_offset = 0;
+  for (const auto num_ots : num_ots_list) {
+    auto sender_fut =
+        std::async(std::launch::async, [this, num_ots] { return get_sender().acquire(num_ots); });
+    auto receiver_fut = std::async(std::launch::async,
+                                   [this, num_ots] { return get_receiver().acquire(num_ots); });
+    const auto sender_range = sender_fut.get();
+    const auto receiver_range = receiver_fut.get();
+
+    EXPECT_EQ(sender_range.offset_, expected_offset);
+    EXPECT_EQ(receiver_range.offset_, expected_offset);
+    ASSERT_EQ(sender_range.messages_0_.size(), num_ots);
+    ASSERT_EQ(sender_range.messages_1_.size(), num_ots);
+    ASSERT_EQ(receiver_range.choices_.GetSize(), num_ots);
+    ASSERT_EQ(receiver_range.messages_.size(), num_ots);
+
+    for (std::size_t ot_i = 0; ot_i < num_ots; ++ot_i) {
+      EXPECT_NE(sender_range.messages_0_[ot_i], sender_range.messages_1_[ot_i]);
+      if (receiver_range.choices_.Get(ot_i)) {
+        ASSERT_EQ(receiver_range.messages_[ot_i], sender_range.messages_1_[ot_i]);
+      } else {
+        ASSERT_EQ(receiver_range.messages_[ot_i], sender_range.messages_0_[ot_i]);
+      }
+    }
+    expected_offset += num_ots;
+  }
+
+  const auto total = expected_offset;
+  for (const auto& statistics :
+       {get_sender().get_statistics(), get_receiver().get_statistics()}) {
+    EXPECT_EQ(statistics.num_acquisitions, num_ots_list.size());
+    EXPECT_EQ(statistics.num_ots_consumed, total);
+    EXPECT_GE(statistics.num_ots_generated, total);
+    EXPECT_EQ(statistics.num_ots_generated, statistics.num_chunks_generated * config.chunk_size);
+    EXPECT_LE(statistics.max_ots_available,
+              statistics.num_chunks_generated * config.chunk_size);
+  }
+  // the receiver never buffers more than max_chunks chunks
+  EXPECT_LE(get_receiver().get_statistics().max_ots_available,
+            config.max_chunks * config.chunk_size);
+}
+
+TEST_F(OTPoolTest, BackPressure) {
+  ENCRYPTO::ObliviousTransfer::OTPoolConfig config;
+  config.chunk_size = 1024;
+  // the receiver always wants to generate more OTs
+  config.low_water_mark = 16 * config.chunk_size;
+  config.max_chunks = 2;
+  start_pools(config);
+
+  // the receiver can use up all chunks while the sender does not consume any
+  const auto num_ots = config.max_chunks * config.chunk_size;
+  get_receiver().acquire(num_ots);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  // but it does not generate further chunks until the sender has caught up
+  EXPECT_EQ(get_receiver().get_statistics().num_chunks_generated, config.max_chunks);
+  EXPECT_LE(get_sender().get_statistics().max_ots_available, num_ots);
+  get_sender().acquire(num_ots);
+
+  auto sender_fut =
+      std::async(std::launch::async, [this, num_ots] { return get_sender().acquire(num_ots); });
+  auto receiver_fut =
+      std::async(std::launch::async, [this, num_ots] { return get_receiver().acquire(num_ots); });
+  const auto sender_range = sender_fut.get();
+  const auto receiver_range = receiver_fut.get();
+  for (std::size_t ot_i = 0; ot_i < num_ots; ++ot_i) {
+    const auto& expected = receiver_range.choices_.Get(ot_i) ? sender_range.messages_1_[ot_i]
+                                                             : sender_range.messages_0_[ot_i];
+    ASSERT_EQ(receiver_range.messages_[ot_i], expected);
+  }
+  EXPECT_LE(get_sender().get_statistics().max_ots_available, num_ots);
+}
+
+TEST_F(OTPoolTest, OTProviderFromPool) {
+  ENCRYPTO::ObliviousTransfer::OTPoolConfig config;
+  config.chunk_size = 1024;
+  config.low_water_mark = 512;
+  config.max_chunks = 2;
+  start_pools(config);
+
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::OTProviderManager>> ot_managers;
+  for (std::size_t i = 0; i < 2; ++i) {
+    ot_managers.emplace_back(std::make_unique<ENCRYPTO::ObliviousTransfer::OTProviderManager>(
+        *comm_layers_[i], *base_ot_providers_[i], *motion_base_providers_[i], nullptr, nullptr,
+        nullptr, ot_pool_managers_[i].get()));
+  }
+
+  // more than a chunk, and 160 bit messages which are expanded from the
+  // 128 bit OTs of the pool
+  const std::size_t num_ots = 1500;
+  const std::size_t vector_size = 5;
+  const auto correlations = std::vector<std::uint32_t>(num_ots * vector_size, 0x12345678);
+  const auto choice_bits = ENCRYPTO::BitVector<>::Random(num_ots);
+  auto ot_sender =
+      ot_managers[sender_i_]->get_provider(receiver_i_).RegisterSendACOT<std::uint32_t>(
+          num_ots, vector_size);
+  auto ot_receiver =
+      ot_managers[receiver_i_]->get_provider(sender_i_).RegisterReceiveACOT<std::uint32_t>(
+          num_ots, vector_size);
+
+  auto sender_fut =
+      std::async(std::launch::async, [&ot_managers] { ot_managers[0]->run_setup(); });
+  auto receiver_fut =
+      std::async(std::launch::async, [&ot_managers] { ot_managers[1]->run_setup(); });
+  sender_fut.get();
+  receiver_fut.get();
+
+  ot_sender->SetCorrelations(correlations);
+  ot_sender->SendMessages();
+  ot_receiver->SetChoices(choice_bits);
+  ot_receiver->SendCorrections();
+  ot_sender->ComputeOutputs();
+  ot_receiver->ComputeOutputs();
+  const auto& sender_output = ot_sender->GetOutputs();
+  const auto& receiver_output = ot_receiver->GetOutputs();
+  ASSERT_EQ(sender_output.size(), num_ots * vector_size);
+  ASSERT_EQ(receiver_output.size(), num_ots * vector_size);
+  for (std::size_t ot_i = 0; ot_i < num_ots; ++ot_i) {
+    for (std::size_t j = 0; j < vector_size; ++j) {
+      const auto i = ot_i * vector_size + j;
+      const auto expected =
+          choice_bits.Get(ot_i) ? std::uint32_t(sender_output[i] + correlations[i])
+                                : sender_output[i];
+      ASSERT_EQ(receiver_output[i], expected);
+    }
+  }
+  EXPECT_EQ(get_sender().get_statistics().num_ots_consumed, num_ots);
+  EXPECT_EQ(get_receiver().get_statistics().num_ots_consumed, num_ots);
+}
@@ -20,11 +20,16 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "test_constants.h"
 
 #include "crypto/random/aes128_ctr_rng.h"
+#include "crypto/sharing_randomness_generator.h"
 
 // Test vectors from NIST FIPS 197, Appendix A
 
@@ -53,3 +58,35 @@ TEST(AES128_CTR_RNG, no_trivial_output) {
   rngt.random_blocks_aligned(output_1.data(), 10);
   EXPECT_NE(output_0, output_1);
 }
+
+template <typename T>
+class SharingRandomnessGeneratorTest : public ::testing::Test {};
+
+using UnsignedTypes = ::testing::Types<std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t,
+                                       __uint128_t>;
+TYPED_TEST_SUITE(SharingRandomnessGeneratorTest, UnsignedTypes);
+
+TYPED_TEST(SharingRandomnessGeneratorTest, GetUnsignedIndependentOfBatching) {
+  std::array<std::byte, MOTION::Crypto::SharingRandomnessGenerator::MASTER_SEED_BYTE_LENGTH> seed;
+  AES128_CTR_RNG::get_thread_instance().random_bytes(seed.data(), seed.size());
+  MOTION::Crypto::SharingRandomnessGenerator rng_0(0);
+  MOTION::Crypto::SharingRandomnessGenerator rng_1(1);
+  rng_0.Initialize(seed.data());
+  rng_1.Initialize(seed.data());
+
+  const std::size_t num_values = 100;
+  const auto values = rng_0.template GetUnsigned<TypeParam>(0, num_values);
+  // both parties obtain the same values
+  EXPECT_EQ(values, rng_1.template GetUnsigned<TypeParam>(0, num_values));
+  // values are not trivial
+  EXPECT_NE(values, std::vector<TypeParam>(num_values, 0));
+
+  // the value for each gate id does not depend on the requested range
+  for (std::size_t gate_id : {1, 3, 7, 16, 33}) {
+    for (std::size_t n : {1, 2, 5, 17, 40}) {
+      auto output = rng_1.template GetUnsigned<TypeParam>(gate_id, n);
+      EXPECT_TRUE(std::equal(std::begin(output), std::end(output), &values[gate_id]));
+    }
+    EXPECT_EQ(rng_1.template GetUnsigned<TypeParam>(gate_id), values[gate_id]);
+  }
+}
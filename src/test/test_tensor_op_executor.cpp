@@ -0,0 +1,180 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include <omp.h>
+
+#include "base/gate_register.h"
+#include "executor/tensor_op_executor.h"
+#include "gate/new_gate.h"
+#include "statistics/run_time_stats.h"
+#include "utility/thread_budget.h"
+
+using namespace MOTION;
+
+namespace {
+
+struct TestState {
+  std::promise<void> local_online_promise;
+  std::shared_future<void> local_online_future = local_online_promise.get_future().share();
+  std::atomic<bool> setup_finished = false;
+  std::atomic<bool> setup_saw_local_online = false;
+  std::atomic<bool> local_online_saw_setup = false;
+  std::atomic<bool> dependent_online_saw_setup = false;
+};
+
+// gate with a setup phase which waits (for a limited time) until the online
+// phase of the local gate has been evaluated
+class SlowSetupGate : public NewGate {
+ public:
+  SlowSetupGate(std::size_t gate_id, TestState& state) : NewGate(gate_id), state_(state) {}
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override {
+    auto status = state_.local_online_future.wait_for(std::chrono::milliseconds(500));
+    state_.setup_saw_local_online = status == std::future_status::ready;
+    state_.setup_finished = true;
+  }
+  void evaluate_online() override {}
+
+ private:
+  TestState& state_;
+};
+
+class LocalGate : public NewGate {
+ public:
+  LocalGate(std::size_t gate_id, TestState& state) : NewGate(gate_id), state_(state) {}
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  bool online_needs_setup() const noexcept override { return false; }
+  void evaluate_setup() override {}
+  void evaluate_online() override {
+    state_.local_online_saw_setup = state_.setup_finished.load();
+    state_.local_online_promise.set_value();
+  }
+
+ private:
+  TestState& state_;
+};
+
+class DependentGate : public NewGate {
+ public:
+  DependentGate(std::size_t gate_id, TestState& state) : NewGate(gate_id), state_(state) {}
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override {
+    state_.dependent_online_saw_setup = state_.setup_finished.load();
+  }
+
+ private:
+  TestState& state_;
+};
+
+void run_executor(TestState& state, bool sync_between_setup_and_online, bool speculative_online) {
+  GateRegister gate_register;
+  gate_register.register_gate(
+      std::make_unique<SlowSetupGate>(gate_register.get_next_gate_id(), state));
+  gate_register.register_gate(std::make_unique<LocalGate>(gate_register.get_next_gate_id(), state));
+  gate_register.register_gate(
+      std::make_unique<DependentGate>(gate_register.get_next_gate_id(), state));
+  TensorOpExecutor executor(
+      gate_register, [] {}, sync_between_setup_and_online, [] {}, 1, nullptr);
+  executor.set_speculative_online(speculative_online);
+  Statistics::RunTimeStats stats;
+  executor.evaluate_setup_online(stats);
+}
+
+}  // namespace
+
+TEST(TensorOpExecutor, SequentialOnlineByDefault) {
+  TestState state;
+  run_executor(state, false, false);
+  EXPECT_FALSE(state.setup_saw_local_online);
+  EXPECT_TRUE(state.local_online_saw_setup);
+  EXPECT_TRUE(state.dependent_online_saw_setup);
+}
+
+TEST(TensorOpExecutor, SpeculativeOnline) {
+  TestState state;
+  run_executor(state, false, true);
+  // the online phase of the local gate has been evaluated during the setup phase
+  EXPECT_TRUE(state.setup_saw_local_online);
+  EXPECT_FALSE(state.local_online_saw_setup);
+  // gates which depend on the setup phase still wait for it
+  EXPECT_TRUE(state.dependent_online_saw_setup);
+}
+
+TEST(TensorOpExecutor, SynchronizedOnline) {
+  TestState state;
+  run_executor(state, true, false);
+  EXPECT_FALSE(state.setup_saw_local_online);
+  EXPECT_TRUE(state.local_online_saw_setup);
+  EXPECT_TRUE(state.dependent_online_saw_setup);
+}
+
+TEST(TensorOpExecutor, SpeculativeOnlineWithSync) {
+  GateRegister gate_register;
+  TensorOpExecutor executor(gate_register, [] {}, true, [] {}, 1, nullptr);
+  EXPECT_THROW(executor.set_speculative_online(true), std::logic_error);
+}
+
+TEST(ThreadBudget, Leases) {
+  ThreadBudget budget(3);
+  {
+    auto lease_a = budget.acquire(2);
+    EXPECT_EQ(lease_a.get_num_threads(), 2);
+    // only the remaining thread is leased
+    auto lease_b = budget.acquire(0);
+    EXPECT_EQ(lease_b.get_num_threads(), 1);
+    EXPECT_EQ(budget.get_num_available_threads(), 0);
+  }
+  EXPECT_EQ(budget.get_num_available_threads(), 3);
+}
+
+TEST(TensorOpExecutor, ThreadBudget) {
+  auto budget = std::make_shared<ThreadBudget>(3);
+  GateRegister gate_register;
+  int omp_threads = 0;
+  std::size_t available_threads = 0;
+  TensorOpExecutor executor(
+      gate_register,
+      [&] {
+        omp_threads = omp_get_max_threads();
+        available_threads = budget->get_num_available_threads();
+      },
+      8, nullptr);
+  executor.set_thread_budget(budget);
+  Statistics::RunTimeStats stats;
+  executor.evaluate_setup_online(stats);
+  // the executor is limited to the budget and returns its threads afterwards
+  EXPECT_EQ(omp_threads, 3);
+  EXPECT_EQ(available_threads, 0);
+  EXPECT_EQ(budget->get_num_available_threads(), 3);
+}
@@ -0,0 +1,317 @@
+// MIT License
+//
+// Copyright (c) 2020 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "communication/communication_layer.h"
+#include "crypto/base_ots/base_ot_provider.h"
+#include "crypto/motion_base_provider.h"
+#include "crypto/multiplication_triple/mt_provider.h"
+#include "crypto/multiplication_triple/sb_provider.h"
+#include "crypto/multiplication_triple/sp_provider.h"
+#include "crypto/oblivious_transfer/ot_flavors.h"
+#include "crypto/oblivious_transfer/ot_provider.h"
+#include "crypto/trusted_dealer.h"
+#include "statistics/run_time_stats.h"
+
+using namespace MOTION;
+
+namespace {
+
+constexpr std::uint64_t seed = 42;
+constexpr std::size_t num_parties = 3;
+constexpr std::size_t num_values = 100;
+
+std::vector<Crypto::TrustedDealer> make_dealers() {
+  std::vector<Crypto::TrustedDealer> dealers;
+  for (std::size_t party_id = 0; party_id < num_parties; ++party_id) {
+    dealers.emplace_back(seed, party_id, num_parties);
+  }
+  return dealers;
+}
+
+}  // namespace
+
+TEST(TrustedDealer, InvalidPartyId) {
+  EXPECT_THROW(Crypto::TrustedDealer(seed, 2, 2), std::invalid_argument);
+}
+
+TEST(TrustedDealer, CommonRandomness) {
+  const auto dealers = make_dealers();
+  const auto values = dealers.at(0).random_values<std::uint32_t>("values", num_values);
+  const auto bits = dealers.at(0).random_bits("bits", num_values);
+  ASSERT_EQ(values.size(), num_values);
+  ASSERT_EQ(bits.GetSize(), num_values);
+  for (const auto& dealer : dealers) {
+    EXPECT_EQ(dealer.random_values<std::uint32_t>("values", num_values), values);
+    EXPECT_EQ(dealer.random_bits("bits", num_values), bits);
+  }
+  EXPECT_NE(dealers.at(0).random_values<std::uint32_t>("other_values", num_values), values);
+  EXPECT_NE(Crypto::TrustedDealer(seed + 1, 0, num_parties)
+                .random_values<std::uint32_t>("values", num_values),
+            values);
+}
+
+TEST(TrustedDealer, Share) {
+  const auto dealers = make_dealers();
+  const auto values = dealers.at(0).random_values<std::uint64_t>("values", num_values);
+  const auto bits = dealers.at(0).random_bits("bits", num_values);
+  std::vector<std::uint64_t> sum(num_values, 0);
+  ENCRYPTO::BitVector<> xor_sum(num_values, false);
+  for (const auto& dealer : dealers) {
+    const auto shares = dealer.share("shares", values);
+    ASSERT_EQ(shares.size(), num_values);
+    for (std::size_t i = 0; i < num_values; ++i) {
+      sum.at(i) += shares.at(i);
+    }
+    xor_sum ^= dealer.share("bit_shares", bits);
+  }
+  EXPECT_EQ(sum, values);
+  EXPECT_EQ(xor_sum, bits);
+}
+
+TEST(TrustedDealer, MTsAndSPs) {
+  const auto dealers = make_dealers();
+  std::vector<Statistics::RunTimeStats> run_time_stats(num_parties);
+  std::vector<std::unique_ptr<MTProvider>> mt_providers;
+  std::vector<std::unique_ptr<SPProvider>> sp_providers;
+  for (std::size_t party_id = 0; party_id < num_parties; ++party_id) {
+    mt_providers.emplace_back(std::make_unique<MTProviderFromDealer>(
+        dealers.at(party_id), run_time_stats.at(party_id), nullptr));
+    sp_providers.emplace_back(std::make_unique<SPProviderFromDealer>(
+        dealers.at(party_id), run_time_stats.at(party_id), nullptr));
+    mt_providers.back()->RequestBinaryMTs(num_values);
+    mt_providers.back()->RequestArithmeticMTs<std::uint32_t>(num_values);
+    sp_providers.back()->RequestSPs<std::uint16_t>(num_values);
+    mt_providers.back()->PreSetup();
+    sp_providers.back()->PreSetup();
+    mt_providers.back()->Setup();
+    sp_providers.back()->Setup();
+  }
+
+  ENCRYPTO::BitVector<> bin_a(num_values, false), bin_b(num_values, false),
+      bin_c(num_values, false);
+  std::vector<std::uint32_t> int_a(num_values, 0), int_b(num_values, 0), int_c(num_values, 0);
+  std::vector<std::uint16_t> sp_a(num_values, 0), sp_c(num_values, 0);
+  for (std::size_t party_id = 0; party_id < num_parties; ++party_id) {
+    const auto& bin_mts = mt_providers.at(party_id)->GetBinaryAll();
+    bin_a ^= bin_mts.a;
+    bin_b ^= bin_mts.b;
+    bin_c ^= bin_mts.c;
+    const auto& int_mts = mt_providers.at(party_id)->GetIntegerAll<std::uint32_t>();
+    const auto& sps = sp_providers.at(party_id)->GetSPsAll<std::uint16_t>();
+    for (std::size_t i = 0; i < num_values; ++i) {
+      int_a.at(i) += int_mts.a.at(i);
+      int_b.at(i) += int_mts.b.at(i);
+      int_c.at(i) += int_mts.c.at(i);
+      sp_a.at(i) += sps.a.at(i);
+      sp_c.at(i) += sps.c.at(i);
+    }
+  }
+  EXPECT_EQ(bin_a & bin_b, bin_c);
+  for (std::size_t i = 0; i < num_values; ++i) {
+    EXPECT_EQ(std::uint32_t(int_a.at(i) * int_b.at(i)), int_c.at(i));
+    EXPECT_EQ(std::uint16_t(sp_a.at(i) * sp_a.at(i)), sp_c.at(i));
+  }
+}
+
+TEST(TrustedDealer, SBs) {
+  std::vector<Crypto::TrustedDealer> dealers;
+  std::vector<Statistics::RunTimeStats> run_time_stats(2);
+  std::vector<std::unique_ptr<SBProvider>> sb_providers;
+  for (std::size_t party_id = 0; party_id < 2; ++party_id) {
+    dealers.emplace_back(seed, party_id, 2);
+  }
+  for (std::size_t party_id = 0; party_id < 2; ++party_id) {
+    sb_providers.emplace_back(std::make_unique<SBProviderFromDealer>(
+        dealers.at(party_id), run_time_stats.at(party_id), nullptr));
+    sb_providers.back()->RequestSBs<std::uint8_t>(num_values);
+    sb_providers.back()->RequestSBs<std::uint64_t>(num_values);
+    sb_providers.back()->PreSetup();
+    sb_providers.back()->Setup();
+  }
+
+  const auto& sbs_8_0 = sb_providers.at(0)->GetSBsAll<std::uint8_t>();
+  const auto& sbs_8_1 = sb_providers.at(1)->GetSBsAll<std::uint8_t>();
+  const auto& sbs_64_0 = sb_providers.at(0)->GetSBsAll<std::uint64_t>();
+  const auto& sbs_64_1 = sb_providers.at(1)->GetSBsAll<std::uint64_t>();
+  ASSERT_EQ(sbs_8_0.size(), num_values);
+  ASSERT_EQ(sbs_8_1.size(), num_values);
+  ASSERT_EQ(sbs_64_0.size(), num_values);
+  ASSERT_EQ(sbs_64_1.size(), num_values);
+  std::size_t num_ones = 0;
+  for (std::size_t i = 0; i < num_values; ++i) {
+    // the shares add up to a bit
+    const std::uint8_t bit_8 = sbs_8_0.at(i) + sbs_8_1.at(i);
+    const std::uint64_t bit_64 = sbs_64_0.at(i) + sbs_64_1.at(i);
+    EXPECT_LE(bit_8, 1);
+    EXPECT_LE(bit_64, 1);
+    num_ones += bit_64;
+  }
+  // the bits are random
+  EXPECT_GT(num_ones, 0);
+  EXPECT_LT(num_ones, num_values);
+}
+
+class TrustedDealerOTTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    comm_layers_ = Communication::make_dummy_communication_layers(2);
+    for (std::size_t i = 0; i < 2; ++i) {
+      dealers_.emplace_back(std::make_unique<Crypto::TrustedDealer>(seed, i, 2));
+      base_ot_providers_.emplace_back(
+          std::make_unique<BaseOTProvider>(*comm_layers_[i], nullptr, nullptr));
+      motion_base_providers_.emplace_back(
+          std::make_unique<Crypto::MotionBaseProvider>(*comm_layers_[i], nullptr));
+      ot_provider_managers_.emplace_back(
+          std::make_unique<ENCRYPTO::ObliviousTransfer::OTProviderManager>(
+              *comm_layers_[i], *base_ot_providers_[i], *motion_base_providers_[i], nullptr,
+              nullptr, dealers_[i].get()));
+    }
+    for (auto& comm_layer : comm_layers_) {
+      comm_layer->start();
+    }
+  }
+
+  void TearDown() override {
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(std::async(std::launch::async, [this, i] { comm_layers_[i]->shutdown(); }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  ENCRYPTO::ObliviousTransfer::OTProvider& get_provider(std::size_t my_id, std::size_t other_id) {
+    return ot_provider_managers_.at(my_id)->get_provider(other_id);
+  }
+
+  // both parties act as sender and as receiver
+  void run_setup() {
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(
+          std::async(std::launch::async, [this, i] { get_provider(i, 1 - i).SendSetup(); }));
+      futs.emplace_back(
+          std::async(std::launch::async, [this, i] { get_provider(i, 1 - i).ReceiveSetup(); }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  std::vector<std::unique_ptr<Communication::CommunicationLayer>> comm_layers_;
+  std::vector<std::unique_ptr<Crypto::TrustedDealer>> dealers_;
+  std::vector<std::unique_ptr<BaseOTProvider>> base_ot_providers_;
+  std::vector<std::unique_ptr<Crypto::MotionBaseProvider>> motion_base_providers_;
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::OTProviderManager>>
+      ot_provider_managers_;
+};
+
+TEST_F(TrustedDealerOTTest, ROTInBothDirections) {
+  const std::size_t vector_size = 3;
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::ROTSender>> senders;
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::ROTReceiver>> receivers;
+  // senders[i] and receivers[i] belong to the OTs from party i to party 1 - i
+  for (std::size_t sender_i = 0; sender_i < 2; ++sender_i) {
+    senders.emplace_back(
+        get_provider(sender_i, 1 - sender_i).RegisterSendROT(num_values, vector_size, true));
+    receivers.emplace_back(
+        get_provider(1 - sender_i, sender_i).RegisterReceiveROT(num_values, vector_size, true));
+  }
+
+  run_setup();
+
+  std::vector<ENCRYPTO::BitVector<>> receiver_outputs;
+  for (std::size_t sender_i = 0; sender_i < 2; ++sender_i) {
+    receivers[sender_i]->ComputeOutputs();
+    senders[sender_i]->ComputeOutputs();
+    const auto receiver_output = receivers[sender_i]->GetOutputs();
+    const auto choice_bits = receivers[sender_i]->GetChoices();
+    const auto [sender_output_m0, sender_output_m1] = senders[sender_i]->GetOutputs();
+    ASSERT_EQ(receiver_output.GetSize(), num_values * vector_size);
+    ASSERT_EQ(choice_bits.GetSize(), num_values);
+    ASSERT_EQ(sender_output_m0.GetSize(), num_values * vector_size);
+    ASSERT_EQ(sender_output_m1.GetSize(), num_values * vector_size);
+    for (std::size_t ot_i = 0; ot_i < num_values; ++ot_i) {
+      const auto& expected = choice_bits.Get(ot_i) ? sender_output_m1 : sender_output_m0;
+      EXPECT_EQ(receiver_output.Subset(ot_i * vector_size, (ot_i + 1) * vector_size),
+                expected.Subset(ot_i * vector_size, (ot_i + 1) * vector_size));
+    }
+    EXPECT_NE(sender_output_m0, sender_output_m1);
+    receiver_outputs.push_back(receiver_output);
+  }
+  // the two directions use different OTs
+  EXPECT_NE(receiver_outputs.at(0), receiver_outputs.at(1));
+}
+
+TEST_F(TrustedDealerOTTest, ACOTInBothDirections) {
+  const std::size_t vector_size = 5;
+  std::vector<std::vector<std::uint32_t>> correlations;
+  std::vector<ENCRYPTO::BitVector<>> choice_bits;
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::ACOTSender<std::uint32_t>>> senders;
+  std::vector<std::unique_ptr<ENCRYPTO::ObliviousTransfer::ACOTReceiver<std::uint32_t>>>
+      receivers;
+  // senders[i] and receivers[i] belong to the OTs from party i to party 1 - i
+  for (std::size_t sender_i = 0; sender_i < 2; ++sender_i) {
+    correlations.emplace_back(dealers_[0]->random_values<std::uint32_t>(
+        "correlations_" + std::to_string(sender_i), num_values * vector_size));
+    choice_bits.emplace_back(ENCRYPTO::BitVector<>::Random(num_values));
+    senders.emplace_back(get_provider(sender_i, 1 - sender_i)
+                             .RegisterSendACOT<std::uint32_t>(num_values, vector_size));
+    receivers.emplace_back(get_provider(1 - sender_i, sender_i)
+                               .RegisterReceiveACOT<std::uint32_t>(num_values, vector_size));
+  }
+
+  run_setup();
+
+  for (std::size_t sender_i = 0; sender_i < 2; ++sender_i) {
+    senders[sender_i]->SetCorrelations(correlations[sender_i]);
+    senders[sender_i]->SendMessages();
+    receivers[sender_i]->SetChoices(choice_bits[sender_i]);
+    receivers[sender_i]->SendCorrections();
+  }
+  for (std::size_t sender_i = 0; sender_i < 2; ++sender_i) {
+    senders[sender_i]->ComputeOutputs();
+    receivers[sender_i]->ComputeOutputs();
+    const auto& sender_output = senders[sender_i]->GetOutputs();
+    const auto& receiver_output = receivers[sender_i]->GetOutputs();
+    ASSERT_EQ(sender_output.size(), num_values * vector_size);
+    ASSERT_EQ(receiver_output.size(), num_values * vector_size);
+    for (std::size_t ot_i = 0; ot_i < num_values; ++ot_i) {
+      for (std::size_t j = 0; j < vector_size; ++j) {
+        const auto i = ot_i * vector_size + j;
+        if (choice_bits[sender_i].Get(ot_i)) {
+          EXPECT_EQ(receiver_output[i],
+                    std::uint32_t(sender_output[i] + correlations[sender_i][i]));
+        } else {
+          EXPECT_EQ(receiver_output[i], sender_output[i]);
+        }
+      }
+    }
+  }
+}
@@ -21,13 +21,19 @@
 // SOFTWARE.
 
 #include <array>
+#include <algorithm>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
 #include <type_traits>
 
 #include <gtest/gtest.h>
 
 #include "algorithm/circuit_loader.h"
+#include "algorithm/tree_ensemble.h"
 #include "base/gate_register.h"
 #include "communication/communication_layer.h"
 #include "crypto/arithmetic_provider.h"
@@ -46,6 +52,8 @@
 #include "protocols/yao/tensor.h"
 #include "protocols/yao/yao_provider.h"
 #include "statistics/run_time_stats.h"
+#include "tensor/activations.h"
+#include "tensor/network_builder.h"
 #include "tensor/tensor.h"
 #include "utility/helpers.h"
 #include "utility/linear_algebra.h"
@@ -786,6 +794,552 @@ TYPED_TEST(YaoArithmeticGMWTensorTest, MaxPoolInBooleanGMW) {
   EXPECT_EQ(output, expected_output);
 }
 
+// recovers the plaintext values from the garbler's zero keys and the evaluator's keys
+template <typename T>
+static std::vector<T> decode_yao_tensor(const YaoTensorCP& garbler_tensor,
+                                        const YaoTensorCP& evaluator_tensor,
+                                        const ENCRYPTO::block128_t& R) {
+  const auto bit_size = garbler_tensor->get_bit_size();
+  const auto data_size = garbler_tensor->get_dimensions().get_data_size();
+  const auto& zero_keys = garbler_tensor->get_keys();
+  const auto& evaluator_keys = evaluator_tensor->get_keys();
+  std::vector<T> values(data_size, 0);
+  for (std::size_t int_i = 0; int_i < data_size; ++int_i) {
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      auto idx = bit_j * data_size + int_i;
+      if (evaluator_keys.at(idx) == (zero_keys.at(idx) ^ R)) {
+        values[int_i] |= T(1) << bit_j;
+      } else {
+        EXPECT_EQ(evaluator_keys.at(idx), zero_keys.at(idx));
+      }
+    }
+  }
+  return values;
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, Eq) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 5, .width_ = 7};
+  const auto input_a = this->generate_inputs(dims);
+  auto input_b = this->generate_inputs(dims);
+  for (std::size_t i = 0; i < input_b.size(); i += 3) {
+    input_b[i] = input_a[i];
+  }
+
+  auto [input_promise_a, tensor_in_a_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_a_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto [input_promise_b, tensor_in_b_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_b_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_a_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_a_0);
+  auto tensor_a_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_a_1);
+  auto tensor_b_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_b_0);
+  auto tensor_b_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_b_1);
+  auto output_tensor_0 = this->yao_providers_[0]->make_tensor_eq_op(tensor_a_0, tensor_b_0);
+  auto output_tensor_1 = this->yao_providers_[1]->make_tensor_eq_op(tensor_a_1, tensor_b_1);
+  ASSERT_EQ(output_tensor_0->get_dimensions(), dims);
+  ASSERT_EQ(output_tensor_0->get_bit_size(), 1);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise_a.set_value(input_a);
+  input_promise_b.set_value(input_b);
+  this->run_gates_online();
+
+  const auto yao_tensor_0 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_0);
+  const auto yao_tensor_1 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_1);
+  ASSERT_NE(yao_tensor_0, nullptr);
+  ASSERT_NE(yao_tensor_1, nullptr);
+  yao_tensor_0->wait_setup();
+  yao_tensor_1->wait_online();
+
+  const auto output = decode_yao_tensor<TypeParam>(yao_tensor_0, yao_tensor_1,
+                                                   this->yao_providers_[0]->get_global_offset());
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    EXPECT_EQ(output.at(i), TypeParam(input_a.at(i) == input_b.at(i)));
+  }
+}
+
+// per-channel constants for the comparison with public constants of a tensor
+// with 3 channels, and inputs at the boundaries of the signed range
+template <typename T>
+static std::vector<std::uint64_t> prepare_gt_public_inputs(std::vector<T>& input) {
+  using S = std::make_signed_t<T>;
+  constexpr auto s_min = T(std::numeric_limits<S>::min());
+  constexpr auto s_max = T(std::numeric_limits<S>::max());
+  const std::size_t channel_size = input.size() / 3;
+  input.at(0) = T(-3);
+  input.at(1) = T(-2);
+  input.at(2) = T(-4);
+  input.at(channel_size) = s_max;
+  input.at(2 * channel_size) = s_min;
+  input.at(2 * channel_size + 1) = s_min + 1;
+  return {T(-3), s_max, s_min};
+}
+
+template <typename T>
+static bool gt_public_expected(T value, std::uint64_t constant) {
+  using S = std::make_signed_t<T>;
+  return S(value) > S(T(constant));
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, GTPublic) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 2, .width_ = 5};
+  auto input = this->generate_inputs(dims);
+  const auto constants = prepare_gt_public_inputs(input);
+  const std::size_t channel_size = dims.height_ * dims.width_;
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto tensor_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_0);
+  auto tensor_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_1);
+  auto output_tensor_0 = this->yao_providers_[0]->make_tensor_gt_public_op(tensor_0, constants);
+  auto output_tensor_1 = this->yao_providers_[1]->make_tensor_gt_public_op(tensor_1, constants);
+  ASSERT_EQ(output_tensor_0->get_dimensions(), dims);
+  ASSERT_EQ(output_tensor_0->get_bit_size(), 1);
+  EXPECT_THROW(this->yao_providers_[0]->make_tensor_gt_public_op(tensor_0, {1, 2}),
+               std::invalid_argument);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto yao_tensor_0 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_0);
+  const auto yao_tensor_1 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_1);
+  ASSERT_NE(yao_tensor_0, nullptr);
+  ASSERT_NE(yao_tensor_1, nullptr);
+  yao_tensor_0->wait_setup();
+  yao_tensor_1->wait_online();
+
+  const auto output = decode_yao_tensor<TypeParam>(yao_tensor_0, yao_tensor_1,
+                                                   this->yao_providers_[0]->get_global_offset());
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    EXPECT_EQ(output.at(i),
+              TypeParam(gt_public_expected(input.at(i), constants.at(i / channel_size))));
+  }
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, GTPublicInBooleanGMW) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 2, .width_ = 5};
+  auto input = this->generate_inputs(dims);
+  const auto constants = prepare_gt_public_inputs(input);
+  const std::size_t channel_size = dims.height_ * dims.width_;
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto tensor_yao_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_0);
+  auto tensor_yao_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_1);
+  auto tensor_gmw_0 = this->yao_providers_[0]->make_convert_to_boolean_gmw_tensor(tensor_yao_0);
+  auto tensor_gmw_1 = this->yao_providers_[1]->make_convert_to_boolean_gmw_tensor(tensor_yao_1);
+  auto output_tensor_0 = this->gmw_providers_[0]->make_tensor_gt_public_op(tensor_gmw_0, constants);
+  auto output_tensor_1 = this->gmw_providers_[1]->make_tensor_gt_public_op(tensor_gmw_1, constants);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto gmw_tensor_0 = std::dynamic_pointer_cast<const BooleanGMWTensor>(output_tensor_0);
+  const auto gmw_tensor_1 = std::dynamic_pointer_cast<const BooleanGMWTensor>(output_tensor_1);
+  ASSERT_NE(gmw_tensor_0, nullptr);
+  ASSERT_NE(gmw_tensor_1, nullptr);
+  gmw_tensor_0->wait_online();
+  gmw_tensor_1->wait_online();
+
+  const auto& share_0 = gmw_tensor_0->get_share();
+  const auto& share_1 = gmw_tensor_1->get_share();
+  ASSERT_EQ(share_0.size(), 1);
+  ASSERT_EQ(share_1.size(), 1);
+  const auto plain_bits = share_0.at(0) ^ share_1.at(0);
+  ASSERT_EQ(plain_bits.GetSize(), input.size());
+  for (std::size_t int_i = 0; int_i < input.size(); ++int_i) {
+    EXPECT_EQ(plain_bits.Get(int_i),
+              gt_public_expected(input.at(int_i), constants.at(int_i / channel_size)));
+  }
+}
+
+// public bounds for the Clip tests, and inputs at and around them
+template <typename T>
+static std::pair<T, T> prepare_clip_inputs(std::vector<T>& input) {
+  using S = std::make_signed_t<T>;
+  const auto min = T(-5);
+  const auto max = T(6);
+  input.at(0) = min;
+  input.at(1) = max;
+  input.at(2) = min - 1;
+  input.at(3) = max + 1;
+  input.at(4) = T(std::numeric_limits<S>::min());
+  input.at(5) = T(std::numeric_limits<S>::max());
+  input.at(6) = T(0);
+  return {min, max};
+}
+
+template <typename T>
+static T clip_expected(T value, T min, T max) {
+  using S = std::make_signed_t<T>;
+  return T(std::clamp(S(value), S(min), S(max)));
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, Clip) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 2, .height_ = 3, .width_ = 5};
+  auto input = this->generate_inputs(dims);
+  const auto [min, max] = prepare_clip_inputs(input);
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto tensor_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_0);
+  auto tensor_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_1);
+  auto output_tensor_0 = this->yao_providers_[0]->make_tensor_clip_op(tensor_0, min, max);
+  auto output_tensor_1 = this->yao_providers_[1]->make_tensor_clip_op(tensor_1, min, max);
+  ASSERT_EQ(output_tensor_0->get_dimensions(), dims);
+  ASSERT_EQ(output_tensor_0->get_bit_size(), ENCRYPTO::bit_size_v<TypeParam>);
+  EXPECT_THROW(this->yao_providers_[0]->make_tensor_clip_op(tensor_0, max, min),
+               std::invalid_argument);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto yao_tensor_0 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_0);
+  const auto yao_tensor_1 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_1);
+  ASSERT_NE(yao_tensor_0, nullptr);
+  ASSERT_NE(yao_tensor_1, nullptr);
+  yao_tensor_0->wait_setup();
+  yao_tensor_1->wait_online();
+
+  const auto output = decode_yao_tensor<TypeParam>(yao_tensor_0, yao_tensor_1,
+                                                   this->yao_providers_[0]->get_global_offset());
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    EXPECT_EQ(output.at(i), clip_expected(input.at(i), min, max));
+  }
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, ClipInBooleanGMW) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 2, .height_ = 3, .width_ = 5};
+  auto input = this->generate_inputs(dims);
+  const auto [min, max] = prepare_clip_inputs(input);
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto tensor_yao_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_0);
+  auto tensor_yao_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_1);
+  auto tensor_gmw_0 = this->yao_providers_[0]->make_convert_to_boolean_gmw_tensor(tensor_yao_0);
+  auto tensor_gmw_1 = this->yao_providers_[1]->make_convert_to_boolean_gmw_tensor(tensor_yao_1);
+  auto output_tensor_0 = this->gmw_providers_[0]->make_tensor_clip_op(tensor_gmw_0, min, max);
+  auto output_tensor_1 = this->gmw_providers_[1]->make_tensor_clip_op(tensor_gmw_1, min, max);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto gmw_tensor_0 = std::dynamic_pointer_cast<const BooleanGMWTensor>(output_tensor_0);
+  const auto gmw_tensor_1 = std::dynamic_pointer_cast<const BooleanGMWTensor>(output_tensor_1);
+  ASSERT_NE(gmw_tensor_0, nullptr);
+  ASSERT_NE(gmw_tensor_1, nullptr);
+  gmw_tensor_0->wait_online();
+  gmw_tensor_1->wait_online();
+
+  const auto& share_0 = gmw_tensor_0->get_share();
+  const auto& share_1 = gmw_tensor_1->get_share();
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<TypeParam>;
+  ASSERT_EQ(share_0.size(), bit_size);
+  ASSERT_EQ(share_1.size(), bit_size);
+  std::vector<ENCRYPTO::BitVector<>> plain_bits;
+  std::transform(std::begin(share_0), std::end(share_0), std::begin(share_1),
+                 std::back_inserter(plain_bits),
+                 [](const auto& x, const auto& y) { return x ^ y; });
+  const auto plain_ints = ENCRYPTO::ToVectorOutput<TypeParam>(plain_bits);
+  ASSERT_EQ(plain_ints.size(), input.size());
+  for (std::size_t int_i = 0; int_i < input.size(); ++int_i) {
+    EXPECT_EQ(plain_ints.at(int_i), clip_expected(input.at(int_i), min, max));
+  }
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, Sort) {
+  // not a power of two
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 5, .width_ = 7};
+  auto input = this->generate_inputs(dims);
+  input.at(3) = input.at(17);
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_0);
+  auto tensor_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_1);
+  auto output_tensor_0 = this->yao_providers_[0]->make_tensor_sort_op(tensor_0);
+  auto output_tensor_1 = this->yao_providers_[1]->make_tensor_sort_op(tensor_1);
+  ASSERT_EQ(output_tensor_0->get_dimensions(), dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto yao_tensor_0 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_0);
+  const auto yao_tensor_1 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_1);
+  ASSERT_NE(yao_tensor_0, nullptr);
+  ASSERT_NE(yao_tensor_1, nullptr);
+  yao_tensor_0->wait_setup();
+  yao_tensor_1->wait_online();
+
+  const auto output = decode_yao_tensor<TypeParam>(yao_tensor_0, yao_tensor_1,
+                                                   this->yao_providers_[0]->get_global_offset());
+  auto expected_output = input;
+  std::sort(std::begin(expected_output), std::end(expected_output));
+  EXPECT_EQ(output, expected_output);
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, Intersection) {
+  const MOTION::tensor::TensorDimensions dims_a = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 6};
+  const MOTION::tensor::TensorDimensions dims_b = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 5};
+  const std::vector<TypeParam> input_a = {42, 7, 13, 99, 1, 64};
+  const std::vector<TypeParam> input_b = {5, 64, 8, 42, 100};
+
+  auto [input_promise_a, tensor_in_a_0] = this->make_arithmetic_T_tensor_input_my(0, dims_a);
+  auto tensor_in_a_1 = this->make_arithmetic_T_tensor_input_other(1, dims_a);
+  auto tensor_in_b_0 = this->make_arithmetic_T_tensor_input_other(0, dims_b);
+  auto [input_promise_b, tensor_in_b_1] = this->make_arithmetic_T_tensor_input_my(1, dims_b);
+
+  auto tensor_a_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_a_0);
+  auto tensor_a_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_a_1);
+  auto tensor_b_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_b_0);
+  auto tensor_b_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_b_1);
+  auto output_tensor_0 =
+      this->yao_providers_[0]->make_tensor_intersection_op(tensor_a_0, tensor_b_0);
+  auto output_tensor_1 =
+      this->yao_providers_[1]->make_tensor_intersection_op(tensor_a_1, tensor_b_1);
+  ASSERT_EQ(output_tensor_0->get_dimensions().get_data_size(),
+            dims_a.get_data_size() + dims_b.get_data_size());
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise_a.set_value(input_a);
+  input_promise_b.set_value(input_b);
+  this->run_gates_online();
+
+  const auto yao_tensor_0 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_0);
+  const auto yao_tensor_1 = std::dynamic_pointer_cast<const YaoTensor>(output_tensor_1);
+  ASSERT_NE(yao_tensor_0, nullptr);
+  ASSERT_NE(yao_tensor_1, nullptr);
+  yao_tensor_0->wait_setup();
+  yao_tensor_1->wait_online();
+
+  const auto output = decode_yao_tensor<TypeParam>(yao_tensor_0, yao_tensor_1,
+                                                   this->yao_providers_[0]->get_global_offset());
+  // sorted: 1 5 7 8 13 42 42 64 64 99 100
+  const std::vector<TypeParam> expected_output = {0, 0, 0, 0, 0, 42, 0, 64, 0, 0, 0};
+  EXPECT_EQ(output, expected_output);
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, JoinOnKeys) {
+  const MOTION::tensor::TensorDimensions dims_a = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 6};
+  const MOTION::tensor::TensorDimensions dims_b = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 5};
+  const std::vector<TypeParam> keys_a = {42, 7, 13, 99, 1, 64};
+  const std::vector<TypeParam> payload_a = {11, 12, 13, 14, 15, 16};
+  const std::vector<TypeParam> keys_b = {5, 64, 8, 42, 100};
+  const std::vector<TypeParam> payload_b = {21, 22, 23, 24, 25};
+
+  auto [keys_promise_a, tensor_keys_a_0] = this->make_arithmetic_T_tensor_input_my(0, dims_a);
+  auto tensor_keys_a_1 = this->make_arithmetic_T_tensor_input_other(1, dims_a);
+  auto [payload_promise_a, tensor_payload_a_0] = this->make_arithmetic_T_tensor_input_my(0, dims_a);
+  auto tensor_payload_a_1 = this->make_arithmetic_T_tensor_input_other(1, dims_a);
+  auto tensor_keys_b_0 = this->make_arithmetic_T_tensor_input_other(0, dims_b);
+  auto [keys_promise_b, tensor_keys_b_1] = this->make_arithmetic_T_tensor_input_my(1, dims_b);
+  auto tensor_payload_b_0 = this->make_arithmetic_T_tensor_input_other(0, dims_b);
+  auto [payload_promise_b, tensor_payload_b_1] = this->make_arithmetic_T_tensor_input_my(1, dims_b);
+
+  std::array<std::vector<MOTION::tensor::TensorCP>, 2> outputs;
+  for (std::size_t party_i = 0; party_i < 2; ++party_i) {
+    auto& yao_provider = *this->yao_providers_[party_i];
+    const std::array<MOTION::tensor::TensorCP, 4> inputs =
+        party_i == 0 ? std::array{tensor_keys_a_0, tensor_payload_a_0, tensor_keys_b_0,
+                                  tensor_payload_b_0}
+                     : std::array{tensor_keys_a_1, tensor_payload_a_1, tensor_keys_b_1,
+                                  tensor_payload_b_1};
+    std::array<MOTION::tensor::TensorCP, 4> yao_inputs;
+    for (std::size_t input_i = 0; input_i < 4; ++input_i) {
+      yao_inputs[input_i] = yao_provider.make_convert_from_arithmetic_gmw_tensor(inputs[input_i]);
+    }
+    outputs[party_i] = yao_provider.make_tensor_join_on_keys_op(yao_inputs[0], yao_inputs[1],
+                                                                yao_inputs[2], yao_inputs[3]);
+    ASSERT_EQ(outputs[party_i].size(), 3);
+  }
+
+  this->run_setup();
+  this->run_gates_setup();
+  keys_promise_a.set_value(keys_a);
+  payload_promise_a.set_value(payload_a);
+  keys_promise_b.set_value(keys_b);
+  payload_promise_b.set_value(payload_b);
+  this->run_gates_online();
+
+  // sorted: 1 5 7 8 13 42 42 64 64 99 100
+  const std::array<std::vector<TypeParam>, 3> expected_outputs = {
+      std::vector<TypeParam>{0, 0, 0, 0, 0, 42, 0, 64, 0, 0, 0},
+      std::vector<TypeParam>{0, 0, 0, 0, 0, 11, 0, 16, 0, 0, 0},
+      std::vector<TypeParam>{0, 0, 0, 0, 0, 24, 0, 22, 0, 0, 0}};
+  for (std::size_t output_i = 0; output_i < 3; ++output_i) {
+    const auto yao_tensor_0 = std::dynamic_pointer_cast<const YaoTensor>(outputs[0][output_i]);
+    const auto yao_tensor_1 = std::dynamic_pointer_cast<const YaoTensor>(outputs[1][output_i]);
+    ASSERT_NE(yao_tensor_0, nullptr);
+    ASSERT_NE(yao_tensor_1, nullptr);
+    yao_tensor_0->wait_setup();
+    yao_tensor_1->wait_online();
+    const auto output = decode_yao_tensor<TypeParam>(yao_tensor_0, yao_tensor_1,
+                                                     this->yao_providers_[0]->get_global_offset());
+    EXPECT_EQ(output, expected_outputs[output_i]);
+  }
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, Histogram) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 10, .width_ = 10};
+  const std::vector<std::uint64_t> bucket_bounds = {10, 20, 50, 100};
+  std::vector<TypeParam> input(dims.get_data_size());
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<TypeParam> dist(0, 120);
+  std::generate(std::begin(input), std::end(input), [&] { return dist(rng); });
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto yao_tensor_0 = this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(tensor_in_0);
+  auto yao_tensor_1 = this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(tensor_in_1);
+  auto buckets_0 = this->yao_providers_[0]->make_tensor_bucketize_op(yao_tensor_0, bucket_bounds);
+  auto buckets_1 = this->yao_providers_[1]->make_tensor_bucketize_op(yao_tensor_1, bucket_bounds);
+  auto gmw_tensor_0 = this->yao_providers_[0]->make_convert_to_arithmetic_gmw_tensor(buckets_0);
+  auto gmw_tensor_1 = this->yao_providers_[1]->make_convert_to_arithmetic_gmw_tensor(buckets_1);
+  auto histogram_0 = this->gmw_providers_[0]->make_tensor_sum_op(gmw_tensor_0, 3);
+  auto histogram_1 = this->gmw_providers_[1]->make_tensor_sum_op(gmw_tensor_1, 3);
+
+  const MOTION::tensor::TensorDimensions expected_dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 1, .width_ = 1};
+  ASSERT_EQ(histogram_0->get_dimensions(), expected_dims);
+
+  this->gmw_providers_[0]->make_arithmetic_tensor_output_other(histogram_0);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, histogram_1);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  auto output = output_future.get();
+
+  std::vector<TypeParam> expected_output(bucket_bounds.size() - 1, 0);
+  for (auto x : input) {
+    for (std::size_t j = 0; j + 1 < bucket_bounds.size(); ++j) {
+      if (bucket_bounds[j] <= x && x < bucket_bounds[j + 1]) {
+        ++expected_output[j];
+      }
+    }
+  }
+  EXPECT_EQ(output, expected_output);
+}
+
+TYPED_TEST(YaoArithmeticGMWTensorTest, TreeEnsemble) {
+  // two trees of depth 2 and 3 over 3 features
+  std::istringstream model_stream(
+      "3 2\n"
+      "2\n"
+      "0 50\n1 30\n2 70\n"
+      "5 6 7 8\n"
+      "3\n"
+      "1 40\n0 20\n2 60\n0 10\n1 80\n2 30\n2 90\n"
+      "100 101 102 103 104 105 106 107\n");
+  const auto model = MOTION::TreeEnsemble::from_stream(model_stream);
+  ASSERT_TRUE(model.verify());
+  const std::size_t num_queries = 16;
+  const MOTION::tensor::TensorDimensions features_dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = num_queries, .width_ = 3};
+  const MOTION::tensor::TensorDimensions thresholds_dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 10};
+  const MOTION::tensor::TensorDimensions leaf_values_dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 12};
+  std::vector<TypeParam> features(features_dims.get_data_size());
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<TypeParam> dist(0, 100);
+  std::generate(std::begin(features), std::end(features), [&] { return dist(rng); });
+  const auto thresholds_64 = model.get_thresholds();
+  const auto leaf_values_64 = model.get_leaf_values();
+  const std::vector<TypeParam> thresholds(std::begin(thresholds_64), std::end(thresholds_64));
+  const std::vector<TypeParam> leaf_values(std::begin(leaf_values_64), std::end(leaf_values_64));
+
+  // party 0 holds the queries and party 1 the model
+  auto [features_promise, features_0] =
+      this->make_arithmetic_T_tensor_input_my(0, features_dims);
+  auto features_1 = this->make_arithmetic_T_tensor_input_other(1, features_dims);
+  auto thresholds_0 = this->make_arithmetic_T_tensor_input_other(0, thresholds_dims);
+  auto [thresholds_promise, thresholds_1] =
+      this->make_arithmetic_T_tensor_input_my(1, thresholds_dims);
+  auto leaf_values_0 = this->make_arithmetic_T_tensor_input_other(0, leaf_values_dims);
+  auto [leaf_values_promise, leaf_values_1] =
+      this->make_arithmetic_T_tensor_input_my(1, leaf_values_dims);
+
+  auto yao_features_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(features_0);
+  auto yao_features_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(features_1);
+  auto yao_thresholds_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_gmw_tensor(thresholds_0);
+  auto yao_thresholds_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_gmw_tensor(thresholds_1);
+  auto indicators_0 = this->yao_providers_[0]->make_tensor_tree_ensemble_op(model, yao_features_0,
+                                                                            yao_thresholds_0);
+  auto indicators_1 = this->yao_providers_[1]->make_tensor_tree_ensemble_op(model, yao_features_1,
+                                                                            yao_thresholds_1);
+  const MOTION::tensor::TensorDimensions indicators_dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 12, .width_ = num_queries};
+  ASSERT_EQ(indicators_0->get_dimensions(), indicators_dims);
+  ASSERT_EQ(indicators_0->get_bit_size(), 1);
+  auto bool_indicators_0 =
+      this->yao_providers_[0]->make_convert_to_boolean_gmw_tensor(indicators_0);
+  auto bool_indicators_1 =
+      this->yao_providers_[1]->make_convert_to_boolean_gmw_tensor(indicators_1);
+  auto gmw_indicators_0 = this->gmw_providers_[0]->make_tensor_bit_to_arithmetic_op(
+      bool_indicators_0, ENCRYPTO::bit_size_v<TypeParam>);
+  auto gmw_indicators_1 = this->gmw_providers_[1]->make_tensor_bit_to_arithmetic_op(
+      bool_indicators_1, ENCRYPTO::bit_size_v<TypeParam>);
+  const MOTION::tensor::GemmOp gemm_op = {.input_A_shape_ = {1, 12},
+                                          .input_B_shape_ = {12, num_queries},
+                                          .output_shape_ = {1, num_queries}};
+  auto tensor_out_0 =
+      this->gmw_providers_[0]->make_tensor_gemm_op(gemm_op, leaf_values_0, gmw_indicators_0);
+  auto tensor_out_1 =
+      this->gmw_providers_[1]->make_tensor_gemm_op(gemm_op, leaf_values_1, gmw_indicators_1);
+
+  this->gmw_providers_[0]->make_arithmetic_tensor_output_other(tensor_out_0);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, tensor_out_1);
+
+  this->run_setup();
+  this->run_gates_setup();
+  features_promise.set_value(features);
+  thresholds_promise.set_value(thresholds);
+  leaf_values_promise.set_value(leaf_values);
+  this->run_gates_online();
+
+  auto output = output_future.get();
+
+  std::vector<TypeParam> expected_output(num_queries);
+  for (std::size_t query_i = 0; query_i < num_queries; ++query_i) {
+    std::vector<std::uint64_t> query(&features[3 * query_i], &features[3 * query_i + 3]);
+    expected_output[query_i] = model.evaluate(query);
+  }
+  EXPECT_EQ(output, expected_output);
+}
+
 template <typename T>
 class YaoArithmeticBEAVYTensorTest : public YaoTensorTest {
  public:
@@ -1194,3 +1748,166 @@ TYPED_TEST(YaoArithmeticBEAVYTensorTest, MaxPoolInBooleanBEAVY) {
   const auto output = output_future.get();
   EXPECT_EQ(output, expected_output);
 }
+
+TYPED_TEST(YaoArithmeticBEAVYTensorTest, GTPublicInBooleanBEAVY) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 3, .height_ = 2, .width_ = 5};
+  auto input = this->generate_inputs(dims);
+  const auto constants = prepare_gt_public_inputs(input);
+  const std::size_t channel_size = dims.height_ * dims.width_;
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto tensor_yao_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_beavy_tensor(tensor_in_0);
+  auto tensor_yao_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_beavy_tensor(tensor_in_1);
+  auto tensor_beavy_0 = this->yao_providers_[0]->make_convert_to_boolean_beavy_tensor(tensor_yao_0);
+  auto tensor_beavy_1 = this->yao_providers_[1]->make_convert_to_boolean_beavy_tensor(tensor_yao_1);
+  auto output_tensor_0 =
+      this->beavy_providers_[0]->make_tensor_gt_public_op(tensor_beavy_0, constants);
+  auto output_tensor_1 =
+      this->beavy_providers_[1]->make_tensor_gt_public_op(tensor_beavy_1, constants);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto beavy_tensor_0 = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(output_tensor_0);
+  const auto beavy_tensor_1 = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(output_tensor_1);
+  ASSERT_NE(beavy_tensor_0, nullptr);
+  ASSERT_NE(beavy_tensor_1, nullptr);
+  beavy_tensor_0->wait_online();
+  beavy_tensor_1->wait_online();
+
+  const auto& pshare_0 = beavy_tensor_0->get_public_share();
+  const auto& pshare_1 = beavy_tensor_1->get_public_share();
+  const auto& sshare_0 = beavy_tensor_0->get_secret_share();
+  const auto& sshare_1 = beavy_tensor_1->get_secret_share();
+  ASSERT_EQ(pshare_0.size(), 1);
+  ASSERT_EQ(pshare_0, pshare_1);
+  const auto plain_bits = pshare_0.at(0) ^ sshare_0.at(0) ^ sshare_1.at(0);
+  ASSERT_EQ(plain_bits.GetSize(), input.size());
+  for (std::size_t int_i = 0; int_i < input.size(); ++int_i) {
+    EXPECT_EQ(plain_bits.Get(int_i),
+              gt_public_expected(input.at(int_i), constants.at(int_i / channel_size)));
+  }
+}
+
+TYPED_TEST(YaoArithmeticBEAVYTensorTest, ClipInBooleanBEAVY) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 2, .height_ = 3, .width_ = 5};
+  auto input = this->generate_inputs(dims);
+  const auto [min, max] = prepare_clip_inputs(input);
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto tensor_yao_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_beavy_tensor(tensor_in_0);
+  auto tensor_yao_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_beavy_tensor(tensor_in_1);
+  auto tensor_beavy_0 = this->yao_providers_[0]->make_convert_to_boolean_beavy_tensor(tensor_yao_0);
+  auto tensor_beavy_1 = this->yao_providers_[1]->make_convert_to_boolean_beavy_tensor(tensor_yao_1);
+  auto output_tensor_0 = this->beavy_providers_[0]->make_tensor_clip_op(tensor_beavy_0, min, max);
+  auto output_tensor_1 = this->beavy_providers_[1]->make_tensor_clip_op(tensor_beavy_1, min, max);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto beavy_tensor_0 = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(output_tensor_0);
+  const auto beavy_tensor_1 = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(output_tensor_1);
+  ASSERT_NE(beavy_tensor_0, nullptr);
+  ASSERT_NE(beavy_tensor_1, nullptr);
+  beavy_tensor_0->wait_online();
+  beavy_tensor_1->wait_online();
+
+  const auto& pshare_0 = beavy_tensor_0->get_public_share();
+  const auto& pshare_1 = beavy_tensor_1->get_public_share();
+  const auto& sshare_0 = beavy_tensor_0->get_secret_share();
+  const auto& sshare_1 = beavy_tensor_1->get_secret_share();
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<TypeParam>;
+  ASSERT_EQ(pshare_0.size(), bit_size);
+  ASSERT_EQ(pshare_0, pshare_1);
+  std::vector<ENCRYPTO::BitVector<>> plain_bits(bit_size);
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    plain_bits.at(bit_j) = pshare_0.at(bit_j) ^ sshare_0.at(bit_j) ^ sshare_1.at(bit_j);
+  }
+  const auto plain_ints = ENCRYPTO::ToVectorOutput<TypeParam>(plain_bits);
+  ASSERT_EQ(plain_ints.size(), input.size());
+  for (std::size_t int_i = 0; int_i < input.size(); ++int_i) {
+    EXPECT_EQ(plain_ints.at(int_i), clip_expected(input.at(int_i), min, max));
+  }
+}
+
+// routes the tensor operations of one party to its BEAVY and Yao providers
+class BEAVYYaoNetworkBuilder : public MOTION::tensor::NetworkBuilder {
+ public:
+  BEAVYYaoNetworkBuilder(BEAVYProvider& beavy_provider, YaoProvider& yao_provider)
+      : beavy_provider_(beavy_provider), yao_provider_(yao_provider) {}
+  MOTION::tensor::TensorOpFactory& get_tensor_op_factory(MOTION::MPCProtocol proto) override {
+    if (proto == MOTION::MPCProtocol::Yao) {
+      return yao_provider_;
+    }
+    return beavy_provider_;
+  }
+  std::optional<MOTION::MPCProtocol> convert_via(MOTION::MPCProtocol src_proto,
+                                                 MOTION::MPCProtocol dst_proto) override {
+    if (src_proto == MOTION::MPCProtocol::ArithmeticBEAVY &&
+        dst_proto == MOTION::MPCProtocol::BooleanBEAVY) {
+      return MOTION::MPCProtocol::Yao;
+    }
+    return std::nullopt;
+  }
+
+ private:
+  BEAVYProvider& beavy_provider_;
+  YaoProvider& yao_provider_;
+};
+
+TYPED_TEST(YaoArithmeticBEAVYTensorTest, LeakyReLU) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 5, .width_ = 5};
+  const auto input = this->generate_inputs(dims);
+  const std::uint64_t slope = 3;
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  BEAVYYaoNetworkBuilder builder_0(*this->beavy_providers_[0], *this->yao_providers_[0]);
+  BEAVYYaoNetworkBuilder builder_1(*this->beavy_providers_[1], *this->yao_providers_[1]);
+  auto output_tensor_0 = MOTION::tensor::make_leaky_relu(
+      builder_0, MOTION::MPCProtocol::ArithmeticBEAVY, MOTION::MPCProtocol::BooleanBEAVY,
+      tensor_in_0, slope, 0);
+  auto output_tensor_1 = MOTION::tensor::make_leaky_relu(
+      builder_1, MOTION::MPCProtocol::ArithmeticBEAVY, MOTION::MPCProtocol::BooleanBEAVY,
+      tensor_in_1, slope, 0);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto beavy_tensor_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(output_tensor_0);
+  const auto beavy_tensor_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(output_tensor_1);
+  ASSERT_NE(beavy_tensor_0, nullptr);
+  ASSERT_NE(beavy_tensor_1, nullptr);
+  beavy_tensor_0->wait_online();
+  beavy_tensor_1->wait_online();
+
+  const auto& pshare_0 = beavy_tensor_0->get_public_share();
+  const auto& sshare_0 = beavy_tensor_0->get_secret_share();
+  const auto& sshare_1 = beavy_tensor_1->get_secret_share();
+  ASSERT_EQ(pshare_0, beavy_tensor_1->get_public_share());
+  const auto plain_ints =
+      MOTION::Helpers::SubVectors(pshare_0, MOTION::Helpers::AddVectors(sshare_0, sshare_1));
+  ASSERT_EQ(plain_ints.size(), input.size());
+  for (std::size_t int_i = 0; int_i < input.size(); ++int_i) {
+    const auto value = input.at(int_i);
+    const auto msb = bool(value >> (ENCRYPTO::bit_size_v<TypeParam> - 1));
+    EXPECT_EQ(plain_ints.at(int_i), msb ? TypeParam(slope * value) : value);
+  }
+}